@@ -124,10 +124,11 @@ DxHelper::DxHelper() :
     mSamplerLinearPtr(nullptr), mDepthStencilStatePtr(nullptr),
     mBlendStatePtr(nullptr), mVertShaders({}), mPixlShaders({}),
     mConstBufferPtr(nullptr), mUpdateConstBufferPtr(nullptr),
+    mViewConstBufferPtr(nullptr),
     mProjMatrix(g_InitValue), mRasterizerStatePtr(nullptr),
     mDriverType(D3D_DRIVER_TYPE_UNKNOWN),
     mFeatLevel(D3D_FEATURE_LEVEL_11_0),
-    mProjBuffer({}), mWorldBuffer({})
+    mProjBuffer({}), mWorldBuffer({}), mViewBuffer({})
 {
 
 }
@@ -426,6 +427,12 @@ HRESULT DxHelper::StartUp(HWND wndHandle)
     mImmediateContextPtr->VSSetConstantBuffers(
         0, 1, &mConstBufferPtr);
 
+    mViewBuffer.mView = DirectX::XMMatrixIdentity();
+    mImmediateContextPtr->UpdateSubresource(mViewConstBufferPtr,
+        0, nullptr, &mViewBuffer, 0, 0);
+    mImmediateContextPtr->VSSetConstantBuffers(
+        2, 1, &mViewConstBufferPtr);
+
     return hr;
 }
 
@@ -443,6 +450,10 @@ void DxHelper::CleanAndStop()
     {
         mUpdateConstBufferPtr->Release();
     }
+    if (mViewConstBufferPtr)
+    {
+        mViewConstBufferPtr->Release();
+    }
     if (mVertexLayoutPtr)
     {
         mVertexLayoutPtr->Release();
@@ -638,6 +649,17 @@ HRESULT DxHelper::CompileDefaultShaders()
     lbdc.CPUAccessFlags = 0;
     hr = mD3dDevicePtr->CreateBuffer(
         &lbdc, nullptr, &mUpdateConstBufferPtr);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    lbdc.Usage = D3D11_USAGE_DEFAULT;
+    lbdc.ByteWidth = sizeof(ConstantViewBuffer);
+    lbdc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    lbdc.CPUAccessFlags = 0;
+    hr = mD3dDevicePtr->CreateBuffer(
+        &lbdc, nullptr, &mViewConstBufferPtr);
     return hr;
 }
 
@@ -676,3 +698,14 @@ void DxHelper::PassWorldMatrixToVS(Matrix4x4f* world)
     mImmediateContextPtr->VSSetConstantBuffers(
         1, 1, &mUpdateConstBufferPtr);
 }
+
+void DxHelper::PassViewMatrixToVS(Matrix4x4f* view)
+{
+    Float4x4 viewMat = DirectX::XMLoadFloat4x4(view);
+    mViewBuffer.mView = viewMat;
+
+    mImmediateContextPtr->UpdateSubresource(mViewConstBufferPtr,
+        0, nullptr, &mViewBuffer, 0, 0);
+    mImmediateContextPtr->VSSetConstantBuffers(
+        2, 1, &mViewConstBufferPtr);
+}
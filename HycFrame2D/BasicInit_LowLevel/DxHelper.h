@@ -40,6 +40,11 @@ struct ConstantUpdateBuffer
     Float4x4 mWorld;
 };
 
+struct ConstantViewBuffer
+{
+    Float4x4 mView;
+};
+
 class DxHelper
 {
 public:
@@ -57,6 +62,7 @@ public:
     ID3D11Device* GetDevicePtr();
     ID3D11DeviceContext* GetImmediateContextPtr();
     void PassWorldMatrixToVS(Matrix4x4f* world);
+    void PassViewMatrixToVS(Matrix4x4f* view);
 
 private:
     HRESULT CompileDefaultShaders();
@@ -81,7 +87,9 @@ private:
     std::map<std::string, ID3D11PixelShader*> mPixlShaders;
     ID3D11Buffer* mConstBufferPtr;
     ID3D11Buffer* mUpdateConstBufferPtr;
+    ID3D11Buffer* mViewConstBufferPtr;
     Matrix4x4f mProjMatrix;
     ConstantBuffer mProjBuffer;
     ConstantUpdateBuffer mWorldBuffer;
+    ConstantViewBuffer mViewBuffer;
 };
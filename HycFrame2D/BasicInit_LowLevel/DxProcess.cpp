@@ -1,6 +1,7 @@
 #include "DxProcess.h"
 #include "WM_Interface.h"
 #include "ID_Interface.h"
+#include "ControllerHelper.h"
 
 HWND g_WndHandle;
 bool g_ShouldQuit = false;
@@ -35,7 +36,9 @@ float GoRunLoopProcess()
     float timer = 0.f;
     timer = ((float)(GetTickCount64() - g_InitTime)) / 1000.f;
 
-    if (InputInterface::IsKeyPushedInSingle(KB_ESCAPE))
+    // the sampling thread owns the device state, so escape is read
+    // from the same snapshot as every other key
+    if (GetControllerTrigger(KB_ESCAPE))
     {
         g_ShouldQuit = true;
     }
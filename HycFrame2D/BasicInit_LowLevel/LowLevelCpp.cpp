@@ -4,6 +4,11 @@
 DxHelper* gp_DxHelper = nullptr;
 
 bool InitSystem(HINSTANCE hInstance, int cmdShow)
+{
+    return InitWindow(hInstance, cmdShow) && InitDirectX();
+}
+
+bool InitWindow(HINSTANCE hInstance, int cmdShow)
 {
     if (!CreateWndAndInitInput(hInstance, cmdShow))
     {
@@ -11,6 +16,11 @@ bool InitSystem(HINSTANCE hInstance, int cmdShow)
         return false;
     }
 
+    return true;
+}
+
+bool InitDirectX()
+{
     gp_DxHelper = new DxHelper();
     if (FAILED((gp_DxHelper->StartUp(GetWndHandle()))))
     {
@@ -25,7 +35,10 @@ bool InitSystem(HINSTANCE hInstance, int cmdShow)
 
 void UninitSystem()
 {
-    gp_DxHelper->CleanAndStop();
+    if (gp_DxHelper)
+    {
+        gp_DxHelper->CleanAndStop();
+    }
 }
 
 float SwapBuffers()
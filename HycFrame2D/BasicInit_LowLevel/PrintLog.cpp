@@ -1,14 +1,19 @@
 #include "PrintLog.h"
+#include <stdarg.h>
 
 int VDebugPrintF(const char* format, va_list argList)
 {
-    const UINT32 MAX_CHARS = 1024;
+    const unsigned int MAX_CHARS = 1024;
     static char s_LogBuffer[MAX_CHARS];
 
     int charsWritten = vsnprintf(
         s_LogBuffer, MAX_CHARS, format, argList);
 
+#ifdef _WIN32
     OutputDebugString(s_LogBuffer);
+#else
+    fputs(s_LogBuffer, stderr);
+#endif // _WIN32
 
     return charsWritten;
 }
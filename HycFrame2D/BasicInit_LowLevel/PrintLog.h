@@ -2,11 +2,13 @@
 
 #include <stdio.h>
 
+#ifdef _WIN32
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN (1)
 #endif // !WIN32_LEAN_AND_MEAN
 
 #include <Windows.h>
+#endif // _WIN32
 
 #define LOG_MESSAGE             (0)
 #define LOG_WARNING             (1)
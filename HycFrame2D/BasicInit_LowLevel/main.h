@@ -14,6 +14,10 @@
 
 bool InitSystem(HINSTANCE hInstance, int cmdShow);
 
+bool InitWindow(HINSTANCE hInstance, int cmdShow);
+
+bool InitDirectX();
+
 void UninitSystem();
 
 float SwapBuffers();
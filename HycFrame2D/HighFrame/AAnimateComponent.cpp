@@ -15,35 +15,40 @@
 
 AAnimateComponent::AAnimateComponent(std::string _name,
     ActorObject* _owner, int _order) :
-    AComponent(_name, _owner, _order), mAnimates({}),
+    AComponent(_name, _owner, _order), mAnimates(),
     mCurrentAnimateCut(0), mCurrentAnimate(nullptr),
     mAnimateChangedFlg(false), mTimeCounter(0.f)
 {
-    mAnimates.clear();
+    mAnimates.Clear();
 }
 
 AAnimateComponent::~AAnimateComponent()
 {
-
+    // animates are kept while the actor is parked in a recycle pool
+    CompDestory();
 }
 
 void AAnimateComponent::CompInit()
 {
     for (auto& ani : mAnimates)
     {
+        if (ani->Texture)
+        {
+            continue;
+        }
+
         ID3D11ShaderResourceView* exist =
             GetActorObjOwner()->GetSceneNodePtr()->
-            CheckIfTexExist(ani.second->TexPath);
+            CheckIfTexExist(ani->TexPath);
         if (!exist)
         {
-            ani.second->Texture = LoadTexture(ani.second->TexPath);
+            ani->Texture = LoadTexture(ani->TexPath);
             GetActorObjOwner()->GetSceneNodePtr()->
-                InsertNewTex(ani.second->TexPath,
-                    ani.second->Texture);
+                InsertNewTex(ani->TexPath, ani->Texture);
         }
         else
         {
-            ani.second->Texture = exist;
+            ani->Texture = exist;
         }
     }
 }
@@ -88,10 +93,20 @@ void AAnimateComponent::CompDestory()
 {
     for (auto& ani : mAnimates)
     {
-        delete ani.second;
+        delete ani;
     }
 
-    mAnimates.clear();
+    mAnimates.Clear();
+}
+
+void AAnimateComponent::CompRecycle()
+{
+
+}
+
+void AAnimateComponent::CompRespawn()
+{
+
 }
 
 void AAnimateComponent::LoadAnimate(std::string _name,
@@ -106,22 +121,37 @@ void AAnimateComponent::LoadAnimate(std::string _name,
     ani->RepeatFlg = _repeat;
     ani->SwitchTime = _switchTime;
 
-    mAnimates.insert(std::make_pair(_name, ani));
+    mAnimates.Insert(InternStringID(_name), ani);
 }
 
-void AAnimateComponent::DeleteAnimate(std::string _name)
+void AAnimateComponent::LoadAnimate(std::string _name,
+    std::string _path, ID3D11ShaderResourceView* _texture,
+    Float2 _stride, unsigned int _maxCount, bool _repeat,
+    float _switchTime)
 {
-    if (mAnimates.find(_name) == mAnimates.end())
+    LoadAnimate(_name, _path, _stride, _maxCount, _repeat,
+        _switchTime);
+    (*mAnimates.Find(_name))->Texture = _texture;
+}
+
+void AAnimateComponent::DeleteAnimate(StringID _name)
+{
+    ANIMATE_INFO** found = mAnimates.Find(_name);
+    if (!found)
     {
         P_LOG(LOG_WARNING,
             "cannot find this animation : [ %s ]\n",
-            _name.c_str());
+            _name.GetDebugString());
         return;
     }
 
-    ANIMATE_INFO* ani = mAnimates[_name];
+    ANIMATE_INFO* ani = *found;
+    if (mCurrentAnimate == ani)
+    {
+        mCurrentAnimate = nullptr;
+    }
     delete ani;
-    mAnimates.erase(_name);
+    mAnimates.Erase(_name);
 }
 
 void AAnimateComponent::ResetCurrentAnimateCut()
@@ -134,17 +164,18 @@ void AAnimateComponent::ClearCurrentAnimate()
     mCurrentAnimate = nullptr;
 }
 
-void AAnimateComponent::ChangeAnimateTo(std::string _name)
+void AAnimateComponent::ChangeAnimateTo(StringID _name)
 {
-    if (mAnimates.find(_name) == mAnimates.end())
+    ANIMATE_INFO** found = mAnimates.Find(_name);
+    if (!found)
     {
         P_LOG(LOG_ERROR,
             "cannot find this animation : [ %s ]\n",
-            _name.c_str());
+            _name.GetDebugString());
         return;
     }
 
-    mCurrentAnimate = mAnimates[_name];
+    mCurrentAnimate = *found;
     mAnimateChangedFlg = true;
 }
 
@@ -159,10 +190,9 @@ void AAnimateComponent::SetThisAnimateToTextureComp(
 
     ASpriteComponent* asc = nullptr;
     {
-        std::string name = GetActorObjOwner()->GetObjectName() +
-            "-sprite";
         asc = (ASpriteComponent*)(GetActorObjOwner()->
-            GetAComponent(name));
+            GetAComponent(GetActorObjOwner()->GetObjectNameID().
+                Append("-sprite")));
         if (!asc)
         {
             P_LOG(LOG_ERROR,
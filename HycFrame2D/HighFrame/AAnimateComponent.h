@@ -10,7 +10,7 @@
 #pragma once
 
 #include "AComponent.h"
-#include <unordered_map>
+#include "FlatIDMap.h"
 
 struct ANIMATE_INFO
 {
@@ -34,13 +34,17 @@ public:
         Float2 _stride, unsigned int _maxCount,
         bool _repeat, float _switchTime);
 
-    void DeleteAnimate(std::string _name);
+    void LoadAnimate(std::string _name, std::string _path,
+        ID3D11ShaderResourceView* _texture, Float2 _stride,
+        unsigned int _maxCount, bool _repeat, float _switchTime);
+
+    void DeleteAnimate(StringID _name);
 
     void ResetCurrentAnimateCut();
 
     void ClearCurrentAnimate();
 
-    void ChangeAnimateTo(std::string _name);
+    void ChangeAnimateTo(StringID _name);
 
 private:
     void SetThisAnimateToTextureComp(ANIMATE_INFO* _animte,
@@ -53,8 +57,12 @@ public:
 
     virtual void CompDestory();
 
+    virtual void CompRecycle();
+
+    virtual void CompRespawn();
+
 private:
-    std::unordered_map<std::string, ANIMATE_INFO*> mAnimates;
+    FlatIDMap<ANIMATE_INFO*> mAnimates;
 
     unsigned int mCurrentAnimateCut;
 
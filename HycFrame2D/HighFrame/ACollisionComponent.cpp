@@ -12,7 +12,8 @@
 #include "ATransformComponent.h"
 #include "SceneNode.h"
 #include "texture.h"
-#include "sprite.h"
+#include "DxRenderBackend.h"
+#include "Telemetry.h"
 
 static const Float4 NOT_COLLIED = MakeFloat4(0.f, 1.f, 0.f, 1.f);
 static const Float4 IS_COLLIED = MakeFloat4(1.f, 1.f, 0.f, 1.f);
@@ -23,10 +24,9 @@ ACollisionComponent::ACollisionComponent(std::string _name,
     mCollisionType(COLLISION_TYPE::NULLTYPE),
     mCollisionSize(MakeFloat2(0.f, 0.f)), mShowCollisionFlg(false),
     mCircleTexture(nullptr), mRectangleTexture(nullptr),
-    mColliedColor(MakeFloat4(1.f, 1.f, 1.f, 1.f)),
-    mColliVertexBuffer(nullptr), mColliIndexBuffer(nullptr)
+    mColliedColor(MakeFloat4(1.f, 1.f, 1.f, 1.f))
 {
-
+    SetCompNeedUpdate(false);
 }
 
 ACollisionComponent::~ACollisionComponent()
@@ -35,6 +35,18 @@ ACollisionComponent::~ACollisionComponent()
 }
 
 void ACollisionComponent::CompInit()
+{
+    // the shape textures are only for showing it, a spawned bullet
+    // shouldn't look them up every time
+    if (mShowCollisionFlg)
+    {
+        LoadShapeTextures();
+    }
+
+    mColliedColor = NOT_COLLIED;
+}
+
+void ACollisionComponent::LoadShapeTextures()
 {
     ID3D11ShaderResourceView* exist =
         GetActorObjOwner()->GetSceneNodePtr()->
@@ -69,11 +81,6 @@ void ACollisionComponent::CompInit()
     {
         mRectangleTexture = exist;
     }
-
-    mColliedColor = NOT_COLLIED;
-
-    CreateDefaultVertexIndexBuffer(&mColliVertexBuffer,
-        &mColliIndexBuffer);
 }
 
 void ACollisionComponent::CompUpdate(float _deltatime)
@@ -83,14 +90,17 @@ void ACollisionComponent::CompUpdate(float _deltatime)
 
 void ACollisionComponent::CompDestory()
 {
-    if (mColliVertexBuffer)
-    {
-        mColliVertexBuffer->Release();
-    }
-    if (mColliIndexBuffer)
-    {
-        mColliIndexBuffer->Release();
-    }
+    
+}
+
+void ACollisionComponent::CompRecycle()
+{
+
+}
+
+void ACollisionComponent::CompRespawn()
+{
+    mColliedColor = NOT_COLLIED;
 }
 
 void ACollisionComponent::SetCollisionStatus(COLLISION_TYPE _type,
@@ -141,6 +151,10 @@ void ACollisionComponent::SetColliedColor(bool _isCollied)
 void ACollisionComponent::SetShowCollisionFlg(bool _flag)
 {
     mShowCollisionFlg = _flag;
+    if (mShowCollisionFlg && !mCircleTexture && !mRectangleTexture)
+    {
+        LoadShapeTextures();
+    }
 }
 
 void ACollisionComponent::DrawACollision()
@@ -148,39 +162,39 @@ void ACollisionComponent::DrawACollision()
     if (mShowCollisionFlg)
     {
         ATransformComponent* thisAtc = nullptr;
-        Float4x4 pworld = Float4x4();
         {
-            std::string keywordThisT = "";
-            keywordThisT = GetActorObjOwner()->GetObjectName() +
-                "-transform";
             thisAtc = (ATransformComponent*)(GetActorObjOwner()->
-                GetAComponent(keywordThisT));
+                GetAComponent(GetActorObjOwner()->GetObjectNameID().
+                    Append("-transform")));
             if (!thisAtc)
             {
                 P_LOG(LOG_ERROR,
                     "cannot find transform comp in this obj : [ %s ]\n",
-                    GetActorObjOwner()->GetObjectName());
+                    GetActorObjOwner()->GetObjectName().c_str());
                 return;
             }
-            Matrix4x4f world = thisAtc->GetWorldMatrix();
-            GetDxHelperPtr()->PassWorldMatrixToVS(&world);
         }
+        RenderCommandList* list = GetActorObjOwner()->
+            GetSceneNodePtr()->GetRenderCommandList();
 
         switch (mCollisionType)
         {
         case COLLISION_TYPE::CIRCLE:
-            SetTexture(&mCircleTexture);
-            DrawSprite(&mColliVertexBuffer, mColliIndexBuffer,
-                0.f, 0.f,
-                mCollisionSize.x * 2.f, mCollisionSize.y * 2.f,
-                0.f, 0.f, 1.f, 1.f, mColliedColor);
+            list->PushDebugShape(
+                ToRenderMatrix(thisAtc->GetWorldMatrix()),
+                mCircleTexture,
+                {
+                    0.f, 0.f,
+                    mCollisionSize.x * 2.f, mCollisionSize.y * 2.f
+                },
+                ToRenderFloat4(mColliedColor));
             return;
         case COLLISION_TYPE::RECTANGLE:
-            SetTexture(&mRectangleTexture);
-            DrawSprite(&mColliVertexBuffer, mColliIndexBuffer,
-                0.f, 0.f,
-                mCollisionSize.x, mCollisionSize.y,
-                0.f, 0.f, 1.f, 1.f, mColliedColor);
+            list->PushDebugShape(
+                ToRenderMatrix(thisAtc->GetWorldMatrix()),
+                mRectangleTexture,
+                { 0.f, 0.f, mCollisionSize.x, mCollisionSize.y },
+                ToRenderFloat4(mColliedColor));
             return;
         default:
             P_LOG(LOG_ERROR,
@@ -208,15 +222,14 @@ bool ACollisionComponent::CheckCollisionWith(ActorObject* _obj)
             GetActorObjOwner()->GetObjectName().c_str());
         return false;
     }
+    TELEMETRY_INC(COLLISION_PAIRS);
 
     ATransformComponent* thisAtc = nullptr;
     ATransformComponent* atc = nullptr;
     ACollisionComponent* acc = nullptr;
     {
-        std::string keywordC = "";
-        keywordC = _obj->GetObjectName() + "-collision";
-        acc = (ACollisionComponent*)(_obj->
-            GetAComponent(keywordC));
+        acc = (ACollisionComponent*)(_obj->GetAComponent(
+            _obj->GetObjectNameID().Append("-collision")));
         if (acc)
         {
             acc->SetColliedColor(false);
@@ -235,29 +248,25 @@ bool ACollisionComponent::CheckCollisionWith(ActorObject* _obj)
     }
 
     {
-        std::string keywordThisT = "";
-        std::string keywordT = "";
-        keywordThisT = GetActorObjOwner()->GetObjectName() +
-            "-transform";
-        keywordT = _obj->GetObjectName() + "-transform";
         thisAtc = (ATransformComponent*)(GetActorObjOwner()->
-            GetAComponent(keywordThisT));
-        atc = (ATransformComponent*)(_obj->
-            GetAComponent(keywordT));
+            GetAComponent(GetActorObjOwner()->GetObjectNameID().
+                Append("-transform")));
+        atc = (ATransformComponent*)(_obj->GetAComponent(
+            _obj->GetObjectNameID().Append("-transform")));
     }
 
     if (!thisAtc)
     {
         P_LOG(LOG_ERROR,
             "cannot find transform or collison comp in this obj : [ %s ]\n",
-            GetActorObjOwner()->GetObjectName());
+            GetActorObjOwner()->GetObjectName().c_str());
         return false;
     }
     if (!(atc && acc))
     {
         P_LOG(LOG_ERROR,
             "cannot find transform or collison comp in this obj : [ %s ]\n",
-            _obj->GetObjectName());
+            _obj->GetObjectName().c_str());
         return false;
     }
 
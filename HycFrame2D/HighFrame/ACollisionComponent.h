@@ -48,6 +48,8 @@ public:
     void DrawACollision();
 
 private:
+    void LoadShapeTextures();
+
     bool ClacCollisonWith(
         const class ATransformComponent* _thisAtc,
         const class ATransformComponent* _atc,
@@ -72,6 +74,10 @@ public:
 
     virtual void CompDestory();
 
+    virtual void CompRecycle();
+
+    virtual void CompRespawn();
+
 private:
     COLLISION_TYPE mCollisionType;
 
@@ -84,8 +90,4 @@ private:
     ID3D11ShaderResourceView* mRectangleTexture;
 
     Float4 mColliedColor;
-
-    ID3D11Buffer* mColliVertexBuffer;
-
-    ID3D11Buffer* mColliIndexBuffer;
 };
@@ -47,3 +47,18 @@ void AComponent::CompDestory()
 {
 
 }
+
+void AComponent::CompRecycle()
+{
+    CompDestory();
+}
+
+void AComponent::CompRespawn()
+{
+    CompInit();
+}
+
+void AComponent::OnNeedUpdateChanged()
+{
+    GetActorObjOwner()->MarkUpdateListDirty();
+}
\ No newline at end of file
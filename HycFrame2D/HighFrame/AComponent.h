@@ -23,6 +23,9 @@ public:
 
     int GetACUpdateOrder() const;
 
+protected:
+    virtual void OnNeedUpdateChanged();
+
 public:
     virtual void CompInit();
 
@@ -30,6 +33,10 @@ public:
 
     virtual void CompDestory();
 
+    virtual void CompRecycle();
+
+    virtual void CompRespawn();
+
 private:
     class ActorObject* mAObjectOwner;
 
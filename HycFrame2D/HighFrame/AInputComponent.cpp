@@ -9,13 +9,15 @@
 
 #include "AInputComponent.h"
 #include "ActorObject.h"
+#include "SceneNode.h"
 
 AInputComponent::AInputComponent(std::string _name,
     ActorObject* _owner, int _order) :
     AComponent(_name, _owner, _order),
-    mInputProcessFuncPtr(nullptr)
+    mInputProcessFuncPtr(nullptr),
+    mCoroutineFuncPtr(nullptr), mCoroutine()
 {
-
+    SetCompNeedUpdate(false);
 }
 
 AInputComponent::~AInputComponent()
@@ -25,7 +27,13 @@ AInputComponent::~AInputComponent()
 
 void AInputComponent::CompInit()
 {
-
+    if (mCoroutineFuncPtr)
+    {
+        mCoroutine = mCoroutineFuncPtr(this);
+        mCoroutine.StartCoroutine(GetActorObjOwner()->
+            GetSceneNodePtr()->GetCoroutineScheduler(),
+            GetActorObjOwner());
+    }
 }
 
 void AInputComponent::CompUpdate(float _deltatime)
@@ -37,6 +45,16 @@ void AInputComponent::CompUpdate(float _deltatime)
 }
 
 void AInputComponent::CompDestory()
+{
+    mCoroutine.StopCoroutine();
+}
+
+void AInputComponent::CompRecycle()
+{
+
+}
+
+void AInputComponent::CompRespawn()
 {
 
 }
@@ -45,9 +63,22 @@ void AInputComponent::SetInputProcessFunc(
     ActorInputProcessFuncType _func)
 {
     mInputProcessFuncPtr = _func;
+    SetCompNeedUpdate(_func != nullptr);
 }
 
 void AInputComponent::ClearInputProcessFunc()
 {
     mInputProcessFuncPtr = nullptr;
+    SetCompNeedUpdate(false);
+}
+
+void AInputComponent::SetCoroutineFunc(
+    ActorInputCoroutineFuncType _func)
+{
+    mCoroutineFuncPtr = _func;
 }
+
+void AInputComponent::ClearCoroutineFunc()
+{
+    mCoroutineFuncPtr = nullptr;
+}
\ No newline at end of file
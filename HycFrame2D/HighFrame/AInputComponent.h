@@ -10,6 +10,7 @@
 #pragma once
 
 #include "AComponent.h"
+#include "ScriptCoroutine.h"
 
 class AInputComponent :
     public AComponent
@@ -23,6 +24,10 @@ public:
 
     void ClearInputProcessFunc();
 
+    void SetCoroutineFunc(ActorInputCoroutineFuncType _func);
+
+    void ClearCoroutineFunc();
+
 public:
     virtual void CompInit();
 
@@ -30,6 +35,14 @@ public:
 
     virtual void CompDestory();
 
+    virtual void CompRecycle();
+
+    virtual void CompRespawn();
+
 private:
     ActorInputProcessFuncType mInputProcessFuncPtr;
+
+    ActorInputCoroutineFuncType mCoroutineFuncPtr;
+
+    ScriptCoroutine mCoroutine;
 };
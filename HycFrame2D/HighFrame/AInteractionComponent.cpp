@@ -9,13 +9,15 @@
 
 #include "AInteractionComponent.h"
 #include "ActorObject.h"
+#include "SceneNode.h"
 
 AInteractionComponent::AInteractionComponent(std::string _name,
     ActorObject* _owner, int _order) :
     AComponent(_name, _owner, _order), mInterInitFuncPtr(nullptr),
-    mInterUpdateFuncPtr(nullptr), mInterDestoryFuncPtr(nullptr)
+    mInterUpdateFuncPtr(nullptr), mInterDestoryFuncPtr(nullptr),
+    mCoroutineFuncPtr(nullptr), mCoroutine()
 {
-
+    SetCompNeedUpdate(false);
 }
 
 AInteractionComponent::~AInteractionComponent()
@@ -29,6 +31,14 @@ void AInteractionComponent::CompInit()
     {
         mInterInitFuncPtr(this);
     }
+
+    if (mCoroutineFuncPtr)
+    {
+        mCoroutine = mCoroutineFuncPtr(this);
+        mCoroutine.StartCoroutine(GetActorObjOwner()->
+            GetSceneNodePtr()->GetCoroutineScheduler(),
+            GetActorObjOwner());
+    }
 }
 
 void AInteractionComponent::CompUpdate(float _deltatime)
@@ -41,12 +51,24 @@ void AInteractionComponent::CompUpdate(float _deltatime)
 
 void AInteractionComponent::CompDestory()
 {
+    mCoroutine.StopCoroutine();
+
     if (mInterDestoryFuncPtr)
     {
         mInterDestoryFuncPtr(this);
     }
 }
 
+void AInteractionComponent::CompRecycle()
+{
+
+}
+
+void AInteractionComponent::CompRespawn()
+{
+
+}
+
 void AInteractionComponent::SetInitFunc(
     ActorInterInitFuncType _func)
 {
@@ -57,6 +79,7 @@ void AInteractionComponent::SetUpdateFunc(
     ActorInterUpdateFuncType _func)
 {
     mInterUpdateFuncPtr = _func;
+    SetCompNeedUpdate(_func != nullptr);
 }
 
 void AInteractionComponent::SetDestoryFunc(
@@ -73,9 +96,21 @@ void AInteractionComponent::ClearInitFunc()
 void AInteractionComponent::ClearUpdateFunc()
 {
     mInterUpdateFuncPtr = nullptr;
+    SetCompNeedUpdate(false);
 }
 
 void AInteractionComponent::ClearDestoryFunc()
 {
     mInterDestoryFuncPtr = nullptr;
 }
+
+void AInteractionComponent::SetCoroutineFunc(
+    ActorInterCoroutineFuncType _func)
+{
+    mCoroutineFuncPtr = _func;
+}
+
+void AInteractionComponent::ClearCoroutineFunc()
+{
+    mCoroutineFuncPtr = nullptr;
+}
\ No newline at end of file
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "AComponent.h"
+#include "ScriptCoroutine.h"
 
 class AInteractionComponent :
     public AComponent
@@ -31,6 +32,10 @@ public:
 
     void ClearDestoryFunc();
 
+    void SetCoroutineFunc(ActorInterCoroutineFuncType _func);
+
+    void ClearCoroutineFunc();
+
 public:
     virtual void CompInit();
 
@@ -38,10 +43,18 @@ public:
 
     virtual void CompDestory();
 
+    virtual void CompRecycle();
+
+    virtual void CompRespawn();
+
 private:
     ActorInterInitFuncType mInterInitFuncPtr;
 
     ActorInterUpdateFuncType mInterUpdateFuncPtr;
 
     ActorInterDestoryFuncType mInterDestoryFuncPtr;
+
+    ActorInterCoroutineFuncType mCoroutineFuncPtr;
+
+    ScriptCoroutine mCoroutine;
 };
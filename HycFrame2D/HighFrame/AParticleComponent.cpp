@@ -0,0 +1,389 @@
+﻿//---------------------------------------------------------------
+// File: AParticleComponent.cpp
+// Proj: HycFrame2D
+// Info: ACTORオブジェクトにあたるSoA型パーティクルのコンポーネント
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "AParticleComponent.h"
+#include "ActorObject.h"
+#include "ATransformComponent.h"
+#include "SceneNode.h"
+#include "DxRenderBackend.h"
+#include "texture.h"
+#include <xmmintrin.h>
+#include <cmath>
+#include <cfloat>
+
+AParticleComponent::AParticleComponent(std::string _name,
+    ActorObject* _owner, int _order) :
+    AComponent(_name, _owner, _order), mEmitter({}),
+    mTexture(nullptr), mAtlasCols(1), mEmittingFlg(true),
+    mEmitCounter(0.f), mRandomSeed(0x9E3779B9u), mAliveCount(0),
+    mPosX({}), mPosY({}), mVelX({}), mVelY({}), mLife({}),
+    mInvMaxLife({}), mAge({}),
+    mBoundsMin(MakeFloat2(0.f, 0.f)), mBoundsMax(MakeFloat2(0.f, 0.f)),
+    mTransformComp(nullptr)
+{
+    SetEmitter(mEmitter);
+}
+
+AParticleComponent::~AParticleComponent()
+{
+
+}
+
+void AParticleComponent::CompInit()
+{
+    if (mEmitter.TexPath != "")
+    {
+        ID3D11ShaderResourceView* exist =
+            GetActorObjOwner()->GetSceneNodePtr()->
+            CheckIfTexExist(mEmitter.TexPath);
+        if (!exist)
+        {
+            mTexture = LoadTexture(mEmitter.TexPath);
+            GetActorObjOwner()->GetSceneNodePtr()->
+                InsertNewTex(mEmitter.TexPath, mTexture);
+        }
+        else
+        {
+            mTexture = exist;
+        }
+    }
+
+    mTransformComp = nullptr;
+    GetBindedTransform();
+    ClearParticles();
+    EmitBurst(mEmitter.BurstCount);
+}
+
+void AParticleComponent::CompUpdate(float _deltatime)
+{
+    if (mEmittingFlg && mEmitter.EmitRate > 0.f)
+    {
+        mEmitCounter += mEmitter.EmitRate * _deltatime;
+        unsigned int count = (unsigned int)mEmitCounter;
+        mEmitCounter -= (float)count;
+        SpawnParticles(count);
+    }
+
+    UpdateParticles(_deltatime);
+}
+
+void AParticleComponent::CompDestory()
+{
+    ClearParticles();
+}
+
+void AParticleComponent::CompRecycle()
+{
+    ClearParticles();
+}
+
+void AParticleComponent::CompRespawn()
+{
+    EmitBurst(mEmitter.BurstCount);
+}
+
+void AParticleComponent::SetEmitter(const PARTICLE_EMITTER& _emitter)
+{
+    mEmitter = _emitter;
+    mEmitter.MaxCut = mEmitter.MaxCut ? mEmitter.MaxCut : 1;
+    if (mEmitter.Stride.x <= 0.f || mEmitter.Stride.y <= 0.f)
+    {
+        mEmitter.Stride = MakeFloat2(1.f, 1.f);
+    }
+    mAtlasCols = (unsigned int)(1.f / mEmitter.Stride.x + 0.5f);
+    mAtlasCols = mAtlasCols ? mAtlasCols : 1;
+
+    // pad to a whole number of sse lanes, nothing grows after this
+    size_t padded = ((size_t)mEmitter.Capacity + 3) & ~(size_t)3;
+    mPosX.assign(padded, 0.f);
+    mPosY.assign(padded, 0.f);
+    mVelX.assign(padded, 0.f);
+    mVelY.assign(padded, 0.f);
+    mLife.assign(padded, 0.f);
+    mInvMaxLife.assign(padded, 0.f);
+    mAge.assign(padded, 0.f);
+    mAliveCount = 0;
+    mEmitCounter = 0.f;
+}
+
+const PARTICLE_EMITTER& AParticleComponent::GetEmitter() const
+{
+    return mEmitter;
+}
+
+void AParticleComponent::SetEmitting(bool _emitting)
+{
+    mEmittingFlg = _emitting;
+    mEmitCounter = 0.f;
+}
+
+bool AParticleComponent::IsEmitting() const
+{
+    return mEmittingFlg;
+}
+
+void AParticleComponent::EmitBurst(unsigned int _count)
+{
+    SpawnParticles(_count);
+}
+
+void AParticleComponent::ClearParticles()
+{
+    mAliveCount = 0;
+    mEmitCounter = 0.f;
+    mBoundsMin = MakeFloat2(0.f, 0.f);
+    mBoundsMax = MakeFloat2(0.f, 0.f);
+}
+
+unsigned int AParticleComponent::GetAliveCount() const
+{
+    return mAliveCount;
+}
+
+unsigned int AParticleComponent::GetCapacity() const
+{
+    return mEmitter.Capacity;
+}
+
+void AParticleComponent::UpdateParticles(float _deltatime)
+{
+    float* px = mPosX.data();
+    float* py = mPosY.data();
+    float* vx = mVelX.data();
+    float* vy = mVelY.data();
+    float* life = mLife.data();
+    float* invLife = mInvMaxLife.data();
+    float* age = mAge.data();
+
+    const __m128 dt = _mm_set1_ps(_deltatime);
+    const __m128 gx = _mm_set1_ps(mEmitter.Gravity.x * _deltatime);
+    const __m128 gy = _mm_set1_ps(mEmitter.Gravity.y * _deltatime);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.f);
+    __m128 minX = _mm_set1_ps(FLT_MAX);
+    __m128 minY = _mm_set1_ps(FLT_MAX);
+    __m128 maxX = _mm_set1_ps(-FLT_MAX);
+    __m128 maxY = _mm_set1_ps(-FLT_MAX);
+
+    unsigned int wide = mAliveCount & ~3u;
+    for (unsigned int i = 0; i < wide; i += 4)
+    {
+        __m128 velX = _mm_add_ps(_mm_loadu_ps(vx + i), gx);
+        __m128 velY = _mm_add_ps(_mm_loadu_ps(vy + i), gy);
+        __m128 posX = _mm_add_ps(_mm_loadu_ps(px + i),
+            _mm_mul_ps(velX, dt));
+        __m128 posY = _mm_add_ps(_mm_loadu_ps(py + i),
+            _mm_mul_ps(velY, dt));
+        __m128 rest = _mm_sub_ps(_mm_loadu_ps(life + i), dt);
+        __m128 t = _mm_sub_ps(one,
+            _mm_mul_ps(rest, _mm_loadu_ps(invLife + i)));
+        t = _mm_min_ps(_mm_max_ps(t, zero), one);
+
+        _mm_storeu_ps(vx + i, velX);
+        _mm_storeu_ps(vy + i, velY);
+        _mm_storeu_ps(px + i, posX);
+        _mm_storeu_ps(py + i, posY);
+        _mm_storeu_ps(life + i, rest);
+        _mm_storeu_ps(age + i, t);
+
+        minX = _mm_min_ps(minX, posX);
+        minY = _mm_min_ps(minY, posY);
+        maxX = _mm_max_ps(maxX, posX);
+        maxY = _mm_max_ps(maxY, posY);
+    }
+
+    float lane[4][4] = {};
+    _mm_storeu_ps(lane[0], minX);
+    _mm_storeu_ps(lane[1], minY);
+    _mm_storeu_ps(lane[2], maxX);
+    _mm_storeu_ps(lane[3], maxY);
+    Float2 bMin = MakeFloat2(FLT_MAX, FLT_MAX);
+    Float2 bMax = MakeFloat2(-FLT_MAX, -FLT_MAX);
+    for (int l = 0; l < 4; l++)
+    {
+        bMin.x = fminf(bMin.x, lane[0][l]);
+        bMin.y = fminf(bMin.y, lane[1][l]);
+        bMax.x = fmaxf(bMax.x, lane[2][l]);
+        bMax.y = fmaxf(bMax.y, lane[3][l]);
+    }
+
+    for (unsigned int i = wide; i < mAliveCount; i++)
+    {
+        vx[i] += mEmitter.Gravity.x * _deltatime;
+        vy[i] += mEmitter.Gravity.y * _deltatime;
+        px[i] += vx[i] * _deltatime;
+        py[i] += vy[i] * _deltatime;
+        life[i] -= _deltatime;
+        float t = 1.f - life[i] * invLife[i];
+        age[i] = t < 0.f ? 0.f : (t > 1.f ? 1.f : t);
+
+        bMin.x = fminf(bMin.x, px[i]);
+        bMin.y = fminf(bMin.y, py[i]);
+        bMax.x = fmaxf(bMax.x, px[i]);
+        bMax.y = fmaxf(bMax.y, py[i]);
+    }
+
+    KillDeadParticles();
+
+    if (mAliveCount)
+    {
+        float size = fmaxf(mEmitter.SizeRange.x, mEmitter.SizeRange.y);
+        mBoundsMin = MakeFloat2(bMin.x - size, bMin.y - size);
+        mBoundsMax = MakeFloat2(bMax.x + size, bMax.y + size);
+    }
+}
+
+bool AParticleComponent::GetWorldBounds(Float2* _center,
+    Float2* _halfSize) const
+{
+    if (!mAliveCount)
+    {
+        return false;
+    }
+
+    _center->x = (mBoundsMin.x + mBoundsMax.x) * 0.5f;
+    _center->y = (mBoundsMin.y + mBoundsMax.y) * 0.5f;
+    _halfSize->x = (mBoundsMax.x - mBoundsMin.x) * 0.5f;
+    _halfSize->y = (mBoundsMax.y - mBoundsMin.y) * 0.5f;
+
+    return true;
+}
+
+unsigned int AParticleComponent::DrawAParticle()
+{
+    if (!mAliveCount)
+    {
+        return 0;
+    }
+
+    static const RENDER_MATRIX IDENTITY =
+    {
+        1.f, 0.f, 0.f, 0.f,
+        0.f, 1.f, 0.f, 0.f,
+        0.f, 0.f, 1.f, 0.f,
+        0.f, 0.f, 0.f, 1.f
+    };
+
+    RenderCommandList* list =
+        GetActorObjOwner()->GetSceneNodePtr()->GetRenderCommandList();
+    RENDER_QUAD* quads = list->AllocateQuadBatch(
+        RENDER_CMD_TYPE::PARTICLE_BATCH, IDENTITY, mTexture,
+        mAliveCount);
+
+    const Float4& c0 = mEmitter.StartColor;
+    const Float4& c1 = mEmitter.EndColor;
+    float s0 = mEmitter.SizeRange.x;
+    float s1 = mEmitter.SizeRange.y;
+    unsigned int maxCut = mEmitter.MaxCut;
+    for (unsigned int i = 0; i < mAliveCount; i++)
+    {
+        float t = mAge[i];
+        float size = s0 + (s1 - s0) * t;
+        unsigned int cut = (unsigned int)(t * (float)maxCut);
+        cut = cut >= maxCut ? maxCut - 1 : cut;
+
+        RENDER_QUAD& quad = quads[i];
+        quad.Rect = { mPosX[i], mPosY[i], size, size };
+        quad.UV =
+        {
+            (float)(cut % mAtlasCols) * mEmitter.Stride.x,
+            (float)(cut / mAtlasCols) * mEmitter.Stride.y,
+            mEmitter.Stride.x, mEmitter.Stride.y
+        };
+        quad.Color =
+        {
+            c0.x + (c1.x - c0.x) * t, c0.y + (c1.y - c0.y) * t,
+            c0.z + (c1.z - c0.z) * t, c0.w + (c1.w - c0.w) * t
+        };
+    }
+
+    return mAliveCount;
+}
+
+void AParticleComponent::SpawnParticles(unsigned int _count)
+{
+    unsigned int room = mEmitter.Capacity - mAliveCount;
+    _count = _count > room ? room : _count;
+    if (!_count)
+    {
+        return;
+    }
+
+    Float3 origin = MakeFloat3(0.f, 0.f, 0.f);
+    ATransformComponent* atc = GetBindedTransform();
+    if (atc)
+    {
+        origin = atc->GetPosition();
+    }
+
+    const float toRadian = 3.14159265f / 180.f;
+    for (unsigned int i = 0; i < _count; i++)
+    {
+        unsigned int index = mAliveCount++;
+        float angle = RandomRange(mEmitter.AngleRange) * toRadian;
+        float speed = RandomRange(mEmitter.SpeedRange);
+        float life = RandomRange(mEmitter.LifeRange);
+        life = life > 0.001f ? life : 0.001f;
+
+        mPosX[index] = origin.x;
+        mPosY[index] = origin.y;
+        mVelX[index] = cosf(angle) * speed;
+        mVelY[index] = sinf(angle) * speed;
+        mLife[index] = life;
+        mInvMaxLife[index] = 1.f / life;
+        mAge[index] = 0.f;
+    }
+}
+
+void AParticleComponent::KillDeadParticles()
+{
+    unsigned int i = 0;
+    while (i < mAliveCount)
+    {
+        if (mLife[i] > 0.f)
+        {
+            ++i;
+            continue;
+        }
+
+        unsigned int last = --mAliveCount;
+        mPosX[i] = mPosX[last];
+        mPosY[i] = mPosY[last];
+        mVelX[i] = mVelX[last];
+        mVelY[i] = mVelY[last];
+        mLife[i] = mLife[last];
+        mInvMaxLife[i] = mInvMaxLife[last];
+        mAge[i] = mAge[last];
+    }
+}
+
+float AParticleComponent::RandomRange(Float2 _range)
+{
+    mRandomSeed ^= mRandomSeed << 13;
+    mRandomSeed ^= mRandomSeed >> 17;
+    mRandomSeed ^= mRandomSeed << 5;
+    float unit = (float)(mRandomSeed & 0xFFFFFF) / (float)0x1000000;
+
+    return _range.x + (_range.y - _range.x) * unit;
+}
+
+ATransformComponent* AParticleComponent::GetBindedTransform()
+{
+    if (mTransformComp)
+    {
+        return mTransformComp;
+    }
+
+    std::string transname = GetComponentName();
+    auto offset = transname.rfind("particle");
+    transname.replace(offset, 8, "transform");
+    mTransformComp = (ATransformComponent*)
+        (GetActorObjOwner()->GetAComponent(transname));
+
+    return mTransformComp;
+}
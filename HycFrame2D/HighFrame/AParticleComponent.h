@@ -0,0 +1,115 @@
+﻿//---------------------------------------------------------------
+// File: AParticleComponent.h
+// Proj: HycFrame2D
+// Info: ACTORオブジェクトにあたるSoA型パーティクルのコンポーネント
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include "AComponent.h"
+#include <vector>
+
+struct PARTICLE_EMITTER
+{
+    unsigned int Capacity = 256;
+    float EmitRate = 0.f;
+    unsigned int BurstCount = 0;
+    Float2 LifeRange = MakeFloat2(1.f, 1.f);
+    Float2 SpeedRange = MakeFloat2(0.f, 0.f);
+    Float2 AngleRange = MakeFloat2(0.f, 360.f);
+    Float2 Gravity = MakeFloat2(0.f, 0.f);
+    Float2 SizeRange = MakeFloat2(16.f, 16.f);
+    Float4 StartColor = MakeFloat4(1.f, 1.f, 1.f, 1.f);
+    Float4 EndColor = MakeFloat4(1.f, 1.f, 1.f, 1.f);
+    std::string TexPath = "";
+    Float2 Stride = MakeFloat2(1.f, 1.f);
+    unsigned int MaxCut = 1;
+};
+
+class AParticleComponent :
+    public AComponent
+{
+public:
+    AParticleComponent(std::string _name,
+        class ActorObject* _owner, int _order);
+    virtual ~AParticleComponent();
+
+    void SetEmitter(const PARTICLE_EMITTER& _emitter);
+
+    const PARTICLE_EMITTER& GetEmitter() const;
+
+    void SetEmitting(bool _emitting);
+
+    bool IsEmitting() const;
+
+    void EmitBurst(unsigned int _count);
+
+    void ClearParticles();
+
+    unsigned int GetAliveCount() const;
+
+    unsigned int GetCapacity() const;
+
+    void UpdateParticles(float _deltatime);
+
+    bool GetWorldBounds(Float2* _center, Float2* _halfSize) const;
+
+    unsigned int DrawAParticle();
+
+private:
+    void SpawnParticles(unsigned int _count);
+
+    void KillDeadParticles();
+
+    float RandomRange(Float2 _range);
+
+    class ATransformComponent* GetBindedTransform();
+
+public:
+    virtual void CompInit();
+
+    virtual void CompUpdate(float _deltatime);
+
+    virtual void CompDestory();
+
+    virtual void CompRecycle();
+
+    virtual void CompRespawn();
+
+private:
+    PARTICLE_EMITTER mEmitter;
+
+    ID3D11ShaderResourceView* mTexture;
+
+    unsigned int mAtlasCols;
+
+    bool mEmittingFlg;
+
+    float mEmitCounter;
+
+    unsigned int mRandomSeed;
+
+    unsigned int mAliveCount;
+
+    std::vector<float> mPosX;
+
+    std::vector<float> mPosY;
+
+    std::vector<float> mVelX;
+
+    std::vector<float> mVelY;
+
+    std::vector<float> mLife;
+
+    std::vector<float> mInvMaxLife;
+
+    std::vector<float> mAge;
+
+    Float2 mBoundsMin;
+
+    Float2 mBoundsMax;
+
+    class ATransformComponent* mTransformComp;
+};
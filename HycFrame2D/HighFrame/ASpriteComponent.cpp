@@ -10,7 +10,7 @@
 #include "ASpriteComponent.h"
 #include "ActorObject.h"
 #include "texture.h"
-#include "sprite.h"
+#include "DxRenderBackend.h"
 #include "ATransformComponent.h"
 #include "SceneNode.h"
 
@@ -21,9 +21,9 @@ ASpriteComponent::ASpriteComponent(std::string _name,
     mVisible(true), mTexWidth(0.f), mTexHeight(0.f),
     mUVValue(MakeFloat4(1.f, 1.f, 1.f, 1.f)),
     mFirstTexture(nullptr), mTexPath(""),
-    mSpriteVertexBuffer(nullptr), mSpriteIndexBuffer(nullptr)
+    mCulledFlg(false), mTransformComp(nullptr)
 {
-
+    SetCompNeedUpdate(false);
 }
 
 ASpriteComponent::~ASpriteComponent()
@@ -39,8 +39,8 @@ void ASpriteComponent::CompInit()
         LoadTextureByPath(mTexPath);
     }
 
-    CreateDefaultVertexIndexBuffer(&mSpriteVertexBuffer,
-        &mSpriteIndexBuffer);
+    mTransformComp = nullptr;
+    GetBindedTransform();
 }
 
 void ASpriteComponent::CompUpdate(float _deltatime)
@@ -53,11 +53,29 @@ void ASpriteComponent::CompDestory()
     
 }
 
+void ASpriteComponent::CompRecycle()
+{
+
+}
+
+void ASpriteComponent::CompRespawn()
+{
+    mUVValue = MakeFloat4(0.f, 0.f, 1.f, 1.f);
+    mCulledFlg = false;
+}
+
 void ASpriteComponent::SaveTexturePath(std::string _path)
 {
     mTexPath = _path;
 }
 
+void ASpriteComponent::SetPreloadedTexture(
+    ID3D11ShaderResourceView* _texture)
+{
+    mTexPath = "";
+    mTexture = _texture;
+}
+
 void ASpriteComponent::LoadTextureByPath(std::string _path)
 {
     ID3D11ShaderResourceView* exist =
@@ -100,6 +118,7 @@ void ASpriteComponent::SetTexWidth(float _width)
     }
 
     mTexWidth = _width;
+    MarkBoundsDirty();
 }
 
 void ASpriteComponent::SetTexHeight(float _height)
@@ -110,6 +129,7 @@ void ASpriteComponent::SetTexHeight(float _height)
     }
 
     mTexHeight = _height;
+    MarkBoundsDirty();
 }
 
 float ASpriteComponent::GetTexWidth() const
@@ -177,17 +197,78 @@ void ASpriteComponent::SetUVValue(Float4 _value)
     mUVValue = _value;
 }
 
-void ASpriteComponent::DrawASprite()
+ATransformComponent* ASpriteComponent::GetBindedTransform()
 {
-    if (!mVisible)
+    if (mTransformComp)
     {
-        return;
+        return mTransformComp;
     }
 
     std::string transname = GetComponentName();
     auto offset = transname.rfind("sprite");
     transname.replace(offset, 6, "transform");
-    auto transcomp = GetActorObjOwner()->GetAComponent(transname);
+    mTransformComp = (ATransformComponent*)
+        (GetActorObjOwner()->GetAComponent(transname));
+
+    return mTransformComp;
+}
+
+bool ASpriteComponent::GetWorldBounds(Float2* _center,
+    Float2* _halfSize)
+{
+    auto atc = GetBindedTransform();
+    if (!atc)
+    {
+        return false;
+    }
+
+    Float3 pos = atc->GetPosition();
+    Float3 rot = atc->GetRotation();
+    Float3 scl = atc->GetScale();
+    float hw = fabsf(mTexWidth * scl.x) * 0.5f;
+    float hh = fabsf(mTexHeight * scl.y) * 0.5f;
+
+    if (rot.x != 0.f || rot.y != 0.f || rot.z != 0.f)
+    {
+        float radius = sqrtf(hw * hw + hh * hh);
+        hw = radius;
+        hh = radius;
+    }
+
+    *_center = MakeFloat2(pos.x, pos.y);
+    *_halfSize = MakeFloat2(hw, hh);
+
+    return true;
+}
+
+void ASpriteComponent::MarkBoundsDirty()
+{
+    // a resized sprite has to be placed again in the culling grid
+    ActorObject* owner = GetActorObjOwner();
+    if (owner->GetActorList() != ACTOR_LIST::UNLISTED)
+    {
+        owner->GetSceneNodePtr()->NotifyActorMoved(owner);
+    }
+}
+
+void ASpriteComponent::SetCulledFlg(bool _culled)
+{
+    mCulledFlg = _culled;
+}
+
+bool ASpriteComponent::IsCulled() const
+{
+    return mCulledFlg;
+}
+
+void ASpriteComponent::DrawASprite()
+{
+    if (!mVisible || mCulledFlg)
+    {
+        return;
+    }
+
+    auto transcomp = GetBindedTransform();
     if (!transcomp)
     {
         P_LOG(LOG_ERROR,
@@ -197,13 +278,8 @@ void ASpriteComponent::DrawASprite()
         return;
     }
 
-    Matrix4x4f world = ((ATransformComponent*)transcomp)->
-        GetWorldMatrix();
-    GetDxHelperPtr()->PassWorldMatrixToVS(&world);
-
-    SetTexture(&mTexture);
-    DrawSprite(&mSpriteVertexBuffer, mSpriteIndexBuffer,
-        0.f, 0.f, mTexWidth, mTexHeight,
-        mUVValue.x, mUVValue.y, mUVValue.z, mUVValue.w,
-        mOffsetColor);
+    GetActorObjOwner()->GetSceneNodePtr()->GetRenderCommandList()->
+        PushSprite(ToRenderMatrix(transcomp->GetWorldMatrix()),
+            mTexture, { 0.f, 0.f, mTexWidth, mTexHeight },
+            ToRenderFloat4(mUVValue), ToRenderFloat4(mOffsetColor));
 }
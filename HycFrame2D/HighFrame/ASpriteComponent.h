@@ -21,6 +21,8 @@ public:
 
     void SaveTexturePath(std::string _path);
 
+    void SetPreloadedTexture(ID3D11ShaderResourceView* _texture);
+
     void DeleteTexture();
 
     ID3D11ShaderResourceView* GetTexture() const;
@@ -51,11 +53,21 @@ public:
 
     void SetUVValue(Float4 _value);
 
+    bool GetWorldBounds(Float2* _center, Float2* _halfSize);
+
+    void SetCulledFlg(bool _culled);
+
+    bool IsCulled() const;
+
     void DrawASprite();
 
 private:
     void LoadTextureByPath(std::string _path);
 
+    class ATransformComponent* GetBindedTransform();
+
+    void MarkBoundsDirty();
+
 public:
     virtual void CompInit();
 
@@ -63,15 +75,15 @@ public:
 
     virtual void CompDestory();
 
+    virtual void CompRecycle();
+
+    virtual void CompRespawn();
+
 private:
     ID3D11ShaderResourceView* mTexture;
 
     ID3D11ShaderResourceView* mFirstTexture;
 
-    ID3D11Buffer* mSpriteVertexBuffer;
-
-    ID3D11Buffer* mSpriteIndexBuffer;
-
     std::string mTexPath;
 
     Float4 mOffsetColor;
@@ -84,5 +96,9 @@ private:
 
     bool mVisible;
 
+    bool mCulledFlg;
+
     int mDrawOrder;
+
+    class ATransformComponent* mTransformComp;
 };
@@ -0,0 +1,484 @@
+﻿//---------------------------------------------------------------
+// File: ATilemapComponent.cpp
+// Proj: HycFrame2D
+// Info: ACTORオブジェクトにあたるチャンク分割タイルマップのコンポーネント
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "ATilemapComponent.h"
+#include "ActorObject.h"
+#include "ATransformComponent.h"
+#include "SceneNode.h"
+#include "VirtualFileSystem.h"
+#include "DxRenderBackend.h"
+#include "texture.h"
+
+namespace
+{
+    const char TILE_LAYER_MAGIC[4] = { 'H', 'T', 'L', '1' };
+
+    // every chunk ever built gets its own key so the backend never
+    // mixes up the buffers of two maps or of a relaid map
+    unsigned int g_NextChunkCacheKey = 1;
+}
+
+ATilemapComponent::ATilemapComponent(std::string _name,
+    ActorObject* _owner, int _order) :
+    AComponent(_name, _owner, _order), mMapCols(0), mMapRows(0),
+    mTileSize(MakeFloat2(0.f, 0.f)), mTileArray({}),
+    mSolidTable({}), mAtlasPath(""), mAtlasTexture(nullptr),
+    mAtlasCols(1), mAtlasRows(1), mChunkCols(0), mChunkRows(0),
+    mChunkArray({}), mVisibleChunkArray({}), mTransformComp(nullptr)
+{
+    mTileArray.clear();
+    mSolidTable.assign(EMPTY_TILE + 1, false);
+    mChunkArray.clear();
+    mVisibleChunkArray.clear();
+    SetCompNeedUpdate(false);
+}
+
+ATilemapComponent::~ATilemapComponent()
+{
+
+}
+
+void ATilemapComponent::CompInit()
+{
+    if (mAtlasPath != "")
+    {
+        ID3D11ShaderResourceView* exist =
+            GetActorObjOwner()->GetSceneNodePtr()->
+            CheckIfTexExist(mAtlasPath);
+        if (!exist)
+        {
+            mAtlasTexture = LoadTexture(mAtlasPath);
+            GetActorObjOwner()->GetSceneNodePtr()->
+                InsertNewTex(mAtlasPath, mAtlasTexture);
+        }
+        else
+        {
+            mAtlasTexture = exist;
+        }
+    }
+
+    mTransformComp = nullptr;
+    GetBindedTransform();
+    RebuildDirtyChunks();
+}
+
+void ATilemapComponent::CompUpdate(float _deltatime)
+{
+
+}
+
+void ATilemapComponent::CompDestory()
+{
+    mVisibleChunkArray.clear();
+}
+
+void ATilemapComponent::SetTileLayout(unsigned int _cols,
+    unsigned int _rows, Float2 _tileSize)
+{
+    mMapCols = _cols;
+    mMapRows = _rows;
+    mTileSize = _tileSize;
+    mTileArray.assign((size_t)mMapCols * mMapRows, EMPTY_TILE);
+    BuildChunkArray();
+}
+
+void ATilemapComponent::SetAtlas(std::string _path,
+    unsigned int _atlasCols, unsigned int _atlasRows)
+{
+    mAtlasPath = _path;
+    mAtlasCols = _atlasCols ? _atlasCols : 1;
+    mAtlasRows = _atlasRows ? _atlasRows : 1;
+    for (auto& chunk : mChunkArray)
+    {
+        chunk.DirtyFlg = true;
+    }
+}
+
+bool ATilemapComponent::LoadTileArray(
+    const std::vector<unsigned short>& _tiles)
+{
+    if (_tiles.size() != mTileArray.size())
+    {
+        P_LOG(LOG_ERROR,
+            "tile count doesn't match the map size of [ %s ]\n",
+            GetComponentName().c_str());
+        return false;
+    }
+
+    mTileArray = _tiles;
+    for (auto& chunk : mChunkArray)
+    {
+        chunk.DirtyFlg = true;
+    }
+
+    return true;
+}
+
+bool ATilemapComponent::LoadBinaryLayer(std::string _path)
+{
+    ASSET_DATA asset = {};
+    if (!GetVirtualFileSystem()->ReadAsset(_path, &asset))
+    {
+        P_LOG(LOG_ERROR, "cannot open tile layer [ %s ]\n",
+            _path.c_str());
+        return false;
+    }
+
+    const size_t headerSize = sizeof(TILE_LAYER_MAGIC) +
+        sizeof(unsigned int) * 2;
+    unsigned int size[2] = { 0, 0 };
+    if (asset.Size < headerSize ||
+        memcmp(asset.Data, TILE_LAYER_MAGIC, sizeof(TILE_LAYER_MAGIC)))
+    {
+        P_LOG(LOG_ERROR, "invalid tile layer header [ %s ]\n",
+            _path.c_str());
+        return false;
+    }
+    memcpy(size, asset.Data + sizeof(TILE_LAYER_MAGIC), sizeof(size));
+
+    std::vector<unsigned short> tiles((size_t)size[0] * size[1]);
+    size_t tileBytes = tiles.size() * sizeof(unsigned short);
+    if (asset.Size - headerSize < tileBytes)
+    {
+        P_LOG(LOG_ERROR, "tile layer is truncated [ %s ]\n",
+            _path.c_str());
+        return false;
+    }
+    memcpy(tiles.data(), asset.Data + headerSize, tileBytes);
+
+    SetTileLayout(size[0], size[1], mTileSize);
+    mTileArray.swap(tiles);
+
+    return true;
+}
+
+void ATilemapComponent::SetSolidTiles(
+    const std::vector<unsigned short>& _solids)
+{
+    mSolidTable.assign(EMPTY_TILE + 1, false);
+    for (auto tile : _solids)
+    {
+        if (tile != EMPTY_TILE)
+        {
+            mSolidTable[tile] = true;
+        }
+    }
+}
+
+void ATilemapComponent::SetTile(unsigned int _x, unsigned int _y,
+    unsigned short _tile)
+{
+    if (_x >= mMapCols || _y >= mMapRows)
+    {
+        return;
+    }
+
+    unsigned short& tile = mTileArray[(size_t)_y * mMapCols + _x];
+    if (tile == _tile)
+    {
+        return;
+    }
+    tile = _tile;
+    mChunkArray[(size_t)(_y / TILEMAP_CHUNK_SIZE) * mChunkCols +
+        _x / TILEMAP_CHUNK_SIZE].DirtyFlg = true;
+}
+
+unsigned short ATilemapComponent::GetTile(unsigned int _x,
+    unsigned int _y) const
+{
+    if (_x >= mMapCols || _y >= mMapRows)
+    {
+        return EMPTY_TILE;
+    }
+
+    return mTileArray[(size_t)_y * mMapCols + _x];
+}
+
+unsigned short ATilemapComponent::GetTileAtWorld(Float2 _pos)
+{
+    int x = 0;
+    int y = 0;
+    if (!WorldToTile(_pos, &x, &y))
+    {
+        return EMPTY_TILE;
+    }
+
+    return GetTile((unsigned int)x, (unsigned int)y);
+}
+
+bool ATilemapComponent::IsSolidAtWorld(Float2 _pos)
+{
+    return mSolidTable[GetTileAtWorld(_pos)];
+}
+
+bool ATilemapComponent::OverlapSolidRect(Float2 _center,
+    Float2 _halfSize)
+{
+    int minX = 0;
+    int minY = 0;
+    int maxX = 0;
+    int maxY = 0;
+    WorldToTile(MakeFloat2(_center.x - _halfSize.x,
+        _center.y - _halfSize.y), &minX, &minY);
+    WorldToTile(MakeFloat2(_center.x + _halfSize.x,
+        _center.y + _halfSize.y), &maxX, &maxY);
+    if (minX > maxX)
+    {
+        std::swap(minX, maxX);
+    }
+    if (minY > maxY)
+    {
+        std::swap(minY, maxY);
+    }
+
+    minX = minX < 0 ? 0 : minX;
+    minY = minY < 0 ? 0 : minY;
+    maxX = maxX >= (int)mMapCols ? (int)mMapCols - 1 : maxX;
+    maxY = maxY >= (int)mMapRows ? (int)mMapRows - 1 : maxY;
+    for (int y = minY; y <= maxY; y++)
+    {
+        for (int x = minX; x <= maxX; x++)
+        {
+            if (mSolidTable[mTileArray[(size_t)y * mMapCols + x]])
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+unsigned int ATilemapComponent::GetMapCols() const
+{
+    return mMapCols;
+}
+
+unsigned int ATilemapComponent::GetMapRows() const
+{
+    return mMapRows;
+}
+
+Float2 ATilemapComponent::GetTileSize() const
+{
+    return mTileSize;
+}
+
+unsigned int ATilemapComponent::GetChunkCount() const
+{
+    return (unsigned int)mChunkArray.size();
+}
+
+const TILE_CHUNK* ATilemapComponent::GetChunk(
+    unsigned int _index) const
+{
+    if (_index >= mChunkArray.size())
+    {
+        return nullptr;
+    }
+
+    return &mChunkArray[_index];
+}
+
+void ATilemapComponent::RebuildDirtyChunks()
+{
+    for (auto& chunk : mChunkArray)
+    {
+        if (chunk.DirtyFlg)
+        {
+            BuildChunk(&chunk);
+        }
+    }
+}
+
+void ATilemapComponent::CollectVisibleChunks(Camera* _camera,
+    std::vector<unsigned int>* _out)
+{
+    _out->clear();
+
+    Float3 pos = MakeFloat3(0.f, 0.f, 0.f);
+    Float3 scl = MakeFloat3(1.f, 1.f, 1.f);
+    ATransformComponent* atc = GetBindedTransform();
+    if (atc)
+    {
+        pos = atc->GetPosition();
+        scl = atc->GetScale();
+    }
+
+    for (unsigned int i = 0; i < (unsigned int)mChunkArray.size(); i++)
+    {
+        const TILE_CHUNK& chunk = mChunkArray[i];
+        if (chunk.QuadArray.empty() && !chunk.DirtyFlg)
+        {
+            continue;
+        }
+
+        Float2 center = MakeFloat2(pos.x + chunk.Center.x * scl.x,
+            pos.y + chunk.Center.y * scl.y);
+        Float2 halfSize = MakeFloat2(
+            fabsf(chunk.HalfSize.x * scl.x),
+            fabsf(chunk.HalfSize.y * scl.y));
+        if (!_camera || _camera->IsInCameraView(center, halfSize))
+        {
+            _out->push_back(i);
+        }
+    }
+}
+
+unsigned int ATilemapComponent::DrawATilemap(Camera* _camera)
+{
+    ATransformComponent* atc = GetBindedTransform();
+    if (!atc)
+    {
+        P_LOG(LOG_ERROR,
+            "cannot find the transform component of [ %s ]\n",
+            GetActorObjOwner()->GetObjectName().c_str());
+        return 0;
+    }
+
+    RebuildDirtyChunks();
+    CollectVisibleChunks(_camera, &mVisibleChunkArray);
+
+    RenderCommandList* list =
+        GetActorObjOwner()->GetSceneNodePtr()->GetRenderCommandList();
+    RENDER_MATRIX world = ToRenderMatrix(atc->GetWorldMatrix());
+    for (auto index : mVisibleChunkArray)
+    {
+        const TILE_CHUNK& chunk = mChunkArray[index];
+        list->PushCachedQuadBatch(RENDER_CMD_TYPE::TILE_CHUNK, world,
+            mAtlasTexture, chunk.QuadArray.data(),
+            (unsigned int)chunk.QuadArray.size(), chunk.CacheKey,
+            chunk.Revision);
+    }
+
+    return (unsigned int)mVisibleChunkArray.size();
+}
+
+void ATilemapComponent::BuildChunkArray()
+{
+    mChunkCols = (mMapCols + TILEMAP_CHUNK_SIZE - 1) /
+        TILEMAP_CHUNK_SIZE;
+    mChunkRows = (mMapRows + TILEMAP_CHUNK_SIZE - 1) /
+        TILEMAP_CHUNK_SIZE;
+
+    mChunkArray.clear();
+    mChunkArray.resize((size_t)mChunkCols * mChunkRows);
+    for (unsigned int cy = 0; cy < mChunkRows; cy++)
+    {
+        for (unsigned int cx = 0; cx < mChunkCols; cx++)
+        {
+            TILE_CHUNK& chunk =
+                mChunkArray[(size_t)cy * mChunkCols + cx];
+            unsigned int w = mMapCols - cx * TILEMAP_CHUNK_SIZE;
+            unsigned int h = mMapRows - cy * TILEMAP_CHUNK_SIZE;
+            w = w > TILEMAP_CHUNK_SIZE ? TILEMAP_CHUNK_SIZE : w;
+            h = h > TILEMAP_CHUNK_SIZE ? TILEMAP_CHUNK_SIZE : h;
+
+            chunk.ChunkX = cx;
+            chunk.ChunkY = cy;
+            chunk.HalfSize = MakeFloat2(w * mTileSize.x * 0.5f,
+                h * mTileSize.y * 0.5f);
+            chunk.Center = MakeFloat2(
+                cx * TILEMAP_CHUNK_SIZE * mTileSize.x +
+                chunk.HalfSize.x,
+                cy * TILEMAP_CHUNK_SIZE * mTileSize.y +
+                chunk.HalfSize.y);
+            chunk.DirtyFlg = true;
+            chunk.CacheKey = g_NextChunkCacheKey++;
+            chunk.Revision = 0;
+            chunk.QuadArray.clear();
+        }
+    }
+}
+
+void ATilemapComponent::BuildChunk(TILE_CHUNK* _chunk)
+{
+    _chunk->QuadArray.clear();
+    _chunk->DirtyFlg = false;
+    ++_chunk->Revision;
+
+    float du = 1.f / (float)mAtlasCols;
+    float dv = 1.f / (float)mAtlasRows;
+    unsigned int startX = _chunk->ChunkX * TILEMAP_CHUNK_SIZE;
+    unsigned int startY = _chunk->ChunkY * TILEMAP_CHUNK_SIZE;
+    unsigned int endX = startX + TILEMAP_CHUNK_SIZE;
+    unsigned int endY = startY + TILEMAP_CHUNK_SIZE;
+    endX = endX > mMapCols ? mMapCols : endX;
+    endY = endY > mMapRows ? mMapRows : endY;
+
+    for (unsigned int y = startY; y < endY; y++)
+    {
+        for (unsigned int x = startX; x < endX; x++)
+        {
+            unsigned short tile = mTileArray[(size_t)y * mMapCols + x];
+            if (tile == EMPTY_TILE)
+            {
+                continue;
+            }
+
+            RENDER_QUAD quad = {};
+            quad.Rect =
+            {
+                ((float)x + 0.5f) * mTileSize.x,
+                ((float)y + 0.5f) * mTileSize.y,
+                mTileSize.x, mTileSize.y
+            };
+            quad.UV =
+            {
+                (float)(tile % mAtlasCols) * du,
+                (float)(tile / mAtlasCols) * dv, du, dv
+            };
+            quad.Color = { 1.f, 1.f, 1.f, 1.f };
+            _chunk->QuadArray.push_back(quad);
+        }
+    }
+}
+
+bool ATilemapComponent::WorldToTile(Float2 _pos, int* _x, int* _y)
+{
+    Float3 pos = MakeFloat3(0.f, 0.f, 0.f);
+    Float3 scl = MakeFloat3(1.f, 1.f, 1.f);
+    ATransformComponent* atc = GetBindedTransform();
+    if (atc)
+    {
+        pos = atc->GetPosition();
+        scl = atc->GetScale();
+    }
+
+    if (mTileSize.x == 0.f || mTileSize.y == 0.f ||
+        scl.x == 0.f || scl.y == 0.f)
+    {
+        *_x = -1;
+        *_y = -1;
+        return false;
+    }
+
+    float localX = (_pos.x - pos.x) / scl.x / mTileSize.x;
+    float localY = (_pos.y - pos.y) / scl.y / mTileSize.y;
+    *_x = (int)floorf(localX);
+    *_y = (int)floorf(localY);
+
+    return *_x >= 0 && *_y >= 0 &&
+        *_x < (int)mMapCols && *_y < (int)mMapRows;
+}
+
+ATransformComponent* ATilemapComponent::GetBindedTransform()
+{
+    if (mTransformComp)
+    {
+        return mTransformComp;
+    }
+
+    std::string transname = GetComponentName();
+    auto offset = transname.rfind("tilemap");
+    transname.replace(offset, 7, "transform");
+    mTransformComp = (ATransformComponent*)
+        (GetActorObjOwner()->GetAComponent(transname));
+
+    return mTransformComp;
+}
@@ -0,0 +1,123 @@
+﻿//---------------------------------------------------------------
+// File: ATilemapComponent.h
+// Proj: HycFrame2D
+// Info: ACTORオブジェクトにあたるチャンク分割タイルマップのコンポーネント
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include "AComponent.h"
+#include "RenderCommandQueue.h"
+#include <vector>
+
+#define TILEMAP_CHUNK_SIZE (16)
+
+constexpr unsigned short EMPTY_TILE = 0xFFFF;
+
+struct TILE_CHUNK
+{
+    unsigned int ChunkX;
+    unsigned int ChunkY;
+    Float2 Center;
+    Float2 HalfSize;
+    bool DirtyFlg;
+    unsigned int CacheKey;
+    unsigned int Revision;
+    std::vector<RENDER_QUAD> QuadArray;
+};
+
+class ATilemapComponent :
+    public AComponent
+{
+public:
+    ATilemapComponent(std::string _name,
+        class ActorObject* _owner, int _order);
+    virtual ~ATilemapComponent();
+
+    void SetTileLayout(unsigned int _cols, unsigned int _rows,
+        Float2 _tileSize);
+
+    void SetAtlas(std::string _path, unsigned int _atlasCols,
+        unsigned int _atlasRows);
+
+    bool LoadTileArray(const std::vector<unsigned short>& _tiles);
+
+    bool LoadBinaryLayer(std::string _path);
+
+    void SetSolidTiles(const std::vector<unsigned short>& _solids);
+
+    void SetTile(unsigned int _x, unsigned int _y,
+        unsigned short _tile);
+
+    unsigned short GetTile(unsigned int _x, unsigned int _y) const;
+
+    unsigned short GetTileAtWorld(Float2 _pos);
+
+    bool IsSolidAtWorld(Float2 _pos);
+
+    bool OverlapSolidRect(Float2 _center, Float2 _halfSize);
+
+    unsigned int GetMapCols() const;
+
+    unsigned int GetMapRows() const;
+
+    Float2 GetTileSize() const;
+
+    unsigned int GetChunkCount() const;
+
+    const TILE_CHUNK* GetChunk(unsigned int _index) const;
+
+    void RebuildDirtyChunks();
+
+    void CollectVisibleChunks(class Camera* _camera,
+        std::vector<unsigned int>* _out);
+
+    unsigned int DrawATilemap(class Camera* _camera);
+
+private:
+    void BuildChunkArray();
+
+    void BuildChunk(TILE_CHUNK* _chunk);
+
+    bool WorldToTile(Float2 _pos, int* _x, int* _y);
+
+    class ATransformComponent* GetBindedTransform();
+
+public:
+    virtual void CompInit();
+
+    virtual void CompUpdate(float _deltatime);
+
+    virtual void CompDestory();
+
+private:
+    unsigned int mMapCols;
+
+    unsigned int mMapRows;
+
+    Float2 mTileSize;
+
+    std::vector<unsigned short> mTileArray;
+
+    std::vector<bool> mSolidTable;
+
+    std::string mAtlasPath;
+
+    ID3D11ShaderResourceView* mAtlasTexture;
+
+    unsigned int mAtlasCols;
+
+    unsigned int mAtlasRows;
+
+    unsigned int mChunkCols;
+
+    unsigned int mChunkRows;
+
+    std::vector<TILE_CHUNK> mChunkArray;
+
+    std::vector<unsigned int> mVisibleChunkArray;
+
+    class ATransformComponent* mTransformComp;
+};
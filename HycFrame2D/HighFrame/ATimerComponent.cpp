@@ -13,15 +13,16 @@
 ATimerComponent::ATimerComponent(std::string _name,
     ActorObject* _owner, int _order) :
     AComponent(_name, _owner, _order),
-    mTimerMap({}), mTimerArray({})
+    mTimerMap(), mTimerArray({})
 {
     mTimerArray.clear();
-    mTimerMap.clear();
+    mTimerMap.Clear();
 }
 
 ATimerComponent::~ATimerComponent()
 {
-
+    // timers are kept while the actor is parked in a recycle pool
+    CompDestory();
 }
 
 void ATimerComponent::CompInit()
@@ -48,7 +49,17 @@ void ATimerComponent::CompDestory()
     }
 
     mTimerArray.clear();
-    mTimerMap.clear();
+    mTimerMap.Clear();
+}
+
+void ATimerComponent::CompRecycle()
+{
+
+}
+
+void ATimerComponent::CompRespawn()
+{
+
 }
 
 void ATimerComponent::AddTimer(std::string _name)
@@ -59,10 +70,10 @@ void ATimerComponent::AddTimer(std::string _name)
     t->Time = 0.f;
 
     mTimerArray.push_back(t);
-    mTimerMap.insert(std::make_pair(_name, t));
+    mTimerMap.Insert(InternStringID(_name), t);
 }
 
-void ATimerComponent::StartTimer(std::string _name)
+void ATimerComponent::StartTimer(StringID _name)
 {
     Timer* timer = GetTimer(_name);
     if (timer)
@@ -71,7 +82,7 @@ void ATimerComponent::StartTimer(std::string _name)
     }
 }
 
-void ATimerComponent::PauseTimer(std::string _name)
+void ATimerComponent::PauseTimer(StringID _name)
 {
     Timer* timer = GetTimer(_name);
     if (timer)
@@ -80,7 +91,7 @@ void ATimerComponent::PauseTimer(std::string _name)
     }
 }
 
-void ATimerComponent::ResetTimer(std::string _name)
+void ATimerComponent::ResetTimer(StringID _name)
 {
     Timer* timer = GetTimer(_name);
     if (timer)
@@ -89,13 +100,13 @@ void ATimerComponent::ResetTimer(std::string _name)
     }
 }
 
-void ATimerComponent::DeleteTimer(std::string _name)
+void ATimerComponent::DeleteTimer(StringID _name)
 {
     Timer* timer = GetTimer(_name);
     if (timer)
     {
         timer->Time = 0.f;
-        mTimerMap.erase(_name);
+        mTimerMap.Erase(_name);
     }
     else
     {
@@ -105,24 +116,30 @@ void ATimerComponent::DeleteTimer(std::string _name)
     for (auto iter = mTimerArray.begin();
         iter != mTimerArray.end(); iter++)
     {
-        if ((*iter)->Name == _name)
+        if ((*iter) == timer)
         {
-            Timer* p = (*iter);
-            delete p;
+            delete timer;
             mTimerArray.erase(iter);
             break;
         }
     }
 }
 
-Timer* ATimerComponent::GetTimer(std::string _name)
+Timer* ATimerComponent::GetTimer(StringID _name)
 {
-    if (mTimerMap.find(_name) == mTimerMap.end())
+    Timer** found = mTimerMap.Find(_name);
+    if (!found)
     {
         P_LOG(LOG_WARNING,
-            "cannot find this timer : [ %s ]\n", _name.c_str());
+            "cannot find this timer : [ %s ]\n",
+            _name.GetDebugString());
         return nullptr;
     }
 
-    return mTimerMap[_name];
+    return *found;
+}
+
+const std::vector<Timer*>* ATimerComponent::GetTimerArray() const
+{
+    return &mTimerArray;
 }
@@ -10,7 +10,7 @@
 #pragma once
 
 #include "AComponent.h"
-#include <unordered_map>
+#include "FlatIDMap.h"
 #include <vector>
 
 struct Timer
@@ -35,15 +35,17 @@ public:
 
     void AddTimer(std::string _name);
 
-    void StartTimer(std::string _name);
+    void StartTimer(StringID _name);
 
-    void PauseTimer(std::string _name);
+    void PauseTimer(StringID _name);
 
-    void ResetTimer(std::string _name);
+    void ResetTimer(StringID _name);
 
-    void DeleteTimer(std::string _name);
+    void DeleteTimer(StringID _name);
 
-    Timer* GetTimer(std::string _name);
+    Timer* GetTimer(StringID _name);
+
+    const std::vector<Timer*>* GetTimerArray() const;
 
 public:
     virtual void CompInit();
@@ -52,8 +54,12 @@ public:
 
     virtual void CompDestory();
 
+    virtual void CompRecycle();
+
+    virtual void CompRespawn();
+
 private:
-    std::unordered_map<std::string, Timer*> mTimerMap;
+    FlatIDMap<Timer*> mTimerMap;
 
     std::vector<Timer*> mTimerArray;
 };
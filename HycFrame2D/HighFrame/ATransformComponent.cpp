@@ -15,9 +15,10 @@ ATransformComponent::ATransformComponent(std::string _name,
     ActorObject* _owner, int _order, Float3 _initValue) :
     AComponent(_name, _owner, _order),
     mPosition(_initValue), mRotation(_initValue),
-    mScale(MakeFloat3(1.f, 1.f, 1.f)), mWorldMatrix(Matrix4x4f())
+    mScale(MakeFloat3(1.f, 1.f, 1.f)), mWorldMatrix(Matrix4x4f()),
+    mWorldDirtyFlg(true)
 {
-
+    SetCompNeedUpdate(false);
 }
 
 ATransformComponent::~ATransformComponent()
@@ -32,7 +33,7 @@ void ATransformComponent::CompInit()
 
 void ATransformComponent::CompUpdate(float _deltatime)
 {
-    UpdateWorldMatrix();
+
 }
 
 void ATransformComponent::CompDestory()
@@ -40,9 +41,32 @@ void ATransformComponent::CompDestory()
 
 }
 
+void ATransformComponent::CompRecycle()
+{
+
+}
+
+void ATransformComponent::CompRespawn()
+{
+
+}
+
+void ATransformComponent::MarkWorldDirty()
+{
+    mWorldDirtyFlg = true;
+
+    // the scene places a moved actor again in its spatial lists
+    ActorObject* owner = GetActorObjOwner();
+    if (owner->GetActorList() != ACTOR_LIST::UNLISTED)
+    {
+        owner->GetSceneNodePtr()->NotifyActorMoved(owner);
+    }
+}
+
 void ATransformComponent::SetPosition(Float3 _pos)
 {
     mPosition = _pos;
+    MarkWorldDirty();
 }
 
 Float3 ATransformComponent::GetPosition() const
@@ -53,6 +77,7 @@ Float3 ATransformComponent::GetPosition() const
 void ATransformComponent::SetRotation(Float3 _angle)
 {
     mRotation = _angle;
+    MarkWorldDirty();
 }
 
 Float3 ATransformComponent::GetRotation() const
@@ -63,6 +88,7 @@ Float3 ATransformComponent::GetRotation() const
 void ATransformComponent::SetScale(Float3 _factor)
 {
     mScale = _factor;
+    MarkWorldDirty();
 }
 
 Float3 ATransformComponent::GetScale() const
@@ -70,11 +96,21 @@ Float3 ATransformComponent::GetScale() const
     return mScale;
 }
 
-Matrix4x4f ATransformComponent::GetWorldMatrix() const
+Matrix4x4f ATransformComponent::GetWorldMatrix()
 {
+    if (mWorldDirtyFlg)
+    {
+        UpdateWorldMatrix();
+    }
+
     return mWorldMatrix;
 }
 
+bool ATransformComponent::IsWorldMatrixDirty() const
+{
+    return mWorldDirtyFlg;
+}
+
 void ATransformComponent::Translate(Float3 _pos)
 {
     if (GetActorObjOwner()->GetChildrenArray()->size())
@@ -118,6 +154,7 @@ void ATransformComponent::Translate(Float3 _pos)
     mPosition.x += _pos.x;
     mPosition.y += _pos.y;
     mPosition.z += _pos.z;
+    MarkWorldDirty();
 }
 
 void ATransformComponent::TranslateXAsix(float _posx)
@@ -161,6 +198,7 @@ void ATransformComponent::TranslateXAsix(float _posx)
     }
 
     mPosition.x += _posx;
+    MarkWorldDirty();
 }
 
 void ATransformComponent::TranslateYAsix(float _posy)
@@ -204,6 +242,7 @@ void ATransformComponent::TranslateYAsix(float _posy)
     }
 
     mPosition.y += _posy;
+    MarkWorldDirty();
 }
 
 void ATransformComponent::TranslateZAsix(float _posz)
@@ -247,6 +286,7 @@ void ATransformComponent::TranslateZAsix(float _posz)
     }
 
     mPosition.z += _posz;
+    MarkWorldDirty();
 }
 
 void ATransformComponent::Rotate(Float3 _angle)
@@ -292,6 +332,7 @@ void ATransformComponent::Rotate(Float3 _angle)
     mRotation.x += _angle.x;
     mRotation.y += _angle.y;
     mRotation.z += _angle.z;
+    MarkWorldDirty();
 }
 
 void ATransformComponent::RotateXAsix(float _anglex)
@@ -335,6 +376,7 @@ void ATransformComponent::RotateXAsix(float _anglex)
     }
 
     mRotation.x += _anglex;
+    MarkWorldDirty();
 }
 
 void ATransformComponent::RotateYAsix(float _angley)
@@ -378,6 +420,7 @@ void ATransformComponent::RotateYAsix(float _angley)
     }
 
     mRotation.y += _angley;
+    MarkWorldDirty();
 }
 
 void ATransformComponent::RotateZAsix(float _anglez)
@@ -421,6 +464,7 @@ void ATransformComponent::RotateZAsix(float _anglez)
     }
 
     mRotation.z += _anglez;
+    MarkWorldDirty();
 }
 
 void ATransformComponent::Scale(Float3 _factor)
@@ -466,6 +510,7 @@ void ATransformComponent::Scale(Float3 _factor)
     mScale.x *= _factor.x;
     mScale.y *= _factor.y;
     mScale.z *= _factor.z;
+    MarkWorldDirty();
 }
 
 void ATransformComponent::Scale(float _factor)
@@ -511,6 +556,7 @@ void ATransformComponent::Scale(float _factor)
     mScale.x *= _factor;
     mScale.y *= _factor;
     mScale.z *= _factor;
+    MarkWorldDirty();
 }
 
 void ATransformComponent::ScaleXAsix(float _factorx)
@@ -554,6 +600,7 @@ void ATransformComponent::ScaleXAsix(float _factorx)
     }
 
     mScale.x *= _factorx;
+    MarkWorldDirty();
 }
 
 void ATransformComponent::ScaleYAsix(float _factory)
@@ -597,6 +644,7 @@ void ATransformComponent::ScaleYAsix(float _factory)
     }
 
     mScale.y *= _factory;
+    MarkWorldDirty();
 }
 
 void ATransformComponent::ScaleZAsix(float _factorz)
@@ -640,6 +688,7 @@ void ATransformComponent::ScaleZAsix(float _factorz)
     }
 
     mScale.z *= _factorz;
+    MarkWorldDirty();
 }
 
 void ATransformComponent::UpdateWorldMatrix()
@@ -652,10 +701,6 @@ void ATransformComponent::UpdateWorldMatrix()
         0.f, 0.f, 0.f, 1.f
     };
 
-    Float3 relative = MakeFloat3(0.f, 0.f, 0.f);
-    relative = GetActorObjOwner()->GetSceneNodePtr()->
-        GetCamera()->GetRelativePosWithCam(mPosition);
-
     Float4x4 world = DirectX::XMLoadFloat4x4(&mWorldMatrix);
     static const float PI = 3.14156f;
     Float3 angle = MakeFloat3(
@@ -671,9 +716,10 @@ void ATransformComponent::UpdateWorldMatrix()
     world = DirectX::XMMatrixMultiply(
         world,
         DirectX::XMMatrixTranslation(
-            relative.x, relative.y, relative.z)
+            mPosition.x, mPosition.y, mPosition.z)
     );
     world = DirectX::XMMatrixTranspose(world);
 
     DirectX::XMStoreFloat4x4(&mWorldMatrix, world);
+    mWorldDirtyFlg = false;
 }
@@ -31,7 +31,9 @@ public:
 
     Float3 GetScale() const;
 
-    Matrix4x4f GetWorldMatrix() const;
+    Matrix4x4f GetWorldMatrix();
+
+    bool IsWorldMatrixDirty() const;
 
     void Translate(Float3 _pos);
 
@@ -62,6 +64,8 @@ public:
 private:
     void UpdateWorldMatrix();
 
+    void MarkWorldDirty();
+
 public:
     virtual void CompInit();
 
@@ -69,6 +73,10 @@ public:
 
     virtual void CompDestory();
 
+    virtual void CompRecycle();
+
+    virtual void CompRespawn();
+
 private:
     Float3 mPosition;
 
@@ -77,4 +85,6 @@ private:
     Float3 mScale;
 
     Matrix4x4f mWorldMatrix;
+
+    bool mWorldDirtyFlg;
 };
@@ -12,19 +12,30 @@
 #include "AComponent.h"
 #include "ASpriteComponent.h"
 #include "ACollisionComponent.h"
+#include "ATransformComponent.h"
+#include "Telemetry.h"
 
 ActorObject::ActorObject(std::string _name,
     class SceneNode* _scene, int _order) :
-    Object(_name, _scene, STATUS::NEED_INIT), mACompMap({}),
-    mACompArray({}), mActorUpdateOrder(_order),
-    mChildrenArray({}), mChildrenMap({}),
-    mSpriteCompArray({}), mParentActorObject(nullptr)
+    Object(_name, _scene, STATUS::NEED_INIT), mACompMap(),
+    mACompArray({}), mUpdateCompArray({}),
+    mUpdateListDirty(true), mActorUpdateOrder(_order),
+    mChildrenArray({}), mChildrenMap(),
+    mSpriteCompArray({}), mParentActorObject(nullptr),
+    mDormantPolicy(DORMANT_POLICY::ALWAYS_ACTIVE),
+    mDormantRate(1), mDormantCounter(0), mDormantDeltaTime(0.f),
+    mActorList(ACTOR_LIST::UNLISTED), mRegionTransform(nullptr),
+    mRecycleKey(""), mRecycledFlg(false), mTagArray({}),
+    mIndexSlotArray({}), mDrawVisibleFlg(false)
 {
-    mACompMap.clear();
+    mACompMap.Clear();
     mACompArray.clear();
+    mUpdateCompArray.clear();
     mSpriteCompArray.clear();
     mChildrenArray.clear();
-    mChildrenMap.clear();
+    mChildrenMap.Clear();
+    mTagArray.clear();
+    mIndexSlotArray.clear();
 }
 
 ActorObject::~ActorObject()
@@ -32,16 +43,18 @@ ActorObject::~ActorObject()
 
 }
 
-AComponent* ActorObject::GetAComponent(std::string _name)
+AComponent* ActorObject::GetAComponent(StringID _name)
 {
-    if (mACompMap.find(_name) == mACompMap.end())
+    AComponent** found = mACompMap.Find(_name);
+    if (!found)
     {
         P_LOG(LOG_MESSAGE,
-            "cannot find this Acomponent : [ %s ]\n", _name.c_str());
+            "cannot find this Acomponent : [ %s ]\n",
+            _name.GetDebugString());
         return nullptr;
     }
 
-    return mACompMap[_name];
+    return *found;
 }
 
 void ActorObject::AddAComponent(AComponent* _comp)
@@ -63,8 +76,8 @@ void ActorObject::AddAComponent(AComponent* _comp)
         mACompArray.push_back(_comp);
     }
 
-    mACompMap.insert(std::make_pair(
-        _comp->GetComponentName(), _comp));
+    mACompMap.Insert(_comp->GetComponentNameID(), _comp);
+    mUpdateListDirty = true;
 
     if (_comp->GetComponentName().find("sprite", 0) !=
         _comp->GetComponentName().npos)
@@ -94,13 +107,48 @@ int ActorObject::GetUpdateOrder() const
     return mActorUpdateOrder;
 }
 
+void ActorObject::SetObjectActive(STATUS _active)
+{
+    STATUS before = IsObjectActive();
+    Object::SetObjectActive(_active);
+
+    if (before != _active && mActorList != ACTOR_LIST::UNLISTED)
+    {
+        GetSceneNodePtr()->NotifyActorStatusChanged(this);
+    }
+}
+
 void ActorObject::Init()
 {
     for (auto& comp : mACompArray)
     {
-        comp->CompInit();
+        if (mRecycledFlg)
+        {
+            comp->CompRespawn();
+        }
+        else
+        {
+            comp->CompInit();
+        }
         comp->SetCompActive(STATUS::ACTIVE);
     }
+    mRecycledFlg = false;
+
+    mRegionTransform = nullptr;
+    AComponent** trans =
+        mACompMap.Find(GetObjectNameID().Append("-transform"));
+    if (!trans)
+    {
+        trans = mACompMap.Find(
+            GetObjectNameID().Append("-transform-1"));
+    }
+    if (trans)
+    {
+        mRegionTransform = (ATransformComponent*)(*trans);
+    }
+
+    mDormantCounter = 0;
+    mDormantDeltaTime = 0.f;
 }
 
 void ActorObject::Update(float _deltatime)
@@ -112,33 +160,62 @@ void ActorObject::UpdateComponents(float _deltatime)
 {
     if (IsObjectActive() == STATUS::ACTIVE)
     {
-        for (auto& comp : mACompArray)
+        if (mUpdateListDirty)
+        {
+            mUpdateCompArray.clear();
+            for (auto& comp : mACompArray)
+            {
+                if (comp->IsCompNeedUpdate())
+                {
+                    mUpdateCompArray.push_back(comp);
+                }
+            }
+            mUpdateListDirty = false;
+        }
+
+        unsigned int updateNum = 0;
+        for (auto& comp : mUpdateCompArray)
         {
             if (comp->IsCompActive() == STATUS::ACTIVE)
             {
                 comp->CompUpdate(_deltatime);
+                ++updateNum;
             }
         }
+        TELEMETRY_ADD(COMP_UPDATES, updateNum);
     }
 }
 
 void ActorObject::Destory()
 {
+    // a parked actor already ran its destroy when it was recycled,
+    // only the memory its components kept is left to free
     while (mACompArray.size())
     {
         auto comp = mACompArray.back();
-        comp->CompDestory();
+        if (!mRecycledFlg)
+        {
+            comp->CompDestory();
+        }
         delete comp;
         mACompArray.pop_back();
     }
 
-    mACompMap.clear();
+    mACompMap.Clear();
+
+    mUpdateCompArray.clear();
+
+    mUpdateListDirty = true;
 
     mSpriteCompArray.clear();
 
-    mChildrenMap.clear();
+    mChildrenMap.Clear();
 
     mChildrenArray.clear();
+
+    mTagArray.clear();
+
+    mIndexSlotArray.clear();
 }
 
 void ActorObject::AddChild(ActorObject* _obj)
@@ -147,8 +224,7 @@ void ActorObject::AddChild(ActorObject* _obj)
 
     mChildrenArray.push_back(_obj);
 
-    mChildrenMap.insert(std::make_pair(_obj->GetObjectName(),
-        _obj));
+    mChildrenMap.Insert(_obj->GetObjectNameID(), _obj);
 
     GetSceneNodePtr()->AddActorObject(_obj);
 }
@@ -163,24 +239,26 @@ void ActorObject::ClearParent()
     mParentActorObject = nullptr;
 }
 
-void ActorObject::ClearChild(std::string _name)
+void ActorObject::ClearChild(StringID _name)
 {
-    if (mChildrenMap.find(_name) == mChildrenMap.end())
+    ActorObject** found = mChildrenMap.Find(_name);
+    if (!found)
     {
         P_LOG(LOG_WARNING,
-            "cannot find this child : [ %s ]\n", _name.c_str());
+            "cannot find this child : [ %s ]\n",
+            _name.GetDebugString());
         return;
     }
 
-    if (mChildrenMap[_name]->GetChildrenArray()->size())
+    if ((*found)->GetChildrenArray()->size())
     {
-        mChildrenMap[_name]->ClearChildren();
+        (*found)->ClearChildren();
     }
 
     for (auto child = mChildrenArray.begin();
         child != mChildrenArray.end(); child++)
     {
-        if ((*child)->GetObjectName() == _name)
+        if ((*child)->GetObjectNameID() == _name)
         {
             (*child)->SetObjectActive(STATUS::PAUSE);
             mChildrenArray.erase(child);
@@ -188,7 +266,7 @@ void ActorObject::ClearChild(std::string _name)
         }
     }
 
-    mChildrenMap.erase(_name);
+    mChildrenMap.Erase(_name);
 }
 
 void ActorObject::ClearChildren()
@@ -204,19 +282,21 @@ void ActorObject::ClearChildren()
 
     mChildrenArray.clear();
 
-    mChildrenMap.clear();
+    mChildrenMap.Clear();
 }
 
-ActorObject* ActorObject::GetChild(std::string _name)
+ActorObject* ActorObject::GetChild(StringID _name)
 {
-    if (mChildrenMap.find(_name) == mChildrenMap.end())
+    ActorObject** found = mChildrenMap.Find(_name);
+    if (!found)
     {
         P_LOG(LOG_WARNING,
-            "cannot find this child : [ %s ]\n", _name.c_str());
+            "cannot find this child : [ %s ]\n",
+            _name.GetDebugString());
         return nullptr;
     }
 
-    return mChildrenMap[_name];
+    return *found;
 }
 
 std::vector<ActorObject*>* ActorObject::GetChildrenArray()
@@ -245,9 +325,194 @@ void ActorObject::Draw()
     }
 
     auto acc = (ACollisionComponent*)(GetAComponent(
-        GetObjectName() + "-collision"));
+        GetObjectNameID().Append("-collision")));
     if (acc && (acc->IsCompActive() == STATUS::ACTIVE))
     {
         acc->DrawACollision();
     }
 }
+
+
+void ActorObject::SetDormantPolicy(DORMANT_POLICY _policy,
+    unsigned int _rate)
+{
+    mDormantPolicy = _policy;
+    mDormantRate = _rate ? _rate : 1;
+}
+
+DORMANT_POLICY ActorObject::GetDormantPolicy() const
+{
+    return mDormantPolicy;
+}
+
+void ActorObject::SetActorList(ACTOR_LIST _list)
+{
+    if (_list == ACTOR_LIST::ACTIVE &&
+        mActorList == ACTOR_LIST::DORMANT)
+    {
+        mDormantCounter = 0;
+        mDormantDeltaTime = 0.f;
+    }
+
+    mActorList = _list;
+}
+
+ACTOR_LIST ActorObject::GetActorList() const
+{
+    return mActorList;
+}
+
+bool ActorObject::GetRegionPosition(Float2* _pos) const
+{
+    if (!mRegionTransform)
+    {
+        return false;
+    }
+
+    Float3 pos = mRegionTransform->GetPosition();
+    *_pos = MakeFloat2(pos.x, pos.y);
+
+    return true;
+}
+
+void ActorObject::UpdateDormant(float _deltatime)
+{
+    if (mDormantPolicy != DORMANT_POLICY::REDUCED)
+    {
+        return;
+    }
+
+    mDormantDeltaTime += _deltatime;
+    if (++mDormantCounter < mDormantRate)
+    {
+        return;
+    }
+
+    Update(mDormantDeltaTime);
+    UpdateComponents(mDormantDeltaTime);
+    mDormantCounter = 0;
+    mDormantDeltaTime = 0.f;
+}
+
+void ActorObject::MarkUpdateListDirty()
+{
+    mUpdateListDirty = true;
+}
+
+void ActorObject::SetRecycleKey(std::string _key)
+{
+    mRecycleKey = _key;
+}
+
+std::string ActorObject::GetRecycleKey() const
+{
+    return mRecycleKey;
+}
+
+void ActorObject::Recycle()
+{
+    if (mRecycledFlg)
+    {
+        return;
+    }
+
+    for (auto& comp : mACompArray)
+    {
+        comp->CompRecycle();
+        comp->SetCompActive(STATUS::NEED_INIT);
+    }
+    mRecycledFlg = true;
+}
+
+void ActorObject::AddTag(std::string _tag)
+{
+    if (mActorList != ACTOR_LIST::UNLISTED)
+    {
+        P_LOG(LOG_WARNING,
+            "tag added after init will not be indexed : [ %s ]\n",
+            _tag.c_str());
+    }
+
+    StringID tag = InternStringID(_tag);
+    if (!HasTag(tag))
+    {
+        mTagArray.push_back(tag);
+    }
+}
+
+bool ActorObject::HasTag(StringID _tag) const
+{
+    for (auto& tag : mTagArray)
+    {
+        if (tag == _tag)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const std::vector<StringID>* ActorObject::GetTagArray() const
+{
+    return &mTagArray;
+}
+
+bool ActorObject::HasAComponent(COMP_TYPE _type)
+{
+    switch (_type)
+    {
+    case COMP_TYPE::ATRANSFORM:
+        return mACompMap.Find(
+            GetObjectNameID().Append("-transform")) ||
+            mACompMap.Find(
+                GetObjectNameID().Append("-transform-1"));
+
+    case COMP_TYPE::ATIMER:
+        return mACompMap.Find(GetObjectNameID().Append("-timer"));
+
+    case COMP_TYPE::ASPRITE:
+        return !mSpriteCompArray.empty();
+
+    case COMP_TYPE::ACOLLISION:
+        return mACompMap.Find(
+            GetObjectNameID().Append("-collision"));
+
+    case COMP_TYPE::AINPUT:
+        return mACompMap.Find(GetObjectNameID().Append("-input"));
+
+    case COMP_TYPE::AANIMATE:
+        return mACompMap.Find(
+            GetObjectNameID().Append("-animate"));
+
+    case COMP_TYPE::AINTERACT:
+        return mACompMap.Find(
+            GetObjectNameID().Append("-interaction"));
+
+    case COMP_TYPE::ATILEMAP:
+        return mACompMap.Find(
+            GetObjectNameID().Append("-tilemap"));
+
+    case COMP_TYPE::APARTICLE:
+        return mACompMap.Find(
+            GetObjectNameID().Append("-particle"));
+
+    default:
+        return false;
+    }
+}
+
+std::vector<INDEX_SLOT>* ActorObject::GetIndexSlotArray()
+{
+    return &mIndexSlotArray;
+}
+
+void ActorObject::SetDrawVisible(bool _value)
+{
+    mDrawVisibleFlg = _value;
+}
+
+bool ActorObject::IsDrawVisible() const
+{
+    return mDrawVisibleFlg;
+}
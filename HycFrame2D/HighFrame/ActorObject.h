@@ -10,9 +10,26 @@
 #pragma once
 
 #include "Object.h"
+#include "FlatIDMap.h"
 #include <vector>
 #include <unordered_map>
 
+enum class ACTOR_LIST
+{
+    UNLISTED,
+    ACTIVE,
+    DORMANT,
+    PAUSED,
+    // out of every list, dropped from the scene arrays once a frame
+    RETIRED
+};
+
+struct INDEX_SLOT
+{
+    std::vector<class ActorObject*>* List;
+    size_t Slot;
+};
+
 class ActorObject :
     public Object
 {
@@ -21,42 +38,48 @@ public:
         class SceneNode* _scene, int _order);
     virtual ~ActorObject();
 
-    class AComponent* GetAComponent(std::string _name);
+    class AComponent* GetAComponent(StringID _name);
 
     template <typename T>
     inline T* GetAComponent(COMP_TYPE _type)
     {
-        static std::string compName = "";
-        compName = GetObjectName();
         switch (_type)
         {
         case COMP_TYPE::ATRANSFORM:
-            compName += "-transform";
-            return (T*)(GetAComponent(compName));
+            return (T*)(GetAComponent(
+                GetObjectNameID().Append("-transform")));
 
         case COMP_TYPE::ATIMER:
-            compName += "-timer";
-            return (T*)(GetAComponent(compName));
+            return (T*)(GetAComponent(
+                GetObjectNameID().Append("-timer")));
 
         case COMP_TYPE::ASPRITE:
-            compName += "-sprite";
-            return (T*)(GetAComponent(compName));
+            return (T*)(GetAComponent(
+                GetObjectNameID().Append("-sprite")));
 
         case COMP_TYPE::ACOLLISION:
-            compName += "-collision";
-            return (T*)(GetAComponent(compName));
+            return (T*)(GetAComponent(
+                GetObjectNameID().Append("-collision")));
 
         case COMP_TYPE::AINPUT:
-            compName += "-input";
-            return (T*)(GetAComponent(compName));
+            return (T*)(GetAComponent(
+                GetObjectNameID().Append("-input")));
 
         case COMP_TYPE::AANIMATE:
-            compName += "-animate";
-            return (T*)(GetAComponent(compName));
+            return (T*)(GetAComponent(
+                GetObjectNameID().Append("-animate")));
 
         case COMP_TYPE::AINTERACT:
-            compName += "-interaction";
-            return (T*)(GetAComponent(compName));
+            return (T*)(GetAComponent(
+                GetObjectNameID().Append("-interaction")));
+
+        case COMP_TYPE::ATILEMAP:
+            return (T*)(GetAComponent(
+                GetObjectNameID().Append("-tilemap")));
+
+        case COMP_TYPE::APARTICLE:
+            return (T*)(GetAComponent(
+                GetObjectNameID().Append("-particle")));
 
         default:
             P_LOG(LOG_ERROR,
@@ -75,11 +98,11 @@ public:
 
     void ClearParent();
 
-    void ClearChild(std::string _name);
+    void ClearChild(StringID _name);
 
     void ClearChildren();
 
-    ActorObject* GetChild(std::string _name);
+    ActorObject* GetChild(StringID _name);
 
     std::vector<ActorObject*>* GetChildrenArray();
 
@@ -89,7 +112,44 @@ public:
 
     void Draw();
 
+    void MarkUpdateListDirty();
+
+    void SetDormantPolicy(DORMANT_POLICY _policy,
+        unsigned int _rate);
+
+    DORMANT_POLICY GetDormantPolicy() const;
+
+    void SetActorList(ACTOR_LIST _list);
+
+    ACTOR_LIST GetActorList() const;
+
+    bool GetRegionPosition(Float2* _pos) const;
+
+    void UpdateDormant(float _deltatime);
+
+    void SetRecycleKey(std::string _key);
+
+    std::string GetRecycleKey() const;
+
+    void Recycle();
+
+    void AddTag(std::string _tag);
+
+    bool HasTag(StringID _tag) const;
+
+    const std::vector<StringID>* GetTagArray() const;
+
+    bool HasAComponent(COMP_TYPE _type);
+
+    std::vector<INDEX_SLOT>* GetIndexSlotArray();
+
+    void SetDrawVisible(bool _value);
+
+    bool IsDrawVisible() const;
+
 public:
+    virtual void SetObjectActive(STATUS _active);
+
     virtual void Init();
 
     virtual void Update(float _deltatime);
@@ -99,18 +159,44 @@ public:
     virtual void Destory();
 
 private:
-    std::unordered_map<std::string, class AComponent*> mACompMap;
+    FlatIDMap<class AComponent*> mACompMap;
 
     std::vector<class AComponent*> mACompArray;
 
+    std::vector<class AComponent*> mUpdateCompArray;
+
+    bool mUpdateListDirty;
+
     std::vector<class ASpriteComponent*> mSpriteCompArray;
 
     int mActorUpdateOrder;
 
     ActorObject* mParentActorObject;
 
-    std::unordered_map<std::string, ActorObject*> mChildrenMap;
+    FlatIDMap<ActorObject*> mChildrenMap;
 
     std::vector<ActorObject*> mChildrenArray;
+
+    DORMANT_POLICY mDormantPolicy;
+
+    unsigned int mDormantRate;
+
+    unsigned int mDormantCounter;
+
+    float mDormantDeltaTime;
+
+    ACTOR_LIST mActorList;
+
+    class ATransformComponent* mRegionTransform;
+
+    std::string mRecycleKey;
+
+    bool mRecycledFlg;
+
+    std::vector<StringID> mTagArray;
+
+    std::vector<INDEX_SLOT> mIndexSlotArray;
+
+    bool mDrawVisibleFlg;
 };
 
@@ -2,12 +2,15 @@
 
 #include "SceneManager.h"
 #include "SceneNode.h"
+#include "EventBus.h"
 #include "ObjectFactory.h"
 #include "ActorObject.h"
 #include "AAnimateComponent.h"
 #include "ACollisionComponent.h"
 #include "AInputComponent.h"
 #include "AInteractionComponent.h"
+#include "AParticleComponent.h"
 #include "ASpriteComponent.h"
+#include "ATilemapComponent.h"
 #include "ATimerComponent.h"
 #include "ATransformComponent.h"
@@ -0,0 +1,486 @@
+﻿//---------------------------------------------------------------
+// File: AssetArchive.cpp
+// Proj: HycFrame2D
+// Info: パックされたアセットアーカイブの形式と読み書き
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "AssetArchive.h"
+#include "StringID.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+// entries are compressed with a small lz4 style block codec:
+//   token (literal length << 4 | match length - 4)
+//   [extra literal length bytes] literals
+//   offset (u16) [extra match length bytes]
+// the last sequence only carries literals
+
+namespace
+{
+    const size_t MIN_MATCH = 4;
+    const size_t LAST_LITERALS = 5;
+    const unsigned int HASH_BITS = 12;
+
+    inline unsigned int Read32(const unsigned char* _ptr)
+    {
+        unsigned int value = 0;
+        memcpy(&value, _ptr, sizeof(value));
+        return value;
+    }
+
+    inline void WriteLength(std::vector<unsigned char>* _out,
+        size_t _length)
+    {
+        while (_length >= 255)
+        {
+            _out->push_back(255);
+            _length -= 255;
+        }
+        _out->push_back((unsigned char)_length);
+    }
+
+    inline bool ReadLength(const unsigned char** _ip,
+        const unsigned char* _end, size_t* _length)
+    {
+        unsigned char byte = 255;
+        while (byte == 255)
+        {
+            if (*_ip >= _end)
+            {
+                return false;
+            }
+            byte = *(*_ip)++;
+            *_length += byte;
+        }
+        return true;
+    }
+
+    void EmitSequence(std::vector<unsigned char>* _out,
+        const unsigned char* _literal, size_t _literalLen,
+        size_t _offset, size_t _matchLen)
+    {
+        unsigned char token = (unsigned char)
+            ((_literalLen >= 15 ? 15 : _literalLen) << 4);
+        if (_matchLen)
+        {
+            size_t extra = _matchLen - MIN_MATCH;
+            token |= (unsigned char)(extra >= 15 ? 15 : extra);
+        }
+        _out->push_back(token);
+        if (_literalLen >= 15)
+        {
+            WriteLength(_out, _literalLen - 15);
+        }
+        _out->insert(_out->end(), _literal, _literal + _literalLen);
+
+        if (!_matchLen)
+        {
+            return;
+        }
+        _out->push_back((unsigned char)(_offset & 0xFF));
+        _out->push_back((unsigned char)(_offset >> 8));
+        if (_matchLen - MIN_MATCH >= 15)
+        {
+            WriteLength(_out, _matchLen - MIN_MATCH - 15);
+        }
+    }
+}
+
+std::string NormalizeAssetPath(const std::string& _path)
+{
+    std::string path = _path;
+    for (auto& c : path)
+    {
+        if (c == '\\')
+        {
+            c = '/';
+        }
+    }
+
+    return path;
+}
+
+std::string MakeLooseAssetPath(const std::string& _path)
+{
+    std::string path = NormalizeAssetPath(_path);
+    size_t rom = path.find(":/");
+    if (rom != std::string::npos)
+    {
+        path.erase(rom, 1);
+    }
+
+    return path;
+}
+
+std::string MakeAssetPathKey(const std::string& _path)
+{
+    // the rom is authored on windows, a config saying .png has to find
+    // the .PNG next to it, so the key ignores ascii case
+    std::string path = NormalizeAssetPath(_path);
+    for (auto& c : path)
+    {
+        if (c >= 'A' && c <= 'Z')
+        {
+            c = c - 'A' + 'a';
+        }
+    }
+
+    return path;
+}
+
+unsigned long long MakeAssetPathID(const std::string& _path)
+{
+    return StringID(MakeAssetPathKey(_path).c_str()).GetValue();
+}
+
+size_t CompressAssetData(const unsigned char* _src, size_t _size,
+    std::vector<unsigned char>* _out)
+{
+    _out->clear();
+    _out->reserve(_size + _size / 255 + 16);
+
+    std::vector<unsigned int> table((size_t)1 << HASH_BITS,
+        0xFFFFFFFFu);
+    size_t anchor = 0;
+    size_t pos = 0;
+    size_t limit = _size > LAST_LITERALS + MIN_MATCH ?
+        _size - LAST_LITERALS : 0;
+
+    while (pos + MIN_MATCH <= limit)
+    {
+        unsigned int sequence = Read32(_src + pos);
+        unsigned int hash =
+            (sequence * 2654435761u) >> (32 - HASH_BITS);
+        unsigned int ref = table[hash];
+        table[hash] = (unsigned int)pos;
+
+        if (ref == 0xFFFFFFFFu || pos - ref > 0xFFFF ||
+            Read32(_src + ref) != sequence)
+        {
+            ++pos;
+            continue;
+        }
+
+        size_t length = MIN_MATCH;
+        while (pos + length < limit &&
+            _src[ref + length] == _src[pos + length])
+        {
+            ++length;
+        }
+
+        EmitSequence(_out, _src + anchor, pos - anchor, pos - ref,
+            length);
+        pos += length;
+        anchor = pos;
+    }
+
+    EmitSequence(_out, _src + anchor, _size - anchor, 0, 0);
+    return _out->size();
+}
+
+bool DecompressAssetData(const unsigned char* _src, size_t _size,
+    unsigned char* _dst, size_t _rawSize)
+{
+    const unsigned char* ip = _src;
+    const unsigned char* end = _src + _size;
+    size_t op = 0;
+
+    while (ip < end)
+    {
+        unsigned char token = *ip++;
+        size_t literalLen = token >> 4;
+        if (literalLen == 15 && !ReadLength(&ip, end, &literalLen))
+        {
+            return false;
+        }
+        if ((size_t)(end - ip) < literalLen ||
+            _rawSize - op < literalLen)
+        {
+            return false;
+        }
+        memcpy(_dst + op, ip, literalLen);
+        ip += literalLen;
+        op += literalLen;
+        if (ip == end)
+        {
+            break;
+        }
+
+        if (end - ip < 2)
+        {
+            return false;
+        }
+        size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        size_t matchLen = token & 0x0F;
+        if (matchLen == 15 && !ReadLength(&ip, end, &matchLen))
+        {
+            return false;
+        }
+        matchLen += MIN_MATCH;
+        if (!offset || offset > op || _rawSize - op < matchLen)
+        {
+            return false;
+        }
+
+        // byte by byte on purpose, matches may overlap themselves
+        const unsigned char* match = _dst + op - offset;
+        for (size_t i = 0; i < matchLen; i++)
+        {
+            _dst[op + i] = match[i];
+        }
+        op += matchLen;
+    }
+
+    return op == _rawSize;
+}
+
+AssetArchive::AssetArchive() :
+    mData(nullptr), mSize(0), mHeader(nullptr), mEntryArray(nullptr),
+    mNameTable(nullptr)
+{
+
+}
+
+AssetArchive::~AssetArchive()
+{
+
+}
+
+bool AssetArchive::OpenArchive(const unsigned char* _data,
+    size_t _size)
+{
+    CloseArchive();
+    if (!_data || _size < sizeof(ARCHIVE_HEADER))
+    {
+        return false;
+    }
+
+    const ARCHIVE_HEADER* header = (const ARCHIVE_HEADER*)_data;
+    unsigned long long indexEnd = header->IndexOffset +
+        (unsigned long long)header->EntryCount * sizeof(ARCHIVE_ENTRY);
+    if (header->Magic != ASSET_ARCHIVE_MAGIC ||
+        header->Version != ASSET_ARCHIVE_VERSION ||
+        indexEnd > _size ||
+        header->NameOffset + header->NameSize > _size)
+    {
+        return false;
+    }
+
+    const ARCHIVE_ENTRY* entries =
+        (const ARCHIVE_ENTRY*)(_data + header->IndexOffset);
+    for (unsigned int i = 0; i < header->EntryCount; i++)
+    {
+        if (entries[i].Offset + entries[i].StoredSize > _size ||
+            entries[i].NameOffset >= header->NameSize)
+        {
+            return false;
+        }
+    }
+
+    mData = _data;
+    mSize = _size;
+    mHeader = header;
+    mEntryArray = entries;
+    mNameTable = (const char*)(_data + header->NameOffset);
+    return true;
+}
+
+void AssetArchive::CloseArchive()
+{
+    mData = nullptr;
+    mSize = 0;
+    mHeader = nullptr;
+    mEntryArray = nullptr;
+    mNameTable = nullptr;
+}
+
+const ARCHIVE_ENTRY* AssetArchive::FindEntry(
+    unsigned long long _pathID) const
+{
+    if (!mHeader)
+    {
+        return nullptr;
+    }
+
+    const ARCHIVE_ENTRY* begin = mEntryArray;
+    const ARCHIVE_ENTRY* end = mEntryArray + mHeader->EntryCount;
+    const ARCHIVE_ENTRY* found = std::lower_bound(begin, end, _pathID,
+        [](const ARCHIVE_ENTRY& _entry, unsigned long long _id)
+        { return _entry.PathID < _id; });
+    if (found == end || found->PathID != _pathID)
+    {
+        return nullptr;
+    }
+
+    return found;
+}
+
+const unsigned char* AssetArchive::GetEntryData(
+    const ARCHIVE_ENTRY* _entry) const
+{
+    return mData + _entry->Offset;
+}
+
+const char* AssetArchive::GetEntryName(
+    const ARCHIVE_ENTRY* _entry) const
+{
+    return mNameTable + _entry->NameOffset;
+}
+
+unsigned int AssetArchive::GetEntryCount() const
+{
+    return mHeader ? mHeader->EntryCount : 0;
+}
+
+const ARCHIVE_ENTRY* AssetArchive::GetEntry(unsigned int _index) const
+{
+    return mEntryArray + _index;
+}
+
+AssetArchiveWriter::AssetArchiveWriter() :
+    mPendingArray({})
+{
+    mPendingArray.clear();
+}
+
+AssetArchiveWriter::~AssetArchiveWriter()
+{
+
+}
+
+bool AssetArchiveWriter::AddEntry(const std::string& _path,
+    std::vector<unsigned char>&& _data, bool _compress)
+{
+    PENDING_ENTRY pending = {};
+    pending.Path = NormalizeAssetPath(_path);
+    pending.Entry.PathID = MakeAssetPathID(pending.Path);
+    pending.Entry.RawSize = _data.size();
+    for (auto& exist : mPendingArray)
+    {
+        if (exist.Entry.PathID == pending.Entry.PathID)
+        {
+            return false;
+        }
+    }
+
+    std::vector<unsigned char> packed = {};
+    if (_compress && !_data.empty())
+    {
+        CompressAssetData(_data.data(), _data.size(), &packed);
+    }
+
+    // only keep the compressed form when it actually pays off
+    if (!packed.empty() && packed.size() < _data.size() * 9 / 10)
+    {
+        pending.Entry.Flags = ASSET_ENTRY_COMPRESSED;
+        pending.Data.swap(packed);
+    }
+    else
+    {
+        pending.Entry.Flags = 0;
+        pending.Data.swap(_data);
+    }
+    pending.Entry.StoredSize = pending.Data.size();
+    mPendingArray.push_back(std::move(pending));
+
+    return true;
+}
+
+bool AssetArchiveWriter::WriteArchive(const std::string& _file) const
+{
+    std::vector<const PENDING_ENTRY*> sorted = {};
+    for (auto& pending : mPendingArray)
+    {
+        sorted.push_back(&pending);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+        [](const PENDING_ENTRY* _a, const PENDING_ENTRY* _b)
+        { return _a->Entry.PathID < _b->Entry.PathID; });
+
+    auto align = [](unsigned long long _offset)
+    {
+        return (_offset + ASSET_ENTRY_ALIGNMENT - 1) &
+            ~(unsigned long long)(ASSET_ENTRY_ALIGNMENT - 1);
+    };
+
+    ARCHIVE_HEADER header = {};
+    header.Magic = ASSET_ARCHIVE_MAGIC;
+    header.Version = ASSET_ARCHIVE_VERSION;
+    header.EntryCount = (unsigned int)sorted.size();
+    header.Alignment = ASSET_ENTRY_ALIGNMENT;
+    header.IndexOffset = align(sizeof(ARCHIVE_HEADER));
+
+    std::vector<ARCHIVE_ENTRY> index = {};
+    std::string names = "";
+    unsigned long long offset = align(header.IndexOffset +
+        sorted.size() * sizeof(ARCHIVE_ENTRY));
+    for (auto pending : sorted)
+    {
+        ARCHIVE_ENTRY entry = pending->Entry;
+        entry.Offset = offset;
+        entry.NameOffset = (unsigned int)names.size();
+        names += pending->Path;
+        names.push_back('\0');
+        index.push_back(entry);
+        offset = align(offset + entry.StoredSize);
+    }
+    header.NameOffset = offset;
+    header.NameSize = names.size();
+
+    std::ofstream file(_file, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    const char padding[ASSET_ENTRY_ALIGNMENT] = {};
+    auto padTo = [&file, &padding](unsigned long long _offset)
+    {
+        unsigned long long now = (unsigned long long)file.tellp();
+        file.write(padding, (std::streamsize)(_offset - now));
+    };
+
+    file.write((const char*)&header, sizeof(header));
+    padTo(header.IndexOffset);
+    file.write((const char*)index.data(),
+        index.size() * sizeof(ARCHIVE_ENTRY));
+    for (size_t i = 0; i < sorted.size(); i++)
+    {
+        padTo(index[i].Offset);
+        file.write((const char*)sorted[i]->Data.data(),
+            sorted[i]->Data.size());
+    }
+    padTo(header.NameOffset);
+    file.write(names.data(), names.size());
+
+    return file.good();
+}
+
+unsigned int AssetArchiveWriter::GetEntryCount() const
+{
+    return (unsigned int)mPendingArray.size();
+}
+
+unsigned long long AssetArchiveWriter::GetRawTotal() const
+{
+    unsigned long long total = 0;
+    for (auto& pending : mPendingArray)
+    {
+        total += pending.Entry.RawSize;
+    }
+    return total;
+}
+
+unsigned long long AssetArchiveWriter::GetStoredTotal() const
+{
+    unsigned long long total = 0;
+    for (auto& pending : mPendingArray)
+    {
+        total += pending.Entry.StoredSize;
+    }
+    return total;
+}
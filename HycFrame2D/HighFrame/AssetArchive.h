@@ -0,0 +1,113 @@
+﻿//---------------------------------------------------------------
+// File: AssetArchive.h
+// Proj: HycFrame2D
+// Info: パックされたアセットアーカイブの形式と読み書き
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#define ASSET_ARCHIVE_MAGIC     (0x314B5048u)
+#define ASSET_ARCHIVE_VERSION   (2)
+#define ASSET_ENTRY_ALIGNMENT   (64)
+#define ASSET_ENTRY_COMPRESSED  (0x1u)
+
+struct ARCHIVE_HEADER
+{
+    unsigned int Magic;
+    unsigned int Version;
+    unsigned int EntryCount;
+    unsigned int Alignment;
+    unsigned long long IndexOffset;
+    unsigned long long NameOffset;
+    unsigned long long NameSize;
+};
+
+struct ARCHIVE_ENTRY
+{
+    unsigned long long PathID;
+    unsigned long long Offset;
+    unsigned long long StoredSize;
+    unsigned long long RawSize;
+    unsigned int Flags;
+    unsigned int NameOffset;
+};
+
+std::string NormalizeAssetPath(const std::string& _path);
+
+std::string MakeAssetPathKey(const std::string& _path);
+
+std::string MakeLooseAssetPath(const std::string& _path);
+
+unsigned long long MakeAssetPathID(const std::string& _path);
+
+size_t CompressAssetData(const unsigned char* _src, size_t _size,
+    std::vector<unsigned char>* _out);
+
+bool DecompressAssetData(const unsigned char* _src, size_t _size,
+    unsigned char* _dst, size_t _rawSize);
+
+class AssetArchive
+{
+public:
+    AssetArchive();
+    ~AssetArchive();
+
+    bool OpenArchive(const unsigned char* _data, size_t _size);
+
+    void CloseArchive();
+
+    const ARCHIVE_ENTRY* FindEntry(unsigned long long _pathID) const;
+
+    const unsigned char* GetEntryData(
+        const ARCHIVE_ENTRY* _entry) const;
+
+    const char* GetEntryName(const ARCHIVE_ENTRY* _entry) const;
+
+    unsigned int GetEntryCount() const;
+
+    const ARCHIVE_ENTRY* GetEntry(unsigned int _index) const;
+
+private:
+    const unsigned char* mData;
+
+    size_t mSize;
+
+    const ARCHIVE_HEADER* mHeader;
+
+    const ARCHIVE_ENTRY* mEntryArray;
+
+    const char* mNameTable;
+};
+
+class AssetArchiveWriter
+{
+public:
+    AssetArchiveWriter();
+    ~AssetArchiveWriter();
+
+    bool AddEntry(const std::string& _path,
+        std::vector<unsigned char>&& _data, bool _compress);
+
+    bool WriteArchive(const std::string& _file) const;
+
+    unsigned int GetEntryCount() const;
+
+    unsigned long long GetRawTotal() const;
+
+    unsigned long long GetStoredTotal() const;
+
+private:
+    struct PENDING_ENTRY
+    {
+        std::string Path;
+        ARCHIVE_ENTRY Entry;
+        std::vector<unsigned char> Data;
+    };
+
+    std::vector<PENDING_ENTRY> mPendingArray;
+};
@@ -0,0 +1,450 @@
+﻿//---------------------------------------------------------------
+// File: AudioMixer.cpp
+// Proj: HycFrame2D
+// Info: 仮想ボイスと優先度付きのソフトウェアミキサー
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "AudioMixer.h"
+#include "AudioSimd.h"
+#include "PrintLog.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    unsigned int GetVoiceIndex(VOICE_HANDLE _handle)
+    {
+        return (_handle & 0xFFFF) - 1;
+    }
+
+    VOICE_HANDLE MakeVoiceHandle(unsigned int _index,
+        unsigned int _generation)
+    {
+        return (_generation << 16) | (_index + 1);
+    }
+
+    // linear pan, the center keeps the full volume on both sides
+    void GetPanGain(const VOICE_DESC& _desc, float* _left,
+        float* _right)
+    {
+        float pan = std::clamp(_desc.Pan, -1.f, 1.f);
+        *_left = _desc.Volume * std::min(1.f, 1.f - pan);
+        *_right = _desc.Volume * std::min(1.f, 1.f + pan);
+    }
+}
+
+AudioMixer::AudioMixer() :
+    mVoiceLock(), mVoiceArray({}), mFreeArray({}), mActiveArray({}),
+    mSortArray({}), mScratchBuffer({}),
+    mRealVoiceLimit(AUDIO_REAL_VOICE_NUM), mMasterVolume(1.f),
+    mStartCounter(0), mStatistics({})
+{
+    mVoiceArray.clear();
+    mFreeArray.clear();
+    mActiveArray.clear();
+    mSortArray.clear();
+    mScratchBuffer.clear();
+
+    mVoiceArray.resize(AUDIO_MAX_VOICE_NUM);
+    mFreeArray.reserve(AUDIO_MAX_VOICE_NUM);
+    mActiveArray.reserve(AUDIO_MAX_VOICE_NUM);
+    mSortArray.reserve(AUDIO_MAX_VOICE_NUM);
+    for (unsigned int i = AUDIO_MAX_VOICE_NUM; i > 0; i--)
+    {
+        mVoiceArray[i - 1] = {};
+        mFreeArray.push_back(i - 1);
+    }
+    mScratchBuffer.resize(AUDIO_MIX_BLOCK_FRAMES * AUDIO_MIX_CHANNELS);
+}
+
+AudioMixer::~AudioMixer()
+{
+
+}
+
+void AudioMixer::SetRealVoiceLimit(unsigned int _limit)
+{
+    std::lock_guard<std::mutex> lock(mVoiceLock);
+    mRealVoiceLimit = _limit;
+}
+
+void AudioMixer::SetMasterVolume(float _volume)
+{
+    std::lock_guard<std::mutex> lock(mVoiceLock);
+    mMasterVolume = _volume;
+}
+
+VOICE_HANDLE AudioMixer::PlayVoice(const SoundClip* _clip,
+    const VOICE_DESC& _desc)
+{
+    if (!_clip || !_clip->GetFrameCount())
+    {
+        return NULL_VOICE_HANDLE;
+    }
+
+    std::lock_guard<std::mutex> lock(mVoiceLock);
+    if (mFreeArray.empty())
+    {
+        // the pool is full, steal the least important voice if the
+        // new one matters more
+        auto victim = std::min_element(
+            mActiveArray.begin(), mActiveArray.end(),
+            [this](unsigned int _a, unsigned int _b)
+            {
+                const MIXER_VOICE& a = mVoiceArray[_a];
+                const MIXER_VOICE& b = mVoiceArray[_b];
+                if (a.Desc.Priority != b.Desc.Priority)
+                {
+                    return a.Desc.Priority < b.Desc.Priority;
+                }
+                return a.StartOrder < b.StartOrder;
+            });
+        if (mVoiceArray[*victim].Desc.Priority > _desc.Priority)
+        {
+            return NULL_VOICE_HANDLE;
+        }
+        ReleaseVoice(*victim);
+        ++mStatistics.StolenVoices;
+    }
+
+    unsigned int index = mFreeArray.back();
+    mFreeArray.pop_back();
+    mActiveArray.push_back(index);
+
+    MIXER_VOICE& voice = mVoiceArray[index];
+    voice.Clip = _clip;
+    voice.Desc = _desc;
+    voice.Position = 0;
+    voice.StartOrder = mStartCounter++;
+    voice.LastGainL = 0.f;
+    voice.LastGainR = 0.f;
+    voice.State = VOICE_STATE::VIRTUAL;
+    mStatistics.PeakVoices = std::max(mStatistics.PeakVoices,
+        (unsigned int)mActiveArray.size());
+
+    return MakeVoiceHandle(index, voice.Generation);
+}
+
+void AudioMixer::StopVoice(VOICE_HANDLE _handle)
+{
+    std::lock_guard<std::mutex> lock(mVoiceLock);
+    if (FindVoice(_handle))
+    {
+        ReleaseVoice(GetVoiceIndex(_handle));
+    }
+}
+
+void AudioMixer::StopVoicesOfClip(const SoundClip* _clip)
+{
+    std::lock_guard<std::mutex> lock(mVoiceLock);
+    for (size_t i = mActiveArray.size(); i > 0; i--)
+    {
+        if (mVoiceArray[mActiveArray[i - 1]].Clip == _clip)
+        {
+            ReleaseVoice(mActiveArray[i - 1]);
+        }
+    }
+}
+
+void AudioMixer::StopAllVoices()
+{
+    std::lock_guard<std::mutex> lock(mVoiceLock);
+    while (!mActiveArray.empty())
+    {
+        ReleaseVoice(mActiveArray.back());
+    }
+}
+
+void AudioMixer::SetVoiceVolume(VOICE_HANDLE _handle, float _volume)
+{
+    std::lock_guard<std::mutex> lock(mVoiceLock);
+    MIXER_VOICE* voice = FindVoice(_handle);
+    if (voice)
+    {
+        voice->Desc.Volume = _volume;
+    }
+}
+
+VOICE_STATE AudioMixer::GetVoiceState(VOICE_HANDLE _handle)
+{
+    std::lock_guard<std::mutex> lock(mVoiceLock);
+    MIXER_VOICE* voice = FindVoice(_handle);
+    return voice ? voice->State : VOICE_STATE::STOPPED;
+}
+
+void AudioMixer::MixFrames(float* _out, unsigned int _frames)
+{
+    std::lock_guard<std::mutex> lock(mVoiceLock);
+    while (_frames)
+    {
+        unsigned int block = std::min(_frames,
+            (unsigned int)AUDIO_MIX_BLOCK_FRAMES);
+        MixBlock(_out, block);
+        _out += block * AUDIO_MIX_CHANNELS;
+        _frames -= block;
+    }
+}
+
+MIXER_STATISTICS AudioMixer::GetStatistics()
+{
+    std::lock_guard<std::mutex> lock(mVoiceLock);
+    return mStatistics;
+}
+
+AudioMixer::MIXER_VOICE* AudioMixer::FindVoice(VOICE_HANDLE _handle)
+{
+    unsigned int index = GetVoiceIndex(_handle);
+    if (_handle == NULL_VOICE_HANDLE || index >= AUDIO_MAX_VOICE_NUM)
+    {
+        return nullptr;
+    }
+
+    MIXER_VOICE& voice = mVoiceArray[index];
+    if (voice.State == VOICE_STATE::STOPPED ||
+        voice.Generation != (_handle >> 16))
+    {
+        return nullptr;
+    }
+
+    return &voice;
+}
+
+void AudioMixer::ReleaseVoice(unsigned int _index)
+{
+    MIXER_VOICE& voice = mVoiceArray[_index];
+    voice.State = VOICE_STATE::STOPPED;
+    voice.Clip = nullptr;
+    voice.Generation = (voice.Generation + 1) & 0xFFFF;
+
+    auto found = std::find(mActiveArray.begin(), mActiveArray.end(),
+        _index);
+    if (found != mActiveArray.end())
+    {
+        *found = mActiveArray.back();
+        mActiveArray.pop_back();
+    }
+    mFreeArray.push_back(_index);
+}
+
+void AudioMixer::SelectRealVoices()
+{
+    // quiet voices never take a real slot, the rest compete by
+    // priority, then by volume, then the newest one wins
+    mSortArray.clear();
+    for (auto index : mActiveArray)
+    {
+        MIXER_VOICE& voice = mVoiceArray[index];
+        voice.State = VOICE_STATE::VIRTUAL;
+        if (voice.Desc.Volume * mMasterVolume >= AUDIO_VIRTUAL_VOLUME)
+        {
+            mSortArray.push_back(index);
+        }
+    }
+
+    auto louder = [this](unsigned int _a, unsigned int _b)
+    {
+        const MIXER_VOICE& a = mVoiceArray[_a];
+        const MIXER_VOICE& b = mVoiceArray[_b];
+        if (a.Desc.Priority != b.Desc.Priority)
+        {
+            return a.Desc.Priority > b.Desc.Priority;
+        }
+        if (a.Desc.Volume != b.Desc.Volume)
+        {
+            return a.Desc.Volume > b.Desc.Volume;
+        }
+        return a.StartOrder > b.StartOrder;
+    };
+    size_t realCount = std::min(mSortArray.size(),
+        (size_t)mRealVoiceLimit);
+    if (realCount < mSortArray.size())
+    {
+        std::nth_element(mSortArray.begin(),
+            mSortArray.begin() + realCount, mSortArray.end(), louder);
+    }
+    for (size_t i = 0; i < realCount; i++)
+    {
+        mVoiceArray[mSortArray[i]].State = VOICE_STATE::REAL;
+    }
+}
+
+void AudioMixer::MixBlock(float* _out, unsigned int _frames)
+{
+    memset(_out, 0, sizeof(float) * _frames * AUDIO_MIX_CHANNELS);
+    SelectRealVoices();
+
+    unsigned int realCount = 0;
+    for (size_t i = mActiveArray.size(); i > 0; i--)
+    {
+        unsigned int index = mActiveArray[i - 1];
+        MIXER_VOICE& voice = mVoiceArray[index];
+        bool playing = false;
+        // a voice that just went virtual is still mixed for one block
+        // while its gain ramps down to zero
+        if (voice.State == VOICE_STATE::REAL ||
+            voice.LastGainL > 0.f || voice.LastGainR > 0.f)
+        {
+            playing = MixVoice(&voice, _out, _frames);
+            realCount += voice.State == VOICE_STATE::REAL ? 1 : 0;
+        }
+        else
+        {
+            playing = AdvanceVoice(&voice, _frames);
+        }
+
+        if (!playing)
+        {
+            ReleaseVoice(index);
+        }
+    }
+
+    ScaleAndClamp(_out, (size_t)_frames * AUDIO_MIX_CHANNELS,
+        mMasterVolume);
+    mStatistics.RealVoices = realCount;
+    mStatistics.VirtualVoices =
+        (unsigned int)mActiveArray.size() - realCount;
+    mStatistics.MixedFrames += _frames;
+}
+
+bool AudioMixer::MixVoice(MIXER_VOICE* _voice, float* _out,
+    unsigned int _frames)
+{
+    float targetL = 0.f;
+    float targetR = 0.f;
+    if (_voice->State == VOICE_STATE::REAL)
+    {
+        GetPanGain(_voice->Desc, &targetL, &targetR);
+    }
+    float stepL = (targetL - _voice->LastGainL) / (float)_frames;
+    float stepR = (targetR - _voice->LastGainR) / (float)_frames;
+    float gainL = _voice->LastGainL;
+    float gainR = _voice->LastGainR;
+    _voice->LastGainL = targetL;
+    _voice->LastGainR = targetR;
+
+    const SoundClip* clip = _voice->Clip;
+    size_t frameCount = clip->GetFrameCount();
+    unsigned int done = 0;
+    while (done < _frames)
+    {
+        unsigned int count = (unsigned int)std::min(
+            (size_t)(_frames - done), frameCount - _voice->Position);
+        clip->ReadFrames(_voice->Position, count,
+            mScratchBuffer.data());
+        AccumulateStereo(_out + done * AUDIO_MIX_CHANNELS,
+            mScratchBuffer.data(), count, gainL, gainR, stepL, stepR);
+        gainL += stepL * (float)count;
+        gainR += stepR * (float)count;
+        done += count;
+        _voice->Position += count;
+        if (_voice->Position >= frameCount)
+        {
+            if (!_voice->Desc.LoopFlg)
+            {
+                return false;
+            }
+            _voice->Position = 0;
+        }
+    }
+
+    return true;
+}
+
+bool AudioMixer::AdvanceVoice(MIXER_VOICE* _voice,
+    unsigned int _frames)
+{
+    size_t frameCount = _voice->Clip->GetFrameCount();
+    _voice->Position += _frames;
+    if (_voice->Position < frameCount)
+    {
+        return true;
+    }
+    if (!_voice->Desc.LoopFlg)
+    {
+        return false;
+    }
+
+    _voice->Position %= frameCount;
+    return true;
+}
+
+WavFileSink::WavFileSink() :
+    mFile(nullptr), mFrameCount(0)
+{
+
+}
+
+WavFileSink::~WavFileSink()
+{
+    CloseWavFile();
+}
+
+bool WavFileSink::OpenWavFile(std::string _file)
+{
+    CloseWavFile();
+#ifdef _WIN32
+    fopen_s(&mFile, _file.c_str(), "wb");
+#else
+    mFile = fopen(_file.c_str(), "wb");
+#endif // _WIN32
+    if (!mFile)
+    {
+        P_LOG(LOG_ERROR, "cannot create wav file : [ %s ]\n",
+            _file.c_str());
+        return false;
+    }
+
+    // the sizes are patched in when the file is closed
+    unsigned char header[44] = {};
+    fwrite(header, 1, sizeof(header), mFile);
+    mFrameCount = 0;
+
+    return true;
+}
+
+void WavFileSink::WriteFrames(const float* _frames, unsigned int _count)
+{
+    if (mFile)
+    {
+        fwrite(_frames, sizeof(float) * AUDIO_MIX_CHANNELS, _count,
+            mFile);
+        mFrameCount += _count;
+    }
+}
+
+void WavFileSink::CloseWavFile()
+{
+    if (!mFile)
+    {
+        return;
+    }
+
+    unsigned int blockAlign = sizeof(float) * AUDIO_MIX_CHANNELS;
+    unsigned int dataSize = (unsigned int)(mFrameCount * blockAlign);
+    unsigned int riffSize = dataSize + 36;
+    unsigned int fmtSize = 16;
+    unsigned short formatTag = 3;
+    unsigned short channels = AUDIO_MIX_CHANNELS;
+    unsigned int rate = AUDIO_MIX_RATE;
+    unsigned int byteRate = AUDIO_MIX_RATE * blockAlign;
+    unsigned short align = (unsigned short)blockAlign;
+    unsigned short bits = 32;
+
+    fseek(mFile, 0, SEEK_SET);
+    fwrite("RIFF", 1, 4, mFile);
+    fwrite(&riffSize, 4, 1, mFile);
+    fwrite("WAVEfmt ", 1, 8, mFile);
+    fwrite(&fmtSize, 4, 1, mFile);
+    fwrite(&formatTag, 2, 1, mFile);
+    fwrite(&channels, 2, 1, mFile);
+    fwrite(&rate, 4, 1, mFile);
+    fwrite(&byteRate, 4, 1, mFile);
+    fwrite(&align, 2, 1, mFile);
+    fwrite(&bits, 2, 1, mFile);
+    fwrite("data", 1, 4, mFile);
+    fwrite(&dataSize, 4, 1, mFile);
+    fclose(mFile);
+    mFile = nullptr;
+}
@@ -0,0 +1,142 @@
+﻿//---------------------------------------------------------------
+// File: AudioMixer.h
+// Proj: HycFrame2D
+// Info: 仮想ボイスと優先度付きのソフトウェアミキサー
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include "SoundClip.h"
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define AUDIO_MIX_BLOCK_FRAMES  (512)
+#define AUDIO_MAX_VOICE_NUM     (1024)
+#define AUDIO_REAL_VOICE_NUM    (32)
+#define AUDIO_VIRTUAL_VOLUME    (0.01f)
+#define AUDIO_PRIORITY_SE       (128)
+#define AUDIO_PRIORITY_BGM      (255)
+
+using VOICE_HANDLE = unsigned int;
+constexpr VOICE_HANDLE NULL_VOICE_HANDLE = 0;
+
+enum class VOICE_STATE
+{
+    STOPPED,
+    REAL,
+    VIRTUAL
+};
+
+struct VOICE_DESC
+{
+    float Volume = 1.f;
+    float Pan = 0.f;
+    unsigned int Priority = AUDIO_PRIORITY_SE;
+    bool LoopFlg = false;
+};
+
+struct MIXER_STATISTICS
+{
+    unsigned int RealVoices;
+    unsigned int VirtualVoices;
+    unsigned int PeakVoices;
+    unsigned long long StolenVoices;
+    unsigned long long MixedFrames;
+};
+
+class AudioMixer
+{
+public:
+    AudioMixer();
+    ~AudioMixer();
+
+    void SetRealVoiceLimit(unsigned int _limit);
+
+    void SetMasterVolume(float _volume);
+
+    VOICE_HANDLE PlayVoice(const SoundClip* _clip,
+        const VOICE_DESC& _desc);
+
+    void StopVoice(VOICE_HANDLE _handle);
+
+    void StopVoicesOfClip(const SoundClip* _clip);
+
+    void StopAllVoices();
+
+    void SetVoiceVolume(VOICE_HANDLE _handle, float _volume);
+
+    VOICE_STATE GetVoiceState(VOICE_HANDLE _handle);
+
+    void MixFrames(float* _out, unsigned int _frames);
+
+    MIXER_STATISTICS GetStatistics();
+
+private:
+    struct MIXER_VOICE
+    {
+        const SoundClip* Clip;
+        VOICE_DESC Desc;
+        size_t Position;
+        unsigned long long StartOrder;
+        float LastGainL;
+        float LastGainR;
+        unsigned int Generation;
+        VOICE_STATE State;
+    };
+
+    MIXER_VOICE* FindVoice(VOICE_HANDLE _handle);
+
+    void ReleaseVoice(unsigned int _index);
+
+    void SelectRealVoices();
+
+    void MixBlock(float* _out, unsigned int _frames);
+
+    bool MixVoice(MIXER_VOICE* _voice, float* _out,
+        unsigned int _frames);
+
+    bool AdvanceVoice(MIXER_VOICE* _voice, unsigned int _frames);
+
+private:
+    std::mutex mVoiceLock;
+
+    std::vector<MIXER_VOICE> mVoiceArray;
+
+    std::vector<unsigned int> mFreeArray;
+
+    std::vector<unsigned int> mActiveArray;
+
+    std::vector<unsigned int> mSortArray;
+
+    std::vector<float> mScratchBuffer;
+
+    unsigned int mRealVoiceLimit;
+
+    float mMasterVolume;
+
+    unsigned long long mStartCounter;
+
+    MIXER_STATISTICS mStatistics;
+};
+
+class WavFileSink
+{
+public:
+    WavFileSink();
+    ~WavFileSink();
+
+    bool OpenWavFile(std::string _file);
+
+    void WriteFrames(const float* _frames, unsigned int _count);
+
+    void CloseWavFile();
+
+private:
+    FILE* mFile;
+
+    unsigned long long mFrameCount;
+};
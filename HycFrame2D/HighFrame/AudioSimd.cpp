@@ -0,0 +1,274 @@
+﻿//---------------------------------------------------------------
+// File: AudioSimd.cpp
+// Proj: HycFrame2D
+// Info: ミキサー用のSIMDサンプル処理
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "AudioSimd.h"
+#include "SoundCodec.h"
+
+#ifdef AUDIO_SIMD_SSE2
+#include <emmintrin.h>
+#endif // AUDIO_SIMD_SSE2
+
+namespace
+{
+    const float PCM16_SCALE = 1.f / 32768.f;
+
+    void DecodeAdpcmBlock(const unsigned char* _src, short* _dst)
+    {
+        int predictor = (short)(_src[0] | (_src[1] << 8));
+        int index = _src[2] < ADPCM_STEP_NUM ? _src[2] : 0;
+        for (int i = 0; i < ADPCM_BLOCK_FRAMES; i++)
+        {
+            int nibble = (_src[4 + i / 2] >> ((i & 1) * 4)) & 0xF;
+            int step = ADPCM_STEP_TABLE[index];
+            int delta = step >> 3;
+            delta += (nibble & 4) ? step : 0;
+            delta += (nibble & 2) ? (step >> 1) : 0;
+            delta += (nibble & 1) ? (step >> 2) : 0;
+            predictor += (nibble & 8) ? -delta : delta;
+            predictor = predictor > 32767 ? 32767 :
+                (predictor < -32768 ? -32768 : predictor);
+            index += ADPCM_INDEX_TABLE[nibble & 7];
+            index = index < 0 ? 0 :
+                (index >= ADPCM_STEP_NUM ? ADPCM_STEP_NUM - 1 : index);
+            _dst[i] = (short)predictor;
+        }
+    }
+
+#ifdef AUDIO_SIMD_SSE2
+    // four independent blocks run side by side, one per lane, only
+    // the step table lookup stays scalar
+    void DecodeAdpcmBlock4(const unsigned char* _src, short* _dst)
+    {
+        alignas(16) int index[4] = {};
+        alignas(16) short output[ADPCM_BLOCK_FRAMES * 4] = {};
+        int predictor[4] = {};
+        for (int l = 0; l < 4; l++)
+        {
+            const unsigned char* block = _src + l * ADPCM_BLOCK_BYTES;
+            predictor[l] = (short)(block[0] | (block[1] << 8));
+            index[l] = block[2] < ADPCM_STEP_NUM ? block[2] : 0;
+        }
+
+        const __m128i one = _mm_set1_epi32(1);
+        const __m128i two = _mm_set1_epi32(2);
+        const __m128i three = _mm_set1_epi32(3);
+        const __m128i four = _mm_set1_epi32(4);
+        const __m128i eight = _mm_set1_epi32(8);
+        const __m128i maxIndex = _mm_set1_epi32(ADPCM_STEP_NUM - 1);
+        __m128i pred = _mm_setr_epi32(predictor[0], predictor[1],
+            predictor[2], predictor[3]);
+        __m128i idx = _mm_load_si128((const __m128i*)index);
+        for (int i = 0; i < ADPCM_BLOCK_FRAMES; i++)
+        {
+            int shift = (i & 1) * 4;
+            const unsigned char* bytes = _src + 4 + i / 2;
+            __m128i nibble = _mm_and_si128(_mm_setr_epi32(
+                bytes[0] >> shift,
+                bytes[ADPCM_BLOCK_BYTES] >> shift,
+                bytes[ADPCM_BLOCK_BYTES * 2] >> shift,
+                bytes[ADPCM_BLOCK_BYTES * 3] >> shift),
+                _mm_set1_epi32(0xF));
+            __m128i step = _mm_setr_epi32(
+                ADPCM_STEP_TABLE[index[0]], ADPCM_STEP_TABLE[index[1]],
+                ADPCM_STEP_TABLE[index[2]], ADPCM_STEP_TABLE[index[3]]);
+
+            __m128i has4 = _mm_cmpeq_epi32(
+                _mm_and_si128(nibble, four), four);
+            __m128i has2 = _mm_cmpeq_epi32(
+                _mm_and_si128(nibble, two), two);
+            __m128i has1 = _mm_cmpeq_epi32(
+                _mm_and_si128(nibble, one), one);
+            __m128i delta = _mm_srai_epi32(step, 3);
+            delta = _mm_add_epi32(delta, _mm_and_si128(has4, step));
+            delta = _mm_add_epi32(delta,
+                _mm_and_si128(has2, _mm_srai_epi32(step, 1)));
+            delta = _mm_add_epi32(delta,
+                _mm_and_si128(has1, _mm_srai_epi32(step, 2)));
+            __m128i sign = _mm_cmpeq_epi32(
+                _mm_and_si128(nibble, eight), eight);
+            delta = _mm_sub_epi32(_mm_xor_si128(delta, sign), sign);
+
+            // saturating pack does the 16 bit clamp
+            __m128i packed = _mm_packs_epi32(
+                _mm_add_epi32(pred, delta), _mm_setzero_si128());
+            pred = _mm_srai_epi32(
+                _mm_unpacklo_epi16(packed, packed), 16);
+            _mm_storel_epi64((__m128i*)(output + i * 4), packed);
+
+            // index table is -1 for 0..3 and (n & 3 + 1) * 2 above
+            __m128i up = _mm_slli_epi32(_mm_add_epi32(
+                _mm_and_si128(nibble, three), one), 1);
+            idx = _mm_add_epi32(idx, _mm_or_si128(
+                _mm_and_si128(has4, up),
+                _mm_andnot_si128(has4, _mm_set1_epi32(-1))));
+            idx = _mm_andnot_si128(
+                _mm_cmplt_epi32(idx, _mm_setzero_si128()), idx);
+            __m128i over = _mm_cmpgt_epi32(idx, maxIndex);
+            idx = _mm_or_si128(_mm_and_si128(over, maxIndex),
+                _mm_andnot_si128(over, idx));
+            _mm_store_si128((__m128i*)index, idx);
+        }
+
+        for (int l = 0; l < 4; l++)
+        {
+            short* dst = _dst + l * ADPCM_BLOCK_FRAMES;
+            for (int i = 0; i < ADPCM_BLOCK_FRAMES; i++)
+            {
+                dst[i] = output[i * 4 + l];
+            }
+        }
+    }
+#endif // AUDIO_SIMD_SSE2
+}
+
+void ConvertPcm16ToFloat(const short* _src, size_t _count,
+    float* _dst)
+{
+    size_t i = 0;
+#ifdef AUDIO_SIMD_SSE2
+    const __m128 scale = _mm_set1_ps(PCM16_SCALE);
+    for (; i + 8 <= _count; i += 8)
+    {
+        __m128i packed = _mm_loadu_si128((const __m128i*)(_src + i));
+        // sign extension by shifting the shorts into the high half
+        __m128i low = _mm_srai_epi32(
+            _mm_unpacklo_epi16(packed, packed), 16);
+        __m128i high = _mm_srai_epi32(
+            _mm_unpackhi_epi16(packed, packed), 16);
+        _mm_storeu_ps(_dst + i,
+            _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+        _mm_storeu_ps(_dst + i + 4,
+            _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+    }
+#endif // AUDIO_SIMD_SSE2
+    for (; i < _count; i++)
+    {
+        _dst[i] = (float)_src[i] * PCM16_SCALE;
+    }
+}
+
+void ConvertMonoPcm16ToStereo(const short* _src, size_t _frames,
+    float* _dst)
+{
+    size_t i = 0;
+#ifdef AUDIO_SIMD_SSE2
+    const __m128 scale = _mm_set1_ps(PCM16_SCALE);
+    for (; i + 4 <= _frames; i += 4)
+    {
+        __m128i packed = _mm_loadl_epi64((const __m128i*)(_src + i));
+        __m128 mono = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(
+            _mm_unpacklo_epi16(packed, packed), 16)), scale);
+        _mm_storeu_ps(_dst + i * 2, _mm_unpacklo_ps(mono, mono));
+        _mm_storeu_ps(_dst + i * 2 + 4, _mm_unpackhi_ps(mono, mono));
+    }
+#endif // AUDIO_SIMD_SSE2
+    for (; i < _frames; i++)
+    {
+        float value = (float)_src[i] * PCM16_SCALE;
+        _dst[i * 2] = value;
+        _dst[i * 2 + 1] = value;
+    }
+}
+
+void InterleavePcm16ToStereo(const short* _left, const short* _right,
+    size_t _frames, float* _dst)
+{
+    size_t i = 0;
+#ifdef AUDIO_SIMD_SSE2
+    const __m128 scale = _mm_set1_ps(PCM16_SCALE);
+    for (; i + 4 <= _frames; i += 4)
+    {
+        __m128i left = _mm_loadl_epi64((const __m128i*)(_left + i));
+        __m128i right = _mm_loadl_epi64((const __m128i*)(_right + i));
+        __m128i pairs = _mm_unpacklo_epi16(left, right);
+        __m128i low = _mm_srai_epi32(
+            _mm_unpacklo_epi16(pairs, pairs), 16);
+        __m128i high = _mm_srai_epi32(
+            _mm_unpackhi_epi16(pairs, pairs), 16);
+        _mm_storeu_ps(_dst + i * 2,
+            _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+        _mm_storeu_ps(_dst + i * 2 + 4,
+            _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+    }
+#endif // AUDIO_SIMD_SSE2
+    for (; i < _frames; i++)
+    {
+        _dst[i * 2] = (float)_left[i] * PCM16_SCALE;
+        _dst[i * 2 + 1] = (float)_right[i] * PCM16_SCALE;
+    }
+}
+
+void DecodeAdpcmBlocks(const unsigned char* _src, size_t _blockCount,
+    short* _dst)
+{
+    size_t i = 0;
+#ifdef AUDIO_SIMD_SSE2
+    for (; i + 4 <= _blockCount; i += 4)
+    {
+        DecodeAdpcmBlock4(_src + i * ADPCM_BLOCK_BYTES,
+            _dst + i * ADPCM_BLOCK_FRAMES);
+    }
+#endif // AUDIO_SIMD_SSE2
+    for (; i < _blockCount; i++)
+    {
+        DecodeAdpcmBlock(_src + i * ADPCM_BLOCK_BYTES,
+            _dst + i * ADPCM_BLOCK_FRAMES);
+    }
+}
+
+void AccumulateStereo(float* _dst, const float* _src, size_t _frames,
+    float _gainL, float _gainR, float _stepL, float _stepR)
+{
+    size_t i = 0;
+#ifdef AUDIO_SIMD_SSE2
+    // two stereo frames per register, the gain ramps by one step
+    // per frame so that volume changes don't click
+    __m128 gain = _mm_setr_ps(_gainL, _gainR,
+        _gainL + _stepL, _gainR + _stepR);
+    const __m128 step = _mm_setr_ps(_stepL * 2.f, _stepR * 2.f,
+        _stepL * 2.f, _stepR * 2.f);
+    for (; i + 2 <= _frames; i += 2)
+    {
+        __m128 src = _mm_loadu_ps(_src + i * 2);
+        __m128 dst = _mm_loadu_ps(_dst + i * 2);
+        _mm_storeu_ps(_dst + i * 2,
+            _mm_add_ps(dst, _mm_mul_ps(src, gain)));
+        gain = _mm_add_ps(gain, step);
+    }
+    _gainL += _stepL * (float)i;
+    _gainR += _stepR * (float)i;
+#endif // AUDIO_SIMD_SSE2
+    for (; i < _frames; i++)
+    {
+        _dst[i * 2] += _src[i * 2] * _gainL;
+        _dst[i * 2 + 1] += _src[i * 2 + 1] * _gainR;
+        _gainL += _stepL;
+        _gainR += _stepR;
+    }
+}
+
+void ScaleAndClamp(float* _buffer, size_t _count, float _gain)
+{
+    size_t i = 0;
+#ifdef AUDIO_SIMD_SSE2
+    const __m128 gain = _mm_set1_ps(_gain);
+    const __m128 maxValue = _mm_set1_ps(1.f);
+    const __m128 minValue = _mm_set1_ps(-1.f);
+    for (; i + 4 <= _count; i += 4)
+    {
+        __m128 value = _mm_mul_ps(_mm_loadu_ps(_buffer + i), gain);
+        value = _mm_min_ps(_mm_max_ps(value, minValue), maxValue);
+        _mm_storeu_ps(_buffer + i, value);
+    }
+#endif // AUDIO_SIMD_SSE2
+    for (; i < _count; i++)
+    {
+        float value = _buffer[i] * _gain;
+        _buffer[i] = value > 1.f ? 1.f : (value < -1.f ? -1.f : value);
+    }
+}
@@ -0,0 +1,32 @@
+﻿//---------------------------------------------------------------
+// File: AudioSimd.h
+// Proj: HycFrame2D
+// Info: ミキサー用のSIMDサンプル処理
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define AUDIO_SIMD_SSE2
+#endif
+
+void ConvertPcm16ToFloat(const short* _src, size_t _count,
+    float* _dst);
+
+void ConvertMonoPcm16ToStereo(const short* _src, size_t _frames,
+    float* _dst);
+
+void InterleavePcm16ToStereo(const short* _left, const short* _right,
+    size_t _frames, float* _dst);
+
+void DecodeAdpcmBlocks(const unsigned char* _src, size_t _blockCount,
+    short* _dst);
+
+void AccumulateStereo(float* _dst, const float* _src, size_t _frames,
+    float _gainL, float _gainR, float _stepL, float _stepR);
+
+void ScaleAndClamp(float* _buffer, size_t _count, float _gain);
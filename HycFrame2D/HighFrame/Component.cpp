@@ -10,7 +10,8 @@
 #include "Component.h"
 
 Component::Component(std::string _name, STATUS _active) :
-    mName(_name), mActive(_active)
+    mName(_name), mNameID(InternStringID(_name)),
+    mActive(_active), mNeedUpdate(true)
 {
 
 }
@@ -20,11 +21,16 @@ Component::~Component()
 
 }
 
-std::string Component::GetComponentName() const
+const std::string& Component::GetComponentName() const
 {
     return mName;
 }
 
+StringID Component::GetComponentNameID() const
+{
+    return mNameID;
+}
+
 STATUS Component::IsCompActive() const
 {
     return mActive;
@@ -32,5 +38,33 @@ STATUS Component::IsCompActive() const
 
 void Component::SetCompActive(STATUS _active)
 {
-    mActive = _active;
+    if (mActive != _active)
+    {
+        mActive = _active;
+        OnCompActiveChanged();
+    }
+}
+
+bool Component::IsCompNeedUpdate() const
+{
+    return mNeedUpdate;
+}
+
+void Component::SetCompNeedUpdate(bool _needUpdate)
+{
+    if (mNeedUpdate != _needUpdate)
+    {
+        mNeedUpdate = _needUpdate;
+        OnNeedUpdateChanged();
+    }
+}
+
+void Component::OnNeedUpdateChanged()
+{
+
+}
+
+void Component::OnCompActiveChanged()
+{
+
 }
@@ -11,6 +11,7 @@
 
 #include <string>
 #include "HFCommon.h"
+#include "StringID.h"
 
 class Component
 {
@@ -18,12 +19,23 @@ public:
     Component(std::string _name, STATUS _active);
     virtual ~Component();
 
-    std::string GetComponentName() const;
+    const std::string& GetComponentName() const;
+
+    StringID GetComponentNameID() const;
 
     STATUS IsCompActive() const;
 
     void SetCompActive(STATUS _active);
 
+    bool IsCompNeedUpdate() const;
+
+    void SetCompNeedUpdate(bool _needUpdate);
+
+protected:
+    virtual void OnNeedUpdateChanged();
+
+    virtual void OnCompActiveChanged();
+
 public:
     virtual void CompInit() = 0;
 
@@ -34,6 +46,10 @@ public:
 private:
     const std::string mName;
 
+    const StringID mNameID;
+
     STATUS mActive;
+
+    bool mNeedUpdate;
 };
 
@@ -0,0 +1,271 @@
+﻿//---------------------------------------------------------------
+// File: DdsTexture.cpp
+// Proj: HycFrame2D
+// Info: ブロック圧縮テクスチャ(DDS)の形式と読み書き
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "DdsTexture.h"
+#include <cstring>
+
+#define DDS_FOURCC(a, b, c, d) \
+    ((unsigned int)(a) | ((unsigned int)(b) << 8) | \
+    ((unsigned int)(c) << 16) | ((unsigned int)(d) << 24))
+
+namespace
+{
+    const unsigned int DDSD_CAPS = 0x1;
+    const unsigned int DDSD_HEIGHT = 0x2;
+    const unsigned int DDSD_WIDTH = 0x4;
+    const unsigned int DDSD_PIXELFORMAT = 0x1000;
+    const unsigned int DDSD_MIPMAPCOUNT = 0x20000;
+    const unsigned int DDSD_LINEARSIZE = 0x80000;
+    const unsigned int DDPF_FOURCC = 0x4;
+    const unsigned int DDSCAPS_COMPLEX = 0x8;
+    const unsigned int DDSCAPS_TEXTURE = 0x1000;
+    const unsigned int DDSCAPS_MIPMAP = 0x400000;
+
+    // same values as DXGI_FORMAT, kept here so that the cooker
+    // doesn't need any d3d header
+    const unsigned int DXGI_BC1_UNORM = 71;
+    const unsigned int DXGI_BC3_UNORM = 77;
+    const unsigned int DXGI_BC7_UNORM = 98;
+
+    struct DDS_PIXELFORMAT
+    {
+        unsigned int Size;
+        unsigned int Flags;
+        unsigned int FourCC;
+        unsigned int RGBBitCount;
+        unsigned int RBitMask;
+        unsigned int GBitMask;
+        unsigned int BBitMask;
+        unsigned int ABitMask;
+    };
+
+    struct DDS_HEADER
+    {
+        unsigned int Size;
+        unsigned int Flags;
+        unsigned int Height;
+        unsigned int Width;
+        unsigned int PitchOrLinearSize;
+        unsigned int Depth;
+        unsigned int MipMapCount;
+        unsigned int Reserved1[11];
+        DDS_PIXELFORMAT PixelFormat;
+        unsigned int Caps;
+        unsigned int Caps2;
+        unsigned int Caps3;
+        unsigned int Caps4;
+        unsigned int Reserved2;
+    };
+
+    struct DDS_HEADER_DXT10
+    {
+        unsigned int DxgiFormat;
+        unsigned int ResourceDimension;
+        unsigned int MiscFlag;
+        unsigned int ArraySize;
+        unsigned int MiscFlags2;
+    };
+
+    static_assert(sizeof(DDS_HEADER) == DDS_HEADER_SIZE,
+        "dds header layout mismatch");
+    static_assert(sizeof(DDS_HEADER_DXT10) == DDS_DX10_HEADER_SIZE,
+        "dds dx10 header layout mismatch");
+
+    DDS_FORMAT GetFormatFromDxgi(unsigned int _dxgi)
+    {
+        switch (_dxgi)
+        {
+        case DXGI_BC1_UNORM: return DDS_FORMAT::BC1;
+        case DXGI_BC3_UNORM: return DDS_FORMAT::BC3;
+        case DXGI_BC7_UNORM: return DDS_FORMAT::BC7;
+        default: return DDS_FORMAT::UNKNOWN;
+        }
+    }
+}
+
+std::string MakeCookedTexturePath(const std::string& _path)
+{
+    size_t dot = _path.find_last_of('.');
+    size_t slash = _path.find_last_of("/\\");
+    if (dot == std::string::npos ||
+        (slash != std::string::npos && dot < slash))
+    {
+        return _path + ".dds";
+    }
+
+    return _path.substr(0, dot) + ".dds";
+}
+
+unsigned int GetDdsBlockBytes(DDS_FORMAT _format)
+{
+    switch (_format)
+    {
+    case DDS_FORMAT::BC1: return 8;
+    case DDS_FORMAT::BC3: return 16;
+    case DDS_FORMAT::BC7: return 16;
+    default: return 0;
+    }
+}
+
+size_t GetDdsLevelPitch(DDS_FORMAT _format, unsigned int _width)
+{
+    size_t blocks = (_width + 3) / 4;
+    if (!blocks)
+    {
+        blocks = 1;
+    }
+
+    return blocks * GetDdsBlockBytes(_format);
+}
+
+size_t GetDdsLevelSize(DDS_FORMAT _format, unsigned int _width,
+    unsigned int _height)
+{
+    size_t rows = (_height + 3) / 4;
+    if (!rows)
+    {
+        rows = 1;
+    }
+
+    return rows * GetDdsLevelPitch(_format, _width);
+}
+
+bool ParseDdsTexture(const unsigned char* _data, size_t _size,
+    DDS_TEXTURE_INFO* _info)
+{
+    unsigned int magic = 0;
+    DDS_HEADER header = {};
+    if (_size < sizeof(magic) + sizeof(header))
+    {
+        return false;
+    }
+    memcpy(&magic, _data, sizeof(magic));
+    memcpy(&header, _data + sizeof(magic), sizeof(header));
+    if (magic != DDS_MAGIC || header.Size != DDS_HEADER_SIZE ||
+        !(header.PixelFormat.Flags & DDPF_FOURCC))
+    {
+        return false;
+    }
+
+    size_t offset = sizeof(magic) + sizeof(header);
+    DDS_FORMAT format = DDS_FORMAT::UNKNOWN;
+    unsigned int fourCC = header.PixelFormat.FourCC;
+    if (fourCC == DDS_FOURCC('D', 'X', 'T', '1'))
+    {
+        format = DDS_FORMAT::BC1;
+    }
+    else if (fourCC == DDS_FOURCC('D', 'X', 'T', '5'))
+    {
+        format = DDS_FORMAT::BC3;
+    }
+    else if (fourCC == DDS_FOURCC('D', 'X', '1', '0'))
+    {
+        DDS_HEADER_DXT10 dx10 = {};
+        if (_size < offset + sizeof(dx10))
+        {
+            return false;
+        }
+        memcpy(&dx10, _data + offset, sizeof(dx10));
+        offset += sizeof(dx10);
+        if (dx10.ArraySize > 1)
+        {
+            return false;
+        }
+        format = GetFormatFromDxgi(dx10.DxgiFormat);
+    }
+    if (format == DDS_FORMAT::UNKNOWN ||
+        !header.Width || !header.Height)
+    {
+        return false;
+    }
+
+    unsigned int mipCount = header.MipMapCount ?
+        header.MipMapCount : 1;
+    if (mipCount > DDS_MAX_MIP_LEVEL)
+    {
+        return false;
+    }
+
+    size_t dataSize = 0;
+    unsigned int width = header.Width;
+    unsigned int height = header.Height;
+    for (unsigned int i = 0; i < mipCount; i++)
+    {
+        dataSize += GetDdsLevelSize(format, width, height);
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    if (_size - offset < dataSize)
+    {
+        return false;
+    }
+
+    _info->Format = format;
+    _info->Width = header.Width;
+    _info->Height = header.Height;
+    _info->MipCount = mipCount;
+    _info->DataOffset = offset;
+    _info->DataSize = dataSize;
+
+    return true;
+}
+
+void WriteDdsHeader(DDS_FORMAT _format, unsigned int _width,
+    unsigned int _height, unsigned int _mipCount,
+    std::vector<unsigned char>* _out)
+{
+    DDS_HEADER header = {};
+    header.Size = DDS_HEADER_SIZE;
+    header.Flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH |
+        DDSD_PIXELFORMAT | DDSD_LINEARSIZE;
+    header.Height = _height;
+    header.Width = _width;
+    header.PitchOrLinearSize =
+        (unsigned int)GetDdsLevelSize(_format, _width, _height);
+    header.MipMapCount = _mipCount;
+    header.PixelFormat.Size = sizeof(DDS_PIXELFORMAT);
+    header.PixelFormat.Flags = DDPF_FOURCC;
+    header.Caps = DDSCAPS_TEXTURE;
+    if (_mipCount > 1)
+    {
+        header.Flags |= DDSD_MIPMAPCOUNT;
+        header.Caps |= DDSCAPS_COMPLEX | DDSCAPS_MIPMAP;
+    }
+
+    // bc1 and bc3 use the legacy fourcc so that old viewers can
+    // still open them, bc7 needs the dx10 extension
+    DDS_HEADER_DXT10 dx10 = {};
+    bool useDx10 = false;
+    switch (_format)
+    {
+    case DDS_FORMAT::BC1:
+        header.PixelFormat.FourCC = DDS_FOURCC('D', 'X', 'T', '1');
+        break;
+    case DDS_FORMAT::BC3:
+        header.PixelFormat.FourCC = DDS_FOURCC('D', 'X', 'T', '5');
+        break;
+    default:
+        header.PixelFormat.FourCC = DDS_FOURCC('D', 'X', '1', '0');
+        dx10.DxgiFormat = DXGI_BC7_UNORM;
+        dx10.ResourceDimension = 3;
+        dx10.ArraySize = 1;
+        useDx10 = true;
+        break;
+    }
+
+    unsigned int magic = DDS_MAGIC;
+    const unsigned char* bytes = (const unsigned char*)&magic;
+    _out->insert(_out->end(), bytes, bytes + sizeof(magic));
+    bytes = (const unsigned char*)&header;
+    _out->insert(_out->end(), bytes, bytes + sizeof(header));
+    if (useDx10)
+    {
+        bytes = (const unsigned char*)&dx10;
+        _out->insert(_out->end(), bytes, bytes + sizeof(dx10));
+    }
+}
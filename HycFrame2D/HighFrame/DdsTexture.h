@@ -0,0 +1,51 @@
+﻿//---------------------------------------------------------------
+// File: DdsTexture.h
+// Proj: HycFrame2D
+// Info: ブロック圧縮テクスチャ(DDS)の形式と読み書き
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#define DDS_MAGIC               (0x20534444u)
+#define DDS_HEADER_SIZE         (124)
+#define DDS_DX10_HEADER_SIZE    (20)
+#define DDS_MAX_MIP_LEVEL       (16)
+
+enum class DDS_FORMAT
+{
+    UNKNOWN,
+    BC1,
+    BC3,
+    BC7
+};
+
+struct DDS_TEXTURE_INFO
+{
+    DDS_FORMAT Format = DDS_FORMAT::UNKNOWN;
+    unsigned int Width = 0;
+    unsigned int Height = 0;
+    unsigned int MipCount = 0;
+    size_t DataOffset = 0;
+    size_t DataSize = 0;
+};
+
+std::string MakeCookedTexturePath(const std::string& _path);
+
+unsigned int GetDdsBlockBytes(DDS_FORMAT _format);
+
+size_t GetDdsLevelPitch(DDS_FORMAT _format, unsigned int _width);
+
+size_t GetDdsLevelSize(DDS_FORMAT _format, unsigned int _width,
+    unsigned int _height);
+
+bool ParseDdsTexture(const unsigned char* _data, size_t _size,
+    DDS_TEXTURE_INFO* _info);
+
+void WriteDdsHeader(DDS_FORMAT _format, unsigned int _width,
+    unsigned int _height, unsigned int _mipCount,
+    std::vector<unsigned char>* _out);
@@ -0,0 +1,387 @@
+﻿//---------------------------------------------------------------
+// File: DxRenderBackend.cpp
+// Proj: HycFrame2D
+// Info: D3D11による描画コマンドの再生
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "DxRenderBackend.h"
+#include "texture.h"
+#include "sprite.h"
+#include "Telemetry.h"
+#include <cstring>
+
+// the shared index buffer and the stream buffer start this big and
+// grow to the next power of two when a longer batch comes along
+#define BATCH_MIN_QUADS (4096)
+
+// a cached batch that isn't drawn for this many frames is released
+#define BATCH_KEEP_FRAMES (120)
+
+static_assert(sizeof(RENDER_MATRIX) == sizeof(Matrix4x4f),
+    "the render matrix must keep the directx layout");
+
+namespace
+{
+    Matrix4x4f ToDxMatrix(const RENDER_MATRIX& _matrix)
+    {
+        Matrix4x4f result = {};
+        memcpy(&result, &_matrix, sizeof(result));
+
+        return result;
+    }
+
+    Float4 ToDxFloat4(const RENDER_FLOAT4& _value)
+    {
+        return MakeFloat4(_value.x, _value.y, _value.z, _value.w);
+    }
+
+    unsigned int GrowQuadCapacity(unsigned int _capacity,
+        unsigned int _count)
+    {
+        _capacity = _capacity ? _capacity : BATCH_MIN_QUADS;
+        while (_capacity < _count)
+        {
+            _capacity *= 2;
+        }
+
+        return _capacity;
+    }
+}
+
+void WriteQuadVertices(VERTEX* _out, const RENDER_QUAD* _quads,
+    unsigned int _count)
+{
+    // the same corners and uv flip as DrawSprite
+    for (unsigned int i = 0; i < _count; i++)
+    {
+        const RENDER_QUAD& quad = _quads[i];
+        float x = quad.Rect.x;
+        float y = quad.Rect.y;
+        float hw = quad.Rect.z * 0.5f;
+        float hh = quad.Rect.w * 0.5f;
+        float tx = quad.UV.x;
+        float ty = quad.UV.y;
+        float tw = quad.UV.z;
+        float th = quad.UV.w;
+        Float4 color = ToDxFloat4(quad.Color);
+        VERTEX* vertex = _out + (size_t)i * 4;
+
+        vertex[0] = { MakeFloat3(x - hw, y + hh, 0.f), color,
+            MakeFloat2(tx, ty + th) };
+        vertex[1] = { MakeFloat3(x + hw, y + hh, 0.f), color,
+            MakeFloat2(tx + tw, ty + th) };
+        vertex[2] = { MakeFloat3(x + hw, y - hh, 0.f), color,
+            MakeFloat2(tx + tw, ty) };
+        vertex[3] = { MakeFloat3(x - hw, y - hh, 0.f), color,
+            MakeFloat2(tx, ty) };
+    }
+}
+
+RENDER_MATRIX ToRenderMatrix(const Matrix4x4f& _matrix)
+{
+    RENDER_MATRIX result = {};
+    memcpy(&result, &_matrix, sizeof(result));
+
+    return result;
+}
+
+RENDER_FLOAT4 ToRenderFloat4(const Float4& _value)
+{
+    return { _value.x, _value.y, _value.z, _value.w };
+}
+
+DxRenderBackend::DxRenderBackend() :
+    mQuadVertexBuffer(nullptr), mQuadIndexBuffer(nullptr),
+    mBatchIndexBuffer(nullptr), mBatchIndexCapacity(0),
+    mStreamVertexBuffer(nullptr), mStreamCapacity(0),
+    mCachedBatchMap({}), mVertexScratch({}), mFrameCount(0)
+{
+
+}
+
+DxRenderBackend::~DxRenderBackend()
+{
+
+}
+
+bool DxRenderBackend::StartUp()
+{
+    CreateDefaultVertexIndexBuffer(&mQuadVertexBuffer,
+        &mQuadIndexBuffer);
+    if (!mQuadVertexBuffer || !mQuadIndexBuffer)
+    {
+        P_LOG(LOG_ERROR, "failed to create render backend quad\n");
+        return false;
+    }
+    if (!EnsureBatchIndexBuffer(BATCH_MIN_QUADS))
+    {
+        P_LOG(LOG_ERROR, "failed to create batch index buffer\n");
+        return false;
+    }
+
+    return true;
+}
+
+bool DxRenderBackend::EnsureBatchIndexBuffer(unsigned int _count)
+{
+    if (mBatchIndexBuffer && mBatchIndexCapacity >= _count)
+    {
+        return true;
+    }
+
+    unsigned int capacity = GrowQuadCapacity(mBatchIndexCapacity,
+        _count);
+    std::vector<UINT> indices((size_t)capacity * 6);
+    for (UINT i = 0; i < capacity; i++)
+    {
+        UINT base = i * 4;
+        UINT* quad = &indices[(size_t)i * 6];
+        quad[0] = base + 3;
+        quad[1] = base + 1;
+        quad[2] = base + 0;
+        quad[3] = base + 2;
+        quad[4] = base + 1;
+        quad[5] = base + 3;
+    }
+
+    D3D11_BUFFER_DESC bdc = {};
+    bdc.Usage = D3D11_USAGE_IMMUTABLE;
+    bdc.ByteWidth = (UINT)(sizeof(UINT) * indices.size());
+    bdc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+    D3D11_SUBRESOURCE_DATA initData = {};
+    initData.pSysMem = indices.data();
+    ID3D11Buffer* buffer = nullptr;
+    HRESULT hr = GetDxHelperPtr()->GetDevicePtr()->CreateBuffer(
+        &bdc, &initData, &buffer);
+    if (FAILED(hr))
+    {
+        return false;
+    }
+
+    if (mBatchIndexBuffer)
+    {
+        mBatchIndexBuffer->Release();
+    }
+    mBatchIndexBuffer = buffer;
+    mBatchIndexCapacity = capacity;
+
+    return true;
+}
+
+bool DxRenderBackend::EnsureStreamVertexBuffer(unsigned int _count)
+{
+    if (mStreamVertexBuffer && mStreamCapacity >= _count)
+    {
+        return true;
+    }
+
+    unsigned int capacity = GrowQuadCapacity(mStreamCapacity, _count);
+    D3D11_BUFFER_DESC bdc = {};
+    bdc.Usage = D3D11_USAGE_DYNAMIC;
+    bdc.ByteWidth = (UINT)(sizeof(VERTEX) * 4 * (size_t)capacity);
+    bdc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    bdc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    ID3D11Buffer* buffer = nullptr;
+    HRESULT hr = GetDxHelperPtr()->GetDevicePtr()->CreateBuffer(
+        &bdc, nullptr, &buffer);
+    if (FAILED(hr))
+    {
+        return false;
+    }
+
+    if (mStreamVertexBuffer)
+    {
+        mStreamVertexBuffer->Release();
+    }
+    mStreamVertexBuffer = buffer;
+    mStreamCapacity = capacity;
+
+    return true;
+}
+
+void DxRenderBackend::CleanAndStop()
+{
+    if (mQuadVertexBuffer)
+    {
+        mQuadVertexBuffer->Release();
+        mQuadVertexBuffer = nullptr;
+    }
+    if (mQuadIndexBuffer)
+    {
+        mQuadIndexBuffer->Release();
+        mQuadIndexBuffer = nullptr;
+    }
+    if (mBatchIndexBuffer)
+    {
+        mBatchIndexBuffer->Release();
+        mBatchIndexBuffer = nullptr;
+    }
+    mBatchIndexCapacity = 0;
+    if (mStreamVertexBuffer)
+    {
+        mStreamVertexBuffer->Release();
+        mStreamVertexBuffer = nullptr;
+    }
+    mStreamCapacity = 0;
+    for (auto& cached : mCachedBatchMap)
+    {
+        cached.second.VertexBuffer->Release();
+    }
+    mCachedBatchMap.clear();
+}
+
+void DxRenderBackend::BeginFrame()
+{
+    GetDxHelperPtr()->ClearBuffer();
+}
+
+void DxRenderBackend::ExecuteCommand(const RENDER_COMMAND& _cmd,
+    const RENDER_MATRIX& _transform, const RENDER_QUAD* _quads)
+{
+    Matrix4x4f matrix = ToDxMatrix(_transform);
+    if (_cmd.Type == RENDER_CMD_TYPE::SET_VIEW)
+    {
+        GetDxHelperPtr()->PassViewMatrixToVS(&matrix);
+        return;
+    }
+
+    ID3D11ShaderResourceView* texture = _cmd.Texture;
+    SetTexture(&texture);
+    GetDxHelperPtr()->PassWorldMatrixToVS(&matrix);
+
+    if (_cmd.CacheKey)
+    {
+        ID3D11Buffer* cached = PrepareCachedBatch(_cmd, _quads);
+        if (cached)
+        {
+            DrawQuadBatch(cached, _cmd.QuadCount);
+            return;
+        }
+    }
+
+    // particles and text runs are expanded straight into the mapped
+    // stream buffer and drawn with one call
+    if (_cmd.QuadCount > 1 && EnsureStreamVertexBuffer(_cmd.QuadCount))
+    {
+        ID3D11DeviceContext* context =
+            GetDxHelperPtr()->GetImmediateContextPtr();
+        D3D11_MAPPED_SUBRESOURCE msr = {};
+        if (SUCCEEDED(context->Map(mStreamVertexBuffer, 0,
+            D3D11_MAP_WRITE_DISCARD, 0, &msr)))
+        {
+            WriteQuadVertices((VERTEX*)msr.pData, _quads,
+                _cmd.QuadCount);
+            context->Unmap(mStreamVertexBuffer, 0);
+            DrawQuadBatch(mStreamVertexBuffer, _cmd.QuadCount);
+            return;
+        }
+    }
+
+    for (unsigned int i = 0; i < _cmd.QuadCount; i++)
+    {
+        const RENDER_QUAD& quad = _quads[i];
+        DrawSprite(&mQuadVertexBuffer, mQuadIndexBuffer,
+            quad.Rect.x, quad.Rect.y, quad.Rect.z, quad.Rect.w,
+            quad.UV.x, quad.UV.y, quad.UV.z, quad.UV.w,
+            ToDxFloat4(quad.Color));
+    }
+}
+
+void DxRenderBackend::EndFrame()
+{
+    GetDxHelperPtr()->SwapBufferChain();
+    ReleaseUnusedBatches();
+    ++mFrameCount;
+}
+
+ID3D11Buffer* DxRenderBackend::PrepareCachedBatch(
+    const RENDER_COMMAND& _cmd, const RENDER_QUAD* _quads)
+{
+    CACHED_BATCH& cached = mCachedBatchMap[_cmd.CacheKey];
+    cached.LastFrame = mFrameCount;
+    if (cached.VertexBuffer && cached.Revision == _cmd.CacheRevision &&
+        cached.Capacity >= _cmd.QuadCount)
+    {
+        return cached.VertexBuffer;
+    }
+
+    mVertexScratch.resize((size_t)_cmd.QuadCount * 4);
+    WriteQuadVertices(mVertexScratch.data(), _quads, _cmd.QuadCount);
+    ID3D11DeviceContext* context =
+        GetDxHelperPtr()->GetImmediateContextPtr();
+    if (cached.VertexBuffer && cached.Capacity >= _cmd.QuadCount)
+    {
+        D3D11_BOX box = {};
+        box.right = (UINT)(sizeof(VERTEX) * mVertexScratch.size());
+        box.bottom = 1;
+        box.back = 1;
+        context->UpdateSubresource(cached.VertexBuffer, 0, &box,
+            mVertexScratch.data(), 0, 0);
+        cached.Revision = _cmd.CacheRevision;
+        return cached.VertexBuffer;
+    }
+
+    if (cached.VertexBuffer)
+    {
+        cached.VertexBuffer->Release();
+        cached.VertexBuffer = nullptr;
+    }
+    D3D11_BUFFER_DESC bdc = {};
+    bdc.Usage = D3D11_USAGE_DEFAULT;
+    bdc.ByteWidth = (UINT)(sizeof(VERTEX) * mVertexScratch.size());
+    bdc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    D3D11_SUBRESOURCE_DATA initData = {};
+    initData.pSysMem = mVertexScratch.data();
+    HRESULT hr = GetDxHelperPtr()->GetDevicePtr()->CreateBuffer(
+        &bdc, &initData, &cached.VertexBuffer);
+    if (FAILED(hr))
+    {
+        P_LOG(LOG_WARNING, "failed to create cached batch buffer\n");
+        mCachedBatchMap.erase(_cmd.CacheKey);
+        return nullptr;
+    }
+    cached.Capacity = _cmd.QuadCount;
+    cached.Revision = _cmd.CacheRevision;
+
+    return cached.VertexBuffer;
+}
+
+void DxRenderBackend::DrawQuadBatch(ID3D11Buffer* _vertexBuffer,
+    unsigned int _count)
+{
+    if (!EnsureBatchIndexBuffer(_count))
+    {
+        P_LOG(LOG_WARNING, "failed to grow batch index buffer\n");
+        return;
+    }
+
+    ID3D11DeviceContext* context =
+        GetDxHelperPtr()->GetImmediateContextPtr();
+    UINT stride = sizeof(VERTEX);
+    UINT offset = 0;
+    context->IASetVertexBuffers(0, 1, &_vertexBuffer, &stride, &offset);
+    context->IASetIndexBuffer(mBatchIndexBuffer, DXGI_FORMAT_R32_UINT,
+        0);
+
+    TELEMETRY_INC(DRAW_CALLS);
+    context->DrawIndexed(_count * 6, 0, 0);
+}
+
+void DxRenderBackend::ReleaseUnusedBatches()
+{
+    for (auto it = mCachedBatchMap.begin();
+        it != mCachedBatchMap.end();)
+    {
+        if (mFrameCount - it->second.LastFrame > BATCH_KEEP_FRAMES)
+        {
+            it->second.VertexBuffer->Release();
+            it = mCachedBatchMap.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
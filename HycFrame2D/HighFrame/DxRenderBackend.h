@@ -0,0 +1,82 @@
+﻿//---------------------------------------------------------------
+// File: DxRenderBackend.h
+// Proj: HycFrame2D
+// Info: D3D11による描画コマンドの再生
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include "HFCommon.h"
+#include "RenderCommandQueue.h"
+#include <unordered_map>
+
+struct CACHED_BATCH
+{
+    ID3D11Buffer* VertexBuffer;
+    unsigned int Capacity;
+    unsigned int Revision;
+    unsigned long long LastFrame;
+};
+
+class DxRenderBackend :
+    public RenderBackend
+{
+public:
+    DxRenderBackend();
+    virtual ~DxRenderBackend();
+
+    virtual bool StartUp();
+
+    virtual void CleanAndStop();
+
+    virtual void BeginFrame();
+
+    virtual void ExecuteCommand(const RENDER_COMMAND& _cmd,
+        const RENDER_MATRIX& _transform, const RENDER_QUAD* _quads);
+
+    virtual void EndFrame();
+
+private:
+    bool EnsureBatchIndexBuffer(unsigned int _count);
+
+    bool EnsureStreamVertexBuffer(unsigned int _count);
+
+    ID3D11Buffer* PrepareCachedBatch(const RENDER_COMMAND& _cmd,
+        const RENDER_QUAD* _quads);
+
+    void DrawQuadBatch(ID3D11Buffer* _vertexBuffer,
+        unsigned int _count);
+
+    void ReleaseUnusedBatches();
+
+private:
+    ID3D11Buffer* mQuadVertexBuffer;
+
+    ID3D11Buffer* mQuadIndexBuffer;
+
+    ID3D11Buffer* mBatchIndexBuffer;
+
+    unsigned int mBatchIndexCapacity;
+
+    ID3D11Buffer* mStreamVertexBuffer;
+
+    unsigned int mStreamCapacity;
+
+    std::unordered_map<unsigned int, CACHED_BATCH> mCachedBatchMap;
+
+    std::vector<VERTEX> mVertexScratch;
+
+    unsigned long long mFrameCount;
+};
+
+// the queue only takes plain floats, producers convert their directx
+// values here and the backend converts them back when playing
+RENDER_MATRIX ToRenderMatrix(const Matrix4x4f& _matrix);
+
+RENDER_FLOAT4 ToRenderFloat4(const Float4& _value);
+
+// expands quads into the four vertices each that every batch uploads
+void WriteQuadVertices(VERTEX* _out, const RENDER_QUAD* _quads,
+    unsigned int _count);
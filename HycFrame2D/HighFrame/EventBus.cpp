@@ -0,0 +1,237 @@
+﻿//---------------------------------------------------------------
+// File: EventBus.cpp
+// Proj: HycFrame2D
+// Info: オブジェクト間のイベント配信を管理するバス
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "EventBus.h"
+#include "Object.h"
+#include <algorithm>
+#include <thread>
+
+#define INIT_QUEUE_CAPACITY (1024)
+
+EventBus::EventBus() :
+    mSubscriberMap(), mPendingSubscribeArray({}), mMessageQueue(),
+    mWriteIndex(0), mQueueLock(), mDispatchingFlg(false),
+    mNeedCompactFlg(false)
+{
+    mSubscriberMap.Clear();
+    mPendingSubscribeArray.clear();
+    mMessageQueue[0].reserve(INIT_QUEUE_CAPACITY);
+    mMessageQueue[1].reserve(INIT_QUEUE_CAPACITY);
+    mQueueLock.clear();
+}
+
+EventBus::~EventBus()
+{
+
+}
+
+void EventBus::Subscribe(StringID _eventID, Object* _receiver,
+    EventHandlerFuncType _func)
+{
+    if (!_func)
+    {
+        P_LOG(LOG_WARNING,
+            "cannot subscribe an empty handler : [ %s ]\n",
+            _eventID.GetDebugString());
+        return;
+    }
+
+    EVENT_SUBSCRIBER sub = { _receiver, _func };
+    if (mDispatchingFlg)
+    {
+        // the subscriber lists must not move while being walked
+        mPendingSubscribeArray.push_back({ _eventID, sub });
+        return;
+    }
+
+    AddSubscriber(_eventID, sub);
+}
+
+void EventBus::Unsubscribe(StringID _eventID, Object* _receiver,
+    EventHandlerFuncType _func)
+{
+    std::vector<EVENT_SUBSCRIBER>* subs = mSubscriberMap.Find(_eventID);
+    if (subs)
+    {
+        for (auto& sub : *subs)
+        {
+            if (sub.Receiver == _receiver && sub.Func == _func)
+            {
+                sub.Func = nullptr;
+                mNeedCompactFlg = true;
+            }
+        }
+    }
+
+    for (auto& pending : mPendingSubscribeArray)
+    {
+        if (pending.EventID == _eventID &&
+            pending.Subscriber.Receiver == _receiver &&
+            pending.Subscriber.Func == _func)
+        {
+            pending.Subscriber.Func = nullptr;
+        }
+    }
+
+    if (!mDispatchingFlg)
+    {
+        CompactSubscribers();
+    }
+}
+
+void EventBus::UnsubscribeAll(Object* _receiver)
+{
+    for (auto& subs : mSubscriberMap)
+    {
+        for (auto& sub : subs)
+        {
+            if (sub.Receiver == _receiver)
+            {
+                sub.Func = nullptr;
+                mNeedCompactFlg = true;
+            }
+        }
+    }
+
+    for (auto& pending : mPendingSubscribeArray)
+    {
+        if (pending.Subscriber.Receiver == _receiver)
+        {
+            pending.Subscriber.Func = nullptr;
+        }
+    }
+
+    if (!mDispatchingFlg)
+    {
+        CompactSubscribers();
+    }
+}
+
+void EventBus::PostEvent(StringID _eventID, Object* _sender)
+{
+    EVENT_MESSAGE msg = {};
+    msg.EventID = _eventID;
+    msg.Sender = _sender;
+    msg.PayloadSize = 0;
+    PushMessage(msg);
+}
+
+void EventBus::DispatchEvents()
+{
+    LockQueue();
+    unsigned int readIndex = mWriteIndex;
+    mWriteIndex ^= 1;
+    UnlockQueue();
+
+    mDispatchingFlg = true;
+    for (auto& msg : mMessageQueue[readIndex])
+    {
+        std::vector<EVENT_SUBSCRIBER>* subs =
+            mSubscriberMap.Find(msg.EventID);
+        if (!subs)
+        {
+            continue;
+        }
+
+        for (auto& sub : *subs)
+        {
+            if (!sub.Func)
+            {
+                continue;
+            }
+            if (sub.Receiver &&
+                sub.Receiver->IsObjectActive() == STATUS::NEED_DESTORY)
+            {
+                continue;
+            }
+            sub.Func(sub.Receiver, msg);
+        }
+    }
+    mMessageQueue[readIndex].clear();
+    mDispatchingFlg = false;
+
+    for (auto& pending : mPendingSubscribeArray)
+    {
+        if (pending.Subscriber.Func)
+        {
+            AddSubscriber(pending.EventID, pending.Subscriber);
+        }
+    }
+    mPendingSubscribeArray.clear();
+
+    CompactSubscribers();
+}
+
+void EventBus::ClearEventBus()
+{
+    LockQueue();
+    mMessageQueue[0].clear();
+    mMessageQueue[1].clear();
+    UnlockQueue();
+
+    mSubscriberMap.Clear();
+    mPendingSubscribeArray.clear();
+    mNeedCompactFlg = false;
+}
+
+void EventBus::PushMessage(const EVENT_MESSAGE& _msg)
+{
+    LockQueue();
+    mMessageQueue[mWriteIndex].push_back(_msg);
+    UnlockQueue();
+}
+
+void EventBus::AddSubscriber(StringID _eventID,
+    const EVENT_SUBSCRIBER& _sub)
+{
+    std::vector<EVENT_SUBSCRIBER>* subs = mSubscriberMap.Find(_eventID);
+    if (!subs)
+    {
+        mSubscriberMap.Insert(_eventID, {});
+        subs = mSubscriberMap.Find(_eventID);
+    }
+
+    for (auto& exist : *subs)
+    {
+        if (exist.Receiver == _sub.Receiver && exist.Func == _sub.Func)
+        {
+            return;
+        }
+    }
+    subs->push_back(_sub);
+}
+
+void EventBus::CompactSubscribers()
+{
+    if (!mNeedCompactFlg)
+    {
+        return;
+    }
+
+    for (auto& subs : mSubscriberMap)
+    {
+        subs.erase(std::remove_if(subs.begin(), subs.end(),
+            [](const EVENT_SUBSCRIBER& _sub)
+            { return _sub.Func == nullptr; }),
+            subs.end());
+    }
+    mNeedCompactFlg = false;
+}
+
+void EventBus::LockQueue()
+{
+    while (mQueueLock.test_and_set(std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+}
+
+void EventBus::UnlockQueue()
+{
+    mQueueLock.clear(std::memory_order_release);
+}
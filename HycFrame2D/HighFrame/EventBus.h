@@ -0,0 +1,120 @@
+﻿//---------------------------------------------------------------
+// File: EventBus.h
+// Proj: HycFrame2D
+// Info: オブジェクト間のイベント配信を管理するバス
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include "HFCommon.h"
+#include "FlatIDMap.h"
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+constexpr size_t EVENT_PAYLOAD_SIZE = 32;
+
+struct EVENT_MESSAGE
+{
+    StringID EventID;
+    class Object* Sender;
+    size_t PayloadSize;
+    alignas(16) unsigned char Payload[EVENT_PAYLOAD_SIZE];
+
+    template <typename T>
+    const T* GetPayload() const
+    {
+        if (PayloadSize != sizeof(T))
+        {
+            P_LOG(LOG_WARNING,
+                "event payload type mismatch : [ %s ]\n",
+                EventID.GetDebugString());
+            return nullptr;
+        }
+
+        return (const T*)Payload;
+    }
+};
+
+using EventHandlerFuncType = void(*)(
+    class Object*, const EVENT_MESSAGE&);
+
+class EventBus
+{
+public:
+    EventBus();
+    ~EventBus();
+
+    void Subscribe(StringID _eventID, class Object* _receiver,
+        EventHandlerFuncType _func);
+
+    void Unsubscribe(StringID _eventID, class Object* _receiver,
+        EventHandlerFuncType _func);
+
+    void UnsubscribeAll(class Object* _receiver);
+
+    void PostEvent(StringID _eventID, class Object* _sender);
+
+    template <typename T>
+    void PostEvent(StringID _eventID, class Object* _sender,
+        const T& _payload)
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+            "event payload must be trivially copyable");
+        static_assert(sizeof(T) <= EVENT_PAYLOAD_SIZE,
+            "event payload is too large");
+
+        EVENT_MESSAGE msg = {};
+        msg.EventID = _eventID;
+        msg.Sender = _sender;
+        msg.PayloadSize = sizeof(T);
+        std::memcpy(msg.Payload, &_payload, sizeof(T));
+        PushMessage(msg);
+    }
+
+    void DispatchEvents();
+
+    void ClearEventBus();
+
+private:
+    struct EVENT_SUBSCRIBER
+    {
+        class Object* Receiver;
+        EventHandlerFuncType Func;
+    };
+
+    struct PENDING_SUBSCRIBE
+    {
+        StringID EventID;
+        EVENT_SUBSCRIBER Subscriber;
+    };
+
+    void PushMessage(const EVENT_MESSAGE& _msg);
+
+    void AddSubscriber(StringID _eventID,
+        const EVENT_SUBSCRIBER& _sub);
+
+    void CompactSubscribers();
+
+    void LockQueue();
+
+    void UnlockQueue();
+
+private:
+    FlatIDMap<std::vector<EVENT_SUBSCRIBER>> mSubscriberMap;
+
+    std::vector<PENDING_SUBSCRIBE> mPendingSubscribeArray;
+
+    std::vector<EVENT_MESSAGE> mMessageQueue[2];
+
+    unsigned int mWriteIndex;
+
+    std::atomic_flag mQueueLock;
+
+    bool mDispatchingFlg;
+
+    bool mNeedCompactFlg;
+};
@@ -0,0 +1,176 @@
+﻿//---------------------------------------------------------------
+// File: FlatIDMap.h
+// Proj: HycFrame2D
+// Info: StringIDをキーとする開番地法のハッシュマップ
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include "StringID.h"
+#include <vector>
+
+template <typename T>
+class FlatIDMap
+{
+public:
+    FlatIDMap() :
+        mSlots({}), mKeys({}), mValues({}), mTombstones(0)
+    {
+        mSlots.clear();
+        mKeys.clear();
+        mValues.clear();
+    }
+
+    T* Find(StringID _id)
+    {
+        size_t slot = FindSlot(_id);
+        if (slot == NOT_FOUND)
+        {
+            return nullptr;
+        }
+
+        return &mValues[mSlots[slot] - 1];
+    }
+
+    bool Insert(StringID _id, const T& _value)
+    {
+        if (FindSlot(_id) != NOT_FOUND)
+        {
+            return false;
+        }
+
+        if ((mKeys.size() + mTombstones + 1) * 4 > mSlots.size() * 3)
+        {
+            size_t capacity = 16;
+            while (capacity < (mKeys.size() + 1) * 2)
+            {
+                capacity <<= 1;
+            }
+            Rehash(capacity);
+        }
+
+        mKeys.push_back(_id);
+        mValues.push_back(_value);
+        PlaceIndex(_id, (unsigned int)mKeys.size());
+
+        return true;
+    }
+
+    bool Erase(StringID _id)
+    {
+        size_t slot = FindSlot(_id);
+        if (slot == NOT_FOUND)
+        {
+            return false;
+        }
+
+        unsigned int index = mSlots[slot] - 1;
+        unsigned int last = (unsigned int)mKeys.size() - 1;
+        mSlots[slot] = TOMBSTONE;
+        ++mTombstones;
+
+        if (index != last)
+        {
+            mSlots[FindSlot(mKeys[last])] = index + 1;
+            mKeys[index] = mKeys[last];
+            mValues[index] = mValues[last];
+        }
+        mKeys.pop_back();
+        mValues.pop_back();
+
+        return true;
+    }
+
+    void Clear()
+    {
+        mSlots.clear();
+        mKeys.clear();
+        mValues.clear();
+        mTombstones = 0;
+    }
+
+    size_t Size() const
+    {
+        return mValues.size();
+    }
+
+    typename std::vector<T>::iterator begin()
+    {
+        return mValues.begin();
+    }
+
+    typename std::vector<T>::iterator end()
+    {
+        return mValues.end();
+    }
+
+private:
+    static constexpr size_t NOT_FOUND = (size_t)-1;
+
+    static constexpr unsigned int EMPTY = 0;
+
+    static constexpr unsigned int TOMBSTONE = 0xFFFFFFFF;
+
+    size_t HomeSlot(StringID _id) const
+    {
+        unsigned long long value = _id.GetValue();
+        return (size_t)(value ^ (value >> 32)) & (mSlots.size() - 1);
+    }
+
+    size_t FindSlot(StringID _id) const
+    {
+        if (mSlots.empty())
+        {
+            return NOT_FOUND;
+        }
+
+        size_t slot = HomeSlot(_id);
+        while (mSlots[slot] != EMPTY)
+        {
+            if (mSlots[slot] != TOMBSTONE &&
+                mKeys[mSlots[slot] - 1] == _id)
+            {
+                return slot;
+            }
+            slot = (slot + 1) & (mSlots.size() - 1);
+        }
+
+        return NOT_FOUND;
+    }
+
+    void PlaceIndex(StringID _id, unsigned int _index)
+    {
+        size_t slot = HomeSlot(_id);
+        while (mSlots[slot] != EMPTY && mSlots[slot] != TOMBSTONE)
+        {
+            slot = (slot + 1) & (mSlots.size() - 1);
+        }
+
+        if (mSlots[slot] == TOMBSTONE)
+        {
+            --mTombstones;
+        }
+        mSlots[slot] = _index;
+    }
+
+    void Rehash(size_t _capacity)
+    {
+        mSlots.assign(_capacity, EMPTY);
+        mTombstones = 0;
+        for (size_t i = 0; i < mKeys.size(); i++)
+        {
+            PlaceIndex(mKeys[i], (unsigned int)(i + 1));
+        }
+    }
+
+private:
+    std::vector<unsigned int> mSlots;
+
+    std::vector<StringID> mKeys;
+
+    std::vector<T> mValues;
+
+    size_t mTombstones;
+};
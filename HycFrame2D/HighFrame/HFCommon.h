@@ -16,6 +16,11 @@
 
 #define SHOW_LOADING
 
+#define RENDER_THREAD
+
+#define INPUT_THREAD
+#define INPUT_SAMPLE_RATE (1000)
+
 enum class STATUS
 {
     NEED_INIT,
@@ -24,6 +29,13 @@ enum class STATUS
     NEED_DESTORY
 };
 
+enum class DORMANT_POLICY
+{
+    ALWAYS_ACTIVE,
+    REDUCED,
+    SLEEP
+};
+
 enum class OBJ_TYPE
 {
     ACTOR,
@@ -40,6 +52,8 @@ enum class COMP_TYPE
     AINPUT,
     AANIMATE,
     AINTERACT,
+    ATILEMAP,
+    APARTICLE,
     UTRANSFORM,
     UINPUT,
     UTEXT,
@@ -69,4 +83,16 @@ using UiInterUpdateFuncType = void(*)(
 using UiInterDestoryFuncType = void(*)(
     class UInteractionComponent*);
 
+using ActorInputCoroutineFuncType = class ScriptCoroutine(*)(
+    class AInputComponent*);
+
+using ActorInterCoroutineFuncType = class ScriptCoroutine(*)(
+    class AInteractionComponent*);
+
+using UiInputCoroutineFuncType = class ScriptCoroutine(*)(
+    class UInputComponent*);
+
+using UiInterCoroutineFuncType = class ScriptCoroutine(*)(
+    class UInteractionComponent*);
+
 #define FUNC_NAME(funcName) #funcName
@@ -0,0 +1,429 @@
+﻿//---------------------------------------------------------------
+// File: InputReplay.cpp
+// Proj: HycFrame2D
+// Info: 入力の記録と再生による性能計測
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "InputReplay.h"
+#include "PrintLog.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+// every frame is stored as
+//   float delta | u8 down-word mask | u8 edge-word mask | u8 stick flag
+//   changed down words | press/release edge words | 4 x short sticks
+//   u64 state hash
+// so an idle frame only costs 15 bytes
+
+namespace
+{
+    template <typename T>
+    void WriteValue(std::vector<unsigned char>* _stream, T _value)
+    {
+        const unsigned char* bytes = (const unsigned char*)&_value;
+        _stream->insert(_stream->end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    bool ReadValue(const std::vector<unsigned char>& _stream,
+        size_t* _offset, T* _out)
+    {
+        if (*_offset + sizeof(T) > _stream.size())
+        {
+            return false;
+        }
+
+        memcpy(_out, _stream.data() + *_offset, sizeof(T));
+        *_offset += sizeof(T);
+        return true;
+    }
+
+    inline short QuantizeReplayAxis(float _value)
+    {
+        _value = _value < -1.f ? -1.f : (_value > 1.f ? 1.f : _value);
+        return (short)lroundf(_value * INPUT_AXIS_SCALE);
+    }
+}
+
+InputRecorder::InputRecorder() :
+    mPath(""), mRecordingFlg(false), mFrameCount(0), mLastSample(),
+    mStream({})
+{
+    ClearInputSample(&mLastSample);
+    mStream.clear();
+}
+
+InputRecorder::~InputRecorder()
+{
+    StopRecording();
+}
+
+bool InputRecorder::StartRecording(std::string _path)
+{
+    if (mRecordingFlg)
+    {
+        return false;
+    }
+
+    mPath = _path;
+    mRecordingFlg = true;
+    mFrameCount = 0;
+    ClearInputSample(&mLastSample);
+    mStream.clear();
+    mStream.reserve(64 * 1024);
+
+    return true;
+}
+
+void InputRecorder::RecordFrame(const INPUT_SAMPLE& _sample,
+    float _deltatime, unsigned long long _stateHash)
+{
+    if (!mRecordingFlg)
+    {
+        return;
+    }
+
+    unsigned char downMask = 0;
+    unsigned char edgeMask = 0;
+    for (int w = 0; w < INPUT_KEY_WORD_NUM; w++)
+    {
+        if (_sample.Down[w] != mLastSample.Down[w])
+        {
+            downMask |= (unsigned char)(1 << w);
+        }
+        if (_sample.PressEdge[w] || _sample.ReleaseEdge[w])
+        {
+            edgeMask |= (unsigned char)(1 << w);
+        }
+    }
+    short sticks[4] =
+    {
+        QuantizeReplayAxis(_sample.LeftStick[0]),
+        QuantizeReplayAxis(_sample.LeftStick[1]),
+        QuantizeReplayAxis(_sample.RightStick[0]),
+        QuantizeReplayAxis(_sample.RightStick[1])
+    };
+    short lastSticks[4] =
+    {
+        QuantizeReplayAxis(mLastSample.LeftStick[0]),
+        QuantizeReplayAxis(mLastSample.LeftStick[1]),
+        QuantizeReplayAxis(mLastSample.RightStick[0]),
+        QuantizeReplayAxis(mLastSample.RightStick[1])
+    };
+    unsigned char stickFlag =
+        memcmp(sticks, lastSticks, sizeof(sticks)) ? 1 : 0;
+
+    WriteValue(&mStream, _deltatime);
+    WriteValue(&mStream, downMask);
+    WriteValue(&mStream, edgeMask);
+    WriteValue(&mStream, stickFlag);
+    for (int w = 0; w < INPUT_KEY_WORD_NUM; w++)
+    {
+        if (downMask & (1 << w))
+        {
+            WriteValue(&mStream, _sample.Down[w]);
+        }
+    }
+    for (int w = 0; w < INPUT_KEY_WORD_NUM; w++)
+    {
+        if (edgeMask & (1 << w))
+        {
+            WriteValue(&mStream, _sample.PressEdge[w]);
+            WriteValue(&mStream, _sample.ReleaseEdge[w]);
+        }
+    }
+    if (stickFlag)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            WriteValue(&mStream, sticks[i]);
+        }
+    }
+    WriteValue(&mStream, _stateHash);
+
+    mLastSample = _sample;
+    ++mFrameCount;
+}
+
+bool InputRecorder::StopRecording()
+{
+    if (!mRecordingFlg)
+    {
+        return false;
+    }
+    mRecordingFlg = false;
+
+    std::ofstream file(mPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        P_LOG(LOG_ERROR, "cannot open replay file : [ %s ]\n",
+            mPath.c_str());
+        return false;
+    }
+
+    unsigned int header[3] =
+    {
+        REPLAY_FILE_MAGIC, REPLAY_FILE_VERSION, mFrameCount
+    };
+    file.write((const char*)header, sizeof(header));
+    file.write((const char*)mStream.data(), mStream.size());
+    mStream.clear();
+
+    P_LOG(LOG_MESSAGE, "recorded %u frames into [ %s ]\n",
+        mFrameCount, mPath.c_str());
+    return file.good();
+}
+
+bool InputRecorder::IsRecording() const
+{
+    return mRecordingFlg;
+}
+
+InputReplayer::InputReplayer() :
+    mFrameArray({}), mFrameIndex(0), mMismatchCount(0)
+{
+    mFrameArray.clear();
+}
+
+InputReplayer::~InputReplayer()
+{
+
+}
+
+bool InputReplayer::LoadReplay(std::string _path)
+{
+    std::ifstream file(_path, std::ios::binary);
+    if (!file.is_open())
+    {
+        P_LOG(LOG_ERROR, "cannot open replay file : [ %s ]\n",
+            _path.c_str());
+        return false;
+    }
+    std::vector<unsigned char> stream(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+
+    size_t offset = 0;
+    unsigned int header[3] = { 0, 0, 0 };
+    if (!ReadValue(stream, &offset, &header) ||
+        header[0] != REPLAY_FILE_MAGIC ||
+        header[1] != REPLAY_FILE_VERSION)
+    {
+        P_LOG(LOG_ERROR, "invalid replay file : [ %s ]\n",
+            _path.c_str());
+        return false;
+    }
+
+    mFrameArray.clear();
+    mFrameArray.reserve(header[2]);
+    mFrameIndex = 0;
+    mMismatchCount = 0;
+
+    REPLAY_FRAME frame = {};
+    ClearInputSample(&frame.Sample);
+    short sticks[4] = { 0, 0, 0, 0 };
+    for (unsigned int f = 0; f < header[2]; f++)
+    {
+        unsigned char downMask = 0;
+        unsigned char edgeMask = 0;
+        unsigned char stickFlag = 0;
+        bool valid = ReadValue(stream, &offset, &frame.DeltaTime) &&
+            ReadValue(stream, &offset, &downMask) &&
+            ReadValue(stream, &offset, &edgeMask) &&
+            ReadValue(stream, &offset, &stickFlag);
+
+        memset(frame.Sample.PressEdge, 0,
+            sizeof(frame.Sample.PressEdge));
+        memset(frame.Sample.ReleaseEdge, 0,
+            sizeof(frame.Sample.ReleaseEdge));
+        for (int w = 0; valid && w < INPUT_KEY_WORD_NUM; w++)
+        {
+            if (downMask & (1 << w))
+            {
+                valid = ReadValue(stream, &offset,
+                    &frame.Sample.Down[w]);
+            }
+        }
+        for (int w = 0; valid && w < INPUT_KEY_WORD_NUM; w++)
+        {
+            if (edgeMask & (1 << w))
+            {
+                valid = ReadValue(stream, &offset,
+                    &frame.Sample.PressEdge[w]) &&
+                    ReadValue(stream, &offset,
+                        &frame.Sample.ReleaseEdge[w]);
+            }
+        }
+        if (valid && stickFlag)
+        {
+            valid = ReadValue(stream, &offset, &sticks);
+        }
+        valid = valid && ReadValue(stream, &offset, &frame.StateHash);
+        if (!valid)
+        {
+            P_LOG(LOG_ERROR, "replay file is truncated at frame %u\n",
+                f);
+            return false;
+        }
+
+        float* axis[4] =
+        {
+            &frame.Sample.LeftStick[0], &frame.Sample.LeftStick[1],
+            &frame.Sample.RightStick[0], &frame.Sample.RightStick[1]
+        };
+        for (int i = 0; i < 4; i++)
+        {
+            *axis[i] = (float)sticks[i] / INPUT_AXIS_SCALE;
+        }
+        mFrameArray.push_back(frame);
+    }
+
+    P_LOG(LOG_MESSAGE, "loaded %u replay frames from [ %s ]\n",
+        header[2], _path.c_str());
+    return true;
+}
+
+bool InputReplayer::StepFrame()
+{
+    if (mFrameIndex >= mFrameArray.size())
+    {
+        return false;
+    }
+
+    ++mFrameIndex;
+    return true;
+}
+
+float InputReplayer::GetFrameDelta() const
+{
+    if (!mFrameIndex)
+    {
+        return 0.f;
+    }
+
+    return mFrameArray[mFrameIndex - 1].DeltaTime;
+}
+
+void InputReplayer::SampleInput(INPUT_SAMPLE* _out)
+{
+    if (!mFrameIndex)
+    {
+        ClearInputSample(_out);
+        return;
+    }
+
+    *_out = mFrameArray[mFrameIndex - 1].Sample;
+}
+
+bool InputReplayer::VerifyFrame(unsigned long long _stateHash)
+{
+    if (!mFrameIndex)
+    {
+        return true;
+    }
+
+    if (mFrameArray[mFrameIndex - 1].StateHash == _stateHash)
+    {
+        return true;
+    }
+
+    if (!mMismatchCount)
+    {
+        P_LOG(LOG_WARNING,
+            "replay diverged from the recording at frame %u\n",
+            mFrameIndex - 1);
+    }
+    ++mMismatchCount;
+    return false;
+}
+
+unsigned int InputReplayer::GetFrameIndex() const
+{
+    return mFrameIndex;
+}
+
+unsigned int InputReplayer::GetFrameCount() const
+{
+    return (unsigned int)mFrameArray.size();
+}
+
+unsigned int InputReplayer::GetMismatchCount() const
+{
+    return mMismatchCount;
+}
+
+FrameTimeStatistics::FrameTimeStatistics() :
+    mFrameTimeArray({})
+{
+    mFrameTimeArray.clear();
+}
+
+FrameTimeStatistics::~FrameTimeStatistics()
+{
+
+}
+
+void FrameTimeStatistics::AddFrameTime(float _milliseconds)
+{
+    mFrameTimeArray.push_back(_milliseconds);
+}
+
+void FrameTimeStatistics::ClearStatistics()
+{
+    mFrameTimeArray.clear();
+}
+
+void FrameTimeStatistics::LogStatistics() const
+{
+    if (mFrameTimeArray.empty())
+    {
+        return;
+    }
+
+    std::vector<float> sorted = mFrameTimeArray;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (auto time : sorted)
+    {
+        total += time;
+    }
+
+    P_LOG(LOG_WARNING,
+        "frame time over %u frames (ms) : avg %.3f min %.3f "
+        "p50 %.3f p95 %.3f p99 %.3f max %.3f\n",
+        (unsigned int)sorted.size(), total / sorted.size(),
+        sorted.front(), GetPercentile(sorted, 0.5f),
+        GetPercentile(sorted, 0.95f), GetPercentile(sorted, 0.99f),
+        sorted.back());
+}
+
+bool FrameTimeStatistics::WriteCsvFile(std::string _path) const
+{
+    std::ofstream file(_path, std::ios::trunc);
+    if (!file.is_open())
+    {
+        P_LOG(LOG_ERROR, "cannot open statistics file : [ %s ]\n",
+            _path.c_str());
+        return false;
+    }
+
+    file << "frame,milliseconds\n";
+    for (size_t i = 0; i < mFrameTimeArray.size(); i++)
+    {
+        file << i << "," << mFrameTimeArray[i] << "\n";
+    }
+
+    return file.good();
+}
+
+float FrameTimeStatistics::GetPercentile(
+    const std::vector<float>& _sorted, float _ratio) const
+{
+    float position = _ratio * (float)(_sorted.size() - 1);
+    size_t index = (size_t)(position + 0.5f);
+    return _sorted[std::min(index, _sorted.size() - 1)];
+}
@@ -0,0 +1,103 @@
+﻿//---------------------------------------------------------------
+// File: InputReplay.h
+// Proj: HycFrame2D
+// Info: 入力の記録と再生による性能計測
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include "InputSnapshot.h"
+#include <string>
+#include <vector>
+
+#define REPLAY_FILE_MAGIC       (0x31505248u)
+#define REPLAY_FILE_VERSION     (1)
+
+struct REPLAY_FRAME
+{
+    float DeltaTime;
+    INPUT_SAMPLE Sample;
+    unsigned long long StateHash;
+};
+
+class InputRecorder
+{
+public:
+    InputRecorder();
+    ~InputRecorder();
+
+    bool StartRecording(std::string _path);
+
+    void RecordFrame(const INPUT_SAMPLE& _sample, float _deltatime,
+        unsigned long long _stateHash);
+
+    bool StopRecording();
+
+    bool IsRecording() const;
+
+private:
+    std::string mPath;
+
+    bool mRecordingFlg;
+
+    unsigned int mFrameCount;
+
+    INPUT_SAMPLE mLastSample;
+
+    std::vector<unsigned char> mStream;
+};
+
+class InputReplayer :
+    public InputSampler
+{
+public:
+    InputReplayer();
+    virtual ~InputReplayer();
+
+    bool LoadReplay(std::string _path);
+
+    bool StepFrame();
+
+    float GetFrameDelta() const;
+
+    virtual void SampleInput(INPUT_SAMPLE* _out);
+
+    bool VerifyFrame(unsigned long long _stateHash);
+
+    unsigned int GetFrameIndex() const;
+
+    unsigned int GetFrameCount() const;
+
+    unsigned int GetMismatchCount() const;
+
+private:
+    std::vector<REPLAY_FRAME> mFrameArray;
+
+    unsigned int mFrameIndex;
+
+    unsigned int mMismatchCount;
+};
+
+class FrameTimeStatistics
+{
+public:
+    FrameTimeStatistics();
+    ~FrameTimeStatistics();
+
+    void AddFrameTime(float _milliseconds);
+
+    void ClearStatistics();
+
+    void LogStatistics() const;
+
+    bool WriteCsvFile(std::string _path) const;
+
+private:
+    float GetPercentile(const std::vector<float>& _sorted,
+        float _ratio) const;
+
+private:
+    std::vector<float> mFrameTimeArray;
+};
@@ -0,0 +1,268 @@
+﻿//---------------------------------------------------------------
+// File: InputSamplingThread.cpp
+// Proj: HycFrame2D
+// Info: 高頻度入力サンプリングスレッドとイベントキュー
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "InputSamplingThread.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    inline unsigned int LowestBit(unsigned long long _bits)
+    {
+        unsigned int index = 0;
+        while (!((_bits >> index) & 1ull))
+        {
+            ++index;
+        }
+        return index;
+    }
+
+    inline unsigned long long PackSticks(const INPUT_SAMPLE& _sample)
+    {
+        unsigned long long packed = 0;
+        const float axis[4] =
+        {
+            _sample.LeftStick[0], _sample.LeftStick[1],
+            _sample.RightStick[0], _sample.RightStick[1]
+        };
+        for (int i = 0; i < 4; i++)
+        {
+            float value = axis[i] < -1.f ? -1.f :
+                (axis[i] > 1.f ? 1.f : axis[i]);
+            short q = (short)lroundf(value * INPUT_AXIS_SCALE);
+            packed |= (unsigned long long)(unsigned short)q << (16 * i);
+        }
+        return packed;
+    }
+
+    inline float UnpackAxis(unsigned long long _packed, int _index)
+    {
+        short q = (short)(unsigned short)(_packed >> (16 * _index));
+        return (float)q / INPUT_AXIS_SCALE;
+    }
+}
+
+InputEventQueue::InputEventQueue() :
+    mEventArray(), mHead(0), mTail(0)
+{
+    static_assert(
+        (INPUT_EVENT_QUEUE_SIZE & (INPUT_EVENT_QUEUE_SIZE - 1)) == 0,
+        "event queue size must be a power of two");
+}
+
+InputEventQueue::~InputEventQueue()
+{
+
+}
+
+bool InputEventQueue::PushEvent(const INPUT_EVENT& _event)
+{
+    unsigned int tail = mTail.load(std::memory_order_relaxed);
+    unsigned int head = mHead.load(std::memory_order_acquire);
+    if (tail - head >= INPUT_EVENT_QUEUE_SIZE)
+    {
+        return false;
+    }
+
+    mEventArray[tail & (INPUT_EVENT_QUEUE_SIZE - 1)] = _event;
+    mTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool InputEventQueue::PopEvent(INPUT_EVENT* _out)
+{
+    unsigned int head = mHead.load(std::memory_order_relaxed);
+    unsigned int tail = mTail.load(std::memory_order_acquire);
+    if (head == tail)
+    {
+        return false;
+    }
+
+    *_out = mEventArray[head & (INPUT_EVENT_QUEUE_SIZE - 1)];
+    mHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+void InputEventQueue::ResetQueue()
+{
+    mHead.store(0, std::memory_order_relaxed);
+    mTail.store(0, std::memory_order_relaxed);
+}
+
+InputEdgeDetector::InputEdgeDetector() :
+    mPublished()
+{
+    ResetDetector();
+}
+
+InputEdgeDetector::~InputEdgeDetector()
+{
+
+}
+
+unsigned int InputEdgeDetector::DetectEdges(
+    const INPUT_SAMPLE& _sample, unsigned long long _timestamp,
+    InputEventQueue* _queue)
+{
+    unsigned int pushed = 0;
+    for (int w = 0; w < INPUT_KEY_WORD_NUM; w++)
+    {
+        unsigned long long changed = _sample.Down[w] ^ mPublished[w];
+        while (changed)
+        {
+            unsigned int bit = LowestBit(changed);
+            unsigned long long mask = 1ull << bit;
+            changed &= ~mask;
+
+            INPUT_EVENT ev = {};
+            ev.Timestamp = _timestamp;
+            ev.Code = (unsigned short)(w * 64 + bit);
+            ev.Down = (_sample.Down[w] & mask) != 0;
+
+            // when the queue is full the key keeps its old published
+            // state, so the edge is retried on the next sample
+            if (!_queue->PushEvent(ev))
+            {
+                return pushed;
+            }
+            mPublished[w] ^= mask;
+            ++pushed;
+        }
+    }
+
+    return pushed;
+}
+
+void InputEdgeDetector::ResetDetector()
+{
+    memset(mPublished, 0, sizeof(mPublished));
+}
+
+InputSamplingThread::InputSamplingThread() :
+    mDeviceSampler(nullptr), mRateHz(0), mSamplingThread(),
+    mStopFlg(false), mEventQueue(), mEdgeDetector(),
+    mPackedSticks(0), mDown(), mFrameEventArray({})
+{
+    memset(mDown, 0, sizeof(mDown));
+    mFrameEventArray.clear();
+}
+
+InputSamplingThread::~InputSamplingThread()
+{
+    StopSampling();
+}
+
+bool InputSamplingThread::StartSampling(InputSampler* _device,
+    unsigned int _rateHz)
+{
+    if (!_device || !_rateHz || IsSampling())
+    {
+        return false;
+    }
+
+    mDeviceSampler = _device;
+    mRateHz = _rateHz;
+    mStopFlg = false;
+    mEventQueue.ResetQueue();
+    mEdgeDetector.ResetDetector();
+    mPackedSticks = 0;
+    memset(mDown, 0, sizeof(mDown));
+    mFrameEventArray.clear();
+    mSamplingThread = std::thread(
+        &InputSamplingThread::SamplingLoop, this);
+
+    return true;
+}
+
+void InputSamplingThread::StopSampling()
+{
+    if (!mSamplingThread.joinable())
+    {
+        return;
+    }
+
+    mStopFlg = true;
+    mSamplingThread.join();
+    mDeviceSampler = nullptr;
+}
+
+bool InputSamplingThread::IsSampling() const
+{
+    return mSamplingThread.joinable();
+}
+
+void InputSamplingThread::SampleInput(INPUT_SAMPLE* _out)
+{
+    ClearInputSample(_out);
+    mFrameEventArray.clear();
+
+    INPUT_EVENT ev = {};
+    while (mEventQueue.PopEvent(&ev))
+    {
+        unsigned long long mask = 1ull << (ev.Code & 63);
+        unsigned int word = ev.Code >> 6;
+        if (ev.Down)
+        {
+            mDown[word] |= mask;
+            _out->PressEdge[word] |= mask;
+        }
+        else
+        {
+            mDown[word] &= ~mask;
+            _out->ReleaseEdge[word] |= mask;
+        }
+        mFrameEventArray.push_back(ev);
+    }
+
+    memcpy(_out->Down, mDown, sizeof(mDown));
+    unsigned long long sticks = mPackedSticks.load(
+        std::memory_order_relaxed);
+    _out->LeftStick[0] = UnpackAxis(sticks, 0);
+    _out->LeftStick[1] = UnpackAxis(sticks, 1);
+    _out->RightStick[0] = UnpackAxis(sticks, 2);
+    _out->RightStick[1] = UnpackAxis(sticks, 3);
+}
+
+const std::vector<INPUT_EVENT>*
+InputSamplingThread::GetFrameEvents() const
+{
+    return &mFrameEventArray;
+}
+
+unsigned long long InputSamplingThread::GetInputTimestamp()
+{
+    return (unsigned long long)
+        std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void InputSamplingThread::SamplingLoop()
+{
+    auto period = std::chrono::microseconds(1000000 / mRateHz);
+    auto next = std::chrono::steady_clock::now();
+    INPUT_SAMPLE sample = {};
+
+    while (!mStopFlg)
+    {
+        mDeviceSampler->SampleInput(&sample);
+        mEdgeDetector.DetectEdges(sample, GetInputTimestamp(),
+            &mEventQueue);
+        mPackedSticks.store(PackSticks(sample),
+            std::memory_order_relaxed);
+
+        // do not try to catch up after a stall, just keep the rate
+        next += period;
+        auto now = std::chrono::steady_clock::now();
+        if (next < now)
+        {
+            next = now;
+        }
+        std::this_thread::sleep_until(next);
+    }
+}
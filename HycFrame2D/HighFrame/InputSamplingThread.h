@@ -0,0 +1,100 @@
+﻿//---------------------------------------------------------------
+// File: InputSamplingThread.h
+// Proj: HycFrame2D
+// Info: 高頻度入力サンプリングスレッドとイベントキュー
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include "InputSnapshot.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#define INPUT_EVENT_QUEUE_SIZE  (1024)
+
+struct INPUT_EVENT
+{
+    unsigned long long Timestamp;
+    unsigned short Code;
+    bool Down;
+};
+
+class InputEventQueue
+{
+public:
+    InputEventQueue();
+    ~InputEventQueue();
+
+    bool PushEvent(const INPUT_EVENT& _event);
+
+    bool PopEvent(INPUT_EVENT* _out);
+
+    void ResetQueue();
+
+private:
+    INPUT_EVENT mEventArray[INPUT_EVENT_QUEUE_SIZE];
+
+    alignas(64) std::atomic<unsigned int> mHead;
+
+    alignas(64) std::atomic<unsigned int> mTail;
+};
+
+class InputEdgeDetector
+{
+public:
+    InputEdgeDetector();
+    ~InputEdgeDetector();
+
+    unsigned int DetectEdges(const INPUT_SAMPLE& _sample,
+        unsigned long long _timestamp, InputEventQueue* _queue);
+
+    void ResetDetector();
+
+private:
+    unsigned long long mPublished[INPUT_KEY_WORD_NUM];
+};
+
+class InputSamplingThread :
+    public InputSampler
+{
+public:
+    InputSamplingThread();
+    virtual ~InputSamplingThread();
+
+    bool StartSampling(InputSampler* _device, unsigned int _rateHz);
+
+    void StopSampling();
+
+    bool IsSampling() const;
+
+    virtual void SampleInput(INPUT_SAMPLE* _out);
+
+    const std::vector<INPUT_EVENT>* GetFrameEvents() const;
+
+    static unsigned long long GetInputTimestamp();
+
+private:
+    void SamplingLoop();
+
+private:
+    InputSampler* mDeviceSampler;
+
+    unsigned int mRateHz;
+
+    std::thread mSamplingThread;
+
+    std::atomic<bool> mStopFlg;
+
+    InputEventQueue mEventQueue;
+
+    InputEdgeDetector mEdgeDetector;
+
+    std::atomic<unsigned long long> mPackedSticks;
+
+    unsigned long long mDown[INPUT_KEY_WORD_NUM];
+
+    std::vector<INPUT_EVENT> mFrameEventArray;
+};
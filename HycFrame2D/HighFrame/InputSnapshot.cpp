@@ -0,0 +1,317 @@
+﻿//---------------------------------------------------------------
+// File: InputSnapshot.cpp
+// Proj: HycFrame2D
+// Info: フレーム毎の入力スナップショットとアクション割り当て
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "InputSnapshot.h"
+#include "PrintLog.h"
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    inline bool TestKeyBit(const unsigned long long* _bits,
+        unsigned int _code)
+    {
+        if (_code >= INPUT_KEY_CODE_NUM)
+        {
+            return false;
+        }
+
+        return (_bits[_code >> 6] >> (_code & 63)) & 1ull;
+    }
+
+    inline short QuantizeAxis(float _value)
+    {
+        _value = _value < -1.f ? -1.f : (_value > 1.f ? 1.f : _value);
+        return (short)lroundf(_value * INPUT_AXIS_SCALE);
+    }
+}
+
+void ClearInputSample(INPUT_SAMPLE* _sample)
+{
+    memset(_sample, 0, sizeof(INPUT_SAMPLE));
+}
+
+void SetInputSampleKey(INPUT_SAMPLE* _sample, unsigned int _code,
+    bool _down)
+{
+    if (_code >= INPUT_KEY_CODE_NUM)
+    {
+        return;
+    }
+
+    unsigned long long bit = 1ull << (_code & 63);
+    if (_down)
+    {
+        _sample->Down[_code >> 6] |= bit;
+    }
+    else
+    {
+        _sample->Down[_code >> 6] &= ~bit;
+    }
+}
+
+bool INPUT_SNAPSHOT::IsPressed(unsigned int _code) const
+{
+    return TestKeyBit(Pressed, _code);
+}
+
+bool INPUT_SNAPSHOT::IsTriggered(unsigned int _code) const
+{
+    return TestKeyBit(Triggered, _code);
+}
+
+bool INPUT_SNAPSHOT::IsReleased(unsigned int _code) const
+{
+    return TestKeyBit(Released, _code);
+}
+
+bool INPUT_SNAPSHOT::IsAnyTriggered() const
+{
+    unsigned long long any = 0;
+    for (int w = 0; w < INPUT_KEY_WORD_NUM; w++)
+    {
+        any |= Triggered[w];
+    }
+
+    return any != 0;
+}
+
+bool INPUT_SNAPSHOT::IsActionPressed(int _action) const
+{
+    return _action >= 0 && ((ActionPressed >> _action) & 1ull);
+}
+
+bool INPUT_SNAPSHOT::IsActionTriggered(int _action) const
+{
+    return _action >= 0 && ((ActionTriggered >> _action) & 1ull);
+}
+
+bool INPUT_SNAPSHOT::IsActionReleased(int _action) const
+{
+    return _action >= 0 && ((ActionReleased >> _action) & 1ull);
+}
+
+float INPUT_SNAPSHOT::GetLeftStickX() const
+{
+    return (float)LeftStick[0] / INPUT_AXIS_SCALE;
+}
+
+float INPUT_SNAPSHOT::GetLeftStickY() const
+{
+    return (float)LeftStick[1] / INPUT_AXIS_SCALE;
+}
+
+float INPUT_SNAPSHOT::GetRightStickX() const
+{
+    return (float)RightStick[0] / INPUT_AXIS_SCALE;
+}
+
+float INPUT_SNAPSHOT::GetRightStickY() const
+{
+    return (float)RightStick[1] / INPUT_AXIS_SCALE;
+}
+
+ScriptedInputSampler::ScriptedInputSampler() :
+    mSampleQueue({})
+{
+    mSampleQueue.clear();
+}
+
+ScriptedInputSampler::~ScriptedInputSampler()
+{
+
+}
+
+void ScriptedInputSampler::PushSample(const INPUT_SAMPLE& _sample)
+{
+    mSampleQueue.push_back(_sample);
+}
+
+void ScriptedInputSampler::PushIdleFrames(unsigned int _frames)
+{
+    INPUT_SAMPLE idle = {};
+    ClearInputSample(&idle);
+    for (unsigned int i = 0; i < _frames; i++)
+    {
+        mSampleQueue.push_back(idle);
+    }
+}
+
+size_t ScriptedInputSampler::GetPendingCount() const
+{
+    return mSampleQueue.size();
+}
+
+void ScriptedInputSampler::SampleInput(INPUT_SAMPLE* _out)
+{
+    if (mSampleQueue.empty())
+    {
+        ClearInputSample(_out);
+        return;
+    }
+
+    *_out = mSampleQueue.front();
+    mSampleQueue.pop_front();
+}
+
+InputActionMap::InputActionMap() :
+    mActionIndexMap(), mActionMaskArray({})
+{
+    mActionIndexMap.Clear();
+    mActionMaskArray.clear();
+}
+
+InputActionMap::~InputActionMap()
+{
+
+}
+
+int InputActionMap::RegisterAction(StringID _name)
+{
+    int* exist = mActionIndexMap.Find(_name);
+    if (exist)
+    {
+        return *exist;
+    }
+
+    if (mActionMaskArray.size() >= MAX_INPUT_ACTION_NUM)
+    {
+        P_LOG(LOG_ERROR, "too many input actions : [ %s ]\n",
+            _name.GetDebugString());
+        return NULL_ACTION;
+    }
+
+    int index = (int)mActionMaskArray.size();
+    KEY_MASK mask = {};
+    mActionMaskArray.push_back(mask);
+    mActionIndexMap.Insert(_name, index);
+
+    return index;
+}
+
+bool InputActionMap::BindKey(StringID _action, unsigned int _code)
+{
+    if (_code >= INPUT_KEY_CODE_NUM)
+    {
+        P_LOG(LOG_WARNING, "key code is out of range : [ %u ]\n",
+            _code);
+        return false;
+    }
+
+    int index = RegisterAction(_action);
+    if (index == NULL_ACTION)
+    {
+        return false;
+    }
+
+    mActionMaskArray[index].Bits[_code >> 6] |= 1ull << (_code & 63);
+    return true;
+}
+
+int InputActionMap::GetActionIndex(StringID _name)
+{
+    int* found = mActionIndexMap.Find(_name);
+    return found ? *found : NULL_ACTION;
+}
+
+unsigned int InputActionMap::GetActionCount() const
+{
+    return (unsigned int)mActionMaskArray.size();
+}
+
+void InputActionMap::ClearActionMap()
+{
+    mActionIndexMap.Clear();
+    mActionMaskArray.clear();
+}
+
+void InputActionMap::EvaluateActions(INPUT_SNAPSHOT* _snapshot) const
+{
+    unsigned long long pressed = 0;
+    unsigned long long touched = 0;
+    for (size_t a = 0; a < mActionMaskArray.size(); a++)
+    {
+        const unsigned long long* mask = mActionMaskArray[a].Bits;
+        unsigned long long hit = 0;
+        unsigned long long edge = 0;
+        for (int w = 0; w < INPUT_KEY_WORD_NUM; w++)
+        {
+            hit |= _snapshot->Pressed[w] & mask[w];
+            edge |= _snapshot->Triggered[w] & mask[w];
+        }
+        pressed |= (unsigned long long)(hit != 0) << a;
+        touched |= (unsigned long long)(edge != 0) << a;
+    }
+
+    // edges are taken on the action itself, so switching from one
+    // bound key to another while held does not trigger it again. a
+    // key tapped and let go inside one frame still counts as both
+    unsigned long long before = _snapshot->ActionPressed;
+    unsigned long long tapped = touched & ~pressed & ~before;
+    _snapshot->ActionPressed = pressed;
+    _snapshot->ActionTriggered = (pressed & ~before) | tapped;
+    _snapshot->ActionReleased = (~pressed & before) | tapped;
+}
+
+InputSystem::InputSystem() :
+    mSnapshot({}), mLastSample({}), mActionMap()
+{
+    ResetInputSystem();
+}
+
+InputSystem::~InputSystem()
+{
+
+}
+
+void InputSystem::CaptureSnapshot(InputSampler* _sampler)
+{
+    INPUT_SAMPLE& sample = mLastSample;
+    ClearInputSample(&sample);
+    if (_sampler)
+    {
+        _sampler->SampleInput(&sample);
+    }
+
+    ++mSnapshot.Frame;
+    for (int w = 0; w < INPUT_KEY_WORD_NUM; w++)
+    {
+        unsigned long long before = mSnapshot.Pressed[w];
+        unsigned long long now = sample.Down[w];
+        mSnapshot.Pressed[w] = now;
+        mSnapshot.Triggered[w] = (now & ~before) | sample.PressEdge[w];
+        mSnapshot.Released[w] = (~now & before) | sample.ReleaseEdge[w];
+    }
+    mSnapshot.LeftStick[0] = QuantizeAxis(sample.LeftStick[0]);
+    mSnapshot.LeftStick[1] = QuantizeAxis(sample.LeftStick[1]);
+    mSnapshot.RightStick[0] = QuantizeAxis(sample.RightStick[0]);
+    mSnapshot.RightStick[1] = QuantizeAxis(sample.RightStick[1]);
+
+    mActionMap.EvaluateActions(&mSnapshot);
+}
+
+const INPUT_SNAPSHOT* InputSystem::GetSnapshot() const
+{
+    return &mSnapshot;
+}
+
+const INPUT_SAMPLE* InputSystem::GetLastSample() const
+{
+    return &mLastSample;
+}
+
+InputActionMap* InputSystem::GetActionMap()
+{
+    return &mActionMap;
+}
+
+void InputSystem::ResetInputSystem()
+{
+    memset(&mSnapshot, 0, sizeof(INPUT_SNAPSHOT));
+    ClearInputSample(&mLastSample);
+}
@@ -0,0 +1,150 @@
+﻿//---------------------------------------------------------------
+// File: InputSnapshot.h
+// Proj: HycFrame2D
+// Info: フレーム毎の入力スナップショットとアクション割り当て
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include "StringID.h"
+#include "FlatIDMap.h"
+#include <deque>
+#include <vector>
+
+#define INPUT_KEY_CODE_NUM      (512)
+#define INPUT_KEY_WORD_NUM      (INPUT_KEY_CODE_NUM / 64)
+#define MAX_INPUT_ACTION_NUM    (64)
+#define INPUT_AXIS_SCALE        (32767.f)
+
+constexpr int NULL_ACTION = -1;
+
+struct INPUT_SAMPLE
+{
+    unsigned long long Down[INPUT_KEY_WORD_NUM];
+    unsigned long long PressEdge[INPUT_KEY_WORD_NUM];
+    unsigned long long ReleaseEdge[INPUT_KEY_WORD_NUM];
+    float LeftStick[2];
+    float RightStick[2];
+};
+
+void ClearInputSample(INPUT_SAMPLE* _sample);
+
+void SetInputSampleKey(INPUT_SAMPLE* _sample, unsigned int _code,
+    bool _down);
+
+struct INPUT_SNAPSHOT
+{
+    unsigned long long Frame;
+    unsigned long long Pressed[INPUT_KEY_WORD_NUM];
+    unsigned long long Triggered[INPUT_KEY_WORD_NUM];
+    unsigned long long Released[INPUT_KEY_WORD_NUM];
+    short LeftStick[2];
+    short RightStick[2];
+    unsigned long long ActionPressed;
+    unsigned long long ActionTriggered;
+    unsigned long long ActionReleased;
+
+    bool IsPressed(unsigned int _code) const;
+
+    bool IsTriggered(unsigned int _code) const;
+
+    bool IsReleased(unsigned int _code) const;
+
+    bool IsAnyTriggered() const;
+
+    bool IsActionPressed(int _action) const;
+
+    bool IsActionTriggered(int _action) const;
+
+    bool IsActionReleased(int _action) const;
+
+    float GetLeftStickX() const;
+
+    float GetLeftStickY() const;
+
+    float GetRightStickX() const;
+
+    float GetRightStickY() const;
+};
+
+class InputSampler
+{
+public:
+    virtual ~InputSampler() {}
+
+    virtual void SampleInput(INPUT_SAMPLE* _out) = 0;
+};
+
+class ScriptedInputSampler :
+    public InputSampler
+{
+public:
+    ScriptedInputSampler();
+    virtual ~ScriptedInputSampler();
+
+    void PushSample(const INPUT_SAMPLE& _sample);
+
+    void PushIdleFrames(unsigned int _frames);
+
+    size_t GetPendingCount() const;
+
+    virtual void SampleInput(INPUT_SAMPLE* _out);
+
+private:
+    std::deque<INPUT_SAMPLE> mSampleQueue;
+};
+
+class InputActionMap
+{
+public:
+    InputActionMap();
+    ~InputActionMap();
+
+    int RegisterAction(StringID _name);
+
+    bool BindKey(StringID _action, unsigned int _code);
+
+    int GetActionIndex(StringID _name);
+
+    unsigned int GetActionCount() const;
+
+    void ClearActionMap();
+
+    void EvaluateActions(INPUT_SNAPSHOT* _snapshot) const;
+
+private:
+    struct KEY_MASK
+    {
+        unsigned long long Bits[INPUT_KEY_WORD_NUM];
+    };
+
+    FlatIDMap<int> mActionIndexMap;
+
+    std::vector<KEY_MASK> mActionMaskArray;
+};
+
+class InputSystem
+{
+public:
+    InputSystem();
+    ~InputSystem();
+
+    void CaptureSnapshot(InputSampler* _sampler);
+
+    const INPUT_SNAPSHOT* GetSnapshot() const;
+
+    const INPUT_SAMPLE* GetLastSample() const;
+
+    InputActionMap* GetActionMap();
+
+    void ResetInputSystem();
+
+private:
+    INPUT_SNAPSHOT mSnapshot;
+
+    INPUT_SAMPLE mLastSample;
+
+    InputActionMap mActionMap;
+};
@@ -9,10 +9,12 @@
 
 #include "Object.h"
 #include "SceneNode.h"
+#include "ScriptCoroutine.h"
 
 Object::Object(std::string _name,
     class SceneNode* _scene, STATUS _active) :
-    mName(_name), mSceneNodePtr(_scene), mActive(_active)
+    mName(_name), mNameID(InternStringID(_name)),
+    mSceneNodePtr(_scene), mActive(_active)
 {
 
 }
@@ -22,11 +24,16 @@ Object::~Object()
 
 }
 
-std::string Object::GetObjectName() const
+const std::string& Object::GetObjectName() const
 {
     return mName;
 }
 
+StringID Object::GetObjectNameID() const
+{
+    return mNameID;
+}
+
 STATUS Object::IsObjectActive() const
 {
     return mActive;
@@ -34,7 +41,19 @@ STATUS Object::IsObjectActive() const
 
 void Object::SetObjectActive(STATUS _active)
 {
+    STATUS before = mActive;
     mActive = _active;
+
+    // scripts parked while this was paused carry on from here, and a
+    // collision with it may count again
+    if (before != STATUS::ACTIVE && _active == STATUS::ACTIVE &&
+        mSceneNodePtr && mSceneNodePtr->GetCoroutineScheduler())
+    {
+        CoroutineScheduler* scheduler =
+            mSceneNodePtr->GetCoroutineScheduler();
+        scheduler->WakeParkedCoroutines(this);
+        scheduler->RaiseSignal(mNameID);
+    }
 }
 
 SceneNode* Object::GetSceneNodePtr() const
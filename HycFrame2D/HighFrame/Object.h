@@ -11,6 +11,7 @@
 
 #include <string>
 #include "HFCommon.h"
+#include "StringID.h"
 
 class Object
 {
@@ -19,11 +20,13 @@ public:
         class SceneNode* _scene, STATUS _active);
     virtual ~Object();
 
-    std::string GetObjectName() const;
+    const std::string& GetObjectName() const;
+
+    StringID GetObjectNameID() const;
 
     STATUS IsObjectActive() const;
 
-    void SetObjectActive(STATUS _active);
+    virtual void SetObjectActive(STATUS _active);
 
     class SceneNode* GetSceneNodePtr() const;
 
@@ -39,6 +42,8 @@ public:
 private:
     const std::string mName;
 
+    const StringID mNameID;
+
     STATUS mActive;
 
     class SceneNode* mSceneNodePtr;
@@ -15,6 +15,9 @@
 #include "Actor_all.h"
 #include "Ui_all.h"
 #include "sound.h"
+#include "texture.h"
+#include "Telemetry.h"
+#include <algorithm>
 
 #include "..\FuncsResigter.h"
 
@@ -26,7 +29,11 @@ ObjectFactory::ObjectFactory() :
     mActorInteractionDestoryFunctionPool({}),
     mUiInteractionInitFunctionPool({}),
     mUiInteractionUpdateFunctionPool({}),
-    mUiInteractionDestoryFunctionPool({})
+    mUiInteractionDestoryFunctionPool({}),
+    mActorInputCoroutinePool({}),
+    mActorInteractionCoroutinePool({}),
+    mUiInputCoroutinePool({}),
+    mUiInteractionCoroutinePool({})
 {
 
 }
@@ -102,6 +109,30 @@ ObjectFactory::GetUiInterDestoryPool()
     return &mUiInteractionDestoryFunctionPool;
 }
 
+std::unordered_map<std::string, ActorInputCoroutineFuncType>*
+ObjectFactory::GetActorInputCoroutinePool()
+{
+    return &mActorInputCoroutinePool;
+}
+
+std::unordered_map<std::string, ActorInterCoroutineFuncType>*
+ObjectFactory::GetActorInterCoroutinePool()
+{
+    return &mActorInteractionCoroutinePool;
+}
+
+std::unordered_map<std::string, UiInputCoroutineFuncType>*
+ObjectFactory::GetUiInputCoroutinePool()
+{
+    return &mUiInputCoroutinePool;
+}
+
+std::unordered_map<std::string, UiInterCoroutineFuncType>*
+ObjectFactory::GetUiInterCoroutinePool()
+{
+    return &mUiInteractionCoroutinePool;
+}
+
 void ObjectFactory::ResetSceneNode(SceneNode* _scene,
     std::string _configPath)
 {
@@ -136,13 +167,26 @@ void ObjectFactory::ResetSceneNode(SceneNode* _scene,
         pa->SetObjectActive(STATUS::NEED_INIT);
         for (unsigned int i = 0; i < arraySize; i++)
         {
+            std::string nodePath = "/actor/" + std::to_string(i);
+            if (config["actor"][i].HasMember("prefab"))
+            {
+                SPAWN_OVERRIDES overrides =
+                    ReadSpawnOverrides(&config, nodePath);
+                if (overrides.Name == pa->GetObjectName())
+                {
+                    ResetPrefabActor(pa,
+                        mPropertyManagerPtr->GetPropertyNode(
+                            config["actor"][i]["prefab"].GetString()),
+                        overrides);
+                }
+                continue;
+            }
+
             std::string name =
                 config["actor"][i]["actor-name"].GetString();
             if (name == pa->GetObjectName())
             {
-                ResetAComp(pa, &config,
-                    "/actor/" +
-                    std::to_string(i) + "/components");
+                ResetAComp(pa, &config, nodePath + "/components");
             }
         }
         _scene->AddActorObject(pa);
@@ -345,6 +389,17 @@ void ObjectFactory::ResetAComp(ActorObject* _actor,
 
         }
 
+        else if (compType == "tilemap")
+        {
+            LoadTilemapLayer((ATilemapComponent*)pComp, _file,
+                _nodePath + "/" + std::to_string(i));
+        }
+
+        else if (compType == "particle")
+        {
+            ((AParticleComponent*)pComp)->SetEmitting(true);
+        }
+
         else
         {
             P_LOG(LOG_ERROR, "you fuck up\n");
@@ -511,6 +566,13 @@ SceneNode* ObjectFactory::CreateNewScene(std::string _name,
 {
     JsonFile config = {};
     LoadJsonFile(&config, _configPath);
+    return CreateNewScene(_name, _configPath, &config);
+}
+
+SceneNode* ObjectFactory::CreateNewScene(std::string _name,
+    std::string _configPath, JsonFile* _config)
+{
+    JsonFile& config = *_config;
     if (config.HasParseError())
     {
         P_LOG(LOG_ERROR,
@@ -529,6 +591,7 @@ SceneNode* ObjectFactory::CreateNewScene(std::string _name,
     }
     SceneNode* node = new SceneNode(_name, _configPath,
         mSceneManagerPtr);
+    TELEMETRY_INC(ALLOCATIONS);
     node->InitCamera(
         MakeFloat2(0.f, 0.f), MakeFloat2(1920.f, 1080.f));
 
@@ -543,21 +606,50 @@ SceneNode* ObjectFactory::CreateNewScene(std::string _name,
                 config["camera"][3].GetFloat()));
     }
 
+    if (config.HasMember("activity-margin") &&
+        config["activity-margin"].Size() == 2)
+    {
+        node->SetActivityMargin(
+            MakeFloat2(
+                config["activity-margin"][0].GetFloat(),
+                config["activity-margin"][1].GetFloat()));
+    }
+
     if (config.HasMember("sound"))
     {
         unsigned int soundSize = config["sound"].Size();
         for (unsigned int i = 0; i < soundSize; i++)
         {
             if (config["sound"][i]["name"].IsString() &&
-                config["sound"][i]["path"].IsString())
-            {
+                config["sound"][i]["path"].IsString() &&
                 LoadSound(
                     config["sound"][i]["name"].GetString(),
-                    config["sound"][i]["path"].GetString());
+                    config["sound"][i]["path"].GetString()))
+            {
+                node->InsertNewSound(
+                    config["sound"][i]["name"].GetString());
+            }
+        }
+    }
+
+    if (config.HasMember("preload-scenes") &&
+        config["preload-scenes"].IsArray())
+    {
+        for (auto& hint : config["preload-scenes"].GetArray())
+        {
+            if (hint.HasMember("name") && hint["name"].IsString() &&
+                hint.HasMember("path") && hint["path"].IsString())
+            {
+                node->AddPreloadHint(hint["name"].GetString(),
+                    hint["path"].GetString());
             }
         }
     }
 
+    // textures are loaded here on the loading thread, so the first
+    // init of the objects only finds them in the scene's pool
+    PreloadSceneTextures(node, &config);
+
     if (config.HasMember("actor") &&
         !config["actor"].IsNull() && config["actor"].Size())
     {
@@ -593,18 +685,34 @@ SceneNode* ObjectFactory::CreateNewScene(std::string _name,
 ActorObject* ObjectFactory::CreateNewAObject(JsonFile* _file,
     std::string _nodePath, SceneNode* _scene)
 {
-    ActorObject* aObj = CreateActorItself(
-        _file, _nodePath, _scene);
+    ActorObject* aObj = nullptr;
 
-    JsonNode compNode = GetJsonNode(
-        _file, _nodePath + "/components");
-    if (compNode && !compNode->IsNull() && compNode->Size())
+    JsonNode compNode = GetJsonNode(_file, _nodePath + "/prefab");
+    if (compNode && compNode->IsString())
     {
-        for (unsigned int i = 0; i < compNode->Size(); i++)
+        PropertyNode* prop = mPropertyManagerPtr->GetPropertyNode(
+            compNode->GetString());
+        if (!prop)
         {
-            std::string path =
-                _nodePath + "/components/" + std::to_string(i);
-            AddACompToActor(aObj, _file, path);
+            return nullptr;
+        }
+
+        aObj = CreateActorFromProperty(prop, _scene,
+            ReadSpawnOverrides(_file, _nodePath));
+    }
+    else
+    {
+        aObj = CreateActorItself(_file, _nodePath, _scene);
+
+        compNode = GetJsonNode(_file, _nodePath + "/components");
+        if (compNode && !compNode->IsNull() && compNode->Size())
+        {
+            for (unsigned int i = 0; i < compNode->Size(); i++)
+            {
+                std::string path =
+                    _nodePath + "/components/" + std::to_string(i);
+                AddACompToActor(aObj, _file, path);
+            }
         }
     }
 
@@ -683,6 +791,54 @@ ActorObject* ObjectFactory::CreateActorItself(JsonFile* _file,
         }
 
         aObj = new ActorObject(name, _scene, objOrder);
+        TELEMETRY_INC(ALLOCATIONS);
+
+        node = GetJsonNode(_file, _nodePath + "/dormant-policy");
+        if (node && node->IsString())
+        {
+            std::string policy = node->GetString();
+            unsigned int rate = 1;
+            JsonNode rateNode = GetJsonNode(
+                _file, _nodePath + "/dormant-rate");
+            if (rateNode && rateNode->IsUint())
+            {
+                rate = rateNode->GetUint();
+            }
+
+            if (policy == "always")
+            {
+                aObj->SetDormantPolicy(
+                    DORMANT_POLICY::ALWAYS_ACTIVE, rate);
+            }
+            else if (policy == "reduced")
+            {
+                aObj->SetDormantPolicy(
+                    DORMANT_POLICY::REDUCED, rate);
+            }
+            else if (policy == "sleep")
+            {
+                aObj->SetDormantPolicy(
+                    DORMANT_POLICY::SLEEP, rate);
+            }
+            else
+            {
+                P_LOG(LOG_WARNING,
+                    "unknown dormant policy in [ %s ]\n",
+                    _nodePath.c_str());
+            }
+        }
+
+        node = GetJsonNode(_file, _nodePath + "/tags");
+        if (node && node->IsArray())
+        {
+            for (auto& tag : node->GetArray())
+            {
+                if (tag.IsString())
+                {
+                    aObj->AddTag(tag.GetString());
+                }
+            }
+        }
     }
 
     return aObj;
@@ -721,11 +877,128 @@ UiObject* ObjectFactory::CreateUiItself(JsonFile* _file,
         }
 
         uObj = new UiObject(name, _scene, objOrder);
+        TELEMETRY_INC(ALLOCATIONS);
     }
 
     return uObj;
 }
 
+void ObjectFactory::LoadTilemapLayer(ATilemapComponent* _atmc,
+    JsonFile* _file, std::string _nodePath)
+{
+    JsonNode compNode = nullptr;
+    Float2 tileSize = MakeFloat2(0.f, 0.f);
+    unsigned int mapSize[2] = { 0, 0 };
+    compNode = GetJsonNode(_file, _nodePath + "/tile-size/0");
+    if (compNode && compNode->IsNumber())
+    {
+        tileSize.x = compNode->GetFloat();
+    }
+    compNode = GetJsonNode(_file, _nodePath + "/tile-size/1");
+    if (compNode && compNode->IsNumber())
+    {
+        tileSize.y = compNode->GetFloat();
+    }
+    compNode = GetJsonNode(_file, _nodePath + "/map-size/0");
+    if (compNode && compNode->IsUint())
+    {
+        mapSize[0] = compNode->GetUint();
+    }
+    compNode = GetJsonNode(_file, _nodePath + "/map-size/1");
+    if (compNode && compNode->IsUint())
+    {
+        mapSize[1] = compNode->GetUint();
+    }
+    _atmc->SetTileLayout(mapSize[0], mapSize[1], tileSize);
+
+    compNode = GetJsonNode(_file, _nodePath + "/tile-file");
+    if (compNode && compNode->IsString())
+    {
+        _atmc->LoadBinaryLayer(compNode->GetString());
+        return;
+    }
+
+    compNode = GetJsonNode(_file, _nodePath + "/tiles");
+    if (compNode && compNode->IsArray())
+    {
+        std::vector<unsigned short> tiles = {};
+        tiles.reserve(compNode->Size());
+        for (auto& tile : compNode->GetArray())
+        {
+            tiles.push_back(tile.IsInt() && tile.GetInt() >= 0 ?
+                (unsigned short)tile.GetInt() : EMPTY_TILE);
+        }
+        _atmc->LoadTileArray(tiles);
+    }
+}
+
+void ObjectFactory::LoadParticleEmitter(AParticleComponent* _apc,
+    JsonFile* _file, std::string _nodePath)
+{
+    PARTICLE_EMITTER emitter = {};
+    JsonNode compNode = nullptr;
+    auto readPair = [&](const char* _key, Float2* _out)
+    {
+        JsonNode x = GetJsonNode(_file, _nodePath + _key + "/0");
+        JsonNode y = GetJsonNode(_file, _nodePath + _key + "/1");
+        if (x && y && x->IsNumber() && y->IsNumber())
+        {
+            *_out = MakeFloat2(x->GetFloat(), y->GetFloat());
+        }
+    };
+    auto readColor = [&](const char* _key, Float4* _out)
+    {
+        float value[4] = { 1.f, 1.f, 1.f, 1.f };
+        for (int i = 0; i < 4; i++)
+        {
+            JsonNode c = GetJsonNode(_file,
+                _nodePath + _key + "/" + std::to_string(i));
+            if (c && c->IsNumber())
+            {
+                value[i] = c->GetFloat();
+            }
+        }
+        *_out = MakeFloat4(value[0], value[1], value[2], value[3]);
+    };
+
+    compNode = GetJsonNode(_file, _nodePath + "/capacity");
+    if (compNode && compNode->IsUint())
+    {
+        emitter.Capacity = compNode->GetUint();
+    }
+    compNode = GetJsonNode(_file, _nodePath + "/emit-rate");
+    if (compNode && compNode->IsNumber())
+    {
+        emitter.EmitRate = compNode->GetFloat();
+    }
+    compNode = GetJsonNode(_file, _nodePath + "/burst-count");
+    if (compNode && compNode->IsUint())
+    {
+        emitter.BurstCount = compNode->GetUint();
+    }
+    readPair("/life", &emitter.LifeRange);
+    readPair("/speed", &emitter.SpeedRange);
+    readPair("/angle", &emitter.AngleRange);
+    readPair("/gravity", &emitter.Gravity);
+    readPair("/size", &emitter.SizeRange);
+    readColor("/start-color", &emitter.StartColor);
+    readColor("/end-color", &emitter.EndColor);
+
+    compNode = GetJsonNode(_file, _nodePath + "/texture-path");
+    if (compNode && compNode->IsString())
+    {
+        emitter.TexPath = compNode->GetString();
+    }
+    readPair("/animate-stride", &emitter.Stride);
+    compNode = GetJsonNode(_file, _nodePath + "/max-count");
+    if (compNode && compNode->IsUint())
+    {
+        emitter.MaxCut = compNode->GetUint();
+    }
+
+    _apc->SetEmitter(emitter);
+}
+
 void ObjectFactory::AddACompToActor(ActorObject* _actor,
     JsonFile* _file, std::string _nodePath)
 {
@@ -992,6 +1265,19 @@ void ObjectFactory::AddACompToActor(ActorObject* _actor,
                     mActorInputFunctionPool[funcName]);
             }
         }
+
+        compNode = GetJsonNode(
+            _file, _nodePath + "/coroutine-func-name");
+        if (compNode && compNode->IsString())
+        {
+            std::string funcName = compNode->GetString();
+            if (mActorInputCoroutinePool.find(funcName) !=
+                mActorInputCoroutinePool.end())
+            {
+                aic->SetCoroutineFunc(
+                    mActorInputCoroutinePool[funcName]);
+            }
+        }
     }
 
     // TIMER----------------------------
@@ -1244,6 +1530,109 @@ void ObjectFactory::AddACompToActor(ActorObject* _actor,
                     mActorInteractionDestoryFunctionPool[funcName]);
             }
         }
+
+        compNode = GetJsonNode(
+            _file, _nodePath + "/coroutine-func-name");
+        if (compNode && compNode->IsString())
+        {
+            std::string funcName = compNode->GetString();
+            if (mActorInteractionCoroutinePool.find(funcName) !=
+                mActorInteractionCoroutinePool.end())
+            {
+                aitc->SetCoroutineFunc(
+                    mActorInteractionCoroutinePool[funcName]);
+            }
+        }
+    }
+
+    // TILEMAP----------------------------
+    else if (compType == "tilemap")
+    {
+        std::string name =
+            _actor->GetObjectName() + "-" + compType;
+        int updateOrder = 0;
+
+        compNode = GetJsonNode(
+            _file, _nodePath + "/update-order");
+        if (compNode && compNode->IsInt())
+        {
+            updateOrder = compNode->GetInt();
+        }
+        else
+        {
+            P_LOG(LOG_ERROR,
+                "cannot get update order in [ %s ]\n",
+                _nodePath.c_str());
+        }
+
+        ATilemapComponent* atmc = new ATilemapComponent(name,
+            _actor, updateOrder);
+        _actor->AddAComponent(atmc);
+
+        std::string atlasPath = "";
+        unsigned int atlasSize[2] = { 1, 1 };
+        compNode = GetJsonNode(
+            _file, _nodePath + "/atlas-path");
+        if (compNode && compNode->IsString())
+        {
+            atlasPath = compNode->GetString();
+        }
+        compNode = GetJsonNode(
+            _file, _nodePath + "/atlas-size/0");
+        if (compNode && compNode->IsUint())
+        {
+            atlasSize[0] = compNode->GetUint();
+        }
+        compNode = GetJsonNode(
+            _file, _nodePath + "/atlas-size/1");
+        if (compNode && compNode->IsUint())
+        {
+            atlasSize[1] = compNode->GetUint();
+        }
+        atmc->SetAtlas(atlasPath, atlasSize[0], atlasSize[1]);
+
+        compNode = GetJsonNode(
+            _file, _nodePath + "/solid-tiles");
+        if (compNode && compNode->IsArray())
+        {
+            std::vector<unsigned short> solids = {};
+            for (auto& tile : compNode->GetArray())
+            {
+                if (tile.IsUint())
+                {
+                    solids.push_back((unsigned short)tile.GetUint());
+                }
+            }
+            atmc->SetSolidTiles(solids);
+        }
+
+        LoadTilemapLayer(atmc, _file, _nodePath);
+    }
+
+    // PARTICLE----------------------------
+    else if (compType == "particle")
+    {
+        std::string name =
+            _actor->GetObjectName() + "-" + compType;
+        int updateOrder = 0;
+
+        compNode = GetJsonNode(
+            _file, _nodePath + "/update-order");
+        if (compNode && compNode->IsInt())
+        {
+            updateOrder = compNode->GetInt();
+        }
+        else
+        {
+            P_LOG(LOG_ERROR,
+                "cannot get update order in [ %s ]\n",
+                _nodePath.c_str());
+        }
+
+        AParticleComponent* apc = new AParticleComponent(name,
+            _actor, updateOrder);
+        _actor->AddAComponent(apc);
+        LoadParticleEmitter(apc, _file, _nodePath);
     }
 
     // ELSE----------------------------
@@ -1254,6 +1643,9 @@ void ObjectFactory::AddACompToActor(ActorObject* _actor,
             compType.c_str());
         return;
     }
+
+    // every known type above made exactly one component
+    TELEMETRY_INC(ALLOCATIONS);
 }
 
 void ObjectFactory::AddUCompToUi(UiObject* _ui,
@@ -1460,6 +1852,19 @@ void ObjectFactory::AddUCompToUi(UiObject* _ui,
                     mUiInputFunctionPool[funcName]);
             }
         }
+
+        compNode = GetJsonNode(
+            _file, _nodePath + "/coroutine-func-name");
+        if (compNode && compNode->IsString())
+        {
+            std::string funcName = compNode->GetString();
+            if (mUiInputCoroutinePool.find(funcName) !=
+                mUiInputCoroutinePool.end())
+            {
+                uic->SetCoroutineFunc(
+                    mUiInputCoroutinePool[funcName]);
+            }
+        }
     }
 
     // BTNMAP----------------------------
@@ -1581,6 +1986,19 @@ void ObjectFactory::AddUCompToUi(UiObject* _ui,
                     mUiInteractionDestoryFunctionPool[funcName]);
             }
         }
+
+        compNode = GetJsonNode(
+            _file, _nodePath + "/coroutine-func-name");
+        if (compNode && compNode->IsString())
+        {
+            std::string funcName = compNode->GetString();
+            if (mUiInteractionCoroutinePool.find(funcName) !=
+                mUiInteractionCoroutinePool.end())
+            {
+                uitc->SetCoroutineFunc(
+                    mUiInteractionCoroutinePool[funcName]);
+            }
+        }
     }
 
     // TEXT----------------------------
@@ -1711,4 +2129,300 @@ void ObjectFactory::AddUCompToUi(UiObject* _ui,
             compType.c_str());
         return;
     }
+
+    // every known type above made exactly one component
+    TELEMETRY_INC(ALLOCATIONS);
+}
+
+ActorObject* ObjectFactory::Spawn(SceneNode* _scene,
+    std::string _prefabId, const SPAWN_OVERRIDES& _overrides)
+{
+    PropertyNode* prop =
+        mPropertyManagerPtr->GetPropertyNode(_prefabId);
+    if (!prop)
+    {
+        return nullptr;
+    }
+
+    ActorObject* actor = nullptr;
+    if (_overrides.Name == "")
+    {
+        actor = _scene->TakeRecycledActor(_prefabId);
+    }
+
+    if (actor)
+    {
+        actor->SetObjectActive(STATUS::NEED_INIT);
+        ResetPrefabActor(actor, prop, _overrides);
+    }
+    else
+    {
+        actor = CreateActorFromProperty(prop, _scene, _overrides);
+    }
+    _scene->AddActorObject(actor);
+
+    return actor;
+}
+
+void ObjectFactory::PreloadSceneTextures(SceneNode* _scene,
+    JsonNode _node)
+{
+    if (_node->IsObject())
+    {
+        for (auto member = _node->MemberBegin();
+            member != _node->MemberEnd(); ++member)
+        {
+            PreloadSceneTextures(_scene, &member->value);
+        }
+    }
+    else if (_node->IsArray())
+    {
+        for (auto& element : _node->GetArray())
+        {
+            PreloadSceneTextures(_scene, &element);
+        }
+    }
+    else if (_node->IsString())
+    {
+        std::string path = _node->GetString();
+        std::string ext = path.size() > 4 ?
+            path.substr(path.size() - 4) : "";
+        std::transform(ext.begin(), ext.end(), ext.begin(),
+            [](unsigned char _c) { return (char)tolower(_c); });
+        if (ext == ".png" && !_scene->CheckIfTexExist(path))
+        {
+            ID3D11ShaderResourceView* texture = LoadTexture(path);
+            if (texture)
+            {
+                _scene->InsertNewTex(path, texture);
+            }
+        }
+    }
+}
+
+SPAWN_OVERRIDES ObjectFactory::ReadSpawnOverrides(JsonFile* _file,
+    std::string _nodePath)
+{
+    SPAWN_OVERRIDES overrides = {};
+
+    JsonNode node = GetJsonNode(_file, _nodePath + "/actor-name");
+    if (node && node->IsString())
+    {
+        overrides.Name = node->GetString();
+    }
+
+    node = GetJsonNode(_file, _nodePath + "/position");
+    if (node && node->IsArray() && node->Size() == 3 &&
+        (*node)[0].IsNumber())
+    {
+        overrides.HasPosition = true;
+        overrides.Position = MakeFloat3((*node)[0].GetFloat(),
+            (*node)[1].GetFloat(), (*node)[2].GetFloat());
+    }
+
+    node = GetJsonNode(_file, _nodePath + "/rotation");
+    if (node && node->IsArray() && node->Size() == 3 &&
+        (*node)[0].IsNumber())
+    {
+        overrides.HasRotation = true;
+        overrides.Rotation = MakeFloat3((*node)[0].GetFloat(),
+            (*node)[1].GetFloat(), (*node)[2].GetFloat());
+    }
+
+    node = GetJsonNode(_file, _nodePath + "/scale");
+    if (node && node->IsArray() && node->Size() == 3 &&
+        (*node)[0].IsNumber())
+    {
+        overrides.HasScale = true;
+        overrides.Scale = MakeFloat3((*node)[0].GetFloat(),
+            (*node)[1].GetFloat(), (*node)[2].GetFloat());
+    }
+
+    return overrides;
+}
+
+ActorObject* ObjectFactory::CreateActorFromProperty(
+    PropertyNode* _prop, SceneNode* _scene,
+    const SPAWN_OVERRIDES& _overrides)
+{
+    std::string name = _overrides.Name;
+    bool recyclable = false;
+    if (name == "")
+    {
+        name = _prop->MakeSpawnName();
+        recyclable = true;
+    }
+
+    ActorObject* actor =
+        new ActorObject(name, _scene, _prop->GetUpdateOrder());
+    TELEMETRY_ADD(ALLOCATIONS, 1 + _prop->GetComponentArray()->size());
+    if (recyclable)
+    {
+        actor->SetRecycleKey(_prop->GetPropertyName());
+    }
+    actor->SetDormantPolicy(_prop->GetDormantPolicy(),
+        _prop->GetDormantRate());
+    for (auto& tag : *(_prop->GetTagArray()))
+    {
+        actor->AddTag(tag);
+    }
+
+    for (auto& comp : *(_prop->GetComponentArray()))
+    {
+        if (comp.Type == COMP_TYPE::ATRANSFORM)
+        {
+            ATransformComponent* atc = new ATransformComponent(
+                name + "-transform", actor, comp.UpdateOrder,
+                comp.Position);
+            actor->AddAComponent(atc);
+            atc->SetPosition(_overrides.HasPosition ?
+                _overrides.Position : comp.Position);
+            atc->SetRotation(_overrides.HasRotation ?
+                _overrides.Rotation : comp.Rotation);
+            atc->SetScale(_overrides.HasScale ?
+                _overrides.Scale : comp.Scale);
+        }
+        else if (comp.Type == COMP_TYPE::ASPRITE)
+        {
+            ASpriteComponent* asc = new ASpriteComponent(
+                name + "-sprite", actor, comp.UpdateOrder,
+                comp.DrawOrder);
+            actor->AddAComponent(asc);
+            asc->SetPreloadedTexture(comp.Texture);
+            asc->SetTexWidth(comp.TexSize.x);
+            asc->SetTexHeight(comp.TexSize.y);
+        }
+        else if (comp.Type == COMP_TYPE::ACOLLISION)
+        {
+            ACollisionComponent* acc = new ACollisionComponent(
+                name + "-collision", actor, comp.UpdateOrder);
+            actor->AddAComponent(acc);
+            acc->SetCollisionStatus(comp.CollisionType,
+                comp.CollisionSize, comp.ShowCollision);
+        }
+        else if (comp.Type == COMP_TYPE::AINPUT)
+        {
+            AInputComponent* aic = new AInputComponent(
+                name + "-input", actor, comp.UpdateOrder);
+            actor->AddAComponent(aic);
+            aic->SetInputProcessFunc(comp.InputFunc);
+            aic->SetCoroutineFunc(comp.InputCoroutine);
+        }
+        else if (comp.Type == COMP_TYPE::ATIMER)
+        {
+            ATimerComponent* atic = new ATimerComponent(
+                name + "-timer", actor, comp.UpdateOrder);
+            actor->AddAComponent(atic);
+            for (auto& timer : comp.Timers)
+            {
+                atic->AddTimer(timer);
+            }
+        }
+        else if (comp.Type == COMP_TYPE::AANIMATE)
+        {
+            AAnimateComponent* aac = new AAnimateComponent(
+                name + "-animate", actor, comp.UpdateOrder);
+            actor->AddAComponent(aac);
+            for (auto& ani : comp.Animates)
+            {
+                aac->LoadAnimate(ani.Name, ani.TexPath, ani.Texture,
+                    ani.Stride, ani.MaxCut, ani.RepeatFlg,
+                    ani.SwitchTime);
+            }
+            if (comp.InitAnimate != "")
+            {
+                aac->ChangeAnimateTo(comp.InitAnimate);
+            }
+        }
+        else if (comp.Type == COMP_TYPE::AINTERACT)
+        {
+            AInteractionComponent* aitc = new AInteractionComponent(
+                name + "-interaction", actor, comp.UpdateOrder);
+            actor->AddAComponent(aitc);
+            aitc->SetInitFunc(comp.InterInitFunc);
+            aitc->SetUpdateFunc(comp.InterUpdateFunc);
+            aitc->SetDestoryFunc(comp.InterDestoryFunc);
+            aitc->SetCoroutineFunc(comp.InterCoroutine);
+        }
+    }
+
+    return actor;
+}
+
+void ObjectFactory::ResetPrefabActor(ActorObject* _actor,
+    PropertyNode* _prop, const SPAWN_OVERRIDES& _overrides)
+{
+    if (!_prop)
+    {
+        return;
+    }
+
+    std::string name = _actor->GetObjectName();
+    for (auto& comp : *(_prop->GetComponentArray()))
+    {
+        if (comp.Type == COMP_TYPE::ATRANSFORM)
+        {
+            ATransformComponent* atc = (ATransformComponent*)
+                (_actor->GetAComponent(name + "-transform"));
+            atc->SetCompActive(STATUS::NEED_INIT);
+            atc->SetPosition(_overrides.HasPosition ?
+                _overrides.Position : comp.Position);
+            atc->SetRotation(_overrides.HasRotation ?
+                _overrides.Rotation : comp.Rotation);
+            atc->SetScale(_overrides.HasScale ?
+                _overrides.Scale : comp.Scale);
+        }
+        else if (comp.Type == COMP_TYPE::ASPRITE)
+        {
+            ASpriteComponent* asc = (ASpriteComponent*)
+                (_actor->GetAComponent(name + "-sprite"));
+            asc->SetCompActive(STATUS::NEED_INIT);
+            asc->SetTexWidth(comp.TexSize.x);
+            asc->SetTexHeight(comp.TexSize.y);
+            asc->SetOffsetColor(MakeFloat4(1.f, 1.f, 1.f, 1.f));
+            asc->SetVisible(true);
+            asc->ResetFirstTexture();
+        }
+        else if (comp.Type == COMP_TYPE::ACOLLISION)
+        {
+            ACollisionComponent* acc = (ACollisionComponent*)
+                (_actor->GetAComponent(name + "-collision"));
+            acc->SetCompActive(STATUS::NEED_INIT);
+            acc->SetCollisionType(comp.CollisionType);
+            acc->SetCollisionSize(comp.CollisionSize);
+        }
+        else if (comp.Type == COMP_TYPE::ATIMER)
+        {
+            ATimerComponent* atic = (ATimerComponent*)
+                (_actor->GetAComponent(name + "-timer"));
+            atic->SetCompActive(STATUS::NEED_INIT);
+            for (auto& timer : comp.Timers)
+            {
+                atic->PauseTimer(timer);
+                atic->ResetTimer(timer);
+            }
+        }
+        else if (comp.Type == COMP_TYPE::AANIMATE)
+        {
+            AAnimateComponent* aac = (AAnimateComponent*)
+                (_actor->GetAComponent(name + "-animate"));
+            aac->SetCompActive(STATUS::NEED_INIT);
+            aac->ClearCurrentAnimate();
+            aac->ResetCurrentAnimateCut();
+            if (comp.InitAnimate != "")
+            {
+                aac->ChangeAnimateTo(comp.InitAnimate);
+            }
+        }
+        else if (comp.Type == COMP_TYPE::AINPUT)
+        {
+            _actor->GetAComponent(name + "-input")->
+                SetCompActive(STATUS::NEED_INIT);
+        }
+        else if (comp.Type == COMP_TYPE::AINTERACT)
+        {
+            _actor->GetAComponent(name + "-interaction")->
+                SetCompActive(STATUS::NEED_INIT);
+        }
+    }
 }
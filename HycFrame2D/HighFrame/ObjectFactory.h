@@ -14,6 +14,17 @@
 #include "json.h"
 #include "HFCommon.h"
 
+struct SPAWN_OVERRIDES
+{
+    std::string Name = "";
+    bool HasPosition = false;
+    Float3 Position = MakeFloat3(0.f, 0.f, 0.f);
+    bool HasRotation = false;
+    Float3 Rotation = MakeFloat3(0.f, 0.f, 0.f);
+    bool HasScale = false;
+    Float3 Scale = MakeFloat3(1.f, 1.f, 1.f);
+};
+
 class ObjectFactory
 {
 public:
@@ -28,9 +39,15 @@ public:
     class SceneNode* CreateNewScene(std::string _name,
         std::string _configPath);
 
+    class SceneNode* CreateNewScene(std::string _name,
+        std::string _configPath, JsonFile* _config);
+
     void ResetSceneNode(class SceneNode* _scene,
         std::string _configPath);
 
+    class ActorObject* Spawn(class SceneNode* _scene,
+        std::string _prefabId, const SPAWN_OVERRIDES& _overrides);
+
     std::unordered_map<std::string, ActorInputProcessFuncType>*
         GetActorInputPool();
 
@@ -55,6 +72,18 @@ public:
     std::unordered_map<std::string, UiInterDestoryFuncType>*
         GetUiInterDestoryPool();
 
+    std::unordered_map<std::string, ActorInputCoroutineFuncType>*
+        GetActorInputCoroutinePool();
+
+    std::unordered_map<std::string, ActorInterCoroutineFuncType>*
+        GetActorInterCoroutinePool();
+
+    std::unordered_map<std::string, UiInputCoroutineFuncType>*
+        GetUiInputCoroutinePool();
+
+    std::unordered_map<std::string, UiInterCoroutineFuncType>*
+        GetUiInterCoroutinePool();
+
 private:
     class ActorObject* CreateNewAObject(JsonFile* _file,
         std::string _nodePath, class SceneNode* _scene);
@@ -80,6 +109,25 @@ private:
     void ResetUComp(class UiObject* _ui,
         JsonFile* _file, std::string _nodePath);
 
+    void LoadTilemapLayer(class ATilemapComponent* _atmc,
+        JsonFile* _file, std::string _nodePath);
+
+    void LoadParticleEmitter(class AParticleComponent* _apc,
+        JsonFile* _file, std::string _nodePath);
+
+    SPAWN_OVERRIDES ReadSpawnOverrides(JsonFile* _file,
+        std::string _nodePath);
+
+    void PreloadSceneTextures(class SceneNode* _scene,
+        JsonNode _node);
+
+    class ActorObject* CreateActorFromProperty(
+        class PropertyNode* _prop, class SceneNode* _scene,
+        const SPAWN_OVERRIDES& _overrides);
+
+    void ResetPrefabActor(class ActorObject* _actor,
+        class PropertyNode* _prop, const SPAWN_OVERRIDES& _overrides);
+
 private:
     class PropertyManager* mPropertyManagerPtr;
 
@@ -108,5 +156,17 @@ private:
 
     std::unordered_map<std::string, UiInterDestoryFuncType>
         mUiInteractionDestoryFunctionPool;
+
+    std::unordered_map<std::string, ActorInputCoroutineFuncType>
+        mActorInputCoroutinePool;
+
+    std::unordered_map<std::string, ActorInterCoroutineFuncType>
+        mActorInteractionCoroutinePool;
+
+    std::unordered_map<std::string, UiInputCoroutineFuncType>
+        mUiInputCoroutinePool;
+
+    std::unordered_map<std::string, UiInterCoroutineFuncType>
+        mUiInteractionCoroutinePool;
 };
 
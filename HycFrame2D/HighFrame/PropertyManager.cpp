@@ -9,10 +9,13 @@
 
 #include "PropertyManager.h"
 #include "PropertyNode.h"
+#include "texture.h"
 
-PropertyManager::PropertyManager() :mPropertyMap({})
+PropertyManager::PropertyManager() :mPropertyMap({}),
+    mPrefabTexturePool({})
 {
     mPropertyMap.clear();
+    mPrefabTexturePool.clear();
 }
 
 PropertyManager::~PropertyManager()
@@ -20,16 +23,75 @@ PropertyManager::~PropertyManager()
 
 }
 
-bool PropertyManager::StartUp()
+bool PropertyManager::StartUp(ObjectFactory* _factory)
 {
+    JsonFile prefabList = {};
+    LoadJsonFile(&prefabList, "rom:/Configs/prefab-list.json");
+    if (prefabList.HasParseError())
+    {
+        P_LOG(LOG_WARNING,
+            "cannot load prefab list, no prefab will be used\n");
+        return true;
+    }
+
+    if (!prefabList.HasMember("prefab") ||
+        !prefabList["prefab"].IsArray())
+    {
+        P_LOG(LOG_WARNING, "prefab list is empty\n");
+        return true;
+    }
+
     bool result = true;
+    for (auto& prefab : prefabList["prefab"].GetArray())
+    {
+        if (!prefab.HasMember("name") || !prefab["name"].IsString() ||
+            !prefab.HasMember("path") || !prefab["path"].IsString())
+        {
+            P_LOG(LOG_ERROR, "invalid prefab info in prefab list\n");
+            result = false;
+            continue;
+        }
+
+        std::string name = prefab["name"].GetString();
+        std::string path = prefab["path"].GetString();
+        if (mPropertyMap.find(name) != mPropertyMap.end())
+        {
+            P_LOG(LOG_ERROR,
+                "this prefab name has been used : [ %s ]\n",
+                name.c_str());
+            result = false;
+            continue;
+        }
+
+        PropertyNode* node = new PropertyNode(name, path);
+        if (!node->LoadPropertyFile(this, _factory))
+        {
+            P_LOG(LOG_ERROR,
+                "failed to load prefab : [ %s ]\n", name.c_str());
+            delete node;
+            result = false;
+            continue;
+        }
+
+        mPropertyMap.insert(std::make_pair(name, node));
+    }
 
     return result;
 }
 
 void PropertyManager::CleanAndStop()
 {
+    for (auto& node : mPropertyMap)
+    {
+        delete node.second;
+    }
+    mPropertyMap.clear();
 
+    for (auto& tex : mPrefabTexturePool)
+    {
+        UnloadTexture(&tex.second);
+    }
+    mPrefabTexturePool.clear();
 }
 
 PropertyNode* PropertyManager::GetPropertyNode(std::string _name)
@@ -43,3 +105,18 @@ PropertyNode* PropertyManager::GetPropertyNode(std::string _name)
 
     return mPropertyMap[_name];
 }
+
+ID3D11ShaderResourceView* PropertyManager::LoadPrefabTexture(
+    std::string _path)
+{
+    auto exist = mPrefabTexturePool.find(_path);
+    if (exist != mPrefabTexturePool.end())
+    {
+        return exist->second;
+    }
+
+    ID3D11ShaderResourceView* texture = LoadTexture(_path);
+    mPrefabTexturePool.insert(std::make_pair(_path, texture));
+
+    return texture;
+}
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include "HFCommon.h"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -19,13 +20,18 @@ public:
     PropertyManager();
     ~PropertyManager();
 
-    bool StartUp();
+    bool StartUp(class ObjectFactory* _factory);
 
     void CleanAndStop();
 
     class PropertyNode* GetPropertyNode(std::string _name);
 
+    ID3D11ShaderResourceView* LoadPrefabTexture(std::string _path);
+
 private:
     std::unordered_map<std::string, class PropertyNode*>
         mPropertyMap;
+
+    std::unordered_map<std::string, ID3D11ShaderResourceView*>
+        mPrefabTexturePool;
 };
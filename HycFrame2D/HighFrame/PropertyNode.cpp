@@ -1,19 +1,97 @@
 ﻿//---------------------------------------------------------------
 // File: PropertyNode.cpp
 // Proj: HycFrame2D
-// Info: ロード用プロパティ節点
+// Info: ロード用オブジェクトプロパティ節点
 // Date: 2021.06.10
 // Mail: cai_genkan@outlook.com
 // Comt: NULL
 //---------------------------------------------------------------
 
 #include "PropertyNode.h"
+#include "PropertyManager.h"
+#include "ObjectFactory.h"
+
+namespace
+{
+    bool ReadFloat3(JsonNode _node, const char* _key, Float3* _out)
+    {
+        if (!_node->HasMember(_key))
+        {
+            return false;
+        }
+
+        rapidjson::Value& arr = (*_node)[_key];
+        if (!arr.IsArray() || arr.Size() != 3 ||
+            !arr[0].IsNumber() || !arr[1].IsNumber() ||
+            !arr[2].IsNumber())
+        {
+            return false;
+        }
+
+        *_out = MakeFloat3(arr[0].GetFloat(),
+            arr[1].GetFloat(), arr[2].GetFloat());
+        return true;
+    }
+
+    bool ReadFloat2(JsonNode _node, const char* _key, Float2* _out)
+    {
+        if (!_node->HasMember(_key))
+        {
+            return false;
+        }
+
+        rapidjson::Value& arr = (*_node)[_key];
+        if (!arr.IsArray() || arr.Size() != 2 ||
+            !arr[0].IsNumber() || !arr[1].IsNumber())
+        {
+            return false;
+        }
+
+        *_out = MakeFloat2(arr[0].GetFloat(), arr[1].GetFloat());
+        return true;
+    }
+
+    std::string ReadString(JsonNode _node, const char* _key)
+    {
+        if (_node->HasMember(_key) && (*_node)[_key].IsString())
+        {
+            return (*_node)[_key].GetString();
+        }
+
+        return "";
+    }
+
+    template <typename T>
+    T FindFunc(std::unordered_map<std::string, T>* _pool,
+        const std::string& _name)
+    {
+        if (_name == "")
+        {
+            return nullptr;
+        }
+
+        auto found = _pool->find(_name);
+        if (found == _pool->end())
+        {
+            P_LOG(LOG_WARNING,
+                "cannot find this func in pool : [ %s ]\n",
+                _name.c_str());
+            return nullptr;
+        }
+
+        return found->second;
+    }
+}
 
 PropertyNode::PropertyNode(std::string _name, std::string _path) :
-    mName(_name), mObjectType(OBJ_TYPE::NULLTYPE),
-    mComponentSet({})
+    mName(_name), mPath(_path), mObjectType(OBJ_TYPE::NULLTYPE),
+    mUpdateOrder(0), mDormantPolicy(DORMANT_POLICY::ALWAYS_ACTIVE),
+    mDormantRate(1), mComponentSet({}), mComponentArray({}),
+    mTagArray({}), mSpawnCounter(0)
 {
     mComponentSet.clear();
+    mComponentArray.clear();
+    mTagArray.clear();
 }
 
 PropertyNode::~PropertyNode()
@@ -26,7 +104,305 @@ std::string PropertyNode::GetPropertyName() const
     return mName;
 }
 
-void PropertyNode::LoadPropertyFile(std::string _path)
+bool PropertyNode::LoadPropertyFile(PropertyManager* _pmPtr,
+    ObjectFactory* _factory)
+{
+    JsonFile prefab = {};
+    LoadJsonFile(&prefab, mPath);
+    if (prefab.HasParseError())
+    {
+        P_LOG(LOG_ERROR,
+            "failed to parse json file [ %s ] with error [ %d ]\n",
+            mPath.c_str(), prefab.GetParseError());
+        return false;
+    }
+
+    std::string type = ReadString(&prefab, "prefab-type");
+    if (type != "" && type != "actor")
+    {
+        P_LOG(LOG_ERROR,
+            "only actor prefab is supported : [ %s ]\n",
+            mName.c_str());
+        return false;
+    }
+    mObjectType = OBJ_TYPE::ACTOR;
+
+    if (prefab.HasMember("update-order") &&
+        prefab["update-order"].IsInt())
+    {
+        mUpdateOrder = prefab["update-order"].GetInt();
+    }
+
+    std::string policy = ReadString(&prefab, "dormant-policy");
+    if (policy == "reduced")
+    {
+        mDormantPolicy = DORMANT_POLICY::REDUCED;
+    }
+    else if (policy == "sleep")
+    {
+        mDormantPolicy = DORMANT_POLICY::SLEEP;
+    }
+    if (prefab.HasMember("dormant-rate") &&
+        prefab["dormant-rate"].IsUint())
+    {
+        mDormantRate = prefab["dormant-rate"].GetUint();
+    }
+
+    if (prefab.HasMember("tags") && prefab["tags"].IsArray())
+    {
+        for (auto& tag : prefab["tags"].GetArray())
+        {
+            if (tag.IsString())
+            {
+                mTagArray.push_back(tag.GetString());
+            }
+        }
+    }
+
+    if (!prefab.HasMember("components") ||
+        !prefab["components"].IsArray())
+    {
+        P_LOG(LOG_ERROR,
+            "prefab doesn't have any component : [ %s ]\n",
+            mName.c_str());
+        return false;
+    }
+
+    for (auto& comp : prefab["components"].GetArray())
+    {
+        COMP_PROPERTY prop = {};
+        if (!LoadComponent(_pmPtr, _factory, &comp, &prop))
+        {
+            return false;
+        }
+
+        for (auto& exist : mComponentSet)
+        {
+            if (exist == prop.Type)
+            {
+                P_LOG(LOG_ERROR,
+                    "prefab has a duplicate component : [ %s ]\n",
+                    mName.c_str());
+                return false;
+            }
+        }
+
+        mComponentSet.push_back(prop.Type);
+        mComponentArray.push_back(prop);
+    }
+
+    bool hasTransform = false;
+    bool needTransform = false;
+    for (auto& type : mComponentSet)
+    {
+        if (type == COMP_TYPE::ATRANSFORM)
+        {
+            hasTransform = true;
+        }
+        else if (type == COMP_TYPE::ASPRITE ||
+            type == COMP_TYPE::ACOLLISION)
+        {
+            needTransform = true;
+        }
+    }
+    if (needTransform && !hasTransform)
+    {
+        P_LOG(LOG_ERROR,
+            "prefab needs a transform component : [ %s ]\n",
+            mName.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool PropertyNode::LoadComponent(PropertyManager* _pmPtr,
+    ObjectFactory* _factory, JsonNode _node, COMP_PROPERTY* _prop)
+{
+    std::string compType = ReadString(_node, "type");
+    if (_node->HasMember("update-order") &&
+        (*_node)["update-order"].IsInt())
+    {
+        _prop->UpdateOrder = (*_node)["update-order"].GetInt();
+    }
+
+    if (compType == "transform")
+    {
+        _prop->Type = COMP_TYPE::ATRANSFORM;
+        Float3 init = MakeFloat3(0.f, 0.f, 0.f);
+        ReadFloat3(_node, "init-value", &init);
+        _prop->Position = init;
+        _prop->Rotation = init;
+        ReadFloat3(_node, "position", &_prop->Position);
+        ReadFloat3(_node, "rotation", &_prop->Rotation);
+        ReadFloat3(_node, "scale", &_prop->Scale);
+    }
+    else if (compType == "sprite")
+    {
+        _prop->Type = COMP_TYPE::ASPRITE;
+        if (_node->HasMember("draw-order") &&
+            (*_node)["draw-order"].IsInt())
+        {
+            _prop->DrawOrder = (*_node)["draw-order"].GetInt();
+        }
+        std::string path = ReadString(_node, "texture-path");
+        if (path != "")
+        {
+            _prop->Texture = _pmPtr->LoadPrefabTexture(path);
+        }
+        if (_node->HasMember("texture-width") &&
+            (*_node)["texture-width"].IsNumber())
+        {
+            _prop->TexSize.x = (*_node)["texture-width"].GetFloat();
+        }
+        if (_node->HasMember("texture-height") &&
+            (*_node)["texture-height"].IsNumber())
+        {
+            _prop->TexSize.y = (*_node)["texture-height"].GetFloat();
+        }
+    }
+    else if (compType == "collision")
+    {
+        _prop->Type = COMP_TYPE::ACOLLISION;
+        std::string ctype = ReadString(_node, "collision-type");
+        if (ctype == "circle")
+        {
+            _prop->CollisionType = COLLISION_TYPE::CIRCLE;
+        }
+        else if (ctype == "rectangle")
+        {
+            _prop->CollisionType = COLLISION_TYPE::RECTANGLE;
+        }
+        ReadFloat2(_node, "collision-size", &_prop->CollisionSize);
+        if (_node->HasMember("show-flag") &&
+            (*_node)["show-flag"].IsBool())
+        {
+            _prop->ShowCollision = (*_node)["show-flag"].GetBool();
+        }
+    }
+    else if (compType == "input")
+    {
+        _prop->Type = COMP_TYPE::AINPUT;
+        _prop->InputFunc = FindFunc(_factory->GetActorInputPool(),
+            ReadString(_node, "func-name"));
+        _prop->InputCoroutine = FindFunc(
+            _factory->GetActorInputCoroutinePool(),
+            ReadString(_node, "coroutine-func-name"));
+    }
+    else if (compType == "timer")
+    {
+        _prop->Type = COMP_TYPE::ATIMER;
+        if (_node->HasMember("timers") && (*_node)["timers"].IsArray())
+        {
+            for (auto& timer : (*_node)["timers"].GetArray())
+            {
+                if (timer.IsString())
+                {
+                    _prop->Timers.push_back(timer.GetString());
+                }
+            }
+        }
+    }
+    else if (compType == "animate")
+    {
+        _prop->Type = COMP_TYPE::AANIMATE;
+        if (_node->HasMember("animates") &&
+            (*_node)["animates"].IsArray())
+        {
+            for (auto& ani : (*_node)["animates"].GetArray())
+            {
+                ANIMATE_PROPERTY aniProp = {};
+                aniProp.Name = ReadString(&ani, "animate-name");
+                aniProp.TexPath = ReadString(&ani, "animate-path");
+                if (aniProp.Name == "" || aniProp.TexPath == "")
+                {
+                    P_LOG(LOG_ERROR,
+                        "invalid animate in prefab : [ %s ]\n",
+                        mName.c_str());
+                    return false;
+                }
+                aniProp.Texture =
+                    _pmPtr->LoadPrefabTexture(aniProp.TexPath);
+                ReadFloat2(&ani, "animate-stride", &aniProp.Stride);
+                if (ani.HasMember("max-count") &&
+                    ani["max-count"].IsUint())
+                {
+                    aniProp.MaxCut = ani["max-count"].GetUint();
+                }
+                if (ani.HasMember("repeat-flag") &&
+                    ani["repeat-flag"].IsBool())
+                {
+                    aniProp.RepeatFlg = ani["repeat-flag"].GetBool();
+                }
+                if (ani.HasMember("frame-time") &&
+                    ani["frame-time"].IsNumber())
+                {
+                    aniProp.SwitchTime = ani["frame-time"].GetFloat();
+                }
+                _prop->Animates.push_back(aniProp);
+            }
+        }
+        _prop->InitAnimate = ReadString(_node, "init-animate");
+    }
+    else if (compType == "interaction")
+    {
+        _prop->Type = COMP_TYPE::AINTERACT;
+        _prop->InterInitFunc = FindFunc(
+            _factory->GetActorInterInitPool(),
+            ReadString(_node, "init-func-name"));
+        _prop->InterUpdateFunc = FindFunc(
+            _factory->GetActorInterUpdatePool(),
+            ReadString(_node, "update-func-name"));
+        _prop->InterDestoryFunc = FindFunc(
+            _factory->GetActorInterDestoryPool(),
+            ReadString(_node, "destory-func-name"));
+        _prop->InterCoroutine = FindFunc(
+            _factory->GetActorInterCoroutinePool(),
+            ReadString(_node, "coroutine-func-name"));
+    }
+    else
+    {
+        P_LOG(LOG_ERROR,
+            "this comp type cannot be used in prefab [ %s ]\n",
+            compType.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+OBJ_TYPE PropertyNode::GetObjectType() const
+{
+    return mObjectType;
+}
+
+int PropertyNode::GetUpdateOrder() const
+{
+    return mUpdateOrder;
+}
+
+DORMANT_POLICY PropertyNode::GetDormantPolicy() const
+{
+    return mDormantPolicy;
+}
+
+unsigned int PropertyNode::GetDormantRate() const
+{
+    return mDormantRate;
+}
+
+const std::vector<COMP_PROPERTY>*
+PropertyNode::GetComponentArray() const
+{
+    return &mComponentArray;
+}
+
+const std::vector<std::string>* PropertyNode::GetTagArray() const
 {
+    return &mTagArray;
+}
 
+std::string PropertyNode::MakeSpawnName()
+{
+    return mName + "-" + std::to_string(mSpawnCounter++);
 }
@@ -10,9 +10,52 @@
 #pragma once
 
 #include "HFCommon.h"
+#include "ACollisionComponent.h"
+#include "json.h"
 #include <string>
 #include <vector>
 
+struct ANIMATE_PROPERTY
+{
+    std::string Name = "";
+    std::string TexPath = "";
+    ID3D11ShaderResourceView* Texture = nullptr;
+    Float2 Stride = MakeFloat2(0.f, 0.f);
+    unsigned int MaxCut = 0;
+    bool RepeatFlg = false;
+    float SwitchTime = 0.f;
+};
+
+struct COMP_PROPERTY
+{
+    COMP_TYPE Type = COMP_TYPE::NULLTYPE;
+    int UpdateOrder = 0;
+
+    Float3 Position = MakeFloat3(0.f, 0.f, 0.f);
+    Float3 Rotation = MakeFloat3(0.f, 0.f, 0.f);
+    Float3 Scale = MakeFloat3(1.f, 1.f, 1.f);
+
+    int DrawOrder = 0;
+    ID3D11ShaderResourceView* Texture = nullptr;
+    Float2 TexSize = MakeFloat2(0.f, 0.f);
+
+    COLLISION_TYPE CollisionType = COLLISION_TYPE::NULLTYPE;
+    Float2 CollisionSize = MakeFloat2(0.f, 0.f);
+    bool ShowCollision = false;
+
+    std::vector<std::string> Timers = {};
+
+    std::vector<ANIMATE_PROPERTY> Animates = {};
+    std::string InitAnimate = "";
+
+    ActorInputProcessFuncType InputFunc = nullptr;
+    ActorInputCoroutineFuncType InputCoroutine = nullptr;
+    ActorInterInitFuncType InterInitFunc = nullptr;
+    ActorInterUpdateFuncType InterUpdateFunc = nullptr;
+    ActorInterDestoryFuncType InterDestoryFunc = nullptr;
+    ActorInterCoroutineFuncType InterCoroutine = nullptr;
+};
+
 class PropertyNode
 {
 public:
@@ -21,14 +64,47 @@ public:
 
     std::string GetPropertyName() const;
 
+    bool LoadPropertyFile(class PropertyManager* _pmPtr,
+        class ObjectFactory* _factory);
+
+    OBJ_TYPE GetObjectType() const;
+
+    int GetUpdateOrder() const;
+
+    DORMANT_POLICY GetDormantPolicy() const;
+
+    unsigned int GetDormantRate() const;
+
+    const std::vector<COMP_PROPERTY>* GetComponentArray() const;
+
+    const std::vector<std::string>* GetTagArray() const;
+
+    std::string MakeSpawnName();
+
 private:
-    void LoadPropertyFile(std::string _path);
+    bool LoadComponent(class PropertyManager* _pmPtr,
+        class ObjectFactory* _factory, JsonNode _node,
+        COMP_PROPERTY* _prop);
 
 private:
     const std::string mName;
 
+    const std::string mPath;
+
     OBJ_TYPE mObjectType;
 
+    int mUpdateOrder;
+
+    DORMANT_POLICY mDormantPolicy;
+
+    unsigned int mDormantRate;
+
     std::vector<COMP_TYPE> mComponentSet;
+
+    std::vector<COMP_PROPERTY> mComponentArray;
+
+    std::vector<std::string> mTagArray;
+
+    unsigned int mSpawnCounter;
 };
 
@@ -0,0 +1,409 @@
+﻿//---------------------------------------------------------------
+// File: RenderCommandQueue.cpp
+// Proj: HycFrame2D
+// Info: 描画コマンドの記録と描画スレッドでの再生
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "RenderCommandQueue.h"
+
+#define INIT_COMMAND_CAPACITY (1024)
+#define INIT_QUAD_CAPACITY (4096)
+
+namespace
+{
+    const RENDER_MATRIX IDENTITY_MATRIX =
+    {
+        1.f,0.f,0.f,0.f,
+        0.f,1.f,0.f,0.f,
+        0.f,0.f,1.f,0.f,
+        0.f,0.f,0.f,1.f
+    };
+}
+
+RenderCommandList::RenderCommandList() :
+    mCommandArray({}), mQuadArray({}), mTransformArray({})
+{
+    mCommandArray.reserve(INIT_COMMAND_CAPACITY);
+    mQuadArray.reserve(INIT_QUAD_CAPACITY);
+    mTransformArray.reserve(INIT_COMMAND_CAPACITY);
+}
+
+RenderCommandList::~RenderCommandList()
+{
+
+}
+
+void RenderCommandList::ResetList()
+{
+    mCommandArray.clear();
+    mQuadArray.clear();
+    mTransformArray.clear();
+}
+
+void RenderCommandList::SetViewMatrix(const RENDER_MATRIX& _view)
+{
+    // the view lives in the transform of a command without quads
+    PushCommand(RENDER_CMD_TYPE::SET_VIEW, nullptr, _view);
+}
+
+void RenderCommandList::PushSprite(const RENDER_MATRIX& _world,
+    ID3D11ShaderResourceView* _texture, RENDER_FLOAT4 _rect,
+    RENDER_FLOAT4 _uv, RENDER_FLOAT4 _color)
+{
+    PushCommand(RENDER_CMD_TYPE::SPRITE, _texture, _world);
+    mQuadArray.push_back({ _rect, _uv, _color });
+    ++mCommandArray.back().QuadCount;
+}
+
+void RenderCommandList::BeginTextRun(ID3D11ShaderResourceView* _font)
+{
+    PushCommand(RENDER_CMD_TYPE::TEXT_RUN, _font, IDENTITY_MATRIX);
+}
+
+void RenderCommandList::PushGlyph(RENDER_FLOAT4 _rect,
+    RENDER_FLOAT4 _uv, RENDER_FLOAT4 _color)
+{
+    if (mCommandArray.empty() ||
+        mCommandArray.back().Type != RENDER_CMD_TYPE::TEXT_RUN)
+    {
+        return;
+    }
+
+    mQuadArray.push_back({ _rect, _uv, _color });
+    ++mCommandArray.back().QuadCount;
+}
+
+void RenderCommandList::PushDebugShape(const RENDER_MATRIX& _world,
+    ID3D11ShaderResourceView* _texture, RENDER_FLOAT4 _rect,
+    RENDER_FLOAT4 _color)
+{
+    PushCommand(RENDER_CMD_TYPE::DEBUG_SHAPE, _texture, _world);
+    mQuadArray.push_back({ _rect, { 0.f, 0.f, 1.f, 1.f }, _color });
+    ++mCommandArray.back().QuadCount;
+}
+
+void RenderCommandList::PushQuadBatch(RENDER_CMD_TYPE _type,
+    const RENDER_MATRIX& _world,
+    ID3D11ShaderResourceView* _texture,
+    const RENDER_QUAD* _quads, unsigned int _count)
+{
+    if (!_count)
+    {
+        return;
+    }
+
+    PushCommand(_type, _texture, _world);
+    mQuadArray.insert(mQuadArray.end(), _quads, _quads + _count);
+    mCommandArray.back().QuadCount = _count;
+}
+
+void RenderCommandList::PushCachedQuadBatch(RENDER_CMD_TYPE _type,
+    const RENDER_MATRIX& _world,
+    ID3D11ShaderResourceView* _texture,
+    const RENDER_QUAD* _quads, unsigned int _count,
+    unsigned int _cacheKey, unsigned int _cacheRevision)
+{
+    if (!_count)
+    {
+        return;
+    }
+
+    // the quads are still copied so a backend without the cache and
+    // a backend that dropped it can draw the batch all the same
+    PushQuadBatch(_type, _world, _texture, _quads, _count);
+    mCommandArray.back().CacheKey = _cacheKey;
+    mCommandArray.back().CacheRevision = _cacheRevision;
+}
+
+RENDER_QUAD* RenderCommandList::AllocateQuadBatch(
+    RENDER_CMD_TYPE _type, const RENDER_MATRIX& _world,
+    ID3D11ShaderResourceView* _texture, unsigned int _count)
+{
+    if (!_count)
+    {
+        return nullptr;
+    }
+
+    PushCommand(_type, _texture, _world);
+    size_t first = mQuadArray.size();
+    mQuadArray.resize(first + _count);
+    mCommandArray.back().QuadCount = _count;
+
+    return &mQuadArray[first];
+}
+
+void RenderCommandList::AppendList(const RenderCommandList* _other,
+    size_t _firstCommand)
+{
+    const auto& commands = _other->mCommandArray;
+    if (_firstCommand >= commands.size())
+    {
+        return;
+    }
+
+    unsigned int srcFirst = commands[_firstCommand].FirstQuad;
+    unsigned int dstFirst = (unsigned int)mQuadArray.size();
+    unsigned int srcTransform = commands[_firstCommand].Transform;
+    unsigned int dstTransform = (unsigned int)mTransformArray.size();
+    mQuadArray.insert(mQuadArray.end(),
+        _other->mQuadArray.begin() + srcFirst,
+        _other->mQuadArray.end());
+    mTransformArray.insert(mTransformArray.end(),
+        _other->mTransformArray.begin() + srcTransform,
+        _other->mTransformArray.end());
+    for (size_t i = _firstCommand; i < commands.size(); i++)
+    {
+        RENDER_COMMAND cmd = commands[i];
+        cmd.FirstQuad = cmd.FirstQuad - srcFirst + dstFirst;
+        cmd.Transform = cmd.Transform - srcTransform + dstTransform;
+        mCommandArray.push_back(cmd);
+    }
+}
+
+const std::vector<RENDER_COMMAND>*
+RenderCommandList::GetCommandArray() const
+{
+    return &mCommandArray;
+}
+
+const std::vector<RENDER_QUAD>* RenderCommandList::GetQuadArray() const
+{
+    return &mQuadArray;
+}
+
+const std::vector<RENDER_MATRIX>*
+RenderCommandList::GetTransformArray() const
+{
+    return &mTransformArray;
+}
+
+void RenderCommandList::PushCommand(RENDER_CMD_TYPE _type,
+    ID3D11ShaderResourceView* _texture,
+    const RENDER_MATRIX& _transform)
+{
+    mCommandArray.push_back({ _type, _texture,
+        (unsigned int)mTransformArray.size(),
+        (unsigned int)mQuadArray.size(), 0, 0, 0 });
+    mTransformArray.push_back(_transform);
+}
+
+NullRenderBackend::NullRenderBackend() :
+    mFrameCount(0), mRecordCommandArray({}), mRecordQuadArray({}),
+    mRecordTransformArray({}), mLastCommandArray({}),
+    mLastQuadArray({}), mLastTransformArray({})
+{
+
+}
+
+NullRenderBackend::~NullRenderBackend()
+{
+
+}
+
+bool NullRenderBackend::StartUp()
+{
+    return true;
+}
+
+void NullRenderBackend::CleanAndStop()
+{
+    mRecordCommandArray.clear();
+    mRecordQuadArray.clear();
+    mRecordTransformArray.clear();
+    mLastCommandArray.clear();
+    mLastQuadArray.clear();
+    mLastTransformArray.clear();
+}
+
+void NullRenderBackend::BeginFrame()
+{
+    mRecordCommandArray.clear();
+    mRecordQuadArray.clear();
+    mRecordTransformArray.clear();
+}
+
+void NullRenderBackend::ExecuteCommand(const RENDER_COMMAND& _cmd,
+    const RENDER_MATRIX& _transform, const RENDER_QUAD* _quads)
+{
+    RENDER_COMMAND cmd = _cmd;
+    cmd.FirstQuad = (unsigned int)mRecordQuadArray.size();
+    cmd.Transform = (unsigned int)mRecordTransformArray.size();
+    mRecordCommandArray.push_back(cmd);
+    mRecordTransformArray.push_back(_transform);
+    mRecordQuadArray.insert(mRecordQuadArray.end(),
+        _quads, _quads + _cmd.QuadCount);
+}
+
+void NullRenderBackend::EndFrame()
+{
+    mLastCommandArray.swap(mRecordCommandArray);
+    mLastQuadArray.swap(mRecordQuadArray);
+    mLastTransformArray.swap(mRecordTransformArray);
+    ++mFrameCount;
+}
+
+unsigned long long NullRenderBackend::GetFrameCount() const
+{
+    return mFrameCount;
+}
+
+const std::vector<RENDER_COMMAND>*
+NullRenderBackend::GetLastCommandArray() const
+{
+    return &mLastCommandArray;
+}
+
+const std::vector<RENDER_QUAD>*
+NullRenderBackend::GetLastQuadArray() const
+{
+    return &mLastQuadArray;
+}
+
+const std::vector<RENDER_MATRIX>*
+NullRenderBackend::GetLastTransformArray() const
+{
+    return &mLastTransformArray;
+}
+
+RenderCommandQueue::RenderCommandQueue() :
+    mBackendPtr(nullptr), mCommandLists(), mRecordIndex(0),
+    mPlaybackIndex(1), mUseRenderThread(false), mRenderThread(),
+    mQueueMutex(), mFrameReadyCV(), mFrameDoneCV(),
+    mFrameReadyFlg(false), mStopFlg(false)
+{
+
+}
+
+RenderCommandQueue::~RenderCommandQueue()
+{
+
+}
+
+bool RenderCommandQueue::StartUp(RenderBackend* _backend,
+    bool _useRenderThread)
+{
+    mBackendPtr = _backend;
+    if (!mBackendPtr || !mBackendPtr->StartUp())
+    {
+        return false;
+    }
+
+    mUseRenderThread = _useRenderThread;
+    mStopFlg = false;
+    mFrameReadyFlg = false;
+    if (mUseRenderThread)
+    {
+        mRenderThread = std::thread(
+            &RenderCommandQueue::RenderThreadLoop, this);
+    }
+
+    return true;
+}
+
+void RenderCommandQueue::CleanAndStop()
+{
+    if (mUseRenderThread && mRenderThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mQueueMutex);
+            mStopFlg = true;
+        }
+        mFrameReadyCV.notify_one();
+        mRenderThread.join();
+    }
+
+    if (mBackendPtr)
+    {
+        mBackendPtr->CleanAndStop();
+        mBackendPtr = nullptr;
+    }
+    mCommandLists[0].ResetList();
+    mCommandLists[1].ResetList();
+}
+
+RenderCommandList* RenderCommandQueue::GetRecordingList()
+{
+    return &mCommandLists[mRecordIndex];
+}
+
+void RenderCommandQueue::SubmitFrame()
+{
+    if (!mUseRenderThread)
+    {
+        PlaybackList(&mCommandLists[mRecordIndex]);
+        mCommandLists[mRecordIndex].ResetList();
+        return;
+    }
+
+    {
+        // the list that is about to be recorded into must be played
+        std::unique_lock<std::mutex> lock(mQueueMutex);
+        mFrameDoneCV.wait(lock, [this]() { return !mFrameReadyFlg; });
+        mPlaybackIndex = mRecordIndex;
+        mRecordIndex ^= 1;
+        mFrameReadyFlg = true;
+    }
+    mFrameReadyCV.notify_one();
+
+    mCommandLists[mRecordIndex].ResetList();
+}
+
+void RenderCommandQueue::WaitForRenderIdle()
+{
+    if (!mUseRenderThread)
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mQueueMutex);
+    mFrameDoneCV.wait(lock, [this]() { return !mFrameReadyFlg; });
+}
+
+void RenderCommandQueue::RenderThreadLoop()
+{
+    while (true)
+    {
+        unsigned int index = 0;
+        {
+            std::unique_lock<std::mutex> lock(mQueueMutex);
+            mFrameReadyCV.wait(lock,
+                [this]() { return mFrameReadyFlg || mStopFlg; });
+            if (mStopFlg)
+            {
+                mFrameReadyFlg = false;
+                break;
+            }
+            index = mPlaybackIndex;
+        }
+
+        PlaybackList(&mCommandLists[index]);
+
+        {
+            std::lock_guard<std::mutex> lock(mQueueMutex);
+            mFrameReadyFlg = false;
+        }
+        mFrameDoneCV.notify_one();
+    }
+
+    mFrameDoneCV.notify_all();
+}
+
+void RenderCommandQueue::PlaybackList(const RenderCommandList* _list)
+{
+    const RENDER_QUAD* quads = _list->GetQuadArray()->data();
+    const RENDER_MATRIX* transforms =
+        _list->GetTransformArray()->data();
+
+    mBackendPtr->BeginFrame();
+    for (auto& cmd : *(_list->GetCommandArray()))
+    {
+        if (cmd.QuadCount || cmd.Type == RENDER_CMD_TYPE::SET_VIEW)
+        {
+            mBackendPtr->ExecuteCommand(cmd, transforms[cmd.Transform],
+                quads + cmd.FirstQuad);
+        }
+    }
+    mBackendPtr->EndFrame();
+}
@@ -0,0 +1,232 @@
+﻿//---------------------------------------------------------------
+// File: RenderCommandQueue.h
+// Proj: HycFrame2D
+// Info: 描画コマンドの記録と描画スレッドでの再生
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct ID3D11ShaderResourceView;
+
+enum class RENDER_CMD_TYPE
+{
+    SPRITE,
+    TEXT_RUN,
+    DEBUG_SHAPE,
+    SET_VIEW,
+    TILE_CHUNK,
+    PARTICLE_BATCH
+};
+
+// plain floats keep the queue and the null backend free of directx,
+// only the d3d backend converts them back
+struct RENDER_FLOAT4
+{
+    float x;
+    float y;
+    float z;
+    float w;
+};
+
+struct RENDER_MATRIX
+{
+    float _11, _12, _13, _14;
+    float _21, _22, _23, _24;
+    float _31, _32, _33, _34;
+    float _41, _42, _43, _44;
+};
+
+// a quad only keeps what differs per quad, the matrix is stored once
+// for the whole command
+struct RENDER_QUAD
+{
+    RENDER_FLOAT4 Rect;
+    RENDER_FLOAT4 UV;
+    RENDER_FLOAT4 Color;
+};
+
+// a non zero cache key lets the backend keep the quads of a static
+// batch on the gpu, they are only uploaded again when the revision
+// changes
+struct RENDER_COMMAND
+{
+    RENDER_CMD_TYPE Type;
+    ID3D11ShaderResourceView* Texture;
+    unsigned int Transform;
+    unsigned int FirstQuad;
+    unsigned int QuadCount;
+    unsigned int CacheKey;
+    unsigned int CacheRevision;
+};
+
+class RenderCommandList
+{
+public:
+    RenderCommandList();
+    ~RenderCommandList();
+
+    void ResetList();
+
+    void SetViewMatrix(const RENDER_MATRIX& _view);
+
+    void PushSprite(const RENDER_MATRIX& _world,
+        ID3D11ShaderResourceView* _texture, RENDER_FLOAT4 _rect,
+        RENDER_FLOAT4 _uv, RENDER_FLOAT4 _color);
+
+    void BeginTextRun(ID3D11ShaderResourceView* _font);
+
+    void PushGlyph(RENDER_FLOAT4 _rect, RENDER_FLOAT4 _uv,
+        RENDER_FLOAT4 _color);
+
+    void PushDebugShape(const RENDER_MATRIX& _world,
+        ID3D11ShaderResourceView* _texture, RENDER_FLOAT4 _rect,
+        RENDER_FLOAT4 _color);
+
+    void PushQuadBatch(RENDER_CMD_TYPE _type,
+        const RENDER_MATRIX& _world,
+        ID3D11ShaderResourceView* _texture,
+        const RENDER_QUAD* _quads, unsigned int _count);
+
+    void PushCachedQuadBatch(RENDER_CMD_TYPE _type,
+        const RENDER_MATRIX& _world,
+        ID3D11ShaderResourceView* _texture,
+        const RENDER_QUAD* _quads, unsigned int _count,
+        unsigned int _cacheKey, unsigned int _cacheRevision);
+
+    RENDER_QUAD* AllocateQuadBatch(RENDER_CMD_TYPE _type,
+        const RENDER_MATRIX& _world,
+        ID3D11ShaderResourceView* _texture, unsigned int _count);
+
+    void AppendList(const RenderCommandList* _other,
+        size_t _firstCommand);
+
+    const std::vector<RENDER_COMMAND>* GetCommandArray() const;
+
+    const std::vector<RENDER_QUAD>* GetQuadArray() const;
+
+    const std::vector<RENDER_MATRIX>* GetTransformArray() const;
+
+private:
+    void PushCommand(RENDER_CMD_TYPE _type,
+        ID3D11ShaderResourceView* _texture,
+        const RENDER_MATRIX& _transform);
+
+private:
+    std::vector<RENDER_COMMAND> mCommandArray;
+
+    std::vector<RENDER_QUAD> mQuadArray;
+
+    std::vector<RENDER_MATRIX> mTransformArray;
+};
+
+class RenderBackend
+{
+public:
+    virtual ~RenderBackend() {}
+
+    virtual bool StartUp() = 0;
+
+    virtual void CleanAndStop() = 0;
+
+    virtual void BeginFrame() = 0;
+
+    virtual void ExecuteCommand(const RENDER_COMMAND& _cmd,
+        const RENDER_MATRIX& _transform,
+        const RENDER_QUAD* _quads) = 0;
+
+    virtual void EndFrame() = 0;
+};
+
+class NullRenderBackend :
+    public RenderBackend
+{
+public:
+    NullRenderBackend();
+    virtual ~NullRenderBackend();
+
+    virtual bool StartUp();
+
+    virtual void CleanAndStop();
+
+    virtual void BeginFrame();
+
+    virtual void ExecuteCommand(const RENDER_COMMAND& _cmd,
+        const RENDER_MATRIX& _transform, const RENDER_QUAD* _quads);
+
+    virtual void EndFrame();
+
+    unsigned long long GetFrameCount() const;
+
+    const std::vector<RENDER_COMMAND>* GetLastCommandArray() const;
+
+    const std::vector<RENDER_QUAD>* GetLastQuadArray() const;
+
+    const std::vector<RENDER_MATRIX>* GetLastTransformArray() const;
+
+private:
+    unsigned long long mFrameCount;
+
+    std::vector<RENDER_COMMAND> mRecordCommandArray;
+
+    std::vector<RENDER_QUAD> mRecordQuadArray;
+
+    std::vector<RENDER_MATRIX> mRecordTransformArray;
+
+    std::vector<RENDER_COMMAND> mLastCommandArray;
+
+    std::vector<RENDER_QUAD> mLastQuadArray;
+
+    std::vector<RENDER_MATRIX> mLastTransformArray;
+};
+
+class RenderCommandQueue
+{
+public:
+    RenderCommandQueue();
+    ~RenderCommandQueue();
+
+    bool StartUp(RenderBackend* _backend, bool _useRenderThread);
+
+    void CleanAndStop();
+
+    RenderCommandList* GetRecordingList();
+
+    void SubmitFrame();
+
+    void WaitForRenderIdle();
+
+private:
+    void RenderThreadLoop();
+
+    void PlaybackList(const RenderCommandList* _list);
+
+private:
+    RenderBackend* mBackendPtr;
+
+    RenderCommandList mCommandLists[2];
+
+    unsigned int mRecordIndex;
+
+    unsigned int mPlaybackIndex;
+
+    bool mUseRenderThread;
+
+    std::thread mRenderThread;
+
+    std::mutex mQueueMutex;
+
+    std::condition_variable mFrameReadyCV;
+
+    std::condition_variable mFrameDoneCV;
+
+    bool mFrameReadyFlg;
+
+    bool mStopFlg;
+};
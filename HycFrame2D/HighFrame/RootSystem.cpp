@@ -9,15 +9,30 @@
 
 #include "RootSystem.h"
 #include "SceneManager.h"
+#include "SceneNode.h"
 #include "PropertyManager.h"
 #include "ObjectFactory.h"
+#include "RenderCommandQueue.h"
+#include "DxRenderBackend.h"
+#include "InputReplay.h"
+#include "VirtualFileSystem.h"
+#include "StartupTaskGraph.h"
+#include "TelemetryOverlay.h"
 #include "main.h"
 #include "controller.h"
 #include "sound.h"
+#include <chrono>
+#include <sstream>
 
 RootSystem::RootSystem() :
     mSceneManagerPtr(nullptr), mPropertyManagerPtr(nullptr),
-    mObjectFactoryPtr(nullptr), mLastTime(0.f), mDeltaTime(0.16f)
+    mObjectFactoryPtr(nullptr), mRenderBackendPtr(nullptr),
+    mRenderCommandQueuePtr(nullptr), mLastTime(0.f), mDeltaTime(0.16f),
+    mRunMode(RUN_MODE::NORMAL), mReplayPath(""),
+    mInputRecorderPtr(nullptr), mInputReplayerPtr(nullptr),
+    mFrameStatisticsPtr(nullptr), mStartupGraphPtr(nullptr),
+    mComInitFlg(false), mTelemetryPath(""),
+    mTelemetryOverlayPtr(nullptr)
 {
 
 }
@@ -27,28 +42,120 @@ RootSystem::~RootSystem()
 
 }
 
-bool RootSystem::StartUp(HINSTANCE hInstance, int cmdShow)
+bool RootSystem::StartUp(HINSTANCE hInstance, int cmdShow,
+    LPSTR cmdLine)
 {
     P_LOG(LOG_MESSAGE,
         "[START UP] : starting up ROOT SYSTEM\n");
 
+    mStartupGraphPtr = new StartupTaskGraph();
+    ParseCommandLine(cmdLine ? cmdLine : "");
+
+    // com belongs to the main thread for the whole run, the startup
+    // workers use it through the multithreaded apartment
+    mComInitFlg = SUCCEEDED(CoInitializeEx(NULL, COINIT_MULTITHREADED));
+    if (!mComInitFlg)
+    {
+        P_LOG(LOG_ERROR, "failed to init com library\n");
+    }
+
     mSceneManagerPtr = new SceneManager();
     mPropertyManagerPtr = new PropertyManager();
     mObjectFactoryPtr = new ObjectFactory();
+    if (mRunMode == RUN_MODE::REPLAY)
+    {
+        // replays only measure the cpu side, nothing reaches the gpu
+        mRenderBackendPtr = new NullRenderBackend();
+    }
+    else
+    {
+        mRenderBackendPtr = new DxRenderBackend();
+    }
+    mRenderCommandQueuePtr = new RenderCommandQueue();
+
+    // the window and the device stay on the main thread, everything
+    // else runs on the workers as soon as what it needs is ready
+    JsonFile loadingConfig = {};
+    StartupTaskGraph* graph = mStartupGraphPtr;
+    graph->AddTask("mount-archive", []()
+        {
+            GetVirtualFileSystem()->MountArchive("rom.hpak");
+            return true;
+        }, {});
+    graph->AddTask("init-window", [hInstance, cmdShow]()
+        { return InitWindow(hInstance, cmdShow); }, {}, true);
+    graph->AddTask("init-directx", []() { return InitDirectX(); },
+        { "init-window" }, true);
+    graph->AddTask("init-sound", []() { return InitSound(); }, {});
+    graph->AddTask("init-input", []()
+        {
+            InitController();
+            LoadControllerActionMap("rom:/Configs/action-map.json");
+#ifdef INPUT_THREAD
+            StartControllerSampling(INPUT_SAMPLE_RATE);
+#endif // INPUT_THREAD
+            return true;
+        }, { "init-window", "mount-archive" });
+    graph->AddTask("render-queue", [this]()
+        {
+#ifdef RENDER_THREAD
+            return mRenderCommandQueuePtr->StartUp(
+                mRenderBackendPtr, true);
+#else
+            return mRenderCommandQueuePtr->StartUp(
+                mRenderBackendPtr, false);
+#endif // RENDER_THREAD
+        }, { "init-directx" }, true);
+    graph->AddTask("scene-manager", [this]()
+        {
+            bool result = mSceneManagerPtr->StartUp() &&
+                mObjectFactoryPtr->StartUp(
+                    mPropertyManagerPtr, mSceneManagerPtr);
+            mSceneManagerPtr->PostStartUp(
+                mPropertyManagerPtr, mObjectFactoryPtr,
+                mRenderCommandQueuePtr);
+            return result;
+        }, { "mount-archive" });
+    graph->AddTask("load-prefabs", [this]()
+        { return mPropertyManagerPtr->StartUp(mObjectFactoryPtr); },
+        { "init-directx", "scene-manager" });
+    graph->AddTask("parse-loading-scene", [&loadingConfig]()
+        {
+            LoadJsonFile(&loadingConfig, LOADING_SCENE_PATH);
+            return !loadingConfig.HasParseError();
+        }, { "mount-archive" });
+    graph->AddTask("load-loading-scene", [this, &loadingConfig]()
+        { return mSceneManagerPtr->LoadLoadingScene(&loadingConfig); },
+        { "parse-loading-scene", "load-prefabs", "init-sound" });
+    bool result1 = graph->RunAllTasks(STARTUP_WORKER_NUM);
+    P_LOG(LOG_MESSAGE, "[START UP] : startup graph took %.2f ms\n",
+        graph->GetElapsedMs());
 
-    bool result1 = InitSystem(hInstance, cmdShow);
-    bool result2 = InitSound();
-    bool result3 = mSceneManagerPtr->StartUp();
-    bool result4 = mPropertyManagerPtr->StartUp();
-    bool result5 = mObjectFactoryPtr->StartUp(
-        mPropertyManagerPtr, mSceneManagerPtr);
-    mSceneManagerPtr->PostStartUp(
-        mPropertyManagerPtr, mObjectFactoryPtr);
+#ifdef RUNTIME_TELEMETRY
+    if (mTelemetryOverlayPtr && !mTelemetryOverlayPtr->StartUp())
+    {
+        delete mTelemetryOverlayPtr;
+        mTelemetryOverlayPtr = nullptr;
+    }
+#endif // RUNTIME_TELEMETRY
 
-    InitController();
+    bool result7 = true;
+    if (mRunMode == RUN_MODE::RECORD)
+    {
+        mSceneManagerPtr->SetSyncLoading(true);
+        mInputRecorderPtr = new InputRecorder();
+        result7 = mInputRecorderPtr->StartRecording(mReplayPath);
+    }
+    else if (mRunMode == RUN_MODE::REPLAY)
+    {
+        mSceneManagerPtr->SetSyncLoading(true);
+        mInputReplayerPtr = new InputReplayer();
+        mFrameStatisticsPtr = new FrameTimeStatistics();
+        result7 = mInputReplayerPtr->LoadReplay(mReplayPath);
+        SetControllerInputSampler(mInputReplayerPtr);
+    }
 
-    bool result = result1 && result2 &&
-        result3 && result4 && result5;
+    bool result = result1 && result7;
     if (result)
     {
         P_LOG(LOG_MESSAGE,
@@ -65,6 +172,25 @@ bool RootSystem::StartUp(HINSTANCE hInstance, int cmdShow)
 
 void RootSystem::ClearAndStop()
 {
+    if (mRenderCommandQueuePtr)
+    {
+        mRenderCommandQueuePtr->CleanAndStop();
+        delete mRenderCommandQueuePtr;
+        mRenderCommandQueuePtr = nullptr;
+    }
+#ifdef RUNTIME_TELEMETRY
+    if (mTelemetryOverlayPtr)
+    {
+        mTelemetryOverlayPtr->CleanAndStop();
+        delete mTelemetryOverlayPtr;
+        mTelemetryOverlayPtr = nullptr;
+    }
+#endif // RUNTIME_TELEMETRY
+    if (mRenderBackendPtr)
+    {
+        delete mRenderBackendPtr;
+        mRenderBackendPtr = nullptr;
+    }
     if (mSceneManagerPtr)
     {
         mSceneManagerPtr->CleanAndStop();
@@ -84,9 +210,53 @@ void RootSystem::ClearAndStop()
         mObjectFactoryPtr = nullptr;
     }
 
+    if (mInputRecorderPtr)
+    {
+        mInputRecorderPtr->StopRecording();
+        delete mInputRecorderPtr;
+        mInputRecorderPtr = nullptr;
+    }
+    if (mInputReplayerPtr)
+    {
+        P_LOG(LOG_WARNING,
+            "replayed %u of %u frames with %u state mismatches\n",
+            mInputReplayerPtr->GetFrameIndex(),
+            mInputReplayerPtr->GetFrameCount(),
+            mInputReplayerPtr->GetMismatchCount());
+        SetControllerInputSampler(nullptr);
+        delete mInputReplayerPtr;
+        mInputReplayerPtr = nullptr;
+    }
+    if (mFrameStatisticsPtr)
+    {
+        mFrameStatisticsPtr->LogStatistics();
+        mFrameStatisticsPtr->WriteCsvFile(mReplayPath + ".csv");
+        delete mFrameStatisticsPtr;
+        mFrameStatisticsPtr = nullptr;
+    }
+#ifdef RUNTIME_TELEMETRY
+    if (mTelemetryPath != "")
+    {
+        GetTelemetryRegistry()->WriteCsvFile(mTelemetryPath + ".csv");
+        GetTelemetryRegistry()->WriteJsonFile(mTelemetryPath + ".json");
+    }
+#endif // RUNTIME_TELEMETRY
+
+    if (mStartupGraphPtr)
+    {
+        delete mStartupGraphPtr;
+        mStartupGraphPtr = nullptr;
+    }
+
     UninitController();
     UninitSound();
     UninitSystem();
+    GetVirtualFileSystem()->UnmountAllArchives();
+    if (mComInitFlg)
+    {
+        CoUninitialize();
+        mComInitFlg = false;
+    }
 
     P_LOG(LOG_MESSAGE,
         "[CLEAN STOP] : stop ROOT SYSTEM successed\n");
@@ -102,14 +272,29 @@ void RootSystem::RunGameLoop()
             TranslateMessage(&msg);
             DispatchMessage(&msg);
         }
+        else if (mRunMode == RUN_MODE::REPLAY)
+        {
+            RunReplayFrame();
+        }
         else
         {
-            GetDxHelperPtr()->ClearBuffer();
-
             UpdateController();
 
             mSceneManagerPtr->UpdateSceneManager(mDeltaTime);
 
+            DrawTelemetryOverlay();
+            mRenderCommandQueuePtr->SubmitFrame();
+            FinishStartupTrace();
+#ifdef RUNTIME_TELEMETRY
+            GetTelemetryRegistry()->SnapshotFrame();
+#endif // RUNTIME_TELEMETRY
+
+            if (mInputRecorderPtr)
+            {
+                mInputRecorderPtr->RecordFrame(*GetControllerSample(),
+                    mDeltaTime, HashCurrentScene());
+            }
+
             SwapAndClacDeltaTime();
 
             if (ShouldQuit() || 
@@ -125,7 +310,7 @@ void RootSystem::SwapAndClacDeltaTime()
 {
     float time = 0.f;
 #ifdef HYC_FRAME_2D
-    time = SwapBuffers();
+    time = GoRunLoopProcess();
 #else
     SwapBuffers();
     nn::os::Tick t = nn::os::GetSystemTick();
@@ -152,3 +337,101 @@ void RootSystem::SwapAndClacDeltaTime()
     }
     //NN_LOG("final delta : %f\n", mDeltaTime);
 }
+
+void RootSystem::ParseCommandLine(std::string _cmdLine)
+{
+    std::istringstream stream(_cmdLine);
+    std::string token = "";
+    while (stream >> token)
+    {
+        if ((token == "-record" || token == "-replay") &&
+            (stream >> mReplayPath))
+        {
+            mRunMode = (token == "-record") ?
+                RUN_MODE::RECORD : RUN_MODE::REPLAY;
+        }
+#ifdef RUNTIME_TELEMETRY
+        else if (token == "-telemetry")
+        {
+            stream >> mTelemetryPath;
+        }
+        else if (token == "-overlay" && !mTelemetryOverlayPtr)
+        {
+            mTelemetryOverlayPtr = new TelemetryOverlay();
+        }
+#endif // RUNTIME_TELEMETRY
+    }
+}
+
+void RootSystem::RunReplayFrame()
+{
+    if (!mInputReplayerPtr->StepFrame())
+    {
+        PostQuitMessage(0);
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // the recorded delta replaces the measured one, and the loop runs
+    // as fast as it can without swapping or sleeping
+    mDeltaTime = mInputReplayerPtr->GetFrameDelta();
+    UpdateController();
+    mSceneManagerPtr->UpdateSceneManager(mDeltaTime);
+    DrawTelemetryOverlay();
+    mRenderCommandQueuePtr->SubmitFrame();
+
+    std::chrono::duration<float, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    mFrameStatisticsPtr->AddFrameTime(elapsed.count());
+    FinishStartupTrace();
+#ifdef RUNTIME_TELEMETRY
+    GetTelemetryRegistry()->SnapshotFrame();
+#endif // RUNTIME_TELEMETRY
+
+    mInputReplayerPtr->VerifyFrame(HashCurrentScene());
+
+    if (ShouldQuit() || mSceneManagerPtr->GetShoudTurnOff())
+    {
+        PostQuitMessage(0);
+    }
+}
+
+unsigned long long RootSystem::HashCurrentScene() const
+{
+    SceneNode* scene = mSceneManagerPtr->GetCurrentSceneNode();
+    return scene ? scene->HashSceneState() : 0;
+}
+
+void RootSystem::FinishStartupTrace()
+{
+    if (!mStartupGraphPtr)
+    {
+        return;
+    }
+
+    // the startup ends with the first submitted frame of the entry
+    // scene, not with the last task of the graph
+    mStartupGraphPtr->MarkTimeline("first-frame");
+    P_LOG(LOG_MESSAGE, "[START UP] : first frame after %.2f ms\n",
+        mStartupGraphPtr->GetElapsedMs());
+    mStartupGraphPtr->WriteTraceFile(STARTUP_TRACE_FILE);
+
+    delete mStartupGraphPtr;
+    mStartupGraphPtr = nullptr;
+}
+
+void RootSystem::DrawTelemetryOverlay()
+{
+#ifdef RUNTIME_TELEMETRY
+    // the overlay shows the last finished frame, this one is still
+    // being counted
+    TELEMETRY_FRAME frame = {};
+    if (mTelemetryOverlayPtr &&
+        GetTelemetryRegistry()->GetLatestFrame(&frame))
+    {
+        mTelemetryOverlayPtr->DrawOverlay(
+            mRenderCommandQueuePtr->GetRecordingList(), frame);
+    }
+#endif // RUNTIME_TELEMETRY
+}
@@ -10,6 +10,14 @@
 #pragma once
 
 #include "HFCommon.h"
+#include <string>
+
+enum class RUN_MODE
+{
+    NORMAL,
+    RECORD,
+    REPLAY
+};
 
 class RootSystem
 {
@@ -17,7 +25,7 @@ public:
     RootSystem();
     ~RootSystem();
 
-    bool StartUp(HINSTANCE hInstance, int cmdShow);
+    bool StartUp(HINSTANCE hInstance, int cmdShow, LPSTR cmdLine);
 
     void ClearAndStop();
 
@@ -26,6 +34,16 @@ public:
 private:
     void SwapAndClacDeltaTime();
 
+    void ParseCommandLine(std::string _cmdLine);
+
+    void RunReplayFrame();
+
+    unsigned long long HashCurrentScene() const;
+
+    void FinishStartupTrace();
+
+    void DrawTelemetryOverlay();
+
 private:
     class SceneManager* mSceneManagerPtr;
 
@@ -33,8 +51,30 @@ private:
 
     class ObjectFactory* mObjectFactoryPtr;
 
+    class RenderBackend* mRenderBackendPtr;
+
+    class RenderCommandQueue* mRenderCommandQueuePtr;
+
     float mLastTime;
 
     float mDeltaTime;
+
+    RUN_MODE mRunMode;
+
+    std::string mReplayPath;
+
+    class InputRecorder* mInputRecorderPtr;
+
+    class InputReplayer* mInputReplayerPtr;
+
+    class FrameTimeStatistics* mFrameStatisticsPtr;
+
+    class StartupTaskGraph* mStartupGraphPtr;
+
+    bool mComInitFlg;
+
+    std::string mTelemetryPath;
+
+    class TelemetryOverlay* mTelemetryOverlayPtr;
 };
 
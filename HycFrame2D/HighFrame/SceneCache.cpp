@@ -0,0 +1,182 @@
+﻿//---------------------------------------------------------------
+// File: SceneCache.cpp
+// Proj: HycFrame2D
+// Info: メモリ予算付きのLRUシーンキャッシュ
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "SceneCache.h"
+#include <algorithm>
+
+SceneCache::SceneCache() :
+    mEntryArray({}), mSceneLimit(SCENE_CACHE_DEFAULT_SIZE),
+    mMemoryBudget(SCENE_CACHE_DEFAULT_BUDGET), mStatistics({})
+{
+    mEntryArray.clear();
+}
+
+SceneCache::~SceneCache()
+{
+
+}
+
+void SceneCache::SetCacheLimit(unsigned int _sceneNum,
+    size_t _memoryBudget)
+{
+    mSceneLimit = _sceneNum ? _sceneNum : 1;
+    mMemoryBudget = _memoryBudget;
+}
+
+SceneNode* SceneCache::FindScene(const std::string& _name,
+    bool* _readyFlg)
+{
+    auto found = std::find_if(mEntryArray.begin(), mEntryArray.end(),
+        [&_name](const CACHE_ENTRY& _entry)
+        { return _entry.Name == _name; });
+    if (found == mEntryArray.end())
+    {
+        ++mStatistics.LoadSwitchCount;
+        *_readyFlg = false;
+        return nullptr;
+    }
+
+    *_readyFlg = found->ReadyFlg;
+    if (found->ReadyFlg)
+    {
+        ++mStatistics.InstantSwitchCount;
+    }
+    else
+    {
+        ++mStatistics.ResetSwitchCount;
+    }
+
+    // a ready scene is used up by entering it, it has to be reset or
+    // preloaded again before the next instant switch
+    CACHE_ENTRY entry = *found;
+    entry.ReadyFlg = false;
+    mEntryArray.erase(found);
+    mEntryArray.insert(mEntryArray.begin(), entry);
+
+    return entry.Scene;
+}
+
+SceneNode* SceneCache::PeekScene(const std::string& _name,
+    bool* _readyFlg) const
+{
+    for (auto& entry : mEntryArray)
+    {
+        if (entry.Name == _name)
+        {
+            *_readyFlg = entry.ReadyFlg;
+            return entry.Scene;
+        }
+    }
+
+    *_readyFlg = false;
+    return nullptr;
+}
+
+void SceneCache::InsertScene(const std::string& _name,
+    SceneNode* _scene, size_t _memorySize, bool _readyFlg)
+{
+    CACHE_ENTRY entry = { _name, _scene, _memorySize, _readyFlg };
+    auto found = std::find_if(mEntryArray.begin(), mEntryArray.end(),
+        [_scene](const CACHE_ENTRY& _entry)
+        { return _entry.Scene == _scene; });
+    if (found != mEntryArray.end())
+    {
+        mEntryArray.erase(found);
+    }
+    if (_readyFlg)
+    {
+        ++mStatistics.PreloadCount;
+    }
+
+    mEntryArray.insert(mEntryArray.begin(), entry);
+}
+
+bool SceneCache::CanPreloadScene(const SceneNode* _inUse) const
+{
+    // another preload must not push out the ones that are still
+    // waiting to be entered, hints come in order of likelihood
+    unsigned int keepNum = 1;
+    size_t keepMemory = 0;
+    for (auto& entry : mEntryArray)
+    {
+        if (entry.Scene == _inUse || entry.ReadyFlg)
+        {
+            keepNum += entry.Scene == _inUse ? 0 : 1;
+            keepMemory += entry.MemorySize;
+        }
+    }
+
+    return keepNum < mSceneLimit && keepMemory < mMemoryBudget;
+}
+
+void SceneCache::UpdateSceneMemory(SceneNode* _scene,
+    size_t _memorySize)
+{
+    for (auto& entry : mEntryArray)
+    {
+        if (entry.Scene == _scene)
+        {
+            entry.MemorySize = _memorySize;
+            return;
+        }
+    }
+}
+
+void SceneCache::EvictScenes(const SceneNode* _inUse,
+    std::vector<SceneNode*>* _out)
+{
+    size_t memory = 0;
+    for (auto& entry : mEntryArray)
+    {
+        memory += entry.MemorySize;
+    }
+
+    // the scene in use always stays, even when it alone is over the
+    // budget
+    size_t i = mEntryArray.size();
+    while (i-- > 0 && (mEntryArray.size() > mSceneLimit ||
+        memory > mMemoryBudget))
+    {
+        CACHE_ENTRY& entry = mEntryArray[i];
+        if (entry.Scene == _inUse)
+        {
+            continue;
+        }
+
+        ++mStatistics.EvictCount;
+        if (entry.ReadyFlg)
+        {
+            ++mStatistics.UnusedPreloadCount;
+        }
+        memory -= entry.MemorySize;
+        _out->push_back(entry.Scene);
+        mEntryArray.erase(mEntryArray.begin() + i);
+    }
+}
+
+void SceneCache::RemoveAllScenes(std::vector<SceneNode*>* _out)
+{
+    for (auto& entry : mEntryArray)
+    {
+        _out->push_back(entry.Scene);
+    }
+    mEntryArray.clear();
+}
+
+SCENE_CACHE_STATISTICS SceneCache::GetStatistics() const
+{
+    SCENE_CACHE_STATISTICS stats = mStatistics;
+    stats.SceneNum = (unsigned int)mEntryArray.size();
+    stats.MemorySize = 0;
+    for (auto& entry : mEntryArray)
+    {
+        stats.MemorySize += entry.MemorySize;
+    }
+
+    return stats;
+}
@@ -0,0 +1,78 @@
+﻿//---------------------------------------------------------------
+// File: SceneCache.h
+// Proj: HycFrame2D
+// Info: メモリ予算付きのLRUシーンキャッシュ
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#define SCENE_CACHE_DEFAULT_SIZE    (4)
+#define SCENE_CACHE_DEFAULT_BUDGET  (256ull * 1024 * 1024)
+
+struct SCENE_CACHE_STATISTICS
+{
+    unsigned int SceneNum;
+    size_t MemorySize;
+    unsigned long long InstantSwitchCount;
+    unsigned long long ResetSwitchCount;
+    unsigned long long LoadSwitchCount;
+    unsigned long long PreloadCount;
+    unsigned long long EvictCount;
+    unsigned long long UnusedPreloadCount;
+};
+
+// only keeps the bookkeeping, creating and releasing the scenes is
+// left to the scene manager
+class SceneCache
+{
+public:
+    SceneCache();
+    ~SceneCache();
+
+    void SetCacheLimit(unsigned int _sceneNum, size_t _memoryBudget);
+
+    class SceneNode* FindScene(const std::string& _name,
+        bool* _readyFlg);
+
+    class SceneNode* PeekScene(const std::string& _name,
+        bool* _readyFlg) const;
+
+    void InsertScene(const std::string& _name, class SceneNode* _scene,
+        size_t _memorySize, bool _readyFlg);
+
+    bool CanPreloadScene(const class SceneNode* _inUse) const;
+
+    void UpdateSceneMemory(class SceneNode* _scene,
+        size_t _memorySize);
+
+    void EvictScenes(const class SceneNode* _inUse,
+        std::vector<class SceneNode*>* _out);
+
+    void RemoveAllScenes(std::vector<class SceneNode*>* _out);
+
+    SCENE_CACHE_STATISTICS GetStatistics() const;
+
+private:
+    struct CACHE_ENTRY
+    {
+        std::string Name;
+        class SceneNode* Scene;
+        size_t MemorySize;
+        bool ReadyFlg;
+    };
+
+    // the front is the most recently used scene
+    std::vector<CACHE_ENTRY> mEntryArray;
+
+    unsigned int mSceneLimit;
+
+    size_t mMemoryBudget;
+
+    SCENE_CACHE_STATISTICS mStatistics;
+};
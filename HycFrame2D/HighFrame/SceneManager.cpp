@@ -11,18 +11,23 @@
 #include "SceneNode.h"
 #include "PropertyManager.h"
 #include "ObjectFactory.h"
-#include <thread>
+#include "RenderCommandQueue.h"
+#include "Telemetry.h"
+#include <algorithm>
 #include "controller.h"
 
 SceneManager::SceneManager() :
     mPropertyManagerPtr(nullptr), mObjectFactoryPtr(nullptr),
+    mRenderCommandQueuePtr(nullptr),
     mLoadingScenePtr(nullptr), mCurrentScenePtr(nullptr),
     mNextScenePtr(nullptr), mLoadSceneFlg(false),
-    mLoadSceneInfo({ "","" }), mScenePool({ nullptr,nullptr }),
-    mReleaseScenePtr(nullptr), mLoadFinishFlg(true),
-    mNeedToLoadSize(0), mHasLoadedSize(0), mShouldTurnOff(false)
+    mLoadSceneInfo({ "","" }), mSceneCache(), mPreloadQueue({}),
+    mPreloadSceneInfo({ "","" }), mPreloadedScenePtr(nullptr),
+    mPreloadThread(), mPreloadingFlg(false), mLoadFinishFlg(true),
+    mNeedToLoadSize(0), mHasLoadedSize(0), mShouldTurnOff(false),
+    mSyncLoadFlg(false)
 {
-
+    mPreloadQueue.clear();
 }
 
 SceneManager::~SceneManager()
@@ -38,13 +43,14 @@ bool SceneManager::StartUp()
 }
 
 void SceneManager::PostStartUp(PropertyManager* _pmPtr,
-    ObjectFactory* _ofPtr)
+    ObjectFactory* _ofPtr, RenderCommandQueue* _rcqPtr)
 {
     mPropertyManagerPtr = _pmPtr;
     mObjectFactoryPtr = _ofPtr;
+    mRenderCommandQueuePtr = _rcqPtr;
 
-    LoadLoadingScene();
-
+    // the loading scene is built by the startup graph, the entry scene
+    // is loaded behind it from the first frame like any other switch
     std::string name = "";
     std::string path = "";
     {
@@ -60,22 +66,57 @@ void SceneManager::PostStartUp(PropertyManager* _pmPtr,
         }
         name = jf["entry-scene-name"].GetString();
         path = jf["entry-scene-path"].GetString();
+
+        unsigned int sceneNum = SCENE_CACHE_DEFAULT_SIZE;
+        size_t budget = SCENE_CACHE_DEFAULT_BUDGET;
+        if (jf.HasMember("scene-cache-size") &&
+            jf["scene-cache-size"].IsUint())
+        {
+            sceneNum = jf["scene-cache-size"].GetUint();
+        }
+        if (jf.HasMember("scene-memory-budget-mb") &&
+            jf["scene-memory-budget-mb"].IsUint())
+        {
+            budget = (size_t)jf["scene-memory-budget-mb"].GetUint() *
+                1024 * 1024;
+        }
+        SetSceneCacheLimit(sceneNum, budget);
     }
     LoadSceneNode(name, path);
 }
 
+bool SceneManager::LoadLoadingScene(JsonFile* _config)
+{
+    mLoadingScenePtr = mObjectFactoryPtr->CreateNewScene(
+        LOADING_SCENE_NAME, LOADING_SCENE_PATH, _config);
+
+    return mLoadingScenePtr != nullptr;
+}
+
 void SceneManager::CleanAndStop()
 {
-    mCurrentScenePtr->ReleaseScene();
-    delete mCurrentScenePtr;
+    if (mPreloadThread.joinable())
+    {
+        mPreloadThread.join();
+    }
 
-    if (mNextScenePtr)
+    std::vector<SceneNode*> sceneArray = {};
+    mSceneCache.RemoveAllScenes(&sceneArray);
+    for (SceneNode* scene : { mPreloadedScenePtr, mNextScenePtr })
     {
-        mNextScenePtr->ReleaseScene();
-        delete mNextScenePtr;
+        if (scene && std::find(sceneArray.begin(), sceneArray.end(),
+            scene) == sceneArray.end())
+        {
+            sceneArray.push_back(scene);
+        }
+    }
+    for (auto& scene : sceneArray)
+    {
+        scene->ReleaseScene();
+        delete scene;
     }
 
-    if (mCurrentScenePtr != mLoadingScenePtr)
+    if (mLoadingScenePtr)
     {
         ReleaseLoadingScene();
         delete mLoadingScenePtr;
@@ -84,33 +125,75 @@ void SceneManager::CleanAndStop()
 
 void SceneManager::UpdateSceneManager(float _deltatime)
 {
-    if (mLoadSceneFlg)
+    FinishPreloadScene();
+
+    // a switch waits for the running preload, the two loaders never
+    // work at the same time
+    if (mLoadSceneFlg && !mPreloadThread.joinable())
     {
         mLoadSceneFlg = false;
 
-        mCurrentScenePtr = mLoadingScenePtr;
-        std::thread loadThread(
-            &SceneManager::LoadNextScene, this);
-        loadThread.detach();
-    }
+        if (mCurrentScenePtr && mCurrentScenePtr != mLoadingScenePtr)
+        {
+            mSceneCache.UpdateSceneMemory(mCurrentScenePtr,
+                mCurrentScenePtr->GetSceneMemorySize());
+        }
 
-    if (mReleaseScenePtr)
-    {
-        mReleaseScenePtr->ReleaseScene();
-        delete mReleaseScenePtr;
-        mReleaseScenePtr = nullptr;
+        bool readyFlg = false;
+        SceneNode* cached = mSceneCache.FindScene(mLoadSceneInfo[0],
+            &readyFlg);
+        if (readyFlg)
+        {
+            P_LOG(LOG_MESSAGE, "switch to preloaded scene : [ %s ]\n",
+                mLoadSceneInfo[0].c_str());
+            EnterScene(cached);
+        }
+        else
+        {
+            mCurrentScenePtr = mLoadingScenePtr;
+            if (mSyncLoadFlg)
+            {
+                LoadNextScene(cached);
+            }
+            else
+            {
+                std::thread loadThread(
+                    &SceneManager::LoadNextScene, this, cached);
+                loadThread.detach();
+            }
+        }
     }
 
     if (mNextScenePtr && mLoadFinishFlg)
     {
-        mCurrentScenePtr = mNextScenePtr;
+        SceneNode* next = mNextScenePtr;
         mNextScenePtr = nullptr;
+        mSceneCache.InsertScene(next->GetSceneName(), next,
+            next->GetSceneMemorySize(), false);
+        EnterScene(next);
     }
 
+    // queued hints, the running preload and a switch still waiting
+    // or behind the loading screen
+    TELEMETRY_SET(PENDING_SCENE_LOADS, mPreloadQueue.size() +
+        (mPreloadThread.joinable() ? 1 : 0) +
+        ((mLoadSceneFlg || mCurrentScenePtr == mLoadingScenePtr) ?
+        1 : 0));
+
     mCurrentScenePtr->UpdateScene(_deltatime);
     mCurrentScenePtr->DrawScene();
 }
 
+SceneNode* SceneManager::GetCurrentSceneNode() const
+{
+    return mCurrentScenePtr;
+}
+
+void SceneManager::SetSyncLoading(bool _value)
+{
+    mSyncLoadFlg = _value;
+}
+
 PropertyManager* SceneManager::GetPropertyManager() const
 {
     return mPropertyManagerPtr;
@@ -121,20 +204,46 @@ ObjectFactory* SceneManager::GetObjectFactory() const
     return mObjectFactoryPtr;
 }
 
+RenderCommandQueue* SceneManager::GetRenderCommandQueue() const
+{
+    return mRenderCommandQueuePtr;
+}
+
+void SceneManager::HintNextScene(std::string _name,
+    std::string _path)
+{
+    for (auto& hint : mPreloadQueue)
+    {
+        if (hint[0] == _name)
+        {
+            return;
+        }
+    }
+
+    mPreloadQueue.push_back({ _name, _path });
+    StartPreloadScene();
+}
+
+void SceneManager::SetSceneCacheLimit(unsigned int _sceneNum,
+    size_t _memoryBudget)
+{
+    mSceneCache.SetCacheLimit(_sceneNum, _memoryBudget);
+}
+
+SCENE_CACHE_STATISTICS SceneManager::GetSceneCacheStatistics() const
+{
+    return mSceneCache.GetStatistics();
+}
+
 void SceneManager::LoadSceneNode(
     std::string _name, std::string _path)
 {
+    // the scene file is parsed once by the loader, which also counts
+    // the objects to load
     mLoadSceneFlg = true;
     mLoadSceneInfo = { _name,_path };
-
-    {
-        JsonFile config = {};
-        LoadJsonFile(&config, _path);
-        unsigned int actorSize = config["actor"].Size();
-        unsigned int uiSize = config["ui"].Size();
-        mNeedToLoadSize = actorSize + uiSize;
-        mHasLoadedSize = 0;
-    }
+    mNeedToLoadSize = 0;
+    mHasLoadedSize = 0;
 }
 
 unsigned int SceneManager::GetNeedToLoad() const
@@ -149,10 +258,21 @@ unsigned int SceneManager::GetHasLoaded() const
 
 void SceneManager::PlusHasLoaded()
 {
+    // a preload runs behind a playing scene, not the loading scene
+    if (mPreloadingFlg)
+    {
+        return;
+    }
+
     ++mHasLoadedSize;
 #ifdef SHOW_LOADING
 #ifdef HYC_FRAME_2D
-    Sleep(10);
+    // only slowed down while the loading scene is there to show it
+    if (!mSyncLoadFlg && mCurrentScenePtr &&
+        mCurrentScenePtr == mLoadingScenePtr)
+    {
+        Sleep(10);
+    }
 #endif // HYC_FRAME_2D
 #endif // SHOW_LOADING
 }
@@ -177,58 +297,152 @@ bool SceneManager::GetShoudTurnOff() const
     return mShouldTurnOff;
 }
 
-void SceneManager::LoadLoadingScene()
+void SceneManager::ReleaseLoadingScene()
 {
-    mLoadingScenePtr = mObjectFactoryPtr->CreateNewScene(
-        "load-scene",
-        "rom:/Configs/Scenes/load-scene.json");
+    mLoadingScenePtr->ReleaseScene();
 }
 
-void SceneManager::ReleaseLoadingScene()
+void SceneManager::ResetLoadCount(JsonFile* _config)
 {
-    mLoadingScenePtr->ReleaseScene();
+    unsigned int needToLoad = 0;
+    for (const char* member : { "actor", "ui" })
+    {
+        if (!_config->HasParseError() && _config->HasMember(member) &&
+            (*_config)[member].IsArray())
+        {
+            needToLoad += (*_config)[member].Size();
+        }
+    }
+    mNeedToLoadSize = needToLoad;
+    mHasLoadedSize = 0;
 }
 
-void SceneManager::LoadNextScene()
+void SceneManager::LoadNextScene(SceneNode* _cached)
 {
     P_LOG(LOG_MESSAGE, "ready to load next scene\n");
 
-    for (int i = 0; i < 2; i++)
+    if (_cached)
+    {
+        mNeedToLoadSize = (unsigned int)(
+            _cached->GetActorArray()->size() +
+            _cached->GetUiArray()->size());
+        _cached->ResetSceneNode();
+        mNextScenePtr = _cached;
+        return;
+    }
+
+    JsonFile config = {};
+    LoadJsonFile(&config, mLoadSceneInfo[1]);
+    ResetLoadCount(&config);
+    mNextScenePtr = mObjectFactoryPtr->CreateNewScene(
+        mLoadSceneInfo[0], mLoadSceneInfo[1], &config);
+}
+
+void SceneManager::EnterScene(SceneNode* _scene)
+{
+    mCurrentScenePtr = _scene;
+    ReleaseEvictedScenes();
+
+    // hints of the scene that was left are no longer likely
+    mPreloadQueue = *_scene->GetPreloadHints();
+    StartPreloadScene();
+}
+
+void SceneManager::ReleaseEvictedScenes()
+{
+    if (mPreloadThread.joinable())
+    {
+        return;
+    }
+
+    std::vector<SceneNode*> evicted = {};
+    mSceneCache.EvictScenes(mCurrentScenePtr, &evicted);
+    if (evicted.empty())
+    {
+        return;
+    }
+
+    // the frame still being drawn may use these scenes' textures
+    mRenderCommandQueuePtr->WaitForRenderIdle();
+    for (auto& scene : evicted)
+    {
+        P_LOG(LOG_MESSAGE, "release scene from cache : [ %s ]\n",
+            scene->GetSceneName().c_str());
+        scene->ReleaseScene();
+        delete scene;
+    }
+}
+
+void SceneManager::StartPreloadScene()
+{
+    if (mPreloadThread.joinable() || mLoadSceneFlg ||
+        !mCurrentScenePtr || mCurrentScenePtr == mLoadingScenePtr)
     {
-        if (mScenePool[i] &&
-            mScenePool[i]->GetSceneName() == mLoadSceneInfo[0])
+        return;
+    }
+
+    while (!mPreloadQueue.empty())
+    {
+        std::array<std::string, 2> hint = mPreloadQueue.front();
+        mPreloadQueue.erase(mPreloadQueue.begin());
+
+        bool readyFlg = false;
+        SceneNode* cached = mSceneCache.PeekScene(hint[0], &readyFlg);
+        if (readyFlg || cached == mCurrentScenePtr)
         {
-            SceneNode* node = mScenePool[i];
-            node->ResetSceneNode();
-            if (i)
-            {
-                SceneNode* temp = mScenePool[0];
-                mScenePool[0] = mScenePool[1];
-                mScenePool[1] = temp;
-            }
-            mNextScenePtr = node;
+            continue;
+        }
+        if (!mSceneCache.CanPreloadScene(mCurrentScenePtr))
+        {
+            mPreloadQueue.clear();
             return;
         }
-    }
 
-    SceneNode* node = mObjectFactoryPtr->CreateNewScene(
-        mLoadSceneInfo[0], mLoadSceneInfo[1]);
+        // a scene that was entered before only needs its reset, the
+        // same work a normal switch would do behind the loading scene
+        mPreloadSceneInfo = hint;
+        mPreloadedScenePtr = nullptr;
+        mPreloadingFlg = true;
+        mPreloadThread = std::thread(
+            &SceneManager::PreloadScene, this, cached);
+        return;
+    }
+}
 
-    if (!mScenePool[0])
+void SceneManager::PreloadScene(SceneNode* _cached)
+{
+    if (_cached)
     {
-        mScenePool[0] = node;
+        _cached->ResetSceneNode();
+        mPreloadedScenePtr = _cached;
     }
-    else if (!mScenePool[1])
+    else
     {
-        mScenePool[1] = mScenePool[0];
-        mScenePool[0] = node;
+        mPreloadedScenePtr = mObjectFactoryPtr->CreateNewScene(
+            mPreloadSceneInfo[0], mPreloadSceneInfo[1]);
     }
-    else
+
+    mPreloadingFlg = false;
+}
+
+void SceneManager::FinishPreloadScene()
+{
+    if (!mPreloadThread.joinable() || mPreloadingFlg)
     {
-        SceneNode* needRelease = mScenePool[1];
-        mScenePool[1] = mScenePool[0];
-        mScenePool[0] = node;
-        mReleaseScenePtr = needRelease;
+        return;
     }
-    mNextScenePtr = node;
+
+    mPreloadThread.join();
+    if (mPreloadedScenePtr)
+    {
+        P_LOG(LOG_MESSAGE, "scene preloaded : [ %s ]\n",
+            mPreloadSceneInfo[0].c_str());
+        mSceneCache.InsertScene(mPreloadSceneInfo[0],
+            mPreloadedScenePtr,
+            mPreloadedScenePtr->GetSceneMemorySize(), true);
+        mPreloadedScenePtr = nullptr;
+        ReleaseEvictedScenes();
+    }
+
+    StartPreloadScene();
 }
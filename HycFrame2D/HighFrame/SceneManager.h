@@ -9,8 +9,16 @@
 
 #pragma once
 
+#include "SceneCache.h"
+#include "json.h"
 #include <array>
+#include <atomic>
 #include <string>
+#include <thread>
+#include <vector>
+
+#define LOADING_SCENE_NAME  ("load-scene")
+#define LOADING_SCENE_PATH  ("rom:/Configs/Scenes/load-scene.json")
 
 class SceneManager
 {
@@ -21,7 +29,10 @@ public:
     bool StartUp();
 
     void PostStartUp(class PropertyManager* _pmPtr,
-        class ObjectFactory* _ofPtr);
+        class ObjectFactory* _ofPtr,
+        class RenderCommandQueue* _rcqPtr);
+
+    bool LoadLoadingScene(JsonFile* _config);
 
     void CleanAndStop();
 
@@ -31,12 +42,25 @@ public:
 
     void UpdateSceneManager(float _deltatime);
 
+    class SceneNode* GetCurrentSceneNode() const;
+
+    void SetSyncLoading(bool _value);
+
     void LoadSceneNode(std::string _name, std::string _path);
 
+    void HintNextScene(std::string _name, std::string _path);
+
+    void SetSceneCacheLimit(unsigned int _sceneNum,
+        size_t _memoryBudget);
+
+    SCENE_CACHE_STATISTICS GetSceneCacheStatistics() const;
+
     class PropertyManager* GetPropertyManager() const;
 
     class ObjectFactory* GetObjectFactory() const;
 
+    class RenderCommandQueue* GetRenderCommandQueue() const;
+
     unsigned int GetNeedToLoad() const;
 
     unsigned int GetHasLoaded() const;
@@ -48,17 +72,29 @@ public:
     void SetLoadFinishedFlag(bool _value);
 
 private:
-    void LoadLoadingScene();
-
     void ReleaseLoadingScene();
 
-    void LoadNextScene();
+    void ResetLoadCount(JsonFile* _config);
+
+    void LoadNextScene(class SceneNode* _cached);
+
+    void EnterScene(class SceneNode* _scene);
+
+    void ReleaseEvictedScenes();
+
+    void StartPreloadScene();
+
+    void PreloadScene(class SceneNode* _cached);
+
+    void FinishPreloadScene();
 
 private:
     class PropertyManager* mPropertyManagerPtr;
 
     class ObjectFactory* mObjectFactoryPtr;
 
+    class RenderCommandQueue* mRenderCommandQueuePtr;
+
     bool mShouldTurnOff;
 
     class SceneNode* mLoadingScenePtr;
@@ -67,18 +103,28 @@ private:
 
     class SceneNode* mNextScenePtr;
 
-    class SceneNode* mReleaseScenePtr;
-
     bool mLoadSceneFlg;
 
     std::array<std::string, 2> mLoadSceneInfo;
 
-    std::array<class SceneNode*, 2> mScenePool;
+    SceneCache mSceneCache;
+
+    std::vector<std::array<std::string, 2>> mPreloadQueue;
 
-    unsigned int mNeedToLoadSize;
+    std::array<std::string, 2> mPreloadSceneInfo;
 
-    unsigned int mHasLoadedSize;
+    class SceneNode* mPreloadedScenePtr;
+
+    std::thread mPreloadThread;
+
+    std::atomic<bool> mPreloadingFlg;
+
+    std::atomic<unsigned int> mNeedToLoadSize;
+
+    std::atomic<unsigned int> mHasLoadedSize;
 
     bool mLoadFinishFlg;
+
+    bool mSyncLoadFlg;
 };
 
@@ -14,28 +14,109 @@
 #include "UiObject.h"
 #include "ASpriteComponent.h"
 #include "USpriteComponent.h"
+#include "ATilemapComponent.h"
+#include "AParticleComponent.h"
+#include "ATransformComponent.h"
+#include "ATimerComponent.h"
+#include "ScriptCoroutine.h"
+#include "EventBus.h"
+#include "UiFocusGraph.h"
+#include "DxRenderBackend.h"
 #include "texture.h"
+#include "sound.h"
+#include "controller.h"
+#include "Telemetry.h"
+#include <algorithm>
+
+namespace
+{
+    const std::vector<ActorObject*> EMPTY_ACTOR_LIST = {};
+
+    inline unsigned long long HashStateBytes(unsigned long long _hash,
+        const void* _data, size_t _size)
+    {
+        const unsigned char* bytes = (const unsigned char*)_data;
+        for (size_t i = 0; i < _size; i++)
+        {
+            _hash ^= bytes[i];
+            _hash *= 1099511628211ULL;
+        }
+
+        return _hash;
+    }
+
+    // the batch goes in front of the ones sharing its order, the same
+    // place each of them would have been inserted at on its own
+    template <typename OrderFunc>
+    void MergeNewActors(std::vector<ActorObject*>* _list,
+        std::vector<ActorObject*>* _batch,
+        std::vector<ActorObject*>* _buffer, OrderFunc _order)
+    {
+        auto less = [&_order](ActorObject* _a, ActorObject* _b)
+        {
+            return _order(_a) < _order(_b);
+        };
+        std::stable_sort(_batch->begin(), _batch->end(), less);
+        _buffer->clear();
+        std::merge(_batch->begin(), _batch->end(), _list->begin(),
+            _list->end(), std::back_inserter(*_buffer), less);
+        _list->swap(*_buffer);
+    }
+}
 
 SceneNode::SceneNode(std::string _name, std::string _path,
     SceneManager* smPtr) :
     mName(_name), mSceneManagerPtr(smPtr), mCamera(nullptr),
     mSceneLoopFuncPtr(nullptr), mConfigPath(_path),
-    mActorObjectsMap({}), mActorObjectsArray({}),
-    mUiObjectsMap({}), mUiObjectsArray({}),
+    mActorObjectsMap(), mActorObjectsArray({}),
+    mActiveActorsArray({}), mDormantGrid(SPATIAL_CELL_SIZE),
+    mReducedActorsArray({}), mMovedActorsArray({}),
+    mWakeCandidateArray({}),
+    mPausedActorsArray({}), mStatusChangedActorsArray({}),
+    mRetiringActorsArray({}),
+    mActivityMargin(MakeFloat2(512.f, 512.f)),
+    mActivityCameraPos(MakeFloat2(0.f, 0.f)),
+    mActivityCameraSize(MakeFloat2(0.f, 0.f)), mActivityDirtyFlg(true),
+    mUiObjectsMap(), mUiObjectsArray({}),
     mActorSpritesArray({}), mUiSpritesArray({}),
-    mNewActorObjectsArray({}), mNewUiObjectsArray({}),
-    mRetiredActorObjectsArray({}), mRetiredUiObjectsArray({})
+    mVisibleActorsArray({}), mSpriteGrid(SPATIAL_CELL_SIZE),
+    mUnboundedSpritesArray({}), mMovedSpritesArray({}),
+    mSpriteActorSet(),
+    mDrawStatistics({ 0, 0, 0, 0, 0, 0, 0 }),
+    mCoroutineScheduler(new CoroutineScheduler()),
+    mEventBus(new EventBus()), mFocusGraph(new UiFocusGraph()),
+    mUiDrawCache(new RenderCommandList()), mUiDrawDirtyFlg(true),
+    mNewActorObjectsArray({}), mAddedActorsArray({}),
+    mAddedSpritesArray({}), mMergeBufferArray({}),
+    mNewUiObjectsArray({}),
+    mRetiredActorObjectsArray({}), mRetiredUiObjectsArray({}),
+    mRecycledActorsPool({}), mTagIndex(), mCompTypeIndex(),
+    mSoundPool({}), mPreloadHintArray({})
 {
-    mActorObjectsMap.clear();
+    mActorObjectsMap.Clear();
     mActorObjectsArray.clear();
-    mUiObjectsMap.clear();
+    mActiveActorsArray.clear();
+    mReducedActorsArray.clear();
+    mMovedActorsArray.clear();
+    mWakeCandidateArray.clear();
+    mPausedActorsArray.clear();
+    mStatusChangedActorsArray.clear();
+    mRetiringActorsArray.clear();
+    mUiObjectsMap.Clear();
     mUiObjectsArray.clear();
     mActorSpritesArray.clear();
     mUiSpritesArray.clear();
+    mVisibleActorsArray.clear();
+    mUnboundedSpritesArray.clear();
+    mMovedSpritesArray.clear();
+    mSpriteActorSet.clear();
     mNewActorObjectsArray.clear();
     mNewUiObjectsArray.clear();
     mRetiredActorObjectsArray.clear();
     mRetiredUiObjectsArray.clear();
+    mRecycledActorsPool.clear();
+    mSoundPool.clear();
+    mPreloadHintArray.clear();
 }
 
 SceneNode::~SceneNode()
@@ -55,56 +136,106 @@ SceneManager* SceneNode::GetSceneManagerPtr() const
 
 void SceneNode::ResetSceneNode()
 {
+    for (auto& actor : mActorObjectsArray)
+    {
+        actor->SetActorList(ACTOR_LIST::UNLISTED);
+    }
+    mActiveActorsArray.clear();
+    mDormantGrid.ClearGrid();
+    mReducedActorsArray.clear();
+    mMovedActorsArray.clear();
+    mActivityDirtyFlg = true;
+    mPausedActorsArray.clear();
+    mStatusChangedActorsArray.clear();
+    mRetiringActorsArray.clear();
     mActorSpritesArray.clear();
+    mVisibleActorsArray.clear();
+    mSpriteGrid.ClearGrid();
+    mUnboundedSpritesArray.clear();
+    mMovedSpritesArray.clear();
+    mSpriteActorSet.clear();
     mUiSpritesArray.clear();
+    ClearActorIndex();
+    mFocusGraph->MarkGraphDirty();
+    MarkUiDrawDirty();
     GetSceneManagerPtr()->GetObjectFactory()->
         ResetSceneNode(this, mConfigPath);
 }
 
-ActorObject* SceneNode::GetActorObject(std::string _name)
+ActorObject* SceneNode::GetActorObject(StringID _name)
 {
-    if (mActorObjectsMap.find(_name) == mActorObjectsMap.end())
+    ActorObject** found = mActorObjectsMap.Find(_name);
+    if (!found)
     {
         for (auto& actor : mNewActorObjectsArray)
         {
-            if (actor->GetObjectName() == _name)
+            if (actor->GetObjectNameID() == _name)
             {
                 P_LOG(LOG_WARNING,
                     "return this Aobject before init : [ %s ]\n",
-                    _name.c_str());
+                    _name.GetDebugString());
                 return actor;
             }
         }
 
         P_LOG(LOG_WARNING,
-            "cannot find this Aobject : [ %s ]\n", _name.c_str());
+            "cannot find this Aobject : [ %s ]\n",
+            _name.GetDebugString());
         return nullptr;
     }
 
-    return mActorObjectsMap[_name];
+    return *found;
+}
+
+ActorObject* SceneNode::FindActorObject(StringID _name)
+{
+    ActorObject** found = mActorObjectsMap.Find(_name);
+
+    return found ? *found : nullptr;
 }
 
-UiObject* SceneNode::GetUiObject(std::string _name)
+UiObject* SceneNode::GetUiObject(StringID _name)
 {
-    if (mUiObjectsMap.find(_name) == mUiObjectsMap.end())
+    UiObject** found = mUiObjectsMap.Find(_name);
+    if (!found)
     {
         for (auto& ui : mNewUiObjectsArray)
         {
-            if (ui->GetObjectName() == _name)
+            if (ui->GetObjectNameID() == _name)
             {
                 P_LOG(LOG_WARNING,
                     "return this Uobject before init : [ %s ]\n",
-                    _name.c_str());
+                    _name.GetDebugString());
                 return ui;
             }
         }
 
         P_LOG(LOG_WARNING,
-            "cannot find this Uobject : [ %s ]\n", _name.c_str());
+            "cannot find this Uobject : [ %s ]\n",
+            _name.GetDebugString());
         return nullptr;
     }
 
-    return mUiObjectsMap[_name];
+    return *found;
+}
+
+UiObject* SceneNode::FindUiObject(StringID _name)
+{
+    UiObject** found = mUiObjectsMap.Find(_name);
+    if (found)
+    {
+        return *found;
+    }
+
+    for (auto& ui : mNewUiObjectsArray)
+    {
+        if (ui->GetObjectNameID() == _name)
+        {
+            return ui;
+        }
+    }
+
+    return nullptr;
 }
 
 std::vector<ActorObject*>* SceneNode::GetActorArray()
@@ -125,33 +256,27 @@ void SceneNode::LoadSceneInitFile(std::string _path)
 void SceneNode::UpdateScene(float _deltatime)
 {
     InitAllNewObjects();
+    ApplyActorStatusChanges();
+    UpdateActivityRegion();
+    mEventBus->DispatchEvents();
 
-    for (auto aci = mActorObjectsArray.begin();
-        aci != mActorObjectsArray.end();)
+    mFocusGraph->AdvanceFocusFrame();
+    mFocusGraph->UpdateFocusGraph(this, &mUiObjectsArray);
+
+    for (auto& actor : mActiveActorsArray)
     {
-        if ((*aci)->IsObjectActive() == STATUS::NEED_DESTORY)
+        if (actor->IsObjectActive() == STATUS::ACTIVE)
         {
-            mRetiredActorObjectsArray.push_back(*aci);
-            for (auto spi = mActorSpritesArray.begin();
-                spi != mActorSpritesArray.end(); spi++)
-            {
-                if ((*spi) == (*aci))
-                {
-                    mActorSpritesArray.erase(spi);
-                    break;
-                }
-            }
-            mActorObjectsMap.erase((*aci)->GetObjectName());
-            aci = mActorObjectsArray.erase(aci);
+            actor->Update(_deltatime);
+            actor->UpdateComponents(_deltatime);
         }
-        else
+    }
+    // sleeping dormant actors aren't in any per frame list at all
+    for (auto& actor : mReducedActorsArray)
+    {
+        if (actor->IsObjectActive() == STATUS::ACTIVE)
         {
-            if ((*aci)->IsObjectActive() == STATUS::ACTIVE)
-            {
-                (*aci)->Update(_deltatime);
-                (*aci)->UpdateComponents(_deltatime);
-            }
-            aci++;
+            actor->UpdateDormant(_deltatime);
         }
     }
     for (auto uii = mUiObjectsArray.begin();
@@ -169,7 +294,10 @@ void SceneNode::UpdateScene(float _deltatime)
                     break;
                 }
             }
-            mUiObjectsMap.erase((*uii)->GetObjectName());
+            mUiObjectsMap.Erase((*uii)->GetObjectNameID());
+            mEventBus->UnsubscribeAll(*uii);
+            mFocusGraph->RemoveFocusNode(*uii);
+            MarkUiDrawDirty();
             uii = mUiObjectsArray.erase(uii);
         }
         else
@@ -183,25 +311,42 @@ void SceneNode::UpdateScene(float _deltatime)
         }
     }
 
+    mEventBus->DispatchEvents();
+    if (GetControllerSnapshot()->IsAnyTriggered())
+    {
+        mCoroutineScheduler->RaiseSignal(INPUT_TRIGGER_SIGNAL);
+    }
+    mCoroutineScheduler->UpdateScheduler(_deltatime);
+
     DestoryAllRetiredObjects();
+
+    TELEMETRY_SET(LIVE_ACTORS, mActorObjectsArray.size());
+    TELEMETRY_SET(LIVE_UIS, mUiObjectsArray.size());
 }
 
 void SceneNode::DrawScene()
 {
-    for (auto& actor : mActorSpritesArray)
+    CullActorSprites();
+
+    static const RENDER_MATRIX SCREEN_VIEW =
     {
-        if (actor->IsObjectActive() == STATUS::ACTIVE)
-        {
-            actor->Draw();
-        }
-    }
-    for (auto& ui : mUiSpritesArray)
+        1.f, 0.f, 0.f, 0.f,
+        0.f, 1.f, 0.f, 0.f,
+        0.f, 0.f, 1.f, 0.f,
+        0.f, 0.f, 0.f, 1.f
+    };
+    RenderCommandList* list = GetRenderCommandList();
+
+    list->SetViewMatrix(mCamera ?
+        ToRenderMatrix(mCamera->GetViewMatrix()) : SCREEN_VIEW);
+    DrawTilemaps();
+    for (auto& actor : mVisibleActorsArray)
     {
-        if (ui->IsObjectActive() == STATUS::ACTIVE)
-        {
-            ui->Draw();
-        }
+        actor->Draw();
     }
+    DrawParticles();
+    list->SetViewMatrix(SCREEN_VIEW);
+    DrawUiObjects();
 }
 
 void SceneNode::ReleaseScene()
@@ -229,8 +374,41 @@ void SceneNode::ReleaseScene()
         delete retireActor;
         mActorObjectsArray.pop_back();
     }
+    mActiveActorsArray.clear();
+    mDormantGrid.ClearGrid();
+    mReducedActorsArray.clear();
+    mMovedActorsArray.clear();
+    mWakeCandidateArray.clear();
+    mPausedActorsArray.clear();
+    mStatusChangedActorsArray.clear();
+    mRetiringActorsArray.clear();
     mActorSpritesArray.clear();
-    mActorObjectsMap.clear();
+    mVisibleActorsArray.clear();
+    mSpriteGrid.ClearGrid();
+    mUnboundedSpritesArray.clear();
+    mMovedSpritesArray.clear();
+    mSpriteActorSet.clear();
+    mActorObjectsMap.Clear();
+
+    for (auto& pool : mRecycledActorsPool)
+    {
+        for (auto& actor : pool.second)
+        {
+            actor->Destory();
+            delete actor;
+        }
+    }
+    mRecycledActorsPool.clear();
+
+    for (auto& list : mTagIndex)
+    {
+        delete list;
+    }
+    mTagIndex.Clear();
+    for (auto& list : mCompTypeIndex)
+    {
+        list.clear();
+    }
 
     while (!mUiObjectsArray.empty())
     {
@@ -240,11 +418,26 @@ void SceneNode::ReleaseScene()
         mUiObjectsArray.pop_back();
     }
     mUiSpritesArray.clear();
-    mUiObjectsMap.clear();
+    mUiObjectsMap.Clear();
 
     delete mCamera;
 
+    delete mCoroutineScheduler;
+    mCoroutineScheduler = nullptr;
+
+    mEventBus->ClearEventBus();
+    delete mEventBus;
+    mEventBus = nullptr;
+
+    mFocusGraph->ClearFocusGraph();
+    delete mFocusGraph;
+    mFocusGraph = nullptr;
+
+    delete mUiDrawCache;
+    mUiDrawCache = nullptr;
+
     ClearTexPool();
+    ReleaseSceneSounds();
 }
 
 void SceneNode::AddActorObject(ActorObject* _aObj)
@@ -257,46 +450,34 @@ void SceneNode::AddUiObject(UiObject* _uObj)
     mNewUiObjectsArray.push_back(_uObj);
 }
 
-void SceneNode::DeleteActorObject(std::string _name)
+void SceneNode::DeleteActorObject(StringID _name)
 {
-    if (mActorObjectsMap.find(_name) == mActorObjectsMap.end())
+    ActorObject** found = mActorObjectsMap.Find(_name);
+    if (!found)
     {
         P_LOG(LOG_WARNING,
-            "cannot find this Aobject : [ %s ]\n", _name.c_str());
+            "cannot find this Aobject : [ %s ]\n",
+            _name.GetDebugString());
         return;
     }
 
-    for (auto aci = mActorObjectsArray.begin();
-        aci != mActorObjectsArray.end(); aci++)
-    {
-        if ((*aci)->GetObjectName() == _name)
-        {
-            (*aci)->SetObjectActive(STATUS::PAUSE);
-            (*aci)->ClearChildren();
-            break;
-        }
-    }
+    (*found)->SetObjectActive(STATUS::PAUSE);
+    (*found)->ClearChildren();
 }
 
-void SceneNode::DeleteUiObject(std::string _name)
+void SceneNode::DeleteUiObject(StringID _name)
 {
-    if (mUiObjectsMap.find(_name) == mUiObjectsMap.end())
+    UiObject** found = mUiObjectsMap.Find(_name);
+    if (!found)
     {
         P_LOG(LOG_WARNING,
-            "cannot find this Uobject : [ %s ]\n", _name.c_str());
+            "cannot find this Uobject : [ %s ]\n",
+            _name.GetDebugString());
         return;
     }
 
-    for (auto uii = mUiObjectsArray.begin();
-        uii != mUiObjectsArray.end(); uii++)
-    {
-        if ((*uii)->GetObjectName() == _name)
-        {
-            (*uii)->SetObjectActive(STATUS::PAUSE);
-            (*uii)->ClearChildren();
-            break;
-        }
-    }
+    (*found)->SetObjectActive(STATUS::PAUSE);
+    (*found)->ClearChildren();
 }
 
 void SceneNode::SetSceneLoopFunc(SceneLoopFuncType _func)
@@ -319,55 +500,444 @@ Camera* SceneNode::GetCamera() const
     return mCamera;
 }
 
-void SceneNode::InitAllNewObjects()
+CoroutineScheduler* SceneNode::GetCoroutineScheduler() const
 {
-    while (!mNewActorObjectsArray.empty())
+    return mCoroutineScheduler;
+}
+
+EventBus* SceneNode::GetEventBus() const
+{
+    return mEventBus;
+}
+
+UiFocusGraph* SceneNode::GetFocusGraph() const
+{
+    return mFocusGraph;
+}
+
+void SceneNode::MarkUiDrawDirty()
+{
+    mUiDrawDirtyFlg = true;
+}
+
+RenderCommandList* SceneNode::GetRenderCommandList() const
+{
+    return mSceneManagerPtr->GetRenderCommandQueue()->
+        GetRecordingList();
+}
+
+const DRAW_STATISTICS& SceneNode::GetDrawStatistics() const
+{
+    return mDrawStatistics;
+}
+
+SCENE_MEMORY_STATISTICS SceneNode::GetMemoryStatistics() const
+{
+    SCENE_MEMORY_STATISTICS stats = {};
+    for (auto& tex : mTexPool)
     {
-        auto newActor = mNewActorObjectsArray.back();
-        newActor->Init();
-        newActor->SetObjectActive(STATUS::ACTIVE);
-        mNewActorObjectsArray.pop_back();
+        stats.TextureBytes += GetTextureMemorySize(tex.second);
+    }
+    for (auto& name : mSoundPool)
+    {
+        stats.SoundBytes += GetSoundMemorySize(name);
+    }
+    stats.TextureNum = (unsigned int)mTexPool.size();
+    stats.SoundNum = (unsigned int)mSoundPool.size();
+    stats.ActorNum = (unsigned int)(mActorObjectsArray.size() +
+        mNewActorObjectsArray.size());
+    stats.UiNum = (unsigned int)(mUiObjectsArray.size() +
+        mNewUiObjectsArray.size());
 
-        bool isInserted = false;
-        for (auto actor = mActorObjectsArray.begin();
-            actor != mActorObjectsArray.end(); actor++)
+    return stats;
+}
+
+size_t SceneNode::GetSceneMemorySize() const
+{
+    // sounds shared with another scene are counted by both, which
+    // only makes the cache budget a little conservative
+    SCENE_MEMORY_STATISTICS stats = GetMemoryStatistics();
+    return stats.TextureBytes + stats.SoundBytes;
+}
+
+void SceneNode::AddPreloadHint(std::string _name, std::string _path)
+{
+    mPreloadHintArray.push_back({ _name, _path });
+}
+
+const std::vector<std::array<std::string, 2>>*
+SceneNode::GetPreloadHints() const
+{
+    return &mPreloadHintArray;
+}
+
+unsigned long long SceneNode::HashSceneState() const
+{
+    unsigned long long hash = StringID(mName).GetValue();
+    for (auto aObj : mActorObjectsArray)
+    {
+        unsigned long long id = aObj->GetObjectNameID().GetValue();
+        STATUS status = aObj->IsObjectActive();
+        hash = HashStateBytes(hash, &id, sizeof(id));
+        hash = HashStateBytes(hash, &status, sizeof(status));
+
+        ATransformComponent* atc = aObj->
+            GetAComponent<ATransformComponent>(COMP_TYPE::ATRANSFORM);
+        if (atc)
         {
-            if ((*actor)->GetUpdateOrder() >=
-                newActor->GetUpdateOrder())
+            Float3 value[3] =
             {
-                mActorObjectsArray.insert(actor, newActor);
-                isInserted = true;
-                break;
+                atc->GetPosition(), atc->GetRotation(), atc->GetScale()
+            };
+            hash = HashStateBytes(hash, value, sizeof(value));
+        }
+
+        ATimerComponent* atmc = aObj->
+            GetAComponent<ATimerComponent>(COMP_TYPE::ATIMER);
+        if (atmc)
+        {
+            for (auto timer : *atmc->GetTimerArray())
+            {
+                hash = HashStateBytes(hash, &timer->Active,
+                    sizeof(timer->Active));
+                hash = HashStateBytes(hash, &timer->Time,
+                    sizeof(timer->Time));
             }
         }
-        if (!isInserted)
+    }
+
+    return hash;
+}
+
+void SceneNode::CullActorSprites()
+{
+    mVisibleActorsArray.clear();
+    mDrawStatistics.SubmittedSprites = 0;
+    mDrawStatistics.CulledSprites = 0;
+
+    // a retired actor already left the sprite set, so only the ones
+    // still registered are placed again
+    for (auto& actor : mMovedSpritesArray)
+    {
+        if (mSpriteActorSet.find(actor) != mSpriteActorSet.end())
         {
-            mActorObjectsArray.push_back(newActor);
+            PlaceSpriteActor(actor);
         }
-        mActorObjectsMap.insert(std::make_pair(
-            newActor->GetObjectName(), newActor));
+    }
+    mMovedSpritesArray.clear();
 
-        if (newActor->GetSpriteArray()->size())
+    if (!mCamera)
+    {
+        // no camera means screen space, nothing can be culled
+        for (auto& actor : mActorSpritesArray)
         {
-            isInserted = false;
-            for (auto actor = mActorSpritesArray.begin();
-                actor != mActorSpritesArray.end(); actor++)
+            if (actor->IsObjectActive() != STATUS::ACTIVE)
             {
-                if (((*actor)->GetSpriteArray())->front()->
-                    GetDrawOrder() >=
-                    newActor->GetSpriteArray()->front()->
-                    GetDrawOrder())
+                continue;
+            }
+
+            bool hasVisible = false;
+            for (auto& sprite : *(actor->GetSpriteArray()))
+            {
+                if (sprite->IsCompActive() != STATUS::ACTIVE ||
+                    !sprite->GetVisible())
                 {
-                    mActorSpritesArray.insert(actor, newActor);
-                    isInserted = true;
-                    break;
+                    continue;
                 }
+                sprite->SetCulledFlg(false);
+                ++mDrawStatistics.SubmittedSprites;
+                hasVisible = true;
             }
-            if (!isInserted)
+
+            if (hasVisible)
+            {
+                mVisibleActorsArray.push_back(actor);
+            }
+        }
+        return;
+    }
+
+    // the grid buckets actors by the center of their sprites, so the
+    // query is widened by the half size any of them may have
+    Float2 camSize = mCamera->GetCameraSize();
+    mSpriteGrid.QueryRect(mCamera->GetCameraPosition(),
+        MakeFloat2(camSize.x * 0.5f + SPRITE_GRID_EXTENT,
+            camSize.y * 0.5f + SPRITE_GRID_EXTENT),
+        &mVisibleActorsArray);
+    mVisibleActorsArray.insert(mVisibleActorsArray.end(),
+        mUnboundedSpritesArray.begin(), mUnboundedSpritesArray.end());
+
+    Float2 center = MakeFloat2(0.f, 0.f);
+    Float2 halfSize = MakeFloat2(0.f, 0.f);
+    for (auto& actor : mVisibleActorsArray)
+    {
+        if (actor->IsObjectActive() != STATUS::ACTIVE)
+        {
+            continue;
+        }
+
+        bool hasVisible = false;
+        for (auto& sprite : *(actor->GetSpriteArray()))
+        {
+            if (sprite->IsCompActive() != STATUS::ACTIVE ||
+                !sprite->GetVisible())
+            {
+                continue;
+            }
+
+            if (sprite->GetWorldBounds(&center, &halfSize) &&
+                !mCamera->IsInCameraView(center, halfSize))
+            {
+                sprite->SetCulledFlg(true);
+                ++mDrawStatistics.CulledSprites;
+            }
+            else
             {
-                mActorSpritesArray.push_back(newActor);
+                sprite->SetCulledFlg(false);
+                ++mDrawStatistics.SubmittedSprites;
+                hasVisible = true;
             }
         }
+
+        actor->SetDrawVisible(hasVisible);
+    }
+
+    // the sprite list is already in draw order, so the visible actors
+    // are picked out of it instead of sorted
+    mVisibleActorsArray.clear();
+    for (auto& actor : mActorSpritesArray)
+    {
+        if (actor->IsDrawVisible())
+        {
+            actor->SetDrawVisible(false);
+            mVisibleActorsArray.push_back(actor);
+        }
+    }
+}
+
+void SceneNode::PlaceSpriteActor(ActorObject* _aObj)
+{
+    Float2 center = MakeFloat2(0.f, 0.f);
+    Float2 halfSize = MakeFloat2(0.f, 0.f);
+    // an oversized actor would widen every query, so it is tested on
+    // its own each frame like one without bounds
+    bool bounded = GetActorSpriteBounds(_aObj, &center, &halfSize) &&
+        halfSize.x <= SPRITE_GRID_EXTENT &&
+        halfSize.y <= SPRITE_GRID_EXTENT;
+    bool inGrid = mSpriteGrid.HasActor(_aObj);
+    auto unbounded = std::find(mUnboundedSpritesArray.begin(),
+        mUnboundedSpritesArray.end(), _aObj);
+
+    if (!bounded)
+    {
+        if (inGrid)
+        {
+            mSpriteGrid.RemoveActor(_aObj);
+        }
+        if (unbounded == mUnboundedSpritesArray.end())
+        {
+            mUnboundedSpritesArray.push_back(_aObj);
+        }
+        return;
+    }
+
+    if (unbounded != mUnboundedSpritesArray.end())
+    {
+        mUnboundedSpritesArray.erase(unbounded);
+    }
+    if (inGrid)
+    {
+        mSpriteGrid.MoveActor(_aObj, center);
+    }
+    else
+    {
+        mSpriteGrid.InsertActor(_aObj, center);
+    }
+}
+
+void SceneNode::RemoveSpriteActor(ActorObject* _aObj)
+{
+    if (mSpriteActorSet.erase(_aObj) == 0)
+    {
+        return;
+    }
+
+    if (mSpriteGrid.HasActor(_aObj))
+    {
+        mSpriteGrid.RemoveActor(_aObj);
+        return;
+    }
+    auto unbounded = std::find(mUnboundedSpritesArray.begin(),
+        mUnboundedSpritesArray.end(), _aObj);
+    if (unbounded != mUnboundedSpritesArray.end())
+    {
+        mUnboundedSpritesArray.erase(unbounded);
+    }
+}
+
+bool SceneNode::GetActorSpriteBounds(ActorObject* _aObj,
+    Float2* _center, Float2* _halfSize)
+{
+    // every sprite counts, hidden ones may be shown again without the
+    // scene being told
+    float minX = 0.f, minY = 0.f, maxX = 0.f, maxY = 0.f;
+    bool first = true;
+    Float2 center = MakeFloat2(0.f, 0.f);
+    Float2 halfSize = MakeFloat2(0.f, 0.f);
+    for (auto& sprite : *(_aObj->GetSpriteArray()))
+    {
+        if (!sprite->GetWorldBounds(&center, &halfSize))
+        {
+            return false;
+        }
+
+        if (first || center.x - halfSize.x < minX)
+        {
+            minX = center.x - halfSize.x;
+        }
+        if (first || center.y - halfSize.y < minY)
+        {
+            minY = center.y - halfSize.y;
+        }
+        if (first || center.x + halfSize.x > maxX)
+        {
+            maxX = center.x + halfSize.x;
+        }
+        if (first || center.y + halfSize.y > maxY)
+        {
+            maxY = center.y + halfSize.y;
+        }
+        first = false;
+    }
+
+    *_center = MakeFloat2((minX + maxX) * 0.5f, (minY + maxY) * 0.5f);
+    *_halfSize = MakeFloat2((maxX - minX) * 0.5f, (maxY - minY) * 0.5f);
+
+    return true;
+}
+
+void SceneNode::DrawTilemaps()
+{
+    mDrawStatistics.SubmittedChunks = 0;
+    mDrawStatistics.CulledChunks = 0;
+
+    for (auto& actor : *GetActorsWithComp(COMP_TYPE::ATILEMAP))
+    {
+        if (actor->IsObjectActive() != STATUS::ACTIVE)
+        {
+            continue;
+        }
+
+        ATilemapComponent* atmc = actor->
+            GetAComponent<ATilemapComponent>(COMP_TYPE::ATILEMAP);
+        if (!atmc || atmc->IsCompActive() != STATUS::ACTIVE)
+        {
+            continue;
+        }
+
+        unsigned int drawn = atmc->DrawATilemap(mCamera);
+        mDrawStatistics.SubmittedChunks += drawn;
+        mDrawStatistics.CulledChunks += atmc->GetChunkCount() - drawn;
+    }
+}
+
+void SceneNode::DrawUiObjects()
+{
+    RenderCommandList* list = GetRenderCommandList();
+    if (!mUiDrawDirtyFlg)
+    {
+        list->AppendList(mUiDrawCache, 0);
+        return;
+    }
+
+    size_t firstCommand = list->GetCommandArray()->size();
+    for (auto& ui : mUiSpritesArray)
+    {
+        if (ui->IsObjectActive() == STATUS::ACTIVE)
+        {
+            ui->Draw();
+        }
+    }
+
+    mUiDrawCache->ResetList();
+    mUiDrawCache->AppendList(list, firstCommand);
+    mUiDrawDirtyFlg = false;
+    ++mDrawStatistics.RebuiltUiFrames;
+}
+
+void SceneNode::DrawParticles()
+{
+    mDrawStatistics.SubmittedParticles = 0;
+    mDrawStatistics.CulledEmitters = 0;
+
+    Float2 center = MakeFloat2(0.f, 0.f);
+    Float2 halfSize = MakeFloat2(0.f, 0.f);
+    for (auto& actor : *GetActorsWithComp(COMP_TYPE::APARTICLE))
+    {
+        if (actor->IsObjectActive() != STATUS::ACTIVE)
+        {
+            continue;
+        }
+
+        AParticleComponent* apc = actor->
+            GetAComponent<AParticleComponent>(COMP_TYPE::APARTICLE);
+        if (!apc || apc->IsCompActive() != STATUS::ACTIVE ||
+            !apc->GetWorldBounds(&center, &halfSize))
+        {
+            continue;
+        }
+
+        if (mCamera && !mCamera->IsInCameraView(center, halfSize))
+        {
+            ++mDrawStatistics.CulledEmitters;
+            continue;
+        }
+
+        mDrawStatistics.SubmittedParticles += apc->DrawAParticle();
+    }
+}
+
+void SceneNode::InitAllNewObjects()
+{
+    while (!mNewActorObjectsArray.empty())
+    {
+        auto newActor = mNewActorObjectsArray.back();
+        newActor->Init();
+        newActor->SetObjectActive(STATUS::ACTIVE);
+        mNewActorObjectsArray.pop_back();
+
+        mAddedActorsArray.push_back(newActor);
+        mActorObjectsMap.Insert(newActor->GetObjectNameID(), newActor);
+        IndexActorObject(newActor);
+        PlaceActorInList(newActor);
+
+        if (newActor->GetSpriteArray()->size())
+        {
+            mAddedSpritesArray.push_back(newActor);
+            mSpriteActorSet.insert(newActor);
+            PlaceSpriteActor(newActor);
+        }
+    }
+
+    // a wave of spawns is merged in once instead of each of them
+    // being inserted at the front of the arrays
+    if (!mAddedActorsArray.empty())
+    {
+        std::reverse(mAddedActorsArray.begin(),
+            mAddedActorsArray.end());
+        std::reverse(mAddedSpritesArray.begin(),
+            mAddedSpritesArray.end());
+        MergeNewActors(&mActorObjectsArray, &mAddedActorsArray,
+            &mMergeBufferArray, [](ActorObject* _aObj)
+            { return _aObj->GetUpdateOrder(); });
+        MergeNewActors(&mActorSpritesArray, &mAddedSpritesArray,
+            &mMergeBufferArray, [](ActorObject* _aObj)
+            {
+                return _aObj->GetSpriteArray()->front()->
+                    GetDrawOrder();
+            });
+        mAddedActorsArray.clear();
+        mAddedSpritesArray.clear();
     }
 
     while (!mNewUiObjectsArray.empty())
@@ -393,8 +963,7 @@ void SceneNode::InitAllNewObjects()
         {
             mUiObjectsArray.push_back(newUi);
         }
-        mUiObjectsMap.insert(std::make_pair(
-            newUi->GetObjectName(), newUi));
+        mUiObjectsMap.Insert(newUi->GetObjectNameID(), newUi);
 
         if (newUi->GetSpriteArray()->size())
         {
@@ -420,6 +989,413 @@ void SceneNode::InitAllNewObjects()
     }
 }
 
+void SceneNode::SetActivityMargin(Float2 _margin)
+{
+    mActivityMargin = _margin;
+    mActivityDirtyFlg = true;
+}
+
+Float2 SceneNode::GetActivityMargin() const
+{
+    return mActivityMargin;
+}
+
+void SceneNode::NotifyActorStatusChanged(ActorObject* _aObj)
+{
+    mStatusChangedActorsArray.push_back(_aObj);
+}
+
+void SceneNode::NotifyActorMoved(ActorObject* _aObj)
+{
+    // only a dormant actor has to be placed again, an active one is
+    // checked every frame anyway
+    if (_aObj->GetActorList() == ACTOR_LIST::DORMANT)
+    {
+        mMovedActorsArray.push_back(_aObj);
+    }
+
+    // scripts waiting on this actor, e.g. for a collision, look again
+    mCoroutineScheduler->RaiseSignal(_aObj->GetObjectNameID());
+
+    // any listed actor with sprites may have left its culling cell
+    if (_aObj->GetSpriteArray()->size() &&
+        (mMovedSpritesArray.empty() ||
+            mMovedSpritesArray.back() != _aObj))
+    {
+        mMovedSpritesArray.push_back(_aObj);
+    }
+}
+
+void SceneNode::ApplyActorStatusChanges()
+{
+    for (auto& actor : mStatusChangedActorsArray)
+    {
+        if (actor->GetActorList() == ACTOR_LIST::UNLISTED ||
+            actor->GetActorList() == ACTOR_LIST::RETIRED)
+        {
+            continue;
+        }
+
+        switch (actor->IsObjectActive())
+        {
+        case STATUS::ACTIVE:
+            if (actor->GetActorList() == ACTOR_LIST::PAUSED)
+            {
+                RemoveActorFromList(actor);
+                PlaceActorInList(actor);
+            }
+            break;
+
+        case STATUS::NEED_DESTORY:
+            RetireActorObject(actor);
+            break;
+
+        default:
+            if (actor->GetActorList() != ACTOR_LIST::PAUSED)
+            {
+                RemoveActorFromList(actor);
+                PlaceActorInList(actor);
+            }
+            break;
+        }
+    }
+
+    mStatusChangedActorsArray.clear();
+    CompactRetiredActors();
+}
+
+void SceneNode::UpdateActivityRegion()
+{
+    if (!mCamera)
+    {
+        return;
+    }
+
+    Float2 pos = MakeFloat2(0.f, 0.f);
+
+    auto keep = mActiveActorsArray.begin();
+    for (auto& actor : mActiveActorsArray)
+    {
+        if (actor->GetDormantPolicy() != DORMANT_POLICY::ALWAYS_ACTIVE &&
+            actor->GetRegionPosition(&pos) &&
+            !mCamera->IsInCameraView(pos, mActivityMargin))
+        {
+            InsertDormantActor(actor, pos);
+        }
+        else
+        {
+            *keep++ = actor;
+        }
+    }
+    mActiveActorsArray.erase(keep, mActiveActorsArray.end());
+
+    // a dormant actor is only looked at again when it moved itself
+    // or when the camera brought its cell near the region
+    for (auto& actor : mMovedActorsArray)
+    {
+        if (actor->GetActorList() != ACTOR_LIST::DORMANT)
+        {
+            continue;
+        }
+        if (!actor->GetRegionPosition(&pos) ||
+            mCamera->IsInCameraView(pos, mActivityMargin))
+        {
+            EraseDormantActor(actor);
+            InsertActiveActor(actor);
+        }
+        else
+        {
+            mDormantGrid.MoveActor(actor, pos);
+        }
+    }
+    mMovedActorsArray.clear();
+
+    Float2 camPos = mCamera->GetCameraPosition();
+    Float2 camSize = mCamera->GetCameraSize();
+    if (!mActivityDirtyFlg &&
+        camPos.x == mActivityCameraPos.x &&
+        camPos.y == mActivityCameraPos.y &&
+        camSize.x == mActivityCameraSize.x &&
+        camSize.y == mActivityCameraSize.y)
+    {
+        return;
+    }
+    mActivityDirtyFlg = false;
+    mActivityCameraPos = camPos;
+    mActivityCameraSize = camSize;
+
+    mDormantGrid.QueryRect(camPos,
+        MakeFloat2(camSize.x * 0.5f + mActivityMargin.x,
+            camSize.y * 0.5f + mActivityMargin.y),
+        &mWakeCandidateArray);
+    for (auto& actor : mWakeCandidateArray)
+    {
+        if (!actor->GetRegionPosition(&pos) ||
+            mCamera->IsInCameraView(pos, mActivityMargin))
+        {
+            EraseDormantActor(actor);
+            InsertActiveActor(actor);
+        }
+    }
+}
+
+void SceneNode::PlaceActorInList(ActorObject* _aObj)
+{
+    switch (_aObj->IsObjectActive())
+    {
+    case STATUS::ACTIVE:
+        InsertActiveActor(_aObj);
+        break;
+
+    case STATUS::NEED_DESTORY:
+        RetireActorObject(_aObj);
+        break;
+
+    default:
+        _aObj->SetActorList(ACTOR_LIST::PAUSED);
+        mPausedActorsArray.push_back(_aObj);
+        break;
+    }
+}
+
+void SceneNode::RemoveActorFromList(ActorObject* _aObj)
+{
+    std::vector<ActorObject*>* list = nullptr;
+    switch (_aObj->GetActorList())
+    {
+    case ACTOR_LIST::ACTIVE:
+        list = &mActiveActorsArray;
+        break;
+    case ACTOR_LIST::DORMANT:
+        EraseDormantActor(_aObj);
+        _aObj->SetActorList(ACTOR_LIST::UNLISTED);
+        return;
+    case ACTOR_LIST::PAUSED:
+        list = &mPausedActorsArray;
+        break;
+    default:
+        return;
+    }
+
+    for (auto actor = list->begin(); actor != list->end(); actor++)
+    {
+        if ((*actor) == _aObj)
+        {
+            list->erase(actor);
+            break;
+        }
+    }
+    _aObj->SetActorList(ACTOR_LIST::UNLISTED);
+}
+
+void SceneNode::InsertActiveActor(ActorObject* _aObj)
+{
+    _aObj->SetActorList(ACTOR_LIST::ACTIVE);
+
+    for (auto actor = mActiveActorsArray.begin();
+        actor != mActiveActorsArray.end(); actor++)
+    {
+        if ((*actor)->GetUpdateOrder() >= _aObj->GetUpdateOrder())
+        {
+            mActiveActorsArray.insert(actor, _aObj);
+            return;
+        }
+    }
+    mActiveActorsArray.push_back(_aObj);
+}
+
+void SceneNode::InsertDormantActor(ActorObject* _aObj, Float2 _pos)
+{
+    _aObj->SetActorList(ACTOR_LIST::DORMANT);
+    mDormantGrid.InsertActor(_aObj, _pos);
+    if (_aObj->GetDormantPolicy() == DORMANT_POLICY::REDUCED)
+    {
+        mReducedActorsArray.push_back(_aObj);
+    }
+}
+
+void SceneNode::EraseDormantActor(ActorObject* _aObj)
+{
+    mDormantGrid.RemoveActor(_aObj);
+    for (auto actor = mReducedActorsArray.begin();
+        actor != mReducedActorsArray.end(); actor++)
+    {
+        if ((*actor) == _aObj)
+        {
+            mReducedActorsArray.erase(actor);
+            break;
+        }
+    }
+}
+
+void SceneNode::RetireActorObject(ActorObject* _aObj)
+{
+    // an active actor stays in the big arrays until they are compacted,
+    // a wave of retired bullets would search them once per bullet
+    if (_aObj->GetActorList() != ACTOR_LIST::ACTIVE)
+    {
+        RemoveActorFromList(_aObj);
+    }
+    _aObj->SetActorList(ACTOR_LIST::RETIRED);
+    mRetiringActorsArray.push_back(_aObj);
+    UnindexActorObject(_aObj);
+    mEventBus->UnsubscribeAll(_aObj);
+    mActorObjectsMap.Erase(_aObj->GetObjectNameID());
+
+    if (_aObj->GetRecycleKey() != "" && !_aObj->GetParent() &&
+        _aObj->GetChildrenArray()->empty())
+    {
+        _aObj->Recycle();
+        mRecycledActorsPool[_aObj->GetRecycleKey()].push_back(_aObj);
+        return;
+    }
+
+    mRetiredActorObjectsArray.push_back(_aObj);
+}
+
+void SceneNode::CompactRetiredActors()
+{
+    if (mRetiringActorsArray.empty())
+    {
+        return;
+    }
+
+    auto isRetired = [](ActorObject* _aObj)
+    {
+        return _aObj->GetActorList() == ACTOR_LIST::RETIRED;
+    };
+    for (auto list : { &mActorObjectsArray, &mActorSpritesArray,
+        &mActiveActorsArray })
+    {
+        list->erase(std::remove_if(list->begin(), list->end(),
+            isRetired), list->end());
+    }
+
+    // a new actor that was already retired is placed in the sprite
+    // list after it, so the grid is only cleaned up here
+    for (auto& actor : mRetiringActorsArray)
+    {
+        RemoveSpriteActor(actor);
+        actor->SetActorList(ACTOR_LIST::UNLISTED);
+    }
+    mRetiringActorsArray.clear();
+}
+
+const std::vector<ActorObject*>* SceneNode::GetActorsWithTag(
+    StringID _tag)
+{
+    // a query never grows the index, only indexing an actor does
+    std::vector<ActorObject*>** found = mTagIndex.Find(_tag);
+
+    return found ? *found : &EMPTY_ACTOR_LIST;
+}
+
+const std::vector<ActorObject*>* SceneNode::GetActorsWithComp(
+    COMP_TYPE _type)
+{
+    if (_type >= COMP_TYPE::UTRANSFORM)
+    {
+        P_LOG(LOG_WARNING,
+            "only actor component type can be indexed\n");
+        return &EMPTY_ACTOR_LIST;
+    }
+
+    return &mCompTypeIndex[(size_t)_type];
+}
+
+void SceneNode::IndexActorObject(ActorObject* _aObj)
+{
+    for (auto& tag : *(_aObj->GetTagArray()))
+    {
+        InsertIntoIndex(FindOrAddTagList(tag), _aObj);
+    }
+
+    for (size_t i = 0; i < (size_t)COMP_TYPE::UTRANSFORM; i++)
+    {
+        if (_aObj->HasAComponent((COMP_TYPE)i))
+        {
+            InsertIntoIndex(&mCompTypeIndex[i], _aObj);
+        }
+    }
+}
+
+void SceneNode::UnindexActorObject(ActorObject* _aObj)
+{
+    for (auto& slot : *(_aObj->GetIndexSlotArray()))
+    {
+        std::vector<ActorObject*>* list = slot.List;
+        ActorObject* moved = list->back();
+        (*list)[slot.Slot] = moved;
+        list->pop_back();
+
+        if (moved == _aObj)
+        {
+            continue;
+        }
+        for (auto& movedSlot : *(moved->GetIndexSlotArray()))
+        {
+            if (movedSlot.List == list)
+            {
+                movedSlot.Slot = slot.Slot;
+                break;
+            }
+        }
+    }
+
+    _aObj->GetIndexSlotArray()->clear();
+}
+
+void SceneNode::InsertIntoIndex(std::vector<ActorObject*>* _list,
+    ActorObject* _aObj)
+{
+    _aObj->GetIndexSlotArray()->push_back({ _list, _list->size() });
+    _list->push_back(_aObj);
+}
+
+std::vector<ActorObject*>* SceneNode::FindOrAddTagList(StringID _tag)
+{
+    std::vector<ActorObject*>** found = mTagIndex.Find(_tag);
+    if (found)
+    {
+        return *found;
+    }
+
+    std::vector<ActorObject*>* list = new std::vector<ActorObject*>();
+    mTagIndex.Insert(_tag, list);
+
+    return list;
+}
+
+void SceneNode::ClearActorIndex()
+{
+    for (auto& actor : mActorObjectsArray)
+    {
+        actor->GetIndexSlotArray()->clear();
+    }
+    for (auto& list : mTagIndex)
+    {
+        list->clear();
+    }
+    for (auto& list : mCompTypeIndex)
+    {
+        list.clear();
+    }
+}
+
+ActorObject* SceneNode::TakeRecycledActor(std::string _key)
+{
+    auto pool = mRecycledActorsPool.find(_key);
+    if (pool == mRecycledActorsPool.end() || pool->second.empty())
+    {
+        return nullptr;
+    }
+
+    ActorObject* actor = pool->second.back();
+    pool->second.pop_back();
+
+    return actor;
+}
+
 void SceneNode::DestoryAllRetiredObjects()
 {
     while (!mRetiredActorObjectsArray.empty())
@@ -468,6 +1444,23 @@ void SceneNode::ClearTexPool()
     mTexPool.clear();
 }
 
+void SceneNode::InsertNewSound(std::string _name)
+{
+    mSoundPool.push_back(_name);
+}
+
+void SceneNode::ReleaseSceneSounds()
+{
+    // a sound shared with the next scene has already been referenced
+    // again by its loading, so only the ones nobody needs are freed
+    for (auto& name : mSoundPool)
+    {
+        ReleaseSound(name);
+    }
+
+    mSoundPool.clear();
+}
+
 Camera::Camera(Float2 _pos, Float2 _size) :
     mCameraPosition(_pos), mCameraSize(_size)
 {
@@ -505,7 +1498,38 @@ Float3 Camera::GetRelativePosWithCam(Float3 _absolutePos)
     return relative;
 }
 
+Matrix4x4f Camera::GetViewMatrix()
+{
+    Float4x4 view = DirectX::XMMatrixTranspose(
+        DirectX::XMMatrixTranslation(
+            -mCameraPosition.x, -mCameraPosition.y, 0.f));
+
+    Matrix4x4f result = {};
+    DirectX::XMStoreFloat4x4(&result, view);
+
+    return result;
+}
+
 Float2 Camera::GetCameraPosition()
 {
     return mCameraPosition;
 }
+
+Float2 Camera::GetCameraSize()
+{
+    return mCameraSize;
+}
+
+bool Camera::IsInCameraView(Float2 _center, Float2 _halfSize)
+{
+    float halfCamW = mCameraSize.x * 0.5f;
+    float halfCamH = mCameraSize.y * 0.5f;
+
+    if (fabsf(_center.x - mCameraPosition.x) > halfCamW + _halfSize.x ||
+        fabsf(_center.y - mCameraPosition.y) > halfCamH + _halfSize.y)
+    {
+        return false;
+    }
+
+    return true;
+}
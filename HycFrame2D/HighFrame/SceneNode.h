@@ -10,14 +10,44 @@
 #pragma once
 
 #include "HFCommon.h"
+#include "FlatIDMap.h"
+#include "SpatialGrid.h"
+#include <array>
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
+
+// the sprite grid query is widened by this, an actor whose sprites
+// reach further out is kept aside and tested every frame
+#define SPRITE_GRID_EXTENT      (SPATIAL_CELL_SIZE * 0.5f)
 
 // TEMP----------------
 using SceneLoopFuncType = void (*)();
 // TEMP----------------
 
+struct DRAW_STATISTICS
+{
+    unsigned int SubmittedSprites;
+    // only sprites the grid query handed back are tested and counted
+    unsigned int CulledSprites;
+    unsigned int SubmittedChunks;
+    unsigned int CulledChunks;
+    unsigned int SubmittedParticles;
+    unsigned int CulledEmitters;
+    unsigned int RebuiltUiFrames;
+};
+
+struct SCENE_MEMORY_STATISTICS
+{
+    size_t TextureBytes;
+    size_t SoundBytes;
+    unsigned int TextureNum;
+    unsigned int SoundNum;
+    unsigned int ActorNum;
+    unsigned int UiNum;
+};
+
 class SceneNode
 {
 public:
@@ -31,9 +61,16 @@ public:
 
     void ResetSceneNode();
 
-    class ActorObject* GetActorObject(std::string _name);
+    class ActorObject* GetActorObject(StringID _name);
+
+    // no warning when the name is missing, scripts look up actors
+    // that come and go
+    class ActorObject* FindActorObject(StringID _name);
+
+    class UiObject* GetUiObject(StringID _name);
 
-    class UiObject* GetUiObject(std::string _name);
+    // quiet like FindActorObject, ui made this frame counts too
+    class UiObject* FindUiObject(StringID _name);
 
     std::vector<class ActorObject*>* GetActorArray();
 
@@ -51,15 +88,17 @@ public:
 
     void AddUiObject(class UiObject* _uObj);
 
-    void DeleteActorObject(std::string _name);
+    void DeleteActorObject(StringID _name);
 
-    void DeleteUiObject(std::string _name);
+    void DeleteUiObject(StringID _name);
 
     ID3D11ShaderResourceView* CheckIfTexExist(std::string _path);
 
     void InsertNewTex(std::string _path, 
         ID3D11ShaderResourceView* _tex);
 
+    void InsertNewSound(std::string _name);
+
     void SetSceneLoopFunc(SceneLoopFuncType _func);
 
     void ClearSceneLoopFunc();
@@ -68,13 +107,101 @@ public:
 
     class Camera* GetCamera() const;
 
+    class CoroutineScheduler* GetCoroutineScheduler() const;
+
+    class EventBus* GetEventBus() const;
+
+    class UiFocusGraph* GetFocusGraph() const;
+
+    void MarkUiDrawDirty();
+
+    class RenderCommandList* GetRenderCommandList() const;
+
+    const DRAW_STATISTICS& GetDrawStatistics() const;
+
+    SCENE_MEMORY_STATISTICS GetMemoryStatistics() const;
+
+    size_t GetSceneMemorySize() const;
+
+    void AddPreloadHint(std::string _name, std::string _path);
+
+    const std::vector<std::array<std::string, 2>>*
+        GetPreloadHints() const;
+
+    unsigned long long HashSceneState() const;
+
+    void SetActivityMargin(Float2 _margin);
+
+    Float2 GetActivityMargin() const;
+
+    void NotifyActorStatusChanged(class ActorObject* _aObj);
+
+    void NotifyActorMoved(class ActorObject* _aObj);
+
+    class ActorObject* TakeRecycledActor(std::string _key);
+
+    // both queries only cover actors and never return nullptr, an
+    // unknown tag or an ui comp type gives back a shared empty list,
+    // so query again instead of keeping the pointer
+    const std::vector<class ActorObject*>* GetActorsWithTag(
+        StringID _tag);
+
+    const std::vector<class ActorObject*>* GetActorsWithComp(
+        COMP_TYPE _type);
+
 private:
     void InitAllNewObjects();
 
+    void ApplyActorStatusChanges();
+
+    void UpdateActivityRegion();
+
+    void PlaceActorInList(class ActorObject* _aObj);
+
+    void RemoveActorFromList(class ActorObject* _aObj);
+
+    void InsertActiveActor(class ActorObject* _aObj);
+
+    void InsertDormantActor(class ActorObject* _aObj, Float2 _pos);
+
+    void EraseDormantActor(class ActorObject* _aObj);
+
+    void RetireActorObject(class ActorObject* _aObj);
+
+    void CompactRetiredActors();
+
+    void IndexActorObject(class ActorObject* _aObj);
+
+    void UnindexActorObject(class ActorObject* _aObj);
+
+    void InsertIntoIndex(std::vector<class ActorObject*>* _list,
+        class ActorObject* _aObj);
+
+    std::vector<class ActorObject*>* FindOrAddTagList(StringID _tag);
+
+    void ClearActorIndex();
+
+    void CullActorSprites();
+
+    void PlaceSpriteActor(class ActorObject* _aObj);
+
+    void RemoveSpriteActor(class ActorObject* _aObj);
+
+    bool GetActorSpriteBounds(class ActorObject* _aObj,
+        Float2* _center, Float2* _halfSize);
+
+    void DrawTilemaps();
+
+    void DrawParticles();
+
+    void DrawUiObjects();
+
     void DestoryAllRetiredObjects();
 
     void ClearTexPool();
 
+    void ReleaseSceneSounds();
+
 private:
     const std::string mName;
 
@@ -82,13 +209,27 @@ private:
 
     class SceneManager* mSceneManagerPtr;
 
-    std::unordered_map<std::string, class ActorObject*>
-        mActorObjectsMap;
+    FlatIDMap<class ActorObject*> mActorObjectsMap;
 
     std::vector<class ActorObject*> mActorObjectsArray;
 
-    std::unordered_map<std::string, class UiObject*>
-        mUiObjectsMap;
+    std::vector<class ActorObject*> mActiveActorsArray;
+
+    SpatialGrid mDormantGrid;
+
+    std::vector<class ActorObject*> mReducedActorsArray;
+
+    std::vector<class ActorObject*> mMovedActorsArray;
+
+    std::vector<class ActorObject*> mWakeCandidateArray;
+
+    std::vector<class ActorObject*> mPausedActorsArray;
+
+    std::vector<class ActorObject*> mStatusChangedActorsArray;
+
+    std::vector<class ActorObject*> mRetiringActorsArray;
+
+    FlatIDMap<class UiObject*> mUiObjectsMap;
 
     std::vector<class UiObject*> mUiObjectsArray;
 
@@ -96,20 +237,68 @@ private:
 
     std::vector<class UiObject*> mUiSpritesArray;
 
+    std::vector<class ActorObject*> mVisibleActorsArray;
+
+    SpatialGrid mSpriteGrid;
+
+    std::vector<class ActorObject*> mUnboundedSpritesArray;
+
+    std::vector<class ActorObject*> mMovedSpritesArray;
+
+    std::unordered_set<class ActorObject*> mSpriteActorSet;
+
     std::vector<class ActorObject*> mNewActorObjectsArray;
 
+    std::vector<class ActorObject*> mAddedActorsArray;
+
+    std::vector<class ActorObject*> mAddedSpritesArray;
+
+    std::vector<class ActorObject*> mMergeBufferArray;
+
     std::vector<class UiObject*> mNewUiObjectsArray;
 
     std::vector<class ActorObject*> mRetiredActorObjectsArray;
 
     std::vector<class UiObject*> mRetiredUiObjectsArray;
 
+    std::unordered_map<std::string, std::vector<class ActorObject*>>
+        mRecycledActorsPool;
+
+    FlatIDMap<std::vector<class ActorObject*>*> mTagIndex;
+
+    std::vector<class ActorObject*>
+        mCompTypeIndex[(size_t)COMP_TYPE::UTRANSFORM];
+
     std::unordered_map<std::string, ID3D11ShaderResourceView*> 
         mTexPool;
 
+    std::vector<std::string> mSoundPool;
+
+    std::vector<std::array<std::string, 2>> mPreloadHintArray;
+
     SceneLoopFuncType mSceneLoopFuncPtr;
 
     class Camera* mCamera;
+
+    class CoroutineScheduler* mCoroutineScheduler;
+
+    class EventBus* mEventBus;
+
+    class UiFocusGraph* mFocusGraph;
+
+    class RenderCommandList* mUiDrawCache;
+
+    bool mUiDrawDirtyFlg;
+
+    DRAW_STATISTICS mDrawStatistics;
+
+    Float2 mActivityMargin;
+
+    Float2 mActivityCameraPos;
+
+    Float2 mActivityCameraSize;
+
+    bool mActivityDirtyFlg;
 };
 
 class Camera
@@ -126,8 +315,14 @@ public:
 
     Float3 GetRelativePosWithCam(Float3 _absolutePos);
 
+    Matrix4x4f GetViewMatrix();
+
     Float2 GetCameraPosition();
 
+    Float2 GetCameraSize();
+
+    bool IsInCameraView(Float2 _center, Float2 _halfSize);
+
 private:
     Float2 mCameraPosition;
 
@@ -0,0 +1,514 @@
+﻿//---------------------------------------------------------------
+// File: ScriptCoroutine.cpp
+// Proj: HycFrame2D
+// Info: コルーチンによるスクリプト関数とその待ち合わせ
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "ScriptCoroutine.h"
+#include "Object.h"
+#include "ActorObject.h"
+#include "ACollisionComponent.h"
+#include "SceneNode.h"
+#include "controller.h"
+#include <algorithm>
+
+ScriptCoroutine ScriptCoroutine::promise_type::get_return_object()
+{
+    return ScriptCoroutine(HandleType::from_promise(*this));
+}
+
+std::suspend_always
+ScriptCoroutine::promise_type::initial_suspend() noexcept
+{
+    return {};
+}
+
+std::suspend_always
+ScriptCoroutine::promise_type::final_suspend() noexcept
+{
+    return {};
+}
+
+void ScriptCoroutine::promise_type::return_void()
+{
+
+}
+
+void ScriptCoroutine::promise_type::unhandled_exception()
+{
+    P_LOG(LOG_ERROR, "an exception escaped from a script coroutine\n");
+}
+
+ScriptCoroutine::ScriptCoroutine() :
+    mHandle(nullptr)
+{
+
+}
+
+ScriptCoroutine::ScriptCoroutine(HandleType _handle) :
+    mHandle(_handle)
+{
+
+}
+
+ScriptCoroutine::ScriptCoroutine(ScriptCoroutine&& _other) noexcept :
+    mHandle(_other.mHandle)
+{
+    _other.mHandle = nullptr;
+}
+
+ScriptCoroutine& ScriptCoroutine::operator=(
+    ScriptCoroutine&& _other) noexcept
+{
+    if (this != &_other)
+    {
+        StopCoroutine();
+        mHandle = _other.mHandle;
+        _other.mHandle = nullptr;
+    }
+
+    return *this;
+}
+
+ScriptCoroutine::~ScriptCoroutine()
+{
+    StopCoroutine();
+}
+
+void ScriptCoroutine::StartCoroutine(CoroutineScheduler* _scheduler,
+    Object* _owner)
+{
+    if (!mHandle)
+    {
+        return;
+    }
+
+    mHandle.promise().Scheduler = _scheduler;
+    mHandle.promise().Owner = _owner;
+    _scheduler->ScheduleAtFrame(mHandle, 0);
+}
+
+void ScriptCoroutine::StopCoroutine()
+{
+    if (!mHandle)
+    {
+        return;
+    }
+
+    if (mHandle.promise().Scheduler)
+    {
+        mHandle.promise().Scheduler->CancelCoroutine(mHandle);
+    }
+    mHandle.destroy();
+    mHandle = nullptr;
+}
+
+bool ScriptCoroutine::IsRunning() const
+{
+    return mHandle && !mHandle.done();
+}
+
+namespace
+{
+    struct TimeWaitGreater
+    {
+        template <typename T>
+        bool operator()(const T& _a, const T& _b) const
+        {
+            if (_a.WakeTime != _b.WakeTime)
+            {
+                return _a.WakeTime > _b.WakeTime;
+            }
+            return _a.Sequence > _b.Sequence;
+        }
+    };
+
+    struct FrameWaitGreater
+    {
+        template <typename T>
+        bool operator()(const T& _a, const T& _b) const
+        {
+            if (_a.WakeFrame != _b.WakeFrame)
+            {
+                return _a.WakeFrame > _b.WakeFrame;
+            }
+            return _a.Sequence > _b.Sequence;
+        }
+    };
+}
+
+CoroutineScheduler::CoroutineScheduler() :
+    mTimeWaitHeap({}), mFrameWaitHeap({}), mConditionWaitArray({}),
+    mSignalWaitArray({}), mRaisedSignalArray({}), mReadyArray({}),
+    mParkedArray({}), mCurrentTime(0.f), mCurrentFrame(0),
+    mSequence(0)
+{
+    mTimeWaitHeap.clear();
+    mFrameWaitHeap.clear();
+    mConditionWaitArray.clear();
+    mSignalWaitArray.clear();
+    mRaisedSignalArray.clear();
+    mReadyArray.clear();
+    mParkedArray.clear();
+}
+
+CoroutineScheduler::~CoroutineScheduler()
+{
+
+}
+
+void CoroutineScheduler::ScheduleAtTime(CoroutineHandle _handle,
+    float _seconds)
+{
+    mTimeWaitHeap.push_back({ mCurrentTime + _seconds,
+        mSequence++, _handle });
+    std::push_heap(mTimeWaitHeap.begin(), mTimeWaitHeap.end(),
+        TimeWaitGreater());
+}
+
+void CoroutineScheduler::ScheduleAtFrame(CoroutineHandle _handle,
+    unsigned int _frames)
+{
+    mFrameWaitHeap.push_back({ mCurrentFrame + _frames,
+        mSequence++, _handle });
+    std::push_heap(mFrameWaitHeap.begin(), mFrameWaitHeap.end(),
+        FrameWaitGreater());
+}
+
+void CoroutineScheduler::ScheduleOnCondition(CoroutineHandle _handle,
+    CoroutineCondition* _condition)
+{
+    mConditionWaitArray.push_back({ _condition, _handle });
+}
+
+void CoroutineScheduler::ScheduleOnSignal(CoroutineHandle _handle,
+    StringID _signal, CoroutineCondition* _condition)
+{
+    mSignalWaitArray.push_back({ _signal, _condition, _handle });
+}
+
+void CoroutineScheduler::RaiseSignal(StringID _signal)
+{
+    // most frames nobody listens, moving actors shouldn't pay for it
+    if (mSignalWaitArray.empty())
+    {
+        return;
+    }
+
+    if (mRaisedSignalArray.empty() ||
+        mRaisedSignalArray.back() != _signal.GetValue())
+    {
+        mRaisedSignalArray.push_back(_signal.GetValue());
+    }
+}
+
+void CoroutineScheduler::WakeParkedCoroutines(Object* _owner)
+{
+    if (mParkedArray.empty())
+    {
+        return;
+    }
+
+    auto keep = mParkedArray.begin();
+    for (auto& handle : mParkedArray)
+    {
+        if (handle.promise().Owner == _owner)
+        {
+            ScheduleAtFrame(handle, 0);
+        }
+        else
+        {
+            *keep++ = handle;
+        }
+    }
+    mParkedArray.erase(keep, mParkedArray.end());
+}
+
+void CoroutineScheduler::CancelCoroutine(CoroutineHandle _handle)
+{
+    auto timeEnd = std::remove_if(
+        mTimeWaitHeap.begin(), mTimeWaitHeap.end(),
+        [_handle](const TIME_WAIT& _wait)
+        { return _wait.Handle == _handle; });
+    if (timeEnd != mTimeWaitHeap.end())
+    {
+        mTimeWaitHeap.erase(timeEnd, mTimeWaitHeap.end());
+        std::make_heap(mTimeWaitHeap.begin(), mTimeWaitHeap.end(),
+            TimeWaitGreater());
+    }
+
+    auto frameEnd = std::remove_if(
+        mFrameWaitHeap.begin(), mFrameWaitHeap.end(),
+        [_handle](const FRAME_WAIT& _wait)
+        { return _wait.Handle == _handle; });
+    if (frameEnd != mFrameWaitHeap.end())
+    {
+        mFrameWaitHeap.erase(frameEnd, mFrameWaitHeap.end());
+        std::make_heap(mFrameWaitHeap.begin(), mFrameWaitHeap.end(),
+            FrameWaitGreater());
+    }
+
+    mConditionWaitArray.erase(std::remove_if(
+        mConditionWaitArray.begin(), mConditionWaitArray.end(),
+        [_handle](const CONDITION_WAIT& _wait)
+        { return _wait.Handle == _handle; }),
+        mConditionWaitArray.end());
+
+    mSignalWaitArray.erase(std::remove_if(
+        mSignalWaitArray.begin(), mSignalWaitArray.end(),
+        [_handle](const SIGNAL_WAIT& _wait)
+        { return _wait.Handle == _handle; }),
+        mSignalWaitArray.end());
+
+    mParkedArray.erase(std::remove(
+        mParkedArray.begin(), mParkedArray.end(), _handle),
+        mParkedArray.end());
+
+    for (auto& ready : mReadyArray)
+    {
+        if (ready == _handle)
+        {
+            ready = nullptr;
+        }
+    }
+}
+
+void CoroutineScheduler::UpdateScheduler(float _deltatime)
+{
+    mCurrentTime += _deltatime;
+    ++mCurrentFrame;
+
+    while (!mTimeWaitHeap.empty() &&
+        mTimeWaitHeap.front().WakeTime <= mCurrentTime)
+    {
+        std::pop_heap(mTimeWaitHeap.begin(), mTimeWaitHeap.end(),
+            TimeWaitGreater());
+        mReadyArray.push_back(mTimeWaitHeap.back().Handle);
+        mTimeWaitHeap.pop_back();
+    }
+
+    while (!mFrameWaitHeap.empty() &&
+        mFrameWaitHeap.front().WakeFrame <= mCurrentFrame)
+    {
+        std::pop_heap(mFrameWaitHeap.begin(), mFrameWaitHeap.end(),
+            FrameWaitGreater());
+        mReadyArray.push_back(mFrameWaitHeap.back().Handle);
+        mFrameWaitHeap.pop_back();
+    }
+
+    auto keep = mConditionWaitArray.begin();
+    for (auto& wait : mConditionWaitArray)
+    {
+        if (wait.Condition->IsSatisfied())
+        {
+            mReadyArray.push_back(wait.Handle);
+        }
+        else
+        {
+            *keep++ = wait;
+        }
+    }
+    mConditionWaitArray.erase(keep, mConditionWaitArray.end());
+
+    if (!mRaisedSignalArray.empty())
+    {
+        CheckSignalWaits();
+    }
+
+    ResumeReadyCoroutines();
+}
+
+void CoroutineScheduler::CheckSignalWaits()
+{
+    std::sort(mRaisedSignalArray.begin(), mRaisedSignalArray.end());
+
+    // a waiter can listen to more than one signal, it wakes once and
+    // leaves all of them
+    auto first = mReadyArray.size();
+    auto isWoken = [this, first](CoroutineHandle _handle)
+    {
+        return std::find(mReadyArray.begin() + first,
+            mReadyArray.end(), _handle) != mReadyArray.end();
+    };
+    for (auto& wait : mSignalWaitArray)
+    {
+        if (std::binary_search(mRaisedSignalArray.begin(),
+            mRaisedSignalArray.end(), wait.Signal.GetValue()) &&
+            !isWoken(wait.Handle) && wait.Condition->IsSatisfied())
+        {
+            mReadyArray.push_back(wait.Handle);
+        }
+    }
+    mRaisedSignalArray.clear();
+
+    if (mReadyArray.size() != first)
+    {
+        mSignalWaitArray.erase(std::remove_if(
+            mSignalWaitArray.begin(), mSignalWaitArray.end(),
+            [&isWoken](const SIGNAL_WAIT& _wait)
+            { return isWoken(_wait.Handle); }),
+            mSignalWaitArray.end());
+    }
+}
+
+void CoroutineScheduler::ResumeReadyCoroutines()
+{
+    for (size_t i = 0; i < mReadyArray.size(); i++)
+    {
+        CoroutineHandle handle = mReadyArray[i];
+        if (!handle || handle.done())
+        {
+            continue;
+        }
+
+        Object* owner = handle.promise().Owner;
+        if (owner && owner->IsObjectActive() != STATUS::ACTIVE)
+        {
+            // left alone until the owner is active again instead of
+            // being queued up every frame
+            mParkedArray.push_back(handle);
+            continue;
+        }
+
+        handle.resume();
+    }
+
+    mReadyArray.clear();
+}
+
+float CoroutineScheduler::GetSchedulerTime() const
+{
+    return mCurrentTime;
+}
+
+unsigned long long CoroutineScheduler::GetSchedulerFrame() const
+{
+    return mCurrentFrame;
+}
+
+size_t CoroutineScheduler::GetWaitingCount() const
+{
+    return mTimeWaitHeap.size() + mFrameWaitHeap.size() +
+        mConditionWaitArray.size() + mSignalWaitArray.size();
+}
+
+size_t CoroutineScheduler::GetParkedCount() const
+{
+    return mParkedArray.size();
+}
+
+WaitSeconds::WaitSeconds(float _seconds) :
+    mSeconds(_seconds)
+{
+
+}
+
+bool WaitSeconds::await_ready() const noexcept
+{
+    return mSeconds <= 0.f;
+}
+
+void WaitSeconds::await_suspend(CoroutineHandle _handle)
+{
+    _handle.promise().Scheduler->ScheduleAtTime(_handle, mSeconds);
+}
+
+void WaitSeconds::await_resume() const noexcept
+{
+
+}
+
+WaitFrames::WaitFrames(unsigned int _frames) :
+    mFrames(_frames)
+{
+
+}
+
+bool WaitFrames::await_ready() const noexcept
+{
+    return mFrames == 0;
+}
+
+void WaitFrames::await_suspend(CoroutineHandle _handle)
+{
+    _handle.promise().Scheduler->ScheduleAtFrame(_handle, mFrames);
+}
+
+void WaitFrames::await_resume() const noexcept
+{
+
+}
+
+WaitUntilCollision::WaitUntilCollision(ACollisionComponent* _acc,
+    StringID _targetID) :
+    mCollision(_acc), mTargetID(_targetID)
+{
+
+}
+
+bool WaitUntilCollision::await_ready()
+{
+    return IsSatisfied();
+}
+
+void WaitUntilCollision::await_suspend(CoroutineHandle _handle)
+{
+    // a collision can only start when one of the two has moved
+    CoroutineScheduler* scheduler = _handle.promise().Scheduler;
+    scheduler->ScheduleOnSignal(_handle,
+        mCollision->GetActorObjOwner()->GetObjectNameID(), this);
+    scheduler->ScheduleOnSignal(_handle, mTargetID, this);
+}
+
+void WaitUntilCollision::await_resume() const noexcept
+{
+
+}
+
+bool WaitUntilCollision::IsSatisfied()
+{
+    if (!mCollision)
+    {
+        return true;
+    }
+
+    // looked up every time, the target may have been destroyed or
+    // spawned again under the same name since the last check
+    ActorObject* target = mCollision->GetActorObjOwner()->
+        GetSceneNodePtr()->FindActorObject(mTargetID);
+    if (!target)
+    {
+        return false;
+    }
+
+    return mCollision->CheckCollisionWith(target);
+}
+
+WaitForButton::WaitForButton(UINT _keyCode) :
+    mKeyCode(_keyCode)
+{
+
+}
+
+bool WaitForButton::await_ready() const noexcept
+{
+    return false;
+}
+
+void WaitForButton::await_suspend(CoroutineHandle _handle)
+{
+    _handle.promise().Scheduler->ScheduleOnSignal(_handle,
+        INPUT_TRIGGER_SIGNAL, this);
+}
+
+void WaitForButton::await_resume() const noexcept
+{
+
+}
+
+bool WaitForButton::IsSatisfied()
+{
+    return GetControllerTrigger(mKeyCode);
+}
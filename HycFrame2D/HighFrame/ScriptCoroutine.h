@@ -0,0 +1,226 @@
+﻿//---------------------------------------------------------------
+// File: ScriptCoroutine.h
+// Proj: HycFrame2D
+// Info: コルーチンによるスクリプト関数とその待ち合わせ
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include "HFCommon.h"
+#include "StringID.h"
+#include <coroutine>
+#include <vector>
+
+class ScriptCoroutine
+{
+public:
+    struct promise_type
+    {
+        class CoroutineScheduler* Scheduler = nullptr;
+
+        class Object* Owner = nullptr;
+
+        ScriptCoroutine get_return_object();
+
+        std::suspend_always initial_suspend() noexcept;
+
+        std::suspend_always final_suspend() noexcept;
+
+        void return_void();
+
+        void unhandled_exception();
+    };
+
+    using HandleType = std::coroutine_handle<promise_type>;
+
+public:
+    ScriptCoroutine();
+    explicit ScriptCoroutine(HandleType _handle);
+    ScriptCoroutine(ScriptCoroutine&& _other) noexcept;
+    ScriptCoroutine& operator=(ScriptCoroutine&& _other) noexcept;
+    ScriptCoroutine(const ScriptCoroutine&) = delete;
+    ScriptCoroutine& operator=(const ScriptCoroutine&) = delete;
+    ~ScriptCoroutine();
+
+    void StartCoroutine(class CoroutineScheduler* _scheduler,
+        class Object* _owner);
+
+    void StopCoroutine();
+
+    bool IsRunning() const;
+
+private:
+    HandleType mHandle;
+};
+
+using CoroutineHandle = ScriptCoroutine::HandleType;
+
+// raised by the scene on every frame with at least one key triggered
+constexpr StringID INPUT_TRIGGER_SIGNAL = "input-trigger"_sid;
+
+class CoroutineCondition
+{
+public:
+    virtual ~CoroutineCondition() {}
+
+    virtual bool IsSatisfied() = 0;
+};
+
+class CoroutineScheduler
+{
+public:
+    CoroutineScheduler();
+    ~CoroutineScheduler();
+
+    void ScheduleAtTime(CoroutineHandle _handle, float _seconds);
+
+    void ScheduleAtFrame(CoroutineHandle _handle,
+        unsigned int _frames);
+
+    void ScheduleOnCondition(CoroutineHandle _handle,
+        CoroutineCondition* _condition);
+
+    // the condition is only checked on frames its signal was raised
+    void ScheduleOnSignal(CoroutineHandle _handle, StringID _signal,
+        CoroutineCondition* _condition);
+
+    void RaiseSignal(StringID _signal);
+
+    void WakeParkedCoroutines(class Object* _owner);
+
+    void CancelCoroutine(CoroutineHandle _handle);
+
+    void UpdateScheduler(float _deltatime);
+
+    float GetSchedulerTime() const;
+
+    unsigned long long GetSchedulerFrame() const;
+
+    size_t GetWaitingCount() const;
+
+    size_t GetParkedCount() const;
+
+private:
+    void CheckSignalWaits();
+
+    void ResumeReadyCoroutines();
+
+private:
+    struct TIME_WAIT
+    {
+        float WakeTime;
+        unsigned long long Sequence;
+        CoroutineHandle Handle;
+    };
+
+    struct FRAME_WAIT
+    {
+        unsigned long long WakeFrame;
+        unsigned long long Sequence;
+        CoroutineHandle Handle;
+    };
+
+    struct CONDITION_WAIT
+    {
+        CoroutineCondition* Condition;
+        CoroutineHandle Handle;
+    };
+
+    std::vector<TIME_WAIT> mTimeWaitHeap;
+
+    std::vector<FRAME_WAIT> mFrameWaitHeap;
+
+    struct SIGNAL_WAIT
+    {
+        StringID Signal;
+        CoroutineCondition* Condition;
+        CoroutineHandle Handle;
+    };
+
+    std::vector<CONDITION_WAIT> mConditionWaitArray;
+
+    std::vector<SIGNAL_WAIT> mSignalWaitArray;
+
+    std::vector<unsigned long long> mRaisedSignalArray;
+
+    std::vector<CoroutineHandle> mReadyArray;
+
+    std::vector<CoroutineHandle> mParkedArray;
+
+    float mCurrentTime;
+
+    unsigned long long mCurrentFrame;
+
+    unsigned long long mSequence;
+};
+
+class WaitSeconds
+{
+public:
+    explicit WaitSeconds(float _seconds);
+
+    bool await_ready() const noexcept;
+
+    void await_suspend(CoroutineHandle _handle);
+
+    void await_resume() const noexcept;
+
+private:
+    float mSeconds;
+};
+
+class WaitFrames
+{
+public:
+    explicit WaitFrames(unsigned int _frames);
+
+    bool await_ready() const noexcept;
+
+    void await_suspend(CoroutineHandle _handle);
+
+    void await_resume() const noexcept;
+
+private:
+    unsigned int mFrames;
+};
+
+class WaitUntilCollision :
+    public CoroutineCondition
+{
+public:
+    WaitUntilCollision(class ACollisionComponent* _acc,
+        StringID _targetID);
+
+    bool await_ready();
+
+    void await_suspend(CoroutineHandle _handle);
+
+    void await_resume() const noexcept;
+
+    virtual bool IsSatisfied();
+
+private:
+    class ACollisionComponent* mCollision;
+
+    StringID mTargetID;
+};
+
+class WaitForButton :
+    public CoroutineCondition
+{
+public:
+    explicit WaitForButton(UINT _keyCode);
+
+    bool await_ready() const noexcept;
+
+    void await_suspend(CoroutineHandle _handle);
+
+    void await_resume() const noexcept;
+
+    virtual bool IsSatisfied();
+
+private:
+    UINT mKeyCode;
+};
@@ -0,0 +1,155 @@
+﻿//---------------------------------------------------------------
+// File: SoundClip.cpp
+// Proj: HycFrame2D
+// Info: ミキサーで再生されるサウンドデータ
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "SoundClip.h"
+#include "AudioSimd.h"
+#include "SoundCodec.h"
+#include "PrintLog.h"
+#include <algorithm>
+
+namespace
+{
+    const size_t DECODE_BLOCK_NUM = 8;
+}
+
+SoundClip::SoundClip() :
+    mSamples({}), mBlocks({}), mChannels(0), mFrameCount(0)
+{
+    mSamples.clear();
+    mBlocks.clear();
+}
+
+SoundClip::~SoundClip()
+{
+
+}
+
+bool SoundClip::CreateFromPcm16(const short* _samples, size_t _frames,
+    unsigned int _channels, unsigned int _rate)
+{
+    if (!_frames || !_rate || (_channels != 1 && _channels != 2))
+    {
+        P_LOG(LOG_ERROR,
+            "only mono or stereo pcm can be used : [ %u ]\n",
+            _channels);
+        return false;
+    }
+
+    mChannels = _channels;
+    mBlocks.clear();
+    if (_rate == AUDIO_MIX_RATE)
+    {
+        mFrameCount = _frames;
+        mSamples.assign(_samples, _samples + _frames * _channels);
+        return true;
+    }
+
+    // converted once here so that the mixer never resamples
+    ResamplePcm16(_samples, _frames, _channels, _rate, AUDIO_MIX_RATE,
+        &mSamples);
+    mFrameCount = mSamples.size() / _channels;
+
+    return true;
+}
+
+bool SoundClip::CreateFromAdpcm(const unsigned char* _data,
+    size_t _size)
+{
+    ADPCM_SOUND_HEADER header = {};
+    const unsigned char* blocks = nullptr;
+    if (!ParseAdpcmSound(_data, _size, &header, &blocks))
+    {
+        P_LOG(LOG_ERROR, "invalid adpcm sound data\n");
+        return false;
+    }
+    if (header.SampleRate != AUDIO_MIX_RATE)
+    {
+        P_LOG(LOG_ERROR,
+            "adpcm sound must be cooked at the mix rate : [ %u ]\n",
+            header.SampleRate);
+        return false;
+    }
+
+    mChannels = header.Channels;
+    mFrameCount = header.FrameCount;
+    mSamples.clear();
+    mBlocks.assign(blocks, blocks +
+        (size_t)header.BlockCount * mChannels * ADPCM_BLOCK_BYTES);
+
+    return true;
+}
+
+size_t SoundClip::GetFrameCount() const
+{
+    return mFrameCount;
+}
+
+unsigned int SoundClip::GetChannelCount() const
+{
+    return mChannels;
+}
+
+size_t SoundClip::GetMemorySize() const
+{
+    return mSamples.size() * sizeof(short) + mBlocks.size();
+}
+
+void SoundClip::ReadFrames(size_t _start, size_t _count,
+    float* _out) const
+{
+    if (mBlocks.empty())
+    {
+        const short* src = mSamples.data() + _start * mChannels;
+        if (mChannels == 2)
+        {
+            ConvertPcm16ToFloat(src, _count * 2, _out);
+        }
+        else
+        {
+            ConvertMonoPcm16ToStereo(src, _count, _out);
+        }
+        return;
+    }
+
+    // adpcm is decoded a few blocks at a time right into the mix,
+    // nothing is cached between calls
+    short decoded[DECODE_BLOCK_NUM * AUDIO_MIX_CHANNELS *
+        ADPCM_BLOCK_FRAMES];
+    while (_count)
+    {
+        size_t first = _start / ADPCM_BLOCK_FRAMES;
+        size_t offset = _start % ADPCM_BLOCK_FRAMES;
+        size_t blockNum = std::min(DECODE_BLOCK_NUM,
+            (offset + _count + ADPCM_BLOCK_FRAMES - 1) /
+            ADPCM_BLOCK_FRAMES);
+        DecodeAdpcmBlocks(mBlocks.data() +
+            first * mChannels * ADPCM_BLOCK_BYTES,
+            blockNum * mChannels, decoded);
+
+        for (size_t b = 0; b < blockNum && _count; b++)
+        {
+            size_t begin = b ? 0 : offset;
+            size_t frames = std::min(_count,
+                (size_t)ADPCM_BLOCK_FRAMES - begin);
+            const short* block = decoded +
+                b * mChannels * ADPCM_BLOCK_FRAMES + begin;
+            if (mChannels == 2)
+            {
+                InterleavePcm16ToStereo(block,
+                    block + ADPCM_BLOCK_FRAMES, frames, _out);
+            }
+            else
+            {
+                ConvertMonoPcm16ToStereo(block, frames, _out);
+            }
+            _out += frames * AUDIO_MIX_CHANNELS;
+            _start += frames;
+            _count -= frames;
+        }
+    }
+}
@@ -0,0 +1,44 @@
+﻿//---------------------------------------------------------------
+// File: SoundClip.h
+// Proj: HycFrame2D
+// Info: ミキサーで再生されるサウンドデータ
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#define AUDIO_MIX_RATE          (44100)
+#define AUDIO_MIX_CHANNELS      (2)
+
+class SoundClip
+{
+public:
+    SoundClip();
+    ~SoundClip();
+
+    bool CreateFromPcm16(const short* _samples, size_t _frames,
+        unsigned int _channels, unsigned int _rate);
+
+    bool CreateFromAdpcm(const unsigned char* _data, size_t _size);
+
+    size_t GetFrameCount() const;
+
+    unsigned int GetChannelCount() const;
+
+    size_t GetMemorySize() const;
+
+    void ReadFrames(size_t _start, size_t _count, float* _out) const;
+
+private:
+    std::vector<short> mSamples;
+
+    std::vector<unsigned char> mBlocks;
+
+    unsigned int mChannels;
+
+    size_t mFrameCount;
+};
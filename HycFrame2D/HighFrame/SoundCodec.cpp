@@ -0,0 +1,229 @@
+﻿//---------------------------------------------------------------
+// File: SoundCodec.cpp
+// Proj: HycFrame2D
+// Info: IMA-ADPCMサウンドの形式とエンコード
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "SoundCodec.h"
+#include <cstring>
+
+const int ADPCM_STEP_TABLE[ADPCM_STEP_NUM] =
+{
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
+    34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130,
+    143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449,
+    494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411,
+    1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026,
+    4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+    11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623,
+    27086, 29794, 32767
+};
+
+const int ADPCM_INDEX_TABLE[8] =
+{
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+std::string MakeCookedSoundPath(const std::string& _path)
+{
+    size_t dot = _path.find_last_of('.');
+    size_t slash = _path.find_last_of("/\\");
+    if (dot == std::string::npos ||
+        (slash != std::string::npos && dot < slash))
+    {
+        return _path + ".adpcm";
+    }
+
+    return _path.substr(0, dot) + ".adpcm";
+}
+
+namespace
+{
+    struct ADPCM_STATE
+    {
+        int Predictor;
+        int Index;
+    };
+
+    unsigned char EncodeSample(int _sample, ADPCM_STATE* _state)
+    {
+        int step = ADPCM_STEP_TABLE[_state->Index];
+        int diff = _sample - _state->Predictor;
+        unsigned char nibble = 0;
+        if (diff < 0)
+        {
+            nibble = 8;
+            diff = -diff;
+        }
+        if (diff >= step)
+        {
+            nibble |= 4;
+            diff -= step;
+        }
+        if (diff >= (step >> 1))
+        {
+            nibble |= 2;
+            diff -= step >> 1;
+        }
+        if (diff >= (step >> 2))
+        {
+            nibble |= 1;
+        }
+
+        // the state moves exactly like the decoder's does
+        int delta = step >> 3;
+        delta += (nibble & 4) ? step : 0;
+        delta += (nibble & 2) ? (step >> 1) : 0;
+        delta += (nibble & 1) ? (step >> 2) : 0;
+        int predictor = _state->Predictor +
+            ((nibble & 8) ? -delta : delta);
+        _state->Predictor = predictor > 32767 ? 32767 :
+            (predictor < -32768 ? -32768 : predictor);
+        int index = _state->Index + ADPCM_INDEX_TABLE[nibble & 7];
+        _state->Index = index < 0 ? 0 :
+            (index >= ADPCM_STEP_NUM ? ADPCM_STEP_NUM - 1 : index);
+
+        return nibble;
+    }
+
+    long long EncodeBlock(const short* _samples, ADPCM_STATE _state,
+        unsigned char* _out)
+    {
+        long long error = 0;
+        _out[0] = (unsigned char)(_state.Predictor & 0xFF);
+        _out[1] = (unsigned char)((_state.Predictor >> 8) & 0xFF);
+        _out[2] = (unsigned char)_state.Index;
+        _out[3] = 0;
+        for (int i = 0; i < ADPCM_BLOCK_FRAMES; i++)
+        {
+            unsigned char nibble = EncodeSample(_samples[i], &_state);
+            if (i & 1)
+            {
+                _out[4 + i / 2] |= (unsigned char)(nibble << 4);
+            }
+            else
+            {
+                _out[4 + i / 2] = nibble;
+            }
+            long long diff = _samples[i] - _state.Predictor;
+            error += diff * diff;
+        }
+
+        return error;
+    }
+}
+
+void ResamplePcm16(const short* _src, size_t _frames,
+    unsigned int _channels, unsigned int _srcRate,
+    unsigned int _dstRate, std::vector<short>* _out)
+{
+    // linear interpolation is enough for sound effects
+    double step = (double)_srcRate / (double)_dstRate;
+    size_t count = (size_t)((double)_frames / step);
+    if (!count)
+    {
+        count = 1;
+    }
+    _out->resize(count * _channels);
+    for (size_t i = 0; i < count; i++)
+    {
+        double source = (double)i * step;
+        size_t index = (size_t)source;
+        size_t next = index + 1 < _frames ? index + 1 : index;
+        float t = (float)(source - (double)index);
+        for (unsigned int c = 0; c < _channels; c++)
+        {
+            float a = _src[index * _channels + c];
+            float b = _src[next * _channels + c];
+            (*_out)[i * _channels + c] = (short)(a + (b - a) * t);
+        }
+    }
+}
+
+void EncodeAdpcmSound(const short* _pcm, size_t _frames,
+    unsigned int _channels, unsigned int _rate,
+    std::vector<unsigned char>* _out)
+{
+    unsigned int blockCount = (unsigned int)((_frames +
+        ADPCM_BLOCK_FRAMES - 1) / ADPCM_BLOCK_FRAMES);
+    ADPCM_SOUND_HEADER header = {};
+    header.Magic = ADPCM_SOUND_MAGIC;
+    header.Channels = _channels;
+    header.SampleRate = _rate;
+    header.FrameCount = (unsigned int)_frames;
+    header.BlockFrames = ADPCM_BLOCK_FRAMES;
+    header.BlockCount = blockCount;
+
+    _out->resize(sizeof(header) +
+        (size_t)blockCount * _channels * ADPCM_BLOCK_BYTES);
+    memcpy(_out->data(), &header, sizeof(header));
+    unsigned char* blocks = _out->data() + sizeof(header);
+
+    for (unsigned int c = 0; c < _channels; c++)
+    {
+        for (unsigned int b = 0; b < blockCount; b++)
+        {
+            // the tail of the last block repeats the final sample
+            short samples[ADPCM_BLOCK_FRAMES] = {};
+            for (size_t i = 0; i < ADPCM_BLOCK_FRAMES; i++)
+            {
+                size_t frame = (size_t)b * ADPCM_BLOCK_FRAMES + i;
+                frame = frame < _frames ? frame : _frames - 1;
+                samples[i] = _pcm[frame * _channels + c];
+            }
+
+            // every block restarts the decoder from its header, so it
+            // starts at the exact previous sample with the step index
+            // that fits the block best
+            size_t previous =
+                b ? (size_t)b * ADPCM_BLOCK_FRAMES - 1 : 0;
+            int predictor = _pcm[previous * _channels + c];
+            unsigned char* out = blocks +
+                ((size_t)b * _channels + c) * ADPCM_BLOCK_BYTES;
+            unsigned char trial[ADPCM_BLOCK_BYTES] = {};
+            long long bestError = -1;
+            for (int index = 0; index < ADPCM_STEP_NUM; index++)
+            {
+                ADPCM_STATE start = { predictor, index };
+                long long error = EncodeBlock(samples, start, trial);
+                if (bestError < 0 || error < bestError)
+                {
+                    bestError = error;
+                    memcpy(out, trial, ADPCM_BLOCK_BYTES);
+                }
+            }
+        }
+    }
+}
+
+bool ParseAdpcmSound(const unsigned char* _data, size_t _size,
+    ADPCM_SOUND_HEADER* _header, const unsigned char** _blocks)
+{
+    if (_size < sizeof(ADPCM_SOUND_HEADER))
+    {
+        return false;
+    }
+
+    memcpy(_header, _data, sizeof(ADPCM_SOUND_HEADER));
+    if (_header->Magic != ADPCM_SOUND_MAGIC ||
+        _header->BlockFrames != ADPCM_BLOCK_FRAMES ||
+        (_header->Channels != 1 && _header->Channels != 2) ||
+        !_header->FrameCount ||
+        _header->BlockCount != (_header->FrameCount +
+            ADPCM_BLOCK_FRAMES - 1) / ADPCM_BLOCK_FRAMES)
+    {
+        return false;
+    }
+
+    size_t blockBytes = (size_t)_header->BlockCount *
+        _header->Channels * ADPCM_BLOCK_BYTES;
+    if (_size - sizeof(ADPCM_SOUND_HEADER) < blockBytes)
+    {
+        return false;
+    }
+
+    *_blocks = _data + sizeof(ADPCM_SOUND_HEADER);
+    return true;
+}
@@ -0,0 +1,47 @@
+﻿//---------------------------------------------------------------
+// File: SoundCodec.h
+// Proj: HycFrame2D
+// Info: IMA-ADPCMサウンドの形式とエンコード
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#define ADPCM_SOUND_MAGIC       (0x31444148u)
+#define ADPCM_BLOCK_FRAMES      (128)
+#define ADPCM_BLOCK_BYTES       (4 + ADPCM_BLOCK_FRAMES / 2)
+#define ADPCM_STEP_NUM          (89)
+
+// every block holds one channel and starts from its own predictor, so
+// blocks can be decoded in any order and side by side in simd lanes
+struct ADPCM_SOUND_HEADER
+{
+    unsigned int Magic;
+    unsigned int Channels;
+    unsigned int SampleRate;
+    unsigned int FrameCount;
+    unsigned int BlockFrames;
+    unsigned int BlockCount;
+};
+
+std::string MakeCookedSoundPath(const std::string& _path);
+
+extern const int ADPCM_STEP_TABLE[ADPCM_STEP_NUM];
+
+extern const int ADPCM_INDEX_TABLE[8];
+
+void ResamplePcm16(const short* _src, size_t _frames,
+    unsigned int _channels, unsigned int _srcRate,
+    unsigned int _dstRate, std::vector<short>* _out);
+
+void EncodeAdpcmSound(const short* _pcm, size_t _frames,
+    unsigned int _channels, unsigned int _rate,
+    std::vector<unsigned char>* _out);
+
+bool ParseAdpcmSound(const unsigned char* _data, size_t _size,
+    ADPCM_SOUND_HEADER* _header, const unsigned char** _blocks);
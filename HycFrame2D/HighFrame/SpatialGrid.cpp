@@ -0,0 +1,153 @@
+﻿//---------------------------------------------------------------
+// File: SpatialGrid.cpp
+// Proj: HycFrame2D
+// Info: アクターを格子状のセルに振り分ける空間インデックス
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "SpatialGrid.h"
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float _cellSize) :
+    mCellSize(_cellSize > 0.f ? _cellSize : SPATIAL_CELL_SIZE),
+    mCellMap({}), mActorCellMap({})
+{
+    mCellMap.clear();
+    mActorCellMap.clear();
+}
+
+SpatialGrid::~SpatialGrid()
+{
+
+}
+
+void SpatialGrid::InsertActor(ActorObject* _actor, Float2 _pos)
+{
+    if (HasActor(_actor))
+    {
+        MoveActor(_actor, _pos);
+        return;
+    }
+
+    long long key = MakeCellKey(_pos);
+    mCellMap[key].push_back(_actor);
+    mActorCellMap.insert({ _actor, key });
+}
+
+void SpatialGrid::RemoveActor(ActorObject* _actor)
+{
+    auto found = mActorCellMap.find(_actor);
+    if (found == mActorCellMap.end())
+    {
+        return;
+    }
+
+    auto cell = mCellMap.find(found->second);
+    std::vector<ActorObject*>& list = cell->second;
+    for (size_t i = 0; i < list.size(); i++)
+    {
+        if (list[i] == _actor)
+        {
+            // the order inside a cell means nothing
+            list[i] = list.back();
+            list.pop_back();
+            break;
+        }
+    }
+    if (list.empty())
+    {
+        mCellMap.erase(cell);
+    }
+    mActorCellMap.erase(found);
+}
+
+void SpatialGrid::MoveActor(ActorObject* _actor, Float2 _pos)
+{
+    auto found = mActorCellMap.find(_actor);
+    if (found == mActorCellMap.end())
+    {
+        InsertActor(_actor, _pos);
+        return;
+    }
+
+    if (found->second == MakeCellKey(_pos))
+    {
+        return;
+    }
+
+    RemoveActor(_actor);
+    InsertActor(_actor, _pos);
+}
+
+bool SpatialGrid::HasActor(ActorObject* _actor) const
+{
+    return mActorCellMap.find(_actor) != mActorCellMap.end();
+}
+
+void SpatialGrid::QueryRect(Float2 _center, Float2 _halfSize,
+    std::vector<ActorObject*>* _out) const
+{
+    _out->clear();
+    int minX = ToCellIndex(_center.x - _halfSize.x);
+    int maxX = ToCellIndex(_center.x + _halfSize.x);
+    int minY = ToCellIndex(_center.y - _halfSize.y);
+    int maxY = ToCellIndex(_center.y + _halfSize.y);
+
+    // a rect bigger than the whole grid walks the cells instead
+    long long rectCells =
+        (long long)(maxX - minX + 1) * (long long)(maxY - minY + 1);
+    if (rectCells > (long long)mCellMap.size())
+    {
+        for (auto& cell : mCellMap)
+        {
+            int x = (int)(cell.first >> 32);
+            int y = (int)(cell.first & 0xFFFFFFFF);
+            if (x >= minX && x <= maxX && y >= minY && y <= maxY)
+            {
+                _out->insert(_out->end(),
+                    cell.second.begin(), cell.second.end());
+            }
+        }
+        return;
+    }
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        for (int x = minX; x <= maxX; x++)
+        {
+            auto cell = mCellMap.find(MakeCellKey(x, y));
+            if (cell != mCellMap.end())
+            {
+                _out->insert(_out->end(),
+                    cell->second.begin(), cell->second.end());
+            }
+        }
+    }
+}
+
+size_t SpatialGrid::GetActorNum() const
+{
+    return mActorCellMap.size();
+}
+
+void SpatialGrid::ClearGrid()
+{
+    mCellMap.clear();
+    mActorCellMap.clear();
+}
+
+long long SpatialGrid::MakeCellKey(Float2 _pos) const
+{
+    return MakeCellKey(ToCellIndex(_pos.x), ToCellIndex(_pos.y));
+}
+
+long long SpatialGrid::MakeCellKey(int _x, int _y) const
+{
+    return ((long long)_x << 32) | (long long)(unsigned int)_y;
+}
+
+int SpatialGrid::ToCellIndex(float _value) const
+{
+    return (int)floorf(_value / mCellSize);
+}
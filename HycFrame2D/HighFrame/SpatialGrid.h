@@ -0,0 +1,54 @@
+﻿//---------------------------------------------------------------
+// File: SpatialGrid.h
+// Proj: HycFrame2D
+// Info: アクターを格子状のセルに振り分ける空間インデックス
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include "HFCommon.h"
+#include <unordered_map>
+#include <vector>
+
+#define SPATIAL_CELL_SIZE       (512.f)
+
+// actors are bucketed by one point each, a query hands back every
+// actor of the touched cells and the caller does the exact test
+class SpatialGrid
+{
+public:
+    SpatialGrid(float _cellSize);
+    ~SpatialGrid();
+
+    void InsertActor(class ActorObject* _actor, Float2 _pos);
+
+    void RemoveActor(class ActorObject* _actor);
+
+    void MoveActor(class ActorObject* _actor, Float2 _pos);
+
+    bool HasActor(class ActorObject* _actor) const;
+
+    void QueryRect(Float2 _center, Float2 _halfSize,
+        std::vector<class ActorObject*>* _out) const;
+
+    size_t GetActorNum() const;
+
+    void ClearGrid();
+
+private:
+    long long MakeCellKey(Float2 _pos) const;
+
+    long long MakeCellKey(int _x, int _y) const;
+
+    int ToCellIndex(float _value) const;
+
+private:
+    float mCellSize;
+
+    std::unordered_map<long long, std::vector<class ActorObject*>>
+        mCellMap;
+
+    std::unordered_map<class ActorObject*, long long> mActorCellMap;
+};
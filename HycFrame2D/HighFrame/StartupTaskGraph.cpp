@@ -0,0 +1,249 @@
+﻿//---------------------------------------------------------------
+// File: StartupTaskGraph.cpp
+// Proj: HycFrame2D
+// Info: 起動処理を依存グラフとして並列に実行する
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "StartupTaskGraph.h"
+#include "PrintLog.h"
+#include <fstream>
+#include <thread>
+
+StartupTaskGraph::StartupTaskGraph() :
+    mTaskArray({}), mReadyArray({}), mFinishedNum(0),
+    mMainPendingNum(0), mTaskLock(), mTaskCV(),
+    mStartTime(std::chrono::steady_clock::now()), mRecordArray({}),
+    mMarkArray({}), mThreadNum(1)
+{
+    mTaskArray.clear();
+    mReadyArray.clear();
+    mRecordArray.clear();
+    mMarkArray.clear();
+}
+
+StartupTaskGraph::~StartupTaskGraph()
+{
+
+}
+
+bool StartupTaskGraph::AddTask(const std::string& _name,
+    StartupTaskFuncType _func, const std::vector<std::string>& _depends,
+    bool _mainThreadFlg)
+{
+    // a dependency has to be added first, so the graph can't loop
+    std::vector<unsigned int> parentArray = {};
+    for (auto& depend : _depends)
+    {
+        unsigned int parent = 0;
+        while (parent < mTaskArray.size() &&
+            mTaskArray[parent].Name != depend)
+        {
+            ++parent;
+        }
+        if (parent == mTaskArray.size())
+        {
+            P_LOG(LOG_ERROR,
+                "startup task [ %s ] depends on unknown task [ %s ]\n",
+                _name.c_str(), depend.c_str());
+            return false;
+        }
+        parentArray.push_back(parent);
+    }
+
+    unsigned int index = (unsigned int)mTaskArray.size();
+    mTaskArray.push_back({ _name, _func, {},
+        (unsigned int)parentArray.size(), _mainThreadFlg, false });
+    for (auto parent : parentArray)
+    {
+        mTaskArray[parent].ChildArray.push_back(index);
+    }
+
+    return true;
+}
+
+bool StartupTaskGraph::RunAllTasks(unsigned int _workerNum)
+{
+    mThreadNum = _workerNum + 1;
+    mFinishedNum = 0;
+    mMainPendingNum = 0;
+    mReadyArray.clear();
+    mRecordArray.clear();
+    for (unsigned int i = 0; i < mTaskArray.size(); i++)
+    {
+        if (mTaskArray[i].MainThreadFlg)
+        {
+            ++mMainPendingNum;
+        }
+        if (!mTaskArray[i].WaitNum)
+        {
+            mReadyArray.push_back(i);
+        }
+    }
+
+    std::vector<std::thread> workerArray = {};
+    for (unsigned int i = 1; i <= _workerNum; i++)
+    {
+        workerArray.push_back(
+            std::thread(&StartupTaskGraph::RunWorker, this, i));
+    }
+    RunWorker(0);
+    for (auto& worker : workerArray)
+    {
+        worker.join();
+    }
+
+    bool result = true;
+    for (auto& record : mRecordArray)
+    {
+        result = result && record.Result;
+    }
+
+    return result;
+}
+
+void StartupTaskGraph::MarkTimeline(const std::string& _name)
+{
+    std::lock_guard<std::mutex> lock(mTaskLock);
+    double now = GetElapsedMs();
+    mMarkArray.push_back({ _name, 0, now, now, true });
+}
+
+double StartupTaskGraph::GetElapsedMs() const
+{
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - mStartTime;
+    return elapsed.count();
+}
+
+const std::vector<STARTUP_TASK_RECORD>*
+StartupTaskGraph::GetTaskRecords() const
+{
+    return &mRecordArray;
+}
+
+bool StartupTaskGraph::WriteTraceFile(const std::string& _path) const
+{
+    std::ofstream file(_path, std::ios::trunc);
+    if (!file.is_open())
+    {
+        P_LOG(LOG_ERROR, "cannot open startup trace file : [ %s ]\n",
+            _path.c_str());
+        return false;
+    }
+
+    // chrome trace event format, it opens in chrome://tracing and
+    // in perfetto with one row per thread
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (unsigned int i = 0; i < mThreadNum; i++)
+    {
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+            << "\"tid\":" << i << ",\"args\":{\"name\":\""
+            << (i ? "startup worker " + std::to_string(i) : "main")
+            << "\"}},\n";
+    }
+    for (auto& record : mRecordArray)
+    {
+        file << "{\"name\":\"" << record.Name
+            << "\",\"cat\":\"startup\",\"ph\":\"X\",\"pid\":1,"
+            << "\"tid\":" << record.ThreadIndex
+            << ",\"ts\":" << (long long)(record.StartMs * 1000.0)
+            << ",\"dur\":"
+            << (long long)((record.EndMs - record.StartMs) * 1000.0)
+            << ",\"args\":{\"result\":"
+            << (record.Result ? "true" : "false") << "}},\n";
+    }
+    for (auto& mark : mMarkArray)
+    {
+        file << "{\"name\":\"" << mark.Name
+            << "\",\"cat\":\"startup\",\"ph\":\"i\",\"s\":\"g\","
+            << "\"pid\":1,\"tid\":0,\"ts\":"
+            << (long long)(mark.StartMs * 1000.0) << "},\n";
+    }
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+        << "\"args\":{\"name\":\"HycFrame2D\"}}\n]}\n";
+
+    return file.good();
+}
+
+bool StartupTaskGraph::PickTask(unsigned int _threadIndex,
+    unsigned int* _task)
+{
+    // the main thread keeps itself free for its own tasks and only
+    // helps the workers once none of them is left
+    for (size_t i = 0; i < mReadyArray.size(); i++)
+    {
+        const STARTUP_TASK& task = mTaskArray[mReadyArray[i]];
+        if ((_threadIndex && task.MainThreadFlg) ||
+            (!_threadIndex && !task.MainThreadFlg && mMainPendingNum &&
+            mThreadNum > 1))
+        {
+            continue;
+        }
+
+        *_task = mReadyArray[i];
+        mReadyArray.erase(mReadyArray.begin() + i);
+        return true;
+    }
+
+    return false;
+}
+
+void StartupTaskGraph::FinishTask(unsigned int _task, bool _result)
+{
+    ++mFinishedNum;
+    if (mTaskArray[_task].MainThreadFlg)
+    {
+        --mMainPendingNum;
+    }
+
+    for (auto child : mTaskArray[_task].ChildArray)
+    {
+        // anything built on a failed task is skipped, not run
+        if (!_result)
+        {
+            mTaskArray[child].SkipFlg = true;
+        }
+        if (!--mTaskArray[child].WaitNum)
+        {
+            mReadyArray.push_back(child);
+        }
+    }
+    mTaskCV.notify_all();
+}
+
+void StartupTaskGraph::RunWorker(unsigned int _threadIndex)
+{
+    std::unique_lock<std::mutex> lock(mTaskLock);
+    while (mFinishedNum < mTaskArray.size())
+    {
+        unsigned int index = 0;
+        if (!PickTask(_threadIndex, &index))
+        {
+            mTaskCV.wait(lock);
+            continue;
+        }
+
+        STARTUP_TASK_RECORD record = { mTaskArray[index].Name,
+            _threadIndex, GetElapsedMs(), 0.0, false };
+        bool skipFlg = mTaskArray[index].SkipFlg;
+        lock.unlock();
+
+        if (skipFlg)
+        {
+            P_LOG(LOG_WARNING,
+                "skip startup task [ %s ] after a failed dependency\n",
+                record.Name.c_str());
+        }
+        else
+        {
+            record.Result = mTaskArray[index].Func();
+        }
+        record.EndMs = GetElapsedMs();
+
+        lock.lock();
+        mRecordArray.push_back(record);
+        FinishTask(index, record.Result);
+    }
+}
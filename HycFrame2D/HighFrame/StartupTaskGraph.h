@@ -0,0 +1,91 @@
+﻿//---------------------------------------------------------------
+// File: StartupTaskGraph.h
+// Proj: HycFrame2D
+// Info: 起動処理を依存グラフとして並列に実行する
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define STARTUP_WORKER_NUM      (3)
+#define STARTUP_TRACE_FILE      ("startup-trace.json")
+
+using StartupTaskFuncType = std::function<bool()>;
+
+struct STARTUP_TASK_RECORD
+{
+    std::string Name;
+    unsigned int ThreadIndex;
+    double StartMs;
+    double EndMs;
+    bool Result;
+};
+
+// the timeline starts when the graph is created, thread 0 is always
+// the calling thread and tasks marked as main thread never leave it
+class StartupTaskGraph
+{
+public:
+    StartupTaskGraph();
+    ~StartupTaskGraph();
+
+    bool AddTask(const std::string& _name, StartupTaskFuncType _func,
+        const std::vector<std::string>& _depends,
+        bool _mainThreadFlg = false);
+
+    bool RunAllTasks(unsigned int _workerNum);
+
+    void MarkTimeline(const std::string& _name);
+
+    double GetElapsedMs() const;
+
+    const std::vector<STARTUP_TASK_RECORD>* GetTaskRecords() const;
+
+    bool WriteTraceFile(const std::string& _path) const;
+
+private:
+    struct STARTUP_TASK
+    {
+        std::string Name;
+        StartupTaskFuncType Func;
+        std::vector<unsigned int> ChildArray;
+        unsigned int WaitNum;
+        bool MainThreadFlg;
+        bool SkipFlg;
+    };
+
+    bool PickTask(unsigned int _threadIndex, unsigned int* _task);
+
+    void FinishTask(unsigned int _task, bool _result);
+
+    void RunWorker(unsigned int _threadIndex);
+
+private:
+    std::vector<STARTUP_TASK> mTaskArray;
+
+    std::vector<unsigned int> mReadyArray;
+
+    unsigned int mFinishedNum;
+
+    unsigned int mMainPendingNum;
+
+    std::mutex mTaskLock;
+
+    std::condition_variable mTaskCV;
+
+    std::chrono::steady_clock::time_point mStartTime;
+
+    std::vector<STARTUP_TASK_RECORD> mRecordArray;
+
+    std::vector<STARTUP_TASK_RECORD> mMarkArray;
+
+    unsigned int mThreadNum;
+};
@@ -0,0 +1,75 @@
+﻿//---------------------------------------------------------------
+// File: StringID.cpp
+// Proj: HycFrame2D
+// Info: 名前文字列をハッシュ値で扱うための識別子
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "StringID.h"
+#include "PrintLog.h"
+#include <cstdio>
+#include <unordered_map>
+#include <mutex>
+
+namespace
+{
+    // kept in every build so a release log still prints the name, it
+    // only grows when a name is interned at load
+    std::unordered_map<unsigned long long, std::string>& GetNameTable()
+    {
+        static std::unordered_map<unsigned long long, std::string>
+            table = {};
+        return table;
+    }
+
+    std::mutex& GetNameLock()
+    {
+        static std::mutex lock;
+        return lock;
+    }
+}
+
+StringID::StringID(const std::string& _str) :
+    mValue(HashAppend(OFFSET_BASIS, _str.c_str()))
+{
+
+}
+
+const char* StringID::GetDebugString() const
+{
+    {
+        std::lock_guard<std::mutex> guard(GetNameLock());
+        auto found = GetNameTable().find(mValue);
+        if (found != GetNameTable().end())
+        {
+            return found->second.c_str();
+        }
+    }
+
+    // a name nobody interned, the hash can still be matched by hand
+    thread_local char unknown[48] = {};
+    snprintf(unknown, sizeof(unknown), "<unknown string id %016llx>",
+        mValue);
+    return unknown;
+}
+
+StringID InternStringID(const std::string& _str)
+{
+    StringID id(_str);
+
+    std::lock_guard<std::mutex> guard(GetNameLock());
+    auto found = GetNameTable().find(id.GetValue());
+    if (found == GetNameTable().end())
+    {
+        GetNameTable().insert(std::make_pair(id.GetValue(), _str));
+    }
+    else if (found->second != _str)
+    {
+        P_LOG(LOG_ERROR,
+            "string id collision between [ %s ] and [ %s ]\n",
+            found->second.c_str(), _str.c_str());
+    }
+
+    return id;
+}
@@ -0,0 +1,89 @@
+﻿//---------------------------------------------------------------
+// File: StringID.h
+// Proj: HycFrame2D
+// Info: 名前文字列をハッシュ値で扱うための識別子
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include <string>
+
+class StringID
+{
+public:
+    constexpr StringID() :
+        mValue(0)
+    {
+
+    }
+
+    constexpr StringID(const char* _str) :
+        mValue(HashAppend(OFFSET_BASIS, _str))
+    {
+
+    }
+
+    StringID(const std::string& _str);
+
+    constexpr unsigned long long GetValue() const
+    {
+        return mValue;
+    }
+
+    constexpr StringID Append(const char* _suffix) const
+    {
+        return StringID(HashAppend(mValue, _suffix), RAW_VALUE());
+    }
+
+    constexpr bool operator==(const StringID& _other) const
+    {
+        return mValue == _other.mValue;
+    }
+
+    constexpr bool operator!=(const StringID& _other) const
+    {
+        return mValue != _other.mValue;
+    }
+
+    // the name given to InternStringID, kept in release builds too
+    const char* GetDebugString() const;
+
+private:
+    struct RAW_VALUE {};
+
+    constexpr StringID(unsigned long long _value, RAW_VALUE) :
+        mValue(_value)
+    {
+
+    }
+
+    static constexpr unsigned long long OFFSET_BASIS =
+        14695981039346656037ULL;
+
+    static constexpr unsigned long long FNV_PRIME = 1099511628211ULL;
+
+    static constexpr unsigned long long HashAppend(
+        unsigned long long _hash, const char* _str)
+    {
+        while (*_str)
+        {
+            _hash ^= (unsigned char)(*_str++);
+            _hash *= FNV_PRIME;
+        }
+
+        return _hash;
+    }
+
+private:
+    unsigned long long mValue;
+};
+
+consteval StringID operator""_sid(const char* _str, size_t)
+{
+    return StringID(_str);
+}
+
+// remembers the name so logs can print it, call it at load time
+StringID InternStringID(const std::string& _str);
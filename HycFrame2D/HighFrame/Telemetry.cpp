@@ -0,0 +1,228 @@
+﻿//---------------------------------------------------------------
+// File: Telemetry.cpp
+// Proj: HycFrame2D
+// Info: フレームごとのランタイムカウンターの集計
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "Telemetry.h"
+
+#ifdef RUNTIME_TELEMETRY
+
+#include "PrintLog.h"
+#include <fstream>
+
+namespace
+{
+    const char* const COUNTER_NAME[TELEMETRY_COUNTER_NUM] =
+    {
+        "live-actors",
+        "live-uis",
+        "comp-updates",
+        "draw-calls",
+        "texture-binds",
+        "collision-pairs",
+        "allocations",
+        "json-lookups",
+        "pending-scene-loads"
+    };
+}
+
+TelemetryRegistry::TelemetryRegistry() :
+    mSlotArray({}), mFreeSlotArray({}), mSlotLock(), mGaugeArray(),
+    mLastTotalArray(),
+    mFrameRing({}), mFrameCount(0)
+{
+    mSlotArray.clear();
+    mFreeSlotArray.clear();
+    mFrameRing.clear();
+    mFrameRing.resize(TELEMETRY_RING_SIZE);
+    for (unsigned int i = 0; i < TELEMETRY_COUNTER_NUM; i++)
+    {
+        mGaugeArray[i] = 0;
+        mLastTotalArray[i] = 0;
+    }
+}
+
+TelemetryRegistry::~TelemetryRegistry()
+{
+    // the registry is a function static, every engine thread has been
+    // joined by the time it goes away
+    for (auto slot : mSlotArray)
+    {
+        delete slot;
+    }
+    mSlotArray.clear();
+    mFreeSlotArray.clear();
+}
+
+TELEMETRY_THREAD_SLOT* TelemetryRegistry::AcquireThreadSlot()
+{
+    std::lock_guard<std::mutex> lock(mSlotLock);
+
+    // a reused slot keeps counting up from where the old thread left
+    // it, the snapshot only ever looks at the growth of the sum
+    if (mFreeSlotArray.size())
+    {
+        TELEMETRY_THREAD_SLOT* slot = mFreeSlotArray.back();
+        mFreeSlotArray.pop_back();
+        return slot;
+    }
+
+    TELEMETRY_THREAD_SLOT* slot = new TELEMETRY_THREAD_SLOT();
+    for (auto& count : slot->Count)
+    {
+        count = 0;
+    }
+    mSlotArray.push_back(slot);
+    return slot;
+}
+
+void TelemetryRegistry::ReleaseThreadSlot(TELEMETRY_THREAD_SLOT* _slot)
+{
+    std::lock_guard<std::mutex> lock(mSlotLock);
+    mFreeSlotArray.push_back(_slot);
+}
+
+void TelemetryRegistry::SetGauge(TELEMETRY_COUNTER _counter,
+    unsigned int _value)
+{
+    mGaugeArray[(unsigned int)_counter].store(_value,
+        std::memory_order_relaxed);
+}
+
+void TelemetryRegistry::SnapshotFrame()
+{
+    unsigned long long total[TELEMETRY_COUNTER_NUM] = {};
+    {
+        std::lock_guard<std::mutex> lock(mSlotLock);
+        for (auto slot : mSlotArray)
+        {
+            for (unsigned int i = 0; i < TELEMETRY_COUNTER_NUM; i++)
+            {
+                total[i] +=
+                    slot->Count[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // a counter only ever grows and a gauge is only ever set, so one
+    // of the two parts is always zero
+    TELEMETRY_FRAME& frame =
+        mFrameRing[mFrameCount % TELEMETRY_RING_SIZE];
+    frame.FrameIndex = mFrameCount++;
+    for (unsigned int i = 0; i < TELEMETRY_COUNTER_NUM; i++)
+    {
+        frame.Value[i] =
+            (unsigned int)(total[i] - mLastTotalArray[i]) +
+            mGaugeArray[i].load(std::memory_order_relaxed);
+        mLastTotalArray[i] = total[i];
+    }
+}
+
+bool TelemetryRegistry::GetLatestFrame(TELEMETRY_FRAME* _out) const
+{
+    if (!mFrameCount)
+    {
+        return false;
+    }
+
+    *_out = mFrameRing[(mFrameCount - 1) % TELEMETRY_RING_SIZE];
+    return true;
+}
+
+unsigned int TelemetryRegistry::GetFrameNum() const
+{
+    return mFrameCount < TELEMETRY_RING_SIZE ?
+        (unsigned int)mFrameCount : TELEMETRY_RING_SIZE;
+}
+
+bool TelemetryRegistry::WriteCsvFile(const std::string& _path) const
+{
+    std::ofstream file(_path, std::ios::trunc);
+    if (!file.is_open())
+    {
+        P_LOG(LOG_ERROR, "cannot open telemetry file : [ %s ]\n",
+            _path.c_str());
+        return false;
+    }
+
+    std::vector<TELEMETRY_FRAME> frameArray = {};
+    CopyFrames(&frameArray);
+
+    file << "frame";
+    for (auto name : COUNTER_NAME)
+    {
+        file << "," << name;
+    }
+    file << "\n";
+    for (auto& frame : frameArray)
+    {
+        file << frame.FrameIndex;
+        for (auto value : frame.Value)
+        {
+            file << "," << value;
+        }
+        file << "\n";
+    }
+
+    return file.good();
+}
+
+bool TelemetryRegistry::WriteJsonFile(const std::string& _path) const
+{
+    std::ofstream file(_path, std::ios::trunc);
+    if (!file.is_open())
+    {
+        P_LOG(LOG_ERROR, "cannot open telemetry file : [ %s ]\n",
+            _path.c_str());
+        return false;
+    }
+
+    std::vector<TELEMETRY_FRAME> frameArray = {};
+    CopyFrames(&frameArray);
+
+    file << "{\n    \"frames\": [";
+    for (size_t i = 0; i < frameArray.size(); i++)
+    {
+        file << (i ? ",\n" : "\n") << "        { \"frame\": "
+            << frameArray[i].FrameIndex;
+        for (unsigned int c = 0; c < TELEMETRY_COUNTER_NUM; c++)
+        {
+            file << ", \"" << COUNTER_NAME[c] << "\": "
+                << frameArray[i].Value[c];
+        }
+        file << " }";
+    }
+    file << "\n    ]\n}\n";
+
+    return file.good();
+}
+
+void TelemetryRegistry::CopyFrames(
+    std::vector<TELEMETRY_FRAME>* _out) const
+{
+    // oldest frame first
+    unsigned int frameNum = GetFrameNum();
+    _out->clear();
+    _out->reserve(frameNum);
+    for (unsigned long long i = mFrameCount - frameNum;
+        i < mFrameCount; i++)
+    {
+        _out->push_back(mFrameRing[i % TELEMETRY_RING_SIZE]);
+    }
+}
+
+TelemetryRegistry* GetTelemetryRegistry()
+{
+    static TelemetryRegistry g_TelemetryRegistry;
+    return &g_TelemetryRegistry;
+}
+
+const char* GetTelemetryCounterName(TELEMETRY_COUNTER _counter)
+{
+    return COUNTER_NAME[(unsigned int)_counter];
+}
+
+#endif // RUNTIME_TELEMETRY
@@ -0,0 +1,138 @@
+﻿//---------------------------------------------------------------
+// File: Telemetry.h
+// Proj: HycFrame2D
+// Info: フレームごとのランタイムカウンターの集計
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+// RUNTIME_TELEMETRY is set by the debug configurations of the
+// project, release builds compile the registry and every counter
+// macro below away
+
+#ifdef RUNTIME_TELEMETRY
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define TELEMETRY_RING_SIZE     (600)
+
+enum class TELEMETRY_COUNTER : unsigned int
+{
+    LIVE_ACTORS,
+    LIVE_UIS,
+    COMP_UPDATES,
+    DRAW_CALLS,
+    TEXTURE_BINDS,
+    COLLISION_PAIRS,
+    ALLOCATIONS,
+    JSON_LOOKUPS,
+    PENDING_SCENE_LOADS,
+
+    COUNTER_MAX
+};
+
+#define TELEMETRY_COUNTER_NUM \
+    ((unsigned int)TELEMETRY_COUNTER::COUNTER_MAX)
+
+struct TELEMETRY_FRAME
+{
+    unsigned long long FrameIndex;
+    unsigned int Value[TELEMETRY_COUNTER_NUM];
+};
+
+// only the owning thread writes a slot, so a relaxed load and store
+// are enough and no two writers ever share a cache line
+struct alignas(64) TELEMETRY_THREAD_SLOT
+{
+    std::atomic<unsigned long long> Count[TELEMETRY_COUNTER_NUM];
+};
+
+class TelemetryRegistry
+{
+public:
+    TelemetryRegistry();
+    ~TelemetryRegistry();
+
+    TELEMETRY_THREAD_SLOT* AcquireThreadSlot();
+
+    void ReleaseThreadSlot(TELEMETRY_THREAD_SLOT* _slot);
+
+    void SetGauge(TELEMETRY_COUNTER _counter, unsigned int _value);
+
+    void SnapshotFrame();
+
+    bool GetLatestFrame(TELEMETRY_FRAME* _out) const;
+
+    unsigned int GetFrameNum() const;
+
+    bool WriteCsvFile(const std::string& _path) const;
+
+    bool WriteJsonFile(const std::string& _path) const;
+
+private:
+    void CopyFrames(std::vector<TELEMETRY_FRAME>* _out) const;
+
+private:
+    std::vector<TELEMETRY_THREAD_SLOT*> mSlotArray;
+
+    std::vector<TELEMETRY_THREAD_SLOT*> mFreeSlotArray;
+
+    std::mutex mSlotLock;
+
+    std::atomic<unsigned int> mGaugeArray[TELEMETRY_COUNTER_NUM];
+
+    unsigned long long mLastTotalArray[TELEMETRY_COUNTER_NUM];
+
+    std::vector<TELEMETRY_FRAME> mFrameRing;
+
+    unsigned long long mFrameCount;
+};
+
+TelemetryRegistry* GetTelemetryRegistry();
+
+const char* GetTelemetryCounterName(TELEMETRY_COUNTER _counter);
+
+// hands the slot back when its thread ends, so short lived threads
+// like the scene preloader don't grow the slot list forever
+struct TELEMETRY_SLOT_HOLDER
+{
+    TELEMETRY_THREAD_SLOT* Slot;
+
+    TELEMETRY_SLOT_HOLDER() :
+        Slot(GetTelemetryRegistry()->AcquireThreadSlot()) {}
+    ~TELEMETRY_SLOT_HOLDER()
+    {
+        GetTelemetryRegistry()->ReleaseThreadSlot(Slot);
+    }
+};
+
+inline void AddTelemetryCount(TELEMETRY_COUNTER _counter,
+    unsigned int _value)
+{
+    thread_local TELEMETRY_SLOT_HOLDER holder;
+    std::atomic<unsigned long long>& count =
+        holder.Slot->Count[(unsigned int)_counter];
+    count.store(count.load(std::memory_order_relaxed) + _value,
+        std::memory_order_relaxed);
+}
+
+#define TELEMETRY_ADD(_counter, _value) \
+    AddTelemetryCount(TELEMETRY_COUNTER::_counter, \
+        (unsigned int)(_value))
+#define TELEMETRY_INC(_counter) TELEMETRY_ADD(_counter, 1)
+#define TELEMETRY_SET(_counter, _value) \
+    GetTelemetryRegistry()->SetGauge(TELEMETRY_COUNTER::_counter, \
+        (unsigned int)(_value))
+
+#else
+
+#define TELEMETRY_ADD(_counter, _value) ((void)0)
+#define TELEMETRY_INC(_counter) ((void)0)
+#define TELEMETRY_SET(_counter, _value) ((void)0)
+
+#endif // RUNTIME_TELEMETRY
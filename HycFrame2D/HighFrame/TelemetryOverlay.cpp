@@ -0,0 +1,101 @@
+﻿//---------------------------------------------------------------
+// File: TelemetryOverlay.cpp
+// Proj: HycFrame2D
+// Info: ランタイムカウンターを画面に重ねて表示する
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TelemetryOverlay.h"
+
+#ifdef RUNTIME_TELEMETRY
+
+#include "UTextComponent.h"
+#include "DxRenderBackend.h"
+#include "texture.h"
+#include <cstdio>
+
+TelemetryOverlay::TelemetryOverlay() :
+    mFontTexture(nullptr)
+{
+
+}
+
+TelemetryOverlay::~TelemetryOverlay()
+{
+
+}
+
+bool TelemetryOverlay::StartUp()
+{
+    mFontTexture = LoadTexture(TELEMETRY_FONT_PATH);
+    if (!mFontTexture)
+    {
+        P_LOG(LOG_ERROR, "cannot load telemetry overlay font\n");
+        return false;
+    }
+
+    return true;
+}
+
+void TelemetryOverlay::CleanAndStop()
+{
+    UnloadTexture(&mFontTexture);
+    mFontTexture = nullptr;
+}
+
+void TelemetryOverlay::DrawOverlay(RenderCommandList* _list,
+    const TELEMETRY_FRAME& _frame)
+{
+    static const RENDER_MATRIX SCREEN_VIEW =
+    {
+        1.f, 0.f, 0.f, 0.f,
+        0.f, 1.f, 0.f, 0.f,
+        0.f, 0.f, 1.f, 0.f,
+        0.f, 0.f, 0.f, 1.f
+    };
+
+    if (!mFontTexture)
+    {
+        return;
+    }
+
+    // drawn last in screen space, above the scene and its ui
+    _list->SetViewMatrix(SCREEN_VIEW);
+    _list->BeginTextRun(mFontTexture);
+    float y = (float)DEFAULT_HEIGHT * 0.5f - TELEMETRY_FONT_SIZE;
+    char line[64] = {};
+    for (unsigned int i = 0; i < TELEMETRY_COUNTER_NUM; i++)
+    {
+        snprintf(line, sizeof(line), "%-20s%8u",
+            GetTelemetryCounterName((TELEMETRY_COUNTER)i),
+            _frame.Value[i]);
+        PushTextLine(_list, line, y);
+        y -= TELEMETRY_FONT_SIZE;
+    }
+}
+
+void TelemetryOverlay::PushTextLine(RenderCommandList* _list,
+    const std::string& _text, float _y)
+{
+    float x = (float)DEFAULT_WIDTH * -0.5f + TELEMETRY_FONT_SIZE;
+    for (auto c : _text)
+    {
+        // the same ascii grid the text component reads
+        if (c > 32 && c <= 126)
+        {
+            unsigned int index = c - 32;
+            _list->PushGlyph(
+                { x, _y, TELEMETRY_FONT_SIZE, TELEMETRY_FONT_SIZE },
+                {
+                    (float)(index % MOJI_TEX_H_NUM) * MOJI_U,
+                    (float)(index / MOJI_TEX_H_NUM) * MOJI_V,
+                    MOJI_U, MOJI_V
+                },
+                { 1.f, 1.f, 0.f, 1.f });
+        }
+        x += TELEMETRY_FONT_SIZE;
+    }
+}
+
+#endif // RUNTIME_TELEMETRY
@@ -0,0 +1,41 @@
+﻿//---------------------------------------------------------------
+// File: TelemetryOverlay.h
+// Proj: HycFrame2D
+// Info: ランタイムカウンターを画面に重ねて表示する
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include "Telemetry.h"
+
+#ifdef RUNTIME_TELEMETRY
+
+#include <string>
+
+#define TELEMETRY_FONT_PATH     ("rom:/Assets/Textures/moji.png")
+#define TELEMETRY_FONT_SIZE     (20.f)
+
+class TelemetryOverlay
+{
+public:
+    TelemetryOverlay();
+    ~TelemetryOverlay();
+
+    bool StartUp();
+
+    void CleanAndStop();
+
+    void DrawOverlay(class RenderCommandList* _list,
+        const TELEMETRY_FRAME& _frame);
+
+private:
+    void PushTextLine(class RenderCommandList* _list,
+        const std::string& _text, float _y);
+
+private:
+    struct ID3D11ShaderResourceView* mFontTexture;
+};
+
+#endif // RUNTIME_TELEMETRY
@@ -11,15 +11,17 @@
 #include "UiObject.h"
 #include "SceneNode.h"
 #include "UTransformComponent.h"
+#include "UiFocusGraph.h"
+#include "USpriteComponent.h"
 
 UBtnMapComponent::UBtnMapComponent(std::string _name,
     UiObject* _owner, int _order) :
     UComponent(_name, _owner, _order),
     mSurroundBtns({ nullptr,nullptr,nullptr,nullptr }),
     mIsSelected(false), mSurroundName({ "","","","" }),
-    mCanSelectOther(true)
+    mFocusIndex(-1)
 {
-
+    SetCompNeedUpdate(false);
 }
 
 UBtnMapComponent::~UBtnMapComponent()
@@ -38,28 +40,8 @@ void UBtnMapComponent::CompInit()
         return;
     }
 
-    std::string null = "";
-    for (int i = 0; i < 4; i++)
-    {
-        if (mSurroundName[i] != null)
-        {
-            mSurroundBtns[i] =
-                scene->GetUiObject(mSurroundName[i]);
-        }
-    }
-
-    /*UpdateButtonMapWith(GetUiObjOwner());
-
-    for (auto& ui : *(scene->GetUiArray()))
-    {
-        std::string btnCompName = ui->GetObjectName() + "-btnmap";
-        UBtnMapComponent* ubmc =
-            (UBtnMapComponent*)(ui->GetUComponent(btnCompName));
-        if (ubmc)
-        {
-            ubmc->UpdateButtonMapWith(GetUiObjOwner());
-        }
-    }*/
+    // neighbours are resolved when the scene patches its graph
+    scene->GetFocusGraph()->AddFocusNode(GetUiObjOwner());
 }
 
 void UBtnMapComponent::CompUpdate(float _deltatime)
@@ -74,7 +56,16 @@ void UBtnMapComponent::CompDestory()
 
 void UBtnMapComponent::SetIsSelected(bool _value)
 {
+    if (mIsSelected == _value)
+    {
+        return;
+    }
+
     mIsSelected = _value;
+    for (auto& sprite : *(GetUiObjOwner()->GetSpriteArray()))
+    {
+        sprite->ApplySelectedColor(mIsSelected);
+    }
 }
 
 bool UBtnMapComponent::IsBeingSelected() const
@@ -82,221 +73,35 @@ bool UBtnMapComponent::IsBeingSelected() const
     return mIsSelected;
 }
 
-void UBtnMapComponent::SetCanSelectFlg(bool _value)
-{
-    mCanSelectOther = _value;
-}
-
 void UBtnMapComponent::SelectUpBtn()
 {
-    if (mSurroundBtns[UP_BTN] && mCanSelectOther)
-    {
-        std::string btnCompName =
-            mSurroundBtns[UP_BTN]->GetObjectName() + "-btnmap";
-        UBtnMapComponent* ubmc =
-            (UBtnMapComponent*)(mSurroundBtns[UP_BTN]->
-                GetUComponent(btnCompName));
-
-        if (!ubmc)
-        {
-            P_LOG(LOG_ERROR,
-                "cannot get btn's comp in obj : [ %s ]\n",
-                mSurroundBtns[UP_BTN]->GetObjectName().c_str());
-            return;
-        }
-
-        SetIsSelected(false);
-        ubmc->SetIsSelected(true);
-
-        int nowBtnOrder = 0;
-        int nxtBtnOrder = 0;
-        int count = 0;
-        for (auto i = GetUiObjOwner()->GetSceneNodePtr()->
-            GetUiArray()->begin();
-            i != GetUiObjOwner()->GetSceneNodePtr()->
-            GetUiArray()->end(); i++)
-        {
-            if ((*i) == GetUiObjOwner())
-            {
-                nowBtnOrder = count;
-            }
-            if ((*i) == ubmc->GetUiObjOwner())
-            {
-                nxtBtnOrder = count;
-            }
-
-            ++count;
-        }
-
-        if (nxtBtnOrder > nowBtnOrder)
-        {
-            ubmc->SetCanSelectFlg(false);
-        }
-    }
-
-    if (!mCanSelectOther)
-    {
-        mCanSelectOther = true;
-    }
+    SelectBtnAt(UP_BTN);
 }
 
 void UBtnMapComponent::SelectDownBtn()
 {
-    if (mSurroundBtns[DOWN_BTN] && mCanSelectOther)
-    {
-        std::string btnCompName =
-            mSurroundBtns[DOWN_BTN]->GetObjectName() + "-btnmap";
-        UBtnMapComponent* ubmc =
-            (UBtnMapComponent*)(mSurroundBtns[DOWN_BTN]->
-                GetUComponent(btnCompName));
-
-        if (!ubmc)
-        {
-            P_LOG(LOG_ERROR,
-                "cannot get btn's comp in obj : [ %s ]\n",
-                mSurroundBtns[DOWN_BTN]->GetObjectName().c_str());
-            return;
-        }
-
-        SetIsSelected(false);
-        ubmc->SetIsSelected(true);
-
-        int nowBtnOrder = 0;
-        int nxtBtnOrder = 0;
-        int count = 0;
-        for (auto i = GetUiObjOwner()->GetSceneNodePtr()->
-            GetUiArray()->begin();
-            i != GetUiObjOwner()->GetSceneNodePtr()->
-            GetUiArray()->end(); i++)
-        {
-            if ((*i) == GetUiObjOwner())
-            {
-                nowBtnOrder = count;
-            }
-            if ((*i) == ubmc->GetUiObjOwner())
-            {
-                nxtBtnOrder = count;
-            }
-
-            ++count;
-        }
-
-        if (nxtBtnOrder > nowBtnOrder)
-        {
-            ubmc->SetCanSelectFlg(false);
-        }
-    }
-
-    if (!mCanSelectOther)
-    {
-        mCanSelectOther = true;
-    }
+    SelectBtnAt(DOWN_BTN);
 }
 
 void UBtnMapComponent::SelectLeftBtn()
 {
-    if (mSurroundBtns[LEFT_BTN] && mCanSelectOther)
-    {
-        std::string btnCompName =
-            mSurroundBtns[LEFT_BTN]->GetObjectName() + "-btnmap";
-        UBtnMapComponent* ubmc =
-            (UBtnMapComponent*)(mSurroundBtns[LEFT_BTN]->
-                GetUComponent(btnCompName));
-
-        if (!ubmc)
-        {
-            P_LOG(LOG_ERROR,
-                "cannot get btn's comp in obj : [ %s ]\n",
-                mSurroundBtns[LEFT_BTN]->GetObjectName().c_str());
-            return;
-        }
-
-        SetIsSelected(false);
-        ubmc->SetIsSelected(true);
-
-        int nowBtnOrder = 0;
-        int nxtBtnOrder = 0;
-        int count = 0;
-        for (auto i = GetUiObjOwner()->GetSceneNodePtr()->
-            GetUiArray()->begin();
-            i != GetUiObjOwner()->GetSceneNodePtr()->
-            GetUiArray()->end(); i++)
-        {
-            if ((*i) == GetUiObjOwner())
-            {
-                nowBtnOrder = count;
-            }
-            if ((*i) == ubmc->GetUiObjOwner())
-            {
-                nxtBtnOrder = count;
-            }
-
-            ++count;
-        }
-
-        if (nxtBtnOrder > nowBtnOrder)
-        {
-            ubmc->SetCanSelectFlg(false);
-        }
-    }
-
-    if (!mCanSelectOther)
-    {
-        mCanSelectOther = true;
-    }
+    SelectBtnAt(LEFT_BTN);
 }
 
 void UBtnMapComponent::SelectRightBtn()
 {
-    if (mSurroundBtns[RIGHT_BTN] && mCanSelectOther)
-    {
-        std::string btnCompName =
-            mSurroundBtns[RIGHT_BTN]->GetObjectName() + "-btnmap";
-        UBtnMapComponent* ubmc =
-            (UBtnMapComponent*)(mSurroundBtns[RIGHT_BTN]->
-                GetUComponent(btnCompName));
-
-        if (!ubmc)
-        {
-            P_LOG(LOG_ERROR,
-                "cannot get btn's comp in obj : [ %s ]\n",
-                mSurroundBtns[RIGHT_BTN]->GetObjectName().c_str());
-            return;
-        }
-
-        SetIsSelected(false);
-        ubmc->SetIsSelected(true);
-
-        int nowBtnOrder = 0;
-        int nxtBtnOrder = 0;
-        int count = 0;
-        for (auto i = GetUiObjOwner()->GetSceneNodePtr()->
-            GetUiArray()->begin();
-            i != GetUiObjOwner()->GetSceneNodePtr()->
-            GetUiArray()->end(); i++)
-        {
-            if ((*i) == GetUiObjOwner())
-            {
-                nowBtnOrder = count;
-            }
-            if ((*i) == ubmc->GetUiObjOwner())
-            {
-                nxtBtnOrder = count;
-            }
-
-            ++count;
-        }
-
-        if (nxtBtnOrder > nowBtnOrder)
-        {
-            ubmc->SetCanSelectFlg(false);
-        }
-    }
+    SelectBtnAt(RIGHT_BTN);
+}
 
-    if (!mCanSelectOther)
+void UBtnMapComponent::SelectBtnAt(int _direction)
+{
+    SceneNode* scene = GetUiObjOwner()->GetSceneNodePtr();
+    if (!scene || mFocusIndex < 0)
     {
-        mCanSelectOther = true;
+        return;
     }
+
+    scene->GetFocusGraph()->MoveFocus(mFocusIndex, _direction);
 }
 
 UiObject* UBtnMapComponent::GetUpBtn() const
@@ -338,3 +143,23 @@ void UBtnMapComponent::SetDownName(std::string _name)
 {
     mSurroundName[DOWN_BTN] = _name;
 }
+
+std::string UBtnMapComponent::GetSurroundName(int _direction) const
+{
+    return mSurroundName[_direction];
+}
+
+void UBtnMapComponent::SetSurroundBtn(int _direction, UiObject* _btn)
+{
+    mSurroundBtns[_direction] = _btn;
+}
+
+void UBtnMapComponent::SetFocusIndex(int _index)
+{
+    mFocusIndex = _index;
+}
+
+int UBtnMapComponent::GetFocusIndex() const
+{
+    return mFocusIndex;
+}
@@ -53,8 +53,16 @@ public:
     
     void SetDownName(std::string _name);
 
+    std::string GetSurroundName(int _direction) const;
+
+    void SetSurroundBtn(int _direction, class UiObject* _btn);
+
+    void SetFocusIndex(int _index);
+
+    int GetFocusIndex() const;
+
 private:
-    void SetCanSelectFlg(bool _value);
+    void SelectBtnAt(int _direction);
 
 public:
     virtual void CompInit();
@@ -70,6 +78,6 @@ private:
 
     bool mIsSelected;
 
-    bool mCanSelectOther;
+    int mFocusIndex;
 };
 
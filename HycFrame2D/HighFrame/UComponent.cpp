@@ -9,6 +9,7 @@
 
 #include "UComponent.h"
 #include "UiObject.h"
+#include "SceneNode.h"
 
 UComponent::UComponent(std::string _name,
     UiObject* _owner, int _order) :
@@ -47,3 +48,22 @@ void UComponent::CompDestory()
 {
 
 }
+
+void UComponent::OnNeedUpdateChanged()
+{
+    GetUiObjOwner()->MarkUpdateListDirty();
+}
+
+void UComponent::OnCompActiveChanged()
+{
+    MarkDrawDirty();
+}
+
+void UComponent::MarkDrawDirty()
+{
+    SceneNode* scene = GetUiObjOwner()->GetSceneNodePtr();
+    if (scene)
+    {
+        scene->MarkUiDrawDirty();
+    }
+}
\ No newline at end of file
@@ -23,6 +23,13 @@ public:
 
     int GetUCUpdateOrder() const;
 
+protected:
+    virtual void OnNeedUpdateChanged();
+
+    virtual void OnCompActiveChanged();
+
+    void MarkDrawDirty();
+
 public:
     virtual void CompInit();
 
@@ -9,13 +9,15 @@
 
 #include "UInputComponent.h"
 #include "UiObject.h"
+#include "SceneNode.h"
 
 UInputComponent::UInputComponent(std::string _name,
     UiObject* _owner, int _order) :
     UComponent(_name, _owner, _order),
-    mInputProcessFuncPtr(nullptr)
+    mInputProcessFuncPtr(nullptr),
+    mCoroutineFuncPtr(nullptr), mCoroutine()
 {
-
+    SetCompNeedUpdate(false);
 }
 
 UInputComponent::~UInputComponent()
@@ -25,7 +27,13 @@ UInputComponent::~UInputComponent()
 
 void UInputComponent::CompInit()
 {
-
+    if (mCoroutineFuncPtr)
+    {
+        mCoroutine = mCoroutineFuncPtr(this);
+        mCoroutine.StartCoroutine(GetUiObjOwner()->
+            GetSceneNodePtr()->GetCoroutineScheduler(),
+            GetUiObjOwner());
+    }
 }
 
 void UInputComponent::CompUpdate(float _deltatime)
@@ -38,16 +46,29 @@ void UInputComponent::CompUpdate(float _deltatime)
 
 void UInputComponent::CompDestory()
 {
-
+    mCoroutine.StopCoroutine();
 }
 
 void UInputComponent::SetInputProcessFunc(
     UiInputProcessFuncType _func)
 {
     mInputProcessFuncPtr = _func;
+    SetCompNeedUpdate(_func != nullptr);
 }
 
 void UInputComponent::ClearInputProcessFunc()
 {
     mInputProcessFuncPtr = nullptr;
+    SetCompNeedUpdate(false);
 }
+
+void UInputComponent::SetCoroutineFunc(
+    UiInputCoroutineFuncType _func)
+{
+    mCoroutineFuncPtr = _func;
+}
+
+void UInputComponent::ClearCoroutineFunc()
+{
+    mCoroutineFuncPtr = nullptr;
+}
\ No newline at end of file
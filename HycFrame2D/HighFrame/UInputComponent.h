@@ -10,6 +10,7 @@
 #pragma once
 
 #include "UComponent.h"
+#include "ScriptCoroutine.h"
 
 class UInputComponent :
     public UComponent
@@ -23,6 +24,10 @@ public:
 
     void ClearInputProcessFunc();
 
+    void SetCoroutineFunc(UiInputCoroutineFuncType _func);
+
+    void ClearCoroutineFunc();
+
 public:
     virtual void CompInit();
 
@@ -32,4 +37,8 @@ public:
 
 private:
     UiInputProcessFuncType mInputProcessFuncPtr;
+
+    UiInputCoroutineFuncType mCoroutineFuncPtr;
+
+    ScriptCoroutine mCoroutine;
 };
@@ -9,13 +9,15 @@
 
 #include "UInteractionComponent.h"
 #include "UiObject.h"
+#include "SceneNode.h"
 
 UInteractionComponent::UInteractionComponent(std::string _name,
     UiObject* _owner, int _order) :
     UComponent(_name, _owner, _order), mInterInitFuncPtr(nullptr),
-    mInterUpdateFuncPtr(nullptr), mInterDestoryFuncPtr(nullptr)
+    mInterUpdateFuncPtr(nullptr), mInterDestoryFuncPtr(nullptr),
+    mCoroutineFuncPtr(nullptr), mCoroutine()
 {
-
+    SetCompNeedUpdate(false);
 }
 
 UInteractionComponent::~UInteractionComponent()
@@ -29,6 +31,14 @@ void UInteractionComponent::CompInit()
     {
         mInterInitFuncPtr(this);
     }
+
+    if (mCoroutineFuncPtr)
+    {
+        mCoroutine = mCoroutineFuncPtr(this);
+        mCoroutine.StartCoroutine(GetUiObjOwner()->
+            GetSceneNodePtr()->GetCoroutineScheduler(),
+            GetUiObjOwner());
+    }
 }
 
 void UInteractionComponent::CompUpdate(float _deltatime)
@@ -41,6 +51,8 @@ void UInteractionComponent::CompUpdate(float _deltatime)
 
 void UInteractionComponent::CompDestory()
 {
+    mCoroutine.StopCoroutine();
+
     if (mInterDestoryFuncPtr)
     {
         mInterDestoryFuncPtr(this);
@@ -57,6 +69,7 @@ void UInteractionComponent::SetUpdateFunc(
     UiInterUpdateFuncType _func)
 {
     mInterUpdateFuncPtr = _func;
+    SetCompNeedUpdate(_func != nullptr);
 }
 
 void UInteractionComponent::SetDestoryFunc(
@@ -73,9 +86,21 @@ void UInteractionComponent::ClearInitFunc()
 void UInteractionComponent::ClearUpdateFunc()
 {
     mInterUpdateFuncPtr = nullptr;
+    SetCompNeedUpdate(false);
 }
 
 void UInteractionComponent::ClearDestoryFunc()
 {
     mInterDestoryFuncPtr = nullptr;
 }
+
+void UInteractionComponent::SetCoroutineFunc(
+    UiInterCoroutineFuncType _func)
+{
+    mCoroutineFuncPtr = _func;
+}
+
+void UInteractionComponent::ClearCoroutineFunc()
+{
+    mCoroutineFuncPtr = nullptr;
+}
\ No newline at end of file
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "UComponent.h"
+#include "ScriptCoroutine.h"
 
 class UInteractionComponent :
     public UComponent
@@ -31,6 +32,10 @@ public:
 
     void ClearDestoryFunc();
 
+    void SetCoroutineFunc(UiInterCoroutineFuncType _func);
+
+    void ClearCoroutineFunc();
+
 public:
     virtual void CompInit();
 
@@ -44,4 +49,8 @@ private:
     UiInterUpdateFuncType mInterUpdateFuncPtr;
 
     UiInterDestoryFuncType mInterDestoryFuncPtr;
+
+    UiInterCoroutineFuncType mCoroutineFuncPtr;
+
+    ScriptCoroutine mCoroutine;
 };
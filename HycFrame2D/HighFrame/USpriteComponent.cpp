@@ -10,7 +10,7 @@
 #include "USpriteComponent.h"
 #include "UiObject.h"
 #include "texture.h"
-#include "sprite.h"
+#include "DxRenderBackend.h"
 #include "UTransformComponent.h"
 #include "UBtnMapComponent.h"
 #include "SceneNode.h"
@@ -20,9 +20,13 @@ USpriteComponent::USpriteComponent(std::string _name,
     UComponent(_name, _owner, _order), mDrawOrder(_drawOrder),
     mTexture(nullptr), mOffsetColor(MakeFloat4(1.f, 1.f, 1.f, 1.f)),
     mVisible(true), mTexWidth(0), mTexHeight(0), mTexPath(""),
-    mSpriteVertexBuffer(nullptr), mSpriteIndexBuffer(nullptr)
+    mTransformNameID()
 {
-
+    std::string transname = GetComponentName();
+    auto offset = transname.rfind("sprite");
+    transname.replace(offset, 6, "transform");
+    mTransformNameID = StringID(transname);
+    SetCompNeedUpdate(false);
 }
 
 USpriteComponent::~USpriteComponent()
@@ -37,28 +41,19 @@ void USpriteComponent::CompInit()
         LoadTextureByPath(mTexPath);
     }
 
-    CreateDefaultVertexIndexBuffer(&mSpriteVertexBuffer,
-        &mSpriteIndexBuffer);
+    UBtnMapComponent* ubmc = (UBtnMapComponent*)
+        (GetUiObjOwner()->GetUComponent(
+            GetUiObjOwner()->GetObjectNameID().Append("-btnmap")));
+    if (ubmc)
+    {
+        ApplySelectedColor(ubmc->IsBeingSelected());
+    }
+    MarkDrawDirty();
 }
 
 void USpriteComponent::CompUpdate(float _deltatime)
 {
-    std::string bmcName =
-        GetUiObjOwner()->GetObjectName() + "-btnmap";
-    UBtnMapComponent* ubmc = (UBtnMapComponent*)
-        (GetUiObjOwner()->GetUComponent(bmcName));
 
-    if (ubmc)
-    {
-        if (ubmc->IsBeingSelected())
-        {
-            mOffsetColor = MakeFloat4(1.f, 1.f, 1.f, 1.f);
-        }
-        else
-        {
-            mOffsetColor = MakeFloat4(1.f, 1.f, 1.f, 0.5f);
-        }
-    }
 }
 
 void USpriteComponent::CompDestory()
@@ -91,6 +86,7 @@ void USpriteComponent::LoadTextureByPath(std::string _path)
 void USpriteComponent::DeleteTexture()
 {
     UnloadTexture(&mTexture);
+    MarkDrawDirty();
 }
 
 ID3D11ShaderResourceView* USpriteComponent::GetTexture() const
@@ -105,7 +101,11 @@ void USpriteComponent::SetTexWidth(float _width)
         _width = -_width;
     }
 
-    mTexWidth = _width;
+    if (mTexWidth != _width)
+    {
+        mTexWidth = _width;
+        MarkDrawDirty();
+    }
 }
 
 void USpriteComponent::SetTexHeight(float _height)
@@ -115,7 +115,11 @@ void USpriteComponent::SetTexHeight(float _height)
         _height = -_height;
     }
 
-    mTexHeight = _height;
+    if (mTexHeight != _height)
+    {
+        mTexHeight = _height;
+        MarkDrawDirty();
+    }
 }
 
 float USpriteComponent::GetTexWidth() const
@@ -130,7 +134,12 @@ float USpriteComponent::GetTexHeight() const
 
 void USpriteComponent::SetOffsetColor(Float4 _color)
 {
-    mOffsetColor = _color;
+    if (mOffsetColor.x != _color.x || mOffsetColor.y != _color.y ||
+        mOffsetColor.z != _color.z || mOffsetColor.w != _color.w)
+    {
+        mOffsetColor = _color;
+        MarkDrawDirty();
+    }
 }
 
 Float4 USpriteComponent::GetOffsetColor() const
@@ -140,7 +149,11 @@ Float4 USpriteComponent::GetOffsetColor() const
 
 void USpriteComponent::SetVisible(bool _visible)
 {
-    mVisible = _visible;
+    if (mVisible != _visible)
+    {
+        mVisible = _visible;
+        MarkDrawDirty();
+    }
 }
 
 bool USpriteComponent::GetVisible() const
@@ -156,6 +169,14 @@ int USpriteComponent::GetDrawOrder() const
 void USpriteComponent::ResetDrawOrder(int _order)
 {
     mDrawOrder = _order;
+    MarkDrawDirty();
+}
+
+void USpriteComponent::ApplySelectedColor(bool _selected)
+{
+    SetOffsetColor(_selected ?
+        MakeFloat4(1.f, 1.f, 1.f, 1.f) :
+        MakeFloat4(1.f, 1.f, 1.f, 0.5f));
 }
 
 void USpriteComponent::DrawUSprite()
@@ -165,10 +186,7 @@ void USpriteComponent::DrawUSprite()
         return;
     }
 
-    std::string transname = GetComponentName();
-    auto offset = transname.rfind("sprite");
-    transname.replace(offset, 6, "transform");
-    auto transcomp = GetUiObjOwner()->GetUComponent(transname);
+    auto transcomp = GetUiObjOwner()->GetUComponent(mTransformNameID);
     if (!transcomp)
     {
         P_LOG(LOG_ERROR,
@@ -180,11 +198,8 @@ void USpriteComponent::DrawUSprite()
 
     Matrix4x4f world = ((UTransformComponent*)transcomp)->
         GetWorldMatrix();
-    GetDxHelperPtr()->PassWorldMatrixToVS(&world);
-
-    SetTexture(&mTexture);
-    DrawSprite(&mSpriteVertexBuffer, mSpriteIndexBuffer,
-        0.f, 0.f, mTexWidth, mTexHeight,
-        0.f, 0.f, 1.f, 1.f,
-        mOffsetColor);
+    GetUiObjOwner()->GetSceneNodePtr()->GetRenderCommandList()->
+        PushSprite(ToRenderMatrix(world), mTexture,
+            { 0.f, 0.f, mTexWidth, mTexHeight },
+            { 0.f, 0.f, 1.f, 1.f }, ToRenderFloat4(mOffsetColor));
 }
@@ -45,6 +45,8 @@ public:
 
     void ResetDrawOrder(int _order);
 
+    void ApplySelectedColor(bool _selected);
+
     void DrawUSprite();
 
 public:
@@ -60,10 +62,6 @@ private:
 private:
     ID3D11ShaderResourceView* mTexture;
 
-    ID3D11Buffer* mSpriteVertexBuffer;
-
-    ID3D11Buffer* mSpriteIndexBuffer;
-
     std::string mTexPath;
 
     Float4 mOffsetColor;
@@ -75,4 +73,6 @@ private:
     bool mVisible;
 
     int mDrawOrder;
+
+    StringID mTransformNameID;
 };
@@ -11,7 +11,7 @@
 #include "UiObject.h"
 #include "SceneNode.h"
 #include "texture.h"
-#include "sprite.h"
+#include "DxRenderBackend.h"
 #include "json.h"
 
 UTextComponent::UTextComponent(std::string _name,
@@ -20,10 +20,11 @@ UTextComponent::UTextComponent(std::string _name,
     mTextPosition(MakeFloat3(0.f, 0.f, 0.f)),
     mFontSize(MakeFloat2(0.f, 0.f)), mFontTexture(0),
     mTextColor(MakeFloat4(1.f, 1.f, 1.f, 1.f)), mTextPtr(nullptr),
-    mKanaUV({}), mFontTexPath(""),
-    mTextVertexBuffer(nullptr), mTextIndexBuffer(nullptr)
+    mKanaUV({}), mFontTexPath(""), mGlyphArray({}),
+    mGlyphDirtyFlg(true)
 {
     mKanaUV.clear();
+    mGlyphArray.clear();
 
     JsonFile moji = {};
     LoadJsonFile(&moji, "rom:/Configs/moji.json");
@@ -36,6 +37,9 @@ UTextComponent::UTextComponent(std::string _name,
                 moji["moji"][i]["start"][1].GetFloat() * MOJI_V,
                 moji["moji"][i]["size"].GetFloat())));
     }
+
+    SetCompNeedUpdate(false);
+    mTextPtr = mTextString.c_str();
 }
 
 UTextComponent::~UTextComponent()
@@ -46,14 +50,12 @@ UTextComponent::~UTextComponent()
 void UTextComponent::CompInit()
 {
     LoadFontTexture(mFontTexPath);
-
-    CreateDefaultVertexIndexBuffer(&mTextVertexBuffer,
-        &mTextIndexBuffer);
+    MarkGlyphDirty();
 }
 
 void UTextComponent::CompUpdate(float _deltatime)
 {
-    mTextPtr = mTextString.c_str();
+
 }
 
 void UTextComponent::CompDestory()
@@ -64,11 +66,13 @@ void UTextComponent::CompDestory()
 void UTextComponent::SetTextPosition(Float3 _pos)
 {
     mTextPosition = _pos;
+    MarkGlyphDirty();
 }
 
 void UTextComponent::SetFontSize(Float2 _size)
 {
     mFontSize = _size;
+    MarkGlyphDirty();
 }
 
 Float2 UTextComponent::GetFontSize() const
@@ -100,17 +104,53 @@ void UTextComponent::LoadFontTexture(std::string _path)
 
 void UTextComponent::ChangeTextString(std::string _text)
 {
+    if (mTextString == _text)
+    {
+        return;
+    }
+
     mTextString = _text;
+    mTextPtr = mTextString.c_str();
+    MarkGlyphDirty();
 }
 
 void UTextComponent::SetTextColor(Float4 _color)
 {
     mTextColor = _color;
+    MarkGlyphDirty();
+}
+
+void UTextComponent::MarkGlyphDirty()
+{
+    mGlyphDirtyFlg = true;
+    MarkDrawDirty();
 }
 
 void UTextComponent::DrawUText()
 {
-    SetTexture(&mFontTexture);
+    static const RENDER_MATRIX IDENTITY =
+    {
+        1.f, 0.f, 0.f, 0.f,
+        0.f, 1.f, 0.f, 0.f,
+        0.f, 0.f, 1.f, 0.f,
+        0.f, 0.f, 0.f, 1.f
+    };
+
+    if (mGlyphDirtyFlg)
+    {
+        RebuildGlyphArray();
+    }
+
+    GetUiObjOwner()->GetSceneNodePtr()->GetRenderCommandList()->
+        PushQuadBatch(RENDER_CMD_TYPE::TEXT_RUN, IDENTITY,
+            mFontTexture, mGlyphArray.data(),
+            (unsigned int)mGlyphArray.size());
+}
+
+void UTextComponent::RebuildGlyphArray()
+{
+    mGlyphArray.clear();
+    mGlyphDirtyFlg = false;
     Float3 nowPosition = mTextPosition;
 
     for (auto i = mTextString.length() - mTextString.length();
@@ -146,24 +186,11 @@ void UTextComponent::DrawUText()
                 Float2 uv = MakeFloat2(mojiData.x, mojiData.y);
                 float sizeOffset = mojiData.z;
 
-                {
-                    Matrix4x4f zeroMove =
-                    {
-                        1.f,0.f,0.f,0.f,
-                        0.f,1.f,0.f,0.f,
-                        0.f,0.f,1.f,0.f,
-                        0.f,0.f,0.f,1.f
-                    };
-                    GetDxHelperPtr()->
-                        PassWorldMatrixToVS(&zeroMove);
-                }
-
-                DrawSprite(&mTextVertexBuffer, mTextIndexBuffer,
-                    nowPosition.x, nowPosition.y,
-                    mFontSize.x * sizeOffset,
-                    mFontSize.y * sizeOffset,
-                    uv.x, uv.y,
-                    MOJI_U, MOJI_V, mTextColor);
+                PushGlyph(
+                    MakeFloat4(nowPosition.x, nowPosition.y,
+                        mFontSize.x * sizeOffset,
+                        mFontSize.y * sizeOffset),
+                    MakeFloat4(uv.x, uv.y, MOJI_U, MOJI_V));
 
                 ++i;
                 nowPosition.x += mFontSize.x;
@@ -179,22 +206,10 @@ void UTextComponent::DrawUText()
                 (float)(index % MOJI_TEX_H_NUM) * MOJI_U,
                 (float)(index / MOJI_TEX_H_NUM) * MOJI_V);
 
-            {
-                Matrix4x4f zeroMove =
-                {
-                    1.f,0.f,0.f,0.f,
-                    0.f,1.f,0.f,0.f,
-                    0.f,0.f,1.f,0.f,
-                    0.f,0.f,0.f,1.f
-                };
-                GetDxHelperPtr()->
-                    PassWorldMatrixToVS(&zeroMove);
-            }
-
-            DrawSprite(&mTextVertexBuffer, mTextIndexBuffer,
-                nowPosition.x, nowPosition.y,
-                mFontSize.x, mFontSize.y, uv.x, uv.y,
-                MOJI_U, MOJI_V, mTextColor);
+            PushGlyph(
+                MakeFloat4(nowPosition.x, nowPosition.y,
+                    mFontSize.x, mFontSize.y),
+                MakeFloat4(uv.x, uv.y, MOJI_U, MOJI_V));
 
             nowPosition.x += mFontSize.x;
         }
@@ -206,3 +221,12 @@ void UTextComponent::DrawUText()
         }
     }
 }
+
+void UTextComponent::PushGlyph(Float4 _rect, Float4 _uv)
+{
+    RENDER_QUAD glyph = {};
+    glyph.Rect = ToRenderFloat4(_rect);
+    glyph.UV = ToRenderFloat4(_uv);
+    glyph.Color = ToRenderFloat4(mTextColor);
+    mGlyphArray.push_back(glyph);
+}
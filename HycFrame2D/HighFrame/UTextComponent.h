@@ -10,6 +10,7 @@
 #pragma once
 
 #include "UComponent.h"
+#include "RenderCommandQueue.h"
 #include <unordered_map>
 
 #define MOJI_TEX_H_NUM  (19)
@@ -42,6 +43,12 @@ public:
 private:
     void LoadFontTexture(std::string _path);
 
+    void MarkGlyphDirty();
+
+    void RebuildGlyphArray();
+
+    void PushGlyph(Float4 _rect, Float4 _uv);
+
 public:
     virtual void CompInit();
 
@@ -52,10 +59,6 @@ public:
 private:
     ID3D11ShaderResourceView* mFontTexture;
 
-    ID3D11Buffer* mTextVertexBuffer;
-
-    ID3D11Buffer* mTextIndexBuffer;
-
     std::string mFontTexPath;
 
     std::string mTextString;
@@ -69,4 +72,8 @@ private:
     const char* mTextPtr;
 
     std::unordered_map<std::string, Float3> mKanaUV;
+
+    std::vector<RENDER_QUAD> mGlyphArray;
+
+    bool mGlyphDirtyFlg;
 };
@@ -14,9 +14,10 @@ UTransformComponent::UTransformComponent(std::string _name,
     UiObject* _owner, int _order, Float3 _initValue) :
     UComponent(_name, _owner, _order),
     mPosition(_initValue), mRotation(_initValue),
-    mScale(MakeFloat3(1.f, 1.f, 1.f)), mWorldMatrix(Matrix4x4f())
+    mScale(MakeFloat3(1.f, 1.f, 1.f)), mWorldMatrix(Matrix4x4f()),
+    mWorldDirtyFlg(true)
 {
-
+    SetCompNeedUpdate(false);
 }
 
 UTransformComponent::~UTransformComponent()
@@ -31,7 +32,7 @@ void UTransformComponent::CompInit()
 
 void UTransformComponent::CompUpdate(float _deltatime)
 {
-    UpdateWorldMatrix();
+
 }
 
 void UTransformComponent::CompDestory()
@@ -42,6 +43,7 @@ void UTransformComponent::CompDestory()
 void UTransformComponent::SetPosition(Float3 _pos)
 {
     mPosition = _pos;
+    MarkWorldDirty();
 }
 
 Float3 UTransformComponent::GetPosition() const
@@ -52,6 +54,7 @@ Float3 UTransformComponent::GetPosition() const
 void UTransformComponent::SetRotation(Float3 _angle)
 {
     mRotation = _angle;
+    MarkWorldDirty();
 }
 
 Float3 UTransformComponent::GetRotation() const
@@ -62,6 +65,7 @@ Float3 UTransformComponent::GetRotation() const
 void UTransformComponent::SetScale(Float3 _factor)
 {
     mScale = _factor;
+    MarkWorldDirty();
 }
 
 Float3 UTransformComponent::GetScale() const
@@ -69,8 +73,13 @@ Float3 UTransformComponent::GetScale() const
     return mScale;
 }
 
-Matrix4x4f UTransformComponent::GetWorldMatrix() const
+Matrix4x4f UTransformComponent::GetWorldMatrix()
 {
+    if (mWorldDirtyFlg)
+    {
+        UpdateWorldMatrix();
+    }
+
     return mWorldMatrix;
 }
 
@@ -117,6 +126,7 @@ void UTransformComponent::Translate(Float3 _pos)
     mPosition.x += _pos.x;
     mPosition.y += _pos.y;
     mPosition.z += _pos.z;
+    MarkWorldDirty();
 }
 
 void UTransformComponent::TranslateXAsix(float _posx)
@@ -160,6 +170,7 @@ void UTransformComponent::TranslateXAsix(float _posx)
     }
 
     mPosition.x += _posx;
+    MarkWorldDirty();
 }
 
 void UTransformComponent::TranslateYAsix(float _posy)
@@ -203,6 +214,7 @@ void UTransformComponent::TranslateYAsix(float _posy)
     }
 
     mPosition.y += _posy;
+    MarkWorldDirty();
 }
 
 void UTransformComponent::TranslateZAsix(float _posz)
@@ -246,6 +258,7 @@ void UTransformComponent::TranslateZAsix(float _posz)
     }
 
     mPosition.z += _posz;
+    MarkWorldDirty();
 }
 
 void UTransformComponent::Rotate(Float3 _angle)
@@ -291,6 +304,7 @@ void UTransformComponent::Rotate(Float3 _angle)
     mRotation.x += _angle.x;
     mRotation.y += _angle.y;
     mRotation.z += _angle.z;
+    MarkWorldDirty();
 }
 
 void UTransformComponent::RotateXAsix(float _anglex)
@@ -334,6 +348,7 @@ void UTransformComponent::RotateXAsix(float _anglex)
     }
 
     mRotation.x += _anglex;
+    MarkWorldDirty();
 }
 
 void UTransformComponent::RotateYAsix(float _angley)
@@ -377,6 +392,7 @@ void UTransformComponent::RotateYAsix(float _angley)
     }
 
     mRotation.y += _angley;
+    MarkWorldDirty();
 }
 
 void UTransformComponent::RotateZAsix(float _anglez)
@@ -420,6 +436,7 @@ void UTransformComponent::RotateZAsix(float _anglez)
     }
 
     mRotation.z += _anglez;
+    MarkWorldDirty();
 }
 
 void UTransformComponent::Scale(Float3 _factor)
@@ -465,6 +482,7 @@ void UTransformComponent::Scale(Float3 _factor)
     mScale.x *= _factor.x;
     mScale.y *= _factor.y;
     mScale.z *= _factor.z;
+    MarkWorldDirty();
 }
 
 void UTransformComponent::Scale(float _factor)
@@ -510,6 +528,7 @@ void UTransformComponent::Scale(float _factor)
     mScale.x *= _factor;
     mScale.y *= _factor;
     mScale.z *= _factor;
+    MarkWorldDirty();
 }
 
 void UTransformComponent::ScaleXAsix(float _factorx)
@@ -553,6 +572,7 @@ void UTransformComponent::ScaleXAsix(float _factorx)
     }
 
     mScale.x *= _factorx;
+    MarkWorldDirty();
 }
 
 void UTransformComponent::ScaleYAsix(float _factory)
@@ -596,6 +616,7 @@ void UTransformComponent::ScaleYAsix(float _factory)
     }
 
     mScale.y *= _factory;
+    MarkWorldDirty();
 }
 
 void UTransformComponent::ScaleZAsix(float _factorz)
@@ -639,6 +660,16 @@ void UTransformComponent::ScaleZAsix(float _factorz)
     }
 
     mScale.z *= _factorz;
+    MarkWorldDirty();
+}
+
+void UTransformComponent::MarkWorldDirty()
+{
+    if (!mWorldDirtyFlg)
+    {
+        mWorldDirtyFlg = true;
+        MarkDrawDirty();
+    }
 }
 
 void UTransformComponent::UpdateWorldMatrix()
@@ -671,4 +702,5 @@ void UTransformComponent::UpdateWorldMatrix()
     world = DirectX::XMMatrixTranspose(world);
 
     DirectX::XMStoreFloat4x4(&mWorldMatrix, world);
+    mWorldDirtyFlg = false;
 }
@@ -31,7 +31,7 @@ public:
 
     Float3 GetScale() const;
 
-    Matrix4x4f GetWorldMatrix() const;
+    Matrix4x4f GetWorldMatrix();
 
     void Translate(Float3 _pos);
 
@@ -60,6 +60,8 @@ public:
     void ScaleZAsix(float _factorz);
 
 private:
+    void MarkWorldDirty();
+
     void UpdateWorldMatrix();
 
 public:
@@ -77,4 +79,6 @@ private:
     Float3 mScale;
 
     Matrix4x4f mWorldMatrix;
+
+    bool mWorldDirtyFlg;
 };
@@ -0,0 +1,561 @@
+﻿//---------------------------------------------------------------
+// File: UiFocusGraph.cpp
+// Proj: HycFrame2D
+// Info: シーン毎のボタン選択移動グラフ
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "UiFocusGraph.h"
+#include "SceneNode.h"
+#include "UiObject.h"
+#include "UBtnMapComponent.h"
+#include "UTransformComponent.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cfloat>
+
+namespace
+{
+    const Float2 FOCUS_DIRECTION[4] =
+    {
+        MakeFloat2(-1.f, 0.f),
+        MakeFloat2(0.f, -1.f),
+        MakeFloat2(1.f, 0.f),
+        MakeFloat2(0.f, 1.f)
+    };
+
+    // sideways distance costs more than distance along the move
+    const float SIDEWAYS_WEIGHT = 2.f;
+
+    // the lower index wins a tie, so every search agrees
+    bool IsBetterFocus(float _score, int _index, float _bestScore,
+        int _bestIndex)
+    {
+        return _score < _bestScore || (_score == _bestScore &&
+            _score != FLT_MAX && _index < _bestIndex);
+    }
+}
+
+UiFocusGraph::UiFocusGraph() :
+    mNodeArray({}), mFocusFrameArray({}), mCellMap({}),
+    mCellMinX(INT_MAX), mCellMinY(INT_MAX), mCellMaxX(INT_MIN),
+    mCellMaxY(INT_MIN), mFreeSlotArray({}), mAddedUiArray({}),
+    mRemovedSlotArray({}), mStatistics({ 0, 0, 0 }), mFocusFrame(0),
+    mGraphDirtyFlg(false)
+{
+    mNodeArray.clear();
+    mFocusFrameArray.clear();
+    mCellMap.clear();
+    mFreeSlotArray.clear();
+    mAddedUiArray.clear();
+    mRemovedSlotArray.clear();
+}
+
+UiFocusGraph::~UiFocusGraph()
+{
+
+}
+
+void UiFocusGraph::MarkGraphDirty()
+{
+    mGraphDirtyFlg = true;
+}
+
+bool UiFocusGraph::IsGraphDirty() const
+{
+    return mGraphDirtyFlg;
+}
+
+void UiFocusGraph::AddFocusNode(UiObject* _ui)
+{
+    mAddedUiArray.push_back(_ui);
+}
+
+void UiFocusGraph::RemoveFocusNode(UiObject* _ui)
+{
+    UBtnMapComponent* ubmc =
+        _ui->GetUComponent<UBtnMapComponent>(COMP_TYPE::UBTNMAP);
+    if (!ubmc)
+    {
+        return;
+    }
+
+    auto added = std::find(mAddedUiArray.begin(), mAddedUiArray.end(),
+        _ui);
+    if (added != mAddedUiArray.end())
+    {
+        mAddedUiArray.erase(added);
+    }
+
+    int index = ubmc->GetFocusIndex();
+    ubmc->SetFocusIndex(NULL_FOCUS);
+    if (index < 0 || index >= (int)mNodeArray.size() ||
+        mNodeArray[index].Ui != _ui)
+    {
+        return;
+    }
+
+    // taken out right away so nothing can move the focus onto it
+    FOCUS_NODE& node = mNodeArray[index];
+    auto cell = mCellMap.find(MakeCellKey(ToCellIndex(node.Position.x),
+        ToCellIndex(node.Position.y)));
+    if (cell != mCellMap.end())
+    {
+        std::vector<int>& list = cell->second;
+        for (size_t i = 0; i < list.size(); i++)
+        {
+            if (list[i] == index)
+            {
+                list[i] = list.back();
+                list.pop_back();
+                break;
+            }
+        }
+        if (list.empty())
+        {
+            mCellMap.erase(cell);
+        }
+    }
+    node.Ui = nullptr;
+    node.BtnMap = nullptr;
+    mRemovedSlotArray.push_back(index);
+}
+
+void UiFocusGraph::UpdateFocusGraph(SceneNode* _scene,
+    std::vector<UiObject*>* _uiArray)
+{
+    if (mGraphDirtyFlg || mAddedUiArray.size() > FOCUS_PATCH_LIMIT)
+    {
+        BuildFocusGraph(_scene, _uiArray);
+        return;
+    }
+
+    if (mAddedUiArray.size() || mRemovedSlotArray.size())
+    {
+        PatchFocusGraph(_scene);
+    }
+}
+
+void UiFocusGraph::BuildFocusGraph(SceneNode* _scene,
+    std::vector<UiObject*>* _uiArray)
+{
+    ClearFocusGraph();
+
+    for (auto& ui : *_uiArray)
+    {
+        UBtnMapComponent* ubmc =
+            ui->GetUComponent<UBtnMapComponent>(COMP_TYPE::UBTNMAP);
+        if (ubmc)
+        {
+            PlaceFocusNode(ui, ubmc);
+        }
+    }
+
+    for (int i = 0; i < (int)mNodeArray.size(); i++)
+    {
+        FOCUS_NODE& node = mNodeArray[i];
+        for (int dir = 0; dir < 4; dir++)
+        {
+            if (node.Named[dir])
+            {
+                ResolveNamedNeighbor(_scene, i, dir);
+            }
+            else
+            {
+                node.Neighbor[dir] =
+                    FindNearestInDirection(i, dir, &node.Score[dir]);
+            }
+        }
+        SyncSurroundBtns(i);
+    }
+
+    ++mStatistics.FullBuilds;
+    mGraphDirtyFlg = false;
+}
+
+void UiFocusGraph::ClearFocusGraph()
+{
+    mNodeArray.clear();
+    mFocusFrameArray.clear();
+    mCellMap.clear();
+    mCellMinX = INT_MAX;
+    mCellMinY = INT_MAX;
+    mCellMaxX = INT_MIN;
+    mCellMaxY = INT_MIN;
+    mFreeSlotArray.clear();
+    mAddedUiArray.clear();
+    mRemovedSlotArray.clear();
+}
+
+void UiFocusGraph::AdvanceFocusFrame()
+{
+    ++mFocusFrame;
+}
+
+bool UiFocusGraph::MoveFocus(int _from, int _direction)
+{
+    if (_from < 0 || _from >= (int)mNodeArray.size() ||
+        !mNodeArray[_from].Ui)
+    {
+        return false;
+    }
+
+    // a button that received focus this frame cannot pass it on
+    // until the next frame, no matter where it sits in the ui array
+    if (mFocusFrameArray[_from] == mFocusFrame)
+    {
+        return false;
+    }
+
+    int to = mNodeArray[_from].Neighbor[_direction];
+    if (to == NULL_FOCUS || !mNodeArray[to].Ui ||
+        mNodeArray[to].Ui->IsObjectActive() == STATUS::NEED_DESTORY)
+    {
+        return false;
+    }
+
+    mNodeArray[_from].BtnMap->SetIsSelected(false);
+    mNodeArray[to].BtnMap->SetIsSelected(true);
+    mFocusFrameArray[to] = mFocusFrame;
+
+    return true;
+}
+
+int UiFocusGraph::GetNeighbor(int _from, int _direction) const
+{
+    if (_from < 0 || _from >= (int)mNodeArray.size())
+    {
+        return NULL_FOCUS;
+    }
+
+    return mNodeArray[_from].Neighbor[_direction];
+}
+
+const FOCUS_NODE* UiFocusGraph::GetFocusNode(int _index) const
+{
+    if (_index < 0 || _index >= (int)mNodeArray.size() ||
+        !mNodeArray[_index].Ui)
+    {
+        return nullptr;
+    }
+
+    return &mNodeArray[_index];
+}
+
+unsigned int UiFocusGraph::GetNodeCount() const
+{
+    return (unsigned int)(mNodeArray.size() - mFreeSlotArray.size() -
+        mRemovedSlotArray.size());
+}
+
+const FOCUS_GRAPH_STATISTICS& UiFocusGraph::GetStatistics() const
+{
+    return mStatistics;
+}
+
+void UiFocusGraph::PatchFocusGraph(SceneNode* _scene)
+{
+    std::vector<int> added = {};
+    for (auto& ui : mAddedUiArray)
+    {
+        UBtnMapComponent* ubmc =
+            ui->GetUComponent<UBtnMapComponent>(COMP_TYPE::UBTNMAP);
+        if (!ubmc || ui->IsObjectActive() == STATUS::NEED_DESTORY)
+        {
+            continue;
+        }
+        // a button initialised twice is only placed once
+        int index = ubmc->GetFocusIndex();
+        if (index >= 0 && index < (int)mNodeArray.size() &&
+            mNodeArray[index].Ui == ui)
+        {
+            continue;
+        }
+        added.push_back(PlaceFocusNode(ui, ubmc));
+    }
+    mAddedUiArray.clear();
+
+    // the buttons already there only look at what changed, a lost
+    // neighbour is searched again and a new button can only win
+    for (int i = 0; i < (int)mNodeArray.size(); i++)
+    {
+        FOCUS_NODE& node = mNodeArray[i];
+        if (!node.Ui ||
+            std::find(added.begin(), added.end(), i) != added.end())
+        {
+            continue;
+        }
+
+        bool changed = false;
+        for (int dir = 0; dir < 4; dir++)
+        {
+            int old = node.Neighbor[dir];
+            bool lost = old != NULL_FOCUS && !mNodeArray[old].Ui;
+            if (node.Named[dir])
+            {
+                if (old == NULL_FOCUS || lost)
+                {
+                    ResolveNamedNeighbor(_scene, i, dir);
+                    changed = true;
+                }
+                continue;
+            }
+
+            if (lost)
+            {
+                node.Neighbor[dir] =
+                    FindNearestInDirection(i, dir, &node.Score[dir]);
+                changed = true;
+                continue;
+            }
+            for (auto a : added)
+            {
+                float score = GetFocusScore(i, a, dir);
+                ++mStatistics.ScoredPairs;
+                if (IsBetterFocus(score, a, node.Score[dir],
+                    node.Neighbor[dir]))
+                {
+                    node.Score[dir] = score;
+                    node.Neighbor[dir] = a;
+                    changed = true;
+                }
+            }
+        }
+        if (changed)
+        {
+            SyncSurroundBtns(i);
+        }
+    }
+
+    for (auto a : added)
+    {
+        FOCUS_NODE& node = mNodeArray[a];
+        for (int dir = 0; dir < 4; dir++)
+        {
+            if (node.Named[dir])
+            {
+                ResolveNamedNeighbor(_scene, a, dir);
+            }
+            else
+            {
+                node.Neighbor[dir] =
+                    FindNearestInDirection(a, dir, &node.Score[dir]);
+            }
+        }
+        SyncSurroundBtns(a);
+    }
+
+    // nothing points at the removed slots any more
+    mFreeSlotArray.insert(mFreeSlotArray.end(),
+        mRemovedSlotArray.begin(), mRemovedSlotArray.end());
+    mRemovedSlotArray.clear();
+    ++mStatistics.PatchedBuilds;
+}
+
+int UiFocusGraph::PlaceFocusNode(UiObject* _ui, UBtnMapComponent* _ubmc)
+{
+    int index = (int)mNodeArray.size();
+    if (mFreeSlotArray.size())
+    {
+        index = mFreeSlotArray.back();
+        mFreeSlotArray.pop_back();
+    }
+    else
+    {
+        mNodeArray.push_back({});
+        mFocusFrameArray.push_back(0);
+    }
+
+    FOCUS_NODE& node = mNodeArray[index];
+    node.Ui = _ui;
+    node.BtnMap = _ubmc;
+    node.Position = MakeFloat2(0.f, 0.f);
+    UTransformComponent* utc = _ui->
+        GetUComponent<UTransformComponent>(COMP_TYPE::UTRANSFORM);
+    if (utc)
+    {
+        Float3 pos = utc->GetPosition();
+        node.Position = MakeFloat2(pos.x, pos.y);
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        node.Neighbor[i] = NULL_FOCUS;
+        node.Score[i] = FLT_MAX;
+        node.Named[i] = _ubmc->GetSurroundName(i) != "";
+    }
+    mFocusFrameArray[index] = (unsigned long long)-1;
+
+    int x = ToCellIndex(node.Position.x);
+    int y = ToCellIndex(node.Position.y);
+    mCellMap[MakeCellKey(x, y)].push_back(index);
+    mCellMinX = std::min(mCellMinX, x);
+    mCellMinY = std::min(mCellMinY, y);
+    mCellMaxX = std::max(mCellMaxX, x);
+    mCellMaxY = std::max(mCellMaxY, y);
+
+    _ubmc->SetFocusIndex(index);
+
+    return index;
+}
+
+void UiFocusGraph::ResolveNamedNeighbor(SceneNode* _scene, int _index,
+    int _direction)
+{
+    FOCUS_NODE& node = mNodeArray[_index];
+    std::string name = node.BtnMap->GetSurroundName(_direction);
+    UiObject* target = _scene->FindUiObject(name);
+    UBtnMapComponent* ubmc = target ?
+        target->GetUComponent<UBtnMapComponent>(COMP_TYPE::UBTNMAP) :
+        nullptr;
+    node.Neighbor[_direction] = ubmc ? ubmc->GetFocusIndex() :
+        NULL_FOCUS;
+    if (node.Neighbor[_direction] == NULL_FOCUS)
+    {
+        P_LOG(LOG_WARNING, "cannot find btn [ %s ] for [ %s ]\n",
+            name.c_str(), node.Ui->GetObjectName().c_str());
+    }
+}
+
+void UiFocusGraph::SyncSurroundBtns(int _index)
+{
+    FOCUS_NODE& node = mNodeArray[_index];
+    for (int dir = 0; dir < 4; dir++)
+    {
+        node.BtnMap->SetSurroundBtn(dir,
+            node.Neighbor[dir] == NULL_FOCUS ? nullptr :
+            mNodeArray[node.Neighbor[dir]].Ui);
+    }
+}
+
+int UiFocusGraph::FindNearestInDirection(int _from, int _direction,
+    float* _score)
+{
+    const Float2 origin = mNodeArray[_from].Position;
+    const Float2 dir = FOCUS_DIRECTION[_direction];
+    const int cx = ToCellIndex(origin.x);
+    const int cy = ToCellIndex(origin.y);
+    int nearest = NULL_FOCUS;
+    *_score = FLT_MAX;
+
+    // only the used cells on the side of the move are walked
+    int minX = mCellMinX;
+    int minY = mCellMinY;
+    int maxX = mCellMaxX;
+    int maxY = mCellMaxY;
+    if (dir.x > 0.f)
+    {
+        minX = std::max(minX, cx);
+    }
+    if (dir.x < 0.f)
+    {
+        maxX = std::min(maxX, cx);
+    }
+    if (dir.y > 0.f)
+    {
+        minY = std::max(minY, cy);
+    }
+    if (dir.y < 0.f)
+    {
+        maxY = std::min(maxY, cy);
+    }
+    if (minX > maxX || minY > maxY)
+    {
+        return NULL_FOCUS;
+    }
+
+    int lastRing = std::max(std::max(cx - minX, maxX - cx),
+        std::max(cy - minY, maxY - cy));
+    for (int r = 0; r <= lastRing; r++)
+    {
+        // a button in ring r is more than r - 1 cells away along one
+        // axis, and the score is never less than that
+        if ((float)(r - 1) * FOCUS_CELL_SIZE >= *_score)
+        {
+            break;
+        }
+
+        int y0 = std::max(minY, cy - r);
+        int y1 = std::min(maxY, cy + r);
+        for (int y = y0; y <= y1; y++)
+        {
+            if (y == cy - r || y == cy + r)
+            {
+                int x0 = std::max(minX, cx - r);
+                int x1 = std::min(maxX, cx + r);
+                for (int x = x0; x <= x1; x++)
+                {
+                    ScoreCellNodes(_from, _direction, x, y,
+                        &nearest, _score);
+                }
+                continue;
+            }
+            if (cx - r >= minX)
+            {
+                ScoreCellNodes(_from, _direction, cx - r, y,
+                    &nearest, _score);
+            }
+            if (cx + r <= maxX)
+            {
+                ScoreCellNodes(_from, _direction, cx + r, y,
+                    &nearest, _score);
+            }
+        }
+    }
+
+    return nearest;
+}
+
+void UiFocusGraph::ScoreCellNodes(int _from, int _direction, int _x,
+    int _y, int* _nearest, float* _bestScore)
+{
+    auto cell = mCellMap.find(MakeCellKey(_x, _y));
+    if (cell == mCellMap.end())
+    {
+        return;
+    }
+
+    for (auto i : cell->second)
+    {
+        float score = GetFocusScore(_from, i, _direction);
+        ++mStatistics.ScoredPairs;
+        if (IsBetterFocus(score, i, *_bestScore, *_nearest))
+        {
+            *_bestScore = score;
+            *_nearest = i;
+        }
+    }
+}
+
+float UiFocusGraph::GetFocusScore(int _from, int _to,
+    int _direction) const
+{
+    if (_from == _to)
+    {
+        return FLT_MAX;
+    }
+
+    const Float2 dir = FOCUS_DIRECTION[_direction];
+    const Float2 origin = mNodeArray[_from].Position;
+    float dx = mNodeArray[_to].Position.x - origin.x;
+    float dy = mNodeArray[_to].Position.y - origin.y;
+    float along = dx * dir.x + dy * dir.y;
+    if (along <= 0.f)
+    {
+        return FLT_MAX;
+    }
+
+    float sideways = fabsf(dx * dir.y - dy * dir.x);
+    return along + sideways * SIDEWAYS_WEIGHT;
+}
+
+long long UiFocusGraph::MakeCellKey(int _x, int _y) const
+{
+    return ((long long)_x << 32) | (long long)(unsigned int)_y;
+}
+
+int UiFocusGraph::ToCellIndex(float _value) const
+{
+    return (int)floorf(_value / FOCUS_CELL_SIZE);
+}
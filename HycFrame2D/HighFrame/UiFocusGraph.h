@@ -0,0 +1,125 @@
+﻿//---------------------------------------------------------------
+// File: UiFocusGraph.h
+// Proj: HycFrame2D
+// Info: シーン毎のボタン選択移動グラフ
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include "HFCommon.h"
+#include <unordered_map>
+#include <vector>
+
+constexpr int NULL_FOCUS = -1;
+
+#define FOCUS_CELL_SIZE         (128.f)
+// more new buttons than this in one frame rebuild the whole graph
+#define FOCUS_PATCH_LIMIT       (32)
+
+struct FOCUS_NODE
+{
+    class UiObject* Ui;
+    class UBtnMapComponent* BtnMap;
+    Float2 Position;
+    int Neighbor[4];
+    // the score of an auto neighbour, named ones don't have one
+    float Score[4];
+    bool Named[4];
+};
+
+struct FOCUS_GRAPH_STATISTICS
+{
+    unsigned int FullBuilds;
+    unsigned int PatchedBuilds;
+    // how many button pairs the nearest searches have scored
+    unsigned long long ScoredPairs;
+};
+
+class UiFocusGraph
+{
+public:
+    UiFocusGraph();
+    ~UiFocusGraph();
+
+    void MarkGraphDirty();
+
+    bool IsGraphDirty() const;
+
+    void AddFocusNode(class UiObject* _ui);
+
+    void RemoveFocusNode(class UiObject* _ui);
+
+    // a full build when the graph is dirty, otherwise only the
+    // buttons added or removed since the last frame are patched in
+    void UpdateFocusGraph(class SceneNode* _scene,
+        std::vector<class UiObject*>* _uiArray);
+
+    void BuildFocusGraph(class SceneNode* _scene,
+        std::vector<class UiObject*>* _uiArray);
+
+    void ClearFocusGraph();
+
+    void AdvanceFocusFrame();
+
+    bool MoveFocus(int _from, int _direction);
+
+    int GetNeighbor(int _from, int _direction) const;
+
+    const FOCUS_NODE* GetFocusNode(int _index) const;
+
+    unsigned int GetNodeCount() const;
+
+    const FOCUS_GRAPH_STATISTICS& GetStatistics() const;
+
+private:
+    void PatchFocusGraph(class SceneNode* _scene);
+
+    int PlaceFocusNode(class UiObject* _ui,
+        class UBtnMapComponent* _ubmc);
+
+    void ResolveNamedNeighbor(class SceneNode* _scene, int _index,
+        int _direction);
+
+    void SyncSurroundBtns(int _index);
+
+    int FindNearestInDirection(int _from, int _direction,
+        float* _score);
+
+    void ScoreCellNodes(int _from, int _direction, int _x, int _y,
+        int* _nearest, float* _bestScore);
+
+    float GetFocusScore(int _from, int _to, int _direction) const;
+
+    long long MakeCellKey(int _x, int _y) const;
+
+    int ToCellIndex(float _value) const;
+
+private:
+    std::vector<FOCUS_NODE> mNodeArray;
+
+    std::vector<unsigned long long> mFocusFrameArray;
+
+    std::unordered_map<long long, std::vector<int>> mCellMap;
+
+    int mCellMinX;
+
+    int mCellMinY;
+
+    int mCellMaxX;
+
+    int mCellMaxY;
+
+    std::vector<int> mFreeSlotArray;
+
+    std::vector<class UiObject*> mAddedUiArray;
+
+    std::vector<int> mRemovedSlotArray;
+
+    FOCUS_GRAPH_STATISTICS mStatistics;
+
+    unsigned long long mFocusFrame;
+
+    bool mGraphDirtyFlg;
+};
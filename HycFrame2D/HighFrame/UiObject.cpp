@@ -12,19 +12,22 @@
 #include "UComponent.h"
 #include "USpriteComponent.h"
 #include "UTextComponent.h"
+#include "Telemetry.h"
 
 UiObject::UiObject(std::string _name,
     class SceneNode* _scene, int _order) :
-    Object(_name, _scene, STATUS::NEED_INIT), mUCompMap({}),
-    mUCompArray({}), mUiUpdateOrder(_order),
-    mChildrenArray({}), mChildrenMap({}),
+    Object(_name, _scene, STATUS::NEED_INIT), mUCompMap(),
+    mUCompArray({}), mUpdateCompArray({}),
+    mUpdateListDirty(true), mUiUpdateOrder(_order),
+    mChildrenArray({}), mChildrenMap(),
     mParentUiObject(nullptr), mSpriteCompArray({}),
     mTextCompArray({})
 {
-    mUCompMap.clear();
+    mUCompMap.Clear();
     mUCompArray.clear();
+    mUpdateCompArray.clear();
     mChildrenArray.clear();
-    mChildrenMap.clear();
+    mChildrenMap.Clear();
     mSpriteCompArray.clear();
     mTextCompArray.clear();
 }
@@ -34,16 +37,18 @@ UiObject::~UiObject()
 
 }
 
-UComponent* UiObject::GetUComponent(std::string _name)
+UComponent* UiObject::GetUComponent(StringID _name)
 {
-    if (mUCompMap.find(_name) == mUCompMap.end())
+    UComponent** found = mUCompMap.Find(_name);
+    if (!found)
     {
         P_LOG(LOG_MESSAGE,
-            "cannot find this Ucomponent : [ %s ]\n", _name.c_str());
+            "cannot find this Ucomponent : [ %s ]\n",
+            _name.GetDebugString());
         return nullptr;
     }
 
-    return mUCompMap[_name];
+    return *found;
 }
 
 void UiObject::AddUComponent(UComponent* _comp)
@@ -65,8 +70,8 @@ void UiObject::AddUComponent(UComponent* _comp)
         mUCompArray.push_back(_comp);
     }
 
-    mUCompMap.insert(std::make_pair(
-        _comp->GetComponentName(), _comp));
+    mUCompMap.Insert(_comp->GetComponentNameID(), _comp);
+    mUpdateListDirty = true;
 
     if (_comp->GetComponentName().find("sprite", 0) !=
         _comp->GetComponentName().npos)
@@ -136,13 +141,29 @@ void UiObject::UpdateComponents(float _deltatime)
 {
     if (IsObjectActive() == STATUS::ACTIVE)
     {
-        for (auto& comp : mUCompArray)
+        if (mUpdateListDirty)
+        {
+            mUpdateCompArray.clear();
+            for (auto& comp : mUCompArray)
+            {
+                if (comp->IsCompNeedUpdate())
+                {
+                    mUpdateCompArray.push_back(comp);
+                }
+            }
+            mUpdateListDirty = false;
+        }
+
+        unsigned int updateNum = 0;
+        for (auto& comp : mUpdateCompArray)
         {
             if (comp->IsCompActive() == STATUS::ACTIVE)
             {
                 comp->CompUpdate(_deltatime);
+                ++updateNum;
             }
         }
+        TELEMETRY_ADD(COMP_UPDATES, updateNum);
     }
 }
 
@@ -156,13 +177,17 @@ void UiObject::Destory()
         mUCompArray.pop_back();
     }
 
-    mUCompMap.clear();
+    mUCompMap.Clear();
+
+    mUpdateCompArray.clear();
+
+    mUpdateListDirty = true;
 
     mSpriteCompArray.clear();
 
     mTextCompArray.clear();
 
-    mChildrenMap.clear();
+    mChildrenMap.Clear();
 
     mChildrenArray.clear();
 }
@@ -173,8 +198,7 @@ void UiObject::AddChild(UiObject* _obj)
 
     mChildrenArray.push_back(_obj);
 
-    mChildrenMap.insert(std::make_pair(_obj->GetObjectName(),
-        _obj));
+    mChildrenMap.Insert(_obj->GetObjectNameID(), _obj);
 
     GetSceneNodePtr()->AddUiObject(_obj);
 }
@@ -189,24 +213,26 @@ void UiObject::ClearParent()
     mParentUiObject = nullptr;
 }
 
-void UiObject::ClearChild(std::string _name)
+void UiObject::ClearChild(StringID _name)
 {
-    if (mChildrenMap.find(_name) == mChildrenMap.end())
+    UiObject** found = mChildrenMap.Find(_name);
+    if (!found)
     {
         P_LOG(LOG_WARNING,
-            "cannot find this child : [ %s ]\n", _name.c_str());
+            "cannot find this child : [ %s ]\n",
+            _name.GetDebugString());
         return;
     }
 
-    if (mChildrenMap[_name]->GetChildrenArray()->size())
+    if ((*found)->GetChildrenArray()->size())
     {
-        mChildrenMap[_name]->ClearChildren();
+        (*found)->ClearChildren();
     }
 
     for (auto child = mChildrenArray.begin();
         child != mChildrenArray.end(); child++)
     {
-        if ((*child)->GetObjectName() == _name)
+        if ((*child)->GetObjectNameID() == _name)
         {
             (*child)->SetObjectActive(STATUS::PAUSE);
             mChildrenArray.erase(child);
@@ -214,7 +240,7 @@ void UiObject::ClearChild(std::string _name)
         }
     }
 
-    mChildrenMap.erase(_name);
+    mChildrenMap.Erase(_name);
 }
 
 void UiObject::ClearChildren()
@@ -230,19 +256,21 @@ void UiObject::ClearChildren()
 
     mChildrenArray.clear();
 
-    mChildrenMap.clear();
+    mChildrenMap.Clear();
 }
 
-UiObject* UiObject::GetChild(std::string _name)
+UiObject* UiObject::GetChild(StringID _name)
 {
-    if (mChildrenMap.find(_name) == mChildrenMap.end())
+    UiObject** found = mChildrenMap.Find(_name);
+    if (!found)
     {
         P_LOG(LOG_WARNING,
-            "cannot find this child : [ %s ]\n", _name.c_str());
+            "cannot find this child : [ %s ]\n",
+            _name.GetDebugString());
         return nullptr;
     }
 
-    return mChildrenMap[_name];
+    return *found;
 }
 
 std::vector<UiObject*>* UiObject::GetChildrenArray()
@@ -283,3 +311,19 @@ void UiObject::Draw()
         }
     }
 }
+
+void UiObject::MarkUpdateListDirty()
+{
+    mUpdateListDirty = true;
+}
+
+void UiObject::SetObjectActive(STATUS _active)
+{
+    STATUS before = IsObjectActive();
+    Object::SetObjectActive(_active);
+
+    if (before != _active && GetSceneNodePtr())
+    {
+        GetSceneNodePtr()->MarkUiDrawDirty();
+    }
+}
\ No newline at end of file
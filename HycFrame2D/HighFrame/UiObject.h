@@ -10,6 +10,7 @@
 #pragma once
 
 #include "Object.h"
+#include "FlatIDMap.h"
 #include <vector>
 #include <unordered_map>
 
@@ -21,38 +22,36 @@ public:
         class SceneNode* _scene, int _order);
     virtual ~UiObject();
 
-    class UComponent* GetUComponent(std::string _name);
+    class UComponent* GetUComponent(StringID _name);
 
     template <typename T>
     inline T* GetUComponent(COMP_TYPE _type)
     {
-        static std::string compName = "";
-        compName = GetObjectName();
         switch (_type)
         {
         case COMP_TYPE::UTRANSFORM:
-            compName += "-transform";
-            return (T*)(GetUComponent(compName));
+            return (T*)(GetUComponent(
+                GetObjectNameID().Append("-transform")));
 
         case COMP_TYPE::UINPUT:
-            compName += "-input";
-            return (T*)(GetUComponent(compName));
+            return (T*)(GetUComponent(
+                GetObjectNameID().Append("-input")));
 
         case COMP_TYPE::UTEXT:
-            compName += "-text";
-            return (T*)(GetUComponent(compName));
+            return (T*)(GetUComponent(
+                GetObjectNameID().Append("-text")));
 
         case COMP_TYPE::USPRITE:
-            compName += "-sprite";
-            return (T*)(GetUComponent(compName));
+            return (T*)(GetUComponent(
+                GetObjectNameID().Append("-sprite")));
 
         case COMP_TYPE::UBTNMAP:
-            compName += "-btnmap";
-            return (T*)(GetUComponent(compName));
+            return (T*)(GetUComponent(
+                GetObjectNameID().Append("-btnmap")));
 
         case COMP_TYPE::UINTERACT:
-            compName += "-interaction";
-            return (T*)(GetUComponent(compName));
+            return (T*)(GetUComponent(
+                GetObjectNameID().Append("-interaction")));
 
         default:
             P_LOG(LOG_ERROR,
@@ -71,11 +70,11 @@ public:
 
     void ClearParent();
 
-    void ClearChild(std::string _name);
+    void ClearChild(StringID _name);
 
     void ClearChildren();
 
-    UiObject* GetChild(std::string _name);
+    UiObject* GetChild(StringID _name);
 
     std::vector<UiObject*>* GetChildrenArray();
 
@@ -87,6 +86,10 @@ public:
 
     void Draw();
 
+    void MarkUpdateListDirty();
+
+    virtual void SetObjectActive(STATUS _active);
+
 public:
     virtual void Init();
 
@@ -97,10 +100,14 @@ public:
     virtual void Destory();
 
 private:
-    std::unordered_map<std::string, class UComponent*> mUCompMap;
+    FlatIDMap<class UComponent*> mUCompMap;
 
     std::vector<class UComponent*> mUCompArray;
 
+    std::vector<class UComponent*> mUpdateCompArray;
+
+    bool mUpdateListDirty;
+
     std::vector<class USpriteComponent*> mSpriteCompArray;
 
     std::vector<class UTextComponent*> mTextCompArray;
@@ -109,7 +116,7 @@ private:
 
     UiObject* mParentUiObject;
 
-    std::unordered_map<std::string, UiObject*> mChildrenMap;
+    FlatIDMap<UiObject*> mChildrenMap;
 
     std::vector<UiObject*> mChildrenArray;
 };
@@ -2,6 +2,8 @@
 
 #include "SceneManager.h"
 #include "SceneNode.h"
+#include "EventBus.h"
+#include "UiFocusGraph.h"
 #include "ObjectFactory.h"
 #include "UiObject.h"
 #include "UBtnMapComponent.h"
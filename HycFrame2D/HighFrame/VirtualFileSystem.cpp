@@ -0,0 +1,324 @@
+﻿//---------------------------------------------------------------
+// File: VirtualFileSystem.cpp
+// Proj: HycFrame2D
+// Info: rom:/パスを解決する仮想ファイルシステム
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "VirtualFileSystem.h"
+#include "PrintLog.h"
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // !_WIN32
+
+namespace
+{
+    bool MapWholeFile(const std::string& _file, void** _fileHandle,
+        void** _mappingHandle, const unsigned char** _view,
+        size_t* _size)
+    {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(_file.c_str(), GENERIC_READ,
+            FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        LARGE_INTEGER size = {};
+        HANDLE mapping = nullptr;
+        if (GetFileSizeEx(file, &size) && size.QuadPart)
+        {
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY,
+                0, 0, nullptr);
+        }
+        if (!mapping)
+        {
+            CloseHandle(file);
+            return false;
+        }
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        *_fileHandle = file;
+        *_mappingHandle = mapping;
+        *_view = (const unsigned char*)view;
+        *_size = (size_t)size.QuadPart;
+        return true;
+#else
+        int file = open(_file.c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            return false;
+        }
+        struct stat info = {};
+        if (fstat(file, &info) || !info.st_size)
+        {
+            close(file);
+            return false;
+        }
+        void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ,
+            MAP_PRIVATE, file, 0);
+        close(file);
+        if (view == MAP_FAILED)
+        {
+            return false;
+        }
+
+        *_fileHandle = nullptr;
+        *_mappingHandle = nullptr;
+        *_view = (const unsigned char*)view;
+        *_size = (size_t)info.st_size;
+        return true;
+#endif // _WIN32
+    }
+
+    // every platform only needs some of the handles it is given
+    void UnmapWholeFile([[maybe_unused]] void* _fileHandle,
+        [[maybe_unused]] void* _mappingHandle,
+        const unsigned char* _view, [[maybe_unused]] size_t _size)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(_view);
+        CloseHandle((HANDLE)_mappingHandle);
+        CloseHandle((HANDLE)_fileHandle);
+#else
+        munmap((void*)_view, _size);
+#endif // _WIN32
+    }
+}
+
+VirtualFileSystem::VirtualFileSystem() :
+    mArchiveArray({}), mResolvedPathMap(), mArchiveReads(0),
+    mLooseReads(0), mFailedReads(0), mDecompressedBytes(0)
+{
+    mArchiveArray.clear();
+    mResolvedPathMap.clear();
+}
+
+VirtualFileSystem::~VirtualFileSystem()
+{
+    UnmountAllArchives();
+}
+
+bool VirtualFileSystem::MountArchive(std::string _file)
+{
+    MOUNTED_ARCHIVE* mounted = new MOUNTED_ARCHIVE();
+    mounted->File = _file;
+    if (!MapWholeFile(_file, &mounted->FileHandle,
+        &mounted->MappingHandle, &mounted->View, &mounted->Size))
+    {
+        P_LOG(LOG_MESSAGE,
+            "no asset archive [ %s ], using loose files\n",
+            _file.c_str());
+        delete mounted;
+        return false;
+    }
+
+    if (!mounted->Archive.OpenArchive(mounted->View, mounted->Size))
+    {
+        P_LOG(LOG_ERROR, "invalid asset archive : [ %s ]\n",
+            _file.c_str());
+        UnmapWholeFile(mounted->FileHandle, mounted->MappingHandle,
+            mounted->View, mounted->Size);
+        delete mounted;
+        return false;
+    }
+
+    // archives mounted later override the earlier ones
+    mArchiveArray.insert(mArchiveArray.begin(), mounted);
+    P_LOG(LOG_MESSAGE, "mounted asset archive [ %s ] with %u entries\n",
+        _file.c_str(), mounted->Archive.GetEntryCount());
+    return true;
+}
+
+void VirtualFileSystem::UnmountAllArchives()
+{
+    for (auto mounted : mArchiveArray)
+    {
+        mounted->Archive.CloseArchive();
+        UnmapWholeFile(mounted->FileHandle, mounted->MappingHandle,
+            mounted->View, mounted->Size);
+        delete mounted;
+    }
+    mArchiveArray.clear();
+}
+
+StringID VirtualFileSystem::ResolveAssetPath(const std::string& _path)
+{
+    StringID pathID = InternStringID(MakeAssetPathKey(_path));
+
+    // an id read can still fall back to the loose file it came from
+    std::lock_guard<std::mutex> guard(mResolvedPathLock);
+    mResolvedPathMap.insert(std::make_pair(pathID.GetValue(), _path));
+
+    return pathID;
+}
+
+bool VirtualFileSystem::ReadAsset(const std::string& _path,
+    ASSET_DATA* _out)
+{
+    return ReadAssetEntry(MakeAssetPathID(_path), &_path, _out);
+}
+
+bool VirtualFileSystem::ReadAssetByID(StringID _pathID,
+    ASSET_DATA* _out)
+{
+    return ReadAssetEntry(_pathID.GetValue(), nullptr, _out);
+}
+
+bool VirtualFileSystem::ReadAssetEntry(unsigned long long _pathID,
+    const std::string* _path, ASSET_DATA* _out)
+{
+    _out->Data = nullptr;
+    _out->Size = 0;
+    _out->Storage.clear();
+
+    for (auto mounted : mArchiveArray)
+    {
+        const ARCHIVE_ENTRY* entry =
+            mounted->Archive.FindEntry(_pathID);
+        if (!entry)
+        {
+            continue;
+        }
+
+        const unsigned char* stored =
+            mounted->Archive.GetEntryData(entry);
+        if (!(entry->Flags & ASSET_ENTRY_COMPRESSED))
+        {
+            // uncompressed entries are handed out straight from the
+            // mapped view without any copy
+            _out->Data = stored;
+            _out->Size = (size_t)entry->RawSize;
+            ++mArchiveReads;
+            return true;
+        }
+
+        _out->Storage.resize((size_t)entry->RawSize);
+        if (!DecompressAssetData(stored, (size_t)entry->StoredSize,
+            _out->Storage.data(), _out->Storage.size()))
+        {
+            P_LOG(LOG_ERROR, "corrupted archive entry : [ %s ]\n",
+                _path ? _path->c_str() :
+                GetResolvedPath(_pathID).c_str());
+            _out->Storage.clear();
+            ++mFailedReads;
+            return false;
+        }
+        _out->Data = _out->Storage.data();
+        _out->Size = _out->Storage.size();
+        mDecompressedBytes += entry->RawSize;
+        ++mArchiveReads;
+        return true;
+    }
+
+    std::string loose = _path ? *_path : GetResolvedPath(_pathID);
+    if (loose != "" && ReadLooseFile(loose, _out))
+    {
+        ++mLooseReads;
+        return true;
+    }
+
+    ++mFailedReads;
+    return false;
+}
+
+bool VirtualFileSystem::HasAssetByID(StringID _pathID)
+{
+    for (auto mounted : mArchiveArray)
+    {
+        if (mounted->Archive.FindEntry(_pathID.GetValue()))
+        {
+            return true;
+        }
+    }
+
+    std::string loose = GetResolvedPath(_pathID.GetValue());
+    if (loose == "")
+    {
+        return false;
+    }
+    std::ifstream file(MakeLooseAssetPath(loose), std::ios::binary);
+    return file.is_open();
+}
+
+bool VirtualFileSystem::HasAsset(const std::string& _path)
+{
+    unsigned long long pathID = MakeAssetPathID(_path);
+    for (auto mounted : mArchiveArray)
+    {
+        if (mounted->Archive.FindEntry(pathID))
+        {
+            return true;
+        }
+    }
+
+    std::ifstream file(MakeLooseAssetPath(_path), std::ios::binary);
+    return file.is_open();
+}
+
+std::string VirtualFileSystem::GetResolvedPath(
+    unsigned long long _pathID)
+{
+    std::lock_guard<std::mutex> guard(mResolvedPathLock);
+    auto found = mResolvedPathMap.find(_pathID);
+    if (found == mResolvedPathMap.end())
+    {
+        return "";
+    }
+
+    return found->second;
+}
+
+VFS_STATISTICS VirtualFileSystem::GetStatistics() const
+{
+    VFS_STATISTICS stats = {};
+    stats.ArchiveReads = mArchiveReads;
+    stats.LooseReads = mLooseReads;
+    stats.FailedReads = mFailedReads;
+    stats.DecompressedBytes = mDecompressedBytes;
+
+    return stats;
+}
+
+bool VirtualFileSystem::ReadLooseFile(const std::string& _path,
+    ASSET_DATA* _out)
+{
+    std::ifstream file(MakeLooseAssetPath(_path),
+        std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    _out->Storage.resize((size_t)size);
+    if (size && !file.read((char*)_out->Storage.data(), size))
+    {
+        _out->Storage.clear();
+        return false;
+    }
+    _out->Data = _out->Storage.data();
+    _out->Size = _out->Storage.size();
+
+    return true;
+}
+
+VirtualFileSystem* GetVirtualFileSystem()
+{
+    static VirtualFileSystem g_VirtualFileSystem;
+    return &g_VirtualFileSystem;
+}
@@ -0,0 +1,93 @@
+﻿//---------------------------------------------------------------
+// File: VirtualFileSystem.h
+// Proj: HycFrame2D
+// Info: rom:/パスを解決する仮想ファイルシステム
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include "AssetArchive.h"
+#include "StringID.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct ASSET_DATA
+{
+    const unsigned char* Data = nullptr;
+    size_t Size = 0;
+    std::vector<unsigned char> Storage = {};
+};
+
+struct VFS_STATISTICS
+{
+    unsigned int ArchiveReads;
+    unsigned int LooseReads;
+    unsigned int FailedReads;
+    unsigned long long DecompressedBytes;
+};
+
+class VirtualFileSystem
+{
+public:
+    VirtualFileSystem();
+    ~VirtualFileSystem();
+
+    bool MountArchive(std::string _file);
+
+    void UnmountAllArchives();
+
+    StringID ResolveAssetPath(const std::string& _path);
+
+    bool ReadAsset(const std::string& _path, ASSET_DATA* _out);
+
+    bool HasAsset(const std::string& _path);
+
+    // hot callers resolve a path once and keep the id, the string
+    // versions above hash the whole path on every call
+    bool ReadAssetByID(StringID _pathID, ASSET_DATA* _out);
+
+    bool HasAssetByID(StringID _pathID);
+
+    VFS_STATISTICS GetStatistics() const;
+
+private:
+    bool ReadAssetEntry(unsigned long long _pathID,
+        const std::string* _path, ASSET_DATA* _out);
+
+    bool ReadLooseFile(const std::string& _path, ASSET_DATA* _out);
+
+    std::string GetResolvedPath(unsigned long long _pathID);
+
+private:
+    struct MOUNTED_ARCHIVE
+    {
+        std::string File;
+        void* FileHandle;
+        void* MappingHandle;
+        const unsigned char* View;
+        size_t Size;
+        AssetArchive Archive;
+    };
+
+    std::vector<MOUNTED_ARCHIVE*> mArchiveArray;
+
+    std::unordered_map<unsigned long long, std::string>
+        mResolvedPathMap;
+
+    std::mutex mResolvedPathLock;
+
+    std::atomic<unsigned int> mArchiveReads;
+
+    std::atomic<unsigned int> mLooseReads;
+
+    std::atomic<unsigned int> mFailedReads;
+
+    std::atomic<unsigned long long> mDecompressedBytes;
+};
+
+VirtualFileSystem* GetVirtualFileSystem();
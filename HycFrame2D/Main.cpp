@@ -19,7 +19,7 @@ extern "C" int WinMain(
     _In_ int iCmdShow
 )
 {
-    if (g_RootSystem.StartUp(hInstance, iCmdShow))
+    if (g_RootSystem.StartUp(hInstance, iCmdShow, szCmdLine))
     {
         g_RootSystem.RunGameLoop();
     }
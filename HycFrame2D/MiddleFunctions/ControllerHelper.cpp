@@ -1,50 +1,274 @@
 #include "ControllerHelper.h"
+#include "JsonHelper.h"
 #include <iostream>
 
+namespace
+{
+    class DeviceInputSampler :
+        public InputSampler
+    {
+    public:
+        virtual void SampleInput(INPUT_SAMPLE* _out)
+        {
+            ClearInputSample(_out);
+            InputInterface::PollDevices();
+
+            // every key is read exactly once per sample here, gameplay
+            // code only ever sees the packed snapshot
+            for (UINT code = 0; code <= GP_UPLEFTDIRBTN; code++)
+            {
+                if (InputInterface::IsKeyDownInSingle(code))
+                {
+                    SetInputSampleKey(_out, code, true);
+                }
+            }
+
+            STICK_OFFSET ls = InputInterface::LeftStickOffset();
+            STICK_OFFSET rs = InputInterface::RightStickOffset();
+            _out->LeftStick[0] = (float)ls.x / 1000.f;
+            _out->LeftStick[1] = -(float)ls.y / 1000.f;
+            _out->RightStick[0] = (float)rs.x / 1000.f;
+            _out->RightStick[1] = (float)rs.y / 1000.f;
+        }
+    };
+
+    struct KEY_NAME
+    {
+        const char* Name;
+        UINT Code;
+    };
+
+#define KEY_NAME_ITEM(_code) { #_code, _code }
+
+    const KEY_NAME g_KeyNameTable[] =
+    {
+        KEY_NAME_ITEM(KB_ESCAPE), KEY_NAME_ITEM(KB_RETURN),
+        KEY_NAME_ITEM(KB_SPACE), KEY_NAME_ITEM(KB_BACK),
+        KEY_NAME_ITEM(KB_TAB), KEY_NAME_ITEM(KB_LSHIFT),
+        KEY_NAME_ITEM(KB_RSHIFT), KEY_NAME_ITEM(KB_LCONTROL),
+        KEY_NAME_ITEM(KB_UP), KEY_NAME_ITEM(KB_DOWN),
+        KEY_NAME_ITEM(KB_LEFT), KEY_NAME_ITEM(KB_RIGHT),
+        KEY_NAME_ITEM(KB_W), KEY_NAME_ITEM(KB_A),
+        KEY_NAME_ITEM(KB_S), KEY_NAME_ITEM(KB_D),
+        KEY_NAME_ITEM(KB_Q), KEY_NAME_ITEM(KB_E),
+        KEY_NAME_ITEM(KB_Z), KEY_NAME_ITEM(KB_X),
+        KEY_NAME_ITEM(KB_C), KEY_NAME_ITEM(KB_J),
+        KEY_NAME_ITEM(KB_K), KEY_NAME_ITEM(KB_L),
+        KEY_NAME_ITEM(M_LEFTBTN), KEY_NAME_ITEM(M_RIGHTBTN),
+        KEY_NAME_ITEM(M_MIDDLEBTN),
+        KEY_NAME_ITEM(GP_LEFTBTN), KEY_NAME_ITEM(GP_BOTTOMBTN),
+        KEY_NAME_ITEM(GP_RIGHTBTN), KEY_NAME_ITEM(GP_TOPBTN),
+        KEY_NAME_ITEM(GP_LEFTFORESHDBTN),
+        KEY_NAME_ITEM(GP_RIGHTFORESHDBTN),
+        KEY_NAME_ITEM(GP_LEFTBACKSHDBTN),
+        KEY_NAME_ITEM(GP_RIGHTBACKSHDBTN),
+        KEY_NAME_ITEM(GP_LEFTMENUBTN), KEY_NAME_ITEM(GP_RIGHTMENUBTN),
+        KEY_NAME_ITEM(GP_LEFTSTICKBTN),
+        KEY_NAME_ITEM(GP_RIGHTSTICKBTN),
+        KEY_NAME_ITEM(GP_UPDIRBTN), KEY_NAME_ITEM(GP_DOWNDIRBTN),
+        KEY_NAME_ITEM(GP_LEFTDIRBTN), KEY_NAME_ITEM(GP_RIGHTDIRBTN),
+    };
+
+#undef KEY_NAME_ITEM
+
+    bool FindKeyCode(const rapidjson::Value& _key, UINT* _out)
+    {
+        if (_key.IsUint())
+        {
+            *_out = _key.GetUint();
+            return true;
+        }
+        if (!_key.IsString())
+        {
+            return false;
+        }
+
+        std::string name = _key.GetString();
+        for (auto& item : g_KeyNameTable)
+        {
+            if (name == item.Name)
+            {
+                *_out = item.Code;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    DeviceInputSampler g_DeviceSampler = {};
+
+    InputSamplingThread g_SamplingThread = {};
+
+    InputSampler* g_DefaultSampler = &g_DeviceSampler;
+
+    InputSampler* g_ActiveSampler = &g_DeviceSampler;
+
+    InputSystem g_InputSystem = {};
+}
+
 void InitController()
 {
     if (!InputInterface::StartUp())
     {
         P_LOG(LOG_ERROR, "failed to start up input system\n");
     }
+    g_InputSystem.ResetInputSystem();
 }
 
 void UninitController()
 {
+    StopControllerSampling();
     InputInterface::CleanAndStop();
+    g_InputSystem.GetActionMap()->ClearActionMap();
 }
 
 void UpdateController()
 {
-    InputInterface::PollDevices();
+    g_InputSystem.CaptureSnapshot(g_ActiveSampler);
+}
+
+bool StartControllerSampling(unsigned int rateHz)
+{
+    if (!g_SamplingThread.StartSampling(&g_DeviceSampler, rateHz))
+    {
+        P_LOG(LOG_WARNING, "failed to start input sampling thread\n");
+        return false;
+    }
+
+    if (g_ActiveSampler == g_DefaultSampler)
+    {
+        g_ActiveSampler = &g_SamplingThread;
+    }
+    g_DefaultSampler = &g_SamplingThread;
+    return true;
+}
+
+void StopControllerSampling()
+{
+    g_SamplingThread.StopSampling();
+
+    if (g_ActiveSampler == g_DefaultSampler)
+    {
+        g_ActiveSampler = &g_DeviceSampler;
+    }
+    g_DefaultSampler = &g_DeviceSampler;
 }
 
 bool GetControllerPress(UINT button)
 {
-    return InputInterface::IsKeyDownInSingle(button);
+    return g_InputSystem.GetSnapshot()->IsPressed(button);
 }
 
 bool GetControllerTrigger(UINT button)
 {
-    return InputInterface::IsKeyPushedInSingle(button);
+    return g_InputSystem.GetSnapshot()->IsTriggered(button);
+}
+
+bool GetControllerRelease(UINT button)
+{
+    return g_InputSystem.GetSnapshot()->IsReleased(button);
+}
+
+void SetControllerInputSampler(InputSampler* sampler)
+{
+    g_ActiveSampler = sampler ? sampler : g_DefaultSampler;
+}
+
+const INPUT_SNAPSHOT* GetControllerSnapshot()
+{
+    return g_InputSystem.GetSnapshot();
+}
+
+const INPUT_SAMPLE* GetControllerSample()
+{
+    return g_InputSystem.GetLastSample();
+}
+
+bool LoadControllerActionMap(std::string path)
+{
+    JsonFile actionFile = {};
+    LoadJsonFile(&actionFile, path);
+    if (actionFile.HasParseError())
+    {
+        P_LOG(LOG_ERROR,
+            "failed to parse action map [ %s ] with error [ %d ]\n",
+            path.c_str(), actionFile.GetParseError());
+        return false;
+    }
+    if (!actionFile.HasMember("action") ||
+        !actionFile["action"].IsArray())
+    {
+        P_LOG(LOG_ERROR, "action map doesn't have any action\n");
+        return false;
+    }
+
+    InputActionMap* actionMap = g_InputSystem.GetActionMap();
+    actionMap->ClearActionMap();
+    for (auto& action : actionFile["action"].GetArray())
+    {
+        if (!action.HasMember("name") || !action["name"].IsString())
+        {
+            continue;
+        }
+        std::string name = action["name"].GetString();
+        actionMap->RegisterAction(InternStringID(name));
+
+        if (!action.HasMember("keys") || !action["keys"].IsArray())
+        {
+            continue;
+        }
+        for (auto& key : action["keys"].GetArray())
+        {
+            UINT code = 0;
+            if (!FindKeyCode(key, &code))
+            {
+                P_LOG(LOG_WARNING,
+                    "unknown key in action : [ %s ]\n",
+                    name.c_str());
+                continue;
+            }
+            actionMap->BindKey(name, code);
+        }
+    }
+
+    return true;
+}
+
+bool GetActionPress(StringID action)
+{
+    return g_InputSystem.GetSnapshot()->IsActionPressed(
+        g_InputSystem.GetActionMap()->GetActionIndex(action));
+}
+
+bool GetActionTrigger(StringID action)
+{
+    return g_InputSystem.GetSnapshot()->IsActionTriggered(
+        g_InputSystem.GetActionMap()->GetActionIndex(action));
+}
+
+bool GetActionRelease(StringID action)
+{
+    return g_InputSystem.GetSnapshot()->IsActionReleased(
+        g_InputSystem.GetActionMap()->GetActionIndex(action));
 }
 
 Float2 GetControllerLeftStick()
 {
+    const INPUT_SNAPSHOT* snapshot = g_InputSystem.GetSnapshot();
     Float2 stick = { 0.f,0.f };
-    STICK_OFFSET ls = InputInterface::LeftStickOffset();
-    stick.x = (float)ls.x / 1000.f;
-    stick.y = -(float)ls.y / 1000.f;
+    stick.x = snapshot->GetLeftStickX();
+    stick.y = snapshot->GetLeftStickY();
 
     return stick;
 }
 
 Float2 GetControllerRightStick()
 {
+    const INPUT_SNAPSHOT* snapshot = g_InputSystem.GetSnapshot();
     Float2 stick = { 0.f,0.f };
-    STICK_OFFSET ls = InputInterface::RightStickOffset();
-    stick.x = (float)ls.x / 1000.f;
-    stick.y = (float)ls.y / 1000.f;
+    stick.x = snapshot->GetRightStickX();
+    stick.y = snapshot->GetRightStickY();
 
     return stick;
 }
@@ -2,6 +2,8 @@
 
 #include "main.h"
 #include "ID_Interface.h"
+#include "InputSnapshot.h"
+#include "InputSamplingThread.h"
 
 void InitController();
 
@@ -9,10 +11,30 @@ void UninitController();
 
 void UpdateController();
 
+bool StartControllerSampling(unsigned int rateHz);
+
+void StopControllerSampling();
+
 bool GetControllerPress(UINT button);
 
 bool GetControllerTrigger(UINT button);
 
+bool GetControllerRelease(UINT button);
+
+void SetControllerInputSampler(InputSampler* sampler);
+
+const INPUT_SNAPSHOT* GetControllerSnapshot();
+
+const INPUT_SAMPLE* GetControllerSample();
+
+bool LoadControllerActionMap(std::string path);
+
+bool GetActionPress(StringID action);
+
+bool GetActionTrigger(StringID action);
+
+bool GetActionRelease(StringID action);
+
 Float2 GetControllerLeftStick();
 
 Float2 GetControllerRightStick();
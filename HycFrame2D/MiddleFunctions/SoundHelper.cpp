@@ -1,66 +1,80 @@
 #include "SoundHelper.h"
 #include <unordered_map>
+#include <vector>
+#include <mutex>
 #include <Windows.h>
+#include "VirtualFileSystem.h"
+#include "AudioMixer.h"
+#include "SoundCodec.h"
+
+#define AUDIO_STREAM_BUFFER_NUM (3)
 
 static IXAudio2* gp_XAudio2 = nullptr;									// XAudio2���֥������ȤؤΥ��󥿩`�ե�����
 static IXAudio2MasteringVoice* gp_MasteringVoice = nullptr;
-std::unordered_map<std::string, DWORD> g_SoundLengthPool;
-std::unordered_map<std::string, BYTE*> g_SoundDataPool;
-std::unordered_map<std::string, SOUND_HANDLE> g_SoundPool;
+static IXAudio2SourceVoice* gp_StreamVoice = nullptr;
+static AudioMixer* gp_AudioMixer = nullptr;
+static float g_StreamBuffer[AUDIO_STREAM_BUFFER_NUM]
+    [AUDIO_MIX_BLOCK_FRAMES * AUDIO_MIX_CHANNELS] = {};
+static unsigned int g_NextStreamBuffer = 0;
+std::unordered_map<std::string, SoundClip*> g_SoundClipPool;
+std::unordered_map<std::string, unsigned int> g_SoundRefPool;
+std::unordered_map<std::string, VOICE_HANDLE> g_SoundVoicePool;
+std::mutex g_SoundPoolLock;
+
+// every sound goes through the engine mixer, xaudio2 only plays the
+// single mixed stream that is refilled whenever a buffer finishes
+void SubmitStreamBuffer()
+{
+    float* buffer = g_StreamBuffer[g_NextStreamBuffer];
+    g_NextStreamBuffer =
+        (g_NextStreamBuffer + 1) % AUDIO_STREAM_BUFFER_NUM;
+    gp_AudioMixer->MixFrames(buffer, AUDIO_MIX_BLOCK_FRAMES);
+
+    XAUDIO2_BUFFER xa2buffer;
+    memset(&xa2buffer, 0, sizeof(XAUDIO2_BUFFER));
+    xa2buffer.AudioBytes = (UINT32)sizeof(g_StreamBuffer[0]);
+    xa2buffer.pAudioData = (const BYTE*)buffer;
+    gp_StreamVoice->SubmitSourceBuffer(&xa2buffer);
+}
+
+class MixerStreamCallback : public IXAudio2VoiceCallback
+{
+public:
+    void STDMETHODCALLTYPE OnVoiceProcessingPassStart(
+        UINT32) override {}
+    void STDMETHODCALLTYPE OnVoiceProcessingPassEnd() override {}
+    void STDMETHODCALLTYPE OnStreamEnd() override {}
+    void STDMETHODCALLTYPE OnBufferStart(void*) override {}
+    void STDMETHODCALLTYPE OnBufferEnd(void*) override
+    {
+        SubmitStreamBuffer();
+    }
+    void STDMETHODCALLTYPE OnLoopEnd(void*) override {}
+    void STDMETHODCALLTYPE OnVoiceError(void*, HRESULT) override {}
+};
+
+static MixerStreamCallback g_StreamCallback;
 
-HRESULT CheckChunk(HANDLE hFile, DWORD format,
+HRESULT CheckChunk(const BYTE* pFile, DWORD fileSize, DWORD format,
     DWORD* pChunkSize, DWORD* pChunkDataPosition)
 {
-    HRESULT hr = S_OK;
-    DWORD dwRead = 0;
     DWORD dwChunkType = 0;
     DWORD dwChunkDataSize = 0;
-    DWORD dwRIFFDataSize = 0;
-    DWORD dwFileType = 0;
-    DWORD dwBytesRead = 0;
     DWORD dwOffset = 0;
 
-    if (SetFilePointer(hFile, 0, NULL, FILE_BEGIN) ==
-        INVALID_SET_FILE_POINTER)
+    while (dwOffset + sizeof(DWORD) * 2 <= fileSize)
     {
-        return HRESULT_FROM_WIN32(GetLastError());
-    }
-
-    while (hr == S_OK)
-    {
-        if (ReadFile(hFile, &dwChunkType, sizeof(DWORD),
-            &dwRead, NULL) == 0)
-        {
-            hr = HRESULT_FROM_WIN32(GetLastError());
-        }
-
-        if (ReadFile(hFile, &dwChunkDataSize, sizeof(DWORD),
-            &dwRead, NULL) == 0)
-        {
-            hr = HRESULT_FROM_WIN32(GetLastError());
-        }
+        memcpy(&dwChunkType, pFile + dwOffset, sizeof(DWORD));
+        memcpy(&dwChunkDataSize, pFile + dwOffset + sizeof(DWORD),
+            sizeof(DWORD));
+        dwOffset += sizeof(DWORD) * 2;
 
-        switch (dwChunkType)
+        // the riff chunk only holds the file type before sub chunks
+        if (dwChunkType == 'FFIR')
         {
-        case 'FFIR':
-            dwRIFFDataSize = dwChunkDataSize;
             dwChunkDataSize = 4;
-            if (ReadFile(hFile, &dwFileType, sizeof(DWORD),
-                &dwRead, NULL) == 0)
-            {
-                hr = HRESULT_FROM_WIN32(GetLastError());
-            }
-            break;
-
-        default:
-            if (SetFilePointer(hFile, dwChunkDataSize, NULL,
-                FILE_CURRENT) == INVALID_SET_FILE_POINTER)
-            {
-                return HRESULT_FROM_WIN32(GetLastError());
-            }
         }
 
-        dwOffset += sizeof(DWORD) * 2;
         if (dwChunkType == format)
         {
             *pChunkSize = dwChunkDataSize;
@@ -70,70 +84,37 @@ HRESULT CheckChunk(HANDLE hFile, DWORD format,
         }
 
         dwOffset += dwChunkDataSize;
-        if (dwBytesRead >= dwRIFFDataSize)
-        {
-            return S_FALSE;
-        }
     }
 
-    return S_OK;
+    return HRESULT_FROM_WIN32(ERROR_NOT_FOUND);
 }
 
-HRESULT ReadChunkData(HANDLE hFile, void* pBuffer,
-    DWORD dwBuffersize, DWORD dwBufferoffset)
+HRESULT ReadChunkData(const BYTE* pFile, DWORD fileSize,
+    void* pBuffer, DWORD dwBuffersize, DWORD dwBufferoffset)
 {
-    DWORD dwRead;
-
-    if (SetFilePointer(hFile, dwBufferoffset, NULL, FILE_BEGIN)
-        == INVALID_SET_FILE_POINTER)
+    if (dwBufferoffset > fileSize ||
+        dwBuffersize > fileSize - dwBufferoffset)
     {
-        return HRESULT_FROM_WIN32(GetLastError());
+        return HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
     }
 
-    if (ReadFile(hFile, pBuffer, dwBuffersize, &dwRead, NULL)
-        == 0)
-    {
-        return HRESULT_FROM_WIN32(GetLastError());
-    }
+    memcpy(pBuffer, pFile + dwBufferoffset, dwBuffersize);
 
     return S_OK;
 }
 
-void SplitByRomSymbolSound(const std::string& s,
-    std::vector<std::string>& v, const std::string& c)
-{
-    v.clear();
-    std::string::size_type pos1 = 0, pos2 = s.find(c);
-    while (std::string::npos != pos2)
-    {
-        v.push_back(s.substr(pos1, pos2 - pos1));
-
-        pos1 = pos2 + c.size();
-        pos2 = s.find(c, pos1);
-    }
-    if (pos1 != s.length())
-        v.push_back(s.substr(pos1));
-}
-
 bool InitSound()
 {
     HRESULT hr;
 
-    hr = CoInitializeEx(NULL, COINIT_MULTITHREADED);
-    if (FAILED(hr))
-    {
-        P_LOG(LOG_ERROR,
-            "failed to init com library in sound\n");
-    }
-
+    // com is initialized once by the root system, this may run on a
+    // startup worker that only joins the multithreaded apartment
     hr = XAudio2Create(&gp_XAudio2, 0);
     if (FAILED(hr))
     {
         P_LOG(LOG_ERROR,
             "failed to create xaudio2 object\n");
 
-        CoUninitialize();
-
         return false;
     }
 
@@ -149,18 +130,63 @@ bool InitSound()
             gp_XAudio2 = nullptr;
         }
 
-        CoUninitialize();
+        return false;
+    }
+
+    WAVEFORMATEX wfx;
+    memset(&wfx, 0, sizeof(WAVEFORMATEX));
+    wfx.wFormatTag = WAVE_FORMAT_IEEE_FLOAT;
+    wfx.nChannels = AUDIO_MIX_CHANNELS;
+    wfx.nSamplesPerSec = AUDIO_MIX_RATE;
+    wfx.wBitsPerSample = 32;
+    wfx.nBlockAlign = wfx.nChannels * wfx.wBitsPerSample / 8;
+    wfx.nAvgBytesPerSec = wfx.nSamplesPerSec * wfx.nBlockAlign;
+
+    hr = gp_XAudio2->CreateSourceVoice(&gp_StreamVoice, &wfx, 0,
+        XAUDIO2_DEFAULT_FREQ_RATIO, &g_StreamCallback);
+    if (FAILED(hr))
+    {
+        P_LOG(LOG_ERROR,
+            "failed to create mixer stream voice\n");
+
+        gp_MasteringVoice->DestroyVoice();
+        gp_MasteringVoice = nullptr;
+        gp_XAudio2->Release();
+        gp_XAudio2 = nullptr;
 
         return false;
     }
 
+    gp_AudioMixer = new AudioMixer();
+    gp_AudioMixer->SetMasterVolume(0.2f);
+    g_NextStreamBuffer = 0;
+    for (int i = 0; i < AUDIO_STREAM_BUFFER_NUM; i++)
+    {
+        SubmitStreamBuffer();
+    }
+    gp_StreamVoice->Start(0);
+
     return true;
 }
 
 void UninitSound()
 {
+    if (!gp_XAudio2)
+    {
+        return;
+    }
+
+    // destroying the stream voice waits for the callback, after that
+    // nothing reads the mixer any more
+    gp_StreamVoice->Stop(0);
+    gp_StreamVoice->DestroyVoice();
+    gp_StreamVoice = nullptr;
+
     ClearSoundPool();
 
+    delete gp_AudioMixer;
+    gp_AudioMixer = nullptr;
+
     gp_MasteringVoice->DestroyVoice();
     gp_MasteringVoice = nullptr;
 
@@ -169,8 +195,6 @@ void UninitSound()
         gp_XAudio2->Release();
         gp_XAudio2 = nullptr;
     }
-
-    CoUninitialize();
 }
 
 void UpdateSound()
@@ -180,263 +204,285 @@ void UpdateSound()
 
 void ClearSoundPool()
 {
-    for (auto& sound : g_SoundPool)
+    std::lock_guard<std::mutex> lock(g_SoundPoolLock);
+    // the pool can be filled before the mixer exists, e.g. by a
+    // startup task or a headless test
+    if (gp_AudioMixer)
     {
-        if (sound.second)
-        {
-            sound.second->Stop(0);
-            sound.second->DestroyVoice();
-        }
+        gp_AudioMixer->StopAllVoices();
     }
-    for (auto& soundData : g_SoundDataPool)
+    for (auto& clip : g_SoundClipPool)
     {
-        if (soundData.second)
-        {
-            delete[] soundData.second;
-        }
+        delete clip.second;
     }
-    g_SoundPool.clear();
-    g_SoundDataPool.clear();
-    g_SoundLengthPool.clear();
+    g_SoundClipPool.clear();
+    g_SoundRefPool.clear();
+    g_SoundVoicePool.clear();
 }
 
-void LoadSound(std::string name, LOAD_HANDLE path)
+SoundClip* LoadAdpcmClip(const std::string& path)
+{
+    std::string cooked = MakeCookedSoundPath(path);
+    ASSET_DATA asset = {};
+    if (!GetVirtualFileSystem()->HasAsset(cooked) ||
+        !GetVirtualFileSystem()->ReadAsset(cooked, &asset))
+    {
+        return nullptr;
+    }
+
+    SoundClip* clip = new SoundClip();
+    if (!clip->CreateFromAdpcm(asset.Data, asset.Size))
+    {
+        P_LOG(LOG_WARNING, "invalid cooked sound, use wav : [ %s ]\n",
+            cooked.c_str());
+        delete clip;
+        return nullptr;
+    }
+
+    return clip;
+}
+
+SoundClip* LoadWavClip(const std::string& path)
 {
-    HANDLE hFile;
     DWORD dwChunkSize = 0;
     DWORD dwChunkPosition = 0;
     DWORD dwFiletype;
     WAVEFORMATEXTENSIBLE wfx;
-    XAUDIO2_BUFFER buffer;
-
-    if (g_SoundPool.find(name) != g_SoundPool.end())
-    {
-        return;
-    }
 
     memset(&wfx, 0, sizeof(WAVEFORMATEXTENSIBLE));
-    memset(&buffer, 0, sizeof(XAUDIO2_BUFFER));
 
-    {
-        std::vector<std::string> v;
-        SplitByRomSymbolSound(path, v, ":/");
-        path = v[0] + "\\" + v[1];
-        v.clear();
-        SplitByRomSymbolSound(path, v, "/");
-        if (v.size() > 1)
-        {
-            path = "";
-            for (int i = 0; i < v.size(); i++)
-            {
-                if (i == (v.size() - 1))
-                {
-                    path += v[i];
-                }
-                else
-                {
-                    path += v[i] + "\\";
-                }
-            }
-        }
-    }
-
-    hFile = CreateFile(path.c_str(), GENERIC_READ,
-        FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
-    if (hFile == INVALID_HANDLE_VALUE)
-    {
-        P_LOG(LOG_ERROR,
-            "failed to create sound handle\n");
-        return;
-    }
-    if (SetFilePointer(hFile, 0, NULL, FILE_BEGIN) ==
-        INVALID_SET_FILE_POINTER)
+    ASSET_DATA asset = {};
+    if (!GetVirtualFileSystem()->ReadAsset(path, &asset))
     {
         P_LOG(LOG_ERROR,
-            "failed to check sound handle by SetFilePointer\n");
-        return;
+            "failed to find sound file : [ %s ]\n", path.c_str());
+        return nullptr;
     }
+    const BYTE* pFile = asset.Data;
+    DWORD fileSize = (DWORD)asset.Size;
 
     HRESULT hr = S_OK;
 
-    hr = CheckChunk(hFile, 'FFIR',
+    hr = CheckChunk(pFile, fileSize, 'FFIR',
         &dwChunkSize, &dwChunkPosition);
     if (FAILED(hr))
     {
         P_LOG(LOG_ERROR,
             "failed to check wav sound CheckChunk\n");
-        return;
+        return nullptr;
     }
-    hr = ReadChunkData(hFile, &dwFiletype,
+    hr = ReadChunkData(pFile, fileSize, &dwFiletype,
         sizeof(DWORD), dwChunkPosition);
     if (FAILED(hr))
     {
         P_LOG(LOG_ERROR,
             "failed to check wav sound by ReadChunkData\n");
-        return;
+        return nullptr;
     }
     if (dwFiletype != 'EVAW')
     {
         P_LOG(LOG_ERROR,
             "failed to check wav sound by dwFiletype\n");
-        return;
+        return nullptr;
     }
 
-    hr = CheckChunk(hFile, ' tmf',
+    hr = CheckChunk(pFile, fileSize, ' tmf',
         &dwChunkSize, &dwChunkPosition);
     if (FAILED(hr))
     {
         P_LOG(LOG_ERROR,
             "failed to check wav format by CheckChunk\n");
-        return;
+        return nullptr;
+    }
+    if (dwChunkSize > sizeof(WAVEFORMATEXTENSIBLE))
+    {
+        dwChunkSize = sizeof(WAVEFORMATEXTENSIBLE);
     }
-    hr = ReadChunkData(hFile, &wfx, dwChunkSize, dwChunkPosition);
+    hr = ReadChunkData(pFile, fileSize, &wfx,
+        dwChunkSize, dwChunkPosition);
     if (FAILED(hr))
     {
         P_LOG(LOG_ERROR,
             "failed to check wav format by ReadChunkData\n");
-        return;
+        return nullptr;
+    }
+    if (wfx.Format.wBitsPerSample != 16)
+    {
+        P_LOG(LOG_ERROR,
+            "only 16 bit pcm wav can be mixed : [ %s ]\n",
+            path.c_str());
+        return nullptr;
     }
 
     DWORD size = 0;
-    hr = CheckChunk(hFile, 'atad', &size, &dwChunkPosition);
+    hr = CheckChunk(pFile, fileSize, 'atad',
+        &size, &dwChunkPosition);
     if (FAILED(hr))
     {
         P_LOG(LOG_ERROR,
             "failed to read wav file by CheckChunk\n");
-        return;
+        return nullptr;
     }
-    g_SoundLengthPool.insert(std::make_pair(name, size));
-    BYTE* pData = new BYTE[size];
-    hr = ReadChunkData(hFile, pData,
-        size, dwChunkPosition);
+    std::vector<short> pcm(size / sizeof(short));
+    hr = ReadChunkData(pFile, fileSize, pcm.data(),
+        (DWORD)(pcm.size() * sizeof(short)), dwChunkPosition);
     if (FAILED(hr))
     {
         P_LOG(LOG_ERROR,
             "failed to read wav file by ReadChunkData\n");
-        delete[] pData;
-        g_SoundLengthPool.erase(name);
-        return;
+        return nullptr;
     }
-    g_SoundDataPool.insert(std::make_pair(name, pData));
 
-    SOUND_HANDLE soundHandle = nullptr;
-    hr = gp_XAudio2->CreateSourceVoice(
-        &soundHandle, &(wfx.Format));
-    if (FAILED(hr))
+    SoundClip* clip = new SoundClip();
+    if (!wfx.Format.nChannels ||
+        !clip->CreateFromPcm16(pcm.data(),
+            pcm.size() / wfx.Format.nChannels,
+            wfx.Format.nChannels, wfx.Format.nSamplesPerSec))
     {
         P_LOG(LOG_ERROR,
-            "failed to create source wav file\n");
-        g_SoundLengthPool.erase(name);
-        delete[] pData;
-        g_SoundDataPool.erase(name);
-        return;
+            "failed to create sound clip : [ %s ]\n", path.c_str());
+        delete clip;
+        return nullptr;
     }
-    soundHandle->SetVolume(0.2f);
-    g_SoundPool.insert(std::make_pair(name, soundHandle));
+
+    return clip;
 }
 
-void PlayBGM(std::string soundName)
+bool LoadSound(std::string name, LOAD_HANDLE path)
 {
-    if (g_SoundPool.find(soundName) == g_SoundPool.end())
     {
-        P_LOG(LOG_ERROR,
-            "you haven't loaded this sound : [ %s ]\n",
-            soundName.c_str());
-        return;
+        std::lock_guard<std::mutex> lock(g_SoundPoolLock);
+        auto found = g_SoundRefPool.find(name);
+        if (found != g_SoundRefPool.end())
+        {
+            ++found->second;
+            return true;
+        }
     }
-    auto soundSize = g_SoundLengthPool[soundName];
-    auto soundData = g_SoundDataPool[soundName];
-    auto sound = g_SoundPool[soundName];
 
-    XAUDIO2_VOICE_STATE xa2state;
-    XAUDIO2_BUFFER buffer;
-
-    memset(&buffer, 0, sizeof(XAUDIO2_BUFFER));
-    buffer.AudioBytes = soundSize;
-    buffer.pAudioData = soundData;
-    buffer.Flags = XAUDIO2_END_OF_STREAM;
-    buffer.LoopCount = XAUDIO2_LOOP_INFINITE;
-
-    sound->GetState(&xa2state);
-    if (xa2state.BuffersQueued != 0)
+    // the cooked adpcm sibling stays compressed in memory and is
+    // decoded by the mixer, the wav is only the fallback
+    SoundClip* clip = LoadAdpcmClip(path);
+    if (!clip)
     {
-        sound->Stop(0);
-        sound->FlushSourceBuffers();
+        clip = LoadWavClip(path);
     }
-
-    sound->SubmitSourceBuffer(&buffer);
-    sound->Start(0);
-}
-
-void StopBGM(std::string soundName)
-{
-    if (g_SoundPool.find(soundName) == g_SoundPool.end())
+    if (!clip)
     {
-        P_LOG(LOG_ERROR,
-            "you haven't loaded this sound : [ %s ]\n",
-            soundName.c_str());
-        return;
+        return false;
     }
-    auto sound = g_SoundPool[soundName];
-    XAUDIO2_VOICE_STATE xa2state;
 
-    sound->GetState(&xa2state);
-    if (xa2state.BuffersQueued != 0)
+    std::lock_guard<std::mutex> lock(g_SoundPoolLock);
+    if (g_SoundClipPool.find(name) != g_SoundClipPool.end())
+    {
+        delete clip;
+    }
+    else
     {
-        sound->Stop(0);
-        sound->FlushSourceBuffers();
+        g_SoundClipPool.insert(std::make_pair(name, clip));
     }
+    ++g_SoundRefPool[name];
+
+    return true;
 }
 
-void StopBGM()
+void ReleaseSound(std::string name)
 {
-    XAUDIO2_VOICE_STATE xa2state;
+    std::lock_guard<std::mutex> lock(g_SoundPoolLock);
+    auto found = g_SoundRefPool.find(name);
+    if (found == g_SoundRefPool.end() || --found->second)
+    {
+        return;
+    }
+    g_SoundRefPool.erase(found);
 
-    for (auto& sound : g_SoundPool)
+    auto clip = g_SoundClipPool.find(name);
+    if (clip != g_SoundClipPool.end())
     {
-        sound.second->GetState(&xa2state);
-        if (xa2state.BuffersQueued != 0)
+        if (gp_AudioMixer)
         {
-            sound.second->Stop(0);
-            sound.second->FlushSourceBuffers();
+            gp_AudioMixer->StopVoicesOfClip(clip->second);
         }
+        delete clip->second;
+        g_SoundClipPool.erase(clip);
     }
+    g_SoundVoicePool.erase(name);
 }
 
-void SetVolumeBGM(float volume, int delayFrame)
+size_t GetSoundMemorySize(std::string name)
 {
+    std::lock_guard<std::mutex> lock(g_SoundPoolLock);
+    auto found = g_SoundClipPool.find(name);
+    if (found == g_SoundClipPool.end())
+    {
+        return 0;
+    }
 
+    return found->second->GetMemorySize();
 }
 
-void PlaySE(std::string soundName)
+VOICE_HANDLE PlaySoundVoice(const std::string& soundName,
+    const VOICE_DESC& desc)
 {
-    if (g_SoundPool.find(soundName) == g_SoundPool.end())
+    std::lock_guard<std::mutex> lock(g_SoundPoolLock);
+    auto found = g_SoundClipPool.find(soundName);
+    if (found == g_SoundClipPool.end())
     {
         P_LOG(LOG_ERROR,
             "you haven't loaded this sound : [ %s ]\n",
             soundName.c_str());
-        return;
+        return NULL_VOICE_HANDLE;
     }
-    auto soundSize = g_SoundLengthPool[soundName];
-    auto soundData = g_SoundDataPool[soundName];
-    auto sound = g_SoundPool[soundName];
 
-    XAUDIO2_VOICE_STATE xa2state;
-    XAUDIO2_BUFFER buffer;
+    return gp_AudioMixer->PlayVoice(found->second, desc);
+}
 
-    memset(&buffer, 0, sizeof(XAUDIO2_BUFFER));
-    buffer.AudioBytes = soundSize;
-    buffer.pAudioData = soundData;
-    buffer.Flags = XAUDIO2_END_OF_STREAM;
-    buffer.LoopCount = 0;
+void PlayBGM(std::string soundName)
+{
+    VOICE_DESC desc = {};
+    desc.Priority = AUDIO_PRIORITY_BGM;
+    desc.LoopFlg = true;
 
-    sound->GetState(&xa2state);
-    if (xa2state.BuffersQueued != 0)
+    StopBGM(soundName);
+    VOICE_HANDLE voice = PlaySoundVoice(soundName, desc);
+    if (voice != NULL_VOICE_HANDLE)
     {
-        sound->Stop(0);
-        sound->FlushSourceBuffers();
+        g_SoundVoicePool[soundName] = voice;
     }
+}
 
-    sound->SubmitSourceBuffer(&buffer);
-    sound->Start(0);
+void StopBGM(std::string soundName)
+{
+    auto found = g_SoundVoicePool.find(soundName);
+    if (found != g_SoundVoicePool.end())
+    {
+        gp_AudioMixer->StopVoice(found->second);
+        g_SoundVoicePool.erase(found);
+    }
+}
+
+void StopBGM()
+{
+    gp_AudioMixer->StopAllVoices();
+    g_SoundVoicePool.clear();
+}
+
+void SetVolumeBGM(float volume, int delayFrame)
+{
+
+}
+
+void PlaySE(std::string soundName, float volume, unsigned int priority)
+{
+    VOICE_DESC desc = {};
+    desc.Volume = volume;
+    desc.Priority = priority;
+
+    // every call starts a new voice, the mixer decides which of the
+    // overlapping ones are really heard
+    VOICE_HANDLE voice = PlaySoundVoice(soundName, desc);
+    if (voice != NULL_VOICE_HANDLE)
+    {
+        g_SoundVoicePool[soundName] = voice;
+    }
 }
@@ -3,8 +3,8 @@
 #include "main.h"
 #include <string>
 #include <xaudio2.h>
+#include "AudioMixer.h"
 
-using SOUND_HANDLE = IXAudio2SourceVoice*;
 using LOAD_HANDLE = std::string;
 
 bool InitSound();
@@ -15,7 +15,11 @@ void UpdateSound();
 
 void ClearSoundPool();
 
-void LoadSound(std::string name, LOAD_HANDLE path);
+bool LoadSound(std::string name, LOAD_HANDLE path);
+
+void ReleaseSound(std::string name);
+
+size_t GetSoundMemorySize(std::string name);
 
 void PlayBGM(std::string soundName);
 
@@ -25,5 +29,6 @@ void StopBGM();
 
 void SetVolumeBGM(float volume, int delayFrame = 0);
 
-void PlaySE(std::string soundName);
+void PlaySE(std::string soundName, float volume = 1.f,
+    unsigned int priority = AUDIO_PRIORITY_SE);
 
@@ -1,5 +1,6 @@
 #include "SpriteHelper.h"
 #include "main.h"
+#include "Telemetry.h"
 
 struct VERTEX_3D
 {
@@ -14,6 +15,8 @@ void DrawSprite(ID3D11Buffer* const* ppVertexBuffers,
     float tx, float ty, float tw, float th,
     Float4 color)
 {
+    TELEMETRY_INC(DRAW_CALLS);
+
     D3D11_MAPPED_SUBRESOURCE msr;
     GetDxHelperPtr()->GetImmediateContextPtr()->Map(
         *ppVertexBuffers, 0, D3D11_MAP_WRITE_DISCARD, 0, &msr);
@@ -2,60 +2,125 @@
 #include "DxHelper.h"
 #include "DxProcess.h"
 #include "main.h"
+#include "Telemetry.h"
 #include <iostream>
 #include <vector>
 #include "WICTextureLoader11.h"
+#include "VirtualFileSystem.h"
+#include "DdsTexture.h"
 
-void SplitByRomSymbol(const std::string& s,
-    std::vector<std::string>& v, const std::string& c)
+namespace
 {
-    v.clear();
-    std::string::size_type pos1 = 0, pos2 = s.find(c);
-    while (std::string::npos != pos2)
+    DXGI_FORMAT GetDxgiFormat(DDS_FORMAT format)
     {
-        v.push_back(s.substr(pos1, pos2 - pos1));
+        switch (format)
+        {
+        case DDS_FORMAT::BC1: return DXGI_FORMAT_BC1_UNORM;
+        case DDS_FORMAT::BC3: return DXGI_FORMAT_BC3_UNORM;
+        case DDS_FORMAT::BC7: return DXGI_FORMAT_BC7_UNORM;
+        default: return DXGI_FORMAT_UNKNOWN;
+        }
+    }
 
-        pos1 = pos2 + c.size();
-        pos2 = s.find(c, pos1);
+    DDS_FORMAT GetDdsFormat(DXGI_FORMAT format)
+    {
+        switch (format)
+        {
+        case DXGI_FORMAT_BC1_UNORM: return DDS_FORMAT::BC1;
+        case DXGI_FORMAT_BC3_UNORM: return DDS_FORMAT::BC3;
+        case DXGI_FORMAT_BC7_UNORM: return DDS_FORMAT::BC7;
+        default: return DDS_FORMAT::UNKNOWN;
+        }
+    }
+
+    // the blocks are handed to the device as they are, there is no
+    // decode and no rgba copy on the cpu side
+    ID3D11ShaderResourceView* CreateBlockTexture(
+        const unsigned char* data, size_t size)
+    {
+        DDS_TEXTURE_INFO info = {};
+        if (!ParseDdsTexture(data, size, &info))
+        {
+            return nullptr;
+        }
+
+        D3D11_SUBRESOURCE_DATA levels[DDS_MAX_MIP_LEVEL] = {};
+        const unsigned char* level = data + info.DataOffset;
+        unsigned int width = info.Width;
+        unsigned int height = info.Height;
+        for (unsigned int i = 0; i < info.MipCount; i++)
+        {
+            levels[i].pSysMem = level;
+            levels[i].SysMemPitch =
+                (UINT)GetDdsLevelPitch(info.Format, width);
+            levels[i].SysMemSlicePitch =
+                (UINT)GetDdsLevelSize(info.Format, width, height);
+            level += levels[i].SysMemSlicePitch;
+            width = width > 1 ? width / 2 : 1;
+            height = height > 1 ? height / 2 : 1;
+        }
+
+        D3D11_TEXTURE2D_DESC desc = {};
+        desc.Width = info.Width;
+        desc.Height = info.Height;
+        desc.MipLevels = info.MipCount;
+        desc.ArraySize = 1;
+        desc.Format = GetDxgiFormat(info.Format);
+        desc.SampleDesc.Count = 1;
+        desc.Usage = D3D11_USAGE_IMMUTABLE;
+        desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+        HRESULT hr = S_OK;
+        ID3D11Texture2D* texture = nullptr;
+        ID3D11ShaderResourceView* texSRV = nullptr;
+        ID3D11Device* device = GetDxHelperPtr()->GetDevicePtr();
+        hr = device->CreateTexture2D(&desc, levels, &texture);
+        if (FAILED(hr))
+        {
+            return nullptr;
+        }
+        hr = device->CreateShaderResourceView(texture, nullptr,
+            &texSRV);
+        texture->Release();
+        if (FAILED(hr))
+        {
+            return nullptr;
+        }
+
+        return texSRV;
     }
-    if (pos1 != s.length())
-        v.push_back(s.substr(pos1));
 }
 
 ID3D11ShaderResourceView* LoadTexture(std::string fileName)
 {
+    ASSET_DATA asset = {};
+    std::string cooked = MakeCookedTexturePath(fileName);
+    if (GetVirtualFileSystem()->HasAsset(cooked) &&
+        GetVirtualFileSystem()->ReadAsset(cooked, &asset))
     {
-        std::vector<std::string> v;
-        SplitByRomSymbol(fileName, v, ":/");
-        fileName = v[0] + "\\" + v[1];
-        v.clear();
-        SplitByRomSymbol(fileName, v, "/");
-        if (v.size() > 1)
+        ID3D11ShaderResourceView* texSRV =
+            CreateBlockTexture(asset.Data, asset.Size);
+        if (texSRV)
         {
-            fileName = "";
-            for (int i = 0; i < v.size(); i++)
-            {
-                if (i == (v.size() - 1))
-                {
-                    fileName += v[i];
-                }
-                else
-                {
-                    fileName += v[i] + "\\";
-                }
-            }
+            return texSRV;
         }
+        P_LOG(LOG_WARNING, "invalid cooked texture, use png : [ %s ]\n",
+            cooked.c_str());
+    }
+
+    if (!GetVirtualFileSystem()->ReadAsset(fileName, &asset))
+    {
+        P_LOG(LOG_ERROR, "cannot find texture : [ %s ]\n",
+            fileName.c_str());
+        return nullptr;
     }
 
     HRESULT hr = S_OK;
     ID3D11ShaderResourceView* texSRV = nullptr;
 
-    std::wstring wName = std::wstring(
-        fileName.begin(), fileName.end());
-
-    hr = DirectX::CreateWICTextureFromFile(
+    hr = DirectX::CreateWICTextureFromMemory(
         GetDxHelperPtr()->GetDevicePtr(),
-        wName.c_str(), nullptr, &texSRV);
+        asset.Data, asset.Size, nullptr, &texSRV);
     if (FAILED(hr))
     {
         return nullptr;
@@ -80,7 +145,45 @@ void SetTexture(ID3D11ShaderResourceView** pSRV)
     }
     else
     {
+        TELEMETRY_INC(TEXTURE_BINDS);
         GetDxHelperPtr()->GetImmediateContextPtr()->
             PSSetShaderResources(0, 1, pSRV);
     }
 }
+
+size_t GetTextureMemorySize(ID3D11ShaderResourceView* pSRV)
+{
+    if (!pSRV)
+    {
+        return 0;
+    }
+
+    ID3D11Resource* resource = nullptr;
+    ID3D11Texture2D* texture = nullptr;
+    pSRV->GetResource(&resource);
+    HRESULT hr = resource->QueryInterface(IID_PPV_ARGS(&texture));
+    resource->Release();
+    if (FAILED(hr))
+    {
+        return 0;
+    }
+    D3D11_TEXTURE2D_DESC desc = {};
+    texture->GetDesc(&desc);
+    texture->Release();
+
+    // everything that isn't block compressed comes from wic as rgba8
+    DDS_FORMAT format = GetDdsFormat(desc.Format);
+    size_t size = 0;
+    unsigned int width = desc.Width;
+    unsigned int height = desc.Height;
+    for (UINT i = 0; i < desc.MipLevels; i++)
+    {
+        size += format == DDS_FORMAT::UNKNOWN ?
+            (size_t)width * height * 4 :
+            GetDdsLevelSize(format, width, height);
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+
+    return size * desc.ArraySize;
+}
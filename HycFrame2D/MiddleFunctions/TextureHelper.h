@@ -8,3 +8,5 @@ ID3D11ShaderResourceView* LoadTexture(std::string fileName);
 void UnloadTexture(ID3D11ShaderResourceView** pSRV);
 
 void SetTexture(ID3D11ShaderResourceView** pSRV);
+
+size_t GetTextureMemorySize(ID3D11ShaderResourceView* pSRV);
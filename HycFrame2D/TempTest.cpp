@@ -24,12 +24,19 @@ void TempTestRegister(ObjectFactory* _factory)
         std::make_pair(FUNC_NAME(TestUiUpdate), TestUiUpdate));
     uDestoryPoolPtr->insert(
         std::make_pair(FUNC_NAME(TestUiDestory), TestUiDestory));
+    uInitPoolPtr->insert(
+        std::make_pair(FUNC_NAME(TestUiToggleInit), TestUiToggleInit));
     aInputPoolPtr->insert(
         std::make_pair(FUNC_NAME(TempMove), TempMove));
     aInputPoolPtr->insert(
         std::make_pair(FUNC_NAME(SceneSwitch), SceneSwitch));
     uInputPoolPtr->insert(
         std::make_pair(FUNC_NAME(TempUiInput), TempUiInput));
+
+    auto aCoroutinePoolPtr = _factory->GetActorInterCoroutinePool();
+    aCoroutinePoolPtr->insert(
+        std::make_pair(FUNC_NAME(TestCollisionCoroutine),
+            TestCollisionCoroutine));
 }
 
 void TestInit(AInteractionComponent* _aitc)
@@ -76,6 +83,24 @@ void TestUpdate(AInteractionComponent* _aitc, float _deltatime)
     }
 }
 
+ScriptCoroutine TestCollisionCoroutine(AInteractionComponent* _aitc)
+{
+    auto ac = _aitc->GetActorObjOwner();
+    auto acc = ac->GetAComponent<ACollisionComponent>(
+        COMP_TYPE::ACOLLISION);
+    if (!acc)
+    {
+        co_return;
+    }
+
+    while (true)
+    {
+        co_await WaitUntilCollision(acc, "test2"_sid);
+        P_LOG(LOG_DEBUG, "collided with test2!!!!!!!!\n");
+        co_await WaitSeconds(1.f);
+    }
+}
+
 void TestDestory(AInteractionComponent* _aitc)
 {
     P_LOG(LOG_DEBUG, "test destory!!!!!!!!\n");
@@ -91,18 +116,8 @@ void TestUiUpdate(UInteractionComponent* _uitc, float _deltatime)
     auto scene = _uitc->GetUiObjOwner()->GetSceneNodePtr();
     if (GetControllerTrigger(GP_RIGHTFORESHDBTN))
     {
-        if (scene->GetUiObject("test-ui")->IsObjectActive() ==
-            STATUS::ACTIVE)
-        {
-            scene->GetUiObject("test-ui")->
-                SetObjectActive(STATUS::PAUSE);
-        }
-        else if (scene->GetUiObject("test-ui")->IsObjectActive() ==
-            STATUS::PAUSE)
-        {
-            scene->GetUiObject("test-ui")->
-                SetObjectActive(STATUS::ACTIVE);
-        }
+        scene->GetEventBus()->PostEvent("toggle-test-ui"_sid,
+            _uitc->GetUiObjOwner());
     }
 
     if (GetControllerTrigger(GP_RIGHTMENUBTN))
@@ -121,6 +136,25 @@ void TestUiDestory(UInteractionComponent* _aitc)
     P_LOG(LOG_DEBUG, "ui test destory!!!!!!!!\n");
 }
 
+void TestUiToggleInit(UInteractionComponent* _uitc)
+{
+    UiObject* owner = _uitc->GetUiObjOwner();
+    owner->GetSceneNodePtr()->GetEventBus()->Subscribe(
+        "toggle-test-ui"_sid, owner, ToggleUiActive);
+}
+
+void ToggleUiActive(Object* _receiver, const EVENT_MESSAGE& _event)
+{
+    if (_receiver->IsObjectActive() == STATUS::ACTIVE)
+    {
+        _receiver->SetObjectActive(STATUS::PAUSE);
+    }
+    else if (_receiver->IsObjectActive() == STATUS::PAUSE)
+    {
+        _receiver->SetObjectActive(STATUS::ACTIVE);
+    }
+}
+
 void TempUiInput(UInputComponent* _uic, float _deltatime)
 {
     UiObject* owner = _uic->GetUiObjOwner();
@@ -130,28 +164,28 @@ void TempUiInput(UInputComponent* _uic, float _deltatime)
     UBtnMapComponent* ubmc = nullptr;
     ubmc = (UBtnMapComponent*)owner->GetUComponent(btnmapName);
 
-    if (GetControllerTrigger(GP_LEFTDIRBTN))
+    if (GetActionTrigger("ui-left"_sid))
     {
         if (ubmc && ubmc->IsBeingSelected())
         {
             ubmc->SelectLeftBtn();
         }
     }
-    else if (GetControllerTrigger(GP_RIGHTDIRBTN))
+    else if (GetActionTrigger("ui-right"_sid))
     {
         if (ubmc && ubmc->IsBeingSelected())
         {
             ubmc->SelectRightBtn();
         }
     }
-    else if (GetControllerTrigger(GP_UPDIRBTN))
+    else if (GetActionTrigger("ui-up"_sid))
     {
         if (ubmc && ubmc->IsBeingSelected())
         {
             ubmc->SelectUpBtn();
         }
     }
-    else if (GetControllerTrigger(GP_DOWNDIRBTN))
+    else if (GetActionTrigger("ui-down"_sid))
     {
         if (ubmc && ubmc->IsBeingSelected())
         {
@@ -10,6 +10,8 @@ void TestInit(AInteractionComponent* _aitc);
 
 void TestUpdate(AInteractionComponent* _aitc, float _deltatime);
 
+ScriptCoroutine TestCollisionCoroutine(AInteractionComponent* _aitc);
+
 void TestDestory(AInteractionComponent* _aitc);
 
 void TestUiInit(UInteractionComponent* _aitc);
@@ -18,6 +20,10 @@ void TestUiUpdate(UInteractionComponent* _aitc, float _deltatime);
 
 void TestUiDestory(UInteractionComponent* _aitc);
 
+void TestUiToggleInit(UInteractionComponent* _uitc);
+
+void ToggleUiActive(Object* _receiver, const EVENT_MESSAGE& _event);
+
 void TempUiInput(UInputComponent* _uic, float _deltatime);
 
 void TempMove(AInputComponent* _aic, float _deltatime);
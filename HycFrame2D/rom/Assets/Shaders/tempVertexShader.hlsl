@@ -6,6 +6,10 @@ cbuffer ConstantUpdateBuffer : register(b1)
 {
     matrix World;
 };
+cbuffer ConstantViewBuffer : register(b2)
+{
+    matrix View;
+};
 struct VS_INPUT
 {
     float3 PosL : POSITION;
@@ -26,6 +30,7 @@ VS_OUTPUT main(VS_INPUT input)
     output.PosH = mul(float4(input.PosL, 1.0f), World);
     output.PosW = output.PosH.xyz;
     output.ColorW = input.ColorL;
+    output.PosH = mul(output.PosH, View);
     output.PosH = mul(output.PosH, Projection);
     output.TexCoordL = input.TexCoordL;
     return output;
@@ -0,0 +1,231 @@
+﻿//---------------------------------------------------------------
+// File: ActivityRegionTest.cpp
+// Proj: HycFrame2D
+// Info: カメラ周りの活動領域と休眠リストのテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "HeadlessScene.h"
+#include "SceneNode.h"
+#include "ActorObject.h"
+#include "AComponent.h"
+#include "ATransformComponent.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+    const Float2 CAMERA_SIZE = MakeFloat2(1920.f, 1080.f);
+
+    class CountingAComponent :
+        public AComponent
+    {
+    public:
+        CountingAComponent(std::string _name, ActorObject* _owner) :
+            AComponent(_name, _owner, 0), mUpdateCount(0),
+            mDeltaTime(0.f)
+        {
+            SetCompNeedUpdate(true);
+        }
+
+        virtual void CompUpdate(float _deltatime)
+        {
+            ++mUpdateCount;
+            mDeltaTime += _deltatime;
+        }
+
+        unsigned int GetUpdateCount() const
+        {
+            return mUpdateCount;
+        }
+
+        float GetDeltaTime() const
+        {
+            return mDeltaTime;
+        }
+
+    private:
+        unsigned int mUpdateCount;
+
+        float mDeltaTime;
+    };
+
+    CountingAComponent* AddCountedActor(HeadlessScene* _scene,
+        std::string _name, Float2 _pos, DORMANT_POLICY _policy,
+        unsigned int _rate = 1)
+    {
+        ActorObject* actor = _scene->AddEmptyActor(_name,
+            MakeFloat3(_pos.x, _pos.y, 0.f));
+        actor->SetDormantPolicy(_policy, _rate);
+        CountingAComponent* comp =
+            new CountingAComponent(_name + "-count", actor);
+        actor->AddAComponent(comp);
+
+        return comp;
+    }
+
+    ACTOR_LIST GetList(HeadlessScene* _scene, const char* _name)
+    {
+        return _scene->GetSceneNode()->GetActorObject(
+            StringID(_name))->GetActorList();
+    }
+
+    void MoveActor(AComponent* _comp, Float2 _pos)
+    {
+        _comp->GetActorObjOwner()->GetAComponent<ATransformComponent>(
+            COMP_TYPE::ATRANSFORM)->SetPosition(
+                MakeFloat3(_pos.x, _pos.y, 0.f));
+    }
+
+    void RunFrames(HeadlessScene* _scene, int _frames)
+    {
+        for (int i = 0; i < _frames; i++)
+        {
+            _scene->RunFrame(MAX_DELTA);
+        }
+    }
+}
+
+TEST_CASE(ActivityRegion_CameraMovesActorsBetweenLists)
+{
+    HeadlessScene scene = {};
+    SceneNode* node = scene.GetSceneNode();
+    node->InitCamera(MakeFloat2(0.f, 0.f), CAMERA_SIZE);
+    CountingAComponent* near = AddCountedActor(&scene, "near",
+        MakeFloat2(0.f, 0.f), DORMANT_POLICY::SLEEP);
+    CountingAComponent* sleep = AddCountedActor(&scene, "sleep",
+        MakeFloat2(5000.f, 0.f), DORMANT_POLICY::SLEEP);
+    CountingAComponent* reduced = AddCountedActor(&scene, "reduced",
+        MakeFloat2(5000.f, 200.f), DORMANT_POLICY::REDUCED, 4);
+    CountingAComponent* always = AddCountedActor(&scene, "always",
+        MakeFloat2(9000.f, 0.f), DORMANT_POLICY::ALWAYS_ACTIVE);
+    RunFrames(&scene, 1);
+
+    // the region is the view grown by the default 512 margin
+    CHECK(GetList(&scene, "near") == ACTOR_LIST::ACTIVE);
+    CHECK(GetList(&scene, "sleep") == ACTOR_LIST::DORMANT);
+    CHECK(GetList(&scene, "reduced") == ACTOR_LIST::DORMANT);
+    CHECK(GetList(&scene, "always") == ACTOR_LIST::ACTIVE);
+
+    // a sleeping actor is never updated, a reduced one every fourth
+    // frame with the time it skipped
+    unsigned int nearBase = near->GetUpdateCount();
+    unsigned int alwaysBase = always->GetUpdateCount();
+    RunFrames(&scene, 8);
+    CHECK(near->GetUpdateCount() == nearBase + 8);
+    CHECK(always->GetUpdateCount() == alwaysBase + 8);
+    CHECK(sleep->GetUpdateCount() == 0);
+    CHECK(reduced->GetUpdateCount() == 2);
+    CHECK(reduced->GetDeltaTime() > MAX_DELTA * 7.9f);
+
+    // the camera takes the region with it
+    node->GetCamera()->ResetCameraPos(MakeFloat2(5000.f, 0.f));
+    RunFrames(&scene, 1);
+    CHECK(GetList(&scene, "near") == ACTOR_LIST::DORMANT);
+    CHECK(GetList(&scene, "sleep") == ACTOR_LIST::ACTIVE);
+    CHECK(GetList(&scene, "reduced") == ACTOR_LIST::ACTIVE);
+    CHECK(GetList(&scene, "always") == ACTOR_LIST::ACTIVE);
+
+    nearBase = near->GetUpdateCount();
+    unsigned int sleepBase = sleep->GetUpdateCount();
+    unsigned int reducedBase = reduced->GetUpdateCount();
+    RunFrames(&scene, 4);
+    CHECK(near->GetUpdateCount() == nearBase);
+    CHECK(sleep->GetUpdateCount() == sleepBase + 4);
+    CHECK(reduced->GetUpdateCount() == reducedBase + 4);
+
+    // a smaller margin lets an actor just past the view fall asleep
+    node->GetCamera()->ResetCameraPos(MakeFloat2(0.f, 0.f));
+    AddCountedActor(&scene, "edge", MakeFloat2(1200.f, 0.f),
+        DORMANT_POLICY::SLEEP);
+    RunFrames(&scene, 1);
+    CHECK(GetList(&scene, "near") == ACTOR_LIST::ACTIVE);
+    CHECK(GetList(&scene, "edge") == ACTOR_LIST::ACTIVE);
+    node->SetActivityMargin(MakeFloat2(64.f, 64.f));
+    RunFrames(&scene, 1);
+    CHECK(GetList(&scene, "edge") == ACTOR_LIST::DORMANT);
+}
+
+TEST_CASE(ActivityRegion_MovedAndPausedActorsChangeLists)
+{
+    HeadlessScene scene = {};
+    scene.GetSceneNode()->InitCamera(MakeFloat2(0.f, 0.f), CAMERA_SIZE);
+    CountingAComponent* runner = AddCountedActor(&scene, "runner",
+        MakeFloat2(6000.f, 0.f), DORMANT_POLICY::SLEEP);
+    CountingAComponent* paused = AddCountedActor(&scene, "paused",
+        MakeFloat2(0.f, 0.f), DORMANT_POLICY::SLEEP);
+    RunFrames(&scene, 1);
+    REQUIRE(GetList(&scene, "runner") == ACTOR_LIST::DORMANT);
+
+    // a dormant actor that moves itself into the region wakes up
+    // without the camera moving
+    MoveActor(runner, MakeFloat2(100.f, 0.f));
+    RunFrames(&scene, 1);
+    CHECK(GetList(&scene, "runner") == ACTOR_LIST::ACTIVE);
+    unsigned int runnerBase = runner->GetUpdateCount();
+    RunFrames(&scene, 3);
+    CHECK(runner->GetUpdateCount() == runnerBase + 3);
+
+    // paused actors leave every update list until they are active
+    ActorObject* pausedActor = paused->GetActorObjOwner();
+    pausedActor->SetObjectActive(STATUS::PAUSE);
+    RunFrames(&scene, 1);
+    CHECK(GetList(&scene, "paused") == ACTOR_LIST::PAUSED);
+    unsigned int pausedBase = paused->GetUpdateCount();
+    RunFrames(&scene, 5);
+    CHECK(paused->GetUpdateCount() == pausedBase);
+
+    // and an actor paused out of view goes back to the dormant list
+    MoveActor(paused, MakeFloat2(8000.f, 0.f));
+    pausedActor->SetObjectActive(STATUS::ACTIVE);
+    RunFrames(&scene, 1);
+    CHECK(GetList(&scene, "paused") == ACTOR_LIST::DORMANT);
+    CHECK(paused->GetUpdateCount() == pausedBase);
+}
+
+TEST_CASE(ActivityRegion_BenchScrollingThroughSleepers)
+{
+    HeadlessScene scene = {};
+    SceneNode* node = scene.GetSceneNode();
+    node->InitCamera(MakeFloat2(0.f, 0.f), CAMERA_SIZE);
+    const int side = 100;
+    const float spacing = 300.f;
+    float origin = -0.5f * spacing * (float)(side - 1);
+    std::vector<CountingAComponent*> counters = {};
+    for (int y = 0; y < side; y++)
+    {
+        for (int x = 0; x < side; x++)
+        {
+            counters.push_back(AddCountedActor(&scene,
+                "sleeper-" + std::to_string(y * side + x),
+                MakeFloat2(origin + spacing * (float)x,
+                    origin + spacing * (float)y),
+                DORMANT_POLICY::SLEEP));
+        }
+    }
+    RunFrames(&scene, 1);
+
+    const int frames = 300;
+    Camera* camera = node->GetCamera();
+    HEADLESS_BENCH bench = scene.BenchFrames(frames, [&](int _frame)
+        {
+            camera->TranslateCameraPos(MakeFloat2(20.f, 10.f));
+            node->UpdateScene(MAX_DELTA);
+        });
+
+    // only the few actors around the camera are updated at all
+    unsigned long long updated = 0;
+    for (auto& counter : counters)
+    {
+        updated += counter->GetUpdateCount();
+    }
+    updated /= frames + 1;
+    BENCH_LOG("%d sleepers, %.4f ms per update while scrolling, %llu "
+        "updates per frame, %.1f allocations per frame\n",
+        side * side, bench.MsPerFrame, updated,
+        bench.AllocationsPerFrame);
+    CHECK(updated > 0);
+    CHECK(updated < (unsigned long long)side * side / 10);
+}
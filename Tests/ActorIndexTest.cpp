@@ -0,0 +1,131 @@
+﻿//---------------------------------------------------------------
+// File: ActorIndexTest.cpp
+// Proj: HycFrame2D
+// Info: タグと種類によるACTOR索引のテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "HeadlessScene.h"
+#include "SceneNode.h"
+#include "ActorObject.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+    bool IsInList(const std::vector<ActorObject*>* _list,
+        ActorObject* _actor)
+    {
+        return std::find(_list->begin(), _list->end(), _actor) !=
+            _list->end();
+    }
+}
+
+TEST_CASE(ActorIndex_TagAndTypeListsFollowRetiredActors)
+{
+    HeadlessScene scene = {};
+    std::vector<ActorObject*> enemies = {};
+    for (int i = 0; i < 5; i++)
+    {
+        ActorObject* actor = scene.AddSpriteActor(
+            "enemy-" + std::to_string(i), MakeFloat3(0.f, 0.f, 0.f),
+            MakeFloat2(8.f, 8.f), 0);
+        actor->AddTag("enemy");
+        enemies.push_back(actor);
+    }
+    ActorObject* plain = scene.AddEmptyActor("plain",
+        MakeFloat3(0.f, 0.f, 0.f));
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+
+    SceneNode* node = scene.GetSceneNode();
+    CHECK(node->GetActorsWithTag("enemy"_sid)->size() == 5);
+    CHECK(node->GetActorsWithComp(COMP_TYPE::ASPRITE)->size() == 5);
+    CHECK(node->GetActorsWithComp(COMP_TYPE::ATRANSFORM)->size() == 6);
+
+    // retiring from the middle swaps the last one into its slot
+    enemies[1]->SetObjectActive(STATUS::NEED_DESTORY);
+    enemies[3]->SetObjectActive(STATUS::NEED_DESTORY);
+    plain->SetObjectActive(STATUS::NEED_DESTORY);
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+    auto tagged = node->GetActorsWithTag("enemy"_sid);
+    CHECK(tagged->size() == 3);
+    CHECK(IsInList(tagged, enemies[0]));
+    CHECK(IsInList(tagged, enemies[2]));
+    CHECK(IsInList(tagged, enemies[4]));
+    CHECK(!IsInList(tagged, enemies[1]));
+    CHECK(node->GetActorsWithComp(COMP_TYPE::ATRANSFORM)->size() == 3);
+
+    enemies[4]->SetObjectActive(STATUS::NEED_DESTORY);
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+    CHECK(tagged->size() == 2);
+    CHECK(IsInList(tagged, enemies[0]));
+    CHECK(IsInList(tagged, enemies[2]));
+}
+
+TEST_CASE(ActorIndex_MissingTagDoesNotGrowTheIndex)
+{
+    HeadlessScene scene = {};
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+
+    size_t before = GetAllocationCount();
+    auto missing = scene.GetSceneNode()->GetActorsWithTag("ghost"_sid);
+    auto another = scene.GetSceneNode()->GetActorsWithTag("spirit"_sid);
+    CHECK(GetAllocationCount() == before);
+    CHECK(missing->empty());
+    CHECK(missing == another);
+}
+
+TEST_CASE(ActorIndex_BenchTagQueryAgainstLinearScan)
+{
+    const int actorNum = 50000;
+    const int rounds = 100;
+    HeadlessScene scene = {};
+    std::vector<ActorObject*> actors = {};
+    for (int i = 0; i < actorNum; i++)
+    {
+        ActorObject* actor = scene.AddEmptyActor(
+            "crowd-" + std::to_string(i), MakeFloat3(0.f, 0.f, 0.f));
+        if (i % 100 == 0)
+        {
+            actor->AddTag("enemy");
+        }
+        actors.push_back(actor);
+    }
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+
+    const StringID tag = "enemy"_sid;
+    size_t scanned = 0;
+    BenchTimer timer = {};
+    for (int r = 0; r < rounds; r++)
+    {
+        for (auto& actor : actors)
+        {
+            if (actor->HasTag(tag))
+            {
+                ++scanned;
+            }
+        }
+    }
+    double scanMs = timer.GetElapsedMs() / rounds;
+
+    size_t queried = 0;
+    timer.ResetTimer();
+    for (int r = 0; r < rounds; r++)
+    {
+        for (auto& actor : *scene.GetSceneNode()->GetActorsWithTag(tag))
+        {
+            if (actor->IsObjectActive() == STATUS::ACTIVE)
+            {
+                ++queried;
+            }
+        }
+    }
+    double queryMs = timer.GetElapsedMs() / rounds;
+
+    BENCH_LOG("%d actors, %zu tagged, scan %.4f ms, index %.4f ms\n",
+        actorNum, queried / rounds, scanMs, queryMs);
+    CHECK(scanned == queried);
+}
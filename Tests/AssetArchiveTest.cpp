@@ -0,0 +1,422 @@
+﻿//---------------------------------------------------------------
+// File: AssetArchiveTest.cpp
+// Proj: HycFrame2D
+// Info: アセットアーカイブと仮想ファイルシステムのテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "VirtualFileSystem.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const std::string ARCHIVE_PATH = "asset-archive-test.hpak";
+    const std::string OVERRIDE_PATH = "asset-archive-override.hpak";
+    const std::string TEXTURE_PATH = "rom:/Assets/Textures/Player.PNG";
+    const std::string CONFIG_PATH = "rom:/Configs/Level-01.json";
+
+    // repeats well so the packer keeps the compressed form
+    std::vector<unsigned char> MakeTextureBytes()
+    {
+        std::vector<unsigned char> bytes(16 * 1024);
+        for (size_t i = 0; i < bytes.size(); i++)
+        {
+            bytes[i] = (unsigned char)((i / 64) % 7);
+        }
+
+        return bytes;
+    }
+
+    std::vector<unsigned char> MakeTextBytes(const std::string& _text)
+    {
+        return std::vector<unsigned char>(_text.begin(), _text.end());
+    }
+
+    bool SameBytes(const ASSET_DATA& _data,
+        const std::vector<unsigned char>& _expect)
+    {
+        return _data.Size == _expect.size() &&
+            !memcmp(_data.Data, _expect.data(), _data.Size);
+    }
+
+    bool WriteTestArchive()
+    {
+        AssetArchiveWriter writer = {};
+        bool added =
+            writer.AddEntry(TEXTURE_PATH, MakeTextureBytes(), true) &&
+            writer.AddEntry(CONFIG_PATH, MakeTextBytes("{\"lv\":1}"),
+                false);
+
+        return added && writer.WriteArchive(ARCHIVE_PATH);
+    }
+
+    // every rom:/ path a shipped scene names, plus the scene itself
+    std::vector<std::string> CollectSceneAssets(
+        const std::string& _scene)
+    {
+        std::vector<std::string> paths = { _scene };
+        std::ifstream file(MakeLooseAssetPath(_scene));
+        std::string text((std::istreambuf_iterator<char>(file)),
+            std::istreambuf_iterator<char>());
+        size_t pos = text.find("\"rom:/");
+        while (pos != std::string::npos)
+        {
+            size_t end = text.find('"', pos + 1);
+            std::string path = text.substr(pos + 1, end - pos - 1);
+            bool seen = false;
+            for (auto& exist : paths)
+            {
+                seen = seen || MakeAssetPathKey(exist) ==
+                    MakeAssetPathKey(path);
+            }
+            if (!seen)
+            {
+                paths.push_back(path);
+            }
+            pos = text.find("\"rom:/", end);
+        }
+
+        return paths;
+    }
+
+    // the configs don't always match the case of the files on disk,
+    // so look the file up the way the packer names its entries
+    std::string FindLooseSpelling(const std::string& _path)
+    {
+        namespace fs = std::filesystem;
+        fs::path loose(MakeLooseAssetPath(_path));
+        std::error_code ec;
+        fs::directory_iterator dir(loose.parent_path(), ec);
+        for (; !ec && dir != fs::directory_iterator(); ++dir)
+        {
+            if (MakeAssetPathKey(dir->path().filename().string()) ==
+                MakeAssetPathKey(loose.filename().string()))
+            {
+                return "rom:/" + fs::relative(dir->path(), "rom")
+                    .generic_string();
+            }
+        }
+
+        return "";
+    }
+
+    // writes back dirty pages and asks the kernel to forget the file,
+    // windows has no cheap equivalent so only warm reads are timed
+    bool DropFileCache(const std::string& _file)
+    {
+#ifndef _WIN32
+        int fd = open(_file.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+        fsync(fd);
+        bool dropped =
+            !posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+
+        return dropped;
+#else
+        (void)_file;
+        return false;
+#endif
+    }
+}
+
+TEST_CASE(AssetArchive_CompressionRoundTrips)
+{
+    std::vector<unsigned char> raw = MakeTextureBytes();
+    std::vector<unsigned char> packed = {};
+    size_t packedSize = CompressAssetData(raw.data(), raw.size(),
+        &packed);
+    CHECK(packedSize == packed.size());
+    CHECK(packedSize < raw.size() / 4);
+
+    std::vector<unsigned char> unpacked(raw.size());
+    REQUIRE(DecompressAssetData(packed.data(), packed.size(),
+        unpacked.data(), unpacked.size()));
+    CHECK(unpacked == raw);
+
+    // a wrong raw size must be caught instead of overrunning
+    CHECK(!DecompressAssetData(packed.data(), packed.size(),
+        unpacked.data(), unpacked.size() - 1));
+}
+
+TEST_CASE(AssetArchive_PathKeysIgnoreCaseAndSlashes)
+{
+    CHECK(MakeAssetPathKey("ROM:\\Assets\\Textures\\Player.PNG") ==
+        "rom:/assets/textures/player.png");
+    CHECK(MakeAssetPathID(TEXTURE_PATH) ==
+        MakeAssetPathID("rom:/assets/textures/player.png"));
+    CHECK(MakeAssetPathID(TEXTURE_PATH) !=
+        MakeAssetPathID("rom:/Assets/Textures/Player.tga"));
+    CHECK(MakeLooseAssetPath("rom:/Configs\\moji.json") ==
+        "rom/Configs/moji.json");
+
+    // two spellings of one path would collide inside the archive
+    AssetArchiveWriter writer = {};
+    CHECK(writer.AddEntry(TEXTURE_PATH, MakeTextureBytes(), true));
+    CHECK(!writer.AddEntry("rom:/assets/textures/PLAYER.png",
+        MakeTextureBytes(), true));
+    CHECK(writer.GetEntryCount() == 1);
+}
+
+TEST_CASE(AssetArchive_MixedCaseLookupFindsTheEntry)
+{
+    REQUIRE(WriteTestArchive());
+    VirtualFileSystem vfs = {};
+    REQUIRE(vfs.MountArchive(ARCHIVE_PATH));
+
+    const std::vector<unsigned char> texture = MakeTextureBytes();
+    const std::vector<unsigned char> config =
+        MakeTextBytes("{\"lv\":1}");
+    const char* textureSpellings[] =
+    {
+        "rom:/Assets/Textures/Player.PNG",
+        "rom:/assets/textures/player.png",
+        "ROM:/ASSETS/TEXTURES/PLAYER.PNG",
+        "rom:\\Assets\\Textures\\player.Png"
+    };
+    for (auto path : textureSpellings)
+    {
+        ASSET_DATA data = {};
+        CHECK(vfs.HasAsset(path));
+        CHECK(vfs.ReadAsset(path, &data));
+        CHECK(SameBytes(data, texture));
+
+        StringID pathID = vfs.ResolveAssetPath(path);
+        CHECK(vfs.HasAssetByID(pathID));
+        CHECK(vfs.ReadAssetByID(pathID, &data));
+        CHECK(SameBytes(data, texture));
+    }
+
+    // uncompressed entries come straight from the mapping
+    ASSET_DATA data = {};
+    CHECK(vfs.ReadAssetByID(vfs.ResolveAssetPath(
+        "rom:/configs/LEVEL-01.JSON"), &data));
+    CHECK(SameBytes(data, config));
+    CHECK(data.Storage.empty());
+
+    VFS_STATISTICS stats = vfs.GetStatistics();
+    CHECK(stats.ArchiveReads == 9);
+    CHECK(stats.LooseReads == 0);
+    CHECK(stats.FailedReads == 0);
+    CHECK(stats.DecompressedBytes == 8ull * texture.size());
+
+    vfs.UnmountAllArchives();
+    std::remove(ARCHIVE_PATH.c_str());
+}
+
+TEST_CASE(AssetArchive_LaterArchivesOverrideEarlierOnes)
+{
+    REQUIRE(WriteTestArchive());
+    AssetArchiveWriter writer = {};
+    REQUIRE(writer.AddEntry("ROM:/configs/level-01.json",
+        MakeTextBytes("{\"lv\":2}"), false));
+    REQUIRE(writer.WriteArchive(OVERRIDE_PATH));
+
+    VirtualFileSystem vfs = {};
+    REQUIRE(vfs.MountArchive(ARCHIVE_PATH));
+    REQUIRE(vfs.MountArchive(OVERRIDE_PATH));
+
+    ASSET_DATA data = {};
+    CHECK(vfs.ReadAsset(CONFIG_PATH, &data));
+    CHECK(SameBytes(data, MakeTextBytes("{\"lv\":2}")));
+    CHECK(vfs.ReadAsset(TEXTURE_PATH, &data));
+    CHECK(SameBytes(data, MakeTextureBytes()));
+
+    vfs.UnmountAllArchives();
+    std::remove(ARCHIVE_PATH.c_str());
+    std::remove(OVERRIDE_PATH.c_str());
+}
+
+TEST_CASE(AssetArchive_MissingEntriesFallBackToLooseFiles)
+{
+    REQUIRE(WriteTestArchive());
+    VirtualFileSystem vfs = {};
+    CHECK(!vfs.MountArchive("no-such-archive.hpak"));
+    REQUIRE(vfs.MountArchive(ARCHIVE_PATH));
+
+    // the loose copy in the working tree is read from disk
+    ASSET_DATA data = {};
+    StringID looseID = vfs.ResolveAssetPath("rom:/Configs/moji.json");
+    CHECK(vfs.HasAssetByID(looseID));
+    CHECK(vfs.ReadAssetByID(looseID, &data));
+    CHECK(data.Size != 0);
+    CHECK(data.Data == data.Storage.data());
+
+    CHECK(!vfs.HasAsset("rom:/Configs/missing.json"));
+    CHECK(!vfs.ReadAsset("rom:/Configs/missing.json", &data));
+    CHECK(!vfs.HasAssetByID(StringID("never-resolved")));
+    CHECK(!vfs.ReadAssetByID(StringID("never-resolved"), &data));
+    CHECK(data.Data == nullptr);
+
+    VFS_STATISTICS stats = vfs.GetStatistics();
+    CHECK(stats.LooseReads == 1);
+    CHECK(stats.FailedReads == 2);
+
+    vfs.UnmountAllArchives();
+    std::remove(ARCHIVE_PATH.c_str());
+}
+
+TEST_CASE(AssetArchive_BenchPathAndIDLookups)
+{
+    const int entryNum = 2000;
+    const int lookupNum = 500000;
+    AssetArchiveWriter writer = {};
+    std::vector<std::string> paths = {};
+    for (int i = 0; i < entryNum; i++)
+    {
+        paths.push_back("rom:/Assets/Textures/Tile_" +
+            std::to_string(i) + ".PNG");
+        writer.AddEntry(paths.back(),
+            MakeTextBytes(std::to_string(i)), false);
+    }
+    REQUIRE(writer.WriteArchive(ARCHIVE_PATH));
+
+    VirtualFileSystem vfs = {};
+    REQUIRE(vfs.MountArchive(ARCHIVE_PATH));
+    std::vector<StringID> ids = {};
+    for (auto& path : paths)
+    {
+        ids.push_back(vfs.ResolveAssetPath(path));
+    }
+
+    ASSET_DATA data = {};
+    size_t total = 0;
+    BenchTimer timer = {};
+    timer.ResetTimer();
+    size_t allocs = GetAllocationCount();
+    for (int i = 0; i < lookupNum; i++)
+    {
+        vfs.ReadAsset(paths[(size_t)i % entryNum], &data);
+        total += data.Size;
+    }
+    size_t pathAllocs = GetAllocationCount() - allocs;
+    double pathMs = timer.GetElapsedMs();
+
+    timer.ResetTimer();
+    allocs = GetAllocationCount();
+    for (int i = 0; i < lookupNum; i++)
+    {
+        vfs.ReadAssetByID(ids[(size_t)i % entryNum], &data);
+        total += data.Size;
+    }
+    size_t idAllocs = GetAllocationCount() - allocs;
+    double idMs = timer.GetElapsedMs();
+
+    BENCH_LOG("%d lookups in %d entries, path %.2f ms (%zu "
+        "allocations), id %.2f ms (%zu allocations), %zu bytes\n",
+        lookupNum, entryNum, pathMs, pathAllocs, idMs, idAllocs,
+        total);
+    CHECK(idAllocs == 0);
+
+    vfs.UnmountAllArchives();
+    std::remove(ARCHIVE_PATH.c_str());
+}
+
+TEST_CASE(AssetArchive_BenchShippedSceneLoadColdAndWarm)
+{
+    const std::string scene = "rom:/Configs/Scenes/1-scene.json";
+    const int warmRounds = 20;
+    std::vector<std::string> paths = {};
+    std::vector<std::string> spellings = {};
+    AssetArchiveWriter writer = {};
+    for (auto& path : CollectSceneAssets(scene))
+    {
+        std::string spelling = FindLooseSpelling(path);
+        ASSET_DATA data = {};
+        VirtualFileSystem loose = {};
+        if (spelling == "" || !loose.ReadAsset(spelling, &data))
+        {
+            continue;
+        }
+        paths.push_back(path);
+        spellings.push_back(spelling);
+        REQUIRE(writer.AddEntry(spelling, std::vector<unsigned char>(
+            data.Data, data.Data + data.Size), true));
+    }
+    REQUIRE(paths.size() >= 4);
+    REQUIRE(writer.WriteArchive(ARCHIVE_PATH));
+
+    // the loose reads go through the spelling on disk, the archive is
+    // asked with the spelling from the scene like the game does
+    auto loadLoose = [&](size_t* _bytes)
+    {
+        VirtualFileSystem vfs = {};
+        ASSET_DATA data = {};
+        bool all = true;
+        for (auto& spelling : spellings)
+        {
+            all = vfs.ReadAsset(spelling, &data) && all;
+            *_bytes += data.Size;
+        }
+        return all;
+    };
+    auto loadArchive = [&](size_t* _bytes)
+    {
+        VirtualFileSystem vfs = {};
+        ASSET_DATA data = {};
+        bool all = vfs.MountArchive(ARCHIVE_PATH);
+        for (auto& path : paths)
+        {
+            all = vfs.ReadAsset(path, &data) && all;
+            *_bytes += data.Size;
+        }
+        all = all && vfs.GetStatistics().LooseReads == 0;
+        vfs.UnmountAllArchives();
+        return all;
+    };
+
+    bool cold = true;
+    for (auto& spelling : spellings)
+    {
+        cold = DropFileCache(MakeLooseAssetPath(spelling)) && cold;
+    }
+    size_t looseBytes = 0;
+    BenchTimer timer = {};
+    CHECK(loadLoose(&looseBytes));
+    double looseColdMs = timer.GetElapsedMs();
+
+    cold = DropFileCache(ARCHIVE_PATH) && cold;
+    size_t archiveBytes = 0;
+    timer.ResetTimer();
+    CHECK(loadArchive(&archiveBytes));
+    double archiveColdMs = timer.GetElapsedMs();
+    CHECK(looseBytes == archiveBytes);
+
+    size_t bytes = 0;
+    timer.ResetTimer();
+    for (int i = 0; i < warmRounds; i++)
+    {
+        loadLoose(&bytes);
+    }
+    double looseWarmMs = timer.GetElapsedMs() / warmRounds;
+    timer.ResetTimer();
+    for (int i = 0; i < warmRounds; i++)
+    {
+        loadArchive(&bytes);
+    }
+    double archiveWarmMs = timer.GetElapsedMs() / warmRounds;
+
+    BENCH_LOG("%s: %zu files, %zu bytes, loose %.3f ms cold %.3f ms "
+        "warm, archive %.3f ms cold %.3f ms warm%s\n", scene.c_str(),
+        paths.size(), looseBytes, looseColdMs, looseWarmMs,
+        archiveColdMs, archiveWarmMs,
+        cold ? "" : " (page cache not dropped)");
+
+    std::remove(ARCHIVE_PATH.c_str());
+}
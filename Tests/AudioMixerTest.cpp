@@ -0,0 +1,292 @@
+﻿//---------------------------------------------------------------
+// File: AudioMixerTest.cpp
+// Proj: HycFrame2D
+// Info: オーディオミキサーのテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "AudioMixer.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const std::string WAV_PATH = "audio-mixer-test.wav";
+    const unsigned int BLOCK = AUDIO_MIX_BLOCK_FRAMES;
+
+    SoundClip MakeConstantClip(size_t _frames, short _value)
+    {
+        std::vector<short> samples(_frames, _value);
+        SoundClip clip = {};
+        clip.CreateFromPcm16(samples.data(), _frames, 1,
+            AUDIO_MIX_RATE);
+
+        return clip;
+    }
+
+    bool NearlyEqual(float _a, float _b)
+    {
+        return std::fabs(_a - _b) < 1e-3f;
+    }
+
+    VOICE_DESC MakeDesc(float _volume, unsigned int _priority,
+        bool _loop)
+    {
+        VOICE_DESC desc = {};
+        desc.Volume = _volume;
+        desc.Priority = _priority;
+        desc.LoopFlg = _loop;
+
+        return desc;
+    }
+}
+
+TEST_CASE(AudioMixer_VoicesRampInAndFollowThePan)
+{
+    SoundClip clip = MakeConstantClip(BLOCK * 8, 16384);
+    AudioMixer mixer = {};
+    VOICE_DESC center = MakeDesc(1.f, AUDIO_PRIORITY_SE, true);
+    VOICE_DESC left = center;
+    left.Pan = -1.f;
+    VOICE_HANDLE a = mixer.PlayVoice(&clip, center);
+    CHECK(a != NULL_VOICE_HANDLE);
+    CHECK(mixer.GetVoiceState(a) == VOICE_STATE::VIRTUAL);
+
+    // the first block ramps up from silence so nothing clicks
+    std::vector<float> out(BLOCK * AUDIO_MIX_CHANNELS);
+    mixer.MixFrames(out.data(), BLOCK);
+    CHECK(mixer.GetVoiceState(a) == VOICE_STATE::REAL);
+    CHECK(NearlyEqual(out[0], 0.f));
+    CHECK(out[(BLOCK / 2) * 2] > 0.2f && out[(BLOCK / 2) * 2] < 0.3f);
+
+    mixer.MixFrames(out.data(), BLOCK);
+    CHECK(NearlyEqual(out[0], 0.5f));
+    CHECK(NearlyEqual(out[1], 0.5f));
+
+    mixer.StopVoice(a);
+    VOICE_HANDLE b = mixer.PlayVoice(&clip, left);
+    mixer.MixFrames(out.data(), BLOCK);
+    mixer.MixFrames(out.data(), BLOCK);
+    CHECK(NearlyEqual(out[0], 0.5f));
+    CHECK(NearlyEqual(out[1], 0.f));
+
+    mixer.SetVoiceVolume(b, 0.5f);
+    mixer.SetMasterVolume(0.5f);
+    mixer.MixFrames(out.data(), BLOCK);
+    mixer.MixFrames(out.data(), BLOCK);
+    CHECK(NearlyEqual(out[0], 0.125f));
+}
+
+TEST_CASE(AudioMixer_OnlyTheLoudestVoicesAreReal)
+{
+    SoundClip clip = MakeConstantClip(BLOCK * 8, 1000);
+    AudioMixer mixer = {};
+    mixer.SetRealVoiceLimit(4);
+    std::vector<VOICE_HANDLE> quietSe = {};
+    for (int i = 0; i < 6; i++)
+    {
+        quietSe.push_back(mixer.PlayVoice(&clip,
+            MakeDesc(0.2f, AUDIO_PRIORITY_SE, true)));
+    }
+    VOICE_HANDLE loudSe = mixer.PlayVoice(&clip,
+        MakeDesc(0.9f, AUDIO_PRIORITY_SE, true));
+    VOICE_HANDLE bgm = mixer.PlayVoice(&clip,
+        MakeDesc(0.1f, AUDIO_PRIORITY_BGM, true));
+    VOICE_HANDLE inaudible = mixer.PlayVoice(&clip,
+        MakeDesc(AUDIO_VIRTUAL_VOLUME * 0.5f, AUDIO_PRIORITY_BGM,
+            true));
+
+    std::vector<float> out(BLOCK * AUDIO_MIX_CHANNELS);
+    mixer.MixFrames(out.data(), BLOCK);
+    CHECK(mixer.GetVoiceState(bgm) == VOICE_STATE::REAL);
+    CHECK(mixer.GetVoiceState(loudSe) == VOICE_STATE::REAL);
+    CHECK(mixer.GetVoiceState(inaudible) == VOICE_STATE::VIRTUAL);
+
+    // among equal voices the newest ones win the last two slots
+    unsigned int realSe = 0;
+    for (auto handle : quietSe)
+    {
+        realSe += mixer.GetVoiceState(handle) == VOICE_STATE::REAL;
+    }
+    CHECK(realSe == 2);
+    CHECK(mixer.GetVoiceState(quietSe[5]) == VOICE_STATE::REAL);
+    CHECK(mixer.GetVoiceState(quietSe[0]) == VOICE_STATE::VIRTUAL);
+
+    MIXER_STATISTICS stats = mixer.GetStatistics();
+    CHECK(stats.RealVoices == 4);
+    CHECK(stats.VirtualVoices == 5);
+    CHECK(stats.PeakVoices == 9);
+    CHECK(stats.MixedFrames == BLOCK);
+}
+
+TEST_CASE(AudioMixer_OneShotsEndEvenWhenVirtual)
+{
+    SoundClip shortClip = MakeConstantClip(BLOCK + BLOCK / 2, 1000);
+    AudioMixer mixer = {};
+    mixer.SetRealVoiceLimit(1);
+    VOICE_HANDLE real = mixer.PlayVoice(&shortClip,
+        MakeDesc(1.f, AUDIO_PRIORITY_SE, false));
+    VOICE_HANDLE hidden = mixer.PlayVoice(&shortClip,
+        MakeDesc(0.5f, AUDIO_PRIORITY_SE, false));
+    VOICE_HANDLE loop = mixer.PlayVoice(&shortClip,
+        MakeDesc(0.5f, AUDIO_PRIORITY_SE, true));
+
+    std::vector<float> out(BLOCK * AUDIO_MIX_CHANNELS * 4);
+    mixer.MixFrames(out.data(), BLOCK);
+    CHECK(mixer.GetVoiceState(real) == VOICE_STATE::REAL);
+    CHECK(mixer.GetVoiceState(hidden) == VOICE_STATE::VIRTUAL);
+
+    mixer.MixFrames(out.data(), BLOCK);
+    CHECK(mixer.GetVoiceState(real) == VOICE_STATE::STOPPED);
+    CHECK(mixer.GetVoiceState(hidden) == VOICE_STATE::STOPPED);
+    CHECK(mixer.GetVoiceState(loop) != VOICE_STATE::STOPPED);
+
+    // the rest of the one-shot block is silence
+    CHECK(out[(BLOCK - 1) * 2] == 0.f);
+
+    mixer.MixFrames(out.data(), BLOCK * 4);
+    CHECK(mixer.GetVoiceState(loop) != VOICE_STATE::STOPPED);
+    mixer.StopVoicesOfClip(&shortClip);
+    CHECK(mixer.GetVoiceState(loop) == VOICE_STATE::STOPPED);
+}
+
+TEST_CASE(AudioMixer_StaleHandlesAndStealing)
+{
+    SoundClip clip = MakeConstantClip(BLOCK, 1000);
+    AudioMixer mixer = {};
+    VOICE_HANDLE old = mixer.PlayVoice(&clip,
+        MakeDesc(1.f, AUDIO_PRIORITY_SE, true));
+    mixer.StopVoice(old);
+    VOICE_HANDLE reused = mixer.PlayVoice(&clip,
+        MakeDesc(1.f, AUDIO_PRIORITY_SE, true));
+    CHECK(reused != old);
+    CHECK(mixer.GetVoiceState(old) == VOICE_STATE::STOPPED);
+    CHECK(mixer.GetVoiceState(reused) != VOICE_STATE::STOPPED);
+
+    // a stale handle must not touch the voice now in its slot
+    mixer.StopVoice(old);
+    CHECK(mixer.GetVoiceState(reused) != VOICE_STATE::STOPPED);
+    CHECK(mixer.PlayVoice(nullptr, VOICE_DESC()) == NULL_VOICE_HANDLE);
+
+    for (int i = 1; i < AUDIO_MAX_VOICE_NUM; i++)
+    {
+        mixer.PlayVoice(&clip, MakeDesc(1.f, AUDIO_PRIORITY_SE, true));
+    }
+    CHECK(mixer.PlayVoice(&clip, MakeDesc(1.f, 1, true)) ==
+        NULL_VOICE_HANDLE);
+
+    // the oldest voice of the lowest priority makes room
+    VOICE_HANDLE bgm = mixer.PlayVoice(&clip,
+        MakeDesc(1.f, AUDIO_PRIORITY_BGM, true));
+    CHECK(bgm != NULL_VOICE_HANDLE);
+    CHECK(mixer.GetVoiceState(reused) == VOICE_STATE::STOPPED);
+    CHECK(mixer.GetStatistics().StolenVoices == 1);
+    CHECK(mixer.GetStatistics().PeakVoices == AUDIO_MAX_VOICE_NUM);
+
+    mixer.StopAllVoices();
+    CHECK(mixer.GetVoiceState(bgm) == VOICE_STATE::STOPPED);
+}
+
+TEST_CASE(AudioMixer_WavSinkWritesAFloatWave)
+{
+    std::vector<float> frames(1000 * AUDIO_MIX_CHANNELS, 0.25f);
+    {
+        WavFileSink sink = {};
+        REQUIRE(sink.OpenWavFile(WAV_PATH));
+        sink.WriteFrames(frames.data(), 600);
+        sink.WriteFrames(frames.data(), 400);
+        sink.CloseWavFile();
+        sink.WriteFrames(frames.data(), 400);
+    }
+
+    std::ifstream file(WAV_PATH, std::ios::binary);
+    REQUIRE(file.is_open());
+    std::vector<unsigned char> bytes(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+    file.close();
+    std::remove(WAV_PATH.c_str());
+    size_t size = bytes.size();
+
+    const unsigned int dataSize = 1000 * sizeof(float) * 2;
+    REQUIRE(size == 44 + dataSize);
+    unsigned int riffSize = 0;
+    unsigned short formatTag = 0;
+    unsigned short channels = 0;
+    unsigned int rate = 0;
+    unsigned int storedData = 0;
+    memcpy(&riffSize, &bytes[4], 4);
+    memcpy(&formatTag, &bytes[20], 2);
+    memcpy(&channels, &bytes[22], 2);
+    memcpy(&rate, &bytes[24], 4);
+    memcpy(&storedData, &bytes[40], 4);
+    CHECK(!memcmp(&bytes[0], "RIFF", 4));
+    CHECK(!memcmp(&bytes[8], "WAVEfmt ", 8));
+    CHECK(!memcmp(&bytes[36], "data", 4));
+    CHECK(riffSize == dataSize + 36);
+    CHECK(formatTag == 3);
+    CHECK(channels == AUDIO_MIX_CHANNELS);
+    CHECK(rate == AUDIO_MIX_RATE);
+    CHECK(storedData == dataSize);
+
+    float first = 0.f;
+    memcpy(&first, &bytes[44], sizeof(first));
+    CHECK(first == 0.25f);
+}
+
+TEST_CASE(AudioMixer_Bench256Voices)
+{
+    const int voiceNum = 256;
+    const unsigned int realLimit = 230;
+    const int blockNum = 1000;
+    std::vector<short> samples(AUDIO_MIX_RATE * 2);
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        samples[i] = (short)(std::sin((float)i * 0.05f) * 8000.f);
+    }
+    SoundClip stereo = {};
+    SoundClip mono = {};
+    stereo.CreateFromPcm16(samples.data(), samples.size() / 2, 2,
+        AUDIO_MIX_RATE);
+    mono.CreateFromPcm16(samples.data(), samples.size(), 1,
+        AUDIO_MIX_RATE);
+
+    AudioMixer mixer = {};
+    mixer.SetRealVoiceLimit(realLimit);
+    for (int i = 0; i < voiceNum; i++)
+    {
+        VOICE_DESC desc = MakeDesc(0.1f + (float)(i % 9) * 0.1f,
+            AUDIO_PRIORITY_SE, true);
+        desc.Pan = (float)(i % 5) * 0.5f - 1.f;
+        mixer.PlayVoice((i & 1) ? &stereo : &mono, desc);
+    }
+
+    std::vector<float> out(BLOCK * AUDIO_MIX_CHANNELS);
+    mixer.MixFrames(out.data(), BLOCK);
+
+    BenchTimer timer = {};
+    timer.ResetTimer();
+    size_t allocs = GetAllocationCount();
+    for (int b = 0; b < blockNum; b++)
+    {
+        mixer.MixFrames(out.data(), BLOCK);
+    }
+    allocs = GetAllocationCount() - allocs;
+    double elapsed = timer.GetElapsedMs();
+
+    MIXER_STATISTICS stats = mixer.GetStatistics();
+    BENCH_LOG("%d voices, %u real, %.4f ms per %u frame block "
+        "(%.1f ms of audio), %zu allocations\n", voiceNum,
+        stats.RealVoices, elapsed / blockNum, BLOCK,
+        BLOCK * 1000.0 / AUDIO_MIX_RATE, allocs);
+    CHECK(stats.RealVoices == realLimit);
+    CHECK(stats.VirtualVoices == voiceNum - realLimit);
+    CHECK(allocs == 0);
+}
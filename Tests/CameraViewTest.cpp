@@ -0,0 +1,148 @@
+﻿//---------------------------------------------------------------
+// File: CameraViewTest.cpp
+// Proj: HycFrame2D
+// Info: カメラのビュー行列化のテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "HeadlessScene.h"
+#include "SceneNode.h"
+#include "ActorObject.h"
+#include "ATransformComponent.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+    const Float2 CAMERA_SIZE = MakeFloat2(1920.f, 1080.f);
+
+    // the first command of a frame is the camera view, the matrix is
+    // stored transposed so the translation sits in the last column
+    Float2 GetDrawnViewOffset(HeadlessScene* _scene)
+    {
+        auto backend = _scene->GetRenderBackend();
+        const RENDER_COMMAND& cmd = backend->GetLastCommandArray()->
+            front();
+        const RENDER_MATRIX& view =
+            (*(backend->GetLastTransformArray()))[cmd.Transform];
+
+        return MakeFloat2(view._14, view._24);
+    }
+
+    unsigned int CountDirtyTransforms(
+        const std::vector<ActorObject*>& _actors)
+    {
+        unsigned int dirty = 0;
+        for (auto& actor : _actors)
+        {
+            if (actor->GetAComponent<ATransformComponent>(
+                COMP_TYPE::ATRANSFORM)->IsWorldMatrixDirty())
+            {
+                ++dirty;
+            }
+        }
+
+        return dirty;
+    }
+}
+
+TEST_CASE(CameraView_ScrollOnlyChangesTheView)
+{
+    HeadlessScene scene = {};
+    scene.GetSceneNode()->InitCamera(MakeFloat2(0.f, 0.f), CAMERA_SIZE);
+    std::vector<ActorObject*> actors = {};
+    for (int i = 0; i < 10; i++)
+    {
+        actors.push_back(scene.AddSpriteActor(
+            "static-" + std::to_string(i),
+            MakeFloat3(100.f * (float)i, 50.f, 0.f),
+            MakeFloat2(32.f, 32.f), 0));
+    }
+    scene.RunFrame(MAX_DELTA);
+    CHECK(CountDirtyTransforms(actors) == 0);
+    std::vector<RENDER_MATRIX> before =
+        *(scene.GetRenderBackend()->GetLastTransformArray());
+
+    scene.GetSceneNode()->GetCamera()->TranslateCameraPos(
+        MakeFloat2(120.f, -40.f));
+    CHECK(CountDirtyTransforms(actors) == 0);
+    scene.RunFrame(MAX_DELTA);
+
+    Float2 offset = GetDrawnViewOffset(&scene);
+    CHECK(offset.x == -120.f);
+    CHECK(offset.y == 40.f);
+    const std::vector<RENDER_MATRIX>& after =
+        *(scene.GetRenderBackend()->GetLastTransformArray());
+    REQUIRE(after.size() == before.size());
+    // every world matrix after the view is the same as before
+    for (size_t i = 1; i < after.size(); i++)
+    {
+        CHECK(after[i]._14 == before[i]._14);
+        CHECK(after[i]._24 == before[i]._24);
+    }
+}
+
+TEST_CASE(CameraView_MovingOneActorDirtiesOnlyItsTransform)
+{
+    HeadlessScene scene = {};
+    scene.GetSceneNode()->InitCamera(MakeFloat2(0.f, 0.f), CAMERA_SIZE);
+    std::vector<ActorObject*> actors = {};
+    for (int i = 0; i < 5; i++)
+    {
+        actors.push_back(scene.AddSpriteActor(
+            "actor-" + std::to_string(i), MakeFloat3(0.f, 0.f, 0.f),
+            MakeFloat2(16.f, 16.f), 0));
+    }
+    scene.RunFrame(MAX_DELTA);
+
+    ATransformComponent* atc = actors[2]->
+        GetAComponent<ATransformComponent>(COMP_TYPE::ATRANSFORM);
+    atc->Translate(MakeFloat3(5.f, 0.f, 0.f));
+    CHECK(CountDirtyTransforms(actors) == 1);
+    CHECK(atc->IsWorldMatrixDirty());
+    CHECK(atc->GetWorldMatrix()._14 == 5.f);
+    CHECK(!atc->IsWorldMatrixDirty());
+}
+
+TEST_CASE(CameraView_BenchScrollOverStaticActors)
+{
+    const int side = 142;
+    const int frames = 200;
+    HeadlessScene scene = {};
+    scene.GetSceneNode()->InitCamera(MakeFloat2(0.f, 0.f), CAMERA_SIZE);
+    std::vector<ActorObject*> actors = {};
+    for (int y = 0; y < side; y++)
+    {
+        for (int x = 0; x < side; x++)
+        {
+            actors.push_back(scene.AddSpriteActor(
+                "tile-" + std::to_string(y * side + x),
+                MakeFloat3(40.f * (float)x, 40.f * (float)y, 0.f),
+                MakeFloat2(40.f, 40.f), 0));
+        }
+    }
+    scene.RunFrame(MAX_DELTA);
+    // culled actors build their matrix lazily, so build them all once
+    for (auto& actor : actors)
+    {
+        actor->GetAComponent<ATransformComponent>(
+            COMP_TYPE::ATRANSFORM)->GetWorldMatrix();
+    }
+
+    Camera* camera = scene.GetSceneNode()->GetCamera();
+    unsigned int dirty = 0;
+    BenchTimer timer = {};
+    for (int i = 0; i < frames; i++)
+    {
+        camera->TranslateCameraPos(MakeFloat2(12.f, 6.f));
+        scene.RunFrame(MAX_DELTA);
+        dirty += CountDirtyTransforms(actors);
+    }
+
+    BENCH_LOG("%zu static actors, %.4f ms per scrolled frame, %u "
+        "transforms dirtied by the camera\n", actors.size(),
+        timer.GetElapsedMs() / frames, dirty);
+    CHECK(dirty == 0);
+}
@@ -0,0 +1,274 @@
+﻿//---------------------------------------------------------------
+// File: DdsTextureTest.cpp
+// Proj: HycFrame2D
+// Info: テクスチャクッカーとDDS読み込みのテスト
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "DdsTexture.h"
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+    void PushBigEndian(std::vector<unsigned char>* _out,
+        unsigned int _value)
+    {
+        for (int i = 3; i >= 0; i--)
+        {
+            _out->push_back((unsigned char)(_value >> (i * 8)));
+        }
+    }
+
+    unsigned int GetCrc32(const unsigned char* _data, size_t _size)
+    {
+        unsigned int crc = 0xFFFFFFFFu;
+        for (size_t i = 0; i < _size; i++)
+        {
+            crc ^= _data[i];
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+            }
+        }
+
+        return crc ^ 0xFFFFFFFFu;
+    }
+
+    void PushPngChunk(std::vector<unsigned char>* _out,
+        const char* _type, const std::vector<unsigned char>& _data)
+    {
+        PushBigEndian(_out, (unsigned int)_data.size());
+        size_t start = _out->size();
+        _out->insert(_out->end(), _type, _type + 4);
+        _out->insert(_out->end(), _data.begin(), _data.end());
+        PushBigEndian(_out, GetCrc32(_out->data() + start,
+            _out->size() - start));
+    }
+
+    // an rgba8 png whose zlib stream only uses stored blocks, which
+    // is enough for the cooker to decode
+    std::vector<unsigned char> EncodePng(unsigned int _width,
+        unsigned int _height, const std::vector<unsigned char>& _rgba)
+    {
+        std::vector<unsigned char> raw = {};
+        for (unsigned int y = 0; y < _height; y++)
+        {
+            raw.push_back(0);
+            size_t row = (size_t)y * _width * 4;
+            raw.insert(raw.end(), _rgba.begin() + row,
+                _rgba.begin() + row + (size_t)_width * 4);
+        }
+
+        std::vector<unsigned char> zlib = { 0x78, 0x01, 0x01 };
+        unsigned short len = (unsigned short)raw.size();
+        zlib.push_back((unsigned char)(len & 0xFF));
+        zlib.push_back((unsigned char)(len >> 8));
+        zlib.push_back((unsigned char)(~len & 0xFF));
+        zlib.push_back((unsigned char)((unsigned short)~len >> 8));
+        zlib.insert(zlib.end(), raw.begin(), raw.end());
+        unsigned int a = 1;
+        unsigned int b = 0;
+        for (auto c : raw)
+        {
+            a = (a + c) % 65521;
+            b = (b + a) % 65521;
+        }
+        PushBigEndian(&zlib, (b << 16) | a);
+
+        std::vector<unsigned char> ihdr = {};
+        PushBigEndian(&ihdr, _width);
+        PushBigEndian(&ihdr, _height);
+        ihdr.insert(ihdr.end(), { 8, 6, 0, 0, 0 });
+
+        std::vector<unsigned char> png =
+            { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+        PushPngChunk(&png, "IHDR", ihdr);
+        PushPngChunk(&png, "IDAT", zlib);
+        PushPngChunk(&png, "IEND", {});
+
+        return png;
+    }
+
+    std::vector<unsigned char> MakeSolidImage(unsigned int _width,
+        unsigned int _height, unsigned char _r, unsigned char _g,
+        unsigned char _b, unsigned char _a)
+    {
+        std::vector<unsigned char> rgba = {};
+        for (unsigned int i = 0; i < _width * _height; i++)
+        {
+            rgba.insert(rgba.end(), { _r, _g, _b, _a });
+        }
+
+        return rgba;
+    }
+
+    std::vector<unsigned char> ReadFileBytes(const std::string& _file)
+    {
+        std::ifstream file(_file, std::ios::binary);
+        return std::vector<unsigned char>(
+            std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>());
+    }
+
+    // the color of the first texel of a bc1 or bc3 color block
+    void DecodeFirstTexel(const unsigned char* _block,
+        unsigned char _rgb[3])
+    {
+        unsigned short c[2] = {
+            (unsigned short)(_block[0] | (_block[1] << 8)),
+            (unsigned short)(_block[2] | (_block[3] << 8)) };
+        int endpoints[2][3] = {};
+        for (int i = 0; i < 2; i++)
+        {
+            endpoints[i][0] = ((c[i] >> 11) & 31) * 255 / 31;
+            endpoints[i][1] = ((c[i] >> 5) & 63) * 255 / 63;
+            endpoints[i][2] = (c[i] & 31) * 255 / 31;
+        }
+
+        unsigned int index = _block[4] & 3;
+        for (int ch = 0; ch < 3; ch++)
+        {
+            int e0 = endpoints[0][ch];
+            int e1 = endpoints[1][ch];
+            int value = index == 0 ? e0 : index == 1 ? e1 :
+                c[0] > c[1] ?
+                (index == 2 ? (2 * e0 + e1) / 3 : (e0 + 2 * e1) / 3) :
+                (index == 2 ? (e0 + e1) / 2 : 0);
+            _rgb[ch] = (unsigned char)value;
+        }
+    }
+
+    // the alpha of the first texel of a bc3 alpha block
+    unsigned char DecodeFirstAlpha(const unsigned char* _block)
+    {
+        int a0 = _block[0];
+        int a1 = _block[1];
+        int index = _block[2] & 7;
+        if (index < 2)
+        {
+            return (unsigned char)(index ? a1 : a0);
+        }
+        if (a0 > a1)
+        {
+            return (unsigned char)(((8 - index) * a0 +
+                (index - 1) * a1) / 7);
+        }
+
+        return (unsigned char)(index == 6 ? 0 : index == 7 ? 255 :
+            ((6 - index) * a0 + (index - 1) * a1) / 5);
+    }
+}
+
+TEST_CASE(DdsTexture_HeaderRoundTrips)
+{
+    const DDS_FORMAT formats[] =
+        { DDS_FORMAT::BC1, DDS_FORMAT::BC3, DDS_FORMAT::BC7 };
+    for (auto format : formats)
+    {
+        std::vector<unsigned char> file = {};
+        WriteDdsHeader(format, 64, 32, 7, &file);
+        size_t header = file.size();
+        size_t levels = 0;
+        for (unsigned int w = 64, h = 32, i = 0; i < 7; i++)
+        {
+            levels += GetDdsLevelSize(format, w, h);
+            w = w > 1 ? w / 2 : 1;
+            h = h > 1 ? h / 2 : 1;
+        }
+        file.resize(header + levels);
+
+        DDS_TEXTURE_INFO info = {};
+        REQUIRE(ParseDdsTexture(file.data(), file.size(), &info));
+        CHECK(info.Format == format);
+        CHECK(info.Width == 64);
+        CHECK(info.Height == 32);
+        CHECK(info.MipCount == 7);
+        CHECK(info.DataOffset == header);
+        CHECK(info.DataSize == levels);
+
+        // a cut off mip chain is refused instead of read past the end
+        CHECK(!ParseDdsTexture(file.data(), file.size() - 1, &info));
+    }
+
+    CHECK(GetDdsLevelSize(DDS_FORMAT::BC1, 8, 8) == 32);
+    CHECK(GetDdsLevelSize(DDS_FORMAT::BC3, 2, 1) == 16);
+    CHECK(MakeCookedTexturePath("rom:/Assets/Textures/player.PNG") ==
+        "rom:/Assets/Textures/player.dds");
+    CHECK(MakeCookedTexturePath("rom:/a.b/noext") ==
+        "rom:/a.b/noext.dds");
+}
+
+#ifdef TEX_COOKER_PATH
+TEST_CASE(DdsTexture_CookerPicksBc1AndBc3)
+{
+    namespace fs = std::filesystem;
+    const fs::path dir = "dds-cooker-test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    // opaque red, a soft alpha green, and one that isn't block sized
+    struct SOURCE
+    {
+        const char* Name;
+        unsigned int Size;
+        unsigned char Alpha;
+    };
+    const SOURCE sources[] =
+    {
+        { "opaque", 8, 255 },
+        { "soft", 8, 128 },
+        { "odd", 6, 255 }
+    };
+    for (auto& source : sources)
+    {
+        std::vector<unsigned char> rgba = MakeSolidImage(source.Size,
+            source.Size, source.Alpha == 255 ? 255 : 0,
+            source.Alpha == 255 ? 0 : 255, 0, source.Alpha);
+        std::vector<unsigned char> png =
+            EncodePng(source.Size, source.Size, rgba);
+        std::ofstream file(dir / (std::string(source.Name) + ".png"),
+            std::ios::binary);
+        file.write((const char*)png.data(), png.size());
+    }
+
+    std::string command = std::string("\"") + TEX_COOKER_PATH +
+        "\" " + dir.string() + " > " + (dir / "cook.log").string();
+    REQUIRE(std::system(command.c_str()) == 0);
+
+    DDS_TEXTURE_INFO info = {};
+    std::vector<unsigned char> opaque =
+        ReadFileBytes((dir / "opaque.dds").string());
+    REQUIRE(ParseDdsTexture(opaque.data(), opaque.size(), &info));
+    CHECK(info.Format == DDS_FORMAT::BC1);
+    CHECK(info.Width == 8);
+    CHECK(info.MipCount == 1);
+    CHECK(info.DataSize == 32);
+    unsigned char rgb[3] = {};
+    DecodeFirstTexel(opaque.data() + info.DataOffset, rgb);
+    CHECK(rgb[0] == 255 && rgb[1] == 0 && rgb[2] == 0);
+
+    std::vector<unsigned char> soft =
+        ReadFileBytes((dir / "soft.dds").string());
+    REQUIRE(ParseDdsTexture(soft.data(), soft.size(), &info));
+    CHECK(info.Format == DDS_FORMAT::BC3);
+    CHECK(info.DataSize == 64);
+    const unsigned char* block = soft.data() + info.DataOffset;
+    unsigned char alpha = DecodeFirstAlpha(block);
+    CHECK(alpha >= 126 && alpha <= 130);
+    DecodeFirstTexel(block + 8, rgb);
+    CHECK(rgb[0] == 0 && rgb[1] == 255 && rgb[2] == 0);
+
+    // the runtime keeps using the png when there is no dds
+    CHECK(!fs::exists(dir / "odd.dds"));
+
+    fs::remove_all(dir);
+}
+#endif
@@ -0,0 +1,167 @@
+﻿//---------------------------------------------------------------
+// File: EventBusTest.cpp
+// Proj: HycFrame2D
+// Info: イベントバスのテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "HeadlessScene.h"
+#include "SceneNode.h"
+#include "ActorObject.h"
+#include "EventBus.h"
+#include <vector>
+
+namespace
+{
+    struct HIT_EVENT
+    {
+        int Damage;
+        Float2 Position;
+    };
+
+    std::vector<int> g_ReceivedDamage = {};
+
+    unsigned long long g_ReceivedCount = 0;
+
+    EventBus* g_BusInHandler = nullptr;
+
+    void OnHit(Object* _receiver, const EVENT_MESSAGE& _msg)
+    {
+        const HIT_EVENT* hit = _msg.GetPayload<HIT_EVENT>();
+        g_ReceivedDamage.push_back(hit ? hit->Damage : -1);
+    }
+
+    void OnCount(Object* _receiver, const EVENT_MESSAGE& _msg)
+    {
+        ++g_ReceivedCount;
+    }
+
+    // posts and subscribes from inside a dispatch
+    void OnChain(Object* _receiver, const EVENT_MESSAGE& _msg)
+    {
+        g_BusInHandler->Subscribe("chain"_sid, nullptr, OnCount);
+        g_BusInHandler->PostEvent("chain"_sid, nullptr);
+        g_BusInHandler->Unsubscribe("hit"_sid, nullptr, OnHit);
+    }
+}
+
+TEST_CASE(EventBus_PayloadsArriveInPostOrder)
+{
+    EventBus bus = {};
+    g_ReceivedDamage.clear();
+    bus.Subscribe("hit"_sid, nullptr, OnHit);
+    bus.Subscribe("hit"_sid, nullptr, OnHit);
+    for (int i = 0; i < 3; i++)
+    {
+        bus.PostEvent("hit"_sid, nullptr,
+            HIT_EVENT{ i * 10, MakeFloat2(0.f, 0.f) });
+    }
+    bus.PostEvent("miss"_sid, nullptr, 5);
+    CHECK(g_ReceivedDamage.empty());
+
+    bus.DispatchEvents();
+    // the second subscribe is the same handler and is ignored
+    REQUIRE(g_ReceivedDamage.size() == 3);
+    CHECK(g_ReceivedDamage[0] == 0);
+    CHECK(g_ReceivedDamage[1] == 10);
+    CHECK(g_ReceivedDamage[2] == 20);
+
+    bus.DispatchEvents();
+    CHECK(g_ReceivedDamage.size() == 3);
+}
+
+TEST_CASE(EventBus_ChangesDuringDispatchWaitForTheNextFrame)
+{
+    EventBus bus = {};
+    g_BusInHandler = &bus;
+    g_ReceivedDamage.clear();
+    g_ReceivedCount = 0;
+    bus.Subscribe("start"_sid, nullptr, OnChain);
+    bus.Subscribe("hit"_sid, nullptr, OnHit);
+    bus.PostEvent("start"_sid, nullptr);
+    bus.PostEvent("hit"_sid, nullptr, HIT_EVENT{ 1, {} });
+    bus.DispatchEvents();
+
+    // the unsubscribe counts at once, the new post and subscriber don't
+    CHECK(g_ReceivedDamage.empty());
+    CHECK(g_ReceivedCount == 0);
+
+    bus.DispatchEvents();
+    CHECK(g_ReceivedCount == 1);
+    g_BusInHandler = nullptr;
+}
+
+TEST_CASE(EventBus_DestoryedReceiversAreSkipped)
+{
+    HeadlessScene scene = {};
+    ActorObject* alive = scene.AddEmptyActor("alive",
+        MakeFloat3(0.f, 0.f, 0.f));
+    ActorObject* dying = scene.AddEmptyActor("dying",
+        MakeFloat3(0.f, 0.f, 0.f));
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+
+    EventBus bus = {};
+    g_ReceivedCount = 0;
+    bus.Subscribe("tick"_sid, alive, OnCount);
+    bus.Subscribe("tick"_sid, dying, OnCount);
+    dying->SetObjectActive(STATUS::NEED_DESTORY);
+    bus.PostEvent("tick"_sid, nullptr);
+    bus.DispatchEvents();
+    CHECK(g_ReceivedCount == 1);
+
+    bus.UnsubscribeAll(alive);
+    bus.UnsubscribeAll(dying);
+    bus.PostEvent("tick"_sid, nullptr);
+    bus.DispatchEvents();
+    CHECK(g_ReceivedCount == 1);
+}
+
+TEST_CASE(EventBus_BenchSteadyStateDoesNotAllocate)
+{
+    const int perFrame = 10000;
+    const int frames = 100;
+    EventBus bus = {};
+    g_ReceivedCount = 0;
+    bus.Subscribe("hit"_sid, nullptr, OnCount);
+    bus.Subscribe("tick"_sid, nullptr, OnCount);
+
+    // the first frames grow both queues to their working size
+    for (int f = 0; f < 2; f++)
+    {
+        for (int i = 0; i < perFrame; i++)
+        {
+            bus.PostEvent("hit"_sid, nullptr, HIT_EVENT{ i, {} });
+        }
+        bus.DispatchEvents();
+    }
+    g_ReceivedCount = 0;
+
+    size_t before = GetAllocationCount();
+    BenchTimer timer = {};
+    for (int f = 0; f < frames; f++)
+    {
+        for (int i = 0; i < perFrame; i++)
+        {
+            if (i & 1)
+            {
+                bus.PostEvent("tick"_sid, nullptr);
+            }
+            else
+            {
+                bus.PostEvent("hit"_sid, nullptr, HIT_EVENT{ i, {} });
+            }
+        }
+        bus.DispatchEvents();
+    }
+    double elapsed = timer.GetElapsedMs();
+    size_t allocs = GetAllocationCount() - before;
+
+    BENCH_LOG("%d events, %.3f ms, %.1f ns per event, %zu "
+        "allocations\n", perFrame * frames, elapsed,
+        elapsed * 1000000.0 / (perFrame * frames), allocs);
+    CHECK(g_ReceivedCount ==
+        (unsigned long long)perFrame * (unsigned long long)frames);
+    CHECK(allocs == 0);
+}
@@ -0,0 +1,171 @@
+﻿//---------------------------------------------------------------
+// File: HeadlessScene.cpp
+// Proj: HycFrame2D
+// Info: ウィンドウもデバイスも使わないテスト用のシーン
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "HeadlessScene.h"
+#include "TestFramework.h"
+#include "SceneManager.h"
+#include "SceneNode.h"
+#include "ActorObject.h"
+#include "ATransformComponent.h"
+#include "ASpriteComponent.h"
+#include "UiObject.h"
+#include "UTransformComponent.h"
+#include "USpriteComponent.h"
+
+HeadlessScene::HeadlessScene() :
+    mRenderBackend(), mRenderQueue(),
+    mSceneManagerPtr(new SceneManager()), mSceneNodePtr(nullptr)
+{
+    // no render thread, every submit is played back right away
+    mRenderQueue.StartUp(&mRenderBackend, false);
+    mSceneManagerPtr->PostStartUp(nullptr, nullptr, &mRenderQueue);
+    mSceneNodePtr = new SceneNode("headless-scene", "",
+        mSceneManagerPtr);
+}
+
+HeadlessScene::~HeadlessScene()
+{
+    mSceneNodePtr->ReleaseScene();
+    delete mSceneNodePtr;
+    mRenderQueue.CleanAndStop();
+    delete mSceneManagerPtr;
+}
+
+SceneNode* HeadlessScene::GetSceneNode() const
+{
+    return mSceneNodePtr;
+}
+
+NullRenderBackend* HeadlessScene::GetRenderBackend()
+{
+    return &mRenderBackend;
+}
+
+ActorObject* HeadlessScene::AddEmptyActor(std::string _name,
+    Float3 _pos)
+{
+    ActorObject* actor = new ActorObject(_name, mSceneNodePtr, 0);
+    AddTransform(actor, _pos);
+    mSceneNodePtr->AddActorObject(actor);
+
+    return actor;
+}
+
+ActorObject* HeadlessScene::AddSpriteActor(std::string _name,
+    Float3 _pos, Float2 _size, int _drawOrder)
+{
+    ActorObject* actor = new ActorObject(_name, mSceneNodePtr, 0);
+    AddTransform(actor, _pos);
+
+    // no texture path, so the sprite is drawn with a null texture
+    ASpriteComponent* asc = new ASpriteComponent(_name + "-sprite",
+        actor, 0, _drawOrder);
+    asc->SetTexWidth(_size.x);
+    asc->SetTexHeight(_size.y);
+    actor->AddAComponent(asc);
+    mSceneNodePtr->AddActorObject(actor);
+
+    return actor;
+}
+
+UiObject* HeadlessScene::AddSpriteUi(std::string _name, Float3 _pos,
+    Float2 _size, int _drawOrder)
+{
+    UiObject* ui = new UiObject(_name, mSceneNodePtr, 0);
+    UTransformComponent* utc = new UTransformComponent(
+        _name + "-transform", ui, 0, _pos);
+    utc->SetRotation(MakeFloat3(0.f, 0.f, 0.f));
+    ui->AddUComponent(utc);
+
+    USpriteComponent* usc = new USpriteComponent(_name + "-sprite",
+        ui, 0, _drawOrder);
+    usc->SetTexWidth(_size.x);
+    usc->SetTexHeight(_size.y);
+    ui->AddUComponent(usc);
+    mSceneNodePtr->AddUiObject(ui);
+
+    return ui;
+}
+
+std::vector<ActorObject*> HeadlessScene::AddSpriteField(
+    std::string _prefix, int _side, float _spacing, Float2 _size)
+{
+    std::vector<ActorObject*> field = {};
+    float origin = -0.5f * _spacing * (float)(_side - 1);
+    for (int y = 0; y < _side; y++)
+    {
+        for (int x = 0; x < _side; x++)
+        {
+            field.push_back(AddSpriteActor(
+                _prefix + "-" + std::to_string(y * _side + x),
+                MakeFloat3(origin + _spacing * (float)x,
+                    origin + _spacing * (float)y, 0.f),
+                _size, 0));
+        }
+    }
+
+    return field;
+}
+
+unsigned int HeadlessScene::CountDrawCommands(RENDER_CMD_TYPE _type)
+{
+    unsigned int count = 0;
+    for (auto& cmd : *(mRenderBackend.GetLastCommandArray()))
+    {
+        if (cmd.Type == _type)
+        {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+void HeadlessScene::AddTransform(ActorObject* _actor, Float3 _pos)
+{
+    // the constructor seeds the rotation with the init value as well,
+    // the factory always sets it again and so does this
+    ATransformComponent* atc = new ATransformComponent(
+        _actor->GetObjectName() + "-transform", _actor, 0, _pos);
+    atc->SetRotation(MakeFloat3(0.f, 0.f, 0.f));
+    _actor->AddAComponent(atc);
+}
+
+void HeadlessScene::RunFrame(float _deltatime)
+{
+    mSceneNodePtr->UpdateScene(_deltatime);
+    DrawFrame();
+}
+
+void HeadlessScene::DrawFrame()
+{
+    mSceneNodePtr->DrawScene();
+    mRenderQueue.SubmitFrame();
+}
+
+HEADLESS_BENCH HeadlessScene::BenchFrames(int _frames,
+    const BenchFrameFuncType& _frame)
+{
+    size_t before = GetAllocationCount();
+    BenchTimer timer = {};
+    for (int i = 0; i < _frames; i++)
+    {
+        if (_frame)
+        {
+            _frame(i);
+        }
+        else
+        {
+            RunFrame(MAX_DELTA);
+        }
+    }
+    double elapsed = timer.GetElapsedMs();
+    size_t allocations = GetAllocationCount() - before;
+
+    return { elapsed / _frames, (double)allocations / _frames };
+}
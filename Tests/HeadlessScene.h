@@ -0,0 +1,72 @@
+﻿//---------------------------------------------------------------
+// File: HeadlessScene.h
+// Proj: HycFrame2D
+// Info: ウィンドウもデバイスも使わないテスト用のシーン
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include "HFCommon.h"
+#include "RenderCommandQueue.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+using BenchFrameFuncType = std::function<void(int)>;
+
+struct HEADLESS_BENCH
+{
+    double MsPerFrame;
+    double AllocationsPerFrame;
+};
+
+// draws into a null backend without any window, device, sound or
+// prefab, actors are put together by hand instead of from json
+class HeadlessScene
+{
+public:
+    HeadlessScene();
+    ~HeadlessScene();
+
+    class SceneNode* GetSceneNode() const;
+
+    NullRenderBackend* GetRenderBackend();
+
+    class ActorObject* AddEmptyActor(std::string _name, Float3 _pos);
+
+    class ActorObject* AddSpriteActor(std::string _name, Float3 _pos,
+        Float2 _size, int _drawOrder);
+
+    class UiObject* AddSpriteUi(std::string _name, Float3 _pos,
+        Float2 _size, int _drawOrder);
+
+    // a square of sprite actors centered on the origin, named
+    // prefix-0 to prefix-n row by row
+    std::vector<class ActorObject*> AddSpriteField(std::string _prefix,
+        int _side, float _spacing, Float2 _size);
+
+    unsigned int CountDrawCommands(RENDER_CMD_TYPE _type);
+
+    void RunFrame(float _deltatime);
+
+    void DrawFrame();
+
+    // times the frames and counts what they allocate, a frame is
+    // RunFrame unless the case passes its own
+    HEADLESS_BENCH BenchFrames(int _frames,
+        const BenchFrameFuncType& _frame = nullptr);
+
+private:
+    void AddTransform(class ActorObject* _actor, Float3 _pos);
+
+private:
+    NullRenderBackend mRenderBackend;
+
+    RenderCommandQueue mRenderQueue;
+
+    class SceneManager* mSceneManagerPtr;
+
+    class SceneNode* mSceneNodePtr;
+};
@@ -0,0 +1,311 @@
+﻿//---------------------------------------------------------------
+// File: InputReplayTest.cpp
+// Proj: HycFrame2D
+// Info: 入力の記録と再生、状態ハッシュのテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "HeadlessScene.h"
+#include "SceneNode.h"
+#include "ActorObject.h"
+#include "ATransformComponent.h"
+#include "InputReplay.h"
+#include "ID_BasicMacro.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const std::string REPLAY_PATH = "input-replay-test.rep";
+    const int REPLAY_FRAME_NUM = 120;
+    const float REPLAY_DELTA = 1.f / 60.f;
+
+    // the header is magic, version and frame count
+    const size_t REPLAY_HEADER_SIZE = 3 * sizeof(unsigned int);
+    const size_t IDLE_FRAME_SIZE = 15;
+
+    // holds right on the first half, jumps on every 16th frame and
+    // tilts the left stick a little further each frame
+    INPUT_SAMPLE MakeScriptedSample(int _frame)
+    {
+        INPUT_SAMPLE sample = {};
+        ClearInputSample(&sample);
+        SetInputSampleKey(&sample, KB_D, _frame < REPLAY_FRAME_NUM / 2);
+        SetInputSampleKey(&sample, KB_SPACE, (_frame % 16) == 0);
+        sample.LeftStick[0] = (float)(_frame % 40) / 40.f;
+
+        return sample;
+    }
+
+    // the whole "game" of the test, the player walks with the input
+    // and reads it through the snapshot like the real gameplay code
+    void StepPlayer(HeadlessScene* _scene, ActorObject* _player,
+        InputSystem* _input, InputSampler* _sampler, float _deltatime,
+        float _speed)
+    {
+        _input->CaptureSnapshot(_sampler);
+        const INPUT_SNAPSHOT* snap = _input->GetSnapshot();
+        auto atc = _player->GetAComponent<ATransformComponent>(
+            COMP_TYPE::ATRANSFORM);
+        if (snap->IsPressed(KB_D))
+        {
+            atc->TranslateXAsix(_speed * _deltatime);
+        }
+        if (snap->IsTriggered(KB_SPACE))
+        {
+            atc->TranslateYAsix(8.f);
+        }
+        atc->TranslateZAsix(snap->GetLeftStickX());
+        _scene->RunFrame(_deltatime);
+    }
+
+    class ScriptSampler :
+        public InputSampler
+    {
+    public:
+        ScriptSampler() :
+            mFrame(0)
+        {
+
+        }
+
+        virtual void SampleInput(INPUT_SAMPLE* _out)
+        {
+            *_out = MakeScriptedSample(mFrame++);
+        }
+
+    private:
+        int mFrame;
+    };
+
+    size_t GetFileSize(const std::string& _path)
+    {
+        std::ifstream file(_path, std::ios::binary | std::ios::ate);
+        return file.is_open() ? (size_t)file.tellg() : 0;
+    }
+
+    // records the scripted run and hands back the final state hash
+    unsigned long long RecordScriptedRun(float _speed)
+    {
+        HeadlessScene scene = {};
+        ActorObject* player = scene.AddEmptyActor("player",
+            MakeFloat3(0.f, 0.f, 0.f));
+        InputSystem input = {};
+        ScriptSampler sampler = {};
+        InputRecorder recorder = {};
+        recorder.StartRecording(REPLAY_PATH);
+        for (int f = 0; f < REPLAY_FRAME_NUM; f++)
+        {
+            INPUT_SAMPLE sample = MakeScriptedSample(f);
+            StepPlayer(&scene, player, &input, &sampler, REPLAY_DELTA,
+                _speed);
+            recorder.RecordFrame(sample, REPLAY_DELTA,
+                scene.GetSceneNode()->HashSceneState());
+        }
+        recorder.StopRecording();
+
+        return scene.GetSceneNode()->HashSceneState();
+    }
+
+    // plays the file back into a fresh scene the way the root system
+    // does, step, simulate with the recorded delta, then verify
+    unsigned int ReplayScriptedRun(float _speed,
+        unsigned long long* _finalHash)
+    {
+        HeadlessScene scene = {};
+        ActorObject* player = scene.AddEmptyActor("player",
+            MakeFloat3(0.f, 0.f, 0.f));
+        InputSystem input = {};
+        InputReplayer replayer = {};
+        if (!replayer.LoadReplay(REPLAY_PATH))
+        {
+            return (unsigned int)-1;
+        }
+        while (replayer.StepFrame())
+        {
+            StepPlayer(&scene, player, &input, &replayer,
+                replayer.GetFrameDelta(), _speed);
+            replayer.VerifyFrame(
+                scene.GetSceneNode()->HashSceneState());
+        }
+        *_finalHash = scene.GetSceneNode()->HashSceneState();
+
+        return replayer.GetMismatchCount();
+    }
+}
+
+TEST_CASE(InputReplay_SamplesSurviveTheFile)
+{
+    InputRecorder recorder = {};
+    REQUIRE(recorder.StartRecording(REPLAY_PATH));
+    CHECK(recorder.IsRecording());
+    CHECK(!recorder.StartRecording(REPLAY_PATH));
+    for (int f = 0; f < REPLAY_FRAME_NUM; f++)
+    {
+        INPUT_SAMPLE sample = MakeScriptedSample(f);
+        sample.PressEdge[0] = (unsigned long long)f;
+        recorder.RecordFrame(sample, REPLAY_DELTA * (float)(f + 1),
+            (unsigned long long)f * 31);
+    }
+    REQUIRE(recorder.StopRecording());
+    CHECK(!recorder.IsRecording());
+
+    InputReplayer replayer = {};
+    REQUIRE(replayer.LoadReplay(REPLAY_PATH));
+    CHECK(replayer.GetFrameCount() == (unsigned int)REPLAY_FRAME_NUM);
+    CHECK(replayer.GetFrameIndex() == 0);
+
+    // nothing is played before the first step
+    INPUT_SAMPLE played = {};
+    replayer.SampleInput(&played);
+    CHECK(played.Down[KB_D >> 6] == 0);
+    CHECK(replayer.GetFrameDelta() == 0.f);
+
+    bool same = true;
+    for (int f = 0; f < REPLAY_FRAME_NUM; f++)
+    {
+        REQUIRE(replayer.StepFrame());
+        INPUT_SAMPLE expect = MakeScriptedSample(f);
+        replayer.SampleInput(&played);
+        for (int w = 0; w < INPUT_KEY_WORD_NUM; w++)
+        {
+            same = same && played.Down[w] == expect.Down[w];
+        }
+        same = same && played.PressEdge[0] == (unsigned long long)f;
+        same = same &&
+            played.LeftStick[0] - expect.LeftStick[0] < 1e-4f &&
+            expect.LeftStick[0] - played.LeftStick[0] < 1e-4f;
+        same = same &&
+            replayer.GetFrameDelta() == REPLAY_DELTA * (float)(f + 1);
+        same = same &&
+            replayer.VerifyFrame((unsigned long long)f * 31);
+    }
+    CHECK(same);
+    CHECK(replayer.GetMismatchCount() == 0);
+    CHECK(!replayer.StepFrame());
+    CHECK(replayer.GetFrameIndex() == (unsigned int)REPLAY_FRAME_NUM);
+
+    std::remove(REPLAY_PATH.c_str());
+}
+
+TEST_CASE(InputReplay_IdleFramesStayTiny)
+{
+    INPUT_SAMPLE idle = {};
+    ClearInputSample(&idle);
+    InputRecorder recorder = {};
+    REQUIRE(recorder.StartRecording(REPLAY_PATH));
+    for (int f = 0; f < 1000; f++)
+    {
+        recorder.RecordFrame(idle, REPLAY_DELTA, 0);
+    }
+    REQUIRE(recorder.StopRecording());
+    CHECK(GetFileSize(REPLAY_PATH) ==
+        REPLAY_HEADER_SIZE + 1000 * IDLE_FRAME_SIZE);
+
+    std::remove(REPLAY_PATH.c_str());
+}
+
+TEST_CASE(InputReplay_BrokenFilesAreRejected)
+{
+    InputReplayer replayer = {};
+    CHECK(!replayer.LoadReplay("no-such-replay.rep"));
+
+    {
+        std::ofstream file(REPLAY_PATH, std::ios::binary);
+        unsigned int header[3] = { 0x12345678u, 1u, 1u };
+        file.write((const char*)header, sizeof(header));
+    }
+    CHECK(!replayer.LoadReplay(REPLAY_PATH));
+
+    // a valid header promising more frames than the file holds
+    {
+        std::ofstream file(REPLAY_PATH, std::ios::binary);
+        unsigned int header[3] =
+        {
+            REPLAY_FILE_MAGIC, REPLAY_FILE_VERSION, 4u
+        };
+        file.write((const char*)header, sizeof(header));
+        file.write((const char*)header, 4);
+    }
+    CHECK(!replayer.LoadReplay(REPLAY_PATH));
+
+    std::remove(REPLAY_PATH.c_str());
+}
+
+TEST_CASE(InputReplay_SameInputGivesTheSameHash)
+{
+    HeadlessScene first = {};
+    HeadlessScene second = {};
+    ActorObject* a = first.AddEmptyActor("player",
+        MakeFloat3(10.f, 20.f, 0.f));
+    ActorObject* b = second.AddEmptyActor("player",
+        MakeFloat3(10.f, 20.f, 0.f));
+    InputSystem inputA = {};
+    InputSystem inputB = {};
+    ScriptSampler samplerA = {};
+    ScriptSampler samplerB = {};
+    for (int f = 0; f < 30; f++)
+    {
+        StepPlayer(&first, a, &inputA, &samplerA, REPLAY_DELTA, 300.f);
+        StepPlayer(&second, b, &inputB, &samplerB, REPLAY_DELTA,
+            300.f);
+    }
+    CHECK(first.GetSceneNode()->HashSceneState() ==
+        second.GetSceneNode()->HashSceneState());
+
+    b->GetAComponent<ATransformComponent>(COMP_TYPE::ATRANSFORM)->
+        TranslateXAsix(0.5f);
+    CHECK(first.GetSceneNode()->HashSceneState() !=
+        second.GetSceneNode()->HashSceneState());
+}
+
+TEST_CASE(InputReplay_ReplayReproducesTheRun)
+{
+    unsigned long long recorded = RecordScriptedRun(300.f);
+    unsigned long long replayed = 0;
+    CHECK(ReplayScriptedRun(300.f, &replayed) == 0);
+    CHECK(replayed == recorded);
+
+    // a changed simulation diverges once the player starts walking
+    // and keeps diverging from then on
+    CHECK(ReplayScriptedRun(301.f, &replayed) ==
+        (unsigned int)REPLAY_FRAME_NUM);
+    CHECK(replayed != recorded);
+
+    std::remove(REPLAY_PATH.c_str());
+}
+
+TEST_CASE(InputReplay_BenchRecordAndLoad)
+{
+    const int frameNum = 200000;
+    InputRecorder recorder = {};
+    recorder.StartRecording(REPLAY_PATH);
+
+    BenchTimer timer = {};
+    timer.ResetTimer();
+    for (int f = 0; f < frameNum; f++)
+    {
+        recorder.RecordFrame(MakeScriptedSample(f), REPLAY_DELTA,
+            (unsigned long long)f);
+    }
+    recorder.StopRecording();
+    double recordMs = timer.GetElapsedMs();
+    size_t fileSize = GetFileSize(REPLAY_PATH);
+
+    InputReplayer replayer = {};
+    timer.ResetTimer();
+    bool loaded = replayer.LoadReplay(REPLAY_PATH);
+    double loadMs = timer.GetElapsedMs();
+    CHECK(loaded);
+    CHECK(replayer.GetFrameCount() == (unsigned int)frameNum);
+
+    BENCH_LOG("%d frames, record %.2f ms, load %.2f ms, "
+        "%.1f bytes per frame\n", frameNum, recordMs, loadMs,
+        (double)(fileSize - REPLAY_HEADER_SIZE) / frameNum);
+
+    std::remove(REPLAY_PATH.c_str());
+}
@@ -0,0 +1,221 @@
+﻿//---------------------------------------------------------------
+// File: InputSamplingTest.cpp
+// Proj: HycFrame2D
+// Info: 入力サンプリングスレッドとイベントキューのテスト
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "InputSamplingThread.h"
+#include "ID_BasicMacro.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+    // stands in for the pad, the test flips the key from the main
+    // thread and waits until the sampling thread has seen it
+    class SyntheticDevice :
+        public InputSampler
+    {
+    public:
+        SyntheticDevice() :
+            mKeyDown(false), mStickX(0.f), mSampleCount(0)
+        {
+
+        }
+
+        virtual void SampleInput(INPUT_SAMPLE* _out)
+        {
+            ClearInputSample(_out);
+            SetInputSampleKey(_out, KB_Z, mKeyDown.load());
+            _out->LeftStick[0] = mStickX.load();
+            mSampleCount.fetch_add(1);
+        }
+
+        void SetKey(bool _down)
+        {
+            mKeyDown.store(_down);
+            WaitForSamples(2);
+        }
+
+        void SetStickX(float _value)
+        {
+            mStickX.store(_value);
+            WaitForSamples(2);
+        }
+
+        void WaitForSamples(unsigned int _count)
+        {
+            unsigned int target = mSampleCount.load() + _count;
+            while (mSampleCount.load() < target)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+    private:
+        std::atomic<bool> mKeyDown;
+
+        std::atomic<float> mStickX;
+
+        std::atomic<unsigned int> mSampleCount;
+    };
+
+    INPUT_EVENT MakeEvent(unsigned long long _stamp,
+        unsigned short _code, bool _down)
+    {
+        INPUT_EVENT ev = {};
+        ev.Timestamp = _stamp;
+        ev.Code = _code;
+        ev.Down = _down;
+
+        return ev;
+    }
+}
+
+TEST_CASE(InputSampling_QueueIsFifoAndBounded)
+{
+    InputEventQueue* queue = new InputEventQueue();
+    INPUT_EVENT ev = {};
+    CHECK(!queue->PopEvent(&ev));
+
+    // a few laps so the indices wrap past the array end
+    for (unsigned int lap = 0; lap < 3; lap++)
+    {
+        for (unsigned int i = 0; i < INPUT_EVENT_QUEUE_SIZE; i++)
+        {
+            CHECK(queue->PushEvent(MakeEvent(lap * 10000 + i, 1,
+                true)));
+        }
+        CHECK(!queue->PushEvent(MakeEvent(0, 1, true)));
+        for (unsigned int i = 0; i < INPUT_EVENT_QUEUE_SIZE; i++)
+        {
+            REQUIRE(queue->PopEvent(&ev));
+            CHECK(ev.Timestamp == lap * 10000 + i);
+        }
+        CHECK(!queue->PopEvent(&ev));
+    }
+    delete queue;
+}
+
+TEST_CASE(InputSampling_EdgesWaitForRoomInAFullQueue)
+{
+    InputEventQueue* queue = new InputEventQueue();
+    InputEdgeDetector detector = {};
+    for (unsigned int i = 0; i < INPUT_EVENT_QUEUE_SIZE - 1; i++)
+    {
+        queue->PushEvent(MakeEvent(0, 0, false));
+    }
+
+    INPUT_SAMPLE sample = {};
+    ClearInputSample(&sample);
+    SetInputSampleKey(&sample, KB_A, true);
+    SetInputSampleKey(&sample, KB_S, true);
+    CHECK(detector.DetectEdges(sample, 1, queue) == 1);
+    CHECK(detector.DetectEdges(sample, 2, queue) == 0);
+
+    INPUT_EVENT ev = {};
+    while (queue->PopEvent(&ev))
+    {
+    }
+    // lower codes go first, so only s is left to publish again
+    CHECK(detector.DetectEdges(sample, 3, queue) == 1);
+    REQUIRE(queue->PopEvent(&ev));
+    CHECK(ev.Timestamp == 3);
+    CHECK(ev.Down);
+    CHECK(ev.Code == KB_S);
+
+    SetInputSampleKey(&sample, KB_A, false);
+    CHECK(detector.DetectEdges(sample, 4, queue) == 1);
+    REQUIRE(queue->PopEvent(&ev));
+    CHECK(ev.Code == KB_A);
+    CHECK(!ev.Down);
+    delete queue;
+}
+
+TEST_CASE(InputSampling_TapBetweenFramesIsNotLost)
+{
+    SyntheticDevice device = {};
+    InputSamplingThread sampling = {};
+    CHECK(!sampling.StartSampling(nullptr, 1000));
+    REQUIRE(sampling.StartSampling(&device, 1000));
+    CHECK(sampling.IsSampling());
+    CHECK(!sampling.StartSampling(&device, 1000));
+
+    device.SetKey(true);
+    device.SetKey(false);
+    device.SetStickX(0.5f);
+
+    INPUT_SAMPLE frame = {};
+    sampling.SampleInput(&frame);
+    unsigned long long bit = 1ull << (KB_Z & 63);
+    CHECK(!(frame.Down[KB_Z >> 6] & bit));
+    CHECK(frame.PressEdge[KB_Z >> 6] & bit);
+    CHECK(frame.ReleaseEdge[KB_Z >> 6] & bit);
+    CHECK(frame.LeftStick[0] > 0.4999f && frame.LeftStick[0] < 0.5001f);
+
+    auto events = sampling.GetFrameEvents();
+    REQUIRE(events->size() == 2);
+    CHECK((*events)[0].Down);
+    CHECK(!(*events)[1].Down);
+    CHECK((*events)[0].Timestamp < (*events)[1].Timestamp);
+
+    // the snapshot turns the tap into a trigger and a release at once
+    InputSystem input = {};
+    device.SetKey(true);
+    device.SetKey(false);
+    input.CaptureSnapshot(&sampling);
+    CHECK(input.GetSnapshot()->IsTriggered(KB_Z));
+    CHECK(input.GetSnapshot()->IsReleased(KB_Z));
+    CHECK(!input.GetSnapshot()->IsPressed(KB_Z));
+
+    sampling.StopSampling();
+    CHECK(!sampling.IsSampling());
+}
+
+TEST_CASE(InputSampling_BenchQueueAcrossThreads)
+{
+    const unsigned int eventNum = 1000000;
+    InputEventQueue* queue = new InputEventQueue();
+
+    BenchTimer timer = {};
+    std::thread producer([queue, eventNum]()
+        {
+            for (unsigned int i = 0; i < eventNum; i++)
+            {
+                while (!queue->PushEvent(MakeEvent(i,
+                    (unsigned short)(i & 511), (i & 1) != 0)))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+    unsigned int received = 0;
+    unsigned int outOfOrder = 0;
+    INPUT_EVENT ev = {};
+    while (received < eventNum)
+    {
+        if (!queue->PopEvent(&ev))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        if (ev.Timestamp != received ||
+            ev.Code != (unsigned short)(received & 511))
+        {
+            ++outOfOrder;
+        }
+        ++received;
+    }
+    producer.join();
+    double elapsed = timer.GetElapsedMs();
+
+    BENCH_LOG("%u events through the spsc queue, %.3f ms, %.1f ns "
+        "each\n", eventNum, elapsed, elapsed * 1000000.0 / eventNum);
+    CHECK(outOfOrder == 0);
+    delete queue;
+}
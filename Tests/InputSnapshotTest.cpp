@@ -0,0 +1,209 @@
+﻿//---------------------------------------------------------------
+// File: InputSnapshotTest.cpp
+// Proj: HycFrame2D
+// Info: 入力スナップショットとアクションマップのテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "InputSnapshot.h"
+#include "ID_BasicMacro.h"
+#include <string>
+
+namespace
+{
+    INPUT_SAMPLE MakeSample(std::initializer_list<unsigned int> _down)
+    {
+        INPUT_SAMPLE sample = {};
+        ClearInputSample(&sample);
+        for (auto code : _down)
+        {
+            SetInputSampleKey(&sample, code, true);
+        }
+
+        return sample;
+    }
+
+    // a fake pad that walks through a fixed pattern without ever
+    // touching the heap, so the bench only measures the snapshot
+    class PatternInputSampler :
+        public InputSampler
+    {
+    public:
+        PatternInputSampler() :
+            mFrame(0)
+        {
+
+        }
+
+        virtual void SampleInput(INPUT_SAMPLE* _out)
+        {
+            ClearInputSample(_out);
+            for (unsigned int k = 0; k < 8; k++)
+            {
+                SetInputSampleKey(_out, (mFrame * 7 + k * 61) %
+                    INPUT_KEY_CODE_NUM, ((mFrame >> k) & 1) != 0);
+            }
+            _out->LeftStick[0] = (float)(mFrame % 200) / 100.f - 1.f;
+            ++mFrame;
+        }
+
+    private:
+        unsigned int mFrame;
+    };
+}
+
+TEST_CASE(InputSnapshot_KeyEdgesFollowTheSamples)
+{
+    InputSystem input = {};
+    ScriptedInputSampler sampler = {};
+    sampler.PushSample(MakeSample({ KB_A }));
+    sampler.PushSample(MakeSample({ KB_A, KB_B }));
+    sampler.PushSample(MakeSample({ KB_B }));
+    sampler.PushIdleFrames(1);
+    CHECK(sampler.GetPendingCount() == 4);
+
+    input.CaptureSnapshot(&sampler);
+    const INPUT_SNAPSHOT* snap = input.GetSnapshot();
+    CHECK(snap->IsPressed(KB_A));
+    CHECK(snap->IsTriggered(KB_A));
+    CHECK(!snap->IsReleased(KB_A));
+
+    input.CaptureSnapshot(&sampler);
+    CHECK(snap->IsPressed(KB_A));
+    CHECK(!snap->IsTriggered(KB_A));
+    CHECK(snap->IsTriggered(KB_B));
+
+    input.CaptureSnapshot(&sampler);
+    CHECK(!snap->IsPressed(KB_A));
+    CHECK(snap->IsReleased(KB_A));
+    CHECK(snap->IsPressed(KB_B));
+
+    input.CaptureSnapshot(&sampler);
+    CHECK(snap->IsReleased(KB_B));
+    CHECK(!snap->IsPressed(INPUT_KEY_CODE_NUM + 10));
+    CHECK(snap->Frame == 4);
+
+    // an empty script reads as nothing held
+    input.CaptureSnapshot(&sampler);
+    CHECK(!snap->IsPressed(KB_B));
+    CHECK(!snap->IsReleased(KB_B));
+}
+
+TEST_CASE(InputSnapshot_TapInsideOneFrameCountsBothEdges)
+{
+    InputSystem input = {};
+    ScriptedInputSampler sampler = {};
+    INPUT_SAMPLE tap = MakeSample({});
+    tap.PressEdge[KB_SPACE >> 6] |= 1ull << (KB_SPACE & 63);
+    tap.ReleaseEdge[KB_SPACE >> 6] |= 1ull << (KB_SPACE & 63);
+    sampler.PushSample(tap);
+    input.GetActionMap()->BindKey("jump"_sid, KB_SPACE);
+    int jump = input.GetActionMap()->GetActionIndex("jump"_sid);
+
+    input.CaptureSnapshot(&sampler);
+    const INPUT_SNAPSHOT* snap = input.GetSnapshot();
+    CHECK(!snap->IsPressed(KB_SPACE));
+    CHECK(snap->IsTriggered(KB_SPACE));
+    CHECK(snap->IsReleased(KB_SPACE));
+    CHECK(!snap->IsActionPressed(jump));
+    CHECK(snap->IsActionTriggered(jump));
+    CHECK(snap->IsActionReleased(jump));
+}
+
+TEST_CASE(InputSnapshot_ActionsEdgeOnTheActionItself)
+{
+    InputSystem input = {};
+    ScriptedInputSampler sampler = {};
+    InputActionMap* map = input.GetActionMap();
+    CHECK(map->BindKey("jump"_sid, KB_SPACE));
+    CHECK(map->BindKey("jump"_sid, KB_A));
+    CHECK(!map->BindKey("jump"_sid, INPUT_KEY_CODE_NUM));
+    int jump = map->GetActionIndex("jump"_sid);
+    CHECK(map->GetActionIndex("dash"_sid) == NULL_ACTION);
+    CHECK(map->GetActionCount() == 1);
+
+    sampler.PushSample(MakeSample({ KB_SPACE }));
+    sampler.PushSample(MakeSample({ KB_SPACE, KB_A }));
+    sampler.PushSample(MakeSample({ KB_A }));
+    sampler.PushSample(MakeSample({}));
+    const INPUT_SNAPSHOT* snap = input.GetSnapshot();
+
+    input.CaptureSnapshot(&sampler);
+    CHECK(snap->IsActionTriggered(jump));
+    // handing the action over from one key to the other keeps it held
+    input.CaptureSnapshot(&sampler);
+    CHECK(snap->IsActionPressed(jump));
+    CHECK(!snap->IsActionTriggered(jump));
+    input.CaptureSnapshot(&sampler);
+    CHECK(snap->IsActionPressed(jump));
+    CHECK(!snap->IsActionReleased(jump));
+    input.CaptureSnapshot(&sampler);
+    CHECK(!snap->IsActionPressed(jump));
+    CHECK(snap->IsActionReleased(jump));
+    CHECK(!snap->IsActionPressed(NULL_ACTION));
+}
+
+TEST_CASE(InputSnapshot_ActionCountIsCapped)
+{
+    InputActionMap map = {};
+    for (int i = 0; i < MAX_INPUT_ACTION_NUM; i++)
+    {
+        CHECK(map.RegisterAction(
+            StringID("action-" + std::to_string(i))) == i);
+    }
+    CHECK(map.RegisterAction("one-too-many"_sid) == NULL_ACTION);
+    CHECK(map.RegisterAction("action-3"_sid) == 3);
+    map.ClearActionMap();
+    CHECK(map.GetActionCount() == 0);
+}
+
+TEST_CASE(InputSnapshot_SticksAreQuantizedAndClamped)
+{
+    InputSystem input = {};
+    ScriptedInputSampler sampler = {};
+    INPUT_SAMPLE sample = MakeSample({});
+    sample.LeftStick[0] = 2.f;
+    sample.LeftStick[1] = -0.5f;
+    sample.RightStick[0] = -3.f;
+    sampler.PushSample(sample);
+    input.CaptureSnapshot(&sampler);
+
+    const INPUT_SNAPSHOT* snap = input.GetSnapshot();
+    CHECK(snap->GetLeftStickX() == 1.f);
+    CHECK(snap->GetRightStickX() == -1.f);
+    CHECK(snap->GetRightStickY() == 0.f);
+    float y = snap->GetLeftStickY();
+    CHECK(y > -0.5001f && y < -0.4999f);
+}
+
+TEST_CASE(InputSnapshot_BenchCaptureWithActions)
+{
+    const int frames = 1000000;
+    InputSystem input = {};
+    PatternInputSampler sampler = {};
+    for (unsigned int i = 0; i < 32; i++)
+    {
+        input.GetActionMap()->BindKey(
+            StringID("action-" + std::to_string(i)), i * 13);
+        input.GetActionMap()->BindKey(
+            StringID("action-" + std::to_string(i)), i * 13 + 5);
+    }
+
+    unsigned long long triggered = 0;
+    size_t before = GetAllocationCount();
+    BenchTimer timer = {};
+    for (int i = 0; i < frames; i++)
+    {
+        input.CaptureSnapshot(&sampler);
+        triggered += input.GetSnapshot()->ActionTriggered & 1ull;
+    }
+    double elapsed = timer.GetElapsedMs();
+    size_t allocs = GetAllocationCount() - before;
+
+    BENCH_LOG("%d snapshots with 32 actions, %.1f ns each, %zu "
+        "allocations\n", frames, elapsed * 1000000.0 / frames, allocs);
+    CHECK(allocs == 0);
+    CHECK(triggered > 0);
+}
@@ -0,0 +1,228 @@
+﻿//---------------------------------------------------------------
+// File: ParticleTest.cpp
+// Proj: HycFrame2D
+// Info: SoAパーティクルコンポーネントのテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "HeadlessScene.h"
+#include "SceneNode.h"
+#include "ActorObject.h"
+#include "AParticleComponent.h"
+#include "DxRenderBackend.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+    AParticleComponent* AddEmitterActor(HeadlessScene* _scene,
+        std::string _name, Float3 _pos,
+        const PARTICLE_EMITTER& _emitter)
+    {
+        ActorObject* actor = _scene->AddEmptyActor(_name, _pos);
+        AParticleComponent* apc = new AParticleComponent(
+            _name + "-particle", actor, 0);
+        apc->SetEmitter(_emitter);
+        actor->AddAComponent(apc);
+
+        return apc;
+    }
+
+    // every particle flies along x at the same speed for the same life
+    PARTICLE_EMITTER MakeStraightEmitter(unsigned int _capacity,
+        unsigned int _burst, float _life)
+    {
+        PARTICLE_EMITTER emitter = {};
+        emitter.Capacity = _capacity;
+        emitter.BurstCount = _burst;
+        emitter.LifeRange = MakeFloat2(_life, _life);
+        emitter.SpeedRange = MakeFloat2(100.f, 100.f);
+        emitter.AngleRange = MakeFloat2(0.f, 0.f);
+        emitter.Gravity = MakeFloat2(0.f, -50.f);
+        emitter.SizeRange = MakeFloat2(4.f, 4.f);
+
+        return emitter;
+    }
+
+    const RENDER_COMMAND* FindParticleBatch(HeadlessScene* _scene)
+    {
+        const RENDER_COMMAND* batch = nullptr;
+        for (auto& cmd :
+            *(_scene->GetRenderBackend()->GetLastCommandArray()))
+        {
+            if (cmd.Type == RENDER_CMD_TYPE::PARTICLE_BATCH)
+            {
+                batch = &cmd;
+            }
+        }
+
+        return batch;
+    }
+}
+
+TEST_CASE(Particle_SimdAndTailLanesAgree)
+{
+    HeadlessScene scene = {};
+    // 7 particles, one whole sse lane and three in the scalar tail
+    AParticleComponent* apc = AddEmitterActor(&scene, "fx",
+        MakeFloat3(10.f, 20.f, 0.f), MakeStraightEmitter(7, 7, 5.f));
+    scene.GetSceneNode()->UpdateScene(0.f);
+    REQUIRE(apc->GetAliveCount() == 7);
+    CHECK(apc->GetCapacity() == 7);
+
+    apc->UpdateParticles(0.5f);
+    scene.DrawFrame();
+    auto backend = scene.GetRenderBackend();
+    const RENDER_COMMAND* batch = FindParticleBatch(&scene);
+    REQUIRE(batch);
+    REQUIRE(batch->QuadCount == 7);
+    const RENDER_QUAD* quads =
+        backend->GetLastQuadArray()->data() + batch->FirstQuad;
+    for (unsigned int i = 0; i < 7; i++)
+    {
+        CHECK(quads[i].Rect.x == 60.f);
+        CHECK(quads[i].Rect.y == 7.5f);
+        CHECK(quads[i].Color.w == 1.f);
+    }
+
+    Float2 center = {};
+    Float2 halfSize = {};
+    REQUIRE(apc->GetWorldBounds(&center, &halfSize));
+    CHECK(center.x == 60.f);
+    CHECK(halfSize.x == 4.f);
+}
+
+TEST_CASE(Particle_BatchExpandsLikeDrawSprite)
+{
+    RENDER_QUAD quads[2] = {};
+    quads[1].Rect = { 10.f, 20.f, 4.f, 2.f };
+    quads[1].UV = { 0.25f, 0.5f, 0.25f, 0.5f };
+    quads[1].Color = { 1.f, 0.5f, 0.f, 1.f };
+    VERTEX vertices[8] = {};
+    WriteQuadVertices(vertices, quads, 2);
+
+    // top left, top right, bottom right, bottom left with the v flip
+    const VERTEX* v = vertices + 4;
+    CHECK(v[0].Position.x == 8.f && v[0].Position.y == 21.f);
+    CHECK(v[1].Position.x == 12.f && v[1].Position.y == 21.f);
+    CHECK(v[2].Position.x == 12.f && v[2].Position.y == 19.f);
+    CHECK(v[3].Position.x == 8.f && v[3].Position.y == 19.f);
+    CHECK(v[0].TexCoord.x == 0.25f && v[0].TexCoord.y == 1.f);
+    CHECK(v[2].TexCoord.x == 0.5f && v[2].TexCoord.y == 0.5f);
+    CHECK(v[3].Color.y == 0.5f);
+    CHECK(vertices[0].Position.x == 0.f);
+}
+
+TEST_CASE(Particle_CapacityRateAndLifetime)
+{
+    HeadlessScene scene = {};
+    PARTICLE_EMITTER emitter = MakeStraightEmitter(30, 0, 0.25f);
+    emitter.EmitRate = 100.f;
+    AParticleComponent* apc = AddEmitterActor(&scene, "fx",
+        MakeFloat3(0.f, 0.f, 0.f), emitter);
+    scene.GetSceneNode()->UpdateScene(0.f);
+    CHECK(apc->GetAliveCount() == 0);
+
+    apc->CompUpdate(0.1f);
+    CHECK(apc->GetAliveCount() == 10);
+    apc->EmitBurst(100);
+    CHECK(apc->GetAliveCount() == 30);
+
+    // the first wave is 0.3 old and the burst 0.2, only the burst lives
+    apc->SetEmitting(false);
+    apc->CompUpdate(0.2f);
+    CHECK(apc->GetAliveCount() == 20);
+    apc->CompUpdate(0.1f);
+    CHECK(apc->GetAliveCount() == 0);
+    Float2 center = {};
+    Float2 halfSize = {};
+    CHECK(!apc->GetWorldBounds(&center, &halfSize));
+}
+
+TEST_CASE(Particle_RecycleClearsAndRespawnBursts)
+{
+    HeadlessScene scene = {};
+    AParticleComponent* apc = AddEmitterActor(&scene, "fx",
+        MakeFloat3(0.f, 0.f, 0.f), MakeStraightEmitter(64, 12, 9.f));
+    scene.GetSceneNode()->UpdateScene(0.f);
+    apc->EmitBurst(20);
+    CHECK(apc->GetAliveCount() == 32);
+
+    apc->CompRecycle();
+    CHECK(apc->GetAliveCount() == 0);
+    apc->CompRespawn();
+    CHECK(apc->GetAliveCount() == 12);
+}
+
+TEST_CASE(Particle_EmittersOutOfViewAreCulled)
+{
+    HeadlessScene scene = {};
+    scene.GetSceneNode()->InitCamera(MakeFloat2(0.f, 0.f),
+        MakeFloat2(640.f, 480.f));
+    AddEmitterActor(&scene, "near", MakeFloat3(0.f, 0.f, 0.f),
+        MakeStraightEmitter(16, 16, 9.f));
+    AddEmitterActor(&scene, "far", MakeFloat3(5000.f, 0.f, 0.f),
+        MakeStraightEmitter(16, 16, 9.f));
+    scene.RunFrame(0.01f);
+
+    auto& stats = scene.GetSceneNode()->GetDrawStatistics();
+    CHECK(stats.SubmittedParticles == 16);
+    CHECK(stats.CulledEmitters == 1);
+}
+
+TEST_CASE(Particle_BenchMillionParticles)
+{
+    const unsigned int capacity = 1 << 20;
+    const int frames = 60;
+    HeadlessScene scene = {};
+    PARTICLE_EMITTER emitter = MakeStraightEmitter(capacity, capacity,
+        1000.f);
+    emitter.SpeedRange = MakeFloat2(10.f, 200.f);
+    emitter.AngleRange = MakeFloat2(0.f, 360.f);
+    AParticleComponent* apc = AddEmitterActor(&scene, "fx",
+        MakeFloat3(0.f, 0.f, 0.f), emitter);
+    scene.GetSceneNode()->UpdateScene(0.f);
+    REQUIRE(apc->GetAliveCount() == capacity);
+
+    size_t before = GetAllocationCount();
+    BenchTimer timer = {};
+    for (int i = 0; i < frames; i++)
+    {
+        apc->UpdateParticles(1.f / 60.f);
+    }
+    double updateMs = timer.GetElapsedMs() / frames;
+    size_t allocs = GetAllocationCount() - before;
+
+    // a whole frame is the update, filling the command list and the
+    // vertex expansion the d3d backend does into its stream buffer,
+    // the first draws grow the command lists to a million quads
+    std::vector<VERTEX> vertices((size_t)capacity * 4);
+    scene.DrawFrame();
+    scene.DrawFrame();
+    unsigned int batches = 0;
+    timer.ResetTimer();
+    for (int i = 0; i < frames; i++)
+    {
+        apc->UpdateParticles(1.f / 60.f);
+        scene.DrawFrame();
+        const RENDER_COMMAND* batch = FindParticleBatch(&scene);
+        if (batch)
+        {
+            WriteQuadVertices(vertices.data(),
+                scene.GetRenderBackend()->GetLastQuadArray()->data() +
+                batch->FirstQuad, batch->QuadCount);
+            ++batches;
+        }
+    }
+    double frameMs = timer.GetElapsedMs() / frames;
+
+    BENCH_LOG("%u particles, %.3f ms per update (%.2f ns each), "
+        "%.3f ms per frame with list fill and vertex expansion, "
+        "%zu allocations while updating\n", capacity, updateMs,
+        updateMs * 1000000.0 / capacity, frameMs, allocs);
+    CHECK(allocs == 0);
+    CHECK(batches == (unsigned int)frames);
+    CHECK(apc->GetAliveCount() == capacity);
+}
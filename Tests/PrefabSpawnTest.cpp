@@ -0,0 +1,227 @@
+﻿//---------------------------------------------------------------
+// File: PrefabSpawnTest.cpp
+// Proj: HycFrame2D
+// Info: プレハブの読み込みと生成のテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "HeadlessScene.h"
+#include "SceneNode.h"
+#include "ActorObject.h"
+#include "ATransformComponent.h"
+#include "ASpriteComponent.h"
+#include "ACollisionComponent.h"
+#include "PropertyManager.h"
+#include "PropertyNode.h"
+#include "ObjectFactory.h"
+#include <vector>
+
+namespace
+{
+    // the shipped prefab list, which only has the bullet
+    class PrefabScene
+    {
+    public:
+        PrefabScene() :
+            mPropertyManager(new PropertyManager()),
+            mObjectFactory(new ObjectFactory()),
+            mScene(new HeadlessScene()), mResult(false)
+        {
+            mObjectFactory->StartUp(mPropertyManager, nullptr);
+            mResult = mPropertyManager->StartUp(mObjectFactory);
+        }
+
+        ~PrefabScene()
+        {
+            delete mScene;
+            mPropertyManager->CleanAndStop();
+            delete mPropertyManager;
+            mObjectFactory->CleanAndStop();
+            delete mObjectFactory;
+        }
+
+        bool GetResult() const
+        {
+            return mResult;
+        }
+
+        HeadlessScene* GetScene() const
+        {
+            return mScene;
+        }
+
+        PropertyManager* GetPropertyManager() const
+        {
+            return mPropertyManager;
+        }
+
+        ActorObject* Spawn(const SPAWN_OVERRIDES& _overrides)
+        {
+            return mObjectFactory->Spawn(mScene->GetSceneNode(),
+                "bullet", _overrides);
+        }
+
+        ActorObject* SpawnAt(Float3 _pos)
+        {
+            SPAWN_OVERRIDES overrides = {};
+            overrides.HasPosition = true;
+            overrides.Position = _pos;
+            return Spawn(overrides);
+        }
+
+    private:
+        PropertyManager* mPropertyManager;
+
+        ObjectFactory* mObjectFactory;
+
+        HeadlessScene* mScene;
+
+        bool mResult;
+    };
+
+    ATransformComponent* GetTransform(ActorObject* _actor)
+    {
+        return _actor->GetAComponent<ATransformComponent>(
+            COMP_TYPE::ATRANSFORM);
+    }
+}
+
+TEST_CASE(PrefabSpawn_LoadsTheShippedPrefab)
+{
+    PrefabScene prefab = {};
+    REQUIRE(prefab.GetResult());
+    PropertyNode* node =
+        prefab.GetPropertyManager()->GetPropertyNode("bullet");
+    REQUIRE(node);
+    CHECK(node->GetObjectType() == OBJ_TYPE::ACTOR);
+    CHECK(node->GetDormantPolicy() == DORMANT_POLICY::SLEEP);
+    REQUIRE(node->GetTagArray()->size() == 1);
+    CHECK((*node->GetTagArray())[0] == "bullet");
+
+    // the components keep the order of the file
+    const std::vector<COMP_PROPERTY>* comps = node->GetComponentArray();
+    REQUIRE(comps->size() == 3);
+    CHECK((*comps)[0].Type == COMP_TYPE::ATRANSFORM);
+    CHECK((*comps)[0].UpdateOrder == -1);
+    CHECK((*comps)[1].Type == COMP_TYPE::ASPRITE);
+    CHECK((*comps)[1].TexSize.x == 20.f);
+    CHECK((*comps)[1].TexSize.y == 20.f);
+    CHECK((*comps)[2].Type == COMP_TYPE::ACOLLISION);
+    CHECK((*comps)[2].CollisionType == COLLISION_TYPE::CIRCLE);
+    CHECK((*comps)[2].CollisionSize.x == 10.f);
+
+    CHECK(!prefab.GetPropertyManager()->GetPropertyNode("missing"));
+}
+
+TEST_CASE(PrefabSpawn_OverridesAndTheRecyclePool)
+{
+    PrefabScene prefab = {};
+    REQUIRE(prefab.GetResult());
+    SceneNode* node = prefab.GetScene()->GetSceneNode();
+
+    SPAWN_OVERRIDES overrides = {};
+    overrides.HasPosition = true;
+    overrides.Position = MakeFloat3(30.f, 40.f, 0.f);
+    overrides.HasScale = true;
+    overrides.Scale = MakeFloat3(2.f, 3.f, 1.f);
+    ActorObject* first = prefab.Spawn(overrides);
+    ActorObject* second = prefab.Spawn({});
+    overrides = {};
+    overrides.Name = "boss-bullet";
+    ActorObject* named = prefab.Spawn(overrides);
+    REQUIRE(first && second && named);
+    prefab.GetScene()->RunFrame(MAX_DELTA);
+
+    // anonymous spawns get numbered names, an overridden one keeps its
+    // own and can be looked up like any scene actor
+    CHECK(first->GetObjectName() == "bullet-0");
+    CHECK(second->GetObjectName() == "bullet-1");
+    CHECK(node->GetActorObject("boss-bullet"_sid) == named);
+    CHECK(first->IsObjectActive() == STATUS::ACTIVE);
+    CHECK(first->HasTag("bullet"_sid));
+    CHECK(node->GetActorsWithTag("bullet"_sid)->size() == 3);
+
+    Float3 pos = GetTransform(first)->GetPosition();
+    Float3 scale = GetTransform(first)->GetScale();
+    CHECK(pos.x == 30.f && pos.y == 40.f);
+    CHECK(scale.x == 2.f && scale.y == 3.f);
+    pos = GetTransform(second)->GetPosition();
+    scale = GetTransform(second)->GetScale();
+    CHECK(pos.x == 0.f && pos.y == 0.f);
+    CHECK(scale.x == 1.f && scale.y == 1.f);
+    ASpriteComponent* asc = first->GetAComponent<ASpriteComponent>(
+        COMP_TYPE::ASPRITE);
+    REQUIRE(asc);
+    CHECK(asc->GetTexWidth() == 20.f);
+
+    // a retired anonymous bullet is handed out again with the prefab
+    // values under the new overrides, a named one is never pooled
+    asc->SetTexWidth(90.f);
+    first->SetObjectActive(STATUS::NEED_DESTORY);
+    named->SetObjectActive(STATUS::NEED_DESTORY);
+    prefab.GetScene()->RunFrame(MAX_DELTA);
+    CHECK(!node->FindActorObject("boss-bullet"_sid));
+
+    ActorObject* reused = prefab.SpawnAt(MakeFloat3(-5.f, 6.f, 0.f));
+    prefab.GetScene()->RunFrame(MAX_DELTA);
+    CHECK(reused == first);
+    CHECK(reused->IsObjectActive() == STATUS::ACTIVE);
+    CHECK(asc->GetTexWidth() == 20.f);
+    pos = GetTransform(reused)->GetPosition();
+    scale = GetTransform(reused)->GetScale();
+    CHECK(pos.x == -5.f && pos.y == 6.f);
+    CHECK(scale.x == 1.f && scale.y == 1.f);
+
+    overrides.Name = "boss-bullet";
+    ActorObject* renamed = prefab.Spawn(overrides);
+    CHECK(renamed != first);
+    CHECK(renamed != second);
+}
+
+TEST_CASE(PrefabSpawn_Bench10kSpawnsPerFrame)
+{
+    PrefabScene prefab = {};
+    REQUIRE(prefab.GetResult());
+    HeadlessScene* scene = prefab.GetScene();
+    scene->GetSceneNode()->InitCamera(MakeFloat2(0.f, 0.f),
+        MakeFloat2(1920.f, 1080.f));
+
+    // every frame spawns a full wave and retires the last one, the
+    // first frames fill the pool and the rest only reuse it
+    const int spawnNum = 10000;
+    const int frames = 30;
+    std::vector<ActorObject*> wave = {};
+    wave.reserve(spawnNum);
+    auto runWave = [&](int _frame)
+    {
+        for (auto& actor : wave)
+        {
+            actor->SetObjectActive(STATUS::NEED_DESTORY);
+        }
+        wave.clear();
+        for (int i = 0; i < spawnNum; i++)
+        {
+            wave.push_back(prefab.SpawnAt(MakeFloat3(
+                (float)(i % 100) * 19.f - 950.f,
+                (float)(i / 100) * 10.f - 500.f, 0.f)));
+        }
+        scene->RunFrame(MAX_DELTA);
+    };
+
+    HEADLESS_BENCH fresh = scene->BenchFrames(1, runWave);
+    HEADLESS_BENCH pooled = scene->BenchFrames(frames, runWave);
+    size_t live = 0;
+    for (auto& actor : wave)
+    {
+        live += actor->IsObjectActive() == STATUS::ACTIVE ? 1 : 0;
+    }
+
+    BENCH_LOG("%d bullet spawns per frame, %.2f ms fresh with %.0f "
+        "allocations, %.2f ms from the pool with %.0f allocations\n",
+        spawnNum, fresh.MsPerFrame, fresh.AllocationsPerFrame,
+        pooled.MsPerFrame, pooled.AllocationsPerFrame);
+    CHECK(live == (size_t)spawnNum);
+    CHECK(pooled.AllocationsPerFrame < fresh.AllocationsPerFrame);
+}
@@ -0,0 +1,243 @@
+﻿//---------------------------------------------------------------
+// File: RecyclePoolTest.cpp
+// Proj: HycFrame2D
+// Info: ACTORリサイクルプールのテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "HeadlessScene.h"
+#include "SceneNode.h"
+#include "ActorObject.h"
+#include "AComponent.h"
+#include "AInteractionComponent.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct LIFE_COUNT
+    {
+        unsigned int Init = 0;
+        unsigned int Destory = 0;
+    };
+
+    // the counts outlive the component, so a case can still read them
+    // after the scene has deleted every actor
+    class CountingAComponent :
+        public AComponent
+    {
+    public:
+        CountingAComponent(std::string _name, ActorObject* _owner,
+            LIFE_COUNT* _count) :
+            AComponent(_name, _owner, 0), mLifeCount(_count)
+        {
+
+        }
+
+        virtual void CompInit()
+        {
+            ++mLifeCount->Init;
+        }
+
+        virtual void CompDestory()
+        {
+            ++mLifeCount->Destory;
+        }
+
+    private:
+        LIFE_COUNT* mLifeCount;
+    };
+
+    ActorObject* AddCountedActor(HeadlessScene* _scene,
+        std::string _name, std::string _key, LIFE_COUNT* _count)
+    {
+        ActorObject* actor = _scene->AddEmptyActor(_name,
+            MakeFloat3(0.f, 0.f, 0.f));
+        actor->SetRecycleKey(_key);
+        actor->AddAComponent(new CountingAComponent(_name + "-count",
+            actor, _count));
+
+        return actor;
+    }
+
+    void RetireActor(HeadlessScene* _scene, ActorObject* _actor)
+    {
+        _actor->SetObjectActive(STATUS::NEED_DESTORY);
+        _scene->GetSceneNode()->UpdateScene(MAX_DELTA);
+    }
+
+    LIFE_COUNT g_ScriptCount = {};
+
+    unsigned int g_ScriptSteps = 0;
+
+    ScriptCoroutine StepEveryFrame(AInteractionComponent* _aitc)
+    {
+        while (true)
+        {
+            ++g_ScriptSteps;
+            co_await WaitFrames(1);
+        }
+    }
+
+    // the same steps the factory takes when it reuses a pooled actor
+    ActorObject* RespawnActor(HeadlessScene* _scene, std::string _key)
+    {
+        ActorObject* actor =
+            _scene->GetSceneNode()->TakeRecycledActor(_key);
+        if (actor)
+        {
+            actor->SetObjectActive(STATUS::NEED_INIT);
+            _scene->GetSceneNode()->AddActorObject(actor);
+            _scene->GetSceneNode()->UpdateScene(MAX_DELTA);
+        }
+
+        return actor;
+    }
+}
+
+TEST_CASE(RecyclePool_DestoryRunsOnceAcrossRetireRespawnAndRelease)
+{
+    LIFE_COUNT count = {};
+    {
+        HeadlessScene scene = {};
+        ActorObject* actor = AddCountedActor(&scene, "bullet", "bullet",
+            &count);
+        scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+        CHECK(count.Init == 1);
+        CHECK(count.Destory == 0);
+
+        RetireActor(&scene, actor);
+        CHECK(count.Destory == 1);
+
+        ActorObject* respawned = RespawnActor(&scene, "bullet");
+        REQUIRE(respawned == actor);
+        CHECK(count.Init == 2);
+        CHECK(count.Destory == 1);
+        CHECK(scene.GetSceneNode()->GetActorObject("bullet"_sid) ==
+            actor);
+
+        RetireActor(&scene, actor);
+        CHECK(count.Destory == 2);
+    }
+    // the parked actor is freed without another destroy
+    CHECK(count.Init == 2);
+    CHECK(count.Destory == 2);
+}
+
+TEST_CASE(RecyclePool_LiveAndUnkeyedActorsAreDestoryedOnce)
+{
+    LIFE_COUNT live = {};
+    LIFE_COUNT unkeyed = {};
+    {
+        HeadlessScene scene = {};
+        AddCountedActor(&scene, "live", "live", &live);
+        ActorObject* plain = AddCountedActor(&scene, "plain", "",
+            &unkeyed);
+        scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+
+        RetireActor(&scene, plain);
+        CHECK(unkeyed.Destory == 1);
+        CHECK(scene.GetSceneNode()->TakeRecycledActor("") == nullptr);
+    }
+    CHECK(live.Destory == 1);
+    CHECK(unkeyed.Destory == 1);
+}
+
+TEST_CASE(RecyclePool_ScriptsKeepTheirStateInThePool)
+{
+    g_ScriptCount = {};
+    g_ScriptSteps = 0;
+    HeadlessScene scene = {};
+    ActorObject* actor = scene.AddEmptyActor("enemy",
+        MakeFloat3(0.f, 0.f, 0.f));
+    actor->SetRecycleKey("enemy");
+    AInteractionComponent* aitc = new AInteractionComponent(
+        "enemy-interaction", actor, 0);
+    aitc->SetInitFunc([](AInteractionComponent*)
+        {
+            ++g_ScriptCount.Init;
+        });
+    aitc->SetDestoryFunc([](AInteractionComponent*)
+        {
+            ++g_ScriptCount.Destory;
+        });
+    aitc->SetCoroutineFunc(StepEveryFrame);
+    actor->AddAComponent(aitc);
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+    CHECK(g_ScriptSteps == 2);
+
+    // neither hook runs for the pool, the coroutine just waits parked
+    // until the actor is active again
+    RetireActor(&scene, actor);
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+    CHECK(g_ScriptSteps == 2);
+    CHECK(scene.GetSceneNode()->GetCoroutineScheduler()->
+        GetParkedCount() == 1);
+    REQUIRE(RespawnActor(&scene, "enemy") == actor);
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+    CHECK(g_ScriptSteps == 4);
+    CHECK(g_ScriptCount.Init == 1);
+    CHECK(g_ScriptCount.Destory == 0);
+}
+
+TEST_CASE(RecyclePool_BenchRespawnAgainstNewActors)
+{
+    const int actorNum = 2000;
+    const int rounds = 10;
+    LIFE_COUNT count = {};
+    HeadlessScene scene = {};
+    std::vector<ActorObject*> actors = {};
+
+    BenchTimer timer = {};
+    for (int r = 0; r < rounds; r++)
+    {
+        for (int i = 0; i < actorNum; i++)
+        {
+            actors.push_back(scene.AddSpriteActor(
+                "new-" + std::to_string(r) + "-" + std::to_string(i),
+                MakeFloat3(0.f, 0.f, 0.f), MakeFloat2(8.f, 8.f), 0));
+        }
+        scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+        for (auto& actor : actors)
+        {
+            actor->SetObjectActive(STATUS::NEED_DESTORY);
+        }
+        scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+        actors.clear();
+    }
+    double spawnNew = timer.GetElapsedMs() / rounds;
+
+    for (int i = 0; i < actorNum; i++)
+    {
+        actors.push_back(AddCountedActor(&scene,
+            "pooled-" + std::to_string(i), "pooled", &count));
+    }
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+    timer.ResetTimer();
+    for (int r = 0; r < rounds; r++)
+    {
+        for (auto& actor : actors)
+        {
+            actor->SetObjectActive(STATUS::NEED_DESTORY);
+        }
+        scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+        for (int i = 0; i < actorNum; i++)
+        {
+            ActorObject* actor =
+                scene.GetSceneNode()->TakeRecycledActor("pooled");
+            actor->SetObjectActive(STATUS::NEED_INIT);
+            scene.GetSceneNode()->AddActorObject(actor);
+        }
+        scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+    }
+    double spawnPooled = timer.GetElapsedMs() / rounds;
+
+    BENCH_LOG("%d actors per wave, %.3f ms to spawn and retire new "
+        "ones, %.3f ms through the pool\n", actorNum, spawnNew,
+        spawnPooled);
+    CHECK(count.Init == (unsigned int)(actorNum * (rounds + 1)));
+    CHECK(count.Destory == (unsigned int)(actorNum * rounds));
+}
@@ -0,0 +1,284 @@
+﻿//---------------------------------------------------------------
+// File: RenderQueueTest.cpp
+// Proj: HycFrame2D
+// Info: 描画コマンドキューと描画スレッドのテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "RenderCommandQueue.h"
+
+namespace
+{
+    const RENDER_MATRIX IDENTITY =
+    {
+        1.f,0.f,0.f,0.f,
+        0.f,1.f,0.f,0.f,
+        0.f,0.f,1.f,0.f,
+        0.f,0.f,0.f,1.f
+    };
+
+    // every quad of a frame carries the frame number in its color, a
+    // frame that mixes numbers was played while still being recorded
+    class FrameCheckBackend :
+        public RenderBackend
+    {
+    public:
+        FrameCheckBackend() :
+            mFrameCount(0), mTornFrameCount(0), mOutOfOrderCount(0),
+            mQuadCount(0), mLastFrame(-1.f), mCurrentFrame(-1.f)
+        {
+
+        }
+
+        virtual bool StartUp()
+        {
+            return true;
+        }
+
+        virtual void CleanAndStop()
+        {
+
+        }
+
+        virtual void BeginFrame()
+        {
+            mCurrentFrame = -1.f;
+        }
+
+        virtual void ExecuteCommand(const RENDER_COMMAND& _cmd,
+            const RENDER_MATRIX&, const RENDER_QUAD* _quads)
+        {
+            // the view has no quad to carry the number
+            if (_cmd.Type == RENDER_CMD_TYPE::SET_VIEW)
+            {
+                return;
+            }
+
+            for (unsigned int i = 0; i < _cmd.QuadCount; i++)
+            {
+                if (mCurrentFrame < 0.f)
+                {
+                    mCurrentFrame = _quads[i].Color.x;
+                }
+                else if (_quads[i].Color.x != mCurrentFrame)
+                {
+                    ++mTornFrameCount;
+                }
+                ++mQuadCount;
+            }
+        }
+
+        virtual void EndFrame()
+        {
+            if (mCurrentFrame <= mLastFrame)
+            {
+                ++mOutOfOrderCount;
+            }
+            mLastFrame = mCurrentFrame;
+            ++mFrameCount;
+        }
+
+    public:
+        unsigned int mFrameCount;
+
+        unsigned int mTornFrameCount;
+
+        unsigned int mOutOfOrderCount;
+
+        unsigned long long mQuadCount;
+
+        float mLastFrame;
+
+        float mCurrentFrame;
+    };
+
+    void RecordFrame(RenderCommandList* _list, int _frame,
+        int _spriteNum)
+    {
+        RENDER_FLOAT4 color = { (float)_frame, 0.f, 0.f, 1.f };
+        _list->SetViewMatrix(IDENTITY);
+        for (int i = 0; i < _spriteNum; i++)
+        {
+            _list->PushSprite(IDENTITY, nullptr,
+                { 0.f, 0.f, 16.f, 16.f },
+                { 0.f, 0.f, 1.f, 1.f }, color);
+        }
+        _list->BeginTextRun(nullptr);
+        _list->PushGlyph({ 0.f, 0.f, 8.f, 8.f },
+            { 0.f, 0.f, 1.f, 1.f }, color);
+        _list->PushGlyph({ 8.f, 0.f, 8.f, 8.f },
+            { 0.f, 0.f, 1.f, 1.f }, color);
+    }
+
+    double BenchQueue(bool _useRenderThread, int _frames,
+        int _spriteNum)
+    {
+        NullRenderBackend backend = {};
+        RenderCommandQueue queue = {};
+        queue.StartUp(&backend, _useRenderThread);
+
+        BenchTimer timer = {};
+        for (int f = 0; f < _frames; f++)
+        {
+            RecordFrame(queue.GetRecordingList(), f, _spriteNum);
+            queue.SubmitFrame();
+        }
+        queue.WaitForRenderIdle();
+        double elapsed = timer.GetElapsedMs();
+        queue.CleanAndStop();
+
+        return elapsed / _frames;
+    }
+}
+
+TEST_CASE(RenderQueue_InlinePlaybackRecordsEveryCommand)
+{
+    NullRenderBackend backend = {};
+    RenderCommandQueue queue = {};
+    REQUIRE(queue.StartUp(&backend, false));
+
+    RecordFrame(queue.GetRecordingList(), 0, 3);
+    // a glyph outside a text run has nowhere to go
+    queue.GetRecordingList()->SetViewMatrix(IDENTITY);
+    queue.GetRecordingList()->PushGlyph({ 0.f, 0.f, 1.f, 1.f },
+        { 0.f, 0.f, 1.f, 1.f }, { 0.f, 0.f, 0.f, 1.f });
+    queue.SubmitFrame();
+
+    auto commands = backend.GetLastCommandArray();
+    REQUIRE(commands->size() == 6);
+    CHECK((*commands)[0].Type == RENDER_CMD_TYPE::SET_VIEW);
+    CHECK((*commands)[1].Type == RENDER_CMD_TYPE::SPRITE);
+    CHECK((*commands)[4].Type == RENDER_CMD_TYPE::TEXT_RUN);
+    CHECK((*commands)[4].QuadCount == 2);
+    CHECK((*commands)[4].FirstQuad == 3);
+    CHECK(backend.GetLastQuadArray()->size() == 5);
+    CHECK(backend.GetLastTransformArray()->size() == 6);
+    CHECK(backend.GetFrameCount() == 1);
+    CHECK(queue.GetRecordingList()->GetCommandArray()->empty());
+
+    queue.CleanAndStop();
+}
+
+TEST_CASE(RenderQueue_AppendListMovesQuadOffsets)
+{
+    RenderCommandList source = {};
+    RenderCommandList target = {};
+    RecordFrame(&source, 1, 2);
+    RecordFrame(&target, 2, 1);
+    size_t targetQuads = target.GetQuadArray()->size();
+
+    // only the sprites and the text run after the view are appended
+    target.AppendList(&source, 1);
+    auto commands = target.GetCommandArray();
+    REQUIRE(commands->size() == 6);
+    CHECK((*commands)[3].FirstQuad == targetQuads);
+    CHECK((*commands)[5].FirstQuad == targetQuads + 2);
+    CHECK((*commands)[5].QuadCount == 2);
+    CHECK(target.GetQuadArray()->size() == targetQuads + 4);
+    CHECK((*target.GetQuadArray())[targetQuads].Color.x == 1.f);
+    CHECK((*commands)[3].Transform == 3);
+    CHECK(target.GetTransformArray()->size() == 6);
+
+    target.AppendList(&source, 100);
+    CHECK(commands->size() == 6);
+}
+
+TEST_CASE(RenderQueue_BatchesShareOneTransform)
+{
+    // a quad is rect, uv and color only, no matrix rides along
+    CHECK(sizeof(RENDER_QUAD) == 12 * sizeof(float));
+
+    RENDER_MATRIX view = IDENTITY;
+    view._14 = -32.f;
+    RENDER_MATRIX world = IDENTITY;
+    world._24 = 8.f;
+    RenderCommandList list = {};
+    list.SetViewMatrix(view);
+    RENDER_QUAD* quads = list.AllocateQuadBatch(
+        RENDER_CMD_TYPE::PARTICLE_BATCH, world, nullptr, 1000);
+    REQUIRE(quads);
+    quads[999].Rect = { 1.f, 2.f, 3.f, 4.f };
+    CHECK(!list.AllocateQuadBatch(RENDER_CMD_TYPE::TILE_CHUNK, world,
+        nullptr, 0));
+
+    NullRenderBackend backend = {};
+    RenderCommandQueue queue = {};
+    REQUIRE(queue.StartUp(&backend, false));
+    queue.GetRecordingList()->AppendList(&list, 0);
+    queue.SubmitFrame();
+
+    auto commands = backend.GetLastCommandArray();
+    auto transforms = backend.GetLastTransformArray();
+    REQUIRE(commands->size() == 2);
+    REQUIRE(transforms->size() == 2);
+    CHECK((*commands)[0].Type == RENDER_CMD_TYPE::SET_VIEW);
+    CHECK((*commands)[0].QuadCount == 0);
+    CHECK((*transforms)[(*commands)[0].Transform]._14 == -32.f);
+    CHECK((*transforms)[(*commands)[1].Transform]._24 == 8.f);
+    CHECK(backend.GetLastQuadArray()->size() == 1000);
+    CHECK((*backend.GetLastQuadArray())[999].Rect.w == 4.f);
+    queue.CleanAndStop();
+}
+
+TEST_CASE(RenderQueue_CachedBatchesKeepTheirKey)
+{
+    RENDER_QUAD quads[3] = {};
+    quads[2].Color = { 1.f, 0.f, 0.f, 1.f };
+    RenderCommandList list = {};
+    list.PushQuadBatch(RENDER_CMD_TYPE::PARTICLE_BATCH, IDENTITY,
+        nullptr, quads, 3);
+    list.PushCachedQuadBatch(RENDER_CMD_TYPE::TILE_CHUNK, IDENTITY,
+        nullptr, quads, 3, 42, 7);
+    list.PushCachedQuadBatch(RENDER_CMD_TYPE::TILE_CHUNK, IDENTITY,
+        nullptr, quads, 0, 43, 1);
+
+    // the key survives being appended into the frame list
+    RenderCommandList frame = {};
+    frame.SetViewMatrix(IDENTITY);
+    frame.AppendList(&list, 0);
+    auto commands = frame.GetCommandArray();
+    REQUIRE(commands->size() == 3);
+    CHECK((*commands)[1].CacheKey == 0);
+    CHECK((*commands)[2].CacheKey == 42);
+    CHECK((*commands)[2].CacheRevision == 7);
+    CHECK((*commands)[2].QuadCount == 3);
+    CHECK((*frame.GetQuadArray())[(*commands)[2].FirstQuad + 2].
+        Color.x == 1.f);
+}
+
+TEST_CASE(RenderQueue_RenderThreadNeverPlaysATornFrame)
+{
+    const int frames = 500;
+    const int spriteNum = 200;
+    FrameCheckBackend backend = {};
+    RenderCommandQueue queue = {};
+    REQUIRE(queue.StartUp(&backend, true));
+
+    for (int f = 0; f < frames; f++)
+    {
+        RecordFrame(queue.GetRecordingList(), f, spriteNum);
+        queue.SubmitFrame();
+    }
+    queue.WaitForRenderIdle();
+
+    CHECK(backend.mFrameCount == (unsigned int)frames);
+    CHECK(backend.mTornFrameCount == 0);
+    CHECK(backend.mOutOfOrderCount == 0);
+    CHECK(backend.mLastFrame == (float)(frames - 1));
+    CHECK(backend.mQuadCount ==
+        (unsigned long long)frames * (spriteNum + 2));
+    queue.CleanAndStop();
+}
+
+TEST_CASE(RenderQueue_BenchRenderThreadAgainstInline)
+{
+    const int frames = 300;
+    const int spriteNum = 10000;
+    double inlineMs = BenchQueue(false, frames, spriteNum);
+    double threadMs = BenchQueue(true, frames, spriteNum);
+
+    BENCH_LOG("%d sprites, %.4f ms per frame inline, %.4f ms with "
+        "the render thread\n", spriteNum, inlineMs, threadMs);
+}
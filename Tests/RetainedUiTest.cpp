@@ -0,0 +1,141 @@
+﻿//---------------------------------------------------------------
+// File: RetainedUiTest.cpp
+// Proj: HycFrame2D
+// Info: 保持モードUI描画のテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "HeadlessScene.h"
+#include "SceneNode.h"
+#include "UiObject.h"
+#include "UTransformComponent.h"
+#include "USpriteComponent.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+    unsigned int GetRebuildCount(HeadlessScene* _scene)
+    {
+        return _scene->GetSceneNode()->GetDrawStatistics().
+            RebuiltUiFrames;
+    }
+
+    // the colors of every ui sprite in submit order
+    std::vector<RENDER_FLOAT4> GetDrawnUiColors(HeadlessScene* _scene)
+    {
+        std::vector<RENDER_FLOAT4> colors = {};
+        auto backend = _scene->GetRenderBackend();
+        for (auto& cmd : *(backend->GetLastCommandArray()))
+        {
+            if (cmd.Type == RENDER_CMD_TYPE::SPRITE)
+            {
+                colors.push_back(
+                    (*(backend->GetLastQuadArray()))[cmd.FirstQuad].
+                    Color);
+            }
+        }
+
+        return colors;
+    }
+
+    void FillWidgets(HeadlessScene* _scene, int _count,
+        std::vector<UiObject*>* _out)
+    {
+        for (int i = 0; i < _count; i++)
+        {
+            _out->push_back(_scene->AddSpriteUi(
+                "widget-" + std::to_string(i),
+                MakeFloat3(-900.f + (float)(i % 50) * 36.f,
+                    500.f - (float)(i / 50) * 24.f, 0.f),
+                MakeFloat2(32.f, 20.f), i));
+        }
+    }
+}
+
+TEST_CASE(RetainedUi_StaticWidgetsAreRecordedOnce)
+{
+    HeadlessScene scene = {};
+    std::vector<UiObject*> widgets = {};
+    FillWidgets(&scene, 20, &widgets);
+    scene.RunFrame(MAX_DELTA);
+    unsigned int rebuilt = GetRebuildCount(&scene);
+    std::vector<RENDER_FLOAT4> first = GetDrawnUiColors(&scene);
+    CHECK(first.size() == 20);
+
+    for (int i = 0; i < 10; i++)
+    {
+        scene.RunFrame(MAX_DELTA);
+    }
+    CHECK(GetRebuildCount(&scene) == rebuilt);
+    // the cached commands are replayed every frame all the same
+    CHECK(GetDrawnUiColors(&scene).size() == 20);
+}
+
+TEST_CASE(RetainedUi_ChangesRebuildOnce)
+{
+    HeadlessScene scene = {};
+    std::vector<UiObject*> widgets = {};
+    FillWidgets(&scene, 5, &widgets);
+    scene.RunFrame(MAX_DELTA);
+    unsigned int rebuilt = GetRebuildCount(&scene);
+
+    USpriteComponent* usc = widgets[2]->
+        GetUComponent<USpriteComponent>(COMP_TYPE::USPRITE);
+    usc->SetOffsetColor(MakeFloat4(1.f, 0.f, 0.f, 1.f));
+    scene.RunFrame(MAX_DELTA);
+    scene.RunFrame(MAX_DELTA);
+    CHECK(GetRebuildCount(&scene) == rebuilt + 1);
+    std::vector<RENDER_FLOAT4> colors = GetDrawnUiColors(&scene);
+    REQUIRE(colors.size() == 5);
+    CHECK(colors[2].y == 0.f);
+    CHECK(colors[1].y == 1.f);
+
+    widgets[0]->GetUComponent<UTransformComponent>(
+        COMP_TYPE::UTRANSFORM)->Translate(MakeFloat3(1.f, 0.f, 0.f));
+    scene.RunFrame(MAX_DELTA);
+    CHECK(GetRebuildCount(&scene) == rebuilt + 2);
+
+    usc->SetVisible(false);
+    scene.RunFrame(MAX_DELTA);
+    CHECK(GetRebuildCount(&scene) == rebuilt + 3);
+    CHECK(GetDrawnUiColors(&scene).size() == 4);
+
+    widgets[4]->SetObjectActive(STATUS::NEED_DESTORY);
+    scene.RunFrame(MAX_DELTA);
+    CHECK(GetRebuildCount(&scene) == rebuilt + 4);
+    CHECK(GetDrawnUiColors(&scene).size() == 3);
+}
+
+TEST_CASE(RetainedUi_BenchStaticHud)
+{
+    const int widgetNum = 2000;
+    const int frames = 300;
+    HeadlessScene scene = {};
+    std::vector<UiObject*> widgets = {};
+    FillWidgets(&scene, widgetNum, &widgets);
+    scene.RunFrame(MAX_DELTA);
+
+    unsigned int rebuilt = GetRebuildCount(&scene);
+    BenchTimer timer = {};
+    for (int i = 0; i < frames; i++)
+    {
+        scene.RunFrame(MAX_DELTA);
+    }
+    double cachedMs = timer.GetElapsedMs() / frames;
+    unsigned int cachedRebuilt = GetRebuildCount(&scene) - rebuilt;
+
+    timer.ResetTimer();
+    for (int i = 0; i < frames; i++)
+    {
+        scene.GetSceneNode()->MarkUiDrawDirty();
+        scene.RunFrame(MAX_DELTA);
+    }
+    double rebuildMs = timer.GetElapsedMs() / frames;
+
+    BENCH_LOG("%d widgets, %.4f ms per frame retained, %.4f ms when "
+        "recorded every frame\n", widgetNum, cachedMs, rebuildMs);
+    CHECK(cachedRebuilt == 0);
+}
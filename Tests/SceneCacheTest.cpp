@@ -0,0 +1,222 @@
+﻿//---------------------------------------------------------------
+// File: SceneCacheTest.cpp
+// Proj: HycFrame2D
+// Info: シーンキャッシュのテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "HeadlessScene.h"
+#include "SceneCache.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const int SCENE_NUM = 6;
+    const size_t MB = 1024 * 1024;
+
+    // the cache never looks inside a scene, it only needs distinct
+    // nodes to hand back
+    struct SCENE_SET
+    {
+        HeadlessScene Holder[SCENE_NUM];
+
+        SceneNode* Get(int _index) const
+        {
+            return Holder[_index].GetSceneNode();
+        }
+    };
+
+    std::string GetSceneName(int _index)
+    {
+        return std::to_string(_index) + "-scene";
+    }
+
+    bool Contains(const std::vector<SceneNode*>& _array,
+        SceneNode* _scene)
+    {
+        return std::find(_array.begin(), _array.end(), _scene) !=
+            _array.end();
+    }
+
+    void InsertLoaded(SceneCache* _cache, const SCENE_SET& _set,
+        int _index, size_t _memorySize)
+    {
+        _cache->InsertScene(GetSceneName(_index), _set.Get(_index),
+            _memorySize, false);
+    }
+}
+
+TEST_CASE(SceneCache_LeastRecentlyUsedSceneIsEvicted)
+{
+    SCENE_SET set = {};
+    SceneCache cache = {};
+    cache.SetCacheLimit(3, SCENE_CACHE_DEFAULT_BUDGET);
+    for (int i = 0; i < 3; i++)
+    {
+        InsertLoaded(&cache, set, i, MB);
+    }
+
+    // 0 is touched again, so 1 becomes the oldest one
+    bool ready = true;
+    CHECK(cache.FindScene(GetSceneName(0), &ready) == set.Get(0));
+    CHECK(!ready);
+    InsertLoaded(&cache, set, 3, MB);
+
+    std::vector<SceneNode*> evicted = {};
+    cache.EvictScenes(set.Get(3), &evicted);
+    REQUIRE(evicted.size() == 1);
+    CHECK(evicted[0] == set.Get(1));
+
+    // peeking does not count as a use
+    CHECK(cache.PeekScene(GetSceneName(2), &ready) == set.Get(2));
+    InsertLoaded(&cache, set, 4, MB);
+    evicted.clear();
+    cache.EvictScenes(set.Get(4), &evicted);
+    REQUIRE(evicted.size() == 1);
+    CHECK(evicted[0] == set.Get(2));
+
+    CHECK(cache.PeekScene(GetSceneName(1), &ready) == nullptr);
+    SCENE_CACHE_STATISTICS stats = cache.GetStatistics();
+    CHECK(stats.SceneNum == 3);
+    CHECK(stats.MemorySize == 3 * MB);
+    CHECK(stats.EvictCount == 2);
+    CHECK(stats.ResetSwitchCount == 1);
+}
+
+TEST_CASE(SceneCache_MemoryBudgetKeepsTheSceneInUse)
+{
+    SCENE_SET set = {};
+    SceneCache cache = {};
+    cache.SetCacheLimit(SCENE_NUM, 100 * MB);
+    InsertLoaded(&cache, set, 0, 30 * MB);
+    InsertLoaded(&cache, set, 1, 40 * MB);
+    InsertLoaded(&cache, set, 2, 20 * MB);
+
+    std::vector<SceneNode*> evicted = {};
+    cache.EvictScenes(set.Get(2), &evicted);
+    CHECK(evicted.empty());
+
+    // only as many old scenes go as needed to fit the budget again
+    InsertLoaded(&cache, set, 3, 40 * MB);
+    cache.EvictScenes(set.Get(3), &evicted);
+    CHECK(evicted.size() == 1);
+    CHECK(Contains(evicted, set.Get(0)));
+    CHECK(cache.GetStatistics().MemorySize == 100 * MB);
+
+    // a scene that grew past the whole budget still stays while used
+    cache.UpdateSceneMemory(set.Get(3), 150 * MB);
+    evicted.clear();
+    cache.EvictScenes(set.Get(3), &evicted);
+    CHECK(evicted.size() == 2);
+    CHECK(cache.GetStatistics().SceneNum == 1);
+
+    bool ready = false;
+    CHECK(cache.PeekScene(GetSceneName(3), &ready) == set.Get(3));
+
+    evicted.clear();
+    cache.RemoveAllScenes(&evicted);
+    CHECK(evicted.size() == 1);
+    CHECK(cache.GetStatistics().SceneNum == 0);
+}
+
+TEST_CASE(SceneCache_PreloadedScenesSwitchOnce)
+{
+    SCENE_SET set = {};
+    SceneCache cache = {};
+    cache.SetCacheLimit(3, SCENE_CACHE_DEFAULT_BUDGET);
+    InsertLoaded(&cache, set, 0, MB);
+    CHECK(cache.CanPreloadScene(set.Get(0)));
+
+    cache.InsertScene(GetSceneName(1), set.Get(1), MB, true);
+    CHECK(cache.CanPreloadScene(set.Get(0)));
+    cache.InsertScene(GetSceneName(2), set.Get(2), MB, true);
+
+    // a third preload would push out one still waiting to be entered
+    CHECK(!cache.CanPreloadScene(set.Get(0)));
+
+    bool ready = false;
+    CHECK(cache.FindScene(GetSceneName(1), &ready) == set.Get(1));
+    CHECK(ready);
+    CHECK(cache.CanPreloadScene(set.Get(1)));
+
+    // entering used the ready state up
+    CHECK(cache.FindScene(GetSceneName(1), &ready) == set.Get(1));
+    CHECK(!ready);
+    CHECK(cache.FindScene(GetSceneName(5), &ready) == nullptr);
+
+    // the never entered preload is the one that gets dropped
+    InsertLoaded(&cache, set, 3, MB);
+    InsertLoaded(&cache, set, 4, MB);
+    std::vector<SceneNode*> evicted = {};
+    cache.EvictScenes(set.Get(4), &evicted);
+    CHECK(evicted.size() == 2);
+    CHECK(Contains(evicted, set.Get(2)));
+
+    SCENE_CACHE_STATISTICS stats = cache.GetStatistics();
+    CHECK(stats.PreloadCount == 2);
+    CHECK(stats.InstantSwitchCount == 1);
+    CHECK(stats.ResetSwitchCount == 1);
+    CHECK(stats.LoadSwitchCount == 1);
+    CHECK(stats.UnusedPreloadCount == 1);
+}
+
+TEST_CASE(SceneCache_BenchHintedSceneTour)
+{
+    // a player walks 0-1-2-3-4-5 and back again with the next scene
+    // always hinted, so no switch has to wait for a load
+    const int lapNum = 20000;
+    SCENE_SET set = {};
+    SceneCache cache = {};
+    cache.SetCacheLimit(4, SCENE_CACHE_DEFAULT_BUDGET);
+    std::vector<SceneNode*> evicted = {};
+    evicted.reserve(SCENE_NUM);
+
+    BenchTimer timer = {};
+    timer.ResetTimer();
+    int current = 0;
+    int direction = 1;
+    InsertLoaded(&cache, set, current, MB);
+    for (int s = 0; s < lapNum * SCENE_NUM; s++)
+    {
+        int next = current + direction;
+        if (next < 0 || next >= SCENE_NUM)
+        {
+            direction = -direction;
+            next = current + direction;
+        }
+
+        // the hint is worked off before the switch like the preload
+        // thread does, a cached scene is only reset again
+        bool ready = false;
+        cache.PeekScene(GetSceneName(next), &ready);
+        if (!ready && cache.CanPreloadScene(set.Get(current)))
+        {
+            cache.InsertScene(GetSceneName(next), set.Get(next), MB,
+                true);
+        }
+
+        if (!cache.FindScene(GetSceneName(next), &ready))
+        {
+            InsertLoaded(&cache, set, next, MB);
+        }
+        evicted.clear();
+        cache.EvictScenes(set.Get(next), &evicted);
+        current = next;
+    }
+    double elapsed = timer.GetElapsedMs();
+
+    SCENE_CACHE_STATISTICS stats = cache.GetStatistics();
+    BENCH_LOG("%d switches, %.1f ns each, %llu instant, %llu reset, "
+        "%llu load, %llu evicted\n", lapNum * SCENE_NUM,
+        elapsed * 1000000.0 / (lapNum * SCENE_NUM),
+        stats.InstantSwitchCount, stats.ResetSwitchCount,
+        stats.LoadSwitchCount, stats.EvictCount);
+    CHECK(stats.InstantSwitchCount ==
+        (unsigned long long)lapNum * SCENE_NUM);
+    CHECK(stats.LoadSwitchCount == 0);
+    CHECK(stats.UnusedPreloadCount == 0);
+}
@@ -0,0 +1,294 @@
+﻿//---------------------------------------------------------------
+// File: ScriptCoroutineTest.cpp
+// Proj: HycFrame2D
+// Info: コルーチンスケジューラーの起床順と所有者の状態のテスト
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "HeadlessScene.h"
+#include "ScriptCoroutine.h"
+#include "SceneNode.h"
+#include "ActorObject.h"
+#include "ATransformComponent.h"
+#include "ACollisionComponent.h"
+#include "AInteractionComponent.h"
+#include <string>
+
+namespace
+{
+    std::string g_WakeOrder = "";
+
+    unsigned int g_LoopCount = 0;
+
+    unsigned int g_HitCount = 0;
+
+    ScriptCoroutine WakeAfterSeconds(float _seconds, char _tag)
+    {
+        co_await WaitSeconds(_seconds);
+        g_WakeOrder += _tag;
+    }
+
+    ScriptCoroutine WakeAfterFrames(unsigned int _frames, char _tag)
+    {
+        co_await WaitFrames(_frames);
+        g_WakeOrder += _tag;
+    }
+
+    class WaitForFlag :
+        public CoroutineCondition
+    {
+    public:
+        WaitForFlag(StringID _signal, const bool* _flag) :
+            mSignal(_signal), mFlag(_flag)
+        {
+
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(CoroutineHandle _handle)
+        {
+            _handle.promise().Scheduler->ScheduleOnSignal(_handle,
+                mSignal, this);
+        }
+
+        void await_resume() const noexcept
+        {
+
+        }
+
+        virtual bool IsSatisfied()
+        {
+            return *mFlag;
+        }
+
+    private:
+        StringID mSignal;
+
+        const bool* mFlag;
+    };
+
+    ScriptCoroutine WakeOnFlag(const bool* _flag, char _tag)
+    {
+        co_await WaitForFlag("flag-signal"_sid, _flag);
+        g_WakeOrder += _tag;
+    }
+
+    ScriptCoroutine CountEveryFrame(AInteractionComponent* _aitc)
+    {
+        while (true)
+        {
+            ++g_LoopCount;
+            co_await WaitFrames(1);
+        }
+    }
+
+    ScriptCoroutine CountTargetHits(AInteractionComponent* _aitc)
+    {
+        ACollisionComponent* acc = _aitc->GetActorObjOwner()->
+            GetAComponent<ACollisionComponent>(COMP_TYPE::ACOLLISION);
+        co_await WaitUntilCollision(acc, "target"_sid);
+        ++g_HitCount;
+        co_await WaitSeconds(1000.f);
+    }
+
+    // the textures for showing the shape need a device, the shape
+    // itself doesn't
+    class QuietCollision :
+        public ACollisionComponent
+    {
+    public:
+        QuietCollision(ActorObject* _owner) :
+            ACollisionComponent(_owner->GetObjectName() + "-collision",
+                _owner, 0)
+        {
+            SetCollisionStatus(COLLISION_TYPE::CIRCLE,
+                MakeFloat2(10.f, 10.f), false);
+        }
+
+        virtual void CompInit()
+        {
+
+        }
+    };
+
+    ActorObject* AddCollider(HeadlessScene* _scene, std::string _name,
+        Float3 _pos)
+    {
+        ActorObject* actor = new ActorObject(_name,
+            _scene->GetSceneNode(), 0);
+        ATransformComponent* atc = new ATransformComponent(
+            _name + "-transform", actor, 0, _pos);
+        atc->SetRotation(MakeFloat3(0.f, 0.f, 0.f));
+        actor->AddAComponent(atc);
+        actor->AddAComponent(new QuietCollision(actor));
+        _scene->GetSceneNode()->AddActorObject(actor);
+
+        return actor;
+    }
+
+    AInteractionComponent* AddScript(ActorObject* _actor,
+        ActorInterCoroutineFuncType _func)
+    {
+        AInteractionComponent* aitc = new AInteractionComponent(
+            _actor->GetObjectName() + "-interaction", _actor, 0);
+        aitc->SetCoroutineFunc(_func);
+        _actor->AddAComponent(aitc);
+
+        return aitc;
+    }
+
+    ATransformComponent* GetTransform(ActorObject* _actor)
+    {
+        return _actor->GetAComponent<ATransformComponent>(
+            COMP_TYPE::ATRANSFORM);
+    }
+}
+
+TEST_CASE(ScriptCoroutine_WakeOrderFollowsTimeThenFrames)
+{
+    g_WakeOrder = "";
+    CoroutineScheduler scheduler = {};
+    ScriptCoroutine a = WakeAfterSeconds(1.f, 'A');
+    ScriptCoroutine b = WakeAfterFrames(2, 'B');
+    ScriptCoroutine c = WakeAfterSeconds(0.5f, 'C');
+    ScriptCoroutine d = WakeAfterSeconds(0.5f, 'D');
+    a.StartCoroutine(&scheduler, nullptr);
+    b.StartCoroutine(&scheduler, nullptr);
+    c.StartCoroutine(&scheduler, nullptr);
+    d.StartCoroutine(&scheduler, nullptr);
+
+    // c and d share a wake time and keep the order they waited in,
+    // the time waits of a frame go before its frame waits
+    for (int i = 0; i < 5; i++)
+    {
+        scheduler.UpdateScheduler(0.25f);
+    }
+    CHECK(g_WakeOrder == "CDBA");
+    CHECK(!a.IsRunning() && !b.IsRunning());
+    CHECK(scheduler.GetWaitingCount() == 0);
+}
+
+TEST_CASE(ScriptCoroutine_SignalWaitsAreNotPolled)
+{
+    g_WakeOrder = "";
+    bool flag = false;
+    CoroutineScheduler scheduler = {};
+    ScriptCoroutine e = WakeOnFlag(&flag, 'E');
+    e.StartCoroutine(&scheduler, nullptr);
+    scheduler.UpdateScheduler(0.f);
+    CHECK(scheduler.GetWaitingCount() == 1);
+
+    // a raised signal alone isn't enough, and a set flag nobody
+    // signalled isn't even looked at
+    scheduler.RaiseSignal("flag-signal"_sid);
+    scheduler.UpdateScheduler(0.f);
+    flag = true;
+    scheduler.UpdateScheduler(0.f);
+    scheduler.RaiseSignal("other-signal"_sid);
+    scheduler.UpdateScheduler(0.f);
+    CHECK(g_WakeOrder == "");
+
+    scheduler.RaiseSignal("flag-signal"_sid);
+    scheduler.UpdateScheduler(0.f);
+    CHECK(g_WakeOrder == "E");
+    CHECK(scheduler.GetWaitingCount() == 0);
+}
+
+TEST_CASE(ScriptCoroutine_PausedOwnersAreParked)
+{
+    g_LoopCount = 0;
+    HeadlessScene scene = {};
+    ActorObject* actor = scene.AddEmptyActor("looper",
+        MakeFloat3(0.f, 0.f, 0.f));
+    AddScript(actor, CountEveryFrame);
+    CoroutineScheduler* scheduler =
+        scene.GetSceneNode()->GetCoroutineScheduler();
+    for (int i = 0; i < 3; i++)
+    {
+        scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+    }
+    CHECK(g_LoopCount == 3);
+
+    // once parked the script is out of every wait list, so a paused
+    // owner costs nothing per frame
+    actor->SetObjectActive(STATUS::PAUSE);
+    for (int i = 0; i < 5; i++)
+    {
+        scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+    }
+    CHECK(g_LoopCount == 3);
+    CHECK(scheduler->GetParkedCount() == 1);
+    CHECK(scheduler->GetWaitingCount() == 0);
+
+    actor->SetObjectActive(STATUS::ACTIVE);
+    CHECK(scheduler->GetParkedCount() == 0);
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+    CHECK(g_LoopCount == 5);
+}
+
+TEST_CASE(ScriptCoroutine_CollisionTargetsAreLookedUpByName)
+{
+    g_HitCount = 0;
+    HeadlessScene scene = {};
+    SceneNode* node = scene.GetSceneNode();
+    ActorObject* hero = AddCollider(&scene, "hero",
+        MakeFloat3(0.f, 0.f, 0.f));
+    AddScript(hero, CountTargetHits);
+    ActorObject* target = AddCollider(&scene, "target",
+        MakeFloat3(100.f, 0.f, 0.f));
+    node->UpdateScene(MAX_DELTA);
+    node->UpdateScene(MAX_DELTA);
+    CHECK(g_HitCount == 0);
+
+    // the first target goes away before it ever touches the hero
+    target->SetObjectActive(STATUS::NEED_DESTORY);
+    node->UpdateScene(MAX_DELTA);
+    node->UpdateScene(MAX_DELTA);
+    CHECK(node->FindActorObject("target"_sid) == nullptr);
+    GetTransform(hero)->Translate(MakeFloat3(1.f, 0.f, 0.f));
+    node->UpdateScene(MAX_DELTA);
+    CHECK(g_HitCount == 0);
+
+    // a new one with the same name is what the wait checks against
+    target = AddCollider(&scene, "target", MakeFloat3(100.f, 0.f, 0.f));
+    node->UpdateScene(MAX_DELTA);
+    CHECK(g_HitCount == 0);
+    GetTransform(target)->SetPosition(MakeFloat3(5.f, 0.f, 0.f));
+    node->UpdateScene(MAX_DELTA);
+    CHECK(g_HitCount == 1);
+    CHECK(node->GetCoroutineScheduler()->GetWaitingCount() == 1);
+}
+
+TEST_CASE(ScriptCoroutine_DestroyedOwnersCancelTheirWaits)
+{
+    g_HitCount = 0;
+    HeadlessScene scene = {};
+    SceneNode* node = scene.GetSceneNode();
+    CoroutineScheduler* scheduler = node->GetCoroutineScheduler();
+    ActorObject* hero = AddCollider(&scene, "hero",
+        MakeFloat3(0.f, 0.f, 0.f));
+    AddScript(hero, CountTargetHits);
+    AddCollider(&scene, "target", MakeFloat3(100.f, 0.f, 0.f));
+    node->UpdateScene(MAX_DELTA);
+    CHECK(scheduler->GetWaitingCount() == 2);
+
+    hero->SetObjectActive(STATUS::NEED_DESTORY);
+    node->UpdateScene(MAX_DELTA);
+    node->UpdateScene(MAX_DELTA);
+    CHECK(node->FindActorObject("hero"_sid) == nullptr);
+    CHECK(scheduler->GetWaitingCount() == 0);
+    CHECK(scheduler->GetParkedCount() == 0);
+
+    // a target moving onto the empty spot wakes nobody
+    GetTransform(node->FindActorObject("target"_sid))->SetPosition(
+        MakeFloat3(0.f, 0.f, 0.f));
+    node->UpdateScene(MAX_DELTA);
+    CHECK(g_HitCount == 0);
+}
@@ -0,0 +1,238 @@
+﻿//---------------------------------------------------------------
+// File: SoundCodecTest.cpp
+// Proj: HycFrame2D
+// Info: ADPCMコーデックとSIMDサンプル処理のテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "AudioSimd.h"
+#include "SoundClip.h"
+#include "SoundCodec.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    // a tone with some noise on top, the same every run
+    std::vector<short> MakeTone(size_t _frames, unsigned int _channels)
+    {
+        std::vector<short> pcm(_frames * _channels);
+        unsigned int seed = 12345;
+        for (size_t i = 0; i < _frames; i++)
+        {
+            for (unsigned int c = 0; c < _channels; c++)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                float noise = (float)(seed >> 16) / 65536.f - 0.5f;
+                float tone = sinf((float)i * 0.031f * (float)(c + 1));
+                pcm[i * _channels + c] =
+                    (short)(tone * 20000.f + noise * 4000.f);
+            }
+        }
+
+        return pcm;
+    }
+
+    // ima adpcm as written in the spec, without any of the engine code
+    void ReferenceDecodeBlock(const unsigned char* _src, short* _dst)
+    {
+        int predictor = (short)(_src[0] | (_src[1] << 8));
+        int index = _src[2];
+        for (int i = 0; i < ADPCM_BLOCK_FRAMES; i++)
+        {
+            int nibble = (_src[4 + i / 2] >> ((i & 1) * 4)) & 0xF;
+            int step = ADPCM_STEP_TABLE[index];
+            int diff = step >> 3;
+            if (nibble & 4)
+            {
+                diff += step;
+            }
+            if (nibble & 2)
+            {
+                diff += step >> 1;
+            }
+            if (nibble & 1)
+            {
+                diff += step >> 2;
+            }
+            predictor += (nibble & 8) ? -diff : diff;
+            predictor = std::clamp(predictor, -32768, 32767);
+            index = std::clamp(index + ADPCM_INDEX_TABLE[nibble & 7], 0,
+                ADPCM_STEP_NUM - 1);
+            _dst[i] = (short)predictor;
+        }
+    }
+
+    SoundClip MakeAdpcmClip(const std::vector<short>& _pcm,
+        unsigned int _channels)
+    {
+        std::vector<unsigned char> cooked = {};
+        EncodeAdpcmSound(_pcm.data(), _pcm.size() / _channels,
+            _channels, AUDIO_MIX_RATE, &cooked);
+        SoundClip clip = {};
+        clip.CreateFromAdpcm(cooked.data(), cooked.size());
+
+        return clip;
+    }
+}
+
+TEST_CASE(SoundCodec_SimdDecodeMatchesScalar)
+{
+    // 37 blocks per channel, so the four lane path has a tail too
+    const size_t frames = 37 * ADPCM_BLOCK_FRAMES - 50;
+    std::vector<short> pcm = MakeTone(frames, 2);
+    std::vector<unsigned char> cooked = {};
+    EncodeAdpcmSound(pcm.data(), frames, 2, AUDIO_MIX_RATE, &cooked);
+
+    ADPCM_SOUND_HEADER header = {};
+    const unsigned char* blocks = nullptr;
+    REQUIRE(ParseAdpcmSound(cooked.data(), cooked.size(), &header,
+        &blocks));
+    REQUIRE(header.BlockCount == 37);
+    size_t blockNum = (size_t)header.BlockCount * header.Channels;
+
+    std::vector<short> batched(blockNum * ADPCM_BLOCK_FRAMES);
+    std::vector<short> single(blockNum * ADPCM_BLOCK_FRAMES);
+    std::vector<short> reference(blockNum * ADPCM_BLOCK_FRAMES);
+    DecodeAdpcmBlocks(blocks, blockNum, batched.data());
+    for (size_t b = 0; b < blockNum; b++)
+    {
+        DecodeAdpcmBlocks(blocks + b * ADPCM_BLOCK_BYTES, 1,
+            single.data() + b * ADPCM_BLOCK_FRAMES);
+        ReferenceDecodeBlock(blocks + b * ADPCM_BLOCK_BYTES,
+            reference.data() + b * ADPCM_BLOCK_FRAMES);
+    }
+    CHECK(batched == single);
+    CHECK(batched == reference);
+
+    // the conversions match a plain division in every lane and tail
+    std::vector<float> simd(pcm.size() + 6);
+    ConvertPcm16ToFloat(pcm.data(), 13, simd.data());
+    bool same = true;
+    for (size_t i = 0; i < 13; i++)
+    {
+        same = same && simd[i] == (float)pcm[i] / 32768.f;
+    }
+    ConvertMonoPcm16ToStereo(pcm.data(), 7, simd.data());
+    for (size_t i = 0; i < 7; i++)
+    {
+        same = same && simd[i * 2] == (float)pcm[i] / 32768.f &&
+            simd[i * 2 + 1] == simd[i * 2];
+    }
+    InterleavePcm16ToStereo(pcm.data(), pcm.data() + 100, 9,
+        simd.data());
+    for (size_t i = 0; i < 9; i++)
+    {
+        same = same && simd[i * 2] == (float)pcm[i] / 32768.f &&
+            simd[i * 2 + 1] == (float)pcm[100 + i] / 32768.f;
+    }
+    CHECK(same);
+}
+
+TEST_CASE(SoundCodec_ReadFramesAtRandomOffsets)
+{
+    const unsigned int channelSet[] = { 1, 2 };
+    for (auto channels : channelSet)
+    {
+        const size_t frames = 20 * ADPCM_BLOCK_FRAMES + 77;
+        std::vector<short> pcm = MakeTone(frames, channels);
+        SoundClip clip = MakeAdpcmClip(pcm, channels);
+        REQUIRE(clip.GetFrameCount() == frames);
+        CHECK(clip.GetMemorySize() < pcm.size() * sizeof(short) / 3);
+
+        std::vector<float> whole(frames * AUDIO_MIX_CHANNELS);
+        clip.ReadFrames(0, frames, whole.data());
+
+        // every read must be the same slice of the whole decode, no
+        // matter which block boundaries it crosses
+        unsigned int seed = 99;
+        bool same = true;
+        std::vector<float> part(frames * AUDIO_MIX_CHANNELS);
+        for (int i = 0; i < 300; i++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            size_t start = (seed >> 8) % frames;
+            seed = seed * 1664525u + 1013904223u;
+            size_t count = 1 + (seed >> 8) % (frames - start);
+            count = count > 2000 ? 2000 : count;
+            clip.ReadFrames(start, count, part.data());
+            for (size_t s = 0; s < count * AUDIO_MIX_CHANNELS; s++)
+            {
+                same = same &&
+                    part[s] == whole[start * AUDIO_MIX_CHANNELS + s];
+            }
+        }
+        CHECK(same);
+
+        // and the decode stays close to what was encoded
+        double error = 0.0;
+        for (size_t f = 0; f < frames; f++)
+        {
+            float expect = (float)pcm[f * channels] / 32768.f;
+            float diff = whole[f * AUDIO_MIX_CHANNELS] - expect;
+            error += (double)diff * diff;
+        }
+        CHECK(sqrt(error / (double)frames) < 0.02);
+    }
+}
+
+TEST_CASE(SoundCodec_BenchDecodeThroughput)
+{
+    const unsigned int seconds = 20;
+    const size_t frames = (size_t)AUDIO_MIX_RATE * seconds;
+    const size_t chunk = 512;
+    std::vector<short> pcm = MakeTone(frames, 2);
+    std::vector<unsigned char> cooked = {};
+    EncodeAdpcmSound(pcm.data(), frames, 2, AUDIO_MIX_RATE, &cooked);
+    SoundClip clip = {};
+    REQUIRE(clip.CreateFromAdpcm(cooked.data(), cooked.size()));
+    SoundClip raw = {};
+    REQUIRE(raw.CreateFromPcm16(pcm.data(), frames, 2,
+        AUDIO_MIX_RATE));
+
+    // the reads are the size the mixer asks for
+    std::vector<float> out(chunk * AUDIO_MIX_CHANNELS);
+    float sink = 0.f;
+    BenchTimer timer = {};
+    for (size_t f = 0; f + chunk <= frames; f += chunk)
+    {
+        clip.ReadFrames(f, chunk, out.data());
+        sink += out[0];
+    }
+    double adpcmMs = timer.GetElapsedMs();
+
+    timer.ResetTimer();
+    for (size_t f = 0; f + chunk <= frames; f += chunk)
+    {
+        raw.ReadFrames(f, chunk, out.data());
+        sink += out[0];
+    }
+    double pcmMs = timer.GetElapsedMs();
+
+    // the block decoder on its own, four lanes against one at a time
+    ADPCM_SOUND_HEADER header = {};
+    const unsigned char* blocks = nullptr;
+    REQUIRE(ParseAdpcmSound(cooked.data(), cooked.size(), &header,
+        &blocks));
+    size_t blockNum = (size_t)header.BlockCount * header.Channels;
+    std::vector<short> decoded(blockNum * ADPCM_BLOCK_FRAMES);
+    timer.ResetTimer();
+    DecodeAdpcmBlocks(blocks, blockNum, decoded.data());
+    double batchMs = timer.GetElapsedMs();
+    timer.ResetTimer();
+    for (size_t b = 0; b < blockNum; b++)
+    {
+        DecodeAdpcmBlocks(blocks + b * ADPCM_BLOCK_BYTES, 1,
+            decoded.data() + b * ADPCM_BLOCK_FRAMES);
+    }
+    double singleMs = timer.GetElapsedMs();
+
+    BENCH_LOG("%u s stereo in %zu frame reads: adpcm %.2f ms (%.0fx "
+        "realtime), pcm16 %.2f ms, blocks %.2f ms in four lanes, %.2f "
+        "ms one by one (sink %.1f)\n", seconds, chunk, adpcmMs,
+        seconds * 1000.0 / adpcmMs, pcmMs, batchMs, singleMs, sink);
+    CHECK(clip.GetFrameCount() == frames);
+}
@@ -0,0 +1,129 @@
+﻿//---------------------------------------------------------------
+// File: SoundPoolTest.cpp
+// Proj: HycFrame2D
+// Info: サウンドプールの参照カウントと圧縮版の読み込みのテスト
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "SoundHelper.h"
+#include "SoundCodec.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const std::string WAV_PATH = "sound-pool-test.wav";
+
+    void PushValue(std::vector<unsigned char>* _out,
+        unsigned int _value, int _bytes)
+    {
+        for (int i = 0; i < _bytes; i++)
+        {
+            _out->push_back((unsigned char)(_value >> (i * 8)));
+        }
+    }
+
+    // a 16 bit mono wav, the only kind the pool accepts besides adpcm
+    void WriteWavFile(const std::string& _path,
+        const std::vector<short>& _pcm)
+    {
+        unsigned int dataSize = (unsigned int)(_pcm.size() * 2);
+        std::vector<unsigned char> wav = {};
+        wav.insert(wav.end(), { 'R', 'I', 'F', 'F' });
+        PushValue(&wav, 36 + dataSize, 4);
+        wav.insert(wav.end(), { 'W', 'A', 'V', 'E' });
+        wav.insert(wav.end(), { 'f', 'm', 't', ' ' });
+        PushValue(&wav, 16, 4);
+        PushValue(&wav, 1, 2);
+        PushValue(&wav, 1, 2);
+        PushValue(&wav, AUDIO_MIX_RATE, 4);
+        PushValue(&wav, AUDIO_MIX_RATE * 2, 4);
+        PushValue(&wav, 2, 2);
+        PushValue(&wav, 16, 2);
+        wav.insert(wav.end(), { 'd', 'a', 't', 'a' });
+        PushValue(&wav, dataSize, 4);
+        size_t start = wav.size();
+        wav.resize(start + dataSize);
+        memcpy(wav.data() + start, _pcm.data(), dataSize);
+
+        std::ofstream file(_path, std::ios::binary);
+        file.write((const char*)wav.data(), wav.size());
+    }
+
+    std::vector<short> MakeSaw(size_t _frames)
+    {
+        std::vector<short> pcm(_frames);
+        for (size_t i = 0; i < _frames; i++)
+        {
+            pcm[i] = (short)((int)(i % 200) * 300 - 30000);
+        }
+
+        return pcm;
+    }
+}
+
+TEST_CASE(SoundPool_LoadAndReleaseAreRefcounted)
+{
+    std::vector<short> pcm = MakeSaw(AUDIO_MIX_RATE / 2);
+    WriteWavFile(WAV_PATH, pcm);
+
+    // two owners of the same name share one clip
+    REQUIRE(LoadSound("pool-se", WAV_PATH));
+    size_t size = GetSoundMemorySize("pool-se");
+    CHECK(size >= pcm.size() * sizeof(short));
+    REQUIRE(LoadSound("pool-se", WAV_PATH));
+    CHECK(GetSoundMemorySize("pool-se") == size);
+
+    // the clip lives until the last owner lets it go
+    ReleaseSound("pool-se");
+    CHECK(GetSoundMemorySize("pool-se") == size);
+    ReleaseSound("pool-se");
+    CHECK(GetSoundMemorySize("pool-se") == 0);
+
+    // an extra release and a missing file change nothing
+    ReleaseSound("pool-se");
+    CHECK(!LoadSound("pool-missing", "sound-pool-missing.wav"));
+    CHECK(GetSoundMemorySize("pool-missing") == 0);
+
+    // and a released name can be loaded again
+    REQUIRE(LoadSound("pool-se", WAV_PATH));
+    CHECK(GetSoundMemorySize("pool-se") == size);
+    ReleaseSound("pool-se");
+    CHECK(GetSoundMemorySize("pool-se") == 0);
+
+    std::remove(WAV_PATH.c_str());
+}
+
+TEST_CASE(SoundPool_PrefersTheCookedSibling)
+{
+    std::vector<short> pcm = MakeSaw(AUDIO_MIX_RATE);
+    WriteWavFile(WAV_PATH, pcm);
+    REQUIRE(LoadSound("pool-wav", WAV_PATH));
+    size_t wavSize = GetSoundMemorySize("pool-wav");
+    ReleaseSound("pool-wav");
+
+    std::vector<unsigned char> cooked = {};
+    EncodeAdpcmSound(pcm.data(), pcm.size(), 1, AUDIO_MIX_RATE,
+        &cooked);
+    std::string cookedPath = MakeCookedSoundPath(WAV_PATH);
+    {
+        std::ofstream file(cookedPath, std::ios::binary);
+        file.write((const char*)cooked.data(), cooked.size());
+    }
+
+    // the adpcm next to the wav is what stays in memory
+    REQUIRE(LoadSound("pool-adpcm", WAV_PATH));
+    size_t adpcmSize = GetSoundMemorySize("pool-adpcm");
+    CHECK(adpcmSize > 0);
+    CHECK(adpcmSize < wavSize / 3);
+    ReleaseSound("pool-adpcm");
+    CHECK(GetSoundMemorySize("pool-adpcm") == 0);
+
+    std::remove(cookedPath.c_str());
+    std::remove(WAV_PATH.c_str());
+}
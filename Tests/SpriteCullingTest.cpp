@@ -0,0 +1,189 @@
+﻿//---------------------------------------------------------------
+// File: SpriteCullingTest.cpp
+// Proj: HycFrame2D
+// Info: スプライトのカメラカリングのテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "HeadlessScene.h"
+#include "SceneNode.h"
+#include "ActorObject.h"
+#include "ATransformComponent.h"
+#include "ASpriteComponent.h"
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    const Float2 CAMERA_SIZE = MakeFloat2(1920.f, 1080.f);
+
+    // the x of every drawn sprite in submit order, the command matrix
+    // is stored transposed so the translation sits in the last column
+    std::vector<float> GetDrawnSpriteX(HeadlessScene* _scene)
+    {
+        std::vector<float> drawn = {};
+        auto backend = _scene->GetRenderBackend();
+        for (auto& cmd : *(backend->GetLastCommandArray()))
+        {
+            if (cmd.Type == RENDER_CMD_TYPE::SPRITE)
+            {
+                auto transforms = backend->GetLastTransformArray();
+                drawn.push_back((*transforms)[cmd.Transform]._14);
+            }
+        }
+
+        return drawn;
+    }
+}
+
+TEST_CASE(SpriteCulling_OnlySpritesInViewAreSubmitted)
+{
+    HeadlessScene scene = {};
+    scene.GetSceneNode()->InitCamera(MakeFloat2(0.f, 0.f), CAMERA_SIZE);
+    const int side = 60;
+    const float spacing = 200.f;
+    const Float2 size = MakeFloat2(64.f, 64.f);
+    scene.AddSpriteField("field", side, spacing, size);
+    scene.RunFrame(MAX_DELTA);
+
+    unsigned int expected = 0;
+    float origin = -0.5f * spacing * (float)(side - 1);
+    for (int y = 0; y < side; y++)
+    {
+        for (int x = 0; x < side; x++)
+        {
+            float px = origin + spacing * (float)x;
+            float py = origin + spacing * (float)y;
+            if (fabsf(px) <= CAMERA_SIZE.x * 0.5f + size.x * 0.5f &&
+                fabsf(py) <= CAMERA_SIZE.y * 0.5f + size.y * 0.5f)
+            {
+                ++expected;
+            }
+        }
+    }
+
+    auto& stats = scene.GetSceneNode()->GetDrawStatistics();
+    CHECK(stats.SubmittedSprites == expected);
+    CHECK(GetDrawnSpriteX(&scene).size() == expected);
+    // the grid hands back a few neighbours, never the whole field
+    CHECK(stats.SubmittedSprites + stats.CulledSprites <
+        (unsigned int)(side * side));
+}
+
+TEST_CASE(SpriteCulling_MovedAndResizedSpritesArePlacedAgain)
+{
+    HeadlessScene scene = {};
+    scene.GetSceneNode()->InitCamera(MakeFloat2(0.f, 0.f), CAMERA_SIZE);
+    ActorObject* far = scene.AddSpriteActor("far",
+        MakeFloat3(8000.f, 0.f, 0.f), MakeFloat2(32.f, 32.f), 0);
+    ActorObject* edge = scene.AddSpriteActor("edge",
+        MakeFloat3(1100.f, 0.f, 0.f), MakeFloat2(10.f, 10.f), 0);
+    scene.RunFrame(MAX_DELTA);
+    CHECK(GetDrawnSpriteX(&scene).empty());
+
+    far->GetAComponent<ATransformComponent>(COMP_TYPE::ATRANSFORM)->
+        SetPosition(MakeFloat3(0.f, 0.f, 0.f));
+    edge->GetAComponent<ASpriteComponent>(COMP_TYPE::ASPRITE)->
+        SetTexWidth(400.f);
+    scene.RunFrame(MAX_DELTA);
+    CHECK(GetDrawnSpriteX(&scene).size() == 2);
+
+    far->GetAComponent<ATransformComponent>(COMP_TYPE::ATRANSFORM)->
+        Translate(MakeFloat3(-9000.f, 0.f, 0.f));
+    scene.RunFrame(MAX_DELTA);
+    CHECK(GetDrawnSpriteX(&scene).size() == 1);
+}
+
+TEST_CASE(SpriteCulling_NoCameraDrawsEverySprite)
+{
+    HeadlessScene scene = {};
+    scene.AddSpriteField("field", 10, 5000.f, MakeFloat2(16.f, 16.f));
+    scene.RunFrame(MAX_DELTA);
+
+    CHECK(scene.GetSceneNode()->GetDrawStatistics().SubmittedSprites ==
+        100);
+    CHECK(scene.GetSceneNode()->GetDrawStatistics().CulledSprites == 0);
+    CHECK(GetDrawnSpriteX(&scene).size() == 100);
+}
+
+TEST_CASE(SpriteCulling_DrawOrderMatchesTheSpriteList)
+{
+    HeadlessScene scene = {};
+    scene.GetSceneNode()->InitCamera(MakeFloat2(0.f, 0.f), CAMERA_SIZE);
+    const Float2 size = MakeFloat2(8.f, 8.f);
+    scene.AddSpriteActor("order-3", MakeFloat3(30.f, 0.f, 0.f),
+        size, 3);
+    scene.AddSpriteActor("order-1", MakeFloat3(10.f, 0.f, 0.f),
+        size, 1);
+    scene.AddSpriteActor("order-2", MakeFloat3(20.f, 0.f, 0.f),
+        size, 2);
+    scene.RunFrame(MAX_DELTA);
+    // a later actor goes in front of the ones sharing its order
+    scene.AddSpriteActor("order-1-late", MakeFloat3(11.f, 0.f, 0.f),
+        size, 1);
+    scene.RunFrame(MAX_DELTA);
+
+    std::vector<float> drawn = GetDrawnSpriteX(&scene);
+    REQUIRE(drawn.size() == 4);
+    CHECK(drawn[0] == 11.f);
+    CHECK(drawn[1] == 10.f);
+    CHECK(drawn[2] == 20.f);
+    CHECK(drawn[3] == 30.f);
+}
+
+TEST_CASE(SpriteCulling_OversizedSpritesDoNotWidenTheQuery)
+{
+    HeadlessScene scene = {};
+    scene.GetSceneNode()->InitCamera(MakeFloat2(0.f, 0.f), CAMERA_SIZE);
+    scene.AddSpriteActor("near-miss", MakeFloat3(1700.f, 0.f, 0.f),
+        MakeFloat2(8.f, 8.f), 0);
+    ActorObject* banner = scene.AddSpriteActor("banner",
+        MakeFloat3(3500.f, 0.f, 0.f), MakeFloat2(6000.f, 64.f), 1);
+    scene.RunFrame(MAX_DELTA);
+
+    // the banner reaches into the view from far outside the query,
+    // and the query still doesn't hand back the sprite next to it
+    auto& stats = scene.GetSceneNode()->GetDrawStatistics();
+    CHECK(stats.SubmittedSprites == 1);
+    CHECK(stats.CulledSprites == 0);
+    std::vector<float> drawn = GetDrawnSpriteX(&scene);
+    REQUIRE(drawn.size() == 1);
+    CHECK(drawn[0] == 3500.f);
+
+    // shrunk again it goes back into the grid, far from the camera
+    banner->GetAComponent<ASpriteComponent>(COMP_TYPE::ASPRITE)->
+        SetTexWidth(64.f);
+    scene.RunFrame(MAX_DELTA);
+    CHECK(stats.SubmittedSprites == 0);
+    CHECK(stats.CulledSprites == 0);
+    CHECK(GetDrawnSpriteX(&scene).empty());
+}
+
+TEST_CASE(SpriteCulling_BenchScrollingField)
+{
+    HeadlessScene scene = {};
+    scene.GetSceneNode()->InitCamera(MakeFloat2(0.f, 0.f), CAMERA_SIZE);
+    const int side = 150;
+    scene.AddSpriteField("field", side, 160.f, MakeFloat2(64.f, 64.f));
+    scene.RunFrame(MAX_DELTA);
+
+    const int frames = 300;
+    Camera* camera = scene.GetSceneNode()->GetCamera();
+    auto& stats = scene.GetSceneNode()->GetDrawStatistics();
+    unsigned long long submitted = 0;
+    unsigned long long tested = 0;
+    HEADLESS_BENCH bench = scene.BenchFrames(frames, [&](int _frame)
+        {
+            camera->TranslateCameraPos(MakeFloat2(16.f, 8.f));
+            scene.DrawFrame();
+            submitted += stats.SubmittedSprites;
+            tested += stats.SubmittedSprites + stats.CulledSprites;
+        });
+
+    BENCH_LOG("%d sprites, %.4f ms per draw, %llu submitted and "
+        "%llu tested per frame\n", side * side, bench.MsPerFrame,
+        submitted / frames, tested / frames);
+    CHECK(submitted > 0);
+}
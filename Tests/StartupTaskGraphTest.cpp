@@ -0,0 +1,167 @@
+﻿//---------------------------------------------------------------
+// File: StartupTaskGraphTest.cpp
+// Proj: HycFrame2D
+// Info: 起動タスクグラフの依存順とスレッド割り当てのテスト
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "StartupTaskGraph.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    const STARTUP_TASK_RECORD* FindRecord(
+        const StartupTaskGraph& _graph, const std::string& _name)
+    {
+        for (auto& record : *_graph.GetTaskRecords())
+        {
+            if (record.Name == _name)
+            {
+                return &record;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // a task that takes long enough for the workers to overlap
+    bool SleepTask()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        return true;
+    }
+}
+
+TEST_CASE(StartupTaskGraph_RunsInDependencyOrder)
+{
+    // a diamond with a tail, b and c can only start after a and d
+    // only after both of them
+    std::mutex orderLock;
+    std::string order = "";
+    auto makeTask = [&orderLock, &order](char _name)
+    {
+        return [&orderLock, &order, _name]()
+        {
+            SleepTask();
+            std::lock_guard<std::mutex> lock(orderLock);
+            order.push_back(_name);
+            return true;
+        };
+    };
+
+    StartupTaskGraph graph = {};
+    CHECK(graph.AddTask("a", makeTask('a'), {}));
+    CHECK(graph.AddTask("b", makeTask('b'), { "a" }));
+    CHECK(graph.AddTask("c", makeTask('c'), { "a" }));
+    CHECK(graph.AddTask("d", makeTask('d'), { "b", "c" }));
+    CHECK(graph.AddTask("e", makeTask('e'), { "d" }));
+
+    // a dependency has to exist before the task that needs it
+    CHECK(!graph.AddTask("f", makeTask('f'), { "g" }));
+
+    REQUIRE(graph.RunAllTasks(3));
+    REQUIRE(graph.GetTaskRecords()->size() == 5);
+    REQUIRE(order.size() == 5);
+    CHECK(order.front() == 'a');
+    CHECK(order.substr(3) == "de");
+
+    const STARTUP_TASK_RECORD* a = FindRecord(graph, "a");
+    const STARTUP_TASK_RECORD* b = FindRecord(graph, "b");
+    const STARTUP_TASK_RECORD* c = FindRecord(graph, "c");
+    const STARTUP_TASK_RECORD* d = FindRecord(graph, "d");
+    REQUIRE(a && b && c && d);
+    CHECK(b->StartMs >= a->EndMs);
+    CHECK(c->StartMs >= a->EndMs);
+    CHECK(d->StartMs >= b->EndMs);
+    CHECK(d->StartMs >= c->EndMs);
+}
+
+TEST_CASE(StartupTaskGraph_SkipsTasksAfterAFailure)
+{
+    std::atomic<int> runNum = 0;
+    auto pass = [&runNum]()
+    {
+        ++runNum;
+        return true;
+    };
+
+    StartupTaskGraph graph = {};
+    graph.AddTask("broken", []() { return false; }, {});
+    graph.AddTask("child", pass, { "broken" });
+    graph.AddTask("grandchild", pass, { "child" });
+    graph.AddTask("other", pass, {});
+    graph.AddTask("joined", pass, { "other", "broken" });
+
+    // the whole graph still finishes, only the independent task runs
+    CHECK(!graph.RunAllTasks(2));
+    CHECK(runNum == 1);
+    REQUIRE(graph.GetTaskRecords()->size() == 5);
+    const char* skipped[] =
+        { "broken", "child", "grandchild", "joined" };
+    for (const char* name : skipped)
+    {
+        const STARTUP_TASK_RECORD* record = FindRecord(graph, name);
+        REQUIRE(record);
+        CHECK(!record->Result);
+    }
+    const STARTUP_TASK_RECORD* other = FindRecord(graph, "other");
+    REQUIRE(other);
+    CHECK(other->Result);
+}
+
+TEST_CASE(StartupTaskGraph_PinsMainThreadTasks)
+{
+    // window and device work has to stay on the calling thread, even
+    // when a worker is free first
+    const std::thread::id mainID = std::this_thread::get_id();
+    std::atomic<int> wrongThreadNum = 0;
+    auto onMain = [&mainID, &wrongThreadNum]()
+    {
+        if (std::this_thread::get_id() != mainID)
+        {
+            ++wrongThreadNum;
+        }
+        return SleepTask();
+    };
+
+    StartupTaskGraph graph = {};
+    graph.AddTask("window", onMain, {}, true);
+    graph.AddTask("sound", SleepTask, {});
+    graph.AddTask("device", onMain, { "window" }, true);
+    graph.AddTask("parse", SleepTask, { "sound" });
+    graph.AddTask("queue", onMain, { "device", "parse" }, true);
+    for (int i = 0; i < 6; i++)
+    {
+        graph.AddTask("worker-" + std::to_string(i), SleepTask, {});
+    }
+
+    REQUIRE(graph.RunAllTasks(3));
+    CHECK(wrongThreadNum == 0);
+    for (auto& record : *graph.GetTaskRecords())
+    {
+        bool mainFlg = record.Name == "window" ||
+            record.Name == "device" || record.Name == "queue";
+        if (mainFlg)
+        {
+            CHECK(record.ThreadIndex == 0);
+        }
+        CHECK(record.ThreadIndex <= 3);
+    }
+
+    // with no workers every task runs on the calling thread
+    StartupTaskGraph single = {};
+    single.AddTask("a", SleepTask, {});
+    single.AddTask("b", onMain, { "a" }, true);
+    REQUIRE(single.RunAllTasks(0));
+    for (auto& record : *single.GetTaskRecords())
+    {
+        CHECK(record.ThreadIndex == 0);
+    }
+}
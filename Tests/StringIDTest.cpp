@@ -0,0 +1,215 @@
+﻿//---------------------------------------------------------------
+// File: StringIDTest.cpp
+// Proj: HycFrame2D
+// Info: 文字列IDとFlatIDMapのテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "HeadlessScene.h"
+#include "ActorObject.h"
+#include "ATransformComponent.h"
+#include "StringID.h"
+#include "FlatIDMap.h"
+#include "SceneManager.h"
+#include "SceneNode.h"
+#include "PropertyManager.h"
+#include "ObjectFactory.h"
+#include "RenderCommandQueue.h"
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+TEST_CASE(StringID_AppendMatchesTheJoinedString)
+{
+    std::string name = "player";
+    StringID joined = InternStringID(name + "-transform");
+    CHECK(StringID(name).Append("-transform") == joined);
+    CHECK("player-transform"_sid == joined);
+    CHECK("player"_sid != joined);
+    CHECK(StringID().GetValue() == 0);
+}
+
+TEST_CASE(StringID_InternedNamesReachTheLog)
+{
+    // the names are kept without _DEBUG too, release logs need them
+    StringID id = InternStringID("log-name-check");
+    CHECK(strcmp(id.GetDebugString(), "log-name-check") == 0);
+    CHECK(strcmp(StringID(std::string("log-name-check"))
+        .GetDebugString(), "log-name-check") == 0);
+
+    // a name nobody interned still prints its hash
+    char expect[48] = {};
+    StringID unknown = "never-interned-name"_sid;
+    snprintf(expect, sizeof(expect), "<unknown string id %016llx>",
+        unknown.GetValue());
+    CHECK(strcmp(unknown.GetDebugString(), expect) == 0);
+}
+
+TEST_CASE(StringID_FlatMapKeepsEntriesAcrossEraseAndGrowth)
+{
+    const int keyNum = 3000;
+    FlatIDMap<int> map = {};
+    for (int i = 0; i < keyNum; i++)
+    {
+        CHECK(map.Insert(StringID("key-" + std::to_string(i)), i));
+    }
+    CHECK(!map.Insert("key-7"_sid, -1));
+    CHECK(map.Size() == (size_t)keyNum);
+
+    // every other key goes, the moved back entries must stay findable
+    for (int i = 0; i < keyNum; i += 2)
+    {
+        CHECK(map.Erase(StringID("key-" + std::to_string(i))));
+    }
+    CHECK(!map.Erase("key-0"_sid));
+    for (int i = 0; i < keyNum; i++)
+    {
+        int* found = map.Find(StringID("key-" + std::to_string(i)));
+        if (i % 2)
+        {
+            REQUIRE(found);
+            CHECK(*found == i);
+        }
+        else
+        {
+            CHECK(!found);
+        }
+    }
+
+    // inserting again has to reuse the tombstones or grow past them
+    for (int i = 0; i < keyNum; i += 2)
+    {
+        CHECK(map.Insert(StringID("key-" + std::to_string(i)), i));
+    }
+    CHECK(map.Size() == (size_t)keyNum);
+    CHECK(*map.Find("key-0"_sid) == 0);
+}
+
+TEST_CASE(StringID_ComponentLookupDoesNotAllocate)
+{
+    HeadlessScene scene = {};
+    ActorObject* actor = scene.AddEmptyActor("lookup",
+        MakeFloat3(0.f, 0.f, 0.f));
+    ATransformComponent* atc = nullptr;
+
+    size_t before = GetAllocationCount();
+    for (int i = 0; i < 1000; i++)
+    {
+        atc = actor->GetAComponent<ATransformComponent>(
+            COMP_TYPE::ATRANSFORM);
+    }
+    CHECK(GetAllocationCount() == before);
+    CHECK(atc != nullptr);
+}
+
+TEST_CASE(StringID_BenchLookupAgainstStringKeys)
+{
+    const int keyNum = 1000;
+    const int rounds = 200;
+    std::unordered_map<std::string, int> stringMap = {};
+    FlatIDMap<int> idMap = {};
+    std::vector<std::string> names = {};
+    std::vector<StringID> ids = {};
+    for (int i = 0; i < keyNum; i++)
+    {
+        names.push_back("actor-" + std::to_string(i));
+        ids.push_back(StringID(names.back()));
+        stringMap.insert({ names.back() + "-transform", i });
+        idMap.Insert(ids.back().Append("-transform"), i);
+    }
+
+    // the old lookups built the component name from the actor name
+    long long sum = 0;
+    size_t allocs = GetAllocationCount();
+    BenchTimer timer = {};
+    for (int r = 0; r < rounds; r++)
+    {
+        for (auto& name : names)
+        {
+            sum += stringMap.find(name + "-transform")->second;
+        }
+    }
+    double stringMs = timer.GetElapsedMs();
+    size_t stringAllocs = GetAllocationCount() - allocs;
+
+    allocs = GetAllocationCount();
+    timer.ResetTimer();
+    for (int r = 0; r < rounds; r++)
+    {
+        for (auto& id : ids)
+        {
+            sum -= *idMap.Find(id.Append("-transform"));
+        }
+    }
+    double idMs = timer.GetElapsedMs();
+    size_t idAllocs = GetAllocationCount() - allocs;
+
+    BENCH_LOG("%d lookups, string keys %.3f ms with %zu allocations, "
+        "string ids %.3f ms with %zu allocations\n", keyNum * rounds,
+        stringMs, stringAllocs, idMs, idAllocs);
+    CHECK(sum == 0);
+    CHECK(idAllocs == 0);
+}
+
+TEST_CASE(StringID_BenchShippedSceneAllocations)
+{
+    NullRenderBackend backend = {};
+    RenderCommandQueue queue = {};
+    queue.StartUp(&backend, false);
+    SceneManager* sm = new SceneManager();
+    PropertyManager* pm = new PropertyManager();
+    ObjectFactory* factory = new ObjectFactory();
+    factory->StartUp(pm, sm);
+    pm->StartUp(factory);
+    sm->PostStartUp(pm, factory, &queue);
+
+    // with string keys second-scene made 28 allocations a frame and
+    // the other two none
+    const char* names[] =
+        { "first-scene", "second-scene", "third-scene" };
+    const char* paths[] =
+    {
+        "rom:/Configs/Scenes/1-scene.json",
+        "rom:/Configs/Scenes/2-scene.json",
+        "rom:/Configs/Scenes/3-scene.json"
+    };
+    const int frames = 600;
+    double allocations[3] = {};
+    for (int s = 0; s < 3; s++)
+    {
+        SceneNode* scene = factory->CreateNewScene(names[s], paths[s]);
+        REQUIRE(scene);
+        for (int i = 0; i < 10; i++)
+        {
+            scene->UpdateScene(MAX_DELTA);
+        }
+
+        size_t before = GetAllocationCount();
+        for (int i = 0; i < frames; i++)
+        {
+            scene->UpdateScene(MAX_DELTA);
+        }
+        allocations[s] =
+            (double)(GetAllocationCount() - before) / frames;
+        scene->ReleaseScene();
+        delete scene;
+    }
+
+    BENCH_LOG("allocations a frame over %d frames: %s %.2f, %s %.2f, "
+        "%s %.2f\n", frames, names[0], allocations[0], names[1],
+        allocations[1], names[2], allocations[2]);
+    CHECK(allocations[0] == 0.0);
+    CHECK(allocations[1] <= 7.0);
+    CHECK(allocations[2] == 0.0);
+
+    queue.CleanAndStop();
+    sm->CleanAndStop();
+    delete sm;
+    pm->CleanAndStop();
+    delete pm;
+    factory->CleanAndStop();
+    delete factory;
+}
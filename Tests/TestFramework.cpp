@@ -0,0 +1,121 @@
+﻿//---------------------------------------------------------------
+// File: TestFramework.cpp
+// Proj: HycFrame2D
+// Info: テストとベンチマークを登録して実行する最小ランナー
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+namespace
+{
+    struct TEST_ENTRY
+    {
+        const char* Name;
+        TestFuncType Func;
+    };
+
+    // registrars run during static init of every test file, so the
+    // list is created on first use instead of being a global
+    std::vector<TEST_ENTRY>& GetTestArray()
+    {
+        static std::vector<TEST_ENTRY> g_TestArray = {};
+        return g_TestArray;
+    }
+
+    std::atomic<size_t> g_AllocationCount(0);
+
+    unsigned int g_FailureCount = 0;
+}
+
+void* operator new(size_t _size)
+{
+    ++g_AllocationCount;
+    void* ptr = malloc(_size ? _size : 1);
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+void operator delete(void* _ptr) noexcept
+{
+    free(_ptr);
+}
+
+void operator delete(void* _ptr, size_t) noexcept
+{
+    free(_ptr);
+}
+
+TestRegistrar::TestRegistrar(const char* _name, TestFuncType _func)
+{
+    GetTestArray().push_back({ _name, _func });
+}
+
+BenchTimer::BenchTimer() :
+    mStartTime(std::chrono::steady_clock::now())
+{
+
+}
+
+void BenchTimer::ResetTimer()
+{
+    mStartTime = std::chrono::steady_clock::now();
+}
+
+double BenchTimer::GetElapsedMs() const
+{
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - mStartTime).count();
+}
+
+void ReportTestFailure(const char* _file, int _line, const char* _expr)
+{
+    ++g_FailureCount;
+    printf("    [FAILED] %s(%d) : %s\n", _file, _line, _expr);
+}
+
+size_t GetAllocationCount()
+{
+    return g_AllocationCount;
+}
+
+int RunAllTests(const char* _filter)
+{
+    unsigned int runNum = 0;
+    unsigned int failedNum = 0;
+    for (auto& test : GetTestArray())
+    {
+        if (_filter && *_filter && !strstr(test.Name, _filter))
+        {
+            continue;
+        }
+
+        printf("[ RUN ] %s\n", test.Name);
+        unsigned int before = g_FailureCount;
+        BenchTimer timer = {};
+        test.Func();
+        bool passed = g_FailureCount == before;
+        printf("[ %s ] %s (%.2f ms)\n", passed ? " OK " : "FAIL",
+            test.Name, timer.GetElapsedMs());
+
+        ++runNum;
+        if (!passed)
+        {
+            ++failedNum;
+        }
+    }
+
+    printf("%u of %u tests passed\n", runNum - failedNum, runNum);
+
+    return (int)failedNum;
+}
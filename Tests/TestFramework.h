@@ -0,0 +1,68 @@
+﻿//---------------------------------------------------------------
+// File: TestFramework.h
+// Proj: HycFrame2D
+// Info: テストとベンチマークを登録して実行する最小ランナー
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using TestFuncType = void (*)();
+
+class TestRegistrar
+{
+public:
+    TestRegistrar(const char* _name, TestFuncType _func);
+};
+
+class BenchTimer
+{
+public:
+    BenchTimer();
+
+    void ResetTimer();
+
+    double GetElapsedMs() const;
+
+private:
+    std::chrono::steady_clock::time_point mStartTime;
+};
+
+void ReportTestFailure(const char* _file, int _line, const char* _expr);
+
+int RunAllTests(const char* _filter);
+
+// every operator new of the test binary is counted, so a case can
+// check that a steady state loop doesn't allocate
+size_t GetAllocationCount();
+
+#define TEST_CASE(name) \
+    static void name(); \
+    static TestRegistrar name##_Registrar(#name, name); \
+    static void name()
+
+#define CHECK(expr) \
+    do \
+    { \
+        if (!(expr)) \
+        { \
+            ReportTestFailure(__FILE__, __LINE__, #expr); \
+        } \
+    } while (0)
+
+#define REQUIRE(expr) \
+    do \
+    { \
+        if (!(expr)) \
+        { \
+            ReportTestFailure(__FILE__, __LINE__, #expr); \
+            return; \
+        } \
+    } while (0)
+
+#define BENCH_LOG(...)  (printf("    [BENCH] " __VA_ARGS__))
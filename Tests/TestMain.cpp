@@ -0,0 +1,15 @@
+﻿//---------------------------------------------------------------
+// File: TestMain.cpp
+// Proj: HycFrame2D
+// Info: テスト実行ファイルの入口
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+
+// usage : HycFrame2DTests [name filter]
+int main(int argc, char* argv[])
+{
+    return RunAllTests(argc > 1 ? argv[1] : "") ? 1 : 0;
+}
@@ -0,0 +1,232 @@
+﻿//---------------------------------------------------------------
+// File: TilemapTest.cpp
+// Proj: HycFrame2D
+// Info: チャンク分割タイルマップのテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "HeadlessScene.h"
+#include "SceneNode.h"
+#include "ActorObject.h"
+#include "ATilemapComponent.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+    ATilemapComponent* AddTilemapActor(HeadlessScene* _scene,
+        std::string _name, Float3 _pos, unsigned int _cols,
+        unsigned int _rows, float _tileSize)
+    {
+        ActorObject* actor = _scene->AddEmptyActor(_name, _pos);
+        ATilemapComponent* atmc = new ATilemapComponent(
+            _name + "-tilemap", actor, 0);
+        atmc->SetTileLayout(_cols, _rows,
+            MakeFloat2(_tileSize, _tileSize));
+        atmc->SetAtlas("", 4, 4);
+        actor->AddAComponent(atmc);
+
+        return atmc;
+    }
+
+    // every third tile is left empty so chunks aren't all full
+    void FillPattern(ATilemapComponent* _atmc)
+    {
+        std::vector<unsigned short> tiles((size_t)_atmc->GetMapCols() *
+            _atmc->GetMapRows(), EMPTY_TILE);
+        for (size_t i = 0; i < tiles.size(); i++)
+        {
+            tiles[i] = (i % 3 == 2) ? EMPTY_TILE :
+                (unsigned short)(i % 16);
+        }
+        _atmc->LoadTileArray(tiles);
+    }
+}
+
+TEST_CASE(Tilemap_ChunksBakeOnlyFilledTiles)
+{
+    HeadlessScene scene = {};
+    ATilemapComponent* atmc = AddTilemapActor(&scene, "map",
+        MakeFloat3(0.f, 0.f, 0.f), 40, 20, 10.f);
+    REQUIRE(atmc->GetChunkCount() == 6);
+    CHECK(!atmc->LoadTileArray({ 1, 2, 3 }));
+    FillPattern(atmc);
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+
+    size_t quads = 0;
+    for (unsigned int i = 0; i < atmc->GetChunkCount(); i++)
+    {
+        CHECK(!atmc->GetChunk(i)->DirtyFlg);
+        quads += atmc->GetChunk(i)->QuadArray.size();
+    }
+    CHECK(quads == (size_t)(40 * 20 - 40 * 20 / 3));
+
+    // the last column of chunks only holds 8 tiles across
+    const TILE_CHUNK* edge = atmc->GetChunk(2);
+    CHECK(edge->HalfSize.x == 40.f);
+    CHECK(edge->Center.x == 360.f);
+    CHECK(atmc->GetChunk(6) == nullptr);
+
+    const RENDER_QUAD& first = atmc->GetChunk(0)->QuadArray[1];
+    CHECK(first.Rect.x == 15.f);
+    CHECK(first.UV.x == 0.25f);
+    CHECK(first.UV.z == 0.25f);
+}
+
+TEST_CASE(Tilemap_SetTileDirtiesOnlyItsChunk)
+{
+    HeadlessScene scene = {};
+    ATilemapComponent* atmc = AddTilemapActor(&scene, "map",
+        MakeFloat3(0.f, 0.f, 0.f), 64, 64, 8.f);
+    FillPattern(atmc);
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+
+    atmc->SetTile(20, 35, atmc->GetTile(20, 35));
+    atmc->SetTile(200, 0, 5);
+    atmc->SetTile(20, 35, 7);
+    unsigned int dirty = 0;
+    for (unsigned int i = 0; i < atmc->GetChunkCount(); i++)
+    {
+        dirty += atmc->GetChunk(i)->DirtyFlg ? 1 : 0;
+    }
+    CHECK(dirty == 1);
+    CHECK(atmc->GetChunk(2 * 4 + 1)->DirtyFlg);
+    atmc->RebuildDirtyChunks();
+    CHECK(!atmc->GetChunk(2 * 4 + 1)->DirtyFlg);
+    CHECK(atmc->GetTile(20, 35) == 7);
+    CHECK(atmc->GetTile(200, 0) == EMPTY_TILE);
+}
+
+TEST_CASE(Tilemap_SolidQueriesFollowTheTransform)
+{
+    HeadlessScene scene = {};
+    ATilemapComponent* atmc = AddTilemapActor(&scene, "map",
+        MakeFloat3(100.f, 50.f, 0.f), 10, 10, 10.f);
+    atmc->SetSolidTiles({ 3, EMPTY_TILE });
+    atmc->SetTile(2, 1, 3);
+    atmc->SetTile(5, 5, 4);
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+
+    CHECK(atmc->IsSolidAtWorld(MakeFloat2(125.f, 65.f)));
+    CHECK(!atmc->IsSolidAtWorld(MakeFloat2(155.f, 105.f)));
+    CHECK(!atmc->IsSolidAtWorld(MakeFloat2(25.f, 15.f)));
+    CHECK(atmc->GetTileAtWorld(MakeFloat2(-1000.f, 0.f)) ==
+        EMPTY_TILE);
+    CHECK(atmc->OverlapSolidRect(MakeFloat2(110.f, 55.f),
+        MakeFloat2(15.f, 10.f)));
+    CHECK(!atmc->OverlapSolidRect(MakeFloat2(110.f, 55.f),
+        MakeFloat2(5.f, 5.f)));
+    CHECK(!atmc->OverlapSolidRect(MakeFloat2(-500.f, -500.f),
+        MakeFloat2(20.f, 20.f)));
+}
+
+TEST_CASE(Tilemap_OnlyChunksInViewAreSubmitted)
+{
+    HeadlessScene scene = {};
+    // 10 by 10 chunks of 160 units, the view covers 2 by 2 of them
+    ATilemapComponent* atmc = AddTilemapActor(&scene, "map",
+        MakeFloat3(0.f, 0.f, 0.f), 160, 160, 10.f);
+    FillPattern(atmc);
+    scene.GetSceneNode()->InitCamera(MakeFloat2(800.f, 800.f),
+        MakeFloat2(200.f, 200.f));
+    scene.RunFrame(MAX_DELTA);
+
+    auto& stats = scene.GetSceneNode()->GetDrawStatistics();
+    CHECK(stats.SubmittedChunks == 4);
+    CHECK(stats.CulledChunks == 96);
+    CHECK(scene.CountDrawCommands(RENDER_CMD_TYPE::TILE_CHUNK) == 4);
+
+    scene.GetSceneNode()->GetCamera()->TranslateCameraPos(
+        MakeFloat2(-1800.f, -1800.f));
+    scene.DrawFrame();
+    CHECK(stats.SubmittedChunks == 0);
+    CHECK(scene.CountDrawCommands(RENDER_CMD_TYPE::TILE_CHUNK) == 0);
+}
+
+TEST_CASE(Tilemap_ChunkCommandsCarryTheirCacheRevision)
+{
+    HeadlessScene scene = {};
+    ATilemapComponent* atmc = AddTilemapActor(&scene, "map",
+        MakeFloat3(0.f, 0.f, 0.f), 32, 16, 10.f);
+    FillPattern(atmc);
+    scene.RunFrame(MAX_DELTA);
+
+    auto backend = scene.GetRenderBackend();
+    std::vector<RENDER_COMMAND> first = {};
+    for (auto& cmd : *(backend->GetLastCommandArray()))
+    {
+        if (cmd.Type == RENDER_CMD_TYPE::TILE_CHUNK)
+        {
+            first.push_back(cmd);
+        }
+    }
+    REQUIRE(first.size() == 2);
+    CHECK(first[0].CacheKey != 0);
+    CHECK(first[0].CacheKey != first[1].CacheKey);
+
+    // an untouched chunk keeps its revision, so the backend keeps its
+    // vertex buffer and only the edited chunk is uploaded again
+    atmc->SetTile(20, 3, 9);
+    scene.DrawFrame();
+    std::vector<RENDER_COMMAND> second = {};
+    for (auto& cmd : *(backend->GetLastCommandArray()))
+    {
+        if (cmd.Type == RENDER_CMD_TYPE::TILE_CHUNK)
+        {
+            second.push_back(cmd);
+        }
+    }
+    REQUIRE(second.size() == 2);
+    CHECK(second[0].CacheKey == first[0].CacheKey);
+    CHECK(second[0].CacheRevision == first[0].CacheRevision);
+    CHECK(second[1].CacheKey == first[1].CacheKey);
+    CHECK(second[1].CacheRevision != first[1].CacheRevision);
+
+    // a new layout hands out new keys
+    atmc->SetTileLayout(32, 16, MakeFloat2(10.f, 10.f));
+    FillPattern(atmc);
+    scene.DrawFrame();
+    for (auto& cmd : *(backend->GetLastCommandArray()))
+    {
+        if (cmd.Type == RENDER_CMD_TYPE::TILE_CHUNK)
+        {
+            CHECK(cmd.CacheKey != first[0].CacheKey);
+            CHECK(cmd.CacheKey != first[1].CacheKey);
+        }
+    }
+}
+
+TEST_CASE(Tilemap_BenchScrollingLargeMap)
+{
+    const unsigned int side = 1024;
+    const int frames = 300;
+    HeadlessScene scene = {};
+    ATilemapComponent* atmc = AddTilemapActor(&scene, "map",
+        MakeFloat3(0.f, 0.f, 0.f), side, side, 32.f);
+    FillPattern(atmc);
+
+    BenchTimer timer = {};
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+    double bakeMs = timer.GetElapsedMs();
+
+    scene.GetSceneNode()->InitCamera(MakeFloat2(960.f, 540.f),
+        MakeFloat2(1920.f, 1080.f));
+    Camera* camera = scene.GetSceneNode()->GetCamera();
+    unsigned long long submitted = 0;
+    timer.ResetTimer();
+    for (int i = 0; i < frames; i++)
+    {
+        camera->TranslateCameraPos(MakeFloat2(40.f, 20.f));
+        scene.DrawFrame();
+        submitted +=
+            scene.GetSceneNode()->GetDrawStatistics().SubmittedChunks;
+    }
+
+    BENCH_LOG("%u x %u tiles in %u chunks, %.3f ms to bake, %.4f ms "
+        "per draw, %llu chunks submitted per frame\n", side, side,
+        atmc->GetChunkCount(), bakeMs, timer.GetElapsedMs() / frames,
+        submitted / frames);
+    CHECK(submitted > 0);
+}
@@ -0,0 +1,270 @@
+﻿//---------------------------------------------------------------
+// File: UiFocusGraphTest.cpp
+// Proj: HycFrame2D
+// Info: ボタン選択移動グラフのテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "HeadlessScene.h"
+#include "SceneNode.h"
+#include "UiObject.h"
+#include "UTransformComponent.h"
+#include "UBtnMapComponent.h"
+#include "UiFocusGraph.h"
+#include <cfloat>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace
+{
+    UBtnMapComponent* AddButton(HeadlessScene* _scene,
+        std::string _name, Float2 _pos)
+    {
+        UiObject* ui = _scene->AddSpriteUi(_name,
+            MakeFloat3(_pos.x, _pos.y, 0.f), MakeFloat2(32.f, 20.f), 0);
+        UBtnMapComponent* ubmc =
+            new UBtnMapComponent(_name + "-btnmap", ui, 0);
+        ui->AddUComponent(ubmc);
+
+        return ubmc;
+    }
+
+    UiObject* GetSurround(UBtnMapComponent* _ubmc, int _direction)
+    {
+        switch (_direction)
+        {
+        case LEFT_BTN: return _ubmc->GetLeftBtn();
+        case UP_BTN: return _ubmc->GetUpBtn();
+        case RIGHT_BTN: return _ubmc->GetRightBtn();
+        default: return _ubmc->GetDownBtn();
+        }
+    }
+
+    Float2 GetButtonPos(UBtnMapComponent* _ubmc)
+    {
+        Float3 pos = _ubmc->GetUiObjOwner()->
+            GetUComponent<UTransformComponent>(COMP_TYPE::UTRANSFORM)->
+            GetPosition();
+
+        return MakeFloat2(pos.x, pos.y);
+    }
+
+    // every button against every other one, the way the graph did it
+    // before it had a grid
+    UiObject* FindByBruteForce(const std::vector<UBtnMapComponent*>&
+        _buttons, UBtnMapComponent* _from, int _direction)
+    {
+        const float dirX[4] = { -1.f, 0.f, 1.f, 0.f };
+        const float dirY[4] = { 0.f, -1.f, 0.f, 1.f };
+        Float2 origin = GetButtonPos(_from);
+        UBtnMapComponent* nearest = nullptr;
+        float bestScore = FLT_MAX;
+        for (auto& btn : _buttons)
+        {
+            if (btn == _from)
+            {
+                continue;
+            }
+            Float2 pos = GetButtonPos(btn);
+            float dx = pos.x - origin.x;
+            float dy = pos.y - origin.y;
+            float along = dx * dirX[_direction] + dy * dirY[_direction];
+            if (along <= 0.f)
+            {
+                continue;
+            }
+            float score = along + 2.f *
+                fabsf(dx * dirY[_direction] - dy * dirX[_direction]);
+            if (score < bestScore || (score == bestScore &&
+                btn->GetFocusIndex() < nearest->GetFocusIndex()))
+            {
+                bestScore = score;
+                nearest = btn;
+            }
+        }
+
+        return nearest ? nearest->GetUiObjOwner() : nullptr;
+    }
+
+    bool MatchesBruteForce(const std::vector<UBtnMapComponent*>&
+        _buttons)
+    {
+        bool same = true;
+        for (auto& btn : _buttons)
+        {
+            for (int dir = 0; dir < 4; dir++)
+            {
+                same = same && GetSurround(btn, dir) ==
+                    FindByBruteForce(_buttons, btn, dir);
+            }
+        }
+
+        return same;
+    }
+
+    // scattered on a coarse lattice so that ties happen as well
+    Float2 MakeScatteredPos(unsigned int* _seed)
+    {
+        *_seed = *_seed * 1664525u + 1013904223u;
+        float x = (float)((*_seed >> 8) % 60) * 40.f - 1200.f;
+        *_seed = *_seed * 1664525u + 1013904223u;
+        float y = (float)((*_seed >> 8) % 40) * 30.f - 600.f;
+
+        return MakeFloat2(x, y);
+    }
+}
+
+TEST_CASE(UiFocusGraph_AutoNeighborsMatchBruteForce)
+{
+    HeadlessScene scene = {};
+    UiFocusGraph* graph = scene.GetSceneNode()->GetFocusGraph();
+    std::vector<UBtnMapComponent*> buttons = {};
+    unsigned int seed = 7;
+    for (int i = 0; i < 300; i++)
+    {
+        buttons.push_back(AddButton(&scene, "btn-" + std::to_string(i),
+            MakeScatteredPos(&seed)));
+    }
+    scene.RunFrame(MAX_DELTA);
+    REQUIRE(graph->GetNodeCount() == 300);
+    CHECK(graph->GetStatistics().FullBuilds == 1);
+    CHECK(MatchesBruteForce(buttons));
+    // the grid only scores the buttons around each one
+    CHECK(graph->GetStatistics().ScoredPairs < 300ull * 299ull);
+
+    // a few removed and a few added are patched in, not rebuilt
+    for (int i = 0; i < 20; i++)
+    {
+        buttons[i * 7]->GetUiObjOwner()->
+            SetObjectActive(STATUS::NEED_DESTORY);
+    }
+    scene.RunFrame(MAX_DELTA);
+    for (int i = 0; i < 20; i++)
+    {
+        buttons.erase(buttons.begin() + (19 - i) * 7);
+    }
+    for (int i = 0; i < 12; i++)
+    {
+        buttons.push_back(AddButton(&scene, "late-" + std::to_string(i),
+            MakeScatteredPos(&seed)));
+    }
+    scene.RunFrame(MAX_DELTA);
+    scene.RunFrame(MAX_DELTA);
+    CHECK(graph->GetNodeCount() == 292);
+    CHECK(graph->GetStatistics().FullBuilds == 1);
+    // the removal is picked up together with the next additions
+    CHECK(graph->GetStatistics().PatchedBuilds == 1);
+    CHECK(MatchesBruteForce(buttons));
+
+    // removed slots are reused without leaving stale links behind
+    for (auto& btn : buttons)
+    {
+        for (int dir = 0; dir < 4; dir++)
+        {
+            UiObject* next = GetSurround(btn, dir);
+            CHECK(!next || next->IsObjectActive() == STATUS::ACTIVE);
+        }
+    }
+}
+
+TEST_CASE(UiFocusGraph_NamedNeighborsOverride)
+{
+    HeadlessScene scene = {};
+    UiFocusGraph* graph = scene.GetSceneNode()->GetFocusGraph();
+    // a row of three, the middle one wraps left to the far end and
+    // names a right neighbour that comes later
+    UBtnMapComponent* a = AddButton(&scene, "a", MakeFloat2(0.f, 0.f));
+    UBtnMapComponent* b =
+        AddButton(&scene, "b", MakeFloat2(100.f, 0.f));
+    UBtnMapComponent* c =
+        AddButton(&scene, "c", MakeFloat2(200.f, 0.f));
+    b->SetLeftName("c");
+    b->SetRightName("menu");
+    scene.RunFrame(MAX_DELTA);
+
+    CHECK(a->GetRightBtn() == b->GetUiObjOwner());
+    CHECK(c->GetLeftBtn() == b->GetUiObjOwner());
+    CHECK(b->GetLeftBtn() == c->GetUiObjOwner());
+    CHECK(b->GetRightBtn() == nullptr);
+    CHECK(b->GetUpBtn() == nullptr);
+
+    // the named button turns up later and is picked up by the patch,
+    // while the others take it as their auto neighbour
+    UBtnMapComponent* menu =
+        AddButton(&scene, "menu", MakeFloat2(100.f, -300.f));
+    scene.RunFrame(MAX_DELTA);
+    CHECK(b->GetRightBtn() == menu->GetUiObjOwner());
+    CHECK(b->GetUpBtn() == menu->GetUiObjOwner());
+    CHECK(menu->GetDownBtn() == b->GetUiObjOwner());
+    CHECK(graph->GetStatistics().FullBuilds == 0);
+
+    // moving follows the override, and only once per frame
+    a->SetIsSelected(true);
+    CHECK(graph->MoveFocus(a->GetFocusIndex(), RIGHT_BTN));
+    CHECK(!graph->MoveFocus(b->GetFocusIndex(), RIGHT_BTN));
+    scene.RunFrame(MAX_DELTA);
+    CHECK(graph->MoveFocus(b->GetFocusIndex(), RIGHT_BTN));
+    CHECK(menu->IsBeingSelected());
+    CHECK(!b->IsBeingSelected());
+
+    // a named target that goes away is not replaced by an auto one
+    menu->GetUiObjOwner()->SetObjectActive(STATUS::NEED_DESTORY);
+    scene.RunFrame(MAX_DELTA);
+    scene.RunFrame(MAX_DELTA);
+    CHECK(b->GetRightBtn() == nullptr);
+    CHECK(b->GetUpBtn() == nullptr);
+    CHECK(b->GetLeftBtn() == c->GetUiObjOwner());
+    CHECK(graph->GetNodeCount() == 3);
+}
+
+TEST_CASE(UiFocusGraph_BenchTenThousandButtons)
+{
+    const int side = 100;
+    const unsigned long long count = (unsigned long long)side * side;
+    HeadlessScene scene = {};
+    UiFocusGraph* graph = scene.GetSceneNode()->GetFocusGraph();
+    std::vector<UBtnMapComponent*> buttons = {};
+    for (int i = 0; i < side * side; i++)
+    {
+        buttons.push_back(AddButton(&scene, "btn-" + std::to_string(i),
+            MakeFloat2((float)(i % side) * 48.f,
+                (float)(i / side) * 32.f)));
+    }
+    scene.RunFrame(MAX_DELTA);
+    REQUIRE(graph->GetNodeCount() == count);
+
+    HEADLESS_BENCH still = scene.BenchFrames(10);
+    unsigned long long before = graph->GetStatistics().ScoredPairs;
+    HEADLESS_BENCH rebuild = scene.BenchFrames(10, [&](int _frame)
+    {
+        graph->MarkGraphDirty();
+        scene.RunFrame(MAX_DELTA);
+    });
+    unsigned long long buildPairs =
+        (graph->GetStatistics().ScoredPairs - before) / 10;
+
+    // one button swapped out per frame only patches its neighbours
+    HEADLESS_BENCH swap = scene.BenchFrames(60, [&](int _frame)
+    {
+        buttons[_frame * 31]->GetUiObjOwner()->
+            SetObjectActive(STATUS::NEED_DESTORY);
+        AddButton(&scene, "swap-" + std::to_string(_frame),
+            MakeFloat2((float)(_frame * 31 % side) * 48.f + 8.f,
+                (float)(_frame * 31 / side) * 32.f + 4.f));
+        scene.RunFrame(MAX_DELTA);
+    });
+    scene.RunFrame(MAX_DELTA);
+
+    BENCH_LOG("%llu buttons: %.2f ms a frame, %.2f ms with a full "
+        "build scoring %.1f pairs per button against %llu before, "
+        "%.2f ms with a swap patched in\n", count, still.MsPerFrame,
+        rebuild.MsPerFrame, (double)buildPairs / (double)count,
+        (count - 1) * 4, swap.MsPerFrame);
+    CHECK(graph->GetNodeCount() == count);
+    CHECK(graph->GetStatistics().FullBuilds == 11);
+    CHECK(graph->GetStatistics().PatchedBuilds == 61);
+    CHECK(buildPairs < count * 400);
+}
@@ -0,0 +1,298 @@
+﻿//---------------------------------------------------------------
+// File: UpdateFlagsTest.cpp
+// Proj: HycFrame2D
+// Info: コンポーネント更新フラグのテストとベンチマーク
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "TestFramework.h"
+#include "HeadlessScene.h"
+#include "SceneNode.h"
+#include "ActorObject.h"
+#include "AComponent.h"
+#include "AInteractionComponent.h"
+#include "SceneManager.h"
+#include "PropertyManager.h"
+#include "ObjectFactory.h"
+#include "JsonHelper.h"
+#include "RenderCommandQueue.h"
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+    class CountingAComponent :
+        public AComponent
+    {
+    public:
+        CountingAComponent(std::string _name, ActorObject* _owner,
+            bool _needUpdate) :
+            AComponent(_name, _owner, 0), mUpdateCount(0)
+        {
+            SetCompNeedUpdate(_needUpdate);
+        }
+
+        virtual void CompUpdate(float _deltatime)
+        {
+            ++mUpdateCount;
+        }
+
+        unsigned int GetUpdateCount() const
+        {
+            return mUpdateCount;
+        }
+
+    private:
+        unsigned int mUpdateCount;
+    };
+
+    CountingAComponent* AddCounter(ActorObject* _actor,
+        std::string _suffix, bool _needUpdate)
+    {
+        CountingAComponent* comp = new CountingAComponent(
+            _actor->GetObjectName() + _suffix, _actor, _needUpdate);
+        _actor->AddAComponent(comp);
+
+        return comp;
+    }
+
+    double BenchUpdate(int _actorNum, bool _needUpdate)
+    {
+        HeadlessScene scene = {};
+        for (int i = 0; i < _actorNum; i++)
+        {
+            ActorObject* actor = new ActorObject(
+                "bench-" + std::to_string(i), scene.GetSceneNode(), 0);
+            AddCounter(actor, "-idle-a", _needUpdate);
+            AddCounter(actor, "-idle-b", _needUpdate);
+            AddCounter(actor, "-idle-c", _needUpdate);
+            scene.GetSceneNode()->AddActorObject(actor);
+        }
+        scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+
+        const int frames = 200;
+        BenchTimer timer = {};
+        for (int i = 0; i < frames; i++)
+        {
+            scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+        }
+
+        return timer.GetElapsedMs() / frames;
+    }
+    const char* SHIPPED_SCENE_PATH[] =
+    {
+        "rom:/Configs/Scenes/1-scene.json",
+        "rom:/Configs/Scenes/2-scene.json",
+        "rom:/Configs/Scenes/3-scene.json"
+    };
+
+    // the actors of every shipped scene copied over and over into one
+    // scene config, a copy gets a number when its name is taken
+    void ReplicateShippedActors(unsigned int _actorNum,
+        JsonFile* _config, std::vector<std::string>* _names,
+        std::vector<std::vector<std::string>>* _compNames)
+    {
+        auto& alloc = _config->GetAllocator();
+        _config->SetObject();
+        _config->AddMember("scene-name", "shipped-x", alloc);
+        rapidjson::Value actors(rapidjson::kArrayType);
+
+        std::vector<JsonFile> scenes(3);
+        for (int i = 0; i < 3; i++)
+        {
+            LoadJsonFile(&scenes[i], SHIPPED_SCENE_PATH[i]);
+        }
+
+        std::unordered_set<std::string> used = {};
+        while (actors.Size() < _actorNum)
+        {
+            for (auto& scene : scenes)
+            {
+                for (auto& src : scene["actor"].GetArray())
+                {
+                    if (actors.Size() == _actorNum)
+                    {
+                        break;
+                    }
+
+                    rapidjson::Value copy(src, alloc);
+                    std::string name = copy["actor-name"].GetString();
+                    if (used.count(name))
+                    {
+                        name += "-" + std::to_string(actors.Size());
+                    }
+                    used.insert(name);
+                    copy["actor-name"].SetString(name.c_str(),
+                        (rapidjson::SizeType)name.size(), alloc);
+
+                    std::vector<std::string> comps = {};
+                    for (auto& comp : copy["components"].GetArray())
+                    {
+                        std::string type = comp["type"].GetString();
+                        comps.push_back(name + "-" + type);
+                        // the init, destroy and coroutine scripts only
+                        // print, the per frame one is kept
+                        if (type == "interaction")
+                        {
+                            comp.RemoveMember("init-func-name");
+                            comp.RemoveMember("destory-func-name");
+                            comp.RemoveMember("coroutine-func-name");
+                        }
+                    }
+                    _names->push_back(name);
+                    _compNames->push_back(comps);
+                    actors.PushBack(copy, alloc);
+                }
+            }
+        }
+        _config->AddMember("actor", actors, alloc);
+    }
+
+    struct SHIPPED_BENCH
+    {
+        double MsPerFrame;
+        double AllocationsPerFrame;
+        unsigned int UpdatedComps;
+    };
+
+    SHIPPED_BENCH BenchShippedScenes(unsigned int _actorNum,
+        bool _updateAll)
+    {
+        NullRenderBackend backend = {};
+        RenderCommandQueue queue = {};
+        queue.StartUp(&backend, false);
+        SceneManager* sm = new SceneManager();
+        PropertyManager* pm = new PropertyManager();
+        ObjectFactory* factory = new ObjectFactory();
+        factory->StartUp(pm, sm);
+        pm->StartUp(factory);
+        sm->PostStartUp(pm, factory, &queue);
+
+        JsonFile config = {};
+        std::vector<std::string> names = {};
+        std::vector<std::vector<std::string>> compNames = {};
+        ReplicateShippedActors(_actorNum, &config, &names, &compNames);
+        SceneNode* scene =
+            factory->CreateNewScene("shipped-x", "", &config);
+        scene->UpdateScene(MAX_DELTA);
+
+        // before the flags every component was called every frame
+        unsigned int updated = 0;
+        for (size_t i = 0; i < names.size(); i++)
+        {
+            ActorObject* actor = scene->GetActorObject(names[i]);
+            for (auto& compName : compNames[i])
+            {
+                AComponent* comp = actor->GetAComponent(compName);
+                if (_updateAll)
+                {
+                    comp->SetCompNeedUpdate(true);
+                }
+                updated += comp->IsCompNeedUpdate() ? 1 : 0;
+            }
+        }
+        scene->UpdateScene(MAX_DELTA);
+
+        const int frames = 100;
+        size_t allocations = GetAllocationCount();
+        BenchTimer timer = {};
+        for (int i = 0; i < frames; i++)
+        {
+            scene->UpdateScene(MAX_DELTA);
+        }
+        SHIPPED_BENCH result = { timer.GetElapsedMs() / frames,
+            (double)(GetAllocationCount() - allocations) / frames,
+            updated };
+
+        scene->ReleaseScene();
+        delete scene;
+        queue.CleanAndStop();
+        sm->CleanAndStop();
+        delete sm;
+        pm->CleanAndStop();
+        delete pm;
+        factory->CleanAndStop();
+        delete factory;
+
+        return result;
+    }
+}
+
+TEST_CASE(UpdateFlags_OptedOutComponentsAreSkipped)
+{
+    HeadlessScene scene = {};
+    ActorObject* actor = new ActorObject("flags", scene.GetSceneNode(),
+        0);
+    CountingAComponent* busy = AddCounter(actor, "-busy", true);
+    CountingAComponent* idle = AddCounter(actor, "-idle", false);
+    scene.GetSceneNode()->AddActorObject(actor);
+
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+    CHECK(busy->GetUpdateCount() == 2);
+    CHECK(idle->GetUpdateCount() == 0);
+
+    // flipping the flag at runtime rebuilds the list on the next frame
+    idle->SetCompNeedUpdate(true);
+    busy->SetCompNeedUpdate(false);
+    scene.GetSceneNode()->UpdateScene(MAX_DELTA);
+    CHECK(busy->GetUpdateCount() == 2);
+    CHECK(idle->GetUpdateCount() == 1);
+}
+
+TEST_CASE(UpdateFlags_InteractionNeedsUpdateOnlyWhenBound)
+{
+    HeadlessScene scene = {};
+    ActorObject* actor = scene.AddEmptyActor("inter",
+        MakeFloat3(0.f, 0.f, 0.f));
+    AInteractionComponent* aitc = new AInteractionComponent(
+        "inter-interaction", actor, 0);
+    actor->AddAComponent(aitc);
+    CHECK(!aitc->IsCompNeedUpdate());
+    CHECK(!actor->GetAComponent<AComponent>(COMP_TYPE::ATRANSFORM)->
+        IsCompNeedUpdate());
+
+    aitc->SetUpdateFunc([](AInteractionComponent*, float) {});
+    CHECK(aitc->IsCompNeedUpdate());
+    aitc->SetUpdateFunc(nullptr);
+    CHECK(!aitc->IsCompNeedUpdate());
+}
+
+TEST_CASE(UpdateFlags_BenchIdleComponents)
+{
+    const int actorNum = 10000;
+    double updateAll = BenchUpdate(actorNum, true);
+    double updateNone = BenchUpdate(actorNum, false);
+
+    BENCH_LOG("%d actors with 3 components, %.4f ms per update when "
+        "all need update, %.4f ms when none do\n", actorNum, updateAll,
+        updateNone);
+}
+
+TEST_CASE(UpdateFlags_BenchShippedScenes)
+{
+    const unsigned int actorNum = 10000;
+    // taken in turns and the best kept, the two are close
+    SHIPPED_BENCH baseline = BenchShippedScenes(actorNum, true);
+    SHIPPED_BENCH flagged = BenchShippedScenes(actorNum, false);
+    for (int i = 0; i < 2; i++)
+    {
+        SHIPPED_BENCH run = BenchShippedScenes(actorNum, true);
+        baseline.MsPerFrame = std::min(baseline.MsPerFrame,
+            run.MsPerFrame);
+        run = BenchShippedScenes(actorNum, false);
+        flagged.MsPerFrame = std::min(flagged.MsPerFrame,
+            run.MsPerFrame);
+    }
+
+    BENCH_LOG("%u actors copied from the shipped scenes, %.3f ms per "
+        "update calling all %u components, %.3f ms calling the %u "
+        "that need it, %.1f and %.1f allocations a frame\n", actorNum,
+        baseline.MsPerFrame, baseline.UpdatedComps, flagged.MsPerFrame,
+        flagged.UpdatedComps, baseline.AllocationsPerFrame,
+        flagged.AllocationsPerFrame);
+    CHECK(flagged.UpdatedComps < baseline.UpdatedComps);
+}
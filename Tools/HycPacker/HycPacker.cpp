@@ -0,0 +1,169 @@
+﻿//---------------------------------------------------------------
+// File: HycPacker.cpp
+// Proj: HycFrame2D
+// Info: romフォルダをアセットアーカイブにまとめるツール
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "AssetArchive.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    bool ReadWholeFile(const fs::path& _file,
+        std::vector<unsigned char>* _out)
+    {
+        std::ifstream file(_file, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        _out->assign(std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    bool HasCookedSibling(const fs::path& _file)
+    {
+        // the same case folding the runtime uses for its path ids
+        std::string ext = MakeAssetPathKey(_file.extension().string());
+        fs::path cooked = _file;
+        if (ext == ".png")
+        {
+            cooked.replace_extension(".dds");
+        }
+        else if (ext == ".wav")
+        {
+            cooked.replace_extension(".adpcm");
+        }
+        else
+        {
+            return false;
+        }
+
+        return fs::exists(cooked);
+    }
+
+    int PackRomFolder(const std::string& _romDir,
+        const std::string& _archive, bool _compress)
+    {
+        fs::path root(_romDir);
+        if (!fs::is_directory(root))
+        {
+            printf("cannot find rom folder : [ %s ]\n",
+                _romDir.c_str());
+            return 1;
+        }
+
+        // entries are named exactly like the paths used in the
+        // configs, e.g. rom:/Configs/Scenes/1-scene.json
+        std::string prefix = root.filename().string() + ":/";
+        AssetArchiveWriter writer;
+        std::unordered_map<unsigned long long, std::string> keyMap = {};
+        unsigned int skipNum = 0;
+        unsigned int duplicateNum = 0;
+        for (auto& item : fs::recursive_directory_iterator(root))
+        {
+            if (!item.is_regular_file())
+            {
+                continue;
+            }
+
+            // a cooked texture or sound replaces its source at
+            // runtime, so the source doesn't need to be shipped as well
+            std::string name = prefix + fs::relative(item.path(), root)
+                .generic_string();
+            if (HasCookedSibling(item.path()))
+            {
+                printf("skip source with cooked sibling : [ %s ]\n",
+                    name.c_str());
+                ++skipNum;
+                continue;
+            }
+
+            // two files that only differ in case get the same id, the
+            // first one wins and the other one is reported
+            std::string key = MakeAssetPathKey(name);
+            auto exist = keyMap.find(MakeAssetPathID(key));
+            if (exist != keyMap.end() && exist->second == key)
+            {
+                printf("skip duplicate entry : [ %s ]\n", name.c_str());
+                ++duplicateNum;
+                continue;
+            }
+            keyMap.insert({ MakeAssetPathID(key), key });
+
+            std::vector<unsigned char> data = {};
+            if (!ReadWholeFile(item.path(), &data))
+            {
+                printf("cannot read file : [ %s ]\n", name.c_str());
+                return 1;
+            }
+            if (!writer.AddEntry(name, std::move(data), _compress))
+            {
+                printf("path id collision : [ %s ]\n", name.c_str());
+                return 1;
+            }
+        }
+
+        if (!writer.WriteArchive(_archive))
+        {
+            printf("cannot write archive : [ %s ]\n", _archive.c_str());
+            return 1;
+        }
+
+        printf("packed %u files, %llu bytes -> %llu bytes\n",
+            writer.GetEntryCount(), writer.GetRawTotal(),
+            writer.GetStoredTotal());
+        printf("skipped %u cooked sources and %u duplicates\n",
+            skipNum, duplicateNum);
+        return 0;
+    }
+
+    int ListArchive(const std::string& _archive)
+    {
+        std::vector<unsigned char> data = {};
+        AssetArchive archive;
+        if (!ReadWholeFile(_archive, &data) ||
+            !archive.OpenArchive(data.data(), data.size()))
+        {
+            printf("invalid archive : [ %s ]\n", _archive.c_str());
+            return 1;
+        }
+
+        for (unsigned int i = 0; i < archive.GetEntryCount(); i++)
+        {
+            const ARCHIVE_ENTRY* entry = archive.GetEntry(i);
+            printf("%016llx %10llu %10llu %s %s\n", entry->PathID,
+                entry->RawSize, entry->StoredSize,
+                (entry->Flags & ASSET_ENTRY_COMPRESSED) ? "lz" : "--",
+                archive.GetEntryName(entry));
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc == 3 && !strcmp(argv[1], "-list"))
+    {
+        return ListArchive(argv[2]);
+    }
+    if (argc == 3 || (argc == 4 && !strcmp(argv[3], "-store")))
+    {
+        return PackRomFolder(argv[1], argv[2], argc == 3);
+    }
+
+    printf("usage : HycPacker <rom folder> <archive> [-store]\n");
+    printf("        HycPacker -list <archive>\n");
+    return 1;
+}
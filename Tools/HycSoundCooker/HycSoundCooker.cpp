@@ -0,0 +1,280 @@
+﻿//---------------------------------------------------------------
+// File: HycSoundCooker.cpp
+// Proj: HycFrame2D
+// Info: WAVサウンドをIMA-ADPCMに変換するツール
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "SoundCodec.h"
+#include "AudioSimd.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace fs = std::filesystem;
+
+#define COOK_SOUND_RATE (44100)
+
+namespace
+{
+    struct PCM_SOUND
+    {
+        unsigned int Channels = 0;
+        unsigned int SampleRate = 0;
+        std::vector<short> Samples = {};
+    };
+
+    struct COOK_RESULT
+    {
+        unsigned long long PcmBytes = 0;
+        unsigned long long CookedBytes = 0;
+        double Seconds = 0.0;
+        double EncodeMs = 0.0;
+        double DecodeMs = 0.0;
+        double Snr = 0.0;
+    };
+
+    bool ReadWholeFile(const fs::path& _file,
+        std::vector<unsigned char>* _out)
+    {
+        std::ifstream file(_file, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        _out->assign(std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    bool WriteWholeFile(const fs::path& _file,
+        const std::vector<unsigned char>& _data)
+    {
+        std::ofstream file(_file, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        file.write((const char*)_data.data(), _data.size());
+        return file.good();
+    }
+
+    unsigned int ReadU32(const unsigned char* _p)
+    {
+        return (unsigned int)_p[0] | ((unsigned int)_p[1] << 8) |
+            ((unsigned int)_p[2] << 16) | ((unsigned int)_p[3] << 24);
+    }
+
+    unsigned int ReadU16(const unsigned char* _p)
+    {
+        return (unsigned int)_p[0] | ((unsigned int)_p[1] << 8);
+    }
+
+    double GetElapsedMs(std::chrono::steady_clock::time_point _start)
+    {
+        return std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - _start).count();
+    }
+
+    // only 16 bit pcm can be mixed by the engine, so it is the only
+    // format accepted here as well
+    bool ParseWav(const std::vector<unsigned char>& _file,
+        PCM_SOUND* _out)
+    {
+        if (_file.size() < 12 || memcmp(_file.data(), "RIFF", 4) ||
+            memcmp(_file.data() + 8, "WAVE", 4))
+        {
+            return false;
+        }
+
+        unsigned int bits = 0;
+        size_t offset = 12;
+        while (offset + 8 <= _file.size())
+        {
+            const unsigned char* chunk = _file.data() + offset;
+            size_t size = ReadU32(chunk + 4);
+            if (size > _file.size() - offset - 8)
+            {
+                return false;
+            }
+
+            if (!memcmp(chunk, "fmt ", 4) && size >= 16)
+            {
+                unsigned int format = ReadU16(chunk + 8);
+                _out->Channels = ReadU16(chunk + 10);
+                _out->SampleRate = ReadU32(chunk + 12);
+                bits = ReadU16(chunk + 22);
+                if (format != 1 && format != 0xFFFE)
+                {
+                    return false;
+                }
+            }
+            else if (!memcmp(chunk, "data", 4))
+            {
+                if (bits != 16 || !_out->SampleRate ||
+                    (_out->Channels != 1 && _out->Channels != 2))
+                {
+                    return false;
+                }
+                size_t frames = size / (2 * _out->Channels);
+                _out->Samples.resize(frames * _out->Channels);
+                memcpy(_out->Samples.data(), chunk + 8,
+                    _out->Samples.size() * sizeof(short));
+                return frames != 0;
+            }
+
+            offset += 8 + size + (size & 1);
+        }
+
+        return false;
+    }
+
+    bool CookSound(const fs::path& _wav, COOK_RESULT* _result)
+    {
+        fs::path cooked = _wav;
+        cooked.replace_extension(".adpcm");
+
+        std::vector<unsigned char> file = {};
+        PCM_SOUND sound = {};
+        if (!ReadWholeFile(_wav, &file) || !ParseWav(file, &sound))
+        {
+            // the runtime reads the wav itself when there is no cooked
+            // sibling, so a stale one must not be left behind
+            printf("skip, not a 16 bit pcm wav : [ %s ]\n",
+                _wav.generic_string().c_str());
+            fs::remove(cooked);
+            return false;
+        }
+
+        // the mixer only accepts adpcm at its own rate
+        std::vector<short> pcm = {};
+        if (sound.SampleRate != COOK_SOUND_RATE)
+        {
+            ResamplePcm16(sound.Samples.data(),
+                sound.Samples.size() / sound.Channels, sound.Channels,
+                sound.SampleRate, COOK_SOUND_RATE, &pcm);
+        }
+        else
+        {
+            pcm = std::move(sound.Samples);
+        }
+        size_t frames = pcm.size() / sound.Channels;
+        _result->PcmBytes = pcm.size() * sizeof(short);
+        _result->Seconds = (double)frames / COOK_SOUND_RATE;
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<unsigned char> output = {};
+        EncodeAdpcmSound(pcm.data(), frames, sound.Channels,
+            COOK_SOUND_RATE, &output);
+        _result->EncodeMs = GetElapsedMs(start);
+        _result->CookedBytes = output.size();
+
+        ADPCM_SOUND_HEADER header = {};
+        const unsigned char* blocks = nullptr;
+        ParseAdpcmSound(output.data(), output.size(), &header, &blocks);
+        size_t blockNum = (size_t)header.BlockCount * sound.Channels;
+        std::vector<short> decoded(blockNum * ADPCM_BLOCK_FRAMES);
+        start = std::chrono::steady_clock::now();
+        DecodeAdpcmBlocks(blocks, blockNum, decoded.data());
+        _result->DecodeMs = GetElapsedMs(start);
+
+        double signal = 0.0;
+        double noise = 0.0;
+        for (size_t i = 0; i < frames; i++)
+        {
+            for (unsigned int c = 0; c < sound.Channels; c++)
+            {
+                size_t block = (i / ADPCM_BLOCK_FRAMES) *
+                    sound.Channels + c;
+                double a = pcm[i * sound.Channels + c];
+                double b = decoded[block * ADPCM_BLOCK_FRAMES +
+                    i % ADPCM_BLOCK_FRAMES];
+                signal += a * a;
+                noise += (a - b) * (a - b);
+            }
+        }
+        _result->Snr = noise > 0.0 ?
+            10.0 * log10(signal / noise) : 99.0;
+
+        if (!WriteWholeFile(cooked, output))
+        {
+            printf("cannot write adpcm : [ %s ]\n",
+                cooked.generic_string().c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    int CookSoundFolder(const std::string& _dir)
+    {
+        fs::path root(_dir);
+        if (!fs::is_directory(root))
+        {
+            printf("cannot find sound folder : [ %s ]\n",
+                _dir.c_str());
+            return 1;
+        }
+
+        std::vector<fs::path> wavArray = {};
+        for (auto& item : fs::recursive_directory_iterator(root))
+        {
+            std::string ext = item.path().extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(),
+                [](unsigned char _c) { return (char)tolower(_c); });
+            if (item.is_regular_file() && ext == ".wav")
+            {
+                wavArray.push_back(item.path());
+            }
+        }
+        std::sort(wavArray.begin(), wavArray.end());
+
+        printf("%-32s %7s %11s %11s %9s %9s %6s\n", "sound", "sec",
+            "pcm bytes", "cooked", "enc ms", "dec ms", "snr");
+        unsigned long long pcmTotal = 0;
+        unsigned long long cookedTotal = 0;
+        double secondTotal = 0.0;
+        double decodeTotal = 0.0;
+        for (auto& wav : wavArray)
+        {
+            COOK_RESULT result = {};
+            if (!CookSound(wav, &result))
+            {
+                continue;
+            }
+
+            printf("%-32s %7.2f %11llu %11llu %9.2f %9.3f %6.1f\n",
+                fs::relative(wav, root).generic_string().c_str(),
+                result.Seconds, result.PcmBytes, result.CookedBytes,
+                result.EncodeMs, result.DecodeMs, result.Snr);
+            pcmTotal += result.PcmBytes;
+            cookedTotal += result.CookedBytes;
+            secondTotal += result.Seconds;
+            decodeTotal += result.DecodeMs;
+        }
+
+        printf("memory %llu bytes -> %llu bytes, "
+            "decode %.0fx realtime\n", pcmTotal, cookedTotal, decodeTotal > 0.0 ?
+            secondTotal * 1000.0 / decodeTotal : 0.0);
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc == 2)
+    {
+        return CookSoundFolder(argv[1]);
+    }
+
+    printf("usage : HycSoundCooker <sound folder>\n");
+    return 1;
+}
@@ -0,0 +1,1220 @@
+﻿//---------------------------------------------------------------
+// File: HycTexCooker.cpp
+// Proj: HycFrame2D
+// Info: PNGテクスチャをブロック圧縮DDSに変換するツール
+// Date: 2026.10.19
+// Comt: NULL
+//---------------------------------------------------------------
+
+#include "DdsTexture.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    struct RGBA_IMAGE
+    {
+        unsigned int Width = 0;
+        unsigned int Height = 0;
+        std::vector<unsigned char> Pixels = {};
+    };
+
+    struct COOK_RESULT
+    {
+        DDS_FORMAT Format = DDS_FORMAT::UNKNOWN;
+        unsigned int MipCount = 0;
+        unsigned long long RawBytes = 0;
+        unsigned long long CookedBytes = 0;
+        double DecodeMs = 0.0;
+        double EncodeMs = 0.0;
+        double SquaredError = 0.0;
+        unsigned long long PixelCount = 0;
+    };
+
+    bool ReadWholeFile(const fs::path& _file,
+        std::vector<unsigned char>* _out)
+    {
+        std::ifstream file(_file, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        _out->assign(std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    bool WriteWholeFile(const fs::path& _file,
+        const std::vector<unsigned char>& _data)
+    {
+        std::ofstream file(_file, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        file.write((const char*)_data.data(), _data.size());
+        return (bool)file;
+    }
+
+    double GetElapsedMs(std::chrono::steady_clock::time_point _start)
+    {
+        return std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - _start).count();
+    }
+
+    //-----------------------------------------------------------
+    // inflate
+    //-----------------------------------------------------------
+
+    struct BIT_READER
+    {
+        const unsigned char* Data;
+        size_t Size;
+        size_t Pos;
+        unsigned int Bits;
+        unsigned int Count;
+        bool Error;
+    };
+
+    struct HUFFMAN_TABLE
+    {
+        unsigned short Count[16];
+        unsigned short Symbol[288];
+    };
+
+    unsigned int ReadBits(BIT_READER* _br, unsigned int _need)
+    {
+        while (_br->Count < _need)
+        {
+            if (_br->Pos >= _br->Size)
+            {
+                _br->Error = true;
+                return 0;
+            }
+            _br->Bits |= (unsigned int)_br->Data[_br->Pos++] <<
+                _br->Count;
+            _br->Count += 8;
+        }
+
+        unsigned int value = _br->Bits & ((1u << _need) - 1);
+        _br->Bits >>= _need;
+        _br->Count -= _need;
+        return value;
+    }
+
+    bool BuildHuffman(HUFFMAN_TABLE* _table,
+        const unsigned char* _lengths, unsigned int _num)
+    {
+        memset(_table->Count, 0, sizeof(_table->Count));
+        for (unsigned int i = 0; i < _num; i++)
+        {
+            ++_table->Count[_lengths[i]];
+        }
+        if (_table->Count[0] == _num)
+        {
+            return true;
+        }
+
+        int left = 1;
+        for (int len = 1; len < 16; len++)
+        {
+            left = (left << 1) - _table->Count[len];
+            if (left < 0)
+            {
+                return false;
+            }
+        }
+
+        unsigned short offset[16] = {};
+        for (int len = 1; len < 15; len++)
+        {
+            offset[len + 1] = offset[len] + _table->Count[len];
+        }
+        for (unsigned int i = 0; i < _num; i++)
+        {
+            if (_lengths[i])
+            {
+                _table->Symbol[offset[_lengths[i]]++] =
+                    (unsigned short)i;
+            }
+        }
+        return true;
+    }
+
+    int DecodeSymbol(BIT_READER* _br, const HUFFMAN_TABLE* _table)
+    {
+        int code = 0;
+        int first = 0;
+        int index = 0;
+        for (int len = 1; len < 16; len++)
+        {
+            code |= (int)ReadBits(_br, 1);
+            int count = _table->Count[len];
+            if (code - count < first)
+            {
+                return _table->Symbol[index + (code - first)];
+            }
+            index += count;
+            first += count;
+            first <<= 1;
+            code <<= 1;
+        }
+
+        _br->Error = true;
+        return -1;
+    }
+
+    bool InflateBlock(BIT_READER* _br, const HUFFMAN_TABLE* _lit,
+        const HUFFMAN_TABLE* _dist, std::vector<unsigned char>* _out)
+    {
+        static const unsigned short LEN_BASE[29] = {
+            3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+            35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227,
+            258 };
+        static const unsigned char LEN_EXTRA[29] = {
+            0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+            3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+        static const unsigned short DIST_BASE[30] = {
+            1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129,
+            193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097,
+            6145, 8193, 12289, 16385, 24577 };
+        static const unsigned char DIST_EXTRA[30] = {
+            0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6,
+            6, 7, 7, 8, 8, 9, 9, 10, 10, 11,
+            11, 12, 12, 13, 13 };
+
+        while (!_br->Error)
+        {
+            int symbol = DecodeSymbol(_br, _lit);
+            if (symbol < 0)
+            {
+                return false;
+            }
+            if (symbol < 256)
+            {
+                _out->push_back((unsigned char)symbol);
+                continue;
+            }
+            if (symbol == 256)
+            {
+                return true;
+            }
+
+            symbol -= 257;
+            if (symbol >= 29)
+            {
+                return false;
+            }
+            size_t length = LEN_BASE[symbol] +
+                ReadBits(_br, LEN_EXTRA[symbol]);
+            int distSymbol = DecodeSymbol(_br, _dist);
+            if (distSymbol < 0 || distSymbol >= 30)
+            {
+                return false;
+            }
+            size_t distance = DIST_BASE[distSymbol] +
+                ReadBits(_br, DIST_EXTRA[distSymbol]);
+            if (distance > _out->size())
+            {
+                return false;
+            }
+
+            size_t from = _out->size() - distance;
+            for (size_t i = 0; i < length; i++)
+            {
+                _out->push_back((*_out)[from + i]);
+            }
+        }
+
+        return false;
+    }
+
+    bool InflateZlib(const unsigned char* _src, size_t _size,
+        std::vector<unsigned char>* _out)
+    {
+        if (_size < 2 || (_src[0] & 0x0F) != 8 ||
+            ((_src[0] << 8) | _src[1]) % 31 || (_src[1] & 0x20))
+        {
+            return false;
+        }
+
+        BIT_READER br = { _src, _size, 2, 0, 0, false };
+        HUFFMAN_TABLE lit = {};
+        HUFFMAN_TABLE dist = {};
+        unsigned int last = 0;
+        while (!last)
+        {
+            last = ReadBits(&br, 1);
+            unsigned int type = ReadBits(&br, 2);
+            if (br.Error)
+            {
+                return false;
+            }
+
+            if (type == 0)
+            {
+                br.Bits = 0;
+                br.Count = 0;
+                if (br.Pos + 4 > br.Size)
+                {
+                    return false;
+                }
+                unsigned int len = br.Data[br.Pos] |
+                    (br.Data[br.Pos + 1] << 8);
+                unsigned int nlen = br.Data[br.Pos + 2] |
+                    (br.Data[br.Pos + 3] << 8);
+                br.Pos += 4;
+                if ((len ^ 0xFFFF) != nlen || br.Pos + len > br.Size)
+                {
+                    return false;
+                }
+                _out->insert(_out->end(), br.Data + br.Pos,
+                    br.Data + br.Pos + len);
+                br.Pos += len;
+                continue;
+            }
+
+            unsigned char lengths[320] = {};
+            if (type == 1)
+            {
+                for (int i = 0; i < 288; i++)
+                {
+                    lengths[i] = i < 144 ? 8 : i < 256 ? 9 :
+                        i < 280 ? 7 : 8;
+                }
+                for (int i = 0; i < 30; i++)
+                {
+                    lengths[288 + i] = 5;
+                }
+                BuildHuffman(&lit, lengths, 288);
+                BuildHuffman(&dist, lengths + 288, 30);
+            }
+            else if (type == 2)
+            {
+                static const unsigned char ORDER[19] = {
+                    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3,
+                    13, 2, 14, 1, 15 };
+                unsigned int nlen = ReadBits(&br, 5) + 257;
+                unsigned int ndist = ReadBits(&br, 5) + 1;
+                unsigned int ncode = ReadBits(&br, 4) + 4;
+                if (nlen > 286 || ndist > 30)
+                {
+                    return false;
+                }
+
+                unsigned char codeLengths[19] = {};
+                for (unsigned int i = 0; i < ncode; i++)
+                {
+                    codeLengths[ORDER[i]] =
+                        (unsigned char)ReadBits(&br, 3);
+                }
+                HUFFMAN_TABLE code = {};
+                if (!BuildHuffman(&code, codeLengths, 19))
+                {
+                    return false;
+                }
+
+                unsigned int index = 0;
+                while (index < nlen + ndist)
+                {
+                    int symbol = DecodeSymbol(&br, &code);
+                    if (symbol < 0 || br.Error)
+                    {
+                        return false;
+                    }
+                    if (symbol < 16)
+                    {
+                        lengths[index++] = (unsigned char)symbol;
+                        continue;
+                    }
+
+                    unsigned char value = 0;
+                    unsigned int repeat = 0;
+                    if (symbol == 16)
+                    {
+                        if (!index)
+                        {
+                            return false;
+                        }
+                        value = lengths[index - 1];
+                        repeat = 3 + ReadBits(&br, 2);
+                    }
+                    else if (symbol == 17)
+                    {
+                        repeat = 3 + ReadBits(&br, 3);
+                    }
+                    else
+                    {
+                        repeat = 11 + ReadBits(&br, 7);
+                    }
+                    if (index + repeat > nlen + ndist)
+                    {
+                        return false;
+                    }
+                    while (repeat--)
+                    {
+                        lengths[index++] = value;
+                    }
+                }
+
+                if (!BuildHuffman(&lit, lengths, nlen) ||
+                    !BuildHuffman(&dist, lengths + nlen, ndist))
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                return false;
+            }
+
+            if (!InflateBlock(&br, &lit, &dist, _out))
+            {
+                return false;
+            }
+        }
+
+        return !br.Error;
+    }
+
+    //-----------------------------------------------------------
+    // png
+    //-----------------------------------------------------------
+
+    unsigned int ReadBigEndian(const unsigned char* _p)
+    {
+        return ((unsigned int)_p[0] << 24) |
+            ((unsigned int)_p[1] << 16) |
+            ((unsigned int)_p[2] << 8) | (unsigned int)_p[3];
+    }
+
+    unsigned char PaethPredict(int _a, int _b, int _c)
+    {
+        int p = _a + _b - _c;
+        int pa = abs(p - _a);
+        int pb = abs(p - _b);
+        int pc = abs(p - _c);
+        if (pa <= pb && pa <= pc)
+        {
+            return (unsigned char)_a;
+        }
+        return (unsigned char)(pb <= pc ? _b : _c);
+    }
+
+    // only the layout every texture in rom uses is handled : 8 bit
+    // per channel, not interlaced, any color type
+    bool DecodePng(const std::vector<unsigned char>& _file,
+        RGBA_IMAGE* _image)
+    {
+        static const unsigned char SIGNATURE[8] = {
+            0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+        if (_file.size() < 8 || memcmp(_file.data(), SIGNATURE, 8))
+        {
+            return false;
+        }
+
+        unsigned int width = 0;
+        unsigned int height = 0;
+        unsigned int colorType = 0;
+        std::vector<unsigned char> palette = {};
+        std::vector<unsigned char> paletteAlpha = {};
+        std::vector<unsigned char> compressed = {};
+        size_t pos = 8;
+        while (pos + 12 <= _file.size())
+        {
+            unsigned int length = ReadBigEndian(&_file[pos]);
+            const unsigned char* type = &_file[pos + 4];
+            const unsigned char* data = &_file[pos + 8];
+            if (length > _file.size() - pos - 12)
+            {
+                return false;
+            }
+
+            if (!memcmp(type, "IHDR", 4))
+            {
+                if (length < 13)
+                {
+                    return false;
+                }
+                width = ReadBigEndian(data);
+                height = ReadBigEndian(data + 4);
+                colorType = data[9];
+                if (data[8] != 8 || data[12] != 0)
+                {
+                    return false;
+                }
+            }
+            else if (!memcmp(type, "PLTE", 4))
+            {
+                palette.assign(data, data + length);
+            }
+            else if (!memcmp(type, "tRNS", 4))
+            {
+                paletteAlpha.assign(data, data + length);
+            }
+            else if (!memcmp(type, "IDAT", 4))
+            {
+                compressed.insert(compressed.end(), data,
+                    data + length);
+            }
+            else if (!memcmp(type, "IEND", 4))
+            {
+                break;
+            }
+            pos += 12 + (size_t)length;
+        }
+
+        unsigned int channels = 0;
+        switch (colorType)
+        {
+        case 0: channels = 1; break;
+        case 2: channels = 3; break;
+        case 3: channels = 1; break;
+        case 4: channels = 2; break;
+        case 6: channels = 4; break;
+        default: return false;
+        }
+        if (!width || !height || width > 16384 || height > 16384)
+        {
+            return false;
+        }
+
+        size_t stride = (size_t)width * channels;
+        std::vector<unsigned char> raw = {};
+        raw.reserve((stride + 1) * height);
+        if (!InflateZlib(compressed.data(), compressed.size(), &raw) ||
+            raw.size() < (stride + 1) * height)
+        {
+            return false;
+        }
+
+        std::vector<unsigned char> rows(stride * height);
+        for (unsigned int y = 0; y < height; y++)
+        {
+            const unsigned char* src = &raw[y * (stride + 1)];
+            unsigned char filter = *src++;
+            unsigned char* dst = &rows[y * stride];
+            const unsigned char* up = y ? dst - stride : nullptr;
+            for (size_t x = 0; x < stride; x++)
+            {
+                int a = x >= channels ? dst[x - channels] : 0;
+                int b = up ? up[x] : 0;
+                int c = (up && x >= channels) ? up[x - channels] : 0;
+                switch (filter)
+                {
+                case 0: dst[x] = src[x]; break;
+                case 1: dst[x] = (unsigned char)(src[x] + a); break;
+                case 2: dst[x] = (unsigned char)(src[x] + b); break;
+                case 3:
+                    dst[x] = (unsigned char)(src[x] + ((a + b) >> 1));
+                    break;
+                case 4:
+                    dst[x] = (unsigned char)(src[x] +
+                        PaethPredict(a, b, c));
+                    break;
+                default: return false;
+                }
+            }
+        }
+
+        _image->Width = width;
+        _image->Height = height;
+        _image->Pixels.resize((size_t)width * height * 4);
+        for (size_t i = 0; i < (size_t)width * height; i++)
+        {
+            const unsigned char* src = &rows[i * channels];
+            unsigned char* dst = &_image->Pixels[i * 4];
+            switch (colorType)
+            {
+            case 0:
+                dst[0] = dst[1] = dst[2] = src[0];
+                dst[3] = 255;
+                break;
+            case 2:
+                dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2];
+                dst[3] = 255;
+                break;
+            case 3:
+                if ((size_t)src[0] * 3 + 2 >= palette.size())
+                {
+                    return false;
+                }
+                memcpy(dst, &palette[src[0] * 3], 3);
+                dst[3] = src[0] < paletteAlpha.size() ?
+                    paletteAlpha[src[0]] : 255;
+                break;
+            case 4:
+                dst[0] = dst[1] = dst[2] = src[0];
+                dst[3] = src[1];
+                break;
+            default:
+                memcpy(dst, src, 4);
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    //-----------------------------------------------------------
+    // block compression
+    //-----------------------------------------------------------
+
+    struct COLOR_BLOCK
+    {
+        float Color[16][3];
+        unsigned char Alpha[16];
+    };
+
+    unsigned short PackColor565(const float _color[3])
+    {
+        int r = (int)(std::clamp(_color[0], 0.f, 255.f) * 31.f /
+            255.f + 0.5f);
+        int g = (int)(std::clamp(_color[1], 0.f, 255.f) * 63.f /
+            255.f + 0.5f);
+        int b = (int)(std::clamp(_color[2], 0.f, 255.f) * 31.f /
+            255.f + 0.5f);
+        return (unsigned short)((r << 11) | (g << 5) | b);
+    }
+
+    void UnpackColor565(unsigned short _packed, float _color[3])
+    {
+        int r = (_packed >> 11) & 31;
+        int g = (_packed >> 5) & 63;
+        int b = _packed & 31;
+        _color[0] = (float)((r << 3) | (r >> 2));
+        _color[1] = (float)((g << 2) | (g >> 4));
+        _color[2] = (float)((b << 3) | (b >> 2));
+    }
+
+    float GetDistance(const float _a[3], const float _b[3])
+    {
+        float dr = _a[0] - _b[0];
+        float dg = _a[1] - _b[1];
+        float db = _a[2] - _b[2];
+        return dr * dr + dg * dg + db * db;
+    }
+
+    // weight of the second endpoint for each palette entry
+    const float FOUR_COLOR_WEIGHT[4] = {
+        0.f, 1.f, 1.f / 3.f, 2.f / 3.f };
+    const float THREE_COLOR_WEIGHT[3] = { 0.f, 1.f, 0.5f };
+
+    float FitColorIndices(const COLOR_BLOCK& _block,
+        const bool _used[16], unsigned short _c0, unsigned short _c1,
+        bool _threeColor, unsigned char _indices[16])
+    {
+        float end0[3] = {};
+        float end1[3] = {};
+        UnpackColor565(_c0, end0);
+        UnpackColor565(_c1, end1);
+
+        const float* weights =
+            _threeColor ? THREE_COLOR_WEIGHT : FOUR_COLOR_WEIGHT;
+        int paletteSize = _threeColor ? 3 : 4;
+        float palette[4][3] = {};
+        for (int i = 0; i < paletteSize; i++)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                palette[i][c] = end0[c] +
+                    (end1[c] - end0[c]) * weights[i];
+            }
+        }
+
+        float error = 0.f;
+        for (int i = 0; i < 16; i++)
+        {
+            if (!_used[i])
+            {
+                continue;
+            }
+            float best = GetDistance(_block.Color[i], palette[0]);
+            _indices[i] = 0;
+            for (int p = 1; p < paletteSize; p++)
+            {
+                float dist = GetDistance(_block.Color[i], palette[p]);
+                if (dist < best)
+                {
+                    best = dist;
+                    _indices[i] = (unsigned char)p;
+                }
+            }
+            error += best;
+        }
+
+        return error;
+    }
+
+    // principal axis endpoints followed by a couple of least squares
+    // refinements on the chosen indices
+    float EncodeColorBlock(const COLOR_BLOCK& _block,
+        const bool _used[16], bool _threeColor,
+        unsigned char _out[8])
+    {
+        unsigned short c0 = 0;
+        unsigned short c1 = 0;
+        unsigned char indices[16] = {};
+        int usedCount = 0;
+        float mean[3] = {};
+        for (int i = 0; i < 16; i++)
+        {
+            if (_used[i])
+            {
+                ++usedCount;
+                for (int c = 0; c < 3; c++)
+                {
+                    mean[c] += _block.Color[i][c];
+                }
+            }
+        }
+
+        float error = 0.f;
+        if (usedCount)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                mean[c] /= (float)usedCount;
+            }
+
+            float cov[6] = {};
+            for (int i = 0; i < 16; i++)
+            {
+                if (!_used[i])
+                {
+                    continue;
+                }
+                float d[3] = { _block.Color[i][0] - mean[0],
+                    _block.Color[i][1] - mean[1],
+                    _block.Color[i][2] - mean[2] };
+                cov[0] += d[0] * d[0];
+                cov[1] += d[0] * d[1];
+                cov[2] += d[0] * d[2];
+                cov[3] += d[1] * d[1];
+                cov[4] += d[1] * d[2];
+                cov[5] += d[2] * d[2];
+            }
+
+            float axis[3] = { 1.f, 1.f, 1.f };
+            for (int iter = 0; iter < 8; iter++)
+            {
+                float next[3] = {
+                    cov[0] * axis[0] + cov[1] * axis[1] +
+                    cov[2] * axis[2],
+                    cov[1] * axis[0] + cov[3] * axis[1] +
+                    cov[4] * axis[2],
+                    cov[2] * axis[0] + cov[4] * axis[1] +
+                    cov[5] * axis[2] };
+                float len = std::max(std::max(fabsf(next[0]),
+                    fabsf(next[1])), fabsf(next[2]));
+                if (len < 1e-6f)
+                {
+                    break;
+                }
+                for (int c = 0; c < 3; c++)
+                {
+                    axis[c] = next[c] / len;
+                }
+            }
+
+            float minDot = 1e30f;
+            float maxDot = -1e30f;
+            int minIndex = 0;
+            int maxIndex = 0;
+            for (int i = 0; i < 16; i++)
+            {
+                if (!_used[i])
+                {
+                    continue;
+                }
+                float dot = _block.Color[i][0] * axis[0] +
+                    _block.Color[i][1] * axis[1] +
+                    _block.Color[i][2] * axis[2];
+                if (dot < minDot)
+                {
+                    minDot = dot;
+                    minIndex = i;
+                }
+                if (dot > maxDot)
+                {
+                    maxDot = dot;
+                    maxIndex = i;
+                }
+            }
+
+            c0 = PackColor565(_block.Color[maxIndex]);
+            c1 = PackColor565(_block.Color[minIndex]);
+            error = FitColorIndices(_block, _used, c0, c1,
+                _threeColor, indices);
+
+            const float* weights =
+                _threeColor ? THREE_COLOR_WEIGHT : FOUR_COLOR_WEIGHT;
+            for (int iter = 0; iter < 2 && error > 0.f; iter++)
+            {
+                float aa = 0.f;
+                float ab = 0.f;
+                float bb = 0.f;
+                float ax[3] = {};
+                float bx[3] = {};
+                for (int i = 0; i < 16; i++)
+                {
+                    if (!_used[i])
+                    {
+                        continue;
+                    }
+                    float w = weights[indices[i]];
+                    aa += (1.f - w) * (1.f - w);
+                    ab += (1.f - w) * w;
+                    bb += w * w;
+                    for (int c = 0; c < 3; c++)
+                    {
+                        ax[c] += (1.f - w) * _block.Color[i][c];
+                        bx[c] += w * _block.Color[i][c];
+                    }
+                }
+
+                float det = aa * bb - ab * ab;
+                if (fabsf(det) < 1e-6f)
+                {
+                    break;
+                }
+                float end0[3] = {};
+                float end1[3] = {};
+                for (int c = 0; c < 3; c++)
+                {
+                    end0[c] = (ax[c] * bb - bx[c] * ab) / det;
+                    end1[c] = (bx[c] * aa - ax[c] * ab) / det;
+                }
+
+                unsigned short n0 = PackColor565(end0);
+                unsigned short n1 = PackColor565(end1);
+                unsigned char newIndices[16] = {};
+                float newError = FitColorIndices(_block, _used, n0, n1,
+                    _threeColor, newIndices);
+                if (newError >= error)
+                {
+                    break;
+                }
+                c0 = n0;
+                c1 = n1;
+                error = newError;
+                memcpy(indices, newIndices, sizeof(indices));
+            }
+        }
+
+        // the endpoint order selects the mode : c0 > c1 means four
+        // colors, c0 <= c1 means three colors plus transparent
+        static const unsigned char SWAP_FOUR[4] = { 1, 0, 3, 2 };
+        static const unsigned char SWAP_THREE[4] = { 1, 0, 2, 3 };
+        if (_threeColor ? (c0 > c1) : (c0 < c1))
+        {
+            std::swap(c0, c1);
+            for (int i = 0; i < 16; i++)
+            {
+                indices[i] = _threeColor ?
+                    SWAP_THREE[indices[i]] : SWAP_FOUR[indices[i]];
+            }
+        }
+        else if (!_threeColor && c0 == c1)
+        {
+            memset(indices, 0, sizeof(indices));
+        }
+
+        unsigned int bits = 0;
+        for (int i = 0; i < 16; i++)
+        {
+            unsigned int index = _used[i] ? indices[i] : 3;
+            bits |= index << (i * 2);
+        }
+        _out[0] = (unsigned char)(c0 & 0xFF);
+        _out[1] = (unsigned char)(c0 >> 8);
+        _out[2] = (unsigned char)(c1 & 0xFF);
+        _out[3] = (unsigned char)(c1 >> 8);
+        memcpy(_out + 4, &bits, 4);
+
+        return error;
+    }
+
+    float FitAlphaIndices(const unsigned char _alpha[16],
+        int _a0, int _a1, unsigned char _indices[16])
+    {
+        int palette[8] = { _a0, _a1 };
+        if (_a0 > _a1)
+        {
+            for (int i = 1; i < 7; i++)
+            {
+                palette[i + 1] = ((7 - i) * _a0 + i * _a1) / 7;
+            }
+        }
+        else
+        {
+            for (int i = 1; i < 5; i++)
+            {
+                palette[i + 1] = ((5 - i) * _a0 + i * _a1) / 5;
+            }
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+
+        float error = 0.f;
+        for (int i = 0; i < 16; i++)
+        {
+            int best = 1 << 30;
+            for (int p = 0; p < 8; p++)
+            {
+                int dist = (_alpha[i] - palette[p]) *
+                    (_alpha[i] - palette[p]);
+                if (dist < best)
+                {
+                    best = dist;
+                    _indices[i] = (unsigned char)p;
+                }
+            }
+            error += (float)best;
+        }
+
+        return error;
+    }
+
+    // tries both the eight step ramp and the six step ramp with
+    // explicit 0 and 255, which suits hard sprite edges better
+    float EncodeAlphaBlock(const unsigned char _alpha[16],
+        unsigned char _out[8])
+    {
+        int minAlpha = 255;
+        int maxAlpha = 0;
+        int innerMin = 255;
+        int innerMax = 0;
+        for (int i = 0; i < 16; i++)
+        {
+            minAlpha = std::min(minAlpha, (int)_alpha[i]);
+            maxAlpha = std::max(maxAlpha, (int)_alpha[i]);
+            if (_alpha[i] != 0 && _alpha[i] != 255)
+            {
+                innerMin = std::min(innerMin, (int)_alpha[i]);
+                innerMax = std::max(innerMax, (int)_alpha[i]);
+            }
+        }
+
+        int a0 = maxAlpha;
+        int a1 = minAlpha;
+        unsigned char indices[16] = {};
+        if (a0 == a1)
+        {
+            a1 = a0 ? a0 - 1 : 0;
+            a0 = a0 ? a0 : 1;
+        }
+        float error = FitAlphaIndices(_alpha, a0, a1, indices);
+        if (error > 0.f && innerMin <= innerMax)
+        {
+            unsigned char sixIndices[16] = {};
+            float sixError = FitAlphaIndices(_alpha, innerMin,
+                innerMax, sixIndices);
+            if (sixError < error)
+            {
+                a0 = innerMin;
+                a1 = innerMax;
+                error = sixError;
+                memcpy(indices, sixIndices, sizeof(indices));
+            }
+        }
+
+        unsigned long long bits = 0;
+        for (int i = 0; i < 16; i++)
+        {
+            bits |= (unsigned long long)indices[i] << (i * 3);
+        }
+        _out[0] = (unsigned char)a0;
+        _out[1] = (unsigned char)a1;
+        for (int i = 0; i < 6; i++)
+        {
+            _out[2 + i] = (unsigned char)(bits >> (i * 8));
+        }
+
+        return error;
+    }
+
+    DDS_FORMAT ChooseTextureFormat(const RGBA_IMAGE& _image)
+    {
+        // punch through bc1 writes black into transparent texels, so
+        // it's only used when the source already does the same and
+        // bilinear filtering around sprite edges stays unchanged
+        const unsigned char* pixel = _image.Pixels.data();
+        size_t count = (size_t)_image.Width * _image.Height;
+        bool binaryAlpha = true;
+        for (size_t i = 0; i < count && binaryAlpha; i++, pixel += 4)
+        {
+            if (pixel[3] == 255)
+            {
+                continue;
+            }
+            binaryAlpha = pixel[3] == 0 &&
+                !pixel[0] && !pixel[1] && !pixel[2];
+        }
+
+        return binaryAlpha ? DDS_FORMAT::BC1 : DDS_FORMAT::BC3;
+    }
+
+    float CompressLevel(const RGBA_IMAGE& _image, DDS_FORMAT _format,
+        std::vector<unsigned char>* _out)
+    {
+        float error = 0.f;
+        unsigned int blockW = (_image.Width + 3) / 4;
+        unsigned int blockH = (_image.Height + 3) / 4;
+        for (unsigned int by = 0; by < blockH; by++)
+        {
+            for (unsigned int bx = 0; bx < blockW; bx++)
+            {
+                // small mips are padded by clamping to the edge
+                COLOR_BLOCK block = {};
+                for (int i = 0; i < 16; i++)
+                {
+                    unsigned int x = std::min(bx * 4 + (i & 3),
+                        _image.Width - 1);
+                    unsigned int y = std::min(by * 4 + (i >> 2),
+                        _image.Height - 1);
+                    const unsigned char* pixel = &_image.Pixels[
+                        ((size_t)y * _image.Width + x) * 4];
+                    for (int c = 0; c < 3; c++)
+                    {
+                        block.Color[i][c] = (float)pixel[c];
+                    }
+                    block.Alpha[i] = pixel[3];
+                }
+
+                // fully transparent texels don't take part in the
+                // color fit, they only get the nearest palette entry
+                unsigned char encoded[16] = {};
+                bool used[16] = {};
+                bool anyUsed = false;
+                bool transparent = false;
+                for (int i = 0; i < 16; i++)
+                {
+                    used[i] = _format == DDS_FORMAT::BC1 ?
+                        block.Alpha[i] == 255 : block.Alpha[i] != 0;
+                    anyUsed = anyUsed || used[i];
+                    transparent = transparent || !used[i];
+                }
+                if (_format == DDS_FORMAT::BC1)
+                {
+                    error += EncodeColorBlock(block, used, transparent,
+                        encoded);
+                    _out->insert(_out->end(), encoded, encoded + 8);
+                }
+                else
+                {
+                    if (!anyUsed)
+                    {
+                        std::fill(used, used + 16, true);
+                    }
+                    error += EncodeAlphaBlock(block.Alpha, encoded);
+                    error += EncodeColorBlock(block, used, false,
+                        encoded + 8);
+                    _out->insert(_out->end(), encoded, encoded + 16);
+                }
+            }
+        }
+
+        return error;
+    }
+
+    void DownsampleImage(const RGBA_IMAGE& _src, RGBA_IMAGE* _dst)
+    {
+        _dst->Width = std::max(1u, _src.Width / 2);
+        _dst->Height = std::max(1u, _src.Height / 2);
+        _dst->Pixels.resize((size_t)_dst->Width * _dst->Height * 4);
+        for (unsigned int y = 0; y < _dst->Height; y++)
+        {
+            for (unsigned int x = 0; x < _dst->Width; x++)
+            {
+                // colors are weighted by alpha so that transparent
+                // texels don't darken the sprite outline
+                float color[3] = {};
+                float alpha = 0.f;
+                for (int i = 0; i < 4; i++)
+                {
+                    unsigned int sx = std::min(x * 2 + (i & 1),
+                        _src.Width - 1);
+                    unsigned int sy = std::min(y * 2 + (i >> 1),
+                        _src.Height - 1);
+                    const unsigned char* pixel = &_src.Pixels[
+                        ((size_t)sy * _src.Width + sx) * 4];
+                    float weight = (float)pixel[3] + 1e-3f;
+                    for (int c = 0; c < 3; c++)
+                    {
+                        color[c] += (float)pixel[c] * weight;
+                    }
+                    alpha += weight;
+                }
+
+                unsigned char* dst = &_dst->Pixels[
+                    ((size_t)y * _dst->Width + x) * 4];
+                for (int c = 0; c < 3; c++)
+                {
+                    dst[c] = (unsigned char)(color[c] / alpha + 0.5f);
+                }
+                dst[3] = (unsigned char)(alpha / 4.f + 0.5f);
+            }
+        }
+    }
+
+    bool CookTexture(const fs::path& _png, bool _mips,
+        COOK_RESULT* _result)
+    {
+        std::vector<unsigned char> file = {};
+        RGBA_IMAGE image = {};
+        auto start = std::chrono::steady_clock::now();
+        if (!ReadWholeFile(_png, &file) || !DecodePng(file, &image))
+        {
+            printf("cannot decode png : [ %s ]\n",
+                _png.generic_string().c_str());
+            return false;
+        }
+        _result->DecodeMs = GetElapsedMs(start);
+
+        fs::path dds = _png;
+        dds.replace_extension(".dds");
+        _result->RawBytes = (unsigned long long)image.Width *
+            image.Height * 4;
+        if (image.Width % 4 || image.Height % 4)
+        {
+            // d3d11 wants the top level of a bc texture to be block
+            // aligned, padding would shift every uv in the configs
+            if (fs::exists(dds))
+            {
+                fs::remove(dds);
+            }
+            _result->CookedBytes = _result->RawBytes;
+            return true;
+        }
+
+        start = std::chrono::steady_clock::now();
+        _result->Format = ChooseTextureFormat(image);
+        std::vector<unsigned char> blocks = {};
+        RGBA_IMAGE level = image;
+        _result->MipCount = 0;
+        while (true)
+        {
+            float error = CompressLevel(level, _result->Format,
+                &blocks);
+            if (!_result->MipCount)
+            {
+                _result->SquaredError = error;
+                _result->PixelCount =
+                    (unsigned long long)level.Width * level.Height;
+            }
+            ++_result->MipCount;
+            if (!_mips || (level.Width == 1 && level.Height == 1) ||
+                _result->MipCount == DDS_MAX_MIP_LEVEL)
+            {
+                break;
+            }
+            RGBA_IMAGE next = {};
+            DownsampleImage(level, &next);
+            level = std::move(next);
+        }
+        _result->EncodeMs = GetElapsedMs(start);
+
+        std::vector<unsigned char> output = {};
+        WriteDdsHeader(_result->Format, image.Width, image.Height,
+            _result->MipCount, &output);
+        output.insert(output.end(), blocks.begin(), blocks.end());
+        _result->CookedBytes = blocks.size();
+        if (!WriteWholeFile(dds, output))
+        {
+            printf("cannot write dds : [ %s ]\n",
+                dds.generic_string().c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    const char* GetFormatName(DDS_FORMAT _format)
+    {
+        switch (_format)
+        {
+        case DDS_FORMAT::BC1: return "bc1";
+        case DDS_FORMAT::BC3: return "bc3";
+        case DDS_FORMAT::BC7: return "bc7";
+        default: return "png";
+        }
+    }
+
+    int CookTextureFolder(const std::string& _dir, bool _mips)
+    {
+        fs::path root(_dir);
+        if (!fs::is_directory(root))
+        {
+            printf("cannot find texture folder : [ %s ]\n",
+                _dir.c_str());
+            return 1;
+        }
+
+        std::vector<fs::path> pngArray = {};
+        for (auto& item : fs::recursive_directory_iterator(root))
+        {
+            std::string ext = item.path().extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(),
+                [](unsigned char _c) { return (char)tolower(_c); });
+            if (item.is_regular_file() && ext == ".png")
+            {
+                pngArray.push_back(item.path());
+            }
+        }
+        std::sort(pngArray.begin(), pngArray.end());
+
+        printf("%-32s %-4s %3s %11s %11s %9s %9s %6s\n", "texture",
+            "fmt", "mip", "rgba8 vram", "cooked", "png ms", "bc ms",
+            "rmse");
+        unsigned long long rawTotal = 0;
+        unsigned long long cookedTotal = 0;
+        double decodeTotal = 0.0;
+        for (auto& png : pngArray)
+        {
+            COOK_RESULT result = {};
+            if (!CookTexture(png, _mips, &result))
+            {
+                return 1;
+            }
+
+            double channels =
+                result.Format == DDS_FORMAT::BC3 ? 4.0 : 3.0;
+            double rmse = result.PixelCount ? sqrt(result.SquaredError /
+                (double)result.PixelCount / channels) : 0.0;
+            printf("%-32s %-4s %3u %11llu %11llu %9.2f %9.2f %6.2f\n",
+                fs::relative(png, root).generic_string().c_str(),
+                GetFormatName(result.Format), result.MipCount,
+                result.RawBytes, result.CookedBytes, result.DecodeMs,
+                result.EncodeMs, rmse);
+            rawTotal += result.RawBytes;
+            cookedTotal += result.CookedBytes;
+            decodeTotal += result.DecodeMs;
+        }
+
+        printf("vram %llu bytes -> %llu bytes, png decode %.2f ms\n",
+            rawTotal, cookedTotal, decodeTotal);
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc == 2 || (argc == 3 && !strcmp(argv[2], "-mips")))
+    {
+        return CookTextureFolder(argv[1], argc == 3);
+    }
+
+    printf("usage : HycTexCooker <texture folder> [-mips]\n");
+    return 1;
+}